@@ -273,6 +273,8 @@ private:
     std::shared_ptr<avsCommon::avs::MessageRequest> m_currentRequest;
     /// Whether this stream has any paused transfers.
     bool m_isPaused;
+    /// Whether any bytes of the current request's attachment have been handed to libcurl yet.
+    bool m_isAttachmentStarted;
     /**
      * The exception message being received from AVS by this stream.  It may be built up over several calls if either
      * the write quanta are small, or if the message is long.
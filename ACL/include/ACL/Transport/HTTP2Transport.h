@@ -17,6 +17,7 @@
 #define ALEXA_CLIENT_SDK_ACL_INCLUDE_ACL_TRANSPORT_HTTP2TRANSPORT_H_
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <deque>
 #include <map>
@@ -160,6 +161,11 @@ private:
      */
     bool establishConnection();
 
+    /**
+     * Record when the TCP connection to AVS was established, once the downchannel stream has received its response.
+     */
+    void recordTcpConnectedTime();
+
     /**
      * Checks if an active stream is finished and reports the response code the observer.
      */
@@ -178,10 +184,21 @@ private:
     bool canProcessOutgoingMessage();
 
     /**
-     * Send the next @c MessageRequest if any are queued.
+     * Send the next @c MessageRequest if any are queued.  Once the post-connect message is sent, events are accepted
+     * and queued behind it while it is in flight, though the transport is only reported connected once it succeeds.
      */
     void processNextOutgoingMessage();
 
+    /**
+     * Handle the end of the post-connect message's stream.  Until a post-connect message succeeds, other queued
+     * messages are held back, so that none is sent ahead of a retried post-connect message.  On success the transport
+     * is reported connected and the held messages are released.  On failure they are completed with
+     * @c NOT_CONNECTED, as they would have been had they been sent before the post-connect message.
+     *
+     * @param succeeded Whether the post-connect message succeeded.
+     */
+    void handlePostConnectStreamFinished(bool succeeded);
+
     /**
      * Attempts to create a stream that will send a ping to the backend. If a ping stream is in flight, we do not
      * attempt to create a new one (returning true in this case).
@@ -242,15 +259,16 @@ private:
      * Queue a @c MessageRequest for processing (to the back of the queue).
      *
      * @param request The MessageRequest to queue for sending.
-     * @param ignoreConnectionStatus set to @c false to block messages to AVS, @c true
-     * when invoked through the @c PostConnectSendMessage interface to allow
+     * @param ignoreConnectionStatus set to @c false to block messages to AVS unless connected or a post-connect
+     * message is in flight, @c true when invoked through the @c PostConnectSendMessage interface to allow
      * post-connect messages to AVS in the unconnected state.
      * @return Whether the request was enqueued.
      */
     bool enqueueRequest(std::shared_ptr<avsCommon::avs::MessageRequest> request, bool ignoreConnectionStatus = false);
 
     /**
-     * De-queue a @c MessageRequest from (the front of) the queue of @c MessageRequest instances to process.
+     * De-queue a @c MessageRequest from (the front of) the queue of @c MessageRequest instances to process.  While a
+     * post-connect message is pending, only the post-connect message is de-queued.
      *
      * @return The next @c MessageRequest to process (or @c nullptr).
      */
@@ -367,6 +385,27 @@ private:
     /// Queue of @c MessageRequest instances to send. Serialized by @c m_mutex.
     std::deque<std::shared_ptr<avsCommon::avs::MessageRequest>> m_requestQueue;
 
+    /// The post-connect message, until it has been sent. Serialized by @c m_mutex.
+    std::shared_ptr<avsCommon::avs::MessageRequest> m_postConnectRequest;
+
+    /**
+     * Whether a post-connect message has been queued and none has succeeded yet, so other messages must be held back.
+     * Serialized by @c m_mutex.
+     */
+    bool m_isPostConnectPending;
+
+    /**
+     * Whether the post-connect message has been sent and has not finished yet, so events may be queued behind it.
+     * Serialized by @c m_mutex.
+     */
+    bool m_isPostConnectInFlight;
+
+    /// The stream of the post-connect message in flight, if any. Only accessed by the network thread.
+    std::shared_ptr<HTTP2Stream> m_postConnectStream;
+
+    /// When the TCP connection to AVS was established. Serialized by @c m_mutex.
+    std::chrono::steady_clock::time_point m_tcpConnectedTime;
+
     /// Used to wake the main network thread in connection retry back-off situation.
     std::condition_variable m_wakeRetryTrigger;
 
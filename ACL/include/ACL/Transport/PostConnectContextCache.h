@@ -0,0 +1,108 @@
+/*
+ * Copyright 2017-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_ACL_INCLUDE_ACL_TRANSPORT_POSTCONNECTCONTEXTCACHE_H_
+#define ALEXA_CLIENT_SDK_ACL_INCLUDE_ACL_TRANSPORT_POSTCONNECTCONTEXTCACHE_H_
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <AVSCommon/SDKInterfaces/ContextManagerInterface.h>
+#include <AVSCommon/SDKInterfaces/ContextManagerObserverInterface.h>
+#include <AVSCommon/SDKInterfaces/ContextRequesterInterface.h>
+
+namespace alexaClientSDK {
+namespace acl {
+
+/**
+ * Keeps a context built ahead of time for the @c SynchronizeState event sent after each connection, so that a
+ * (re)connection does not have to wait for the state providers before it can become ready.
+ *
+ * The context is rebuilt whenever the @c ContextManager reports a change.  States which are only refreshed when
+ * context is requested (such as the playback offset) are as of the last rebuild.
+ *
+ * Each rebuild is a full @c ContextManagerInterface::getContext() request, which asks every state provider with an
+ * @c ALWAYS or @c SOMETIMES refresh policy for its state and serializes the whole context.  The @c ContextManager only
+ * reports states which a provider changed of its own accord, and changes reported while a rebuild is in progress are
+ * coalesced into a single further rebuild, so at most one request is outstanding and a burst of changes costs at most
+ * two rebuilds.  A state which changes continually (a volume being ramped, for example) still costs a rebuild per
+ * change once the previous one has finished.
+ */
+class PostConnectContextCache
+        : public avsCommon::sdkInterfaces::ContextManagerObserverInterface
+        , public avsCommon::sdkInterfaces::ContextRequesterInterface
+        , public std::enable_shared_from_this<PostConnectContextCache> {
+public:
+    /**
+     * Creates a @c PostConnectContextCache which observes @c contextManager, and starts building the context.
+     *
+     * @param contextManager The @c ContextManager from which to get the context.
+     * @return The new @c PostConnectContextCache, or @c nullptr if @c contextManager is @c nullptr.
+     */
+    static std::shared_ptr<PostConnectContextCache> create(
+        std::shared_ptr<avsCommon::sdkInterfaces::ContextManagerInterface> contextManager);
+
+    /**
+     * Get the cached context.
+     *
+     * @return The context, or an empty string if the context has changed since it was built and has not been rebuilt
+     * yet.
+     */
+    std::string getContext();
+
+    /**
+     * Stop observing the @c ContextManager.
+     */
+    void detach();
+
+    void onContextChanged() override;
+
+    void onContextAvailable(const std::string& jsonContext) override;
+    void onContextFailure(const avsCommon::sdkInterfaces::ContextRequestError error) override;
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param contextManager The @c ContextManager from which to get the context.
+     */
+    PostConnectContextCache(std::shared_ptr<avsCommon::sdkInterfaces::ContextManagerInterface> contextManager);
+
+    /**
+     * Ask the @c ContextManager for context.
+     */
+    void requestContext();
+
+    /// The @c ContextManager, which holds a reference to this object as an observer.
+    std::weak_ptr<avsCommon::sdkInterfaces::ContextManagerInterface> m_contextManager;
+
+    /// Serializes access to members.
+    std::mutex m_mutex;
+
+    /// The cached context, or an empty string if it is out of date.
+    std::string m_context;
+
+    /// Whether a request for context is in progress.
+    bool m_isRefreshing;
+
+    /// Whether the context has changed since the request in progress was made.
+    bool m_isOutdated;
+};
+
+}  // namespace acl
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_ACL_INCLUDE_ACL_TRANSPORT_POSTCONNECTCONTEXTCACHE_H_
@@ -20,6 +20,7 @@
 
 #include <AVSCommon/SDKInterfaces/ContextManagerInterface.h>
 #include <AVSCommon/Utils/RequiresShutdown.h>
+#include "ACL/Transport/PostConnectContextCache.h"
 #include "ACL/Transport/PostConnectObserverInterface.h"
 #include "ACL/Transport/PostConnectSendMessageInterface.h"
 #include "ACL/Transport/TransportInterface.h"
@@ -35,7 +36,8 @@ class HTTP2Transport;
 class PostConnectObject : public avsCommon::utils::RequiresShutdown {
 public:
     /**
-     * Static method to initialize the ContextManager.
+     * Static method to initialize the ContextManager.  This also starts keeping a context built ahead of time for
+     * the post-connect objects.
      *
      * @param contextManager is the context manager to initialize with.
      */
@@ -73,6 +75,10 @@ public:
     /// static instance of the ContextManager set during intialization.
     static std::shared_ptr<avsCommon::sdkInterfaces::ContextManagerInterface> m_contextManager;
 
+protected:
+    /// static instance of the context cache set during initialization.
+    static std::shared_ptr<PostConnectContextCache> m_contextCache;
+
 private:
     /**
      * Method to notify observers of PostConnectObserverInterface.
@@ -21,6 +21,7 @@
 #include <AVSCommon/Utils/Logger/Logger.h>
 #include <AVSCommon/Utils/Logger/LoggerUtils.h>
 #include <AVSCommon/Utils/Logger/ThreadMoniker.h>
+#include <AVSCommon/Utils/Metrics.h>
 
 #include "ACL/Transport/HTTP2Stream.h"
 #include "ACL/Transport/HTTP2Transport.h"
@@ -151,6 +152,7 @@ HTTP2Stream::HTTP2Stream(
         m_logicalStreamId{0},
         m_parser{messageConsumer, attachmentManager},
         m_isPaused{false},
+        m_isAttachmentStarted{false},
         m_progressTimeout{std::chrono::steady_clock::duration::max().count()},
         m_timeOfLastTransfer{getNow()} {
 }
@@ -163,6 +165,7 @@ bool HTTP2Stream::reset() {
     m_parser.reset();
     m_currentRequest.reset();
     m_isPaused = false;
+    m_isAttachmentStarted = false;
     m_exceptionBeingProcessed.clear();
     m_progressTimeout = std::chrono::steady_clock::duration::max().count();
     m_timeOfLastTransfer = getNow();
@@ -394,6 +397,13 @@ size_t HTTP2Stream::readCallback(char* data, size_t size, size_t nmemb, void* us
         return CURL_READFUNC_PAUSE;
     }
 
+    // Mark the point where attachment audio first hits the wire; paired with the AIP metrics this gives the
+    // wake-to-first-byte latency of a Recognize event.
+    if (!stream->m_isAttachmentStarted) {
+        stream->m_isAttachmentStarted = true;
+        ACSDK_METRIC_IDS(TAG, "Attachment", "", "", Metrics::Location::ACL_ATTACHMENT_FIRST_BYTE);
+    }
+
     return bytesRead;
 }
 
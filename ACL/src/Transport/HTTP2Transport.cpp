@@ -13,6 +13,7 @@
  * permissions and limitations under the License.
  */
 
+#include <algorithm>
 #include <chrono>
 #include <functional>
 #include <random>
@@ -177,6 +178,8 @@ HTTP2Transport::HTTP2Transport(
         m_isConnected{false},
         m_isStopping{false},
         m_disconnectedSent{false},
+        m_isPostConnectPending{false},
+        m_isPostConnectInFlight{false},
         m_postConnectObject{postConnectObject} {
     m_observers.insert(observer);
 
@@ -288,6 +291,11 @@ void HTTP2Transport::sendPostConnectMessage(std::shared_ptr<MessageRequest> requ
     if (!request) {
         ACSDK_ERROR(LX("sendFailed").d("reason", "nullRequest"));
     }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_postConnectRequest = request;
+        m_isPostConnectPending = true;
+    }
     enqueueRequest(request, true);
 }
 
@@ -457,6 +465,7 @@ void HTTP2Transport::networkLoop() {
     setIsStopping(ConnectionStatusObserverInterface::ChangedReason::INTERNAL_ERROR);
 
     releaseAllEventStreams();
+    m_postConnectStream.reset();
     releasePingStream();
     releaseDownchannelStream();
     m_multi.reset();
@@ -502,6 +511,7 @@ bool HTTP2Transport::establishConnection() {
              * the full error message (for logging purposes) and then return false when we're done
              */
             if (HTTPResponseCode::SUCCESS_OK == downchannelResponseCode) {
+                recordTcpConnectedTime();
                 return true;
             }
         } else if (downchannelResponseCode < 0) {
@@ -529,6 +539,27 @@ bool HTTP2Transport::establishConnection() {
     return false;
 }
 
+void HTTP2Transport::recordTcpConnectedTime() {
+    auto tcpConnectedTime = std::chrono::steady_clock::now();
+
+    /*
+     * The downchannel is the first stream on the connection, and its response has only just arrived, so go back from
+     * now by the time between the connection being established and the response starting.
+     */
+    double connectTime = 0;
+    double startTransferTime = 0;
+    auto handle = m_downchannelStream->getCurlHandle();
+    if (CURLE_OK == curl_easy_getinfo(handle, CURLINFO_CONNECT_TIME, &connectTime) &&
+        CURLE_OK == curl_easy_getinfo(handle, CURLINFO_STARTTRANSFER_TIME, &startTransferTime) &&
+        startTransferTime > connectTime) {
+        tcpConnectedTime -= std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(startTransferTime - connectTime));
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_tcpConnectedTime = tcpConnectedTime;
+}
+
 void HTTP2Transport::cleanupFinishedStreams() {
     CURLMsg* message = nullptr;
     do {
@@ -550,6 +581,12 @@ void HTTP2Transport::cleanupFinishedStreams() {
 
             auto it = m_activeStreams.find(message->easy_handle);
             if (it != m_activeStreams.end()) {
+                if (it->second == m_postConnectStream) {
+                    auto responseCode = it->second->getResponseCode();
+                    handlePostConnectStreamFinished(
+                        HTTPResponseCode::SUCCESS_OK == responseCode ||
+                        HTTPResponseCode::SUCCESS_NO_CONTENT == responseCode);
+                }
                 it->second->notifyRequestObserver();
                 ACSDK_DEBUG0(LX("cleanupFinishedStream")
                                  .d("streamId", it->second->getLogicalStreamId())
@@ -569,6 +606,9 @@ void HTTP2Transport::cleanupStalledStreams() {
         auto stream = (it++)->second;
         if (isEventStream(stream) && stream->hasProgressTimedOut()) {
             ACSDK_INFO(LX("streamProgressTimedOut").d("streamId", stream->getLogicalStreamId()));
+            if (stream == m_postConnectStream) {
+                handlePostConnectStreamFinished(false);
+            }
             stream->notifyRequestObserver(MessageRequestObserverInterface::Status::TIMEDOUT);
             releaseEventStream(stream);
         }
@@ -617,10 +657,54 @@ void HTTP2Transport::processNextOutgoingMessage() {
         } else {
             ACSDK_DEBUG9(LX("insertActiveStream").d("handle", stream->getCurlHandle()));
             m_activeStreams.insert(ActiveTransferEntry(stream->getCurlHandle(), stream));
+
+            /*
+             * An event is only sent once the previous one has a response (see canProcessOutgoingMessage), so events
+             * queued from now on still follow the post-connect message.  Let them be queued while it is in flight.
+             */
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (request == m_postConnectRequest) {
+                m_postConnectRequest.reset();
+                m_postConnectStream = stream;
+                m_isPostConnectInFlight = true;
+            }
         }
     }
 }
 
+void HTTP2Transport::handlePostConnectStreamFinished(bool succeeded) {
+    m_postConnectStream.reset();
+    if (succeeded) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_isPostConnectInFlight = false;
+            m_isPostConnectPending = false;
+        }
+        setIsConnectedTrueUnlessStopping();
+        return;
+    }
+
+    // Events queued behind the failed post-connect message must not overtake its retry, nor wait for it indefinitely.
+    std::deque<std::shared_ptr<MessageRequest>> heldRequests;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isPostConnectInFlight = false;
+        auto it = m_requestQueue.begin();
+        while (it != m_requestQueue.end()) {
+            if (*it == m_postConnectRequest) {
+                ++it;
+            } else {
+                heldRequests.push_back(*it);
+                it = m_requestQueue.erase(it);
+            }
+        }
+    }
+    ACSDK_WARN(LX("postConnectMessageFailed").d("failedHeldRequests", heldRequests.size()));
+    for (auto request : heldRequests) {
+        request->sendCompleted(MessageRequestObserverInterface::Status::NOT_CONNECTED);
+    }
+}
+
 bool HTTP2Transport::sendPing() {
     ACSDK_DEBUG(LX("sendPing").d("pingStream", m_pingStream.get()));
 
@@ -700,14 +784,22 @@ bool HTTP2Transport::isConnectedLocked() const {
 }
 
 void HTTP2Transport::setIsConnectedTrueUnlessStopping() {
+    std::chrono::steady_clock::time_point tcpConnectedTime;
     {
         std::lock_guard<std::mutex> lock(m_mutex);
         if (m_isConnected || m_isStopping) {
             return;
         }
         m_isConnected = true;
+        tcpConnectedTime = m_tcpConnectedTime;
     }
 
+    ACSDK_INFO(LX("connectionReady")
+                   .d("timeFromTcpConnectToReadyMs",
+                      std::chrono::duration_cast<std::chrono::milliseconds>(
+                          std::chrono::steady_clock::now() - tcpConnectedTime)
+                          .count()));
+
     notifyObserversOnConnected();
 }
 
@@ -734,7 +826,7 @@ bool HTTP2Transport::enqueueRequest(std::shared_ptr<MessageRequest> request, boo
 
     std::lock_guard<std::mutex> lock(m_mutex);
     if (!m_isStopping) {
-        if (ignoreConnectState || m_isConnected) {
+        if (ignoreConnectState || m_isConnected || m_isPostConnectInFlight) {
             ACSDK_DEBUG9(LX("enqueueRequest").sensitive("jsonContent", request->getJsonContent()));
             m_requestQueue.push_back(request);
             return true;
@@ -752,6 +844,18 @@ std::shared_ptr<MessageRequest> HTTP2Transport::dequeueRequest() {
     if (m_isStopping || m_requestQueue.empty()) {
         return nullptr;
     }
+    if (m_isPostConnectPending) {
+        /*
+         * Events may have been queued since the transport became connected, ahead of a post-connect message which is
+         * being retried.  Send only the post-connect message until one succeeds.
+         */
+        auto it = std::find(m_requestQueue.begin(), m_requestQueue.end(), m_postConnectRequest);
+        if (!m_postConnectRequest || m_requestQueue.end() == it) {
+            return nullptr;
+        }
+        m_requestQueue.erase(it);
+        return m_postConnectRequest;
+    }
     auto result = m_requestQueue.front();
     m_requestQueue.pop_front();
     return result;
@@ -0,0 +1,114 @@
+/*
+ * Copyright 2017-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "ACL/Transport/PostConnectContextCache.h"
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+namespace alexaClientSDK {
+namespace acl {
+
+using namespace avsCommon::sdkInterfaces;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("PostConnectContextCache");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param event The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+std::shared_ptr<PostConnectContextCache> PostConnectContextCache::create(
+    std::shared_ptr<ContextManagerInterface> contextManager) {
+    if (!contextManager) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "nullContextManager"));
+        return nullptr;
+    }
+
+    auto contextCache = std::shared_ptr<PostConnectContextCache>(new PostConnectContextCache(contextManager));
+    contextManager->addContextManagerObserver(contextCache);
+    contextCache->onContextChanged();
+    return contextCache;
+}
+
+PostConnectContextCache::PostConnectContextCache(std::shared_ptr<ContextManagerInterface> contextManager) :
+        m_contextManager{contextManager},
+        m_isRefreshing{false},
+        m_isOutdated{false} {
+}
+
+std::string PostConnectContextCache::getContext() {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return m_context;
+}
+
+void PostConnectContextCache::detach() {
+    auto contextManager = m_contextManager.lock();
+    if (contextManager) {
+        contextManager->removeContextManagerObserver(shared_from_this());
+    }
+}
+
+void PostConnectContextCache::onContextChanged() {
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_context.clear();
+        if (m_isRefreshing) {
+            // The context being built may not include the change, so build it again once it arrives.
+            m_isOutdated = true;
+            return;
+        }
+        m_isRefreshing = true;
+    }
+    requestContext();
+}
+
+void PostConnectContextCache::onContextAvailable(const std::string& jsonContext) {
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        if (!m_isOutdated) {
+            ACSDK_DEBUG9(LX("onContextAvailable").d("reason", "contextCached"));
+            m_context = jsonContext;
+            m_isRefreshing = false;
+            return;
+        }
+        m_isOutdated = false;
+    }
+    requestContext();
+}
+
+void PostConnectContextCache::onContextFailure(const ContextRequestError error) {
+    ACSDK_WARN(LX("onContextFailure").d("error", error));
+    std::lock_guard<std::mutex> lock{m_mutex};
+    // Leave the cache empty until the next change; connections will request the context themselves meanwhile.
+    m_isRefreshing = false;
+    m_isOutdated = false;
+}
+
+void PostConnectContextCache::requestContext() {
+    auto contextManager = m_contextManager.lock();
+    if (!contextManager) {
+        ACSDK_ERROR(LX("requestContextFailed").d("reason", "contextManagerReleased"));
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_isRefreshing = false;
+        m_isOutdated = false;
+        return;
+    }
+    contextManager->getContext(shared_from_this());
+}
+
+}  // namespace acl
+}  // namespace alexaClientSDK
@@ -25,6 +25,9 @@ using namespace avsCommon::sdkInterfaces;
 /// Class static definition of context-manager.
 std::shared_ptr<avsCommon::sdkInterfaces::ContextManagerInterface> PostConnectObject::m_contextManager = nullptr;
 
+/// Class static definition of the context cache.
+std::shared_ptr<PostConnectContextCache> PostConnectObject::m_contextCache = nullptr;
+
 /// String to identify log entries originating from this file.
 static const std::string TAG("PostConnect");
 
@@ -41,7 +44,11 @@ static const std::string TAG("PostConnect");
  * @param contextManager The contextManager instance to initialize with.
  */
 void PostConnectObject::init(std::shared_ptr<avsCommon::sdkInterfaces::ContextManagerInterface> contextManager) {
+    if (m_contextCache) {
+        m_contextCache->detach();
+    }
     m_contextManager = contextManager;
+    m_contextCache = PostConnectContextCache::create(contextManager);
 }
 
 /**
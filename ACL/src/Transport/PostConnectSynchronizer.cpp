@@ -116,13 +116,27 @@ void PostConnectSynchronizer::postConnectLoop() {
     ACSDK_DEBUG9(LX("Entering postConnectLoop thread"));
 
     while (!isStopping() && !isPostConnected()) {
+        std::string cachedContext;
         {
             std::unique_lock<std::mutex> lock(m_mutex);
             if (!m_contextFetchInProgress) {
-                PostConnectObject::m_contextManager->getContext(shared_from_this());
+                /*
+                 * Use the context built ahead of time for the first attempt, so that SynchronizeState does not have
+                 * to wait for the state providers.  Retries request fresh context.
+                 */
+                if (0 == retryCount && PostConnectObject::m_contextCache) {
+                    cachedContext = PostConnectObject::m_contextCache->getContext();
+                }
+                if (cachedContext.empty()) {
+                    PostConnectObject::m_contextManager->getContext(shared_from_this());
+                }
                 m_contextFetchInProgress = true;
             }
         }
+        if (!cachedContext.empty()) {
+            ACSDK_DEBUG(LX("postConnectLoop").d("context", "cached"));
+            onContextAvailable(cachedContext);
+        }
 
         auto retryBackoff = TransportDefines::RETRY_TIMER.calculateTimeToRetry(retryCount);
         retryCount++;
@@ -155,12 +169,15 @@ void PostConnectSynchronizer::onContextAvailable(const std::string& jsonContext)
 
     /*
      * If the transport pointer held by the post-connect is still valid - not
-     * shutdown yet then we send the message through the transport.
+     * shutdown yet then we send the message through the transport.  The pointer
+     * is kept until the message succeeds, because the transport is connected as
+     * soon as the message is sent, and holds back other messages until a retry
+     * gets through.
      */
     std::shared_ptr<HTTP2Transport> localTransport;
     {
         std::lock_guard<std::mutex> lock{m_mutex};
-        swap(m_transport, localTransport);
+        localTransport = m_transport;
     }
 
     if (localTransport) {
@@ -193,6 +210,7 @@ void PostConnectSynchronizer::onSendCompleted(MessageRequestObserverInterface::S
         {
             std::lock_guard<std::mutex> lock{m_mutex};
             m_isPostConnected = true;
+            m_transport.reset();
             m_wakeRetryTrigger.notify_one();
         }
         notifyObservers();
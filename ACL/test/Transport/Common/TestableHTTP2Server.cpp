@@ -0,0 +1,316 @@
+/*
+ * Copyright 2017-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "TestableHTTP2Server.h"
+
+namespace alexaClientSDK {
+namespace acl {
+namespace test {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("TestableHTTP2Server");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The connection preface sent by an HTTP/2 client.
+static const std::string CLIENT_PREFACE = "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n";
+
+/// The response which switches the connection from HTTP/1.1 to HTTP/2.
+static const std::string SWITCHING_PROTOCOLS_RESPONSE =
+    "HTTP/1.1 101 Switching Protocols\r\nConnection: Upgrade\r\nUpgrade: h2c\r\n\r\n";
+
+/// The header of an HTTP/1.1 request asking to upgrade to cleartext HTTP/2.
+static const std::string UPGRADE_H2C_HEADER = "Upgrade: h2c";
+
+/// The end of the header of an HTTP/1.1 request.
+static const std::string END_OF_HEADER = "\r\n\r\n";
+
+/// The size of an HTTP/2 frame header.
+static const size_t FRAME_HEADER_SIZE = 9;
+
+/// The stream of the request upgraded to HTTP/2, which is the downchannel.
+static const uint32_t DOWNCHANNEL_STREAM_ID = 1;
+
+/// @name HTTP/2 frame types.
+/// @{
+static const uint8_t FRAME_TYPE_DATA = 0x0;
+static const uint8_t FRAME_TYPE_HEADERS = 0x1;
+static const uint8_t FRAME_TYPE_SETTINGS = 0x4;
+static const uint8_t FRAME_TYPE_PING = 0x6;
+static const uint8_t FRAME_TYPE_WINDOW_UPDATE = 0x8;
+/// @}
+
+/// @name HTTP/2 frame flags.
+/// @{
+static const uint8_t FLAG_END_STREAM = 0x1;
+static const uint8_t FLAG_ACK = 0x1;
+static const uint8_t FLAG_END_HEADERS = 0x4;
+static const uint8_t FLAG_PADDED = 0x8;
+/// @}
+
+/// The HTTP status of a request without a body, such as a ping.
+static const int STATUS_NO_CONTENT = 204;
+
+/// The HTTP status of the downchannel.
+static const int STATUS_OK = 200;
+
+/**
+ * Encode a 32 bit value in network byte order.
+ *
+ * @param value The value.
+ * @return The encoded value.
+ */
+static std::string encodeUint32(uint32_t value) {
+    return std::string{static_cast<char>((value >> 24) & 0xff),
+                       static_cast<char>((value >> 16) & 0xff),
+                       static_cast<char>((value >> 8) & 0xff),
+                       static_cast<char>(value & 0xff)};
+}
+
+/**
+ * Encode a header block holding only a status, as a literal without indexing whose name is the ":status" entry of the
+ * HPACK static table.
+ *
+ * @param statusCode The HTTP status code, which must have three digits.
+ * @return The header block.
+ */
+static std::string encodeStatusHeaderBlock(int statusCode) {
+    static const char STATUS_NAME_INDEX = 0x08;
+    auto status = std::to_string(statusCode);
+    return std::string{STATUS_NAME_INDEX, static_cast<char>(status.size())} + status;
+}
+
+std::unique_ptr<TestableHTTP2Server> TestableHTTP2Server::create() {
+    int listenSocket = socket(AF_INET, SOCK_STREAM, 0);
+    if (listenSocket < 0) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "socketFailed"));
+        return nullptr;
+    }
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;
+    socklen_t addressLength = sizeof(address);
+    if (bind(listenSocket, reinterpret_cast<sockaddr*>(&address), addressLength) != 0 ||
+        listen(listenSocket, 1) != 0 ||
+        getsockname(listenSocket, reinterpret_cast<sockaddr*>(&address), &addressLength) != 0) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "listenFailed"));
+        close(listenSocket);
+        return nullptr;
+    }
+
+    return std::unique_ptr<TestableHTTP2Server>(new TestableHTTP2Server(listenSocket, ntohs(address.sin_port)));
+}
+
+TestableHTTP2Server::TestableHTTP2Server(int listenSocket, int port) :
+        m_listenSocket{listenSocket},
+        m_port{port},
+        m_connectionSocket{-1},
+        m_isStopping{false} {
+    m_thread = std::thread(&TestableHTTP2Server::serverLoop, this);
+}
+
+TestableHTTP2Server::~TestableHTTP2Server() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isStopping = true;
+        // Wake the server thread from accept() or recv().
+        shutdown(m_listenSocket, SHUT_RDWR);
+        if (m_connectionSocket >= 0) {
+            shutdown(m_connectionSocket, SHUT_RDWR);
+        }
+    }
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    if (m_connectionSocket >= 0) {
+        close(m_connectionSocket);
+    }
+    close(m_listenSocket);
+}
+
+std::string TestableHTTP2Server::getEndpoint() const {
+    return "http://127.0.0.1:" + std::to_string(m_port);
+}
+
+bool TestableHTTP2Server::waitForEvent(std::chrono::milliseconds timeout, Event* event) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (!m_eventReceived.wait_for(lock, timeout, [this] { return !m_events.empty(); })) {
+        return false;
+    }
+    *event = m_events.front();
+    m_events.pop_front();
+    return true;
+}
+
+void TestableHTTP2Server::respond(uint32_t streamId, int statusCode) {
+    writeFrame(FRAME_TYPE_HEADERS, FLAG_END_HEADERS | FLAG_END_STREAM, streamId, encodeStatusHeaderBlock(statusCode));
+}
+
+void TestableHTTP2Server::serverLoop() {
+    int connectionSocket = accept(m_listenSocket, nullptr, nullptr);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (connectionSocket < 0) {
+            return;
+        }
+        m_connectionSocket = connectionSocket;
+        if (m_isStopping) {
+            shutdown(m_connectionSocket, SHUT_RDWR);
+            return;
+        }
+    }
+
+    if (!upgradeConnection()) {
+        ACSDK_ERROR(LX("serverLoopFailed").d("reason", "upgradeConnectionFailed"));
+        return;
+    }
+
+    char header[FRAME_HEADER_SIZE];
+    while (readExactly(header, sizeof(header))) {
+        auto bytes = reinterpret_cast<const uint8_t*>(header);
+        size_t length = (bytes[0] << 16) | (bytes[1] << 8) | bytes[2];
+        uint8_t type = bytes[3];
+        uint8_t flags = bytes[4];
+        uint32_t streamId = ((bytes[5] & 0x7f) << 24) | (bytes[6] << 16) | (bytes[7] << 8) | bytes[8];
+        std::string payload(length, '\0');
+        if (length > 0 && !readExactly(&payload[0], length)) {
+            break;
+        }
+        handleFrame(type, flags, streamId, payload);
+    }
+}
+
+bool TestableHTTP2Server::upgradeConnection() {
+    std::string request;
+    char c;
+    while (request.find(END_OF_HEADER) == std::string::npos) {
+        if (!readExactly(&c, 1)) {
+            return false;
+        }
+        request += c;
+    }
+    if (request.find(UPGRADE_H2C_HEADER) == std::string::npos) {
+        ACSDK_ERROR(LX("upgradeConnectionFailed").d("reason", "noUpgradeHeader"));
+        return false;
+    }
+
+    write(SWITCHING_PROTOCOLS_RESPONSE);
+    writeFrame(FRAME_TYPE_SETTINGS, 0, 0, "");
+
+    std::string preface(CLIENT_PREFACE.size(), '\0');
+    if (!readExactly(&preface[0], preface.size()) || preface != CLIENT_PREFACE) {
+        ACSDK_ERROR(LX("upgradeConnectionFailed").d("reason", "badClientPreface"));
+        return false;
+    }
+
+    writeFrame(FRAME_TYPE_HEADERS, FLAG_END_HEADERS, DOWNCHANNEL_STREAM_ID, encodeStatusHeaderBlock(STATUS_OK));
+    return true;
+}
+
+bool TestableHTTP2Server::readExactly(char* buffer, size_t size) {
+    while (size > 0) {
+        auto result = recv(m_connectionSocket, buffer, size, 0);
+        if (result <= 0) {
+            return false;
+        }
+        buffer += result;
+        size -= result;
+    }
+    return true;
+}
+
+void TestableHTTP2Server::write(const std::string& data) {
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    size_t written = 0;
+    while (written < data.size()) {
+        auto result = send(m_connectionSocket, data.data() + written, data.size() - written, MSG_NOSIGNAL);
+        if (result <= 0) {
+            return;
+        }
+        written += result;
+    }
+}
+
+void TestableHTTP2Server::writeFrame(uint8_t type, uint8_t flags, uint32_t streamId, const std::string& payload) {
+    auto length = encodeUint32(payload.size());
+    write(length.substr(1) + static_cast<char>(type) + static_cast<char>(flags) + encodeUint32(streamId) + payload);
+}
+
+void TestableHTTP2Server::handleFrame(uint8_t type, uint8_t flags, uint32_t streamId, const std::string& payload) {
+    switch (type) {
+        case FRAME_TYPE_DATA: {
+            std::string data = payload;
+            if ((flags & FLAG_PADDED) && !data.empty()) {
+                size_t padding = static_cast<uint8_t>(data[0]);
+                data = data.substr(1, data.size() - 1 - std::min(padding, data.size() - 1));
+            }
+            m_partialBodies[streamId] += data;
+            if (!payload.empty()) {
+                // Give back the flow control window used by the data.
+                writeFrame(FRAME_TYPE_WINDOW_UPDATE, 0, 0, encodeUint32(payload.size()));
+                if (!(flags & FLAG_END_STREAM)) {
+                    writeFrame(FRAME_TYPE_WINDOW_UPDATE, 0, streamId, encodeUint32(payload.size()));
+                }
+            }
+            if (flags & FLAG_END_STREAM) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_events.push_back({streamId, m_partialBodies[streamId]});
+                m_partialBodies.erase(streamId);
+                m_eventReceived.notify_all();
+            }
+            break;
+        }
+        case FRAME_TYPE_HEADERS:
+            if (flags & FLAG_END_STREAM) {
+                // A request without a body, such as a ping.
+                respond(streamId, STATUS_NO_CONTENT);
+            } else {
+                m_partialBodies[streamId].clear();
+            }
+            break;
+        case FRAME_TYPE_SETTINGS:
+            if (!(flags & FLAG_ACK)) {
+                writeFrame(FRAME_TYPE_SETTINGS, FLAG_ACK, 0, "");
+            }
+            break;
+        case FRAME_TYPE_PING:
+            if (!(flags & FLAG_ACK)) {
+                writeFrame(FRAME_TYPE_PING, FLAG_ACK, 0, payload);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+}  // namespace test
+}  // namespace acl
+}  // namespace alexaClientSDK
@@ -0,0 +1,180 @@
+/*
+ * Copyright 2017-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_ACL_TEST_TRANSPORT_COMMON_TESTABLEHTTP2SERVER_H_
+#define ALEXA_CLIENT_SDK_ACL_TEST_TRANSPORT_COMMON_TESTABLEHTTP2SERVER_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace alexaClientSDK {
+namespace acl {
+namespace test {
+
+/**
+ * A minimal HTTP/2 server on the loopback interface, for testing @c HTTP2Transport without a connection to AVS.
+ *
+ * It accepts a single cleartext connection upgraded from HTTP/1.1 (h2c), answers the downchannel request with 200
+ * straight away, and queues the events it receives so that a test can decide when and how to answer each one.  Only
+ * what @c HTTP2Transport needs is implemented: received header blocks are not decoded, and responses only carry a
+ * status.
+ */
+class TestableHTTP2Server {
+public:
+    /// An event received by the server.
+    struct Event {
+        /// The stream the event was sent on, with which to answer it.
+        uint32_t streamId;
+
+        /// The body of the request.
+        std::string body;
+    };
+
+    /**
+     * Create a server listening on an ephemeral port of the loopback interface.
+     *
+     * @return The server, or @c nullptr if it could not listen.
+     */
+    static std::unique_ptr<TestableHTTP2Server> create();
+
+    /**
+     * Destructor.  Closes the connection and stops the server.
+     */
+    ~TestableHTTP2Server();
+
+    /**
+     * Get the URL of this server, to use as the AVS endpoint.
+     *
+     * @return The URL of this server.
+     */
+    std::string getEndpoint() const;
+
+    /**
+     * Wait for the next event which has not been returned yet.
+     *
+     * @param timeout The maximum time to wait.
+     * @param[out] event The event.
+     * @return Whether an event was received before the timeout.
+     */
+    bool waitForEvent(std::chrono::milliseconds timeout, Event* event);
+
+    /**
+     * Answer an event.
+     *
+     * @param streamId The stream the event was sent on.
+     * @param statusCode The HTTP status code to answer with.
+     */
+    void respond(uint32_t streamId, int statusCode);
+
+private:
+    /**
+     * Constructor.  Starts the server thread.
+     *
+     * @param listenSocket The socket on which to accept the connection.
+     * @param port The port @c listenSocket is bound to.
+     */
+    TestableHTTP2Server(int listenSocket, int port);
+
+    /**
+     * The loop run by the server thread: accepts the connection, upgrades it, and handles frames until it closes.
+     */
+    void serverLoop();
+
+    /**
+     * Read the HTTP/1.1 request of the downchannel, switch the connection to HTTP/2 and answer the downchannel.
+     *
+     * @return Whether the connection was upgraded.
+     */
+    bool upgradeConnection();
+
+    /**
+     * Read an exact number of bytes from the connection.
+     *
+     * @param buffer Where to put the bytes.
+     * @param size The number of bytes to read.
+     * @return Whether all the bytes were read before the connection closed.
+     */
+    bool readExactly(char* buffer, size_t size);
+
+    /**
+     * Write bytes to the connection.
+     *
+     * @param data The bytes to write.
+     */
+    void write(const std::string& data);
+
+    /**
+     * Write an HTTP/2 frame to the connection.
+     *
+     * @param type The frame type.
+     * @param flags The frame flags.
+     * @param streamId The stream of the frame.
+     * @param payload The frame payload.
+     */
+    void writeFrame(uint8_t type, uint8_t flags, uint32_t streamId, const std::string& payload);
+
+    /**
+     * Handle an HTTP/2 frame received from the client.
+     *
+     * @param type The frame type.
+     * @param flags The frame flags.
+     * @param streamId The stream of the frame.
+     * @param payload The frame payload.
+     */
+    void handleFrame(uint8_t type, uint8_t flags, uint32_t streamId, const std::string& payload);
+
+    /// The socket on which the connection is accepted.
+    const int m_listenSocket;
+
+    /// The port the server listens on.
+    const int m_port;
+
+    /// The socket of the connection, or -1.  Serialized by @c m_mutex.
+    int m_connectionSocket;
+
+    /// Whether the server is stopping.  Serialized by @c m_mutex.
+    bool m_isStopping;
+
+    /// The bodies of the requests still being received, by stream.  Only accessed by the server thread.
+    std::map<uint32_t, std::string> m_partialBodies;
+
+    /// Events which have been received and not yet returned by @c waitForEvent().  Serialized by @c m_mutex.
+    std::deque<Event> m_events;
+
+    /// Serializes access to members.
+    std::mutex m_mutex;
+
+    /// Notified when an event is received.
+    std::condition_variable m_eventReceived;
+
+    /// Serializes writes to the connection.
+    std::mutex m_writeMutex;
+
+    /// The server thread.
+    std::thread m_thread;
+};
+
+}  // namespace test
+}  // namespace acl
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_ACL_TEST_TRANSPORT_COMMON_TESTABLEHTTP2SERVER_H_
@@ -0,0 +1,356 @@
+/*
+ * Copyright 2017-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file HTTP2TransportTest.cpp
+
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <ACL/Transport/HTTP2Transport.h>
+#include <ACL/Transport/PostConnectObject.h>
+#include <AVSCommon/AVS/Initialization/AlexaClientSDKInit.h>
+#include <AVSCommon/SDKInterfaces/MockContextManager.h>
+#include <AVSCommon/Utils/Logger/LoggerSinkManager.h>
+
+#include "Common/TestableHTTP2Server.h"
+#include "MockAuthDelegate.h"
+#include "MockTransportObserver.h"
+#include "TestableConsumer.h"
+
+namespace alexaClientSDK {
+namespace acl {
+namespace test {
+
+using namespace ::testing;
+using namespace transport;
+using namespace transport::test;
+using namespace avsCommon::avs;
+using namespace avsCommon::avs::attachment;
+using namespace avsCommon::avs::initialization;
+using namespace avsCommon::sdkInterfaces;
+using namespace avsCommon::sdkInterfaces::test;
+using namespace avsCommon::utils::logger;
+
+/// The context given to the post-connect message.
+static const std::string CONTEXT = R"({"context":[]})";
+
+/// The auth token given to the transport.
+static const std::string AUTH_TOKEN = "test_auth_token";
+
+/// The name of the event sent by the post-connect message.
+static const std::string SYNCHRONIZE_STATE = "SynchronizeState";
+
+/// The name of the event sent by the tests once connected.
+static const std::string TEST_EVENT = "TestEvent";
+
+/// The content of the event sent by the tests once connected.
+static const std::string TEST_EVENT_CONTENT = R"({"event":{"header":{"name":")" + TEST_EVENT + R"("}}})";
+
+/// The log event reporting that the connection is ready.
+static const std::string CONNECTION_READY = "connectionReady";
+
+/// The key of the log entry holding the time from the TCP connection to the connection being ready.
+static const std::string TIME_FROM_TCP_CONNECT_TO_READY_KEY = "timeFromTcpConnectToReadyMs=";
+
+/// The HTTP status for a successful post-connect message.
+static const int HTTP_NO_CONTENT = 204;
+
+/// The HTTP status for a failed post-connect message.
+static const int HTTP_SERVER_ERROR = 500;
+
+/// Timeout for things which are expected to happen.
+static const std::chrono::milliseconds TIMEOUT(5000);
+
+/// Time to wait for things which are expected not to happen.
+static const std::chrono::milliseconds NEGATIVE_TIMEOUT(500);
+
+/**
+ * A log sink which keeps the logs of the connection becoming ready.
+ */
+class ConnectionReadyLogger : public Logger {
+public:
+    /**
+     * Constructor.
+     */
+    ConnectionReadyLogger() : Logger(Level::INFO) {
+    }
+
+    void emit(Level level, std::chrono::system_clock::time_point time, const char* threadMoniker, const char* text)
+        override {
+        std::string line(text);
+        if (line.find(CONNECTION_READY) == std::string::npos) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_lines.push_back(line);
+        m_wakeTrigger.notify_all();
+    }
+
+    /**
+     * Wait for a log of the connection becoming ready.
+     *
+     * @param timeout The maximum time to wait.
+     * @param[out] line The log line.
+     * @return Whether the connection became ready before the timeout.
+     */
+    bool waitForConnectionReady(std::chrono::milliseconds timeout, std::string* line) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (!m_wakeTrigger.wait_for(lock, timeout, [this] { return !m_lines.empty(); })) {
+            return false;
+        }
+        *line = m_lines.front();
+        return true;
+    }
+
+private:
+    /// Serializes access to @c m_lines.
+    std::mutex m_mutex;
+
+    /// Notified when a line is kept.
+    std::condition_variable m_wakeTrigger;
+
+    /// The logs of the connection becoming ready.
+    std::vector<std::string> m_lines;
+};
+
+/**
+ * Mock @c MessageRequestObserverInterface, used to check how an event was completed.
+ */
+class MockMessageRequestObserver : public MessageRequestObserverInterface {
+public:
+    MOCK_METHOD1(onSendCompleted, void(MessageRequestObserverInterface::Status status));
+    MOCK_METHOD1(onExceptionReceived, void(const std::string& exceptionMessage));
+};
+
+/**
+ * Our GTest class.
+ */
+class HTTP2TransportTest : public ::testing::Test {
+public:
+    void SetUp() override;
+
+    void TearDown() override;
+
+    /**
+     * Wait for the next event received by the server.
+     *
+     * @param name The name the event is expected to have.
+     * @return The stream the event was received on, or 0 if it was not received.
+     */
+    uint32_t waitForEvent(const std::string& name);
+
+    /**
+     * Wait for the transport to report that it is connected.
+     *
+     * @param timeout The maximum time to wait.
+     * @return Whether the transport reported that it is connected before the timeout.
+     */
+    bool waitForConnected(std::chrono::milliseconds timeout);
+
+    /// Answers context requests from a separate thread, as the @c ContextManager does.
+    void answerContextRequest(std::shared_ptr<ContextRequesterInterface> contextRequester);
+
+    /// The server standing in for AVS.
+    std::unique_ptr<TestableHTTP2Server> m_server;
+
+    /// The log sink used to check when the connection becomes ready.
+    std::shared_ptr<ConnectionReadyLogger> m_logger;
+
+    /// The mock @c ContextManager which provides the context of the post-connect message.
+    std::shared_ptr<NiceMock<MockContextManager>> m_mockContextManager;
+
+    /// The mock @c AuthDelegate.
+    std::shared_ptr<NiceMock<MockAuthDelegate>> m_mockAuthDelegate;
+
+    /// The mock observer of the transport.
+    std::shared_ptr<NiceMock<MockTransportObserver>> m_mockTransportObserver;
+
+    /// The transport being tested.
+    std::shared_ptr<HTTP2Transport> m_transport;
+
+    /// Serializes access to @c m_contextThreads and @c m_isConnected.
+    std::mutex m_mutex;
+
+    /// Notified when the transport reports that it is connected.
+    std::condition_variable m_wakeTrigger;
+
+    /// Whether the transport reported that it is connected.
+    bool m_isConnected = false;
+
+    /// The threads answering context requests.
+    std::vector<std::thread> m_contextThreads;
+};
+
+void HTTP2TransportTest::SetUp() {
+    AlexaClientSDKInit::initialize(std::vector<std::istream*>());
+    m_logger = std::make_shared<ConnectionReadyLogger>();
+    LoggerSinkManager::instance().initialize(m_logger);
+
+    m_server = TestableHTTP2Server::create();
+    ASSERT_TRUE(m_server);
+
+    m_mockContextManager = std::make_shared<NiceMock<MockContextManager>>();
+    ON_CALL(*m_mockContextManager, getContext(_))
+        .WillByDefault(Invoke(this, &HTTP2TransportTest::answerContextRequest));
+    PostConnectObject::init(m_mockContextManager);
+
+    m_mockAuthDelegate = std::make_shared<NiceMock<MockAuthDelegate>>();
+    ON_CALL(*m_mockAuthDelegate, getAuthToken()).WillByDefault(Return(AUTH_TOKEN));
+
+    m_mockTransportObserver = std::make_shared<NiceMock<MockTransportObserver>>();
+    ON_CALL(*m_mockTransportObserver, onConnected(_)).WillByDefault(InvokeWithoutArgs([this] {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isConnected = true;
+        m_wakeTrigger.notify_all();
+    }));
+
+    m_transport = HTTP2Transport::create(
+        m_mockAuthDelegate,
+        m_server->getEndpoint(),
+        std::make_shared<TestableConsumer>(),
+        std::make_shared<AttachmentManager>(AttachmentManager::AttachmentType::IN_PROCESS),
+        m_mockTransportObserver);
+    ASSERT_TRUE(m_transport);
+    ASSERT_TRUE(m_transport->connect());
+}
+
+void HTTP2TransportTest::TearDown() {
+    if (m_transport) {
+        m_transport->shutdown();
+    }
+    std::vector<std::thread> contextThreads;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::swap(contextThreads, m_contextThreads);
+    }
+    for (auto& thread : contextThreads) {
+        thread.join();
+    }
+    m_server.reset();
+    PostConnectObject::init(nullptr);
+    LoggerSinkManager::instance().initialize(ACSDK_GET_SINK_LOGGER());
+    AlexaClientSDKInit::uninitialize();
+}
+
+uint32_t HTTP2TransportTest::waitForEvent(const std::string& name) {
+    TestableHTTP2Server::Event event;
+    if (!m_server->waitForEvent(TIMEOUT, &event)) {
+        ADD_FAILURE() << "no event received, expected " << name;
+        return 0;
+    }
+    EXPECT_NE(std::string::npos, event.body.find(name)) << "expected " << name << " in: " << event.body;
+    return event.streamId;
+}
+
+bool HTTP2TransportTest::waitForConnected(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return m_wakeTrigger.wait_for(lock, timeout, [this] { return m_isConnected; });
+}
+
+void HTTP2TransportTest::answerContextRequest(std::shared_ptr<ContextRequesterInterface> contextRequester) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_contextThreads.emplace_back([contextRequester] { contextRequester->onContextAvailable(CONTEXT); });
+}
+
+/**
+ * Verify that an event can be sent while SynchronizeState is in flight, that it goes out once SynchronizeState
+ * succeeds, and that the transport is only reported connected at that point.
+ */
+TEST_F(HTTP2TransportTest, eventQueuedWhileSynchronizeStateIsInFlight) {
+    auto synchronizeStateStreamId = waitForEvent(SYNCHRONIZE_STATE);
+    ASSERT_NE(0u, synchronizeStateStreamId);
+
+    auto request = std::make_shared<MessageRequest>(TEST_EVENT_CONTENT);
+    auto requestObserver = std::make_shared<NiceMock<MockMessageRequestObserver>>();
+    EXPECT_CALL(*requestObserver, onSendCompleted(MessageRequestObserverInterface::Status::NOT_CONNECTED)).Times(0);
+    request->addObserver(requestObserver);
+    m_transport->send(request);
+
+    TestableHTTP2Server::Event event;
+    EXPECT_FALSE(m_server->waitForEvent(NEGATIVE_TIMEOUT, &event)) << "event sent ahead of SynchronizeState";
+    EXPECT_FALSE(m_transport->isConnected());
+
+    m_server->respond(synchronizeStateStreamId, HTTP_NO_CONTENT);
+    ASSERT_TRUE(waitForConnected(TIMEOUT));
+    auto testEventStreamId = waitForEvent(TEST_EVENT);
+    ASSERT_NE(0u, testEventStreamId);
+    m_server->respond(testEventStreamId, HTTP_NO_CONTENT);
+}
+
+/**
+ * Verify that an event queued while SynchronizeState is in flight is completed with @c NOT_CONNECTED when
+ * SynchronizeState fails, that the transport is not reported connected, and that a retried SynchronizeState which
+ * succeeds makes it connected.
+ */
+TEST_F(HTTP2TransportTest, eventFailedWhenSynchronizeStateFails) {
+    auto synchronizeStateStreamId = waitForEvent(SYNCHRONIZE_STATE);
+    ASSERT_NE(0u, synchronizeStateStreamId);
+
+    auto request = std::make_shared<MessageRequest>(TEST_EVENT_CONTENT);
+    auto requestObserver = std::make_shared<NiceMock<MockMessageRequestObserver>>();
+    std::promise<void> notConnectedPromise;
+    EXPECT_CALL(*requestObserver, onSendCompleted(MessageRequestObserverInterface::Status::NOT_CONNECTED))
+        .WillOnce(InvokeWithoutArgs([&notConnectedPromise] { notConnectedPromise.set_value(); }));
+    request->addObserver(requestObserver);
+    m_transport->send(request);
+
+    m_server->respond(synchronizeStateStreamId, HTTP_SERVER_ERROR);
+    EXPECT_EQ(std::future_status::ready, notConnectedPromise.get_future().wait_for(TIMEOUT));
+    EXPECT_FALSE(m_transport->isConnected());
+
+    auto retryStreamId = waitForEvent(SYNCHRONIZE_STATE);
+    ASSERT_NE(0u, retryStreamId);
+
+    TestableHTTP2Server::Event event;
+    EXPECT_FALSE(m_server->waitForEvent(NEGATIVE_TIMEOUT, &event)) << "failed event sent";
+    EXPECT_FALSE(m_transport->isConnected());
+
+    m_server->respond(retryStreamId, HTTP_NO_CONTENT);
+    ASSERT_TRUE(waitForConnected(TIMEOUT));
+    m_transport->send(std::make_shared<MessageRequest>(TEST_EVENT_CONTENT));
+    auto testEventStreamId = waitForEvent(TEST_EVENT);
+    ASSERT_NE(0u, testEventStreamId);
+    m_server->respond(testEventStreamId, HTTP_NO_CONTENT);
+}
+
+/**
+ * Verify that the time from the TCP connection to the connection being ready is logged.
+ */
+TEST_F(HTTP2TransportTest, timeFromTcpConnectToReadyIsLogged) {
+    auto synchronizeStateStreamId = waitForEvent(SYNCHRONIZE_STATE);
+    ASSERT_NE(0u, synchronizeStateStreamId);
+    m_server->respond(synchronizeStateStreamId, HTTP_NO_CONTENT);
+
+    std::string line;
+    ASSERT_TRUE(m_logger->waitForConnectionReady(TIMEOUT, &line));
+    auto position = line.find(TIME_FROM_TCP_CONNECT_TO_READY_KEY);
+    ASSERT_NE(std::string::npos, position) << line;
+    auto timeFromTcpConnectToReadyMs = std::stoll(line.substr(position + TIME_FROM_TCP_CONNECT_TO_READY_KEY.size()));
+    EXPECT_GE(timeFromTcpConnectToReadyMs, 0);
+    EXPECT_LT(timeFromTcpConnectToReadyMs, TIMEOUT.count());
+}
+
+}  // namespace test
+}  // namespace acl
+}  // namespace alexaClientSDK
@@ -0,0 +1,131 @@
+/*
+ * Copyright 2017-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file PostConnectContextCacheTest.cpp
+
+#include <memory>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <ACL/Transport/PostConnectContextCache.h>
+#include <AVSCommon/SDKInterfaces/MockContextManager.h>
+
+namespace alexaClientSDK {
+namespace acl {
+namespace test {
+
+using namespace ::testing;
+using namespace avsCommon::sdkInterfaces;
+using namespace avsCommon::sdkInterfaces::test;
+
+/// A context as built by the @c ContextManager.
+static const std::string CONTEXT = R"({"context":[]})";
+
+/// Another context as built by the @c ContextManager.
+static const std::string OTHER_CONTEXT = R"({"context":[{"header":{},"payload":{}}]})";
+
+/**
+ * Our GTest class.
+ */
+class PostConnectContextCacheTest : public ::testing::Test {
+public:
+    void SetUp() override;
+
+    /// The mock @c ContextManager from which the cache gets the context.
+    std::shared_ptr<NiceMock<MockContextManager>> m_mockContextManager;
+
+    /// The cache being tested.
+    std::shared_ptr<PostConnectContextCache> m_contextCache;
+};
+
+void PostConnectContextCacheTest::SetUp() {
+    m_mockContextManager = std::make_shared<NiceMock<MockContextManager>>();
+    EXPECT_CALL(*m_mockContextManager, addContextManagerObserver(_)).Times(1);
+    EXPECT_CALL(*m_mockContextManager, getContext(_)).Times(1);
+    m_contextCache = PostConnectContextCache::create(m_mockContextManager);
+    ASSERT_TRUE(m_contextCache);
+    Mock::VerifyAndClearExpectations(m_mockContextManager.get());
+}
+
+/**
+ * Verify that the cache can't be created without a @c ContextManager.
+ */
+TEST_F(PostConnectContextCacheTest, createWithNullContextManager) {
+    EXPECT_FALSE(PostConnectContextCache::create(nullptr));
+}
+
+/**
+ * Verify that the context built on creation is kept.
+ */
+TEST_F(PostConnectContextCacheTest, contextIsCached) {
+    EXPECT_TRUE(m_contextCache->getContext().empty());
+    m_contextCache->onContextAvailable(CONTEXT);
+    EXPECT_EQ(CONTEXT, m_contextCache->getContext());
+}
+
+/**
+ * Verify that a change discards the cached context and builds it again.
+ */
+TEST_F(PostConnectContextCacheTest, changeRebuildsContext) {
+    m_contextCache->onContextAvailable(CONTEXT);
+
+    EXPECT_CALL(*m_mockContextManager, getContext(_)).Times(1);
+    m_contextCache->onContextChanged();
+    EXPECT_TRUE(m_contextCache->getContext().empty());
+
+    m_contextCache->onContextAvailable(OTHER_CONTEXT);
+    EXPECT_EQ(OTHER_CONTEXT, m_contextCache->getContext());
+}
+
+/**
+ * Verify that a context requested before a change is not cached, and that changes while a request is in progress
+ * result in a single new request.
+ */
+TEST_F(PostConnectContextCacheTest, changeDuringRefreshRebuildsContextOnce) {
+    EXPECT_CALL(*m_mockContextManager, getContext(_)).Times(1);
+    m_contextCache->onContextChanged();
+    m_contextCache->onContextChanged();
+
+    m_contextCache->onContextAvailable(CONTEXT);
+    EXPECT_TRUE(m_contextCache->getContext().empty());
+
+    m_contextCache->onContextAvailable(OTHER_CONTEXT);
+    EXPECT_EQ(OTHER_CONTEXT, m_contextCache->getContext());
+}
+
+/**
+ * Verify that after a failure, the next change builds the context again.
+ */
+TEST_F(PostConnectContextCacheTest, failureLeavesCacheEmpty) {
+    m_contextCache->onContextFailure(ContextRequestError::STATE_PROVIDER_TIMEDOUT);
+    EXPECT_TRUE(m_contextCache->getContext().empty());
+
+    EXPECT_CALL(*m_mockContextManager, getContext(_)).Times(1);
+    m_contextCache->onContextChanged();
+    m_contextCache->onContextAvailable(CONTEXT);
+    EXPECT_EQ(CONTEXT, m_contextCache->getContext());
+}
+
+/**
+ * Verify that detaching stops observing the @c ContextManager.
+ */
+TEST_F(PostConnectContextCacheTest, detachRemovesObserver) {
+    EXPECT_CALL(*m_mockContextManager, removeContextManagerObserver(_)).Times(1);
+    m_contextCache->detach();
+}
+
+}  // namespace test
+}  // namespace acl
+}  // namespace alexaClientSDK
@@ -0,0 +1,153 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file
+ * Converts 10 ms capture buffers of a tone for common device formats with @c AudioFrontEnd and reports the number of
+ * filter taps per output sample and the CPU time per buffer for each.
+ *
+ * USAGE: AudioFrontEndBenchmark [number_of_buffers]
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "AVSCommon/AVS/AudioFrontEnd.h"
+
+using namespace alexaClientSDK::avsCommon::avs;
+using namespace alexaClientSDK::avsCommon::utils;
+
+/// The word size of the output stream.
+static const size_t WORD_SIZE = sizeof(int16_t);
+
+/// The number of words in the output stream buffer.
+static const size_t BUFFER_WORDS = AudioFrontEnd::OUTPUT_SAMPLE_RATE_HZ;
+
+/// The number of readers of the output stream.
+static const size_t MAX_READERS = 1;
+
+/// The duration of one capture buffer.
+static const std::chrono::milliseconds BUFFER_DURATION(10);
+
+/// The default number of capture buffers converted for each format.
+static const size_t DEFAULT_NUM_BUFFERS = 1000;
+
+/// Amplitude of the tone.
+static const double TONE_AMPLITUDE = 10000;
+
+/// Frequency of the tone.
+static const double TONE_FREQUENCY_HZ = 1000;
+
+/// Pi.
+static const double PI = 3.14159265358979323846;
+
+/// A device format to measure.
+struct Case {
+    /// The sample rate.
+    unsigned int sampleRateHz;
+
+    /// The number of interleaved channels.
+    unsigned int numChannels;
+};
+
+/// The formats measured.
+static const std::vector<Case> CASES = {{16000, 1}, {16000, 2}, {8000, 1}, {44100, 2}, {48000, 2}, {48000, 8}};
+
+/**
+ * Build a 16-bit interleaved LPCM format.
+ *
+ * @param sampleRateHz The sample rate.
+ * @param numChannels The number of channels.
+ * @return The format.
+ */
+static AudioFormat makeFormat(unsigned int sampleRateHz, unsigned int numChannels) {
+    AudioFormat format;
+    format.encoding = AudioFormat::Encoding::LPCM;
+    format.endianness = AudioFormat::Endianness::LITTLE;
+    format.sampleRateHz = sampleRateHz;
+    format.sampleSizeInBits = 16;
+    format.numChannels = numChannels;
+    format.dataSigned = true;
+    format.layout = AudioFormat::Layout::INTERLEAVED;
+    return format;
+}
+
+/**
+ * Measure the conversion of one format.
+ *
+ * @param testCase The format.
+ * @param numBuffers The number of capture buffers to convert.
+ * @return Whether every buffer was converted.
+ */
+static bool run(const Case& testCase, size_t numBuffers) {
+    auto size = AudioInputStream::calculateBufferSize(BUFFER_WORDS, WORD_SIZE, MAX_READERS);
+    auto stream = AudioInputStream::create(std::make_shared<AudioInputStream::Buffer>(size), WORD_SIZE, MAX_READERS);
+    if (!stream) {
+        return false;
+    }
+    std::shared_ptr<AudioInputStream::Writer> writer =
+        stream->createWriter(AudioInputStream::Writer::Policy::NONBLOCKABLE);
+    auto frontEnd = AudioFrontEnd::create(makeFormat(testCase.sampleRateHz, testCase.numChannels), writer);
+    if (!frontEnd) {
+        return false;
+    }
+
+    size_t framesPerBuffer = testCase.sampleRateHz * BUFFER_DURATION.count() / 1000;
+    std::vector<int16_t> input(framesPerBuffer * testCase.numChannels);
+    for (size_t i = 0; i < input.size(); ++i) {
+        input[i] = static_cast<int16_t>(
+            TONE_AMPLITUDE * std::sin(2 * PI * TONE_FREQUENCY_HZ * (i / testCase.numChannels) / testCase.sampleRateHz));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < numBuffers; ++i) {
+        if (frontEnd->write(input.data(), framesPerBuffer) != static_cast<ssize_t>(framesPerBuffer)) {
+            return false;
+        }
+    }
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << std::setw(14) << testCase.sampleRateHz << std::setw(10) << testCase.numChannels << std::setw(14)
+              << frontEnd->getTapsPerPhase() << std::setw(14) << elapsed.count() / numBuffers << std::endl;
+    return true;
+}
+
+int main(int argc, char** argv) {
+    size_t numBuffers = DEFAULT_NUM_BUFFERS;
+    if (argc > 1) {
+        numBuffers = std::strtoul(argv[1], nullptr, 10);
+    }
+    if (argc > 2 || !numBuffers) {
+        std::cerr << "USAGE: " << std::string(argv[0]) << " [number_of_buffers]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << std::setw(14) << "sampleRateHz" << std::setw(10) << "channels" << std::setw(14) << "tapsPerPhase"
+              << std::setw(14) << "usPerBuffer" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    for (const auto& testCase : CASES) {
+        if (!run(testCase, numBuffers)) {
+            std::cerr << "Unable to convert " << testCase.sampleRateHz << " Hz, " << testCase.numChannels
+                      << " channels" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    return EXIT_SUCCESS;
+}
@@ -18,6 +18,7 @@
 
 #include <chrono>
 #include <cstddef>
+#include <functional>
 
 #include "AVSCommon/Utils/SDS/ReaderPolicy.h"
 
@@ -59,6 +60,16 @@ public:
         AFTER_DRAINING_CURRENT_BUFFER
     };
 
+    /// An enum class to communicate the possible results of a @c waitForData() call.
+    enum class WaitStatus {
+        /// Data is available, or the reader has closed, so a @c read() will return without waiting.
+        READY,
+        /// No data became available before the timeout.
+        TIMEDOUT,
+        /// This reader can't wait for data, so the caller should poll with @c read() instead.
+        UNSUPPORTED
+    };
+
     /*
      * Destructor.
      */
@@ -80,6 +91,31 @@ public:
         ReadStatus* readStatus,
         std::chrono::milliseconds timeoutMs = std::chrono::milliseconds(0)) = 0;
 
+    /**
+     * Wait until a @c read() would return without waiting, without consuming any data.  This lets a consumer using a
+     * @c NONBLOCKING reader sleep until data arrives instead of polling.  The default implementation does not support
+     * waiting.
+     *
+     * @param timeoutMs The maximum time to wait in milliseconds.  If this is zero, wait with no timeout.
+     * @return Whether data is ready, the wait timed out, or the reader does not support waiting.
+     */
+    virtual WaitStatus waitForData(std::chrono::milliseconds timeoutMs) {
+        return WaitStatus::UNSUPPORTED;
+    }
+
+    /**
+     * Set a function to call when a @c read() may return without waiting, so that a consumer can wait for data in its
+     * own event loop instead of polling or blocking a thread in @c waitForData().  The function is called on the
+     * thread which wrote to or closed the attachment, so it must not block.  Once this returns, a function set
+     * previously will not be called again.  The default implementation does not support this.
+     *
+     * @param callback The function to call, or @c nullptr to stop calling one.
+     * @return Whether the function will be called.
+     */
+    virtual bool setDataAvailableCallback(std::function<void()> callback) {
+        return false;
+    }
+
     /**
      * The seek function.
      *
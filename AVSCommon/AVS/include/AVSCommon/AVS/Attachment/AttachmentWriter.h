@@ -18,6 +18,7 @@
 
 #include <chrono>
 #include <cstddef>
+#include <functional>
 
 namespace alexaClientSDK {
 namespace avsCommon {
@@ -75,6 +76,19 @@ public:
      * needs to use an attachment.
      */
     virtual void close() = 0;
+
+    /**
+     * Set a function to call when a @c write() which found the attachment full may now succeed, so that a producer
+     * which cannot block can wait for space without polling.  The function is called when a reader frees some space
+     * or the writer is closed, on the thread which did so, so it must not block.  Once this returns, a function set
+     * previously will not be called again.  The default implementation does not support this.
+     *
+     * @param callback The function to call, or @c nullptr to stop calling one.
+     * @return Whether the function will be called.
+     */
+    virtual bool setSpaceAvailableCallback(std::function<void()> callback) {
+        return false;
+    }
 };
 
 }  // namespace attachment
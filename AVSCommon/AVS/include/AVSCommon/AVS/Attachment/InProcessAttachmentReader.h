@@ -67,6 +67,10 @@ public:
         ReadStatus* readStatus,
         std::chrono::milliseconds timeoutMs = std::chrono::milliseconds(0)) override;
 
+    WaitStatus waitForData(std::chrono::milliseconds timeoutMs) override;
+
+    bool setDataAvailableCallback(std::function<void()> callback) override;
+
     void close(ClosePoint closePoint = ClosePoint::AFTER_DRAINING_CURRENT_BUFFER) override;
 
     bool seek(uint64_t offset) override;
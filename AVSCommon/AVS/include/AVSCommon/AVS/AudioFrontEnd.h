@@ -0,0 +1,152 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVSCOMMON_AVS_INCLUDE_AVSCOMMON_AVS_AUDIOFRONTEND_H_
+#define ALEXA_CLIENT_SDK_AVSCOMMON_AVS_INCLUDE_AVSCOMMON_AVS_AUDIOFRONTEND_H_
+
+#include <memory>
+#include <vector>
+
+#include "AVSCommon/AVS/AudioInputStream.h"
+#include "AVSCommon/Utils/AudioFormat.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace avs {
+
+/**
+ * An @c AudioFrontEnd converts the audio captured from a device into the 16 kHz, 16-bit, mono LPCM which AIP, ESP and
+ * the keyword detectors expect, and writes it to an @c AudioInputStream.
+ *
+ * The input may have any sample rate and any number of interleaved channels.  One channel is selected, or all channels
+ * are mixed down, and the result is resampled with a windowed-sinc polyphase filter.  Conversion happens on the
+ * caller's thread inside @c write(), so a capture callback can simply hand each buffer it receives to the front end in
+ * place of calling @c AudioInputStream::Writer::write() directly.
+ *
+ * The filter is stored one phase at a time, reversed, so each output sample is a single dot product over contiguous
+ * floats, which is computed with SSE or NEON where the target has them.
+ *
+ * This class is not thread-safe; @c write() must be called from one thread at a time.
+ */
+class AudioFrontEnd {
+public:
+    /// Value for @c channel in @c create() which selects a mix of all the input channels.
+    static const int MIX_ALL_CHANNELS = -1;
+
+    /// The sample rate of the output.
+    static const unsigned int OUTPUT_SAMPLE_RATE_HZ = 16000;
+
+    /**
+     * Creates a new @c AudioFrontEnd instance.
+     *
+     * @param inputFormat The format of the audio passed to @c write().  This must be 16-bit, interleaved,
+     *     little-endian LPCM.
+     * @param writer The writer to write the converted audio to.  Its stream must have a word size of 2 bytes.
+     * @param channel The zero-based input channel to keep, or @c MIX_ALL_CHANNELS to mix all channels.
+     * @return A @c std::unique_ptr to the new @c AudioFrontEnd, or @c nullptr if the operation failed.
+     */
+    static std::unique_ptr<AudioFrontEnd> create(
+        const utils::AudioFormat& inputFormat,
+        std::shared_ptr<AudioInputStream::Writer> writer,
+        int channel = MIX_ALL_CHANNELS);
+
+    /**
+     * Convert a buffer of interleaved input frames and write the result to the output stream.  Because of resampling,
+     * the number of samples written varies from call to call; any remainder is carried over to the next call.
+     *
+     * @param frames The interleaved input samples.
+     * @param numFrames The number of input frames (samples per channel) in @c frames.
+     * @return The number of input frames consumed, or one of the @c AudioInputStream::Writer::Error values if the
+     *     converted audio could not be written.
+     */
+    ssize_t write(const int16_t* frames, size_t numFrames);
+
+    /**
+     * Get the number of taps in each phase of the resampling filter, which is the number of multiply-adds per output
+     * sample.  This is zero if the input is already at the output sample rate.
+     *
+     * @return The number of taps per phase.
+     */
+    size_t getTapsPerPhase() const;
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param numChannels The number of interleaved input channels.
+     * @param channel The input channel to keep, or @c MIX_ALL_CHANNELS.
+     * @param interpolation The factor by which the input is upsampled.
+     * @param decimation The factor by which the upsampled input is downsampled.
+     * @param writer The writer to write the converted audio to.
+     */
+    AudioFrontEnd(
+        unsigned int numChannels,
+        int channel,
+        unsigned int interpolation,
+        unsigned int decimation,
+        std::shared_ptr<AudioInputStream::Writer> writer);
+
+    /**
+     * Design the polyphase filter for the configured interpolation and decimation factors.
+     */
+    void designFilter();
+
+    /**
+     * Resample the mono samples in @c m_history into @c m_output.
+     */
+    void resample();
+
+    /// The number of interleaved input channels.
+    const unsigned int m_numChannels;
+
+    /// The input channel to keep, or @c MIX_ALL_CHANNELS.
+    const int m_channel;
+
+    /// The factor by which the input is upsampled.
+    const unsigned int m_interpolation;
+
+    /// The factor by which the upsampled input is downsampled.
+    const unsigned int m_decimation;
+
+    /// The writer to write the converted audio to.
+    std::shared_ptr<AudioInputStream::Writer> m_writer;
+
+    /// The number of taps in each phase of the filter.
+    size_t m_tapsPerPhase;
+
+    /// The filter coefficients, @c m_tapsPerPhase for each of the @c m_interpolation phases, each phase reversed.
+    std::vector<float> m_coefficients;
+
+    /**
+     * Mono input samples, including at least the @c m_tapsPerPhase - 1 samples before the next one to be filtered.
+     * Samples which are no longer needed are dropped from the front in batches.
+     */
+    std::vector<float> m_history;
+
+    /// The phase of the next output sample.
+    unsigned int m_phase;
+
+    /// The index in @c m_history of the newest input sample used for the next output sample.
+    size_t m_nextInput;
+
+    /// The converted samples waiting to be written.
+    std::vector<int16_t> m_output;
+};
+
+}  // namespace avs
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVSCOMMON_AVS_INCLUDE_AVSCOMMON_AVS_AUDIOFRONTEND_H_
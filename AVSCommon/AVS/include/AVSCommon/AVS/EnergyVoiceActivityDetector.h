@@ -0,0 +1,56 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVSCOMMON_AVS_INCLUDE_AVSCOMMON_AVS_ENERGYVOICEACTIVITYDETECTOR_H_
+#define ALEXA_CLIENT_SDK_AVSCOMMON_AVS_INCLUDE_AVSCOMMON_AVS_ENERGYVOICEACTIVITYDETECTOR_H_
+
+#include "AVSCommon/SDKInterfaces/VoiceActivityDetectorInterface.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace avs {
+
+/**
+ * A simple frame-energy voice activity detector.  A frame is classified as speech when its energy is above an absolute
+ * floor and sufficiently above a running estimate of the background noise level.  The noise estimate follows the
+ * quietest frames immediately and rises slowly otherwise, so it adapts to steady background noise without being pulled
+ * up by speech.
+ *
+ * This is the fallback detector for devices without an ESP library; see @c esp::ESPVoiceActivityDetector.
+ */
+class EnergyVoiceActivityDetector : public sdkInterfaces::VoiceActivityDetectorInterface {
+public:
+    /**
+     * Constructor.
+     */
+    EnergyVoiceActivityDetector();
+
+    /// @name VoiceActivityDetectorInterface methods
+    /// @{
+    size_t getFrameSize() const override;
+    void reset() override;
+    bool isSpeech(const int16_t* frame) override;
+    /// @}
+
+private:
+    /// The current estimate of the background noise level in dB.
+    double m_noiseFloorDb;
+};
+
+}  // namespace avs
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVSCOMMON_AVS_INCLUDE_AVSCOMMON_AVS_ENERGYVOICEACTIVITYDETECTOR_H_
@@ -155,6 +155,27 @@ std::size_t InProcessAttachmentReader::read(
     return bytesRead;
 }
 
+AttachmentReader::WaitStatus InProcessAttachmentReader::waitForData(std::chrono::milliseconds timeoutMs) {
+    if (!m_reader) {
+        // A read will return CLOSED immediately.
+        return WaitStatus::READY;
+    }
+    if (timeoutMs.count() < 0) {
+        ACSDK_ERROR(LX("waitForDataFailed").d("reason", "negative timeout"));
+        return WaitStatus::TIMEDOUT;
+    }
+    return m_reader->waitForData(timeoutMs) ? WaitStatus::READY : WaitStatus::TIMEDOUT;
+}
+
+bool InProcessAttachmentReader::setDataAvailableCallback(std::function<void()> callback) {
+    if (!m_reader) {
+        ACSDK_ERROR(LX("setDataAvailableCallbackFailed").d("reason", "closed or uninitialized SDS"));
+        return false;
+    }
+    m_reader->setDataAvailableCallback(std::move(callback));
+    return true;
+}
+
 void InProcessAttachmentReader::close(ClosePoint closePoint) {
     if (m_reader) {
         switch (closePoint) {
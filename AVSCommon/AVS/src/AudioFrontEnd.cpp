@@ -0,0 +1,322 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
+#include "AVSCommon/AVS/AudioFrontEnd.h"
+#include "AVSCommon/Utils/Logger/Logger.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace avs {
+
+using namespace utils;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("AudioFrontEnd");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+const int AudioFrontEnd::MIX_ALL_CHANNELS;
+const unsigned int AudioFrontEnd::OUTPUT_SAMPLE_RATE_HZ;
+
+/// The only supported sample size for input and output.
+static const unsigned int SAMPLE_SIZE_IN_BITS = 16;
+
+/// Half the number of filter taps per phase, for each multiple of the output rate in the input rate.
+static const size_t HALF_TAPS = 16;
+
+/// The largest supported upsampling factor, which bounds the size of the filter for unusual sample rates.
+static const unsigned int MAX_INTERPOLATION = 1024;
+
+/// The filter cutoff as a fraction of the lower of the input and output Nyquist frequencies.
+static const double CUTOFF_FRACTION = 0.9;
+
+/// Pi.
+static const double PI = 3.14159265358979323846;
+
+/// The number of filtered samples at the start of @c m_history after which they are dropped in one go.
+static const size_t HISTORY_COMPACTION_THRESHOLD = 4096;
+
+/**
+ * Compute the greatest common divisor of two numbers.
+ *
+ * @param a The first number.
+ * @param b The second number.
+ * @return The greatest common divisor of @c a and @c b.
+ */
+static unsigned int gcd(unsigned int a, unsigned int b) {
+    while (b) {
+        auto remainder = a % b;
+        a = b;
+        b = remainder;
+    }
+    return a;
+}
+
+/**
+ * Round a sample to the nearest 16-bit value.
+ *
+ * @param sample The sample to convert.
+ * @return @c sample, rounded and clipped to the range of @c int16_t.
+ */
+static int16_t toInt16(float sample) {
+    return static_cast<int16_t>(std::max(
+        static_cast<float>(INT16_MIN), std::min(static_cast<float>(INT16_MAX), std::round(sample))));
+}
+
+/**
+ * Compute one output sample as the dot product of a phase of the filter with the input samples it lines up with.  The
+ * products are summed into several independent accumulators, using SSE or NEON where the target has them, so that
+ * consecutive multiply-adds do not wait on each other.
+ *
+ * @param coefficients The taps of the phase.
+ * @param input The input samples, oldest first.
+ * @param numTaps The number of taps.
+ * @return The output sample.
+ */
+static float dotProduct(const float* coefficients, const float* input, size_t numTaps) {
+    size_t tap = 0;
+    float sum = 0;
+#if defined(__SSE__)
+    __m128 sum0 = _mm_setzero_ps();
+    __m128 sum1 = _mm_setzero_ps();
+    for (; tap + 8 <= numTaps; tap += 8) {
+        sum0 = _mm_add_ps(sum0, _mm_mul_ps(_mm_loadu_ps(coefficients + tap), _mm_loadu_ps(input + tap)));
+        sum1 = _mm_add_ps(sum1, _mm_mul_ps(_mm_loadu_ps(coefficients + tap + 4), _mm_loadu_ps(input + tap + 4)));
+    }
+    float lanes[4];
+    _mm_storeu_ps(lanes, _mm_add_ps(sum0, sum1));
+    sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    float32x4_t sum0 = vdupq_n_f32(0);
+    float32x4_t sum1 = vdupq_n_f32(0);
+    for (; tap + 8 <= numTaps; tap += 8) {
+        sum0 = vmlaq_f32(sum0, vld1q_f32(coefficients + tap), vld1q_f32(input + tap));
+        sum1 = vmlaq_f32(sum1, vld1q_f32(coefficients + tap + 4), vld1q_f32(input + tap + 4));
+    }
+    float lanes[4];
+    vst1q_f32(lanes, vaddq_f32(sum0, sum1));
+    sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#else
+    float sums[4] = {0, 0, 0, 0};
+    for (; tap + 4 <= numTaps; tap += 4) {
+        sums[0] += coefficients[tap] * input[tap];
+        sums[1] += coefficients[tap + 1] * input[tap + 1];
+        sums[2] += coefficients[tap + 2] * input[tap + 2];
+        sums[3] += coefficients[tap + 3] * input[tap + 3];
+    }
+    sum = (sums[0] + sums[1]) + (sums[2] + sums[3]);
+#endif
+    for (; tap < numTaps; ++tap) {
+        sum += coefficients[tap] * input[tap];
+    }
+    return sum;
+}
+
+std::unique_ptr<AudioFrontEnd> AudioFrontEnd::create(
+    const AudioFormat& inputFormat,
+    std::shared_ptr<AudioInputStream::Writer> writer,
+    int channel) {
+    if (!writer) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "nullWriter"));
+        return nullptr;
+    }
+    if (writer->getWordSize() != sizeof(int16_t)) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "unsupportedWordSize").d("wordSize", writer->getWordSize()));
+        return nullptr;
+    }
+    if (inputFormat.encoding != AudioFormat::Encoding::LPCM || inputFormat.sampleSizeInBits != SAMPLE_SIZE_IN_BITS ||
+        inputFormat.endianness != AudioFormat::Endianness::LITTLE) {
+        ACSDK_ERROR(LX("createFailed")
+                        .d("reason", "unsupportedFormat")
+                        .d("encoding", inputFormat.encoding)
+                        .d("sampleSize", inputFormat.sampleSizeInBits)
+                        .d("endianness", inputFormat.endianness));
+        return nullptr;
+    }
+    if (0 == inputFormat.numChannels ||
+        (inputFormat.numChannels > 1 && inputFormat.layout != AudioFormat::Layout::INTERLEAVED)) {
+        ACSDK_ERROR(LX("createFailed")
+                        .d("reason", "unsupportedChannelLayout")
+                        .d("numChannels", inputFormat.numChannels)
+                        .d("interleaved", inputFormat.layout == AudioFormat::Layout::INTERLEAVED));
+        return nullptr;
+    }
+    if (channel != MIX_ALL_CHANNELS && (channel < 0 || static_cast<unsigned int>(channel) >= inputFormat.numChannels)) {
+        ACSDK_ERROR(LX("createFailed")
+                        .d("reason", "invalidChannel")
+                        .d("channel", channel)
+                        .d("numChannels", inputFormat.numChannels));
+        return nullptr;
+    }
+    if (0 == inputFormat.sampleRateHz) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "invalidSampleRate"));
+        return nullptr;
+    }
+
+    auto divisor = gcd(inputFormat.sampleRateHz, OUTPUT_SAMPLE_RATE_HZ);
+    auto interpolation = OUTPUT_SAMPLE_RATE_HZ / divisor;
+    auto decimation = inputFormat.sampleRateHz / divisor;
+    if (interpolation > MAX_INTERPOLATION) {
+        ACSDK_ERROR(LX("createFailed")
+                        .d("reason", "unsupportedSampleRate")
+                        .d("sampleRateHz", inputFormat.sampleRateHz));
+        return nullptr;
+    }
+
+    return std::unique_ptr<AudioFrontEnd>(
+        new AudioFrontEnd(inputFormat.numChannels, channel, interpolation, decimation, writer));
+}
+
+AudioFrontEnd::AudioFrontEnd(
+    unsigned int numChannels,
+    int channel,
+    unsigned int interpolation,
+    unsigned int decimation,
+    std::shared_ptr<AudioInputStream::Writer> writer) :
+        m_numChannels{numChannels},
+        m_channel{channel},
+        m_interpolation{interpolation},
+        m_decimation{decimation},
+        m_writer{writer},
+        m_tapsPerPhase{0},
+        m_phase{0},
+        m_nextInput{0} {
+    if (m_interpolation != m_decimation) {
+        designFilter();
+        m_history.assign(m_tapsPerPhase - 1, 0.0f);
+        m_nextInput = m_tapsPerPhase - 1;
+    }
+}
+
+void AudioFrontEnd::designFilter() {
+    // Downsampling needs a narrower, and so longer, filter.
+    auto ratio = static_cast<size_t>(std::ceil(static_cast<double>(m_decimation) / m_interpolation));
+    m_tapsPerPhase = 2 * HALF_TAPS * std::max<size_t>(1, ratio);
+    const size_t length = m_tapsPerPhase * m_interpolation;
+
+    // Windowed-sinc lowpass at the upsampled rate, cutting off below the lower of the two Nyquist frequencies.
+    const double cutoff = CUTOFF_FRACTION * 0.5 / std::max(m_interpolation, m_decimation);
+    const double center = (length - 1) / 2.0;
+    std::vector<double> prototype(length);
+    double sum = 0;
+    for (size_t i = 0; i < length; ++i) {
+        double x = i - center;
+        double sinc = (0 == x) ? 2 * cutoff : std::sin(2 * PI * cutoff * x) / (PI * x);
+        double window = 0.42 - 0.5 * std::cos(2 * PI * i / (length - 1)) + 0.08 * std::cos(4 * PI * i / (length - 1));
+        prototype[i] = sinc * window;
+        sum += prototype[i];
+    }
+
+    // Each phase sees one in m_interpolation of the taps, so scale for unity gain at DC, then split into phases with
+    // each phase reversed so that it lines up with the input samples in order.
+    m_coefficients.resize(length);
+    for (size_t phase = 0; phase < m_interpolation; ++phase) {
+        for (size_t tap = 0; tap < m_tapsPerPhase; ++tap) {
+            m_coefficients[phase * m_tapsPerPhase + tap] = static_cast<float>(
+                prototype[phase + (m_tapsPerPhase - 1 - tap) * m_interpolation] * m_interpolation / sum);
+        }
+    }
+}
+
+size_t AudioFrontEnd::getTapsPerPhase() const {
+    return m_tapsPerPhase;
+}
+
+ssize_t AudioFrontEnd::write(const int16_t* frames, size_t numFrames) {
+    if (!frames) {
+        ACSDK_ERROR(LX("writeFailed").d("reason", "nullFrames"));
+        return AudioInputStream::Writer::Error::INVALID;
+    }
+
+    const bool resampling = m_tapsPerPhase > 0;
+    m_output.clear();
+    if (resampling) {
+        m_history.reserve(m_history.size() + numFrames);
+    } else {
+        m_output.reserve(numFrames);
+    }
+
+    for (size_t frame = 0; frame < numFrames; ++frame) {
+        const int16_t* samples = frames + frame * m_numChannels;
+        float sample;
+        if (MIX_ALL_CHANNELS == m_channel) {
+            int32_t mix = 0;
+            for (unsigned int i = 0; i < m_numChannels; ++i) {
+                mix += samples[i];
+            }
+            sample = static_cast<float>(mix) / m_numChannels;
+        } else {
+            sample = samples[m_channel];
+        }
+        if (resampling) {
+            m_history.push_back(sample);
+        } else {
+            m_output.push_back(toInt16(sample));
+        }
+    }
+
+    if (resampling) {
+        resample();
+    }
+
+    if (!m_output.empty()) {
+        auto result = m_writer->write(m_output.data(), m_output.size());
+        if (result <= 0) {
+            ACSDK_ERROR(LX("writeFailed").d("reason", "writerError").d("error", result));
+            return result;
+        }
+    }
+    return numFrames;
+}
+
+void AudioFrontEnd::resample() {
+    while (m_nextInput < m_history.size()) {
+        const float* input = m_history.data() + m_nextInput + 1 - m_tapsPerPhase;
+        const float* coefficients = m_coefficients.data() + m_phase * m_tapsPerPhase;
+        m_output.push_back(toInt16(dotProduct(coefficients, input, m_tapsPerPhase)));
+
+        m_phase += m_decimation;
+        m_nextInput += m_phase / m_interpolation;
+        m_phase %= m_interpolation;
+    }
+
+    /*
+     * Drop the samples which no output needs any more, but only once enough of them have built up, so that the cost
+     * of moving the rest to the front is spread over many writes.
+     */
+    auto consumed = m_nextInput + 1 - m_tapsPerPhase;
+    if (consumed >= HISTORY_COMPACTION_THRESHOLD) {
+        m_history.erase(m_history.begin(), m_history.begin() + consumed);
+        m_nextInput -= consumed;
+    }
+}
+
+}  // namespace avs
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,67 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "AVSCommon/AVS/EnergyVoiceActivityDetector.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace avs {
+
+/// The frame size in samples; 16ms at 16 kHz, matching the ESP library.
+static const size_t FRAME_SIZE = 256;
+
+/// Frames quieter than this (in dB relative to one LSB) are never speech.
+static const double MIN_SPEECH_DB = 45.0;
+
+/// How far above the noise floor a frame must be to count as speech.
+static const double SPEECH_MARGIN_DB = 15.0;
+
+/// How quickly the noise floor estimate rises per frame when the input is louder than it.
+static const double NOISE_FLOOR_RISE_DB = 0.05;
+
+EnergyVoiceActivityDetector::EnergyVoiceActivityDetector() {
+    reset();
+}
+
+size_t EnergyVoiceActivityDetector::getFrameSize() const {
+    return FRAME_SIZE;
+}
+
+void EnergyVoiceActivityDetector::reset() {
+    m_noiseFloorDb = MIN_SPEECH_DB - SPEECH_MARGIN_DB;
+}
+
+bool EnergyVoiceActivityDetector::isSpeech(const int16_t* frame) {
+    double energy = 0;
+    for (size_t i = 0; i < FRAME_SIZE; ++i) {
+        energy += static_cast<double>(frame[i]) * frame[i];
+    }
+    double energyDb = 10 * std::log10(energy / FRAME_SIZE + 1);
+
+    if (energyDb < m_noiseFloorDb) {
+        m_noiseFloorDb = energyDb;
+    } else {
+        m_noiseFloorDb = std::min(energyDb, m_noiseFloorDb + NOISE_FLOOR_RISE_DB);
+    }
+
+    return energyDb >= MIN_SPEECH_DB && energyDb >= m_noiseFloorDb + SPEECH_MARGIN_DB;
+}
+
+}  // namespace avs
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
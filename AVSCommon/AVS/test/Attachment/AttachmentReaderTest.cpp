@@ -13,6 +13,9 @@
  * permissions and limitations under the License.
  */
 
+#include <future>
+#include <thread>
+
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
@@ -230,6 +233,39 @@ TEST_F(AttachmentReaderTest, testAttachmentReaderMultipleReadsOfUnfinishedData)
     testMultipleReads(true);
 }
 
+/**
+ * Test that @c waitForData() times out when no data is written, and returns as soon as data is written.
+ */
+TEST_F(AttachmentReaderTest, testAttachmentReaderWaitForData) {
+    init();
+
+    EXPECT_EQ(m_reader->waitForData(std::chrono::milliseconds(10)), AttachmentReader::WaitStatus::TIMEDOUT);
+
+    auto waitResult =
+        std::async(std::launch::async, [this]() { return m_reader->waitForData(std::chrono::seconds(5)); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    auto numWritten = m_writer->write(m_testPattern.data(), m_testPattern.size());
+    ASSERT_EQ(numWritten, static_cast<ssize_t>(m_testPattern.size()));
+    EXPECT_EQ(waitResult.get(), AttachmentReader::WaitStatus::READY);
+
+    // Waiting does not consume any data.
+    readAndVerifyResult(
+        std::shared_ptr<InProcessAttachmentReader>(std::move(m_reader)), TEST_SDS_PARTIAL_READ_AMOUNT_IN_BYTES);
+}
+
+/**
+ * Test that closing the reader wakes a pending @c waitForData().
+ */
+TEST_F(AttachmentReaderTest, testAttachmentReaderWaitForDataWakesOnClose) {
+    init();
+
+    auto waitResult =
+        std::async(std::launch::async, [this]() { return m_reader->waitForData(std::chrono::seconds(5)); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    m_writer->close();
+    EXPECT_EQ(waitResult.get(), AttachmentReader::WaitStatus::READY);
+}
+
 }  // namespace test
 }  // namespace avs
 }  // namespace avsCommon
@@ -0,0 +1,269 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <cmath>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/AVS/AudioFrontEnd.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace avs {
+namespace test {
+
+using namespace utils;
+
+/// The word size of the output stream.
+static const size_t WORD_SIZE = sizeof(int16_t);
+
+/// The number of words in the output stream buffer.
+static const size_t BUFFER_WORDS = 16000 * 10;
+
+/// The number of readers of the output stream.
+static const size_t MAX_READERS = 1;
+
+/// Amplitude of the test tone.
+static const double TONE_AMPLITUDE = 10000;
+
+/// Frequency of the test tone, well inside the passband at every rate.
+static const double TONE_FREQUENCY_HZ = 1000;
+
+/// Pi.
+static const double PI = 3.14159265358979323846;
+
+class AudioFrontEndTest : public ::testing::Test {
+public:
+    void SetUp() override;
+
+protected:
+    /**
+     * Build a 16-bit interleaved LPCM format.
+     *
+     * @param sampleRateHz The sample rate.
+     * @param numChannels The number of channels.
+     * @return The format.
+     */
+    static AudioFormat makeFormat(unsigned int sampleRateHz, unsigned int numChannels);
+
+    /**
+     * Read everything written to the stream so far.
+     *
+     * @return The samples which have been written.
+     */
+    std::vector<int16_t> readAll();
+
+    /// The output stream.
+    std::shared_ptr<AudioInputStream> m_stream;
+
+    /// The writer passed to the front end.
+    std::shared_ptr<AudioInputStream::Writer> m_writer;
+
+    /// A reader of the output stream.
+    std::shared_ptr<AudioInputStream::Reader> m_reader;
+};
+
+void AudioFrontEndTest::SetUp() {
+    auto size = AudioInputStream::calculateBufferSize(BUFFER_WORDS, WORD_SIZE, MAX_READERS);
+    m_stream = AudioInputStream::create(std::make_shared<AudioInputStream::Buffer>(size), WORD_SIZE, MAX_READERS);
+    ASSERT_NE(m_stream, nullptr);
+    m_writer = m_stream->createWriter(AudioInputStream::Writer::Policy::NONBLOCKABLE);
+    m_reader = m_stream->createReader(AudioInputStream::Reader::Policy::NONBLOCKING);
+    ASSERT_NE(m_writer, nullptr);
+    ASSERT_NE(m_reader, nullptr);
+}
+
+AudioFormat AudioFrontEndTest::makeFormat(unsigned int sampleRateHz, unsigned int numChannels) {
+    AudioFormat format;
+    format.encoding = AudioFormat::Encoding::LPCM;
+    format.endianness = AudioFormat::Endianness::LITTLE;
+    format.sampleRateHz = sampleRateHz;
+    format.sampleSizeInBits = 16;
+    format.numChannels = numChannels;
+    format.dataSigned = true;
+    format.layout = AudioFormat::Layout::INTERLEAVED;
+    return format;
+}
+
+std::vector<int16_t> AudioFrontEndTest::readAll() {
+    std::vector<int16_t> samples;
+    int16_t buffer[1024];
+    ssize_t read;
+    while ((read = m_reader->read(buffer, sizeof(buffer) / sizeof(buffer[0]))) > 0) {
+        samples.insert(samples.end(), buffer, buffer + read);
+    }
+    return samples;
+}
+
+/**
+ * Generate a sine tone.
+ *
+ * @param sampleRateHz The sample rate.
+ * @param numSamples The number of samples to generate.
+ * @return The tone.
+ */
+static std::vector<int16_t> makeTone(unsigned int sampleRateHz, size_t numSamples) {
+    std::vector<int16_t> tone(numSamples);
+    for (size_t i = 0; i < numSamples; ++i) {
+        tone[i] = static_cast<int16_t>(TONE_AMPLITUDE * std::sin(2 * PI * TONE_FREQUENCY_HZ * i / sampleRateHz));
+    }
+    return tone;
+}
+
+/**
+ * Compute the RMS level of part of a signal.
+ *
+ * @param samples The signal.
+ * @param begin The first sample to include.
+ * @param end One past the last sample to include.
+ * @return The RMS level.
+ */
+static double rms(const std::vector<int16_t>& samples, size_t begin, size_t end) {
+    double sum = 0;
+    for (size_t i = begin; i < end; ++i) {
+        sum += static_cast<double>(samples[i]) * samples[i];
+    }
+    return std::sqrt(sum / (end - begin));
+}
+
+/**
+ * Verify that creation fails for unsupported formats, channels and writers.
+ */
+TEST_F(AudioFrontEndTest, createFailsForInvalidParameters) {
+    EXPECT_EQ(AudioFrontEnd::create(makeFormat(16000, 1), nullptr), nullptr);
+
+    auto format = makeFormat(16000, 1);
+    format.encoding = AudioFormat::Encoding::OPUS;
+    EXPECT_EQ(AudioFrontEnd::create(format, m_writer), nullptr);
+
+    format = makeFormat(16000, 1);
+    format.sampleSizeInBits = 8;
+    EXPECT_EQ(AudioFrontEnd::create(format, m_writer), nullptr);
+
+    format = makeFormat(16000, 2);
+    format.layout = AudioFormat::Layout::NON_INTERLEAVED;
+    EXPECT_EQ(AudioFrontEnd::create(format, m_writer), nullptr);
+
+    EXPECT_EQ(AudioFrontEnd::create(makeFormat(0, 1), m_writer), nullptr);
+    EXPECT_EQ(AudioFrontEnd::create(makeFormat(16000, 0), m_writer), nullptr);
+    EXPECT_EQ(AudioFrontEnd::create(makeFormat(16000, 2), m_writer, 2), nullptr);
+    EXPECT_EQ(AudioFrontEnd::create(makeFormat(16000, 2), m_writer, -2), nullptr);
+}
+
+/**
+ * Verify that 16 kHz mono input is written unchanged.
+ */
+TEST_F(AudioFrontEndTest, passesThroughOutputFormat) {
+    auto frontEnd = AudioFrontEnd::create(makeFormat(16000, 1), m_writer);
+    ASSERT_NE(frontEnd, nullptr);
+    EXPECT_EQ(frontEnd->getTapsPerPhase(), 0u);
+
+    std::vector<int16_t> input = {0, 1, -1, INT16_MAX, INT16_MIN, 1234};
+    EXPECT_EQ(frontEnd->write(input.data(), input.size()), static_cast<ssize_t>(input.size()));
+    EXPECT_EQ(readAll(), input);
+}
+
+/**
+ * Verify that a single channel can be selected from interleaved input.
+ */
+TEST_F(AudioFrontEndTest, selectsChannel) {
+    auto frontEnd = AudioFrontEnd::create(makeFormat(16000, 3), m_writer, 1);
+    ASSERT_NE(frontEnd, nullptr);
+
+    std::vector<int16_t> input = {1, 10, 100, 2, 20, 200, 3, 30, 300};
+    EXPECT_EQ(frontEnd->write(input.data(), 3), 3);
+    EXPECT_EQ(readAll(), std::vector<int16_t>({10, 20, 30}));
+}
+
+/**
+ * Verify that all channels are averaged by default, without overflowing at full scale.
+ */
+TEST_F(AudioFrontEndTest, mixesAllChannels) {
+    auto frontEnd = AudioFrontEnd::create(makeFormat(16000, 2), m_writer);
+    ASSERT_NE(frontEnd, nullptr);
+
+    std::vector<int16_t> input = {100, 300, INT16_MAX, INT16_MAX, -50, 50};
+    EXPECT_EQ(frontEnd->write(input.data(), 3), 3);
+    EXPECT_EQ(readAll(), std::vector<int16_t>({200, INT16_MAX, 0}));
+}
+
+/**
+ * Verify that common capture rates are resampled to 16 kHz, preserving the length and level of an in-band tone, when
+ * the input arrives in uneven buffers.
+ */
+TEST_F(AudioFrontEndTest, resamplesToOutputRate) {
+    for (unsigned int sampleRateHz : {8000u, 11025u, 22050u, 32000u, 44100u, 48000u}) {
+        SetUp();
+        auto frontEnd = AudioFrontEnd::create(makeFormat(sampleRateHz, 1), m_writer);
+        ASSERT_NE(frontEnd, nullptr);
+        EXPECT_GT(frontEnd->getTapsPerPhase(), 0u);
+
+        auto input = makeTone(sampleRateHz, sampleRateHz);
+        size_t offset = 0;
+        size_t chunk = 1;
+        while (offset < input.size()) {
+            auto count = std::min(chunk, input.size() - offset);
+            ASSERT_EQ(frontEnd->write(input.data() + offset, count), static_cast<ssize_t>(count));
+            offset += count;
+            chunk = chunk * 3 % 997 + 1;
+        }
+
+        auto output = readAll();
+        // One second in should give one second out, less the filter's delay.
+        EXPECT_LE(output.size(), AudioFrontEnd::OUTPUT_SAMPLE_RATE_HZ) << sampleRateHz;
+        EXPECT_GE(output.size(), AudioFrontEnd::OUTPUT_SAMPLE_RATE_HZ - 200) << sampleRateHz;
+
+        // Skip the filter's start-up transient.
+        auto level = rms(output, 1000, output.size());
+        EXPECT_NEAR(level, TONE_AMPLITUDE / std::sqrt(2.0), TONE_AMPLITUDE * 0.02) << sampleRateHz;
+    }
+}
+
+/**
+ * Verify that content above the output Nyquist frequency is filtered out when downsampling.
+ */
+TEST_F(AudioFrontEndTest, rejectsAliases) {
+    const unsigned int sampleRateHz = 48000;
+    auto frontEnd = AudioFrontEnd::create(makeFormat(sampleRateHz, 1), m_writer);
+    ASSERT_NE(frontEnd, nullptr);
+
+    // A 12 kHz tone would alias to 4 kHz at 16 kHz without filtering.
+    std::vector<int16_t> input(sampleRateHz);
+    for (size_t i = 0; i < input.size(); ++i) {
+        input[i] = static_cast<int16_t>(TONE_AMPLITUDE * std::sin(2 * PI * 12000 * i / sampleRateHz));
+    }
+    ASSERT_EQ(frontEnd->write(input.data(), input.size()), static_cast<ssize_t>(input.size()));
+
+    auto output = readAll();
+    EXPECT_LT(rms(output, 1000, output.size()), TONE_AMPLITUDE * 0.01);
+}
+
+/**
+ * Verify that a writer error is returned from @c write().
+ */
+TEST_F(AudioFrontEndTest, returnsWriterError) {
+    auto frontEnd = AudioFrontEnd::create(makeFormat(16000, 1), m_writer);
+    ASSERT_NE(frontEnd, nullptr);
+    m_writer->close();
+
+    int16_t sample = 0;
+    EXPECT_EQ(frontEnd->write(&sample, 1), AudioInputStream::Writer::Error::CLOSED);
+}
+
+}  // namespace test
+}  // namespace avs
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -18,6 +18,7 @@
 
 #include <memory>
 
+#include "AVSCommon/SDKInterfaces/ContextManagerObserverInterface.h"
 #include "AVSCommon/SDKInterfaces/ContextRequesterInterface.h"
 #include "AVSCommon/SDKInterfaces/StateProviderInterface.h"
 #include "AVSCommon/AVS/StateRefreshPolicy.h"
@@ -115,6 +116,20 @@ public:
      * @param contextRequester The context requester asking for context.
      */
     virtual void getContext(std::shared_ptr<ContextRequesterInterface> contextRequester) = 0;
+
+    /**
+     * Add an observer which will be notified when the context changes.
+     *
+     * @param observer The observer to add.
+     */
+    virtual void addContextManagerObserver(std::shared_ptr<ContextManagerObserverInterface> observer) = 0;
+
+    /**
+     * Remove an observer added with @c addContextManagerObserver.
+     *
+     * @param observer The observer to remove.
+     */
+    virtual void removeContextManagerObserver(std::shared_ptr<ContextManagerObserverInterface> observer) = 0;
 };
 
 }  // namespace sdkInterfaces
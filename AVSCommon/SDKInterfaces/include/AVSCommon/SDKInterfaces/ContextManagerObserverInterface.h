@@ -0,0 +1,49 @@
+/*
+ * Copyright 2017-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVSCOMMON_SDKINTERFACES_INCLUDE_AVSCOMMON_SDKINTERFACES_CONTEXTMANAGEROBSERVERINTERFACE_H_
+#define ALEXA_CLIENT_SDK_AVSCOMMON_SDKINTERFACES_INCLUDE_AVSCOMMON_SDKINTERFACES_CONTEXTMANAGEROBSERVERINTERFACE_H_
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace sdkInterfaces {
+
+/**
+ * This interface is used to observe changes to the states held by the @c ContextManager, so that a component which
+ * keeps a context built earlier knows when it needs to be rebuilt.
+ */
+class ContextManagerObserverInterface {
+public:
+    /**
+     * Destructor.
+     */
+    virtual ~ContextManagerObserverInterface() = default;
+
+    /**
+     * Notification that a state provider was added or removed, or that a state was changed other than in response to
+     * a @c provideState request. States which are refreshed by @c provideState requests are not reported here, as
+     * they are brought up to date by every @c getContext request.
+     *
+     * @note The implementation of this function should return fast in order not to block the component setting the
+     * state.
+     */
+    virtual void onContextChanged() = 0;
+};
+
+}  // namespace sdkInterfaces
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVSCOMMON_SDKINTERFACES_INCLUDE_AVSCOMMON_SDKINTERFACES_CONTEXTMANAGEROBSERVERINTERFACE_H_
@@ -39,6 +39,17 @@ public:
      * Produces an @c HTTPContentFetcherInterface object or @c nullptr on failure.
      */
     virtual std::unique_ptr<HTTPContentFetcherInterface> create(const std::string& url) = 0;
+
+    /**
+     * Produces an @c HTTPContentFetcherInterface object, or @c nullptr on failure, for content which is likely to be
+     * fetched again in whole or from where an earlier fetch stopped, such as a podcast or audiobook file.  A factory
+     * may keep such content so that later fetches of it need not use the network.  Playlists, live streams and other
+     * content which is only played once should be fetched with @c create().  The default implementation calls
+     * @c create().
+     */
+    virtual std::unique_ptr<HTTPContentFetcherInterface> createForReusableContent(const std::string& url) {
+        return create(url);
+    }
 };
 
 }  // namespace sdkInterfaces
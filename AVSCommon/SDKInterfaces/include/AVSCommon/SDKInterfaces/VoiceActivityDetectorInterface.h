@@ -0,0 +1,65 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVSCOMMON_SDKINTERFACES_INCLUDE_AVSCOMMON_SDKINTERFACES_VOICEACTIVITYDETECTORINTERFACE_H_
+#define ALEXA_CLIENT_SDK_AVSCOMMON_SDKINTERFACES_INCLUDE_AVSCOMMON_SDKINTERFACES_VOICEACTIVITYDETECTORINTERFACE_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace sdkInterfaces {
+
+/**
+ * A @c VoiceActivityDetectorInterface classifies fixed-size frames of 16 kHz, 16-bit LPCM audio as speech or
+ * non-speech.  It is used by the AIP @c Endpointer to find the end of an utterance, and by the KWD
+ * @c VoiceActivityGate to keep silence away from keyword engines.
+ *
+ * A detector is only ever used from one thread at a time, so implementations need no synchronization.
+ */
+class VoiceActivityDetectorInterface {
+public:
+    /**
+     * Destructor.
+     */
+    virtual ~VoiceActivityDetectorInterface() = default;
+
+    /**
+     * Get the number of samples in each frame passed to @c isSpeech().
+     *
+     * @return The number of samples per frame.
+     */
+    virtual size_t getFrameSize() const = 0;
+
+    /**
+     * Reset any adaptive state.  This is called at the start of each utterance.
+     */
+    virtual void reset() = 0;
+
+    /**
+     * Classify one frame of audio.
+     *
+     * @param frame Pointer to @c getFrameSize() samples.
+     * @return @c true if the frame contains speech, else @c false.
+     */
+    virtual bool isSpeech(const int16_t* frame) = 0;
+};
+
+}  // namespace sdkInterfaces
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVSCOMMON_SDKINTERFACES_INCLUDE_AVSCOMMON_SDKINTERFACES_VOICEACTIVITYDETECTORINTERFACE_H_
@@ -39,6 +39,8 @@ public:
             const avs::StateRefreshPolicy& refreshPolicy,
             const unsigned int stateRequestToken));
     MOCK_METHOD1(getContext, void(std::shared_ptr<ContextRequesterInterface> contextRequester));
+    MOCK_METHOD1(addContextManagerObserver, void(std::shared_ptr<ContextManagerObserverInterface> observer));
+    MOCK_METHOD1(removeContextManagerObserver, void(std::shared_ptr<ContextManagerObserverInterface> observer));
 };
 
 }  // namespace test
@@ -18,11 +18,14 @@
 
 #include <chrono>
 #include <curl/curl.h>
+#include <memory>
 #include <string>
 
 #include <AVSCommon/Utils/Logger/LogEntry.h>
 #include <AVSCommon/Utils/Logger/LoggerUtils.h>
 
+#include "AVSCommon/Utils/LibcurlUtils/CurlShareHandleWrapper.h"
+
 namespace alexaClientSDK {
 namespace avsCommon {
 namespace utils {
@@ -221,7 +224,8 @@ private:
     void cleanupResources();
 
     /**
-     * Sets common options to the curl easy handle common to all transfers
+     * Sets common options to the curl easy handle common to all transfers, including the process-wide DNS and TLS
+     * session caches.
      *
      * @return Whether the setting was successful
      */
@@ -235,6 +239,8 @@ private:
     curl_slist* m_postHeaders;
     /// The associated multipart post
     curl_httppost* m_post;
+    /// The DNS and TLS session caches shared with every other handle, or @c nullptr if they are unavailable.
+    std::shared_ptr<CurlShareHandleWrapper> m_share;
 };
 
 template <typename ParamType>
@@ -0,0 +1,183 @@
+/*
+ * Copyright 2017-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_LIBCURLUTILS_CURLFETCHENGINE_H_
+#define ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_LIBCURLUTILS_CURLFETCHENGINE_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <curl/curl.h>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "AVSCommon/Utils/LibcurlUtils/CurlMultiHandleWrapper.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace libcurlUtils {
+
+/**
+ * Runs any number of @c libcurl transfers on a single thread with a @c libcurl @c multi @c handle, instead of a thread
+ * and a blocking @c curl_easy_perform() per transfer.  All transfers run by the engine share its connection cache, so
+ * a request to a host that was recently used reuses the open connection.
+ *
+ * Callbacks set on a transfer's easy handle, and its completion callback, are called on the engine's thread.  They
+ * must not block, as that holds up every other transfer.  A write callback which cannot take data yet should return
+ * @c CURL_WRITEFUNC_PAUSE, and the transfer's owner should resume it with @c curl_easy_pause() from a function passed
+ * to @c submit() once its consumer has room.  The engine never resumes a paused transfer itself, so a transfer paused
+ * for a long time costs nothing while it waits.
+ */
+class CurlFetchEngine {
+public:
+    /**
+     * A function called once when a transfer finishes.
+     *
+     * @param result The result of the transfer.
+     */
+    using CompletionCallback = std::function<void(CURLcode result)>;
+
+    /**
+     * Get the engine shared by every user in the process, creating it if no one currently holds it.
+     *
+     * @return The shared engine, or @c nullptr if it could not be created.
+     */
+    static std::shared_ptr<CurlFetchEngine> acquire();
+
+    /**
+     * Create an engine.
+     *
+     * @return The new engine, or @c nullptr if it could not be created.
+     */
+    static std::shared_ptr<CurlFetchEngine> create();
+
+    /**
+     * Destructor.  Transfers still running are abandoned without their completion callbacks being called.
+     *
+     * @note The engine must not be destroyed from one of its own callbacks.
+     */
+    ~CurlFetchEngine();
+
+    /**
+     * Start a transfer.  The handle must stay valid until @c onComplete is called or @c removeTransfer() returns.
+     *
+     * @param handle The configured easy handle to perform.
+     * @param onComplete The function to call when the transfer finishes.
+     * @return Whether the transfer was accepted.
+     */
+    bool addTransfer(CURL* handle, CompletionCallback onComplete);
+
+    /**
+     * Stop a transfer, if it is still running.  Once this returns, no more callbacks will be made for the transfer
+     * and its handle may be freed.  The completion callback is not called for a transfer stopped this way.
+     *
+     * @param handle The handle passed to @c addTransfer().
+     */
+    void removeTransfer(CURL* handle);
+
+    /**
+     * Call a function on the engine thread on behalf of a transfer, for example to resume it with @c curl_easy_pause()
+     * once its consumer can take more data.  This may be called from any thread, including the engine's own.  The
+     * function is dropped if the transfer is removed with @c removeTransfer() before it is called.  The transfer need
+     * not have been added with @c addTransfer(); the handle only identifies the functions to drop.
+     *
+     * @param handle The handle of the transfer the function acts on.
+     * @param task The function to call.
+     * @return Whether the function was accepted.
+     */
+    bool submit(CURL* handle, std::function<void()> task);
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param multi The multi handle with which to run transfers.
+     */
+    CurlFetchEngine(std::unique_ptr<CurlMultiHandleWrapper> multi);
+
+    /// The loop run by @c m_thread.
+    void loop();
+
+    /**
+     * Add the transfers queued by @c addTransfer() to the multi handle, and remove those queued by
+     * @c removeTransfer().  Called on @c m_thread.
+     */
+    void applyPendingChanges();
+
+    /**
+     * Remove finished transfers from the multi handle and call their completion callbacks.  Called on @c m_thread.
+     */
+    void completeFinishedTransfers();
+
+    /**
+     * Remove a transfer from the multi handle.  Called on @c m_thread.
+     *
+     * @param handle The transfer to remove.
+     */
+    void removeFromMulti(CURL* handle);
+
+    /**
+     * Call the functions queued by @c submit().  Called on @c m_thread.
+     */
+    void runSubmittedTasks();
+
+    /// Wake @c m_thread if it is waiting for activity on the transfers.
+    void wakeUp();
+
+    /// The multi handle the transfers are run with.  Only used on @c m_thread, apart from waking it.
+    std::unique_ptr<CurlMultiHandleWrapper> m_multi;
+
+    /// Transfers in the multi handle, with their completion callbacks.  Only used on @c m_thread.
+    std::unordered_map<CURL*, CompletionCallback> m_transfers;
+
+    /// Serializes access to the members below.
+    std::mutex m_mutex;
+
+    /// Notified when the engine thread has applied the pending changes.
+    std::condition_variable m_changesApplied;
+
+    /// Notified when there are changes for an idle engine thread to apply.
+    std::condition_variable m_wakeTrigger;
+
+    /// Transfers to be added by the engine thread.
+    std::deque<std::pair<CURL*, CompletionCallback>> m_transfersToAdd;
+
+    /// Transfers to be removed by the engine thread.
+    std::unordered_set<CURL*> m_transfersToRemove;
+
+    /// Functions queued by @c submit(), with the transfers they act on.
+    std::deque<std::pair<CURL*, std::function<void()>>> m_tasks;
+
+    /// Incremented each time the engine thread applies the pending changes.
+    uint64_t m_changeCount;
+
+    /// Whether the engine is shutting down.
+    bool m_isShuttingDown;
+
+    /// The thread the transfers run on.  This is declared last so that it is started after the members above.
+    std::thread m_thread;
+};
+
+}  // namespace libcurlUtils
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_LIBCURLUTILS_CURLFETCHENGINE_H_
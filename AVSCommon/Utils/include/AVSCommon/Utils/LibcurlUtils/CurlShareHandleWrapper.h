@@ -0,0 +1,96 @@
+/*
+ * Copyright 2017-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_LIBCURLUTILS_CURLSHAREHANDLEWRAPPER_H_
+#define ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_LIBCURLUTILS_CURLSHAREHANDLEWRAPPER_H_
+
+#include <curl/curl.h>
+#include <memory>
+#include <mutex>
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace libcurlUtils {
+
+/**
+ * This class wraps a @c libcurl @c share @c handle which holds the DNS cache and TLS session cache for every
+ * @c CurlEasyHandleWrapper in the process, so that a new handle can skip the DNS lookup and resume a TLS session
+ * with a host that any other handle has already talked to.
+ *
+ * The connection cache is not shared here, because @c libcurl does not support sharing connections between
+ * transfers running on different threads.  Transfers made through the @c CurlFetchEngine share its connections.
+ */
+class CurlShareHandleWrapper {
+public:
+    /**
+     * Get the share handle used by every @c CurlEasyHandleWrapper, creating it if no handle currently holds it.
+     *
+     * @return The shared instance, or @c nullptr if it could not be created.
+     */
+    static std::shared_ptr<CurlShareHandleWrapper> acquire();
+
+    /**
+     * Destructor.
+     */
+    ~CurlShareHandleWrapper();
+
+    /**
+     * Get the @c libcurl @c share @c handle underlying this instance.
+     *
+     * @return The @c libcurl @c share @c handle underlying this instance.
+     */
+    CURLSH* getCurlHandle();
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param handle The @c libcurl @c share @c handle to wrap.
+     */
+    CurlShareHandleWrapper(CURLSH* handle);
+
+    /**
+     * The callback @c libcurl uses to lock the shared data.
+     *
+     * @param handle The easy handle using the shared data.
+     * @param data The data to lock.
+     * @param access Whether shared or single access is wanted.
+     * @param userData This instance.
+     */
+    static void lockCallback(CURL* handle, curl_lock_data data, curl_lock_access access, void* userData);
+
+    /**
+     * The callback @c libcurl uses to unlock the shared data.
+     *
+     * @param handle The easy handle using the shared data.
+     * @param data The data to unlock.
+     * @param userData This instance.
+     */
+    static void unlockCallback(CURL* handle, curl_lock_data data, void* userData);
+
+    /// The wrapped @c libcurl @c share @c handle.
+    CURLSH* m_handle;
+
+    /// A mutex for each kind of data which may be shared.
+    std::mutex m_mutexes[CURL_LOCK_DATA_LAST];
+};
+
+}  // namespace libcurlUtils
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_LIBCURLUTILS_CURLSHAREHANDLEWRAPPER_H_
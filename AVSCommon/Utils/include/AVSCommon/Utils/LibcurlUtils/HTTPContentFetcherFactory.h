@@ -21,6 +21,7 @@
 
 #include <AVSCommon/SDKInterfaces/HTTPContentFetcherInterface.h>
 #include <AVSCommon/SDKInterfaces/HTTPContentFetcherInterfaceFactoryInterface.h>
+#include <AVSCommon/Utils/LibcurlUtils/HttpContentCache.h>
 
 namespace alexaClientSDK {
 namespace avsCommon {
@@ -32,7 +33,22 @@ namespace libcurlUtils {
  */
 class HTTPContentFetcherFactory : public avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface {
 public:
+    /**
+     * Constructor.
+     *
+     * @param cache The cache shared by the fetchers produced by @c createForReusableContent(), or @c nullptr if they
+     *     should always use the network.
+     */
+    HTTPContentFetcherFactory(std::shared_ptr<HttpContentCache> cache = nullptr);
+
     std::unique_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterface> create(const std::string& url) override;
+
+    std::unique_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterface> createForReusableContent(
+        const std::string& url) override;
+
+private:
+    /// The cache shared by the fetchers produced by @c createForReusableContent(), or @c nullptr.
+    std::shared_ptr<HttpContentCache> m_cache;
 };
 
 }  // namespace libcurlUtils
@@ -0,0 +1,358 @@
+/*
+ * Copyright 2017-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_LIBCURLUTILS_HTTPCONTENTCACHE_H_
+#define ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_LIBCURLUTILS_HTTPCONTENTCACHE_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace libcurlUtils {
+
+/**
+ * A bounded on-disk cache of HTTP response bodies, keyed by URL, used by @c LibCurlHttpContentFetcher so that content
+ * which is fetched again, such as a podcast resumed after a pause, is read from disk instead of the network.
+ *
+ * Each entry holds the first bytes of a response body, which is all of it once a fetch has completed, along with the
+ * headers needed to decide whether it may be reused.  A fetch which finds part of the body cached requests only the
+ * rest with an HTTP range request, made conditional on the cached part still being current.  When the cache grows
+ * past its size limit, the least recently used entries which are not being fetched are removed.
+ *
+ * An entry is kept in two files in the cache directory, named after a hash of its URL: a @c .data file with the cached
+ * bytes and a @c .meta file with the rest of its @c Metadata.  Entries left by an earlier instance are picked up when
+ * the cache is created.
+ */
+class HttpContentCache {
+public:
+    /// What is known about a cached response.
+    struct Metadata {
+        /**
+         * Whether all of the body is cached.
+         *
+         * @return Whether the body is complete.
+         */
+        bool isComplete() const;
+
+        /**
+         * Whether the cached body may be used without asking the server whether it is still current.
+         *
+         * @param now The current time.
+         * @return Whether the entry is fresh.
+         */
+        bool isFresh(std::chrono::system_clock::time_point now) const;
+
+        /**
+         * Whether the entry has an @c ETag or @c Last-Modified value with which the server can be asked whether it is
+         * still current.
+         *
+         * @return Whether the entry has a validator.
+         */
+        bool hasValidator() const;
+
+        /// The URL of the response.
+        std::string url;
+
+        /// The value of the @c Content-Type header.
+        std::string contentType;
+
+        /// The value of the @c ETag header, or empty if there was none.
+        std::string etag;
+
+        /// The value of the @c Last-Modified header, or empty if there was none.
+        std::string lastModified;
+
+        /// The length of the whole body.
+        uint64_t contentLength = 0;
+
+        /// The number of bytes at the start of the body which are cached.
+        uint64_t cachedLength = 0;
+
+        /// When the entry stops being fresh.
+        std::chrono::system_clock::time_point expiry;
+
+        /// When the entry was last used, which decides the order in which entries are removed.
+        std::chrono::system_clock::time_point lastAccess;
+    };
+
+    /**
+     * Exclusive use of the entry for one URL during a fetch.  Appending to the entry and reading from it may happen on
+     * different threads, but each of them must only happen on one thread at a time.  The entry is written back to the
+     * cache when this object is destroyed.
+     */
+    class Entry {
+    public:
+        /**
+         * Destructor.
+         */
+        ~Entry();
+
+        /**
+         * Get the metadata of the entry.  The cached length may be stale if data is being appended on another thread.
+         *
+         * @return The metadata.
+         */
+        const Metadata& getMetadata() const;
+
+        /**
+         * Update the metadata of the entry from the headers of a new response, keeping the cached bytes.
+         *
+         * @param metadata The new metadata.  Its URL and cached length are ignored.
+         */
+        void updateMetadata(const Metadata& metadata);
+
+        /**
+         * Discard the cached bytes and start the entry afresh for a new response.
+         *
+         * @param metadata The metadata of the new response.  Its URL and cached length are ignored.
+         * @return Whether the entry could be emptied.
+         */
+        bool reset(const Metadata& metadata);
+
+        /**
+         * Append bytes to the end of the cached part of the body.
+         *
+         * @param data The bytes.
+         * @param size The number of bytes.
+         * @return Whether the bytes were stored.  If not, the entry is discarded when it is released.
+         */
+        bool append(const char* data, size_t size);
+
+        /**
+         * Get the number of bytes at the start of the body which are cached.  This may be called on any thread.
+         *
+         * @return The number of bytes cached.
+         */
+        uint64_t getCachedLength() const;
+
+        /**
+         * Read cached bytes.
+         *
+         * @param offset The offset in the body of the first byte to read.
+         * @param [out] buffer Where to put the bytes.
+         * @param size The number of bytes to read, which must all be cached.
+         * @return Whether the bytes were read.
+         */
+        bool read(uint64_t offset, char* buffer, size_t size);
+
+        /**
+         * Remove the entry from the cache when it is released, because its response may not be stored.
+         */
+        void discard();
+
+    private:
+        friend class HttpContentCache;
+
+        /**
+         * Constructor.
+         *
+         * @param cache The cache the entry belongs to.
+         * @param key The key of the entry.
+         * @param metadata The metadata of the entry.
+         */
+        Entry(std::shared_ptr<HttpContentCache> cache, const std::string& key, const Metadata& metadata);
+
+        /// The cache the entry belongs to.
+        std::shared_ptr<HttpContentCache> m_cache;
+
+        /// The key of the entry.
+        std::string m_key;
+
+        /// The metadata of the entry.
+        Metadata m_metadata;
+
+        /// A copy of @c m_metadata.cachedLength which may be read on any thread.
+        std::atomic<uint64_t> m_cachedLength;
+
+        /// The stream appending to the data file, opened when the first bytes are appended.
+        std::ofstream m_output;
+
+        /// The stream reading from the data file, opened when the first bytes are read.
+        std::ifstream m_input;
+
+        /// Whether the entry is to be removed when it is released.
+        bool m_discard;
+    };
+
+    /**
+     * Create a cache in a directory.
+     *
+     * @param directory The directory holding the cache, which must exist.
+     * @param maxSizeInBytes The most bytes of cached bodies to keep.  A single body may use at most a quarter of this.
+     * @return The cache, or @c nullptr if the directory could not be read.
+     */
+    static std::shared_ptr<HttpContentCache> create(const std::string& directory, uint64_t maxSizeInBytes);
+
+    /**
+     * Look up the entry for a URL without using it.
+     *
+     * @param url The URL.
+     * @param [out] metadata The metadata of the entry, if there is one.
+     * @return Whether there is an entry for the URL.
+     */
+    bool lookup(const std::string& url, Metadata* metadata);
+
+    /**
+     * Take exclusive use of the entry for a URL, creating an empty one if there is none.
+     *
+     * @param url The URL.
+     * @return The entry, or @c nullptr if another fetch is using it.
+     */
+    std::unique_ptr<Entry> acquire(const std::string& url);
+
+    /**
+     * Get the longest body which will be cached.
+     *
+     * @return The size of the longest body cached.
+     */
+    uint64_t getMaxEntrySize() const;
+
+    /**
+     * Get the number of bytes of cached bodies.
+     *
+     * @return The size of the cache.
+     */
+    uint64_t getSize();
+
+    /**
+     * Work out how long a response may be used from the cache without asking the server whether it is current,
+     * following the rules of RFC 7234 for a private cache.
+     *
+     * @param cacheControl The value of the @c Cache-Control header, or empty if there was none.
+     * @param expires The value of the @c Expires header, or empty if there was none.
+     * @param lastModified The value of the @c Last-Modified header, or empty if there was none.
+     * @param now The time of the response.
+     * @return When the response stops being fresh.
+     */
+    static std::chrono::system_clock::time_point computeExpiry(
+        const std::string& cacheControl,
+        const std::string& expires,
+        const std::string& lastModified,
+        std::chrono::system_clock::time_point now);
+
+    /**
+     * Check whether a response may be stored according to its @c Cache-Control header.
+     *
+     * @param cacheControl The value of the @c Cache-Control header, or empty if there was none.
+     * @return Whether the response may be stored.
+     */
+    static bool isStorable(const std::string& cacheControl);
+
+private:
+    /// An entry as tracked in memory.
+    struct IndexEntry {
+        /// The metadata of the entry.
+        Metadata metadata;
+
+        /// Whether an @c Entry is using it.
+        bool inUse = false;
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param directory The directory holding the cache.
+     * @param maxSizeInBytes The most bytes of cached bodies to keep.
+     */
+    HttpContentCache(const std::string& directory, uint64_t maxSizeInBytes);
+
+    /**
+     * Read the metadata of every entry in the cache directory.
+     *
+     * @return Whether the directory could be read.
+     */
+    bool loadIndex();
+
+    /**
+     * Write an entry back when it is released.
+     *
+     * @param key The key of the entry.
+     * @param metadata The metadata of the entry.
+     * @param discard Whether to remove the entry instead.
+     */
+    void release(const std::string& key, const Metadata& metadata, bool discard);
+
+    /**
+     * Remove the least recently used entries which are not in use until the cache is within its size limit.
+     * @c m_mutex must be held.
+     */
+    void evictLocked();
+
+    /**
+     * Remove an entry's files.  @c m_mutex must be held.
+     *
+     * @param key The key of the entry.
+     */
+    void removeFilesLocked(const std::string& key);
+
+    /**
+     * Write an entry's metadata to its @c .meta file.
+     *
+     * @param key The key of the entry.
+     * @param metadata The metadata.
+     * @return Whether the file was written.
+     */
+    bool writeMetadata(const std::string& key, const Metadata& metadata);
+
+    /**
+     * Get the key of the entry for a URL.
+     *
+     * @param url The URL.
+     * @return The key.
+     */
+    static std::string keyForUrl(const std::string& url);
+
+    /**
+     * Get the path of one of an entry's files.
+     *
+     * @param key The key of the entry.
+     * @param extension The extension of the file.
+     * @return The path.
+     */
+    std::string pathFor(const std::string& key, const std::string& extension) const;
+
+    /// The directory holding the cache.
+    const std::string m_directory;
+
+    /// The most bytes of cached bodies to keep.
+    const uint64_t m_maxSizeInBytes;
+
+    /// Serializes access to @c m_index and @c m_size.
+    std::mutex m_mutex;
+
+    /// The entries in the cache, by key.
+    std::unordered_map<std::string, IndexEntry> m_index;
+
+    /// The number of bytes of cached bodies.
+    uint64_t m_size;
+
+    /// Used to hand out @c shared_ptrs to this object to @c Entry objects.
+    std::weak_ptr<HttpContentCache> m_self;
+};
+
+}  // namespace libcurlUtils
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_LIBCURLUTILS_HTTPCONTENTCACHE_H_
@@ -24,6 +24,7 @@
 #include <string>
 
 #include "AVSCommon/Utils/LibcurlUtils/CurlEasyHandleWrapper.h"
+#include "AVSCommon/Utils/LibcurlUtils/CurlFetchEngine.h"
 #include "AVSCommon/Utils/LibcurlUtils/HttpPostInterface.h"
 
 namespace alexaClientSDK {
@@ -31,7 +32,10 @@ namespace avsCommon {
 namespace utils {
 namespace libcurlUtils {
 
-/// LIBCURL based implementation of HttpPostInterface.
+/**
+ * LIBCURL based implementation of HttpPostInterface.  Requests run on the process-wide @c CurlFetchEngine, so they
+ * reuse its warm connections.
+ */
 class HttpPost : public HttpPostInterface {
 public:
     /// HttpPost destructor
@@ -88,6 +92,9 @@ private:
     /// CURL handle with which to make requests
     CurlEasyHandleWrapper m_curl;
 
+    /// The engine requests are run on.
+    std::shared_ptr<CurlFetchEngine> m_engine;
+
     /// String used to accumuate the response body.
     std::string m_bodyAccumulator;
 };
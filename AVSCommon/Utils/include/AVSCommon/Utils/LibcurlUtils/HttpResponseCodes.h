@@ -23,6 +23,10 @@ enum HTTPResponseCode {
     SUCCESS_OK = 200,
     /// HTTP Succcess with no response payload.
     SUCCESS_NO_CONTENT = 204,
+    /// HTTP Success with the requested range of the response payload.
+    SUCCESS_PARTIAL_CONTENT = 206,
+    /// HTTP code for a conditional request whose cached response is still current.
+    NOT_MODIFIED = 304,
     /// HTTP code for invalid request by user.
     BAD_REQUEST = 400,
     /// HTTP code for internal error by server which didn't fulfill the request.
@@ -17,12 +17,18 @@
 #define ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_LIBCURLUTILS_LIBCURLHTTPCONTENTFETCHER_H_
 
 #include <atomic>
+#include <condition_variable>
 #include <future>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include <AVSCommon/SDKInterfaces/HTTPContentFetcherInterface.h>
 #include <AVSCommon/Utils/LibcurlUtils/CurlEasyHandleWrapper.h>
+#include <AVSCommon/Utils/LibcurlUtils/CurlFetchEngine.h>
+#include <AVSCommon/Utils/LibcurlUtils/HttpContentCache.h>
 
 namespace alexaClientSDK {
 namespace avsCommon {
@@ -32,10 +38,25 @@ namespace libcurlUtils {
 /**
  * A class used to retrieve content from remote URLs. Note that this object will only write to the Attachment while it
  * remains alive. If the object goes out of scope, writing to the Attachment will abort.
+ *
+ * Transfers run on the process-wide @c CurlFetchEngine, so they share its warm connections and do not need a thread
+ * each.
+ *
+ * If an @c HttpContentCache is given, a body which is cached and fresh is read from disk without contacting the
+ * server, and a body which is partly cached is completed with a range request for the rest.  Bodies which may be
+ * cached are written to the cache as they arrive and passed on to the attachment from there on the
+ * @c CurlFetchEngine thread as the reader makes room, so the download runs ahead of a slow reader instead of being
+ * paused.
  */
 class LibCurlHttpContentFetcher : public avsCommon::sdkInterfaces::HTTPContentFetcherInterface {
 public:
-    LibCurlHttpContentFetcher(const std::string& url);
+    /**
+     * Constructor.
+     *
+     * @param url The URL to fetch from.
+     * @param cache The cache to read bodies from and store them in, or @c nullptr to always use the network.
+     */
+    LibCurlHttpContentFetcher(const std::string& url, std::shared_ptr<HttpContentCache> cache = nullptr);
 
     /**
      * @copydoc
@@ -46,11 +67,85 @@ public:
         std::shared_ptr<avsCommon::avs::attachment::AttachmentWriter> writer) override;
 
     /*
-     * Destructor.
+     * Destructor.  If the body is being written to a writer passed to @c getContent(), this waits for the transfer, and
+     * for any part of the body served from the cache, to finish, which the owner of the writer can bring about by
+     * closing it.  Otherwise the transfer is aborted.
      */
     ~LibCurlHttpContentFetcher() override;
 
 private:
+    /// How the body of an @c ENTIRE_BODY fetch reaches the attachment.
+    enum class BodyMode {
+        /// The response has not been seen yet, so it is not known whether the cache can be used.
+        PENDING,
+        /// The body is written to the attachment by @c bodyCallback().
+        DIRECT,
+        /// The body is appended to the cache entry by @c bodyCallback() and copied to the attachment from there.
+        CACHED
+    };
+
+    /// The values of the response headers which decide how the body is cached.
+    struct CacheHeaders {
+        /// The value of the @c Cache-Control header.
+        std::string cacheControl;
+
+        /// The value of the @c Expires header.
+        std::string expires;
+
+        /// The value of the @c ETag header.
+        std::string etag;
+
+        /// The value of the @c Last-Modified header.
+        std::string lastModified;
+
+        /// Whether there was a @c Content-Length header.
+        bool hasContentLength = false;
+
+        /// The value of the @c Content-Length header.
+        uint64_t contentLength = 0;
+
+        /// Whether there was a @c Content-Range header.
+        bool hasContentRange = false;
+
+        /// The offset of the first byte given by the @c Content-Range header.
+        uint64_t rangeStart = 0;
+
+        /// The length of the whole body given by the @c Content-Range header, or 0 if it was not given.
+        uint64_t rangeTotal = 0;
+    };
+
+    /**
+     * Start a fetch of the entire body which uses @c m_cacheEntry.  The request is made conditional or limited to the
+     * part of the body which is not cached as the entry allows, or no request is made if the whole body is cached and
+     * fresh.
+     *
+     * @return Whether the fetch was started.
+     */
+    bool startCachedFetch();
+
+    /**
+     * Decide from the response how its body is handled, and settle the promises made by @c getContent().  This is
+     * called on the @c CurlFetchEngine thread once the headers of the final response are in.
+     */
+    void onResponse();
+
+    /**
+     * Store part of the body in @c m_cacheEntry for @c serveFromCache() to pass on.
+     *
+     * @param data The bytes.
+     * @param size The number of bytes.
+     * @return The number of bytes consumed, which is less than @c size if the transfer must stop.
+     */
+    size_t cacheBody(const char* data, size_t size);
+
+    /**
+     * Copy as much of the body from @c m_cacheEntry to @c m_streamWriter as it has room for.  Once the transfer has
+     * finished and the whole body has been passed on, the fetch is done.  This is called on the @c CurlFetchEngine
+     * thread when more of the body is cached, when the transfer finishes and when @c m_streamWriter has room again, or
+     * by the destructor once the fetch has been removed from the engine.
+     */
+    void serveFromCache();
+
     /// The callback to parse HTTP headers.
     static size_t headerCallback(char* data, size_t size, size_t nmemb, void* userData);
 
@@ -60,6 +155,20 @@ private:
     /// A no-op callback to not parse HTTP bodies.
     static size_t noopCallback(char* data, size_t size, size_t nmemb, void* userData);
 
+    /**
+     * Resume the transfer, or the serving of the cached body, if it is waiting because @c m_streamWriter was full.
+     * This is called by @c m_streamWriter when a reader frees some space or the writer is closed.
+     */
+    void onSpaceAvailable();
+
+    /**
+     * Settle the promises made by @c getContent() once the transfer has finished.  This is called on the
+     * @c CurlFetchEngine thread, or by the destructor if the transfer is stopped before it finishes.
+     *
+     * @param curlReturnValue The result of the transfer.
+     */
+    void onTransferComplete(CURLcode curlReturnValue);
+
     /// The URL to fetch from.
     std::string m_url;
 
@@ -95,14 +204,71 @@ private:
      */
     std::string m_lastContentType;
 
-    /// Flag to indicate that the data-fetch operation has completed.
-    std::atomic<bool> m_done;
+    /// Whether @c m_streamWriter was created by this object, in which case it is closed when the transfer finishes.
+    bool m_writerWasCreatedLocally;
 
     /**
-     * Internal thread that does the curl_easy_perform. The reason for using a thread is that curl_easy_perform may
-     * block forever if the URL specified is a live stream.
+     * The number of bytes at the start of the data passed to @c bodyCallback() which were already written before the
+     * transfer was paused.
      */
-    std::thread m_thread;
+    size_t m_bytesToSkip;
+
+    /// What was requested from @c getContent().
+    FetchOptions m_fetchOption;
+
+    /// Whether the transfer was handed to @c m_engine.
+    bool m_transferStarted;
+
+    /// Flag to indicate that the data-fetch operation has completed.
+    std::atomic<bool> m_done;
+
+    /// Serializes setting @c m_done with waiting for it.
+    std::mutex m_doneMutex;
+
+    /// Notified when @c m_done is set.
+    std::condition_variable m_doneTrigger;
+
+    /// The engine the transfer runs on.
+    std::shared_ptr<CurlFetchEngine> m_engine;
+
+    /// The cache to read bodies from and store them in, or @c nullptr.
+    std::shared_ptr<HttpContentCache> m_cache;
+
+    /// The cache entry of an @c ENTIRE_BODY fetch, or @c nullptr if the cache is not used.
+    std::unique_ptr<HttpContentCache::Entry> m_cacheEntry;
+
+    /// The number of bytes of the body which were cached when the fetch started and were requested with a range.
+    uint64_t m_rangeStart;
+
+    /// Whether the whole body was cached and the request asks the server whether it is still current.
+    bool m_isRevalidating;
+
+    /// The cache headers of the last response.  Since we follow redirects, we only want the last ones.
+    CacheHeaders m_cacheHeaders;
+
+    /// How the body reaches the attachment.  This only changes on the @c CurlFetchEngine thread.
+    BodyMode m_bodyMode;
+
+    /// Whether nothing more will be appended to @c m_cacheEntry.
+    bool m_transferFinished;
+
+    /// Whether @c serveFromCache() should stop because the attachment was closed or could not be written.
+    std::atomic<bool> m_stopServing;
+
+    /// The number of bytes of the body passed on from @c m_cacheEntry to @c m_streamWriter.
+    uint64_t m_serveOffset;
+
+    /// The buffer @c serveFromCache() reads the cached body into.
+    std::vector<char> m_serveBuffer;
+
+    /// Whether @c m_streamWriter calls @c onSpaceAvailable(), so that the transfer can pause while it is full.
+    bool m_canWaitForSpace;
+
+    /// Whether the transfer is paused, or about to be, until @c m_streamWriter has room.
+    std::atomic<bool> m_isWaitingForSpace;
+
+    /// Whether the destructor is stopping the transfer.
+    std::atomic<bool> m_isShuttingDown;
 
     /// Flag to indicate that a call to @c getContent() has been made. Subsequent calls will not be accepted.
     std::atomic_flag m_hasObjectBeenUsed;
@@ -203,6 +203,18 @@ public:
      */
     virtual bool resume(SourceId id) = 0;
 
+    /**
+     * Prepares the audio specified by the @c setSource() call so that a following @c play() starts without waiting for
+     * the source to be opened and decoded.  No observer callback is made when prerolling completes.  The default
+     * implementation does not support prerolling, in which case @c play() behaves exactly as it would otherwise.
+     *
+     * @param id The id of the source on which to operate.
+     * @return @c true if prerolling was started, or @c false otherwise.
+     */
+    virtual bool preroll(SourceId id) {
+        return false;
+    }
+
     /**
      * Returns the offset, in milliseconds, of the media source.
      *
@@ -213,6 +225,19 @@ public:
      */
     virtual std::chrono::milliseconds getOffset(SourceId id) = 0;
 
+    /**
+     * Returns the duration, in milliseconds, of the media source.  The default implementation does not know the
+     * duration of any source.
+     *
+     * @param id The id of the source on which to operate.
+     *
+     * @return The duration of the source if it is the active source and its duration is known, or
+     *      @c MEDIA_PLAYER_INVALID_OFFSET otherwise.
+     */
+    virtual std::chrono::milliseconds getDuration(SourceId id) {
+        return MEDIA_PLAYER_INVALID_OFFSET;
+    }
+
     /**
      * Returns the number of bytes queued up in the media player buffers.
      *
@@ -46,6 +46,9 @@ public:
         // AudioInputProcessor send the message
         AIP_SEND,
 
+        // ACL hands the first byte of a message attachment to the transport
+        ACL_ATTACHMENT_FIRST_BYTE,
+
         // Used when issuing an extra metric log for missing Ids
         BUILDING_MESSAGE
     };
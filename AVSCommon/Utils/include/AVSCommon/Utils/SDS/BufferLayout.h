@@ -16,8 +16,10 @@
 #ifndef ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_SDS_BUFFERLAYOUT_H_
 #define ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_INCLUDE_AVSCOMMON_UTILS_SDS_BUFFERLAYOUT_H_
 
+#include <atomic>
 #include <cstdint>
 #include <cstddef>
+#include <functional>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -301,7 +303,10 @@ public:
      */
     static size_t calculateDataOffset(size_t wordSize, size_t maxReaders);
 
-    /// This function calls @c updateOldestUnconsumedCursorLocked() while holding @c Header::backwardSeekMutex.
+    /**
+     * This function calls @c updateOldestUnconsumedCursorLocked() while holding @c Header::backwardSeekMutex, and then
+     * calls @c notifySpaceAvailable() if the cursor moved.
+     */
     void updateOldestUnconsumedCursor();
 
     /**
@@ -325,8 +330,43 @@ public:
      *     updated.
      *
      * @note As an optimization, we could skip this function if Writer policy is nonblockable (ACSDK-251).
+     *
+     * @return @c true if @c oldestUnconsumedCursor moved, which means there may be more space for the @c Writer.
+     */
+    bool updateOldestUnconsumedCursorLocked();
+
+    /**
+     * This function sets a function to call in this process when there may be more data for a @c Reader: the
+     * @c Writer has written or closed, or the @c Reader has been closed.  Unlike waiting on
+     * @c Header::dataAvailableConditionVariable, this lets a consumer wait for data in an event loop of its own.
+     * Callbacks are not shared with other processes attached to the @c Buffer.
+     *
+     * The function is called with an internal mutex held, so once this returns with a different function (or
+     * @c nullptr) the previous one will not be called again.  It must not block, and must not set a callback itself.
+     *
+     * @param id The id of the reader to call the function for.
+     * @param callback The function to call, or @c nullptr to stop calling one.
      */
-    void updateOldestUnconsumedCursorLocked();
+    void setDataAvailableCallback(size_t id, std::function<void()> callback);
+
+    /**
+     * This function sets a function to call in this process when a @c write() which would have blocked may now
+     * succeed: a @c Reader has freed some space, or the @c Writer has closed.  Unlike waiting on
+     * @c Header::spaceAvailableConditionVariable, this lets a producer wait for space in an event loop of its own.
+     * Callbacks are not shared with other processes attached to the @c Buffer.
+     *
+     * The function is called with an internal mutex held, so once this returns with a different function (or
+     * @c nullptr) the previous one will not be called again.  It must not block, and must not set a callback itself.
+     *
+     * @param callback The function to call, or @c nullptr to stop calling one.
+     */
+    void setSpaceAvailableCallback(std::function<void()> callback);
+
+    /// This function calls the functions set with @c setDataAvailableCallback().
+    void notifyDataAvailable();
+
+    /// This function calls the function set with @c setSpaceAvailableCallback().
+    void notifySpaceAvailable();
 
 private:
     /**
@@ -411,6 +451,21 @@ private:
 
     /// Precalculated pointer to the circular data.
     uint8_t* m_data;
+
+    /// Serializes setting and calling the callbacks below.
+    std::mutex m_callbackMutex;
+
+    /// The functions set with @c setDataAvailableCallback(), indexed by reader id.
+    std::vector<std::function<void()>> m_dataAvailableCallbacks;
+
+    /// The function set with @c setSpaceAvailableCallback().
+    std::function<void()> m_spaceAvailableCallback;
+
+    /// The number of functions set with @c setDataAvailableCallback(), so that writes can skip the mutex if none are.
+    std::atomic<size_t> m_numDataAvailableCallbacks;
+
+    /// Whether a function is set with @c setSpaceAvailableCallback(), so that reads can skip the mutex if none is.
+    std::atomic<bool> m_hasSpaceAvailableCallback;
 };
 
 template <typename T>
@@ -423,7 +478,9 @@ SharedDataStream<T>::BufferLayout::BufferLayout(std::shared_ptr<Buffer> buffer)
         m_readerCursorArray{nullptr},
         m_readerCloseIndexArray{nullptr},
         m_dataSize{0},
-        m_data{nullptr} {
+        m_data{nullptr},
+        m_numDataAvailableCallbacks{0},
+        m_hasSpaceAvailableCallback{false} {
 }
 
 template <typename T>
@@ -615,12 +672,18 @@ size_t SharedDataStream<T>::BufferLayout::calculateDataOffset(size_t wordSize, s
 template <typename T>
 void SharedDataStream<T>::BufferLayout::updateOldestUnconsumedCursor() {
     // Note: as an optimization, we could skip this function if Writer policy is nonblockable (ACSDK-251).
-    std::lock_guard<Mutex> backwardSeekLock(getHeader()->backwardSeekMutex);
-    updateOldestUnconsumedCursorLocked();
+    bool moved = false;
+    {
+        std::lock_guard<Mutex> backwardSeekLock(getHeader()->backwardSeekMutex);
+        moved = updateOldestUnconsumedCursorLocked();
+    }
+    if (moved) {
+        notifySpaceAvailable();
+    }
 }
 
 template <typename T>
-void SharedDataStream<T>::BufferLayout::updateOldestUnconsumedCursorLocked() {
+bool SharedDataStream<T>::BufferLayout::updateOldestUnconsumedCursorLocked() {
     auto header = getHeader();
 
     // Note: as an optimization, we could skip this function if Writer policy is nonblockable (ACSDK-251).
@@ -664,6 +727,57 @@ void SharedDataStream<T>::BufferLayout::updateOldestUnconsumedCursorLocked() {
         // Notify the writer(s).
         // Note: as an optimization, we could skip this if there are no blocking writers (ACSDK-251).
         header->spaceAvailableConditionVariable.notify_all();
+        return true;
+    }
+    return false;
+}
+
+template <typename T>
+void SharedDataStream<T>::BufferLayout::setDataAvailableCallback(size_t id, std::function<void()> callback) {
+    std::lock_guard<std::mutex> lock(m_callbackMutex);
+    if (id >= m_dataAvailableCallbacks.size()) {
+        if (!callback) {
+            return;
+        }
+        m_dataAvailableCallbacks.resize(id + 1);
+    }
+    if (m_dataAvailableCallbacks[id]) {
+        --m_numDataAvailableCallbacks;
+    }
+    m_dataAvailableCallbacks[id] = std::move(callback);
+    if (m_dataAvailableCallbacks[id]) {
+        ++m_numDataAvailableCallbacks;
+    }
+}
+
+template <typename T>
+void SharedDataStream<T>::BufferLayout::setSpaceAvailableCallback(std::function<void()> callback) {
+    std::lock_guard<std::mutex> lock(m_callbackMutex);
+    m_spaceAvailableCallback = std::move(callback);
+    m_hasSpaceAvailableCallback = static_cast<bool>(m_spaceAvailableCallback);
+}
+
+template <typename T>
+void SharedDataStream<T>::BufferLayout::notifyDataAvailable() {
+    if (0 == m_numDataAvailableCallbacks) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_callbackMutex);
+    for (auto& callback : m_dataAvailableCallbacks) {
+        if (callback) {
+            callback();
+        }
+    }
+}
+
+template <typename T>
+void SharedDataStream<T>::BufferLayout::notifySpaceAvailable() {
+    if (!m_hasSpaceAvailableCallback) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_callbackMutex);
+    if (m_spaceAvailableCallback) {
+        m_spaceAvailableCallback();
     }
 }
 
@@ -18,6 +18,7 @@
 
 #include <cstdint>
 #include <cstddef>
+#include <functional>
 #include <vector>
 #include <mutex>
 #include <limits>
@@ -114,6 +115,30 @@ public:
      */
     ssize_t read(void* buf, size_t nWords, std::chrono::milliseconds timeout = std::chrono::milliseconds(0));
 
+    /**
+     * This function waits until a @c read() would return without waiting: there is data to read, the @c Writer has
+     * closed, or this @c Reader has reached its close index.  No data is consumed.  This works with either @c Policy,
+     * which lets a @c NONBLOCKING consumer sleep until data arrives instead of polling.
+     *
+     * @param timeout The maximum time to wait for data.  If this parameter is zero, there is no timeout and this
+     *     function will wait until one of the conditions above is met.
+     * @return @c true if a @c read() would return without waiting, or @c false if the timeout expired first.
+     */
+    bool waitForData(std::chrono::milliseconds timeout = std::chrono::milliseconds(0));
+
+    /**
+     * This function sets a function to call when a @c read() may return without waiting, so that a @c NONBLOCKING
+     * consumer can wait for data in its own event loop instead of a thread blocked in @c waitForData().  The function
+     * is called when the @c Writer writes or closes, or this @c Reader is closed.  It is only called for a @c Writer in
+     * this process, and it is called on the thread which wrote or closed, so it must not block.
+     *
+     * Once this returns, a function set previously will not be called again.  The function is cleared when the
+     * @c Reader is destroyed.
+     *
+     * @param callback The function to call, or @c nullptr to stop calling one.
+     */
+    void setDataAvailableCallback(std::function<void()> callback);
+
     /**
      * This function moves the @c Reader to the specified location in the stream.  If successful, subsequent calls to
      * @c read() will start from the new location.  For this function to succeed, the specified location *must* point
@@ -153,7 +178,7 @@ public:
      * @note This function can be called from any thread or process, and it will schedule the @c Reader to close,
      *     however it will *not* wake up a @c BLOCKING @c Reader which is already blocked waiting for data.  In the
      *     case of a blocked @c read(), that @c read() will return when it wakes up - either due to a timeout, or due
-     *     to a @c Writer adding data to the stream.
+     *     to a @c Writer adding data to the stream.  A thread blocked in @c waitForData() is woken up.
      */
     void close(Index offset = 0, Reference reference = Reference::AFTER_READER);
 
@@ -235,6 +260,8 @@ SharedDataStream<T>::Reader::~Reader() {
     // updateOldestUnconsumedCursor().  See updateOldestUnconsumedCursor() comments for further explanation.
     seek(0, Reference::BEFORE_WRITER);
 
+    m_bufferLayout->setDataAvailableCallback(m_id, nullptr);
+
     std::lock_guard<Mutex> lock(m_bufferLayout->getHeader()->readerEnableMutex);
     m_bufferLayout->disableReaderLocked(m_id);
     m_bufferLayout->updateOldestUnconsumedCursor();
@@ -343,6 +370,27 @@ ssize_t SharedDataStream<T>::Reader::read(void* buf, size_t nWords, std::chrono:
     return nWords;
 }
 
+template <typename T>
+bool SharedDataStream<T>::Reader::waitForData(std::chrono::milliseconds timeout) {
+    auto header = m_bufferLayout->getHeader();
+    auto predicate = [this, header] {
+        return header->hasWriterBeenClosed || *m_readerCursor >= m_readerCloseIndex->load() ||
+               tell(Reference::BEFORE_WRITER) > 0;
+    };
+
+    std::unique_lock<Mutex> lock(header->dataAvailableMutex);
+    if (std::chrono::milliseconds::zero() == timeout) {
+        header->dataAvailableConditionVariable.wait(lock, predicate);
+        return true;
+    }
+    return header->dataAvailableConditionVariable.wait_for(lock, timeout, predicate);
+}
+
+template <typename T>
+void SharedDataStream<T>::Reader::setDataAvailableCallback(std::function<void()> callback) {
+    m_bufferLayout->setDataAvailableCallback(m_id, std::move(callback));
+}
+
 template <typename T>
 bool SharedDataStream<T>::Reader::seek(Index offset, Reference reference) {
     auto header = m_bufferLayout->getHeader();
@@ -470,7 +518,14 @@ void SharedDataStream<T>::Reader::close(Index offset, Reference reference) {
         logger::acsdkError(logger::LogEntry(TAG, "closeFailed").d("reason", "invalidReference"));
     }
 
-    *m_readerCloseIndex = absolute;
+    // Hold the data available mutex while moving the close index so a concurrent waitForData() can't miss the notify.
+    auto header = m_bufferLayout->getHeader();
+    {
+        std::lock_guard<Mutex> lock(header->dataAvailableMutex);
+        *m_readerCloseIndex = absolute;
+    }
+    header->dataAvailableConditionVariable.notify_all();
+    m_bufferLayout->notifyDataAvailable();
 }
 
 template <typename T>
@@ -18,6 +18,7 @@
 
 #include <cstdint>
 #include <cstddef>
+#include <functional>
 #include <vector>
 #include <mutex>
 #include <limits>
@@ -96,6 +97,20 @@ public:
      */
     ssize_t write(const void* buf, size_t nWords, std::chrono::milliseconds timeout = std::chrono::milliseconds(0));
 
+    /**
+     * This function sets a function to call when a @c write() which would have blocked or returned @c WOULDBLOCK may
+     * now succeed, so that a producer can wait for space in its own event loop instead of a blocking @c write().  The
+     * function is called when a @c Reader frees some space by reading, seeking forward or going away, or when this
+     * @c Writer closes.  It is only called for @c Readers in this process, and it is called on the thread which freed
+     * the space, so it must not block.
+     *
+     * Once this returns, a function set previously will not be called again.  The function is cleared when the
+     * @c Writer is destroyed.
+     *
+     * @param callback The function to call, or @c nullptr to stop calling one.
+     */
+    void setSpaceAvailableCallback(std::function<void()> callback);
+
     /**
      * This function reports the current position of the @c Writer in the stream.
      *
@@ -161,6 +176,7 @@ SharedDataStream<T>::Writer::Writer(Policy policy, std::shared_ptr<BufferLayout>
 template <typename T>
 SharedDataStream<T>::Writer::~Writer() {
     close();
+    m_bufferLayout->setSpaceAvailableCallback(nullptr);
 }
 
 template <typename T>
@@ -278,27 +294,29 @@ ssize_t SharedDataStream<T>::Writer::write(const void* buf, size_t nWords, std::
     }
 
     // Advance the write cursor.
-    // Note: To prevent a race condition and ensure that readers which block on dataAvailableConditionVariable don't
-    // miss a notify, we should always lock the dataAvailableConditionVariable mutex while moving writeStartCursor.  As
-    // an optimization, we skip that lock for NONBLOCKABLE writers under the assumption that they will be writing
-    // continuously, so a missed notification is not significant.
-    // Note: As a further optimization, the lock could be omitted if no blocking readers are in use (ACSDK-251).
-    std::unique_lock<Mutex> dataAvailableLock(header->dataAvailableMutex, std::defer_lock);
-    if (Policy::NONBLOCKABLE == m_policy) {
-        dataAvailableLock.lock();
-    }
-    header->writeStartCursor = header->writeEndCursor.load();
-    if (Policy::NONBLOCKABLE == m_policy) {
-        dataAvailableLock.unlock();
+    // Note: To prevent a race condition and ensure that readers which block on dataAvailableConditionVariable (in
+    // Reader::read() or Reader::waitForData()) don't miss a notify, we always lock the dataAvailableConditionVariable
+    // mutex while moving writeStartCursor.  A missed notify would leave such a reader asleep until its timeout even
+    // though data is available, and writers of any policy may go quiet right after a write.
+    // Note: As an optimization, the lock could be omitted if no blocking readers are in use (ACSDK-251).
+    {
+        std::lock_guard<Mutex> dataAvailableLock(header->dataAvailableMutex);
+        header->writeStartCursor = header->writeEndCursor.load();
     }
 
     // Notify the reader(s).
     // Note: as an optimization, we could skip this if there are no blocking readers (ACSDK-251).
     header->dataAvailableConditionVariable.notify_all();
+    m_bufferLayout->notifyDataAvailable();
 
     return nWords;
 }
 
+template <typename T>
+void SharedDataStream<T>::Writer::setSpaceAvailableCallback(std::function<void()> callback) {
+    m_bufferLayout->setSpaceAvailableCallback(std::move(callback));
+}
+
 template <typename T>
 typename SharedDataStream<T>::Index SharedDataStream<T>::Writer::tell() const {
     return m_bufferLayout->getHeader()->writeStartCursor;
@@ -307,20 +325,24 @@ typename SharedDataStream<T>::Index SharedDataStream<T>::Writer::tell() const {
 template <typename T>
 void SharedDataStream<T>::Writer::close() {
     auto header = m_bufferLayout->getHeader();
-    std::lock_guard<Mutex> lock(header->writerEnableMutex);
-    if (m_closed) {
-        return;
-    }
-    if (header->isWriterEnabled) {
-        header->isWriterEnabled = false;
+    {
+        std::lock_guard<Mutex> lock(header->writerEnableMutex);
+        if (m_closed) {
+            return;
+        }
+        if (header->isWriterEnabled) {
+            header->isWriterEnabled = false;
 
-        std::unique_lock<Mutex> dataAvailableLock(header->dataAvailableMutex);
+            std::unique_lock<Mutex> dataAvailableLock(header->dataAvailableMutex);
 
-        header->hasWriterBeenClosed = true;
+            header->hasWriterBeenClosed = true;
 
-        header->dataAvailableConditionVariable.notify_all();
+            header->dataAvailableConditionVariable.notify_all();
+        }
+        m_closed = true;
     }
-    m_closed = true;
+    m_bufferLayout->notifyDataAvailable();
+    m_bufferLayout->notifySpaceAvailable();
 }
 
 template <typename T>
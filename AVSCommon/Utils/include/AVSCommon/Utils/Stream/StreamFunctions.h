@@ -18,6 +18,7 @@
 
 #include <memory>
 #include <istream>
+#include <string>
 
 namespace alexaClientSDK {
 namespace avsCommon {
@@ -30,8 +31,12 @@ namespace stream {
  *
  * @param data pointer to the data to make into a stream
  * @param length length of data
+ * @param resourceId an identifier for the data, reported by the stream's @c Streambuf, or empty if it has none
  */
-std::unique_ptr<std::istream> streamFromData(const unsigned char* data, size_t length);
+std::unique_ptr<std::istream> streamFromData(
+    const unsigned char* data,
+    size_t length,
+    const std::string& resourceId = "");
 
 }  // namespace stream
 }  // namespace utils
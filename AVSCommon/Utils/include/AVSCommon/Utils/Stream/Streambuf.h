@@ -34,8 +34,18 @@ public:
      *
      * @param data the beginning of the byte array
      * @param length the size of the byte array
+     * @param resourceId an identifier for the byte array, which is the same for every @c Streambuf over the same
+     *     resource, or empty if it has none
      */
-    Streambuf(const unsigned char* data, size_t length);
+    Streambuf(const unsigned char* data, size_t length, const std::string& resourceId = "");
+
+    /**
+     * Get the identifier of the byte array, which consumers may use to recognize a resource they have seen before
+     * without reading it.
+     *
+     * @return The identifier given to the constructor, or an empty string if none was given.
+     */
+    const std::string& getResourceId() const;
 
     std::streampos seekoff(
         std::streamoff off,
@@ -59,6 +69,7 @@ private:
     char* const m_begin;
     char* m_current;
     char* const m_end;
+    const std::string m_resourceId;
 };
 
 }  // namespace stream
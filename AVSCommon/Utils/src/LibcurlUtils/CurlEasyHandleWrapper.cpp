@@ -46,7 +46,8 @@ CurlEasyHandleWrapper::CurlEasyHandleWrapper() :
         m_handle{curl_easy_init()},
         m_requestHeaders{nullptr},
         m_postHeaders{nullptr},
-        m_post{nullptr} {
+        m_post{nullptr},
+        m_share{CurlShareHandleWrapper::acquire()} {
     if (m_handle == nullptr) {
         ACSDK_ERROR(LX("CurlEasyHandleWrapperFailed").d("reason", "curl_easy_init failed"));
     } else {
@@ -244,7 +245,14 @@ bool CurlEasyHandleWrapper::setDefaultOptions() {
          * The documentation from libcurl recommends setting CURLOPT_NOSIGNAL to 1 for multi-threaded applications.
          * https://curl.haxx.se/libcurl/c/threadsafe.html
          */
-        return setopt(CURLOPT_NOSIGNAL, 1);
+        if (!setopt(CURLOPT_NOSIGNAL, 1)) {
+            return false;
+        }
+        // Without the share a handle still works, it just does its own DNS lookups and TLS handshakes.
+        if (m_share && !setopt(CURLOPT_SHARE, m_share->getCurlHandle())) {
+            ACSDK_WARN(LX("setDefaultOptions").d("reason", "setShareFailed"));
+        }
+        return true;
     }
     ACSDK_ERROR(LX("setDefaultOptions").d("reason", "prepareForTLS failed"));
     curl_easy_cleanup(m_handle);
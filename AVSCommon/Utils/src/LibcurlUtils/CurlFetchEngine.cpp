@@ -0,0 +1,289 @@
+/*
+ * Copyright 2017-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include <AVSCommon/Utils/LibcurlUtils/CurlFetchEngine.h>
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace libcurlUtils {
+
+using namespace alexaClientSDK::avsCommon::utils;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("CurlFetchEngine");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+#if LIBCURL_VERSION_NUM >= 0x074400
+/**
+ * The longest time to wait for activity on the transfers, which is in effect no limit.  libcurl shortens the wait to
+ * its own next timeout, and @c curl_multi_wakeup() ends it early when there are changes or submitted functions.
+ */
+static const int MAX_WAIT_MS = std::numeric_limits<int>::max();
+#else
+/// The longest time to wait for activity on the transfers.  Changes queued meanwhile wait at most this long.
+static const std::chrono::milliseconds MAX_WAIT(10);
+#endif
+
+/// Serializes access to @c g_instance.
+static std::mutex g_instanceMutex;
+
+/// The engine shared by every user in the process, while any of them hold it.
+static std::weak_ptr<CurlFetchEngine> g_instance;
+
+std::shared_ptr<CurlFetchEngine> CurlFetchEngine::acquire() {
+    std::lock_guard<std::mutex> lock(g_instanceMutex);
+    auto instance = g_instance.lock();
+    if (!instance) {
+        instance = create();
+        g_instance = instance;
+    }
+    return instance;
+}
+
+std::shared_ptr<CurlFetchEngine> CurlFetchEngine::create() {
+    auto multi = CurlMultiHandleWrapper::create();
+    if (!multi) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "createMultiHandleFailed"));
+        return nullptr;
+    }
+    return std::shared_ptr<CurlFetchEngine>(new CurlFetchEngine(std::move(multi)));
+}
+
+CurlFetchEngine::CurlFetchEngine(std::unique_ptr<CurlMultiHandleWrapper> multi) :
+        m_multi{std::move(multi)},
+        m_changeCount{0},
+        m_isShuttingDown{false} {
+    m_thread = std::thread(&CurlFetchEngine::loop, this);
+}
+
+CurlFetchEngine::~CurlFetchEngine() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isShuttingDown = true;
+    }
+    m_wakeTrigger.notify_all();
+    wakeUp();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    for (auto& transfer : m_transfers) {
+        m_multi->removeHandle(transfer.first);
+    }
+    m_transfers.clear();
+}
+
+bool CurlFetchEngine::addTransfer(CURL* handle, CompletionCallback onComplete) {
+    if (!handle || !onComplete) {
+        ACSDK_ERROR(LX("addTransferFailed").d("reason", "invalidParameters"));
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_isShuttingDown) {
+            ACSDK_ERROR(LX("addTransferFailed").d("reason", "shuttingDown"));
+            return false;
+        }
+        m_transfersToAdd.emplace_back(handle, std::move(onComplete));
+    }
+    m_wakeTrigger.notify_all();
+    wakeUp();
+    return true;
+}
+
+void CurlFetchEngine::removeTransfer(CURL* handle) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (auto it = m_transfersToAdd.begin(); it != m_transfersToAdd.end(); ++it) {
+        if (it->first == handle) {
+            m_transfersToAdd.erase(it);
+            break;
+        }
+    }
+    m_tasks.erase(
+        std::remove_if(
+            m_tasks.begin(),
+            m_tasks.end(),
+            [handle](const std::pair<CURL*, std::function<void()>>& task) { return task.first == handle; }),
+        m_tasks.end());
+    if (std::this_thread::get_id() == m_thread.get_id()) {
+        // Called from one of the engine's own callbacks, so the transfer can be removed straight away.
+        lock.unlock();
+        removeFromMulti(handle);
+        return;
+    }
+    // Even if the transfer was never added, wait for the engine thread, which may be calling a submitted function.
+    m_transfersToRemove.insert(handle);
+    auto changeCount = m_changeCount;
+    m_wakeTrigger.notify_all();
+    wakeUp();
+    m_changesApplied.wait(lock, [this, changeCount]() { return m_changeCount != changeCount || m_isShuttingDown; });
+}
+
+bool CurlFetchEngine::submit(CURL* handle, std::function<void()> task) {
+    if (!handle || !task) {
+        ACSDK_ERROR(LX("submitFailed").d("reason", "invalidParameters"));
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_isShuttingDown) {
+            ACSDK_ERROR(LX("submitFailed").d("reason", "shuttingDown"));
+            return false;
+        }
+        m_tasks.emplace_back(handle, std::move(task));
+    }
+    m_wakeTrigger.notify_all();
+    wakeUp();
+    return true;
+}
+
+void CurlFetchEngine::loop() {
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            // With nothing to run, sleep until there is.
+            m_wakeTrigger.wait(lock, [this]() {
+                return m_isShuttingDown || !m_transfers.empty() || !m_transfersToAdd.empty() ||
+                       !m_transfersToRemove.empty() || !m_tasks.empty();
+            });
+            if (m_isShuttingDown) {
+                m_changesApplied.notify_all();
+                return;
+            }
+        }
+        applyPendingChanges();
+        runSubmittedTasks();
+
+        int numTransfersRunning = 0;
+        m_multi->perform(&numTransfersRunning);
+        completeFinishedTransfers();
+
+        if (m_transfers.empty()) {
+            continue;
+        }
+#if LIBCURL_VERSION_NUM >= 0x074400
+        auto result = curl_multi_poll(m_multi->getCurlHandle(), NULL, 0, MAX_WAIT_MS, NULL);
+        if (result != CURLM_OK) {
+            ACSDK_ERROR(LX("curlMultiPollFailed").d("error", curl_multi_strerror(result)));
+        }
+#else
+        int numTransfersUpdated = 0;
+        m_multi->wait(MAX_WAIT, &numTransfersUpdated);
+#endif
+    }
+}
+
+void CurlFetchEngine::applyPendingChanges() {
+    std::vector<CompletionCallback> failedTransfers;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto handle : m_transfersToRemove) {
+            removeFromMulti(handle);
+        }
+        m_transfersToRemove.clear();
+        for (auto& transfer : m_transfersToAdd) {
+            if (m_multi->addHandle(transfer.first) == CURLM_OK) {
+                m_transfers[transfer.first] = std::move(transfer.second);
+            } else {
+                failedTransfers.push_back(std::move(transfer.second));
+            }
+        }
+        m_transfersToAdd.clear();
+        ++m_changeCount;
+    }
+    m_changesApplied.notify_all();
+    for (auto& onComplete : failedTransfers) {
+        onComplete(CURLE_FAILED_INIT);
+    }
+}
+
+void CurlFetchEngine::completeFinishedTransfers() {
+    std::vector<std::pair<CompletionCallback, CURLcode>> finishedTransfers;
+    int numMessages = 0;
+    while (auto message = m_multi->infoRead(&numMessages)) {
+        if (message->msg != CURLMSG_DONE) {
+            continue;
+        }
+        auto handle = message->easy_handle;
+        auto result = message->data.result;
+        auto it = m_transfers.find(handle);
+        if (it == m_transfers.end()) {
+            continue;
+        }
+        finishedTransfers.emplace_back(std::move(it->second), result);
+        m_transfers.erase(it);
+        m_multi->removeHandle(handle);
+    }
+    for (auto& transfer : finishedTransfers) {
+        transfer.first(transfer.second);
+    }
+}
+
+void CurlFetchEngine::removeFromMulti(CURL* handle) {
+    auto it = m_transfers.find(handle);
+    if (it != m_transfers.end()) {
+        m_transfers.erase(it);
+        m_multi->removeHandle(handle);
+    }
+}
+
+void CurlFetchEngine::runSubmittedTasks() {
+    size_t numTasks = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        numTasks = m_tasks.size();
+    }
+    /*
+     * Take the functions one at a time, so that one which removes a transfer drops those queued after it for that
+     * transfer.  A transfer removed meanwhile by another thread is still in the multi handle, and its owner is waiting
+     * in removeTransfer() until this loop next applies the pending changes, so its functions are still safe to call.
+     * Functions submitted while these run wait for the next pass, so a function which resubmits itself cannot starve
+     * the transfers.
+     */
+    for (; numTasks > 0; --numTasks) {
+        std::function<void()> task;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_tasks.empty()) {
+                break;
+            }
+            task = std::move(m_tasks.front().second);
+            m_tasks.pop_front();
+        }
+        task();
+    }
+}
+
+void CurlFetchEngine::wakeUp() {
+#if LIBCURL_VERSION_NUM >= 0x074400
+    curl_multi_wakeup(m_multi->getCurlHandle());
+#endif
+}
+
+}  // namespace libcurlUtils
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
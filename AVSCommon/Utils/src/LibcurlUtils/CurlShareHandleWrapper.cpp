@@ -0,0 +1,100 @@
+/*
+ * Copyright 2017-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <AVSCommon/Utils/LibcurlUtils/CurlShareHandleWrapper.h>
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace libcurlUtils {
+
+using namespace alexaClientSDK::avsCommon::utils;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("CurlShareHandleWrapper");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// Serializes access to @c g_instance.
+static std::mutex g_instanceMutex;
+
+/// The instance shared by every easy handle, while any of them hold it.
+static std::weak_ptr<CurlShareHandleWrapper> g_instance;
+
+std::shared_ptr<CurlShareHandleWrapper> CurlShareHandleWrapper::acquire() {
+    std::lock_guard<std::mutex> lock(g_instanceMutex);
+    auto instance = g_instance.lock();
+    if (instance) {
+        return instance;
+    }
+
+    auto handle = curl_share_init();
+    if (!handle) {
+        ACSDK_ERROR(LX("acquireFailed").d("reason", "curlShareInitFailed"));
+        return nullptr;
+    }
+    instance = std::shared_ptr<CurlShareHandleWrapper>(new CurlShareHandleWrapper(handle));
+    CURLSHcode result = CURLSHE_OK;
+    if ((result = curl_share_setopt(handle, CURLSHOPT_LOCKFUNC, lockCallback)) != CURLSHE_OK ||
+        (result = curl_share_setopt(handle, CURLSHOPT_UNLOCKFUNC, unlockCallback)) != CURLSHE_OK ||
+        (result = curl_share_setopt(handle, CURLSHOPT_USERDATA, instance.get())) != CURLSHE_OK ||
+        (result = curl_share_setopt(handle, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS)) != CURLSHE_OK ||
+        (result = curl_share_setopt(handle, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION)) != CURLSHE_OK) {
+        ACSDK_ERROR(LX("acquireFailed").d("reason", "curlShareSetoptFailed").d("error", curl_share_strerror(result)));
+        return nullptr;
+    }
+    g_instance = instance;
+    return instance;
+}
+
+CurlShareHandleWrapper::~CurlShareHandleWrapper() {
+    auto result = curl_share_cleanup(m_handle);
+    if (result != CURLSHE_OK) {
+        ACSDK_ERROR(LX("curlShareCleanupFailed").d("error", curl_share_strerror(result)));
+    }
+    m_handle = nullptr;
+}
+
+CURLSH* CurlShareHandleWrapper::getCurlHandle() {
+    return m_handle;
+}
+
+CurlShareHandleWrapper::CurlShareHandleWrapper(CURLSH* handle) : m_handle{handle} {
+}
+
+void CurlShareHandleWrapper::lockCallback(CURL* handle, curl_lock_data data, curl_lock_access access, void* userData) {
+    auto instance = static_cast<CurlShareHandleWrapper*>(userData);
+    if (instance && data >= 0 && data < CURL_LOCK_DATA_LAST) {
+        instance->m_mutexes[data].lock();
+    }
+}
+
+void CurlShareHandleWrapper::unlockCallback(CURL* handle, curl_lock_data data, void* userData) {
+    auto instance = static_cast<CurlShareHandleWrapper*>(userData);
+    if (instance && data >= 0 && data < CURL_LOCK_DATA_LAST) {
+        instance->m_mutexes[data].unlock();
+    }
+}
+
+}  // namespace libcurlUtils
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
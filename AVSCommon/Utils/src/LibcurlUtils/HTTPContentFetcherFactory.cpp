@@ -22,11 +22,19 @@ namespace avsCommon {
 namespace utils {
 namespace libcurlUtils {
 
+HTTPContentFetcherFactory::HTTPContentFetcherFactory(std::shared_ptr<HttpContentCache> cache) : m_cache{cache} {
+}
+
 std::unique_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterface> HTTPContentFetcherFactory::create(
     const std::string& url) {
     return avsCommon::utils::memory::make_unique<LibCurlHttpContentFetcher>(url);
 }
 
+std::unique_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterface> HTTPContentFetcherFactory::
+    createForReusableContent(const std::string& url) {
+    return avsCommon::utils::memory::make_unique<LibCurlHttpContentFetcher>(url, m_cache);
+}
+
 }  // namespace libcurlUtils
 }  // namespace utils
 }  // namespace avsCommon
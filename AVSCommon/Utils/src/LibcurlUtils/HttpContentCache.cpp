@@ -0,0 +1,503 @@
+/*
+ * Copyright 2017-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <dirent.h>
+#include <sstream>
+#include <vector>
+
+#include <curl/curl.h>
+
+#include "AVSCommon/Utils/File/FileUtils.h"
+#include "AVSCommon/Utils/LibcurlUtils/HttpContentCache.h"
+#include "AVSCommon/Utils/Logger/Logger.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace libcurlUtils {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("HttpContentCache");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The extension of the file holding an entry's cached bytes.
+static const std::string DATA_EXTENSION = ".data";
+
+/// The extension of the file holding an entry's metadata.
+static const std::string META_EXTENSION = ".meta";
+
+/// The extension of a metadata file while it is being written.
+static const std::string TEMPORARY_META_EXTENSION = ".meta.tmp";
+
+/// The fraction of the cache size which a single body may use.
+static const uint64_t MAX_ENTRY_SIZE_DIVISOR = 4;
+
+/**
+ * The fraction of the time since a response without explicit freshness was last modified for which it is considered
+ * fresh, as suggested by RFC 7234 section 4.2.2.
+ */
+static const int HEURISTIC_FRESHNESS_DIVISOR = 10;
+
+/// The longest time a response without explicit freshness is considered fresh.
+static const std::chrono::hours MAX_HEURISTIC_FRESHNESS(24);
+
+/// @name Keys of the lines in a metadata file.
+/// @{
+static const std::string URL_KEY = "url";
+static const std::string CONTENT_TYPE_KEY = "contentType";
+static const std::string ETAG_KEY = "etag";
+static const std::string LAST_MODIFIED_KEY = "lastModified";
+static const std::string CONTENT_LENGTH_KEY = "contentLength";
+static const std::string CACHED_LENGTH_KEY = "cachedLength";
+static const std::string EXPIRY_KEY = "expiry";
+static const std::string LAST_ACCESS_KEY = "lastAccess";
+/// @}
+
+/**
+ * Convert a time to whole seconds since the epoch, for storing in a metadata file.
+ *
+ * @param time The time.
+ * @return The number of seconds.
+ */
+static long long toSeconds(std::chrono::system_clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::seconds>(time.time_since_epoch()).count();
+}
+
+/**
+ * Convert a number of seconds since the epoch read from a metadata file to a time.
+ *
+ * @param seconds The number of seconds.
+ * @return The time.
+ */
+static std::chrono::system_clock::time_point fromSeconds(long long seconds) {
+    return std::chrono::system_clock::time_point(std::chrono::seconds(seconds));
+}
+
+/**
+ * Parse an HTTP date.
+ *
+ * @param date The date.
+ * @param [out] time The time it gives.
+ * @return Whether the date could be parsed.
+ */
+static bool parseHttpDate(const std::string& date, std::chrono::system_clock::time_point* time) {
+    if (date.empty()) {
+        return false;
+    }
+    auto seconds = curl_getdate(date.c_str(), nullptr);
+    if (seconds == -1) {
+        return false;
+    }
+    *time = std::chrono::system_clock::from_time_t(seconds);
+    return true;
+}
+
+/**
+ * Split the value of a @c Cache-Control header into its directives.
+ *
+ * @param cacheControl The value of the header.
+ * @return The directives, in lower case and without surrounding whitespace.
+ */
+static std::vector<std::string> parseDirectives(const std::string& cacheControl) {
+    std::string lowerCase = cacheControl;
+    std::transform(lowerCase.begin(), lowerCase.end(), lowerCase.begin(), ::tolower);
+    std::vector<std::string> directives;
+    std::istringstream iss(lowerCase);
+    std::string directive;
+    while (std::getline(iss, directive, ',')) {
+        directive.erase(0, directive.find_first_not_of(" \t"));
+        directive.erase(directive.find_last_not_of(" \t") + 1);
+        directives.push_back(directive);
+    }
+    return directives;
+}
+
+bool HttpContentCache::Metadata::isComplete() const {
+    return contentLength > 0 && cachedLength >= contentLength;
+}
+
+bool HttpContentCache::Metadata::isFresh(std::chrono::system_clock::time_point now) const {
+    return now < expiry;
+}
+
+bool HttpContentCache::Metadata::hasValidator() const {
+    return !etag.empty() || !lastModified.empty();
+}
+
+HttpContentCache::Entry::Entry(
+    std::shared_ptr<HttpContentCache> cache,
+    const std::string& key,
+    const Metadata& metadata) :
+        m_cache{cache},
+        m_key{key},
+        m_metadata(metadata),
+        m_cachedLength{metadata.cachedLength},
+        m_discard{false} {
+}
+
+HttpContentCache::Entry::~Entry() {
+    m_output.close();
+    m_input.close();
+    m_metadata.cachedLength = m_cachedLength;
+    m_cache->release(m_key, m_metadata, m_discard);
+}
+
+const HttpContentCache::Metadata& HttpContentCache::Entry::getMetadata() const {
+    return m_metadata;
+}
+
+void HttpContentCache::Entry::updateMetadata(const Metadata& metadata) {
+    auto url = m_metadata.url;
+    auto lastAccess = m_metadata.lastAccess;
+    m_metadata = metadata;
+    m_metadata.url = url;
+    m_metadata.lastAccess = lastAccess;
+    m_metadata.cachedLength = m_cachedLength;
+}
+
+bool HttpContentCache::Entry::reset(const Metadata& metadata) {
+    m_output.close();
+    m_input.close();
+    m_cachedLength = 0;
+    updateMetadata(metadata);
+    std::ofstream truncate(m_cache->pathFor(m_key, DATA_EXTENSION), std::ios::binary | std::ios::trunc);
+    if (!truncate.good()) {
+        ACSDK_ERROR(LX("resetFailed").d("reason", "failedToTruncateDataFile"));
+        m_discard = true;
+        return false;
+    }
+    return true;
+}
+
+bool HttpContentCache::Entry::append(const char* data, size_t size) {
+    if (m_discard) {
+        return false;
+    }
+    if (!m_output.is_open()) {
+        auto path = m_cache->pathFor(m_key, DATA_EXTENSION);
+        // Open without truncating, so that the cached bytes are kept, then write after them.
+        m_output.open(path, std::ios::binary | std::ios::in | std::ios::out);
+        if (!m_output.is_open()) {
+            m_output.clear();
+            m_output.open(path, std::ios::binary | std::ios::out);
+        }
+        m_output.seekp(m_cachedLength.load());
+    }
+    m_output.write(data, size);
+    // Flush so that the bytes can be read back through another stream at once.
+    m_output.flush();
+    if (!m_output.good()) {
+        ACSDK_ERROR(LX("appendFailed").d("reason", "writeFailed"));
+        m_discard = true;
+        return false;
+    }
+    m_cachedLength += size;
+    return true;
+}
+
+uint64_t HttpContentCache::Entry::getCachedLength() const {
+    return m_cachedLength;
+}
+
+bool HttpContentCache::Entry::read(uint64_t offset, char* buffer, size_t size) {
+    if (offset + size > m_cachedLength) {
+        ACSDK_ERROR(LX("readFailed").d("reason", "notCached"));
+        return false;
+    }
+    if (!m_input.is_open()) {
+        m_input.open(m_cache->pathFor(m_key, DATA_EXTENSION), std::ios::binary);
+    }
+    m_input.clear();
+    m_input.seekg(offset);
+    m_input.read(buffer, size);
+    if (static_cast<size_t>(m_input.gcount()) != size) {
+        ACSDK_ERROR(LX("readFailed").d("reason", "shortRead"));
+        return false;
+    }
+    return true;
+}
+
+void HttpContentCache::Entry::discard() {
+    m_discard = true;
+}
+
+std::shared_ptr<HttpContentCache> HttpContentCache::create(const std::string& directory, uint64_t maxSizeInBytes) {
+    if (directory.empty()) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "emptyDirectory"));
+        return nullptr;
+    }
+    if (0 == maxSizeInBytes) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "zeroMaxSize"));
+        return nullptr;
+    }
+    auto cache = std::shared_ptr<HttpContentCache>(new HttpContentCache(directory, maxSizeInBytes));
+    cache->m_self = cache;
+    if (!cache->loadIndex()) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "failedToReadDirectory").d("directory", directory));
+        return nullptr;
+    }
+    return cache;
+}
+
+HttpContentCache::HttpContentCache(const std::string& directory, uint64_t maxSizeInBytes) :
+        m_directory{directory},
+        m_maxSizeInBytes{maxSizeInBytes},
+        m_size{0} {
+}
+
+bool HttpContentCache::lookup(const std::string& url, Metadata* metadata) {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    auto it = m_index.find(keyForUrl(url));
+    if (it == m_index.end() || it->second.metadata.url != url || it->second.metadata.cachedLength == 0) {
+        return false;
+    }
+    if (metadata) {
+        *metadata = it->second.metadata;
+    }
+    return true;
+}
+
+std::unique_ptr<HttpContentCache::Entry> HttpContentCache::acquire(const std::string& url) {
+    auto self = m_self.lock();
+    if (!self) {
+        return nullptr;
+    }
+    auto key = keyForUrl(url);
+    std::lock_guard<std::mutex> lock{m_mutex};
+    auto& indexEntry = m_index[key];
+    if (indexEntry.inUse) {
+        ACSDK_DEBUG9(LX("acquireFailed").d("reason", "entryInUse"));
+        return nullptr;
+    }
+    if (indexEntry.metadata.url != url) {
+        // A new entry, or another URL with the same key, which is replaced.
+        if (indexEntry.metadata.cachedLength > 0) {
+            m_size -= indexEntry.metadata.cachedLength;
+            removeFilesLocked(key);
+        }
+        indexEntry.metadata = Metadata();
+        indexEntry.metadata.url = url;
+    }
+    indexEntry.inUse = true;
+    indexEntry.metadata.lastAccess = std::chrono::system_clock::now();
+    return std::unique_ptr<Entry>(new Entry(self, key, indexEntry.metadata));
+}
+
+uint64_t HttpContentCache::getMaxEntrySize() const {
+    return m_maxSizeInBytes / MAX_ENTRY_SIZE_DIVISOR;
+}
+
+uint64_t HttpContentCache::getSize() {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return m_size;
+}
+
+std::chrono::system_clock::time_point HttpContentCache::computeExpiry(
+    const std::string& cacheControl,
+    const std::string& expires,
+    const std::string& lastModified,
+    std::chrono::system_clock::time_point now) {
+    for (const auto& directive : parseDirectives(cacheControl)) {
+        if (directive == "no-store" || directive == "no-cache") {
+            return now;
+        }
+        if (directive.compare(0, 8, "max-age=") == 0) {
+            long long seconds = std::strtoll(directive.c_str() + 8, nullptr, 10);
+            return seconds > 0 ? now + std::chrono::seconds(seconds) : now;
+        }
+    }
+    std::chrono::system_clock::time_point time;
+    if (parseHttpDate(expires, &time)) {
+        return time;
+    }
+    if (parseHttpDate(lastModified, &time) && time < now) {
+        auto freshness = std::chrono::duration_cast<std::chrono::seconds>(now - time) / HEURISTIC_FRESHNESS_DIVISOR;
+        return now + std::min<std::chrono::seconds>(freshness, MAX_HEURISTIC_FRESHNESS);
+    }
+    return now;
+}
+
+bool HttpContentCache::isStorable(const std::string& cacheControl) {
+    auto directives = parseDirectives(cacheControl);
+    return std::find(directives.begin(), directives.end(), "no-store") == directives.end();
+}
+
+bool HttpContentCache::loadIndex() {
+    DIR* directory = opendir(m_directory.c_str());
+    if (!directory) {
+        return false;
+    }
+    std::vector<std::string> names;
+    while (auto item = readdir(directory)) {
+        names.push_back(item->d_name);
+    }
+    closedir(directory);
+
+    std::lock_guard<std::mutex> lock{m_mutex};
+    for (const auto& name : names) {
+        if (name.size() <= META_EXTENSION.size() ||
+            name.compare(name.size() - META_EXTENSION.size(), META_EXTENSION.size(), META_EXTENSION) != 0) {
+            continue;
+        }
+        auto key = name.substr(0, name.size() - META_EXTENSION.size());
+        std::ifstream input(pathFor(key, META_EXTENSION));
+        Metadata metadata;
+        std::string line;
+        while (std::getline(input, line)) {
+            auto separator = line.find('=');
+            if (separator == std::string::npos) {
+                continue;
+            }
+            auto field = line.substr(0, separator);
+            auto value = line.substr(separator + 1);
+            if (field == URL_KEY) {
+                metadata.url = value;
+            } else if (field == CONTENT_TYPE_KEY) {
+                metadata.contentType = value;
+            } else if (field == ETAG_KEY) {
+                metadata.etag = value;
+            } else if (field == LAST_MODIFIED_KEY) {
+                metadata.lastModified = value;
+            } else if (field == CONTENT_LENGTH_KEY) {
+                metadata.contentLength = std::strtoull(value.c_str(), nullptr, 10);
+            } else if (field == CACHED_LENGTH_KEY) {
+                metadata.cachedLength = std::strtoull(value.c_str(), nullptr, 10);
+            } else if (field == EXPIRY_KEY) {
+                metadata.expiry = fromSeconds(std::strtoll(value.c_str(), nullptr, 10));
+            } else if (field == LAST_ACCESS_KEY) {
+                metadata.lastAccess = fromSeconds(std::strtoll(value.c_str(), nullptr, 10));
+            }
+        }
+        std::ifstream data(pathFor(key, DATA_EXTENSION), std::ios::binary | std::ios::ate);
+        if (metadata.url.empty() || keyForUrl(metadata.url) != key || metadata.cachedLength == 0 || !data.good() ||
+            static_cast<uint64_t>(data.tellg()) < metadata.cachedLength) {
+            ACSDK_WARN(LX("loadIndex").d("reason", "removingInvalidEntry").d("key", key));
+            removeFilesLocked(key);
+            continue;
+        }
+        m_size += metadata.cachedLength;
+        m_index[key].metadata = metadata;
+    }
+    ACSDK_DEBUG5(LX("loadIndex").d("entries", m_index.size()).d("size", m_size));
+    evictLocked();
+    return true;
+}
+
+void HttpContentCache::release(const std::string& key, const Metadata& metadata, bool discard) {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    auto it = m_index.find(key);
+    if (it == m_index.end()) {
+        return;
+    }
+    m_size -= it->second.metadata.cachedLength;
+    if (discard || metadata.cachedLength == 0) {
+        removeFilesLocked(key);
+        m_index.erase(it);
+        return;
+    }
+    it->second.metadata = metadata;
+    it->second.inUse = false;
+    m_size += metadata.cachedLength;
+    if (!writeMetadata(key, metadata)) {
+        m_size -= metadata.cachedLength;
+        removeFilesLocked(key);
+        m_index.erase(it);
+        return;
+    }
+    evictLocked();
+}
+
+void HttpContentCache::evictLocked() {
+    while (m_size > m_maxSizeInBytes) {
+        auto oldest = m_index.end();
+        for (auto it = m_index.begin(); it != m_index.end(); ++it) {
+            if (!it->second.inUse &&
+                (oldest == m_index.end() || it->second.metadata.lastAccess < oldest->second.metadata.lastAccess)) {
+                oldest = it;
+            }
+        }
+        if (oldest == m_index.end()) {
+            return;
+        }
+        ACSDK_DEBUG5(LX("evict").sensitive("url", oldest->second.metadata.url));
+        m_size -= oldest->second.metadata.cachedLength;
+        removeFilesLocked(oldest->first);
+        m_index.erase(oldest);
+    }
+}
+
+void HttpContentCache::removeFilesLocked(const std::string& key) {
+    for (const auto& extension : {DATA_EXTENSION, META_EXTENSION}) {
+        auto path = pathFor(key, extension);
+        if (file::fileExists(path)) {
+            file::removeFile(path);
+        }
+    }
+}
+
+bool HttpContentCache::writeMetadata(const std::string& key, const Metadata& metadata) {
+    // Write a new file and rename it over the old one, so that the entry is never left half written.
+    auto temporaryPath = pathFor(key, TEMPORARY_META_EXTENSION);
+    {
+        std::ofstream output(temporaryPath, std::ios::trunc);
+        output << URL_KEY << '=' << metadata.url << '\n'
+               << CONTENT_TYPE_KEY << '=' << metadata.contentType << '\n'
+               << ETAG_KEY << '=' << metadata.etag << '\n'
+               << LAST_MODIFIED_KEY << '=' << metadata.lastModified << '\n'
+               << CONTENT_LENGTH_KEY << '=' << metadata.contentLength << '\n'
+               << CACHED_LENGTH_KEY << '=' << metadata.cachedLength << '\n'
+               << EXPIRY_KEY << '=' << toSeconds(metadata.expiry) << '\n'
+               << LAST_ACCESS_KEY << '=' << toSeconds(metadata.lastAccess) << '\n';
+        if (!output.good()) {
+            ACSDK_ERROR(LX("writeMetadataFailed").d("reason", "writeFailed"));
+            return false;
+        }
+    }
+    if (std::rename(temporaryPath.c_str(), pathFor(key, META_EXTENSION).c_str()) != 0) {
+        ACSDK_ERROR(LX("writeMetadataFailed").d("reason", "renameFailed"));
+        return false;
+    }
+    return true;
+}
+
+std::string HttpContentCache::keyForUrl(const std::string& url) {
+    // A 64 bit FNV-1a hash, which is stable across runs unlike std::hash.
+    uint64_t hash = 14695981039346656037ULL;
+    for (auto c : url) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+    char key[17];
+    std::snprintf(key, sizeof(key), "%016llx", static_cast<unsigned long long>(hash));
+    return key;
+}
+
+std::string HttpContentCache::pathFor(const std::string& key, const std::string& extension) const {
+    return m_directory + "/" + key + extension;
+}
+
+}  // namespace libcurlUtils
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -13,6 +13,8 @@
  * permissions and limitations under the License.
  */
 
+#include <future>
+
 #include <AVSCommon/Utils/LibcurlUtils/HttpPost.h>
 #include <AVSCommon/Utils/LibcurlUtils/HttpResponseCodes.h>
 #include <AVSCommon/Utils/LibcurlUtils/LibcurlUtils.h>
@@ -37,10 +39,15 @@ static const std::string TAG("HttpPost");
 
 std::unique_ptr<HttpPost> HttpPost::create() {
     std::unique_ptr<HttpPost> httpPost(new HttpPost());
-    if (httpPost->m_curl.isValid()) {
-        return httpPost;
+    if (!httpPost->m_curl.isValid()) {
+        return nullptr;
+    }
+    httpPost->m_engine = CurlFetchEngine::acquire();
+    if (!httpPost->m_engine) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "noFetchEngine"));
+        return nullptr;
     }
-    return nullptr;
+    return httpPost;
 }
 
 bool HttpPost::addHTTPHeader(const std::string& header) {
@@ -62,11 +69,19 @@ long HttpPost::doPost(
     }
 
     auto curlHandle = m_curl.getCurlHandle();
-    auto result = curl_easy_perform(curlHandle);
+    auto resultPromise = std::make_shared<std::promise<CURLcode>>();
+    auto resultFuture = resultPromise->get_future();
+    if (!m_engine->addTransfer(curlHandle, [resultPromise](CURLcode result) { resultPromise->set_value(result); })) {
+        ACSDK_ERROR(LX("doPostFailed").d("reason", "addTransferFailed"));
+        body.clear();
+        return HTTPResponseCode::HTTP_RESPONSE_CODE_UNDEFINED;
+    }
+    // The transfer timeout set above bounds this wait.
+    auto result = resultFuture.get();
 
     if (result != CURLE_OK) {
         ACSDK_ERROR(LX("doPostFailed")
-                        .d("reason", "curl_easy_performFailed")
+                        .d("reason", "curlTransferFailed")
                         .d("result", result)
                         .d("error", curl_easy_strerror(result)));
         body.clear();
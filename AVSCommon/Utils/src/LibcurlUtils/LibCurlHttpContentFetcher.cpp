@@ -14,8 +14,12 @@
  */
 
 #include <algorithm>
+#include <cstdlib>
+#include <vector>
 
 #include <AVSCommon/Utils/LibcurlUtils/CurlEasyHandleWrapper.h>
+#include <AVSCommon/Utils/LibcurlUtils/CurlFetchEngine.h>
+#include <AVSCommon/Utils/LibcurlUtils/HttpResponseCodes.h>
 #include <AVSCommon/Utils/LibcurlUtils/LibCurlHttpContentFetcher.h>
 #include <AVSCommon/Utils/Memory/Memory.h>
 #include <AVSCommon/Utils/SDS/InProcessSDS.h>
@@ -29,11 +33,27 @@ namespace libcurlUtils {
 static const std::string TAG("LibCurlHttpContentFetcher");
 
 /**
- * The timeout for a blocking write call to an @c AttachmentWriter. This value may be increased to decrease wakeups but
- * may also increase latency.
+ * The timeout for a write call to an @c AttachmentWriter.  Writes happen on the @c CurlFetchEngine thread shared by
+ * every transfer, so rather than wait for room in the attachment the transfer is paused until the writer reports
+ * that there is some.
+ */
+static const std::chrono::milliseconds TIMEOUT_FOR_WRITE = std::chrono::milliseconds(1);
+
+/**
+ * The timeout for a write call to an @c AttachmentWriter which cannot report when there is room.  Such a transfer
+ * cannot be paused, so it holds up the @c CurlFetchEngine thread until the reader catches up.
  */
 static const std::chrono::milliseconds TIMEOUT_FOR_BLOCKING_WRITE = std::chrono::milliseconds(100);
 
+/// How long to wait before writing again to an attachment which is full but does not block.
+static const std::chrono::milliseconds BUFFER_FULL_RETRY_INTERVAL = std::chrono::milliseconds(10);
+
+/// The number of bytes read from the cache at a time.
+static const size_t CACHE_READ_SIZE = 16 * 1024;
+
+/// The prefix of a weak @c ETag, which may not be used in an @c If-Range header.
+static const std::string WEAK_ETAG_PREFIX = "W/";
+
 /**
  * Create a LogEntry using this file's TAG and the specified event string.
  *
@@ -41,6 +61,22 @@ static const std::chrono::milliseconds TIMEOUT_FOR_BLOCKING_WRITE = std::chrono:
  */
 #define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
 
+/**
+ * Get the value of a header from a raw header line, without surrounding whitespace.
+ *
+ * @param line The header line, starting with the header name.
+ * @param separator The position of the colon after the header name.
+ * @return The value.
+ */
+static std::string getHeaderValue(const std::string& line, size_t separator) {
+    auto begin = line.find_first_not_of(" \t", separator + 1);
+    if (std::string::npos == begin) {
+        return "";
+    }
+    auto end = line.find_last_not_of(" \t\r\n");
+    return line.substr(begin, end + 1 - begin);
+}
+
 size_t LibCurlHttpContentFetcher::headerCallback(char* data, size_t size, size_t nmemb, void* userData) {
     if (!userData) {
         ACSDK_ERROR(LX("headerCallback").d("reason", "nullUserDataPointer"));
@@ -56,6 +92,7 @@ size_t LibCurlHttpContentFetcher::headerCallback(char* data, size_t size, size_t
         iss >> httpVersion >> statusCode;
         LibCurlHttpContentFetcher* thisObject = static_cast<LibCurlHttpContentFetcher*>(userData);
         thisObject->m_lastStatusCode = statusCode;
+        thisObject->m_cacheHeaders = CacheHeaders();
     } else if (line.find("content-type") == 0) {
         // To find lines like: "Content-Type: audio/x-mpegurl; charset=utf-8"
         std::istringstream iss(line);
@@ -70,6 +107,42 @@ size_t LibCurlHttpContentFetcher::headerCallback(char* data, size_t size, size_t
         }
         LibCurlHttpContentFetcher* thisObject = static_cast<LibCurlHttpContentFetcher*>(userData);
         thisObject->m_lastContentType = contentType;
+    } else if (static_cast<LibCurlHttpContentFetcher*>(userData)->m_cacheEntry) {
+        // Header values such as ETag are case sensitive, so they are taken from the line as it was received.
+        LibCurlHttpContentFetcher* thisObject = static_cast<LibCurlHttpContentFetcher*>(userData);
+        std::string rawLine(static_cast<const char*>(data), size * nmemb);
+        auto separator = line.find(':');
+        if (std::string::npos == separator) {
+            return size * nmemb;
+        }
+        auto name = line.substr(0, separator);
+        auto& headers = thisObject->m_cacheHeaders;
+        if ("cache-control" == name) {
+            headers.cacheControl = getHeaderValue(rawLine, separator);
+        } else if ("expires" == name) {
+            headers.expires = getHeaderValue(rawLine, separator);
+        } else if ("etag" == name) {
+            headers.etag = getHeaderValue(rawLine, separator);
+        } else if ("last-modified" == name) {
+            headers.lastModified = getHeaderValue(rawLine, separator);
+        } else if ("content-length" == name) {
+            headers.hasContentLength = true;
+            headers.contentLength = std::strtoull(getHeaderValue(rawLine, separator).c_str(), nullptr, 10);
+        } else if ("content-range" == name) {
+            // To find lines like: "Content-Range: bytes 1000-4999/5000"
+            std::istringstream iss(getHeaderValue(line, separator));
+            std::string unit;
+            uint64_t first = 0;
+            char dash = 0;
+            iss >> unit >> first >> dash;
+            if (iss && "bytes" == unit && '-' == dash) {
+                headers.hasContentRange = true;
+                headers.rangeStart = first;
+                auto slash = line.find('/', separator);
+                headers.rangeTotal =
+                    std::string::npos == slash ? 0 : std::strtoull(line.c_str() + slash + 1, nullptr, 10);
+            }
+        }
     }
     return size * nmemb;
 }
@@ -85,57 +158,94 @@ size_t LibCurlHttpContentFetcher::bodyCallback(char* data, size_t size, size_t n
         return 0;
     }
     if (!thisObject->m_bodyCallbackBegan) {
-        thisObject->m_bodyCallbackBegan = true;
-        thisObject->m_statusCodePromise.set_value(thisObject->m_lastStatusCode);
-        thisObject->m_contentTypePromise.set_value(thisObject->m_lastContentType);
+        thisObject->onResponse();
+    }
+    if (BodyMode::CACHED == thisObject->m_bodyMode) {
+        return thisObject->cacheBody(data, size * nmemb);
     }
     auto streamWriter = thisObject->m_streamWriter;
-    size_t totalBytesWritten = 0;
-
-    if (streamWriter) {
-        size_t targetNumBytes = size * nmemb;
-
-        while (totalBytesWritten < targetNumBytes && !thisObject->m_done) {
-            avsCommon::avs::attachment::AttachmentWriter::WriteStatus writeStatus =
-                avsCommon::avs::attachment::AttachmentWriter::WriteStatus::OK;
-
-            size_t numBytesWritten = streamWriter->write(
-                data,
-                targetNumBytes - totalBytesWritten,
-                &writeStatus,
-                std::chrono::milliseconds(TIMEOUT_FOR_BLOCKING_WRITE));
-            totalBytesWritten += numBytesWritten;
-            data += numBytesWritten;
-
-            switch (writeStatus) {
-                case avsCommon::avs::attachment::AttachmentWriter::WriteStatus::CLOSED:
-                case avsCommon::avs::attachment::AttachmentWriter::WriteStatus::ERROR_BYTES_LESS_THAN_WORD_SIZE:
-                case avsCommon::avs::attachment::AttachmentWriter::WriteStatus::ERROR_INTERNAL:
-                    return totalBytesWritten;
-                case avsCommon::avs::attachment::AttachmentWriter::WriteStatus::TIMEDOUT:
-                case avsCommon::avs::attachment::AttachmentWriter::WriteStatus::OK:
-                    // might still have bytes to write
+    if (!streamWriter) {
+        return 0;
+    }
+
+    /*
+     * A paused transfer is given its data again when it resumes, starting with whatever part of it was written before
+     * pausing, so skip that part.
+     */
+    size_t targetNumBytes = size * nmemb;
+    size_t totalBytesWritten = std::min(thisObject->m_bytesToSkip, targetNumBytes);
+    thisObject->m_bytesToSkip -= totalBytesWritten;
+
+    while (totalBytesWritten < targetNumBytes) {
+        avsCommon::avs::attachment::AttachmentWriter::WriteStatus writeStatus =
+            avsCommon::avs::attachment::AttachmentWriter::WriteStatus::OK;
+
+        size_t numBytesWritten = streamWriter->write(
+            data + totalBytesWritten,
+            targetNumBytes - totalBytesWritten,
+            &writeStatus,
+            thisObject->m_canWaitForSpace ? TIMEOUT_FOR_WRITE : TIMEOUT_FOR_BLOCKING_WRITE);
+        totalBytesWritten += numBytesWritten;
+
+        switch (writeStatus) {
+            case avsCommon::avs::attachment::AttachmentWriter::WriteStatus::CLOSED:
+            case avsCommon::avs::attachment::AttachmentWriter::WriteStatus::ERROR_BYTES_LESS_THAN_WORD_SIZE:
+            case avsCommon::avs::attachment::AttachmentWriter::WriteStatus::ERROR_INTERNAL:
+                // Returning less than was given ends the transfer.
+                return 0;
+            case avsCommon::avs::attachment::AttachmentWriter::WriteStatus::OK:
+                // might still have bytes to write
+                continue;
+            case avsCommon::avs::attachment::AttachmentWriter::WriteStatus::TIMEDOUT:
+            case avsCommon::avs::attachment::AttachmentWriter::WriteStatus::OK_BUFFER_FULL:
+                if (!thisObject->m_canWaitForSpace) {
+                    if (thisObject->m_isShuttingDown) {
+                        return 0;
+                    }
+                    if (avsCommon::avs::attachment::AttachmentWriter::WriteStatus::OK_BUFFER_FULL == writeStatus) {
+                        std::this_thread::sleep_for(BUFFER_FULL_RETRY_INTERVAL);
+                    }
                     continue;
-                case avsCommon::avs::attachment::AttachmentWriter::WriteStatus::OK_BUFFER_FULL:
-                    ACSDK_ERROR(LX(__func__).d("unexpected return code", "OK_BUFFER_FULL"));
-                    return 0;
-            }
-            ACSDK_ERROR(LX(__func__).m("unexpected writeStatus"));
-            return 0;
+                }
+                if (!thisObject->m_isWaitingForSpace.exchange(true)) {
+                    // From now on freed space resumes the transfer.  Try again in case some was freed before now.
+                    continue;
+                }
+                // No room for now, so wait for the reader to catch up without holding up other transfers.
+                thisObject->m_bytesToSkip = totalBytesWritten;
+                return CURL_WRITEFUNC_PAUSE;
         }
+        ACSDK_ERROR(LX(__func__).m("unexpected writeStatus"));
+        return 0;
     }
-    return totalBytesWritten;
+    return targetNumBytes;
 }
 
 size_t LibCurlHttpContentFetcher::noopCallback(char* data, size_t size, size_t nmemb, void* userData) {
     return 0;
 }
 
-LibCurlHttpContentFetcher::LibCurlHttpContentFetcher(const std::string& url) :
+LibCurlHttpContentFetcher::LibCurlHttpContentFetcher(
+    const std::string& url,
+    std::shared_ptr<HttpContentCache> cache) :
         m_url{url},
         m_bodyCallbackBegan{false},
         m_lastStatusCode{0},
-        m_done{false} {
+        m_writerWasCreatedLocally{false},
+        m_bytesToSkip{0},
+        m_fetchOption{FetchOptions::CONTENT_TYPE},
+        m_transferStarted{false},
+        m_done{false},
+        m_cache{cache},
+        m_rangeStart{0},
+        m_isRevalidating{false},
+        m_bodyMode{BodyMode::DIRECT},
+        m_transferFinished{false},
+        m_stopServing{false},
+        m_serveOffset{0},
+        m_canWaitForSpace{false},
+        m_isWaitingForSpace{false},
+        m_isShuttingDown{false} {
     m_hasObjectBeenUsed.clear();
 }
 
@@ -145,6 +255,11 @@ std::unique_ptr<avsCommon::utils::HTTPContent> LibCurlHttpContentFetcher::getCon
     if (m_hasObjectBeenUsed.test_and_set()) {
         return nullptr;
     }
+    m_engine = CurlFetchEngine::acquire();
+    if (!m_engine) {
+        ACSDK_ERROR(LX("getContentFailed").d("reason", "noFetchEngine"));
+        return nullptr;
+    }
     if (!m_curlWrapper.setURL(m_url)) {
         ACSDK_ERROR(LX("getContentFailed").d("reason", "failedToSetUrl"));
         return nullptr;
@@ -170,11 +285,18 @@ std::unique_ptr<avsCommon::utils::HTTPContent> LibCurlHttpContentFetcher::getCon
 
     std::shared_ptr<avsCommon::avs::attachment::InProcessAttachment> stream = nullptr;
 
-    // This flag will remain false if the caller of getContent() passed in their own writer.
-    bool writerWasCreatedLocally = false;
-
     switch (fetchOption) {
-        case FetchOptions::CONTENT_TYPE:
+        case FetchOptions::CONTENT_TYPE: {
+            HttpContentCache::Metadata metadata;
+            if (m_cache && m_cache->lookup(m_url, &metadata) && metadata.isFresh(std::chrono::system_clock::now()) &&
+                !metadata.contentType.empty()) {
+                // The cached response is current, so there is no need to ask the server.
+                m_statusCodePromise.set_value(HTTPResponseCode::SUCCESS_OK);
+                m_contentTypePromise.set_value(metadata.contentType);
+                return avsCommon::utils::memory::make_unique<avsCommon::utils::HTTPContent>(
+                    avsCommon::utils::HTTPContent{
+                        std::move(httpStatusCodeFuture), std::move(contentTypeFuture), nullptr});
+            }
             /*
              * Since this option only wants the content-type, I set a noop callback for parsing the body of the HTTP
              * response. For some webpages, it is required to set a body callback in order for the full webpage data
@@ -185,37 +307,14 @@ std::unique_ptr<avsCommon::utils::HTTPContent> LibCurlHttpContentFetcher::getCon
                 ACSDK_ERROR(LX("getContentFailed").d("reason", "failedToSetCurlCallback"));
                 return nullptr;
             }
-            m_thread = std::thread([this]() {
-                long finalResponseCode = 0;
-                char* contentType = nullptr;
-                auto curlReturnValue = curl_easy_perform(m_curlWrapper.getCurlHandle());
-                if (curlReturnValue != CURLE_OK && curlReturnValue != CURLE_WRITE_ERROR) {
-                    ACSDK_ERROR(LX("curlEasyPerformFailed").d("error", curl_easy_strerror(curlReturnValue)));
-                }
-                curlReturnValue =
-                    curl_easy_getinfo(m_curlWrapper.getCurlHandle(), CURLINFO_RESPONSE_CODE, &finalResponseCode);
-                if (curlReturnValue != CURLE_OK) {
-                    ACSDK_ERROR(LX("curlEasyGetInfoFailed").d("error", curl_easy_strerror(curlReturnValue)));
-                }
-                ACSDK_DEBUG9(LX("getContent").d("responseCode", finalResponseCode).sensitive("url", m_url));
-                m_statusCodePromise.set_value(finalResponseCode);
-                curlReturnValue = curl_easy_getinfo(m_curlWrapper.getCurlHandle(), CURLINFO_CONTENT_TYPE, &contentType);
-                if (curlReturnValue == CURLE_OK && contentType) {
-                    ACSDK_DEBUG9(LX("getContent").d("contentType", contentType).sensitive("url", m_url));
-                    m_contentTypePromise.set_value(std::string(contentType));
-                } else {
-                    ACSDK_ERROR(LX("curlEasyGetInfoFailed").d("error", curl_easy_strerror(curlReturnValue)));
-                    ACSDK_ERROR(LX("getContent").d("contentType", "failedToGetContentType").sensitive("url", m_url));
-                    m_contentTypePromise.set_value("");
-                }
-            });
             break;
+        }
         case FetchOptions::ENTIRE_BODY:
             if (!writer) {
                 // Using the url as the identifier for the attachment
                 stream = std::make_shared<avsCommon::avs::attachment::InProcessAttachment>(m_url);
                 writer = stream->createWriter(sds::WriterPolicy::BLOCKING);
-                writerWasCreatedLocally = true;
+                m_writerWasCreatedLocally = true;
             }
 
             m_streamWriter = writer;
@@ -224,6 +323,7 @@ std::unique_ptr<avsCommon::utils::HTTPContent> LibCurlHttpContentFetcher::getCon
                 ACSDK_ERROR(LX("getContentFailed").d("reason", "failedToCreateWriter"));
                 return nullptr;
             }
+            m_canWaitForSpace = m_streamWriter->setSpaceAvailableCallback([this] { onSpaceAvailable(); });
             if (!m_curlWrapper.setWriteCallback(bodyCallback, this)) {
                 ACSDK_ERROR(LX("getContentFailed").d("reason", "failedToSetCurlBodyCallback"));
                 return nullptr;
@@ -232,41 +332,341 @@ std::unique_ptr<avsCommon::utils::HTTPContent> LibCurlHttpContentFetcher::getCon
                 ACSDK_ERROR(LX("getContentFailed").d("reason", "failedToSetCurlHeaderCallback"));
                 return nullptr;
             }
-            m_thread = std::thread([this, writerWasCreatedLocally]() {
-                auto curlReturnValue = curl_easy_perform(m_curlWrapper.getCurlHandle());
-                if (curlReturnValue != CURLE_OK) {
-                    ACSDK_ERROR(LX("curlEasyPerformFailed").d("error", curl_easy_strerror(curlReturnValue)));
-                }
-                if (!m_bodyCallbackBegan) {
-                    m_statusCodePromise.set_value(m_lastStatusCode);
-                    m_contentTypePromise.set_value(m_lastContentType);
+            if (m_cache) {
+                // If another fetch of the same URL is using the entry, this one goes to the network.
+                m_cacheEntry = m_cache->acquire(m_url);
+                if (m_cacheEntry) {
+                    m_serveBuffer.resize(CACHE_READ_SIZE);
                 }
-                /*
-                 * If the writer was created locally, its job is done and can be safely closed.
-                 */
-                if (writerWasCreatedLocally) {
-                    m_streamWriter->close();
-                }
-
-                /*
-                 * Note: If the writer was not created locally, its owner must ensure that it closes when necessary.
-                 * In the case of a livestream, if the writer is not closed the LibCurlHttpContentFetcher
-                 * will continue to download data indefinitely.
-                 */
-
-                m_done = true;
-            });
+            }
             break;
         default:
             return nullptr;
     }
+    m_fetchOption = fetchOption;
+    if (m_cacheEntry) {
+        if (!startCachedFetch()) {
+            return nullptr;
+        }
+    } else {
+        m_transferStarted = m_engine->addTransfer(
+            m_curlWrapper.getCurlHandle(), [this](CURLcode curlReturnValue) { onTransferComplete(curlReturnValue); });
+        if (!m_transferStarted) {
+            ACSDK_ERROR(LX("getContentFailed").d("reason", "addTransferFailed"));
+            return nullptr;
+        }
+    }
     return avsCommon::utils::memory::make_unique<avsCommon::utils::HTTPContent>(
         avsCommon::utils::HTTPContent{std::move(httpStatusCodeFuture), std::move(contentTypeFuture), stream});
 }
 
+void LibCurlHttpContentFetcher::onTransferComplete(CURLcode curlReturnValue) {
+    switch (m_fetchOption) {
+        case FetchOptions::CONTENT_TYPE: {
+            // The no-op body callback ends the transfer as soon as the headers are in, which is reported as an error.
+            if (curlReturnValue != CURLE_OK && curlReturnValue != CURLE_WRITE_ERROR) {
+                ACSDK_ERROR(LX("curlTransferFailed").d("error", curl_easy_strerror(curlReturnValue)));
+            }
+            long finalResponseCode = 0;
+            char* contentType = nullptr;
+            auto result = curl_easy_getinfo(m_curlWrapper.getCurlHandle(), CURLINFO_RESPONSE_CODE, &finalResponseCode);
+            if (result != CURLE_OK) {
+                ACSDK_ERROR(LX("curlEasyGetInfoFailed").d("error", curl_easy_strerror(result)));
+            }
+            ACSDK_DEBUG9(LX("getContent").d("responseCode", finalResponseCode).sensitive("url", m_url));
+            m_statusCodePromise.set_value(finalResponseCode);
+            result = curl_easy_getinfo(m_curlWrapper.getCurlHandle(), CURLINFO_CONTENT_TYPE, &contentType);
+            if (result == CURLE_OK && contentType) {
+                ACSDK_DEBUG9(LX("getContent").d("contentType", contentType).sensitive("url", m_url));
+                m_contentTypePromise.set_value(std::string(contentType));
+            } else {
+                ACSDK_ERROR(LX("curlEasyGetInfoFailed").d("error", curl_easy_strerror(result)));
+                ACSDK_ERROR(LX("getContent").d("contentType", "failedToGetContentType").sensitive("url", m_url));
+                m_contentTypePromise.set_value("");
+            }
+            break;
+        }
+        case FetchOptions::ENTIRE_BODY:
+            if (curlReturnValue != CURLE_OK) {
+                ACSDK_ERROR(LX("curlTransferFailed").d("error", curl_easy_strerror(curlReturnValue)));
+            }
+            if (!m_bodyCallbackBegan) {
+                onResponse();
+            }
+            if (BodyMode::CACHED == m_bodyMode) {
+                // Pass on the rest of the cached body.  The fetch is done once it has all been passed on.
+                m_transferFinished = true;
+                serveFromCache();
+                return;
+            }
+            /*
+             * If the writer was created locally, its job is done and can be safely closed.
+             *
+             * Note: If the writer was not created locally, its owner must ensure that it closes when necessary.
+             * In the case of a livestream, if the writer is not closed the LibCurlHttpContentFetcher
+             * will continue to download data until it is destroyed.
+             */
+            if (m_writerWasCreatedLocally) {
+                m_streamWriter->close();
+            }
+            break;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_doneMutex);
+        m_done = true;
+    }
+    m_doneTrigger.notify_all();
+}
+
+void LibCurlHttpContentFetcher::onSpaceAvailable() {
+    if (!m_isWaitingForSpace.exchange(false)) {
+        return;
+    }
+    auto handle = m_curlWrapper.getCurlHandle();
+    m_engine->submit(handle, [this, handle] {
+        if (BodyMode::CACHED == m_bodyMode) {
+            serveFromCache();
+        } else {
+            curl_easy_pause(handle, CURLPAUSE_CONT);
+        }
+    });
+}
+
+bool LibCurlHttpContentFetcher::startCachedFetch() {
+    auto metadata = m_cacheEntry->getMetadata();
+    auto now = std::chrono::system_clock::now();
+    if (metadata.isComplete() && metadata.isFresh(now)) {
+        ACSDK_DEBUG5(LX("servingFromCache").sensitive("url", m_url));
+        m_bodyCallbackBegan = true;
+        m_bodyMode = BodyMode::CACHED;
+        m_transferFinished = true;
+        m_statusCodePromise.set_value(HTTPResponseCode::SUCCESS_OK);
+        m_contentTypePromise.set_value(metadata.contentType);
+        // There is no transfer, but the body is still passed on from the engine thread.
+        if (!m_engine->submit(m_curlWrapper.getCurlHandle(), [this] { serveFromCache(); })) {
+            ACSDK_ERROR(LX("startCachedFetchFailed").d("reason", "submitFailed"));
+            return false;
+        }
+        return true;
+    }
+
+    bool ok = true;
+    if (metadata.cachedLength > 0 && (metadata.isFresh(now) || metadata.hasValidator())) {
+        if (metadata.isComplete()) {
+            // Ask whether the cached body is still current, and only get it again if not.
+            m_isRevalidating = true;
+            if (!metadata.etag.empty()) {
+                ok = ok && m_curlWrapper.addHTTPHeader("If-None-Match: " + metadata.etag);
+            }
+            if (!metadata.lastModified.empty()) {
+                ok = ok && m_curlWrapper.addHTTPHeader("If-Modified-Since: " + metadata.lastModified);
+            }
+        } else {
+            // Ask for the rest of the body, or for all of it if the cached part is no longer current.
+            m_rangeStart = metadata.cachedLength;
+            ok = m_curlWrapper.addHTTPHeader("Range: bytes=" + std::to_string(m_rangeStart) + "-");
+            if (!metadata.etag.empty() && metadata.etag.compare(0, WEAK_ETAG_PREFIX.size(), WEAK_ETAG_PREFIX) != 0) {
+                ok = ok && m_curlWrapper.addHTTPHeader("If-Range: " + metadata.etag);
+            } else if (!metadata.lastModified.empty()) {
+                ok = ok && m_curlWrapper.addHTTPHeader("If-Range: " + metadata.lastModified);
+            }
+        }
+        ACSDK_DEBUG5(LX("resumingFromCache")
+                         .d("cachedLength", metadata.cachedLength)
+                         .d("revalidating", m_isRevalidating)
+                         .sensitive("url", m_url));
+    }
+    if (!ok) {
+        ACSDK_ERROR(LX("startCachedFetchFailed").d("reason", "failedToAddHeader"));
+        return false;
+    }
+
+    m_bodyMode = BodyMode::PENDING;
+    m_transferStarted = m_engine->addTransfer(
+        m_curlWrapper.getCurlHandle(), [this](CURLcode curlReturnValue) { onTransferComplete(curlReturnValue); });
+    if (!m_transferStarted) {
+        ACSDK_ERROR(LX("startCachedFetchFailed").d("reason", "addTransferFailed"));
+        return false;
+    }
+    return true;
+}
+
+void LibCurlHttpContentFetcher::onResponse() {
+    m_bodyCallbackBegan = true;
+    long statusCode = m_lastStatusCode;
+    std::string contentType = m_lastContentType;
+    BodyMode bodyMode = BodyMode::DIRECT;
+
+    if (m_cacheEntry) {
+        const auto& cached = m_cacheEntry->getMetadata();
+        HttpContentCache::Metadata metadata;
+        metadata.contentType = m_lastContentType;
+        metadata.etag = m_cacheHeaders.etag;
+        metadata.lastModified = m_cacheHeaders.lastModified;
+        metadata.expiry = HttpContentCache::computeExpiry(
+            m_cacheHeaders.cacheControl,
+            m_cacheHeaders.expires,
+            m_cacheHeaders.lastModified,
+            std::chrono::system_clock::now());
+        bool isStorable = HttpContentCache::isStorable(m_cacheHeaders.cacheControl);
+
+        if (HTTPResponseCode::NOT_MODIFIED == statusCode && m_isRevalidating) {
+            // A 304 response need not repeat the headers of the response it confirms, so keep those it leaves out.
+            contentType = cached.contentType;
+            metadata.contentType = cached.contentType;
+            if (metadata.etag.empty()) {
+                metadata.etag = cached.etag;
+            }
+            if (metadata.lastModified.empty()) {
+                metadata.lastModified = cached.lastModified;
+            }
+            metadata.contentLength = cached.contentLength;
+            m_cacheEntry->updateMetadata(metadata);
+            bodyMode = BodyMode::CACHED;
+            statusCode = HTTPResponseCode::SUCCESS_OK;
+        } else if (
+            HTTPResponseCode::SUCCESS_PARTIAL_CONTENT == statusCode && m_rangeStart > 0 &&
+            m_cacheHeaders.hasContentRange && m_rangeStart == m_cacheHeaders.rangeStart) {
+            // The cached part is current and the rest follows it.
+            if (m_cacheHeaders.rangeTotal > 0) {
+                metadata.contentLength = m_cacheHeaders.rangeTotal;
+            } else if (m_cacheHeaders.hasContentLength) {
+                metadata.contentLength = m_rangeStart + m_cacheHeaders.contentLength;
+            }
+            m_cacheEntry->updateMetadata(metadata);
+            bodyMode = BodyMode::CACHED;
+            statusCode = HTTPResponseCode::SUCCESS_OK;
+        } else if (
+            HTTPResponseCode::SUCCESS_OK == statusCode && isStorable && m_cacheHeaders.hasContentLength &&
+            m_cacheHeaders.contentLength > 0 && m_cacheHeaders.contentLength <= m_cache->getMaxEntrySize()) {
+            metadata.contentLength = m_cacheHeaders.contentLength;
+            if (m_cacheEntry->reset(metadata)) {
+                bodyMode = BodyMode::CACHED;
+            }
+        }
+
+        if (BodyMode::CACHED == bodyMode && !isStorable) {
+            m_cacheEntry->discard();
+        } else if (BodyMode::DIRECT == bodyMode && HTTPResponseCode::SUCCESS_OK == statusCode) {
+            // The body replaces whatever was cached, but cannot be cached itself.
+            m_cacheEntry->discard();
+        }
+        ACSDK_DEBUG9(LX("onResponse")
+                         .d("statusCode", m_lastStatusCode)
+                         .d("cached", BodyMode::CACHED == bodyMode)
+                         .sensitive("url", m_url));
+    }
+
+    m_statusCodePromise.set_value(statusCode);
+    m_contentTypePromise.set_value(contentType);
+    if (BodyMode::PENDING == m_bodyMode) {
+        m_bodyMode = bodyMode;
+        if (BodyMode::CACHED == m_bodyMode) {
+            // Pass on whatever part of the body was already cached.
+            serveFromCache();
+        }
+    }
+}
+
+size_t LibCurlHttpContentFetcher::cacheBody(const char* data, size_t size) {
+    if (m_stopServing) {
+        // Nobody is reading the body any more.
+        return 0;
+    }
+    if (!m_cacheEntry->append(data, size)) {
+        ACSDK_ERROR(LX("cacheBodyFailed").d("reason", "appendFailed"));
+        return 0;
+    }
+    serveFromCache();
+    return size;
+}
+
+void LibCurlHttpContentFetcher::serveFromCache() {
+    if (m_done) {
+        return;
+    }
+    while (!m_stopServing && !m_isShuttingDown) {
+        auto cachedLength = m_cacheEntry->getCachedLength();
+        if (m_serveOffset >= cachedLength) {
+            if (!m_transferFinished) {
+                // Wait for cacheBody() or onTransferComplete() to call again.
+                return;
+            }
+            break;
+        }
+        size_t size = static_cast<size_t>(std::min<uint64_t>(m_serveBuffer.size(), cachedLength - m_serveOffset));
+        if (!m_cacheEntry->read(m_serveOffset, m_serveBuffer.data(), size)) {
+            ACSDK_ERROR(LX("serveFromCacheFailed").d("reason", "readFailed"));
+            m_stopServing = true;
+            break;
+        }
+        auto writeStatus = avsCommon::avs::attachment::AttachmentWriter::WriteStatus::OK;
+        m_serveOffset += m_streamWriter->write(
+            m_serveBuffer.data(),
+            size,
+            &writeStatus,
+            m_canWaitForSpace ? TIMEOUT_FOR_WRITE : TIMEOUT_FOR_BLOCKING_WRITE);
+        switch (writeStatus) {
+            case avsCommon::avs::attachment::AttachmentWriter::WriteStatus::CLOSED:
+            case avsCommon::avs::attachment::AttachmentWriter::WriteStatus::ERROR_BYTES_LESS_THAN_WORD_SIZE:
+            case avsCommon::avs::attachment::AttachmentWriter::WriteStatus::ERROR_INTERNAL:
+                // Stop the transfer too, since there is nobody to pass its body on to.
+                m_stopServing = true;
+                continue;
+            case avsCommon::avs::attachment::AttachmentWriter::WriteStatus::OK:
+                continue;
+            case avsCommon::avs::attachment::AttachmentWriter::WriteStatus::TIMEDOUT:
+            case avsCommon::avs::attachment::AttachmentWriter::WriteStatus::OK_BUFFER_FULL:
+                if (!m_canWaitForSpace) {
+                    if (avsCommon::avs::attachment::AttachmentWriter::WriteStatus::OK_BUFFER_FULL == writeStatus) {
+                        std::this_thread::sleep_for(BUFFER_FULL_RETRY_INTERVAL);
+                    }
+                    continue;
+                }
+                if (!m_isWaitingForSpace.exchange(true)) {
+                    // From now on freed space calls this again.  Try again in case some was freed before now.
+                    continue;
+                }
+                return;
+        }
+        ACSDK_ERROR(LX("serveFromCacheFailed").d("reason", "unexpectedWriteStatus"));
+        m_stopServing = true;
+    }
+    if (m_writerWasCreatedLocally) {
+        m_streamWriter->close();
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_doneMutex);
+        m_done = true;
+    }
+    m_doneTrigger.notify_all();
+}
+
 LibCurlHttpContentFetcher::~LibCurlHttpContentFetcher() {
-    if (m_thread.joinable()) {
-        m_thread.join();
+    /*
+     * The body is going into the caller's writer, which may outlive this object, so let the transfer, and the serving
+     * of any cached part of the body, finish as they did when a thread of our own performed them.  The owner of the
+     * writer closes it to end them early.
+     */
+    bool finishBody = FetchOptions::ENTIRE_BODY == m_fetchOption && !m_writerWasCreatedLocally;
+    if (finishBody && (m_transferStarted || BodyMode::CACHED == m_bodyMode)) {
+        std::unique_lock<std::mutex> lock(m_doneMutex);
+        m_doneTrigger.wait(lock, [this]() { return m_done.load(); });
+    }
+    m_isShuttingDown = true;
+    if (m_streamWriter) {
+        m_streamWriter->setSpaceAvailableCallback(nullptr);
+    }
+    if (m_engine) {
+        // Once the transfer is removed from the engine, no more callbacks or submitted functions are called for it.
+        m_engine->removeTransfer(m_curlWrapper.getCurlHandle());
+    }
+    if (!m_done) {
+        if (m_transferStarted) {
+            onTransferComplete(CURLE_ABORTED_BY_CALLBACK);
+        } else if (BodyMode::CACHED == m_bodyMode) {
+            serveFromCache();
+        }
     }
 }
 
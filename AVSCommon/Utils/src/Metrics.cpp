@@ -34,6 +34,8 @@ const std::string Metrics::locationToString(Metrics::Location location) {
             return "AIP Receive";
         case AIP_SEND:
             return "AIP Send";
+        case ACL_ATTACHMENT_FIRST_BYTE:
+            return "ACL Attachment First Byte";
         case BUILDING_MESSAGE:
             return "Building Message";
     }
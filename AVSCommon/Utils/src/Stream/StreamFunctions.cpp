@@ -25,7 +25,7 @@ namespace avsCommon {
 namespace utils {
 namespace stream {
 
-std::unique_ptr<std::istream> streamFromData(const unsigned char* data, size_t length) {
+std::unique_ptr<std::istream> streamFromData(const unsigned char* data, size_t length, const std::string& resourceId) {
     /**
      * This is an std::istream that holds onto the std::streambuf object.  The streambuf cannot be deleted until the
      * istream is destroyed.
@@ -39,7 +39,8 @@ std::unique_ptr<std::istream> streamFromData(const unsigned char* data, size_t l
         std::unique_ptr<Streambuf> m_buf;
     };
 
-    return std::unique_ptr<ResourceStream>(new ResourceStream(std::unique_ptr<Streambuf>(new Streambuf(data, length))));
+    return std::unique_ptr<ResourceStream>(
+        new ResourceStream(std::unique_ptr<Streambuf>(new Streambuf(data, length, resourceId))));
 }
 
 }  // namespace stream
@@ -22,13 +22,18 @@ namespace stream {
 
 // There are two casts, as a streambuf uses Type=char.  This requires removing the const and removing the unsigned.
 // setg only is for reading, so this operation is safe, although ugly.
-Streambuf::Streambuf(const unsigned char* data, size_t length) :
+Streambuf::Streambuf(const unsigned char* data, size_t length, const std::string& resourceId) :
         m_begin(reinterpret_cast<char*>(const_cast<unsigned char*>(data))),
         m_current(m_begin),
-        m_end(m_begin + length) {
+        m_end(m_begin + length),
+        m_resourceId(resourceId) {
     setg(m_begin, m_current, m_end);
 }
 
+const std::string& Streambuf::getResourceId() const {
+    return m_resourceId;
+}
+
 std::streampos Streambuf::seekoff(std::streamoff off, std::ios_base::seekdir way, std::ios_base::openmode which) {
     switch (way) {
         case std::ios_base::beg:
@@ -0,0 +1,197 @@
+/*
+ * Copyright 2017-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_TEST_AVSCOMMON_UTILS_LIBCURLUTILS_LOCALHTTPSERVER_H_
+#define ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_TEST_AVSCOMMON_UTILS_LIBCURLUTILS_LOCALHTTPSERVER_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace libcurlUtils {
+namespace test {
+
+/**
+ * A minimal HTTP/1.0 server on the loopback interface which serves bodies registered with @c addBody.  libcurl cannot
+ * pause file:// transfers, and file:// has no latency to hide, so tests which need either use this instead.  Each
+ * connection is answered on its own thread, so a delay set with @c setResponseDelay applies to every request at once
+ * rather than adding up.  Open-ended range requests (@c "Range: bytes=N-") are answered with the rest of the body, and
+ * @c If-Range and @c If-None-Match are checked against the @c ETag set with @c setCacheHeaders.
+ */
+class LocalHttpServer {
+public:
+    /// Constructor.
+    LocalHttpServer();
+
+    /// Destructor.
+    ~LocalHttpServer();
+
+    /**
+     * Start listening.
+     *
+     * @return Whether the server started.
+     */
+    bool start();
+
+    /**
+     * Register a body to serve.
+     *
+     * @param path The path to serve it at.
+     * @param body The body.
+     * @param contentType The Content-Type header to send with it.
+     * @param delay How long to hold back responses with this body, in addition to the delay set with
+     * @c setResponseDelay.
+     * @return The URL of the body.
+     */
+    std::string addBody(
+        const std::string& path,
+        const std::string& body,
+        const std::string& contentType = "application/octet-stream",
+        std::chrono::milliseconds delay = std::chrono::milliseconds::zero());
+
+    /**
+     * Set the caching headers sent with a body registered with @c addBody.
+     *
+     * @param path The path of the body.
+     * @param cacheControl The value of the Cache-Control header, or empty to send none.
+     * @param etag The value of the ETag header, or empty to send none.
+     */
+    void setCacheHeaders(const std::string& path, const std::string& cacheControl, const std::string& etag);
+
+    /**
+     * Make every response stop after at most this many bytes of body, to simulate a dropped connection.
+     *
+     * @param maxBodyBytes The most bytes of body to send.
+     */
+    void setMaxBodyBytes(size_t maxBodyBytes);
+
+    /**
+     * Set how long each response is held back after its request has been read, to simulate a high round trip time.
+     *
+     * @param delay The delay.
+     */
+    void setResponseDelay(std::chrono::milliseconds delay);
+
+    /**
+     * Get the number of requests answered so far.
+     *
+     * @return The number of requests.
+     */
+    size_t getRequestCount();
+
+    /**
+     * Get the number of bytes of body sent so far.
+     *
+     * @return The number of bytes.
+     */
+    size_t getBodyBytesSent();
+
+    /**
+     * Get the request line and headers of the last request.
+     *
+     * @return The last request.
+     */
+    std::string getLastRequest();
+
+private:
+    /// Accept connections until the listening socket is closed, handling each on its own thread.
+    void serve();
+
+    /**
+     * Answer one request.
+     *
+     * @param connection The connected socket.
+     */
+    void handle(int connection);
+
+    /// A body served, with its content type.
+    struct Body {
+        /// The body.
+        std::string data;
+
+        /// The Content-Type header sent with it.
+        std::string contentType;
+
+        /// The delay before responses with it, in addition to @c m_responseDelay.
+        std::chrono::milliseconds delay;
+
+        /// The Cache-Control header sent with it, or empty if none is sent.
+        std::string cacheControl;
+
+        /// The ETag header sent with it, or empty if none is sent.
+        std::string etag;
+    };
+
+    /**
+     * Build the response to a request for a body.
+     *
+     * @param request The request line and headers.
+     * @param body The body.
+     * @param [out] bodySize The number of bytes of body in the response.
+     * @return The response.
+     */
+    std::string buildResponse(const std::string& request, const Body& body, size_t* bodySize);
+
+    /// The listening socket.
+    int m_socket;
+
+    /// The port listened on.
+    uint16_t m_port;
+
+    /// Serializes access to the members below.
+    std::mutex m_mutex;
+
+    /// The bodies served, by path.
+    std::map<std::string, Body> m_bodies;
+
+    /// The delay before each response.
+    std::chrono::milliseconds m_responseDelay;
+
+    /// The number of requests answered.
+    size_t m_requestCount;
+
+    /// The most bytes of body to send in a response.
+    size_t m_maxBodyBytes;
+
+    /// The number of bytes of body sent.
+    size_t m_bodyBytesSent;
+
+    /// The request line and headers of the last request.
+    std::string m_lastRequest;
+
+    /// Whether the server is stopping, in which case delayed responses are sent at once.
+    bool m_stopping;
+
+    /// Used to end the delays of responses when the server stops.
+    std::condition_variable m_stopTrigger;
+
+    /// The thread accepting connections.
+    std::thread m_thread;
+};
+
+}  // namespace test
+}  // namespace libcurlUtils
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AVSCOMMON_UTILS_TEST_AVSCOMMON_UTILS_LIBCURLUTILS_LOCALHTTPSERVER_H_
@@ -96,8 +96,10 @@ public:
     MOCK_METHOD1(play, bool(SourceId));
     MOCK_METHOD1(pause, bool(SourceId));
     MOCK_METHOD1(resume, bool(SourceId));
+    MOCK_METHOD1(preroll, bool(SourceId));
     MOCK_METHOD1(stop, bool(SourceId));
     MOCK_METHOD1(getOffset, std::chrono::milliseconds(SourceId));
+    MOCK_METHOD1(getDuration, std::chrono::milliseconds(SourceId));
     MOCK_METHOD0(getNumBytesBuffered, uint64_t());
 
     /// @name RequiresShutdown overrides
@@ -0,0 +1,235 @@
+/*
+ * Copyright 2017-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "AVSCommon/Utils/LibcurlUtils/LocalHttpServer.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace libcurlUtils {
+namespace test {
+
+/// The number of connections which may wait to be accepted.
+static const int LISTEN_BACKLOG = 32;
+
+/**
+ * Get the value of a request header.
+ *
+ * @param request The request line and headers.
+ * @param name The name of the header, as sent by libcurl.
+ * @param [out] value The value of the header.
+ * @return Whether the request has the header.
+ */
+static bool getRequestHeader(const std::string& request, const std::string& name, std::string* value) {
+    auto start = request.find("\r\n" + name + ": ");
+    if (start == std::string::npos) {
+        return false;
+    }
+    start += name.size() + 4;
+    *value = request.substr(start, request.find("\r\n", start) - start);
+    return true;
+}
+
+LocalHttpServer::LocalHttpServer() :
+        m_socket{-1},
+        m_port{0},
+        m_responseDelay{std::chrono::milliseconds::zero()},
+        m_requestCount{0},
+        m_maxBodyBytes{std::numeric_limits<size_t>::max()},
+        m_bodyBytesSent{0},
+        m_stopping{false} {
+}
+
+LocalHttpServer::~LocalHttpServer() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_stopTrigger.notify_all();
+    if (m_socket != -1) {
+        shutdown(m_socket, SHUT_RDWR);
+        close(m_socket);
+    }
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+bool LocalHttpServer::start() {
+    m_socket = socket(AF_INET, SOCK_STREAM, 0);
+    if (m_socket == -1) {
+        return false;
+    }
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t length = sizeof(address);
+    if (bind(m_socket, reinterpret_cast<sockaddr*>(&address), length) != 0 || listen(m_socket, LISTEN_BACKLOG) != 0 ||
+        getsockname(m_socket, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+        return false;
+    }
+    m_port = ntohs(address.sin_port);
+    m_thread = std::thread(&LocalHttpServer::serve, this);
+    return true;
+}
+
+std::string LocalHttpServer::addBody(
+    const std::string& path,
+    const std::string& body,
+    const std::string& contentType,
+    std::chrono::milliseconds delay) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_bodies[path] = {body, contentType, delay, "", ""};
+    return "http://127.0.0.1:" + std::to_string(m_port) + path;
+}
+
+void LocalHttpServer::setCacheHeaders(
+    const std::string& path,
+    const std::string& cacheControl,
+    const std::string& etag) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_bodies[path].cacheControl = cacheControl;
+    m_bodies[path].etag = etag;
+}
+
+void LocalHttpServer::setMaxBodyBytes(size_t maxBodyBytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_maxBodyBytes = maxBodyBytes;
+}
+
+void LocalHttpServer::setResponseDelay(std::chrono::milliseconds delay) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_responseDelay = delay;
+}
+
+size_t LocalHttpServer::getRequestCount() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_requestCount;
+}
+
+size_t LocalHttpServer::getBodyBytesSent() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_bodyBytesSent;
+}
+
+std::string LocalHttpServer::getLastRequest() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_lastRequest;
+}
+
+std::string LocalHttpServer::buildResponse(const std::string& request, const Body& body, size_t* bodySize) {
+    std::string headers = "Content-Type: " + body.contentType + "\r\n";
+    if (!body.cacheControl.empty()) {
+        headers += "Cache-Control: " + body.cacheControl + "\r\n";
+    }
+    if (!body.etag.empty()) {
+        headers += "ETag: " + body.etag + "\r\n";
+    }
+    std::string value;
+    if (!body.etag.empty() && getRequestHeader(request, "If-None-Match", &value) && value == body.etag) {
+        *bodySize = 0;
+        return "HTTP/1.0 304 Not Modified\r\n" + headers + "\r\n";
+    }
+    size_t offset = 0;
+    std::string range;
+    std::string ifRange;
+    bool isRange = getRequestHeader(request, "Range", &range) && range.compare(0, 6, "bytes=") == 0 &&
+                   range.back() == '-' && !(getRequestHeader(request, "If-Range", &ifRange) && ifRange != body.etag);
+    if (isRange) {
+        offset = std::strtoul(range.c_str() + 6, nullptr, 10);
+        if (offset >= body.data.size()) {
+            *bodySize = 0;
+            return "HTTP/1.0 416 Range Not Satisfiable\r\nContent-Length: 0\r\n\r\n";
+        }
+    }
+    auto data = body.data.substr(offset);
+    *bodySize = std::min(data.size(), m_maxBodyBytes);
+    std::string statusLine = "HTTP/1.0 200 OK\r\n";
+    if (isRange) {
+        statusLine = "HTTP/1.0 206 Partial Content\r\n";
+        headers += "Content-Range: bytes " + std::to_string(offset) + "-" + std::to_string(body.data.size() - 1) +
+                   "/" + std::to_string(body.data.size()) + "\r\n";
+    }
+    return statusLine + headers + "Content-Length: " + std::to_string(data.size()) + "\r\n\r\n" +
+           data.substr(0, *bodySize);
+}
+
+void LocalHttpServer::serve() {
+    std::vector<std::thread> handlers;
+    int connection;
+    while ((connection = accept(m_socket, nullptr, nullptr)) != -1) {
+        handlers.emplace_back(&LocalHttpServer::handle, this, connection);
+    }
+    for (auto& handler : handlers) {
+        handler.join();
+    }
+}
+
+void LocalHttpServer::handle(int connection) {
+    std::string request;
+    char buffer[1024];
+    while (request.find("\r\n\r\n") == std::string::npos) {
+        auto received = recv(connection, buffer, sizeof(buffer), 0);
+        if (received <= 0) {
+            close(connection);
+            return;
+        }
+        request.append(buffer, received);
+    }
+    auto pathStart = request.find(' ') + 1;
+    auto path = request.substr(pathStart, request.find(' ', pathStart) - pathStart);
+    std::string response;
+    std::chrono::milliseconds delay;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        ++m_requestCount;
+        m_lastRequest = request;
+        delay = m_responseDelay;
+        auto it = m_bodies.find(path);
+        if (it == m_bodies.end()) {
+            response = "HTTP/1.0 404 Not Found\r\nContent-Length: 0\r\n\r\n";
+        } else {
+            size_t bodySize = 0;
+            response = buildResponse(request, it->second, &bodySize);
+            m_bodyBytesSent += bodySize;
+            delay += it->second.delay;
+        }
+        m_stopTrigger.wait_for(lock, delay, [this]() { return m_stopping; });
+    }
+    size_t sent = 0;
+    while (sent < response.size()) {
+        auto result = send(connection, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+        if (result <= 0) {
+            break;
+        }
+        sent += result;
+    }
+    close(connection);
+}
+
+}  // namespace test
+}  // namespace libcurlUtils
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,296 @@
+/*
+ * Copyright 2017-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file CurlFetchEngineTest.cpp
+
+#include <functional>
+#include <future>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/Utils/LibcurlUtils/CurlEasyHandleWrapper.h"
+#include "AVSCommon/Utils/LibcurlUtils/CurlFetchEngine.h"
+#include "AVSCommon/Utils/LibcurlUtils/CurlShareHandleWrapper.h"
+#include "AVSCommon/Utils/LibcurlUtils/LibCurlHttpContentFetcher.h"
+#include "AVSCommon/Utils/LibcurlUtils/LocalHttpServer.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace libcurlUtils {
+namespace test {
+
+/// Used to limit the amount of time tests will wait for a transfer.  This is only hit if a test is failing.
+static const auto TIMEOUT = std::chrono::seconds(5);
+
+/// Time to wait when checking that a transfer has not finished.
+static const auto SHORT_TIMEOUT = std::chrono::milliseconds(200);
+
+/// The number of transfers run at once.
+static const size_t NUM_TRANSFERS = 8;
+
+/// The size of each test body.
+static const size_t BODY_SIZE = 100000;
+
+/// A transfer from the test server, collecting what it receives.
+struct Transfer {
+    /// The handle doing the transfer.
+    CurlEasyHandleWrapper curl;
+
+    /// The data received.
+    std::string received;
+
+    /// The number of times the write callback should still pause the transfer.
+    int pausesLeft = 0;
+
+    /// Called on the engine thread each time the write callback pauses the transfer.
+    std::function<void()> onPause;
+
+    /// Set to the result of the transfer.
+    std::promise<CURLcode> result;
+
+    /// Write callback which pauses @c pausesLeft times before taking the data.
+    static size_t writeCallback(char* data, size_t size, size_t nmemb, void* userData) {
+        auto transfer = static_cast<Transfer*>(userData);
+        if (transfer->pausesLeft > 0) {
+            --transfer->pausesLeft;
+            if (transfer->onPause) {
+                transfer->onPause();
+            }
+            return CURL_WRITEFUNC_PAUSE;
+        }
+        transfer->received.append(data, size * nmemb);
+        return size * nmemb;
+    }
+};
+
+/// Test harness for the @c CurlFetchEngine class.
+class CurlFetchEngineTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        m_engine = CurlFetchEngine::create();
+        ASSERT_TRUE(m_engine);
+        ASSERT_TRUE(m_server.start());
+    }
+
+    /**
+     * Serve a body of test data.
+     *
+     * @param seed A value which makes the body differ from others.
+     * @param [out] content The content served.
+     * @param size The size of the body.
+     * @return The URL of the body.
+     */
+    std::string createBody(size_t seed, std::string* content, size_t size = BODY_SIZE) {
+        content->clear();
+        for (size_t i = 0; i < size; ++i) {
+            content->push_back(static_cast<char>('a' + (i + seed) % 26));
+        }
+        return m_server.addBody("/" + std::to_string(seed), *content);
+    }
+
+    /**
+     * Set up a transfer.
+     *
+     * @param url The URL to fetch.
+     * @param transfer The transfer to set up.
+     */
+    void prepare(const std::string& url, Transfer* transfer) {
+        ASSERT_TRUE(transfer->curl.setURL(url));
+        ASSERT_TRUE(transfer->curl.setWriteCallback(Transfer::writeCallback, transfer));
+    }
+
+    /**
+     * Add a transfer to @c m_engine.
+     *
+     * @param transfer The transfer to add.
+     * @return Whether the engine accepted it.
+     */
+    bool add(Transfer* transfer) {
+        return m_engine->addTransfer(
+            transfer->curl.getCurlHandle(), [transfer](CURLcode result) { transfer->result.set_value(result); });
+    }
+
+    /**
+     * Resume a paused transfer from the engine thread.
+     *
+     * @param transfer The transfer to resume.
+     * @return Whether the engine accepted the request.
+     */
+    bool resume(Transfer* transfer) {
+        auto handle = transfer->curl.getCurlHandle();
+        return m_engine->submit(handle, [handle] { curl_easy_pause(handle, CURLPAUSE_CONT); });
+    }
+
+    /// The server the transfers fetch from.  This is declared first so that the engine's connections are closed first.
+    LocalHttpServer m_server;
+
+    /// The engine under test.
+    std::shared_ptr<CurlFetchEngine> m_engine;
+};
+
+/**
+ * Verify that many transfers run on one engine and each receives all of its own data.
+ */
+TEST_F(CurlFetchEngineTest, concurrentTransfers) {
+    std::vector<std::unique_ptr<Transfer>> transfers;
+    std::vector<std::string> contents(NUM_TRANSFERS);
+    for (size_t i = 0; i < NUM_TRANSFERS; ++i) {
+        transfers.emplace_back(new Transfer);
+        prepare(createBody(i, &contents[i]), transfers.back().get());
+        ASSERT_TRUE(add(transfers.back().get()));
+    }
+    for (size_t i = 0; i < NUM_TRANSFERS; ++i) {
+        auto future = transfers[i]->result.get_future();
+        ASSERT_EQ(std::future_status::ready, future.wait_for(TIMEOUT));
+        ASSERT_EQ(CURLE_OK, future.get());
+        ASSERT_EQ(contents[i], transfers[i]->received);
+    }
+}
+
+/**
+ * Verify that a transfer paused by its write callback is resumed by a submitted function and gets all of its data.
+ */
+TEST_F(CurlFetchEngineTest, pausedTransferIsResumed) {
+    std::string content;
+    Transfer transfer;
+    transfer.pausesLeft = 3;
+    transfer.onPause = [this, &transfer] { resume(&transfer); };
+    prepare(createBody(0, &content), &transfer);
+    ASSERT_TRUE(add(&transfer));
+    auto future = transfer.result.get_future();
+    ASSERT_EQ(std::future_status::ready, future.wait_for(TIMEOUT));
+    ASSERT_EQ(CURLE_OK, future.get());
+    ASSERT_EQ(content, transfer.received);
+}
+
+/**
+ * Verify that the engine leaves a paused transfer alone until it is asked to resume it.
+ */
+TEST_F(CurlFetchEngineTest, pausedTransferWaitsToBeResumed) {
+    std::string content;
+    Transfer transfer;
+    transfer.pausesLeft = 1;
+    prepare(createBody(0, &content), &transfer);
+    ASSERT_TRUE(add(&transfer));
+    auto future = transfer.result.get_future();
+    ASSERT_EQ(std::future_status::timeout, future.wait_for(SHORT_TIMEOUT));
+    ASSERT_TRUE(transfer.received.empty());
+
+    ASSERT_TRUE(resume(&transfer));
+    ASSERT_EQ(std::future_status::ready, future.wait_for(TIMEOUT));
+    ASSERT_EQ(CURLE_OK, future.get());
+    ASSERT_EQ(content, transfer.received);
+}
+
+/**
+ * Verify that a transfer which is removed gets no completion callback.
+ */
+TEST_F(CurlFetchEngineTest, removedTransferIsNotCompleted) {
+    std::string content;
+    Transfer transfer;
+    transfer.pausesLeft = std::numeric_limits<int>::max();
+    prepare(createBody(0, &content), &transfer);
+    ASSERT_TRUE(add(&transfer));
+    auto future = transfer.result.get_future();
+    ASSERT_EQ(std::future_status::timeout, future.wait_for(SHORT_TIMEOUT));
+    m_engine->removeTransfer(transfer.curl.getCurlHandle());
+    ASSERT_EQ(std::future_status::timeout, future.wait_for(SHORT_TIMEOUT));
+    ASSERT_TRUE(transfer.received.empty());
+}
+
+/**
+ * Verify that the shared engine and share handle are only created once while they are held.
+ */
+TEST_F(CurlFetchEngineTest, acquireReturnsSharedInstances) {
+    auto engine = CurlFetchEngine::acquire();
+    ASSERT_TRUE(engine);
+    ASSERT_EQ(engine, CurlFetchEngine::acquire());
+    ASSERT_NE(engine, m_engine);
+
+    auto share = CurlShareHandleWrapper::acquire();
+    ASSERT_TRUE(share);
+    ASSERT_EQ(share, CurlShareHandleWrapper::acquire());
+}
+
+/**
+ * Verify that @c LibCurlHttpContentFetcher delivers a whole body through the shared engine, including when the
+ * attachment fills up and the transfer has to wait for the reader.
+ */
+TEST_F(CurlFetchEngineTest, contentFetcherReadsEntireBody) {
+    std::string content;
+    // Make the body larger than the attachment so that the transfer has to pause.
+    auto url = createBody(0, &content, avs::attachment::InProcessAttachment::SDS_BUFFER_DEFAULT_SIZE_IN_BYTES * 3);
+    LibCurlHttpContentFetcher fetcher(url);
+    auto httpContent =
+        fetcher.getContent(sdkInterfaces::HTTPContentFetcherInterface::FetchOptions::ENTIRE_BODY, nullptr);
+    ASSERT_TRUE(httpContent);
+    auto reader = httpContent->dataStream->createReader(sds::ReaderPolicy::BLOCKING);
+    ASSERT_TRUE(reader);
+
+    std::string received;
+    std::vector<char> buffer(4096);
+    auto status = avs::attachment::AttachmentReader::ReadStatus::OK;
+    while (status != avs::attachment::AttachmentReader::ReadStatus::CLOSED) {
+        auto bytesRead = reader->read(buffer.data(), buffer.size(), &status, TIMEOUT);
+        ASSERT_NE(avs::attachment::AttachmentReader::ReadStatus::OK_TIMEDOUT, status);
+        received.append(buffer.data(), bytesRead);
+    }
+    ASSERT_EQ(content.size(), received.size());
+    ASSERT_TRUE(content == received);
+}
+
+/**
+ * Verify that a @c LibCurlHttpContentFetcher writing to the caller's writer finishes the body before it is destroyed,
+ * even when it is destroyed as soon as the status code is known.
+ */
+TEST_F(CurlFetchEngineTest, contentFetcherFinishesBodyForCallersWriter) {
+    std::string content;
+    // Make the body larger than the attachment so that it can't all have arrived by the time the fetcher is destroyed.
+    auto url = createBody(0, &content, avs::attachment::InProcessAttachment::SDS_BUFFER_DEFAULT_SIZE_IN_BYTES * 3);
+    auto attachment = std::make_shared<avs::attachment::InProcessAttachment>("callersWriter");
+    auto reader = attachment->createReader(sds::ReaderPolicy::BLOCKING);
+    ASSERT_TRUE(reader);
+
+    std::string received;
+    std::thread readerThread([&content, &reader, &received]() {
+        std::vector<char> buffer(4096);
+        auto status = avs::attachment::AttachmentReader::ReadStatus::OK;
+        while (received.size() < content.size() && status == avs::attachment::AttachmentReader::ReadStatus::OK) {
+            received.append(buffer.data(), reader->read(buffer.data(), buffer.size(), &status, TIMEOUT));
+        }
+    });
+    {
+        LibCurlHttpContentFetcher fetcher(url);
+        auto httpContent = fetcher.getContent(
+            sdkInterfaces::HTTPContentFetcherInterface::FetchOptions::ENTIRE_BODY,
+            attachment->createWriter(sds::WriterPolicy::BLOCKING));
+        ASSERT_TRUE(httpContent);
+        ASSERT_TRUE(*httpContent);
+    }
+    readerThread.join();
+
+    ASSERT_EQ(content.size(), received.size());
+    ASSERT_TRUE(content == received);
+}
+
+}  // namespace test
+}  // namespace libcurlUtils
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
@@ -0,0 +1,310 @@
+/*
+ * Copyright 2017-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/// @file HttpContentCacheTest.cpp
+
+#include <dirent.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "AVSCommon/Utils/File/FileUtils.h"
+#include "AVSCommon/Utils/LibcurlUtils/HttpContentCache.h"
+#include "AVSCommon/Utils/LibcurlUtils/LibCurlHttpContentFetcher.h"
+#include "AVSCommon/Utils/LibcurlUtils/LocalHttpServer.h"
+
+namespace alexaClientSDK {
+namespace avsCommon {
+namespace utils {
+namespace libcurlUtils {
+namespace test {
+
+using namespace avsCommon::avs::attachment;
+using namespace avsCommon::sdkInterfaces;
+
+/// Used to limit the amount of time tests will wait for content.  This is only hit if a test is failing.
+static const auto TIMEOUT = std::chrono::seconds(5);
+
+/// The size of each test body.
+static const size_t BODY_SIZE = 200000;
+
+/// The size of the cache, which holds four test bodies.
+static const uint64_t CACHE_SIZE = 4 * BODY_SIZE;
+
+/// The number of bytes sent before the connection drops in tests of interrupted fetches.
+static const size_t INTERRUPTED_SIZE = 50000;
+
+/// The content type of the test bodies.
+static const std::string CONTENT_TYPE = "audio/mpeg";
+
+/// A Cache-Control header which lets a response be used for an hour without revalidating it.
+static const std::string MAX_AGE = "max-age=3600";
+
+/// A Cache-Control header which makes every use of a response revalidate it.
+static const std::string NO_CACHE = "no-cache";
+
+/// A Cache-Control header which keeps a response from being stored.
+static const std::string NO_STORE = "no-store";
+
+/// Test harness for the @c HttpContentCache class, used through @c LibCurlHttpContentFetcher.
+class HttpContentCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        char directory[] = "/tmp/HttpContentCacheTestXXXXXX";
+        ASSERT_TRUE(mkdtemp(directory));
+        m_directory = directory;
+        m_cache = HttpContentCache::create(m_directory, CACHE_SIZE);
+        ASSERT_TRUE(m_cache);
+        ASSERT_TRUE(m_server.start());
+    }
+
+    void TearDown() override {
+        m_cache.reset();
+        auto dir = opendir(m_directory.c_str());
+        if (dir) {
+            while (auto entry = readdir(dir)) {
+                std::string name = entry->d_name;
+                if (name != "." && name != "..") {
+                    file::removeFile(m_directory + "/" + name);
+                }
+            }
+            closedir(dir);
+        }
+        rmdir(m_directory.c_str());
+    }
+
+    /**
+     * Serve a body of test data.
+     *
+     * @param path The path to serve it at.
+     * @param seed A value which makes the body differ from others.
+     * @param cacheControl The Cache-Control header to send with it.
+     * @param etag The ETag header to send with it, or empty to send none.
+     * @return The URL of the body.
+     */
+    std::string addBody(
+        const std::string& path,
+        size_t seed,
+        const std::string& cacheControl,
+        const std::string& etag = "") {
+        std::string body;
+        for (size_t i = 0; i < BODY_SIZE; ++i) {
+            body.push_back(static_cast<char>('a' + (i + seed) % 26));
+        }
+        m_bodies[path] = body;
+        auto url = m_server.addBody(path, body, CONTENT_TYPE);
+        m_server.setCacheHeaders(path, cacheControl, etag);
+        return url;
+    }
+
+    /**
+     * Fetch a body through @c m_cache.
+     *
+     * @param url The URL of the body.
+     * @param [out] body The body received.
+     * @param cache The cache to use, or @c nullptr to use @c m_cache.
+     */
+    void fetch(const std::string& url, std::string* body, std::shared_ptr<HttpContentCache> cache = nullptr) {
+        body->clear();
+        LibCurlHttpContentFetcher fetcher(url, cache ? cache : m_cache);
+        auto content = fetcher.getContent(HTTPContentFetcherInterface::FetchOptions::ENTIRE_BODY, nullptr);
+        ASSERT_TRUE(content);
+        ASSERT_EQ(std::future_status::ready, content->statusCode.wait_for(TIMEOUT));
+        ASSERT_EQ(200, content->statusCode.get());
+        ASSERT_EQ(CONTENT_TYPE, content->contentType.get());
+        auto reader = content->dataStream->createReader(sds::ReaderPolicy::BLOCKING);
+        ASSERT_TRUE(reader);
+        std::vector<char> buffer(4096);
+        auto status = AttachmentReader::ReadStatus::OK;
+        while (status != AttachmentReader::ReadStatus::CLOSED) {
+            auto bytesRead = reader->read(buffer.data(), buffer.size(), &status, TIMEOUT);
+            ASSERT_NE(AttachmentReader::ReadStatus::OK_TIMEDOUT, status);
+            body->append(buffer.data(), bytesRead);
+        }
+    }
+
+    /// The directory holding the cache.
+    std::string m_directory;
+
+    /// The cache under test.
+    std::shared_ptr<HttpContentCache> m_cache;
+
+    /// The server the bodies are fetched from.
+    LocalHttpServer m_server;
+
+    /// The bodies served, by path.
+    std::map<std::string, std::string> m_bodies;
+};
+
+/**
+ * Check that a body fetched a second time while it is fresh is read from the cache, for its content type as well as
+ * for its content.
+ */
+TEST_F(HttpContentCacheTest, testFreshBodyIsServedFromCache) {
+    auto url = addBody("/fresh", 0, MAX_AGE);
+    std::string body;
+    fetch(url, &body);
+    EXPECT_EQ(m_bodies["/fresh"], body);
+    EXPECT_EQ(BODY_SIZE, m_cache->getSize());
+
+    fetch(url, &body);
+    EXPECT_EQ(m_bodies["/fresh"], body);
+    EXPECT_EQ(1u, m_server.getRequestCount());
+
+    LibCurlHttpContentFetcher fetcher(url, m_cache);
+    auto content = fetcher.getContent(HTTPContentFetcherInterface::FetchOptions::CONTENT_TYPE, nullptr);
+    ASSERT_TRUE(content);
+    EXPECT_EQ(CONTENT_TYPE, content->contentType.get());
+    EXPECT_EQ(1u, m_server.getRequestCount());
+}
+
+/**
+ * Check that a fetch which was cut off is completed with a range request for the rest of the body only.
+ */
+TEST_F(HttpContentCacheTest, testInterruptedFetchIsResumedWithRangeRequest) {
+    auto url = addBody("/interrupted", 1, MAX_AGE, "\"v1\"");
+    m_server.setMaxBodyBytes(INTERRUPTED_SIZE);
+    std::string body;
+    fetch(url, &body);
+    EXPECT_EQ(m_bodies["/interrupted"].substr(0, INTERRUPTED_SIZE), body);
+
+    m_server.setMaxBodyBytes(BODY_SIZE);
+    fetch(url, &body);
+    EXPECT_EQ(m_bodies["/interrupted"], body);
+    EXPECT_NE(std::string::npos, m_server.getLastRequest().find("Range: bytes=" + std::to_string(INTERRUPTED_SIZE)));
+    EXPECT_NE(std::string::npos, m_server.getLastRequest().find("If-Range: \"v1\""));
+    EXPECT_EQ(BODY_SIZE, m_server.getBodyBytesSent());
+    EXPECT_EQ(BODY_SIZE, m_cache->getSize());
+}
+
+/**
+ * Check that a body which changed since part of it was cached is fetched whole.
+ */
+TEST_F(HttpContentCacheTest, testChangedBodyIsNotResumed) {
+    auto url = addBody("/changed", 2, MAX_AGE, "\"v1\"");
+    m_server.setMaxBodyBytes(INTERRUPTED_SIZE);
+    std::string body;
+    fetch(url, &body);
+
+    m_server.setMaxBodyBytes(BODY_SIZE);
+    addBody("/changed", 3, MAX_AGE, "\"v2\"");
+    fetch(url, &body);
+    EXPECT_EQ(m_bodies["/changed"], body);
+}
+
+/**
+ * Check that a cached body which must be revalidated is asked about with a conditional request, and read from the cache
+ * if the server says it is current.
+ */
+TEST_F(HttpContentCacheTest, testStaleBodyIsRevalidated) {
+    auto url = addBody("/revalidated", 4, NO_CACHE, "\"v1\"");
+    std::string body;
+    fetch(url, &body);
+    EXPECT_EQ(m_bodies["/revalidated"], body);
+
+    fetch(url, &body);
+    EXPECT_EQ(m_bodies["/revalidated"], body);
+    EXPECT_EQ(2u, m_server.getRequestCount());
+    EXPECT_NE(std::string::npos, m_server.getLastRequest().find("If-None-Match: \"v1\""));
+    EXPECT_EQ(BODY_SIZE, m_server.getBodyBytesSent());
+
+    // A changed body replaces the cached one.
+    addBody("/revalidated", 5, NO_CACHE, "\"v2\"");
+    fetch(url, &body);
+    EXPECT_EQ(m_bodies["/revalidated"], body);
+    fetch(url, &body);
+    EXPECT_EQ(m_bodies["/revalidated"], body);
+    EXPECT_EQ(2 * BODY_SIZE, m_server.getBodyBytesSent());
+}
+
+/**
+ * Check that a response which may not be stored is not cached.
+ */
+TEST_F(HttpContentCacheTest, testNoStoreBodyIsNotCached) {
+    auto url = addBody("/private", 6, NO_STORE);
+    std::string body;
+    fetch(url, &body);
+    EXPECT_EQ(m_bodies["/private"], body);
+    fetch(url, &body);
+    EXPECT_EQ(m_bodies["/private"], body);
+    EXPECT_EQ(2 * BODY_SIZE, m_server.getBodyBytesSent());
+    EXPECT_EQ(0u, m_cache->getSize());
+}
+
+/**
+ * Check that the least recently used entries are removed to keep the cache within its size limit.
+ */
+TEST_F(HttpContentCacheTest, testLeastRecentlyUsedBodiesAreEvicted) {
+    std::vector<std::string> urls;
+    std::string body;
+    for (size_t i = 0; i < 5; ++i) {
+        urls.push_back(addBody("/" + std::to_string(i), i, MAX_AGE));
+        fetch(urls.back(), &body);
+        if (1 == i) {
+            // Use the first body again so that the second is the least recently used.
+            fetch(urls[0], &body);
+        }
+    }
+    EXPECT_EQ(CACHE_SIZE, m_cache->getSize());
+    HttpContentCache::Metadata metadata;
+    EXPECT_TRUE(m_cache->lookup(urls[0], &metadata));
+    EXPECT_FALSE(m_cache->lookup(urls[1], &metadata));
+    EXPECT_TRUE(m_cache->lookup(urls[4], &metadata));
+}
+
+/**
+ * Check that a cache created in the directory of an earlier one serves its entries.
+ */
+TEST_F(HttpContentCacheTest, testEntriesPersist) {
+    auto url = addBody("/persisted", 7, MAX_AGE);
+    std::string body;
+    fetch(url, &body);
+
+    m_cache.reset();
+    auto cache = HttpContentCache::create(m_directory, CACHE_SIZE);
+    ASSERT_TRUE(cache);
+    EXPECT_EQ(BODY_SIZE, cache->getSize());
+    fetch(url, &body, cache);
+    EXPECT_EQ(m_bodies["/persisted"], body);
+    EXPECT_EQ(1u, m_server.getRequestCount());
+}
+
+/**
+ * Check how long responses stay fresh.
+ */
+TEST_F(HttpContentCacheTest, testComputeExpiry) {
+    auto now = std::chrono::system_clock::now();
+    EXPECT_EQ(now + std::chrono::seconds(60), HttpContentCache::computeExpiry("public, max-age=60", "", "", now));
+    EXPECT_EQ(now, HttpContentCache::computeExpiry("no-cache, max-age=60", "", "", now));
+    EXPECT_EQ(now, HttpContentCache::computeExpiry("", "", "", now));
+    EXPECT_EQ(
+        std::chrono::system_clock::from_time_t(1000000000),
+        HttpContentCache::computeExpiry("", "Sun, 09 Sep 2001 01:46:40 GMT", "", now));
+    EXPECT_TRUE(HttpContentCache::isStorable("max-age=60"));
+    EXPECT_FALSE(HttpContentCache::isStorable("private, no-store"));
+}
+
+}  // namespace test
+}  // namespace libcurlUtils
+}  // namespace utils
+}  // namespace avsCommon
+}  // namespace alexaClientSDK
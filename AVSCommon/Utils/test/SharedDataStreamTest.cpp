@@ -18,8 +18,11 @@
 #include <vector>
 #include <random>
 #include <climits>
+#include <chrono>
 #include <algorithm>
 #include <functional>
+#include <future>
+#include <thread>
 #include <unordered_map>
 
 #include <gtest/gtest.h>
@@ -893,6 +896,155 @@ TEST_F(SharedDataStreamTest, readerClose) {
     ASSERT_EQ(reader->read(readBuf, readWords), Sds::Reader::Error::CLOSED);
 }
 
+/// This tests @c SharedDataStream::Reader::waitForData().
+TEST_F(SharedDataStreamTest, readerWaitForData) {
+    static const size_t WORDSIZE = 2;
+    static const size_t WORDCOUNT = 10;
+    static const size_t MAXREADERS = 2;
+    static const std::chrono::milliseconds SHORT_TIMEOUT(10);
+    static const std::chrono::seconds LONG_TIMEOUT(5);
+
+    // Initialize an sds.
+    size_t bufferSize = Sds::calculateBufferSize(WORDCOUNT, WORDSIZE, MAXREADERS);
+    auto buffer = std::make_shared<Sds::Buffer>(bufferSize);
+    auto sds = Sds::create(buffer, WORDSIZE, MAXREADERS);
+    ASSERT_NE(sds, nullptr);
+
+    // A nonblocking reader with no data times out.
+    std::shared_ptr<Sds::Reader> reader = sds->createReader(Sds::Reader::Policy::NONBLOCKING);
+    ASSERT_NE(reader, nullptr);
+    auto writer = sds->createWriter(Sds::Writer::Policy::NONBLOCKABLE);
+    ASSERT_NE(writer, nullptr);
+    EXPECT_FALSE(reader->waitForData(SHORT_TIMEOUT));
+
+    // Data written from another thread wakes the waiting reader, and nothing is consumed by the wait.
+    uint8_t writeBuf[WORDSIZE * WORDCOUNT] = {};
+    auto writeFuture = std::async(std::launch::async, [&writer, &writeBuf]() {
+        std::this_thread::sleep_for(SHORT_TIMEOUT);
+        return writer->write(writeBuf, 1);
+    });
+    EXPECT_TRUE(reader->waitForData(LONG_TIMEOUT));
+    EXPECT_EQ(writeFuture.get(), 1);
+    EXPECT_EQ(reader->tell(Sds::Reader::Reference::BEFORE_WRITER), 1U);
+    EXPECT_TRUE(reader->waitForData(SHORT_TIMEOUT));
+
+    // Closing the reader from another thread wakes a waiting reader.
+    uint8_t readBuf[WORDSIZE * WORDCOUNT];
+    ASSERT_EQ(reader->read(readBuf, 1), 1);
+    auto closeFuture = std::async(std::launch::async, [&reader]() {
+        std::this_thread::sleep_for(SHORT_TIMEOUT);
+        reader->close();
+    });
+    EXPECT_TRUE(reader->waitForData(LONG_TIMEOUT));
+    closeFuture.wait();
+    EXPECT_EQ(reader->read(readBuf, 1), Sds::Reader::Error::CLOSED);
+
+    // Closing the writer wakes a waiting reader.
+    std::shared_ptr<Sds::Reader> reader2 = sds->createReader(Sds::Reader::Policy::BLOCKING, true);
+    ASSERT_NE(reader2, nullptr);
+    auto writerCloseFuture = std::async(std::launch::async, [&writer]() {
+        std::this_thread::sleep_for(SHORT_TIMEOUT);
+        writer->close();
+    });
+    EXPECT_TRUE(reader2->waitForData(LONG_TIMEOUT));
+    writerCloseFuture.wait();
+}
+
+/**
+ * This measures how long @c SharedDataStream::Reader::waitForData() takes to wake up after data is written.  A missed
+ * notify leaves the reader asleep until its timeout, so every wake must come well before the timeout.
+ */
+TEST_F(SharedDataStreamTest, readerWaitForDataWakeLatency) {
+    static const size_t WORDSIZE = 2;
+    static const size_t WORDCOUNT = 10;
+    static const size_t MAXREADERS = 1;
+    static const size_t ITERATIONS = 2000;
+    static const std::chrono::seconds WAIT_TIMEOUT(5);
+    static const std::chrono::milliseconds MAX_WAKE_LATENCY(250);
+
+    size_t bufferSize = Sds::calculateBufferSize(WORDCOUNT, WORDSIZE, MAXREADERS);
+    auto buffer = std::make_shared<Sds::Buffer>(bufferSize);
+    auto sds = Sds::create(buffer, WORDSIZE, MAXREADERS);
+    ASSERT_NE(sds, nullptr);
+    std::shared_ptr<Sds::Reader> reader = sds->createReader(Sds::Reader::Policy::NONBLOCKING);
+    ASSERT_NE(reader, nullptr);
+    // ALL_OR_NOTHING is the policy attachment writers use.
+    auto writer = sds->createWriter(Sds::Writer::Policy::ALL_OR_NOTHING);
+    ASSERT_NE(writer, nullptr);
+
+    uint8_t writeBuf[WORDSIZE] = {};
+    uint8_t readBuf[WORDSIZE];
+    std::chrono::steady_clock::duration maxLatency = std::chrono::steady_clock::duration::zero();
+    for (size_t i = 0; i < ITERATIONS; ++i) {
+        auto wakeFuture = std::async(std::launch::async, [&reader]() {
+            EXPECT_TRUE(reader->waitForData(WAIT_TIMEOUT));
+            return std::chrono::steady_clock::now();
+        });
+        // Vary the delay so the write lands at different points of the reader going to sleep.
+        std::this_thread::sleep_for(std::chrono::microseconds(i % 50));
+        auto writeTime = std::chrono::steady_clock::now();
+        ASSERT_EQ(writer->write(writeBuf, 1), 1);
+        auto latency = wakeFuture.get() - writeTime;
+        maxLatency = std::max(maxLatency, latency);
+        ASSERT_EQ(reader->read(readBuf, 1), 1);
+    }
+    EXPECT_LT(maxLatency, MAX_WAKE_LATENCY);
+}
+
+/// This tests @c SharedDataStream::Reader::setDataAvailableCallback() and @c Writer::setSpaceAvailableCallback().
+TEST_F(SharedDataStreamTest, dataAndSpaceAvailableCallbacks) {
+    static const size_t WORDSIZE = 2;
+    static const size_t WORDCOUNT = 4;
+    static const size_t MAXREADERS = 2;
+
+    size_t bufferSize = Sds::calculateBufferSize(WORDCOUNT, WORDSIZE, MAXREADERS);
+    auto buffer = std::make_shared<Sds::Buffer>(bufferSize);
+    auto sds = Sds::create(buffer, WORDSIZE, MAXREADERS);
+    ASSERT_NE(sds, nullptr);
+    std::shared_ptr<Sds::Reader> reader = sds->createReader(Sds::Reader::Policy::NONBLOCKING);
+    ASSERT_NE(reader, nullptr);
+    auto writer = sds->createWriter(Sds::Writer::Policy::ALL_OR_NOTHING);
+    ASSERT_NE(writer, nullptr);
+
+    size_t numDataCalls = 0;
+    size_t numSpaceCalls = 0;
+    reader->setDataAvailableCallback([&numDataCalls] { ++numDataCalls; });
+    writer->setSpaceAvailableCallback([&numSpaceCalls] { ++numSpaceCalls; });
+
+    // Writing calls the data callback, and filling the buffer does not call the space callback.
+    uint8_t writeBuf[WORDSIZE * WORDCOUNT] = {};
+    ASSERT_EQ(writer->write(writeBuf, WORDCOUNT), static_cast<ssize_t>(WORDCOUNT));
+    EXPECT_EQ(numDataCalls, 1U);
+    EXPECT_EQ(writer->write(writeBuf, 1), Sds::Writer::Error::WOULDBLOCK);
+    EXPECT_EQ(numSpaceCalls, 0U);
+
+    // Reading frees space and calls the space callback, after which the write succeeds.
+    uint8_t readBuf[WORDSIZE * WORDCOUNT];
+    ASSERT_EQ(reader->read(readBuf, 1), 1);
+    EXPECT_EQ(numSpaceCalls, 1U);
+    EXPECT_EQ(writer->write(writeBuf, 1), 1);
+    EXPECT_EQ(numDataCalls, 2U);
+
+    // Closing the reader calls the data callback.
+    reader->close(0, Sds::Reader::Reference::BEFORE_WRITER);
+    EXPECT_EQ(numDataCalls, 3U);
+
+    // Once cleared, a callback is no longer called.
+    reader->setDataAvailableCallback(nullptr);
+    ASSERT_EQ(reader->read(readBuf, WORDCOUNT), static_cast<ssize_t>(WORDCOUNT));
+    EXPECT_EQ(numSpaceCalls, 2U);
+    writer->setSpaceAvailableCallback(nullptr);
+    ASSERT_EQ(writer->write(writeBuf, 1), 1);
+    EXPECT_EQ(numDataCalls, 3U);
+
+    // Closing the writer calls both callbacks, since reads and writes then return without waiting.
+    reader->setDataAvailableCallback([&numDataCalls] { ++numDataCalls; });
+    writer->setSpaceAvailableCallback([&numSpaceCalls] { ++numSpaceCalls; });
+    writer->close();
+    EXPECT_EQ(numDataCalls, 4U);
+    EXPECT_EQ(numSpaceCalls, 3U);
+}
+
 /// This tests @c SharedDataStream::Reader::getId().
 TEST_F(SharedDataStreamTest, readerGetId) {
     static const size_t WORDSIZE = 1;
@@ -16,6 +16,7 @@
 #include <gtest/gtest.h>
 
 #include <AVSCommon/Utils/Stream/StreamFunctions.h>
+#include <AVSCommon/Utils/Stream/Streambuf.h>
 
 namespace alexaClientSDK {
 namespace avsCommon {
@@ -172,6 +173,21 @@ TEST_F(StreamFunctionsTest, tellgAfterReading) {
     ASSERT_EQ(numberToRead, m_stream->tellg());
 }
 
+/**
+ * Verify that the resource identifier given for the data is reported by the stream's buffer
+ */
+TEST_F(StreamFunctionsTest, resourceId) {
+    auto buf = dynamic_cast<stream::Streambuf*>(m_stream->rdbuf());
+    ASSERT_NE(nullptr, buf);
+    ASSERT_TRUE(buf->getResourceId().empty());
+
+    auto stream = stream::streamFromData(TEST_DATA, sizeof(TEST_DATA), "testData");
+    buf = dynamic_cast<stream::Streambuf*>(stream->rdbuf());
+    ASSERT_NE(nullptr, buf);
+    ASSERT_EQ("testData", buf->getResourceId());
+    ASSERT_TRUE(streamAndDataAreEqual(*stream, TEST_DATA, sizeof(TEST_DATA)));
+}
+
 }  // namespace test
 }  // namespace utils
 }  // namespace avsCommon
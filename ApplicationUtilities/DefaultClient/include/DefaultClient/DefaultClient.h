@@ -24,6 +24,7 @@
 #include <AFML/VisualActivityTracker.h>
 #include <AIP/AudioInputProcessor.h>
 #include <AIP/AudioProvider.h>
+#include <AIP/Endpointer.h>
 #include <Alerts/AlertsCapabilityAgent.h>
 #include <Alerts/Renderer/Renderer.h>
 #include <Alerts/Storage/AlertStorageInterface.h>
@@ -97,6 +98,12 @@ public:
      * @param firmwareVersion The firmware version to report to @c AVS or @c INVALID_FIRMWARE_VERSION.
      * @param sendSoftwareInfoOnConnected Whether to send SoftwareInfo upon connecting to @c AVS.
      * @param softwareInfoSenderObserver Object to receive notifications about sending SoftwareInfo.
+     * @param endpointer An optional @c Endpointer used to stop capturing audio when the end of speech is detected on
+     *     the device.
+     * @param audioPrefetchMediaPlayer An optional second media player for Alexa audio content, used to prefetch the
+     *     next queued item so playback continues without a gap.
+     * @param speakPrestageMediaPlayer An optional second media player for Alexa speech, used to prestage the next
+     *     Speak so multi-Speak responses play without a gap between utterances.
      * @return A @c std::unique_ptr to a DefaultClient if all went well or @c nullptr otherwise.
      *
      * TODO: ACSDK-384 Remove the requirement of clients having to wait for authorization before making the connect()
@@ -131,7 +138,10 @@ public:
             avsCommon::sdkInterfaces::softwareInfo::INVALID_FIRMWARE_VERSION,
         bool sendSoftwareInfoOnConnected = false,
         std::shared_ptr<avsCommon::sdkInterfaces::SoftwareInfoSenderObserverInterface> softwareInfoSenderObserver =
-            nullptr);
+            nullptr,
+        std::shared_ptr<capabilityAgents::aip::Endpointer> endpointer = nullptr,
+        std::shared_ptr<avsCommon::utils::mediaPlayer::MediaPlayerInterface> audioPrefetchMediaPlayer = nullptr,
+        std::shared_ptr<avsCommon::utils::mediaPlayer::MediaPlayerInterface> speakPrestageMediaPlayer = nullptr);
 
     /**
      * Connects the client to AVS. Note that users should first wait for the authorization state to be set to REFRESHED
@@ -421,6 +431,12 @@ private:
      * @param firmwareVersion The firmware version to report to @c AVS or @c INVALID_FIRMWARE_VERSION.
      * @param sendSoftwareInfoOnConnected Whether to send SoftwareInfo upon connecting to @c AVS.
      * @param softwareInfoSenderObserver Object to receive notifications about sending SoftwareInfo.
+     * @param endpointer An optional @c Endpointer used to stop capturing audio when the end of speech is detected on
+     *     the device.
+     * @param audioPrefetchMediaPlayer An optional second media player for Alexa audio content, used to prefetch the
+     *     next queued item so playback continues without a gap.
+     * @param speakPrestageMediaPlayer An optional second media player for Alexa speech, used to prestage the next
+     *     Speak so multi-Speak responses play without a gap between utterances.
      * @return Whether the SDK was initialized properly.
      */
     bool initialize(
@@ -449,7 +465,10 @@ private:
         bool isGuiSupported,
         avsCommon::sdkInterfaces::softwareInfo::FirmwareVersion firmwareVersion,
         bool sendSoftwareInfoOnConnected,
-        std::shared_ptr<avsCommon::sdkInterfaces::SoftwareInfoSenderObserverInterface> softwareInfoSenderObserver);
+        std::shared_ptr<avsCommon::sdkInterfaces::SoftwareInfoSenderObserverInterface> softwareInfoSenderObserver,
+        std::shared_ptr<capabilityAgents::aip::Endpointer> endpointer,
+        std::shared_ptr<avsCommon::utils::mediaPlayer::MediaPlayerInterface> audioPrefetchMediaPlayer,
+        std::shared_ptr<avsCommon::utils::mediaPlayer::MediaPlayerInterface> speakPrestageMediaPlayer);
 
     /// The directive sequencer.
     std::shared_ptr<avsCommon::sdkInterfaces::DirectiveSequencerInterface> m_directiveSequencer;
@@ -20,11 +20,16 @@
 #include <ADSL/MessageInterpreter.h>
 #include <AVSCommon/AVS/Attachment/AttachmentManager.h>
 #include <AVSCommon/AVS/ExceptionEncounteredSender.h>
+#include <AVSCommon/Utils/Memory/Memory.h>
 #include <ContextManager/ContextManager.h>
 #include <Settings/SettingsUpdatedEventSender.h>
 #include <System/EndpointHandler.h>
 #include <System/UserInactivityMonitor.h>
 
+#ifdef ENABLE_OPUS
+#include <AIP/OpusEncoderContext.h>
+#endif
+
 namespace alexaClientSDK {
 namespace defaultClient {
 
@@ -64,7 +69,10 @@ std::unique_ptr<DefaultClient> DefaultClient::create(
     bool isGuiSupported,
     avsCommon::sdkInterfaces::softwareInfo::FirmwareVersion firmwareVersion,
     bool sendSoftwareInfoOnConnected,
-    std::shared_ptr<avsCommon::sdkInterfaces::SoftwareInfoSenderObserverInterface> softwareInfoSenderObserver) {
+    std::shared_ptr<avsCommon::sdkInterfaces::SoftwareInfoSenderObserverInterface> softwareInfoSenderObserver,
+    std::shared_ptr<capabilityAgents::aip::Endpointer> endpointer,
+    std::shared_ptr<avsCommon::utils::mediaPlayer::MediaPlayerInterface> audioPrefetchMediaPlayer,
+    std::shared_ptr<avsCommon::utils::mediaPlayer::MediaPlayerInterface> speakPrestageMediaPlayer) {
     std::unique_ptr<DefaultClient> defaultClient(new DefaultClient());
     if (!defaultClient->initialize(
             externalMusicProviderMediaPlayers,
@@ -89,7 +97,10 @@ std::unique_ptr<DefaultClient> DefaultClient::create(
             isGuiSupported,
             firmwareVersion,
             sendSoftwareInfoOnConnected,
-            softwareInfoSenderObserver)) {
+            softwareInfoSenderObserver,
+            endpointer,
+            audioPrefetchMediaPlayer,
+            speakPrestageMediaPlayer)) {
         return nullptr;
     }
 
@@ -122,7 +133,10 @@ bool DefaultClient::initialize(
     bool isGuiSupported,
     avsCommon::sdkInterfaces::softwareInfo::FirmwareVersion firmwareVersion,
     bool sendSoftwareInfoOnConnected,
-    std::shared_ptr<avsCommon::sdkInterfaces::SoftwareInfoSenderObserverInterface> softwareInfoSenderObserver) {
+    std::shared_ptr<avsCommon::sdkInterfaces::SoftwareInfoSenderObserverInterface> softwareInfoSenderObserver,
+    std::shared_ptr<capabilityAgents::aip::Endpointer> endpointer,
+    std::shared_ptr<avsCommon::utils::mediaPlayer::MediaPlayerInterface> audioPrefetchMediaPlayer,
+    std::shared_ptr<avsCommon::utils::mediaPlayer::MediaPlayerInterface> speakPrestageMediaPlayer) {
     if (!audioFactory) {
         ACSDK_ERROR(LX("initializeFailed").d("reason", "nullAudioFactory"));
         return false;
@@ -282,6 +296,20 @@ bool DefaultClient::initialize(
      * Creating the Audio Input Processor - This component is the Capability Agent that implments the SpeechRecognizer
      * interface of AVS.
      */
+    std::shared_ptr<capabilityAgents::aip::AudioEncoder> audioEncoder;
+#ifdef ENABLE_OPUS
+    /*
+     * Creating the Audio Encoder - This is used by the AudioInputProcessor to compress the audio it uploads, when
+     * encoding is enabled in the "audioInputProcessor" configuration.
+     */
+    audioEncoder = capabilityAgents::aip::AudioEncoder::create(
+        avsCommon::utils::memory::make_unique<capabilityAgents::aip::OpusEncoderContext>());
+    if (!audioEncoder) {
+        ACSDK_ERROR(LX("initializeFailed").d("reason", "unableToCreateAudioEncoder"));
+        return false;
+    }
+#endif
+
     m_audioInputProcessor = capabilityAgents::aip::AudioInputProcessor::create(
         m_directiveSequencer,
         m_connectionManager,
@@ -289,7 +317,10 @@ bool DefaultClient::initialize(
         m_audioFocusManager,
         m_dialogUXStateAggregator,
         m_exceptionSender,
-        userInactivityMonitor);
+        userInactivityMonitor,
+        capabilityAgents::aip::AudioProvider::null(),
+        audioEncoder,
+        endpointer);
     if (!m_audioInputProcessor) {
         ACSDK_ERROR(LX("initializeFailed").d("reason", "unableToCreateAudioInputProcessor"));
         return false;
@@ -307,7 +338,8 @@ bool DefaultClient::initialize(
         m_audioFocusManager,
         contextManager,
         m_exceptionSender,
-        m_dialogUXStateAggregator);
+        m_dialogUXStateAggregator,
+        speakPrestageMediaPlayer);
     if (!m_speechSynthesizer) {
         ACSDK_ERROR(LX("initializeFailed").d("reason", "unableToCreateSpeechSynthesizer"));
         return false;
@@ -346,7 +378,8 @@ bool DefaultClient::initialize(
         m_audioFocusManager,
         contextManager,
         m_exceptionSender,
-        m_playbackRouter);
+        m_playbackRouter,
+        audioPrefetchMediaPlayer);
     if (!m_audioPlayer) {
         ACSDK_ERROR(LX("initializeFailed").d("reason", "unableToCreateAudioPlayer"));
         return false;
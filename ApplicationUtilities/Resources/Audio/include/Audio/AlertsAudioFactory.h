@@ -16,24 +16,40 @@
 #ifndef ALEXA_CLIENT_SDK_APPLICATIONUTILITIES_RESOURCES_AUDIO_INCLUDE_AUDIO_ALERTSAUDIOFACTORY_H_
 #define ALEXA_CLIENT_SDK_APPLICATIONUTILITIES_RESOURCES_AUDIO_INCLUDE_AUDIO_ALERTSAUDIOFACTORY_H_
 
+#include <memory>
+
 #include <AVSCommon/SDKInterfaces/Audio/AlertsAudioFactoryInterface.h>
 
+#include "Audio/AudioResourcePack.h"
+
 namespace alexaClientSDK {
 namespace applicationUtilities {
 namespace resources {
 namespace audio {
 
 /**
- * A class that delivers a stream to the audio data for the various Alerts.
+ * A class that delivers a stream to the audio data for the various Alerts.  Sounds are read from an
+ * @c AudioResourcePack when one is given and holds them, and otherwise from the compiled-in data.
  */
 class AlertsAudioFactory : public avsCommon::sdkInterfaces::audio::AlertsAudioFactoryInterface {
 public:
+    /**
+     * Constructor.
+     *
+     * @param resourcePack The pack to read the sounds from, or @c nullptr to use the compiled-in data.
+     */
+    explicit AlertsAudioFactory(std::shared_ptr<AudioResourcePack> resourcePack = nullptr);
+
     std::function<std::unique_ptr<std::istream>()> alarmDefault() const override;
     std::function<std::unique_ptr<std::istream>()> alarmShort() const override;
     std::function<std::unique_ptr<std::istream>()> timerDefault() const override;
     std::function<std::unique_ptr<std::istream>()> timerShort() const override;
     std::function<std::unique_ptr<std::istream>()> reminderDefault() const override;
     std::function<std::unique_ptr<std::istream>()> reminderShort() const override;
+
+private:
+    /// The pack to read the sounds from, or @c nullptr.
+    std::shared_ptr<AudioResourcePack> m_resourcePack;
 };
 
 }  // namespace audio
@@ -21,6 +21,8 @@
 #include <AVSCommon/SDKInterfaces/Audio/AlertsAudioFactoryInterface.h>
 #include <AVSCommon/SDKInterfaces/Audio/NotificationsAudioFactoryInterface.h>
 
+#include "Audio/AudioResourcePack.h"
+
 namespace alexaClientSDK {
 namespace applicationUtilities {
 namespace resources {
@@ -31,8 +33,19 @@ namespace audio {
  */
 class AudioFactory : public avsCommon::sdkInterfaces::audio::AudioFactoryInterface {
 public:
+    /**
+     * Constructor.
+     *
+     * @param resourcePack The pack to read the sounds from, or @c nullptr to use the compiled-in data.
+     */
+    explicit AudioFactory(std::shared_ptr<AudioResourcePack> resourcePack = nullptr);
+
     std::shared_ptr<avsCommon::sdkInterfaces::audio::AlertsAudioFactoryInterface> alerts() const override;
     std::shared_ptr<avsCommon::sdkInterfaces::audio::NotificationsAudioFactoryInterface> notifications() const override;
+
+private:
+    /// The pack to read the sounds from, or @c nullptr.
+    std::shared_ptr<AudioResourcePack> m_resourcePack;
 };
 
 }  // namespace audio
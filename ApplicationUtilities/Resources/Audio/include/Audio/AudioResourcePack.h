@@ -0,0 +1,145 @@
+/*
+ * Copyright 2017-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_APPLICATIONUTILITIES_RESOURCES_AUDIO_INCLUDE_AUDIO_AUDIORESOURCEPACK_H_
+#define ALEXA_CLIENT_SDK_APPLICATIONUTILITIES_RESOURCES_AUDIO_INCLUDE_AUDIO_AUDIORESOURCEPACK_H_
+
+#include <cstddef>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace alexaClientSDK {
+namespace applicationUtilities {
+namespace resources {
+namespace audio {
+
+/**
+ * A single file holding a set of named audio resources, which is memory mapped the first time a resource is opened
+ * so that the sounds only take up memory once they are actually played.  Streams opened from the pack read straight
+ * from the mapping and keep it alive for as long as they exist.
+ *
+ * The file starts with an index, and all integers are little endian:
+ *
+ * @code
+ *     char[8]  magic "ACSDKARP"
+ *     uint32   version (1)
+ *     uint32   number of resources
+ *     for each resource:
+ *         uint32   length of the name
+ *         char[]   name
+ *         uint64   offset of the data from the start of the file
+ *         uint64   size of the data
+ *     resource data
+ * @endcode
+ *
+ * Packs can be built with @c Audio/Data/create_resource_pack.bash.
+ */
+class AudioResourcePack : public std::enable_shared_from_this<AudioResourcePack> {
+public:
+    /**
+     * Create a pack for a file.  The file is not read until the first resource is opened.
+     *
+     * @param path The path of the pack file.
+     * @return The pack, or @c nullptr if the file does not exist.
+     */
+    static std::shared_ptr<AudioResourcePack> create(const std::string& path);
+
+    /**
+     * Build a stream factory which opens a resource from a pack, or falls back to another factory if there is no pack
+     * or the pack does not hold the resource.
+     *
+     * @param pack The pack to open the resource from, which may be @c nullptr.
+     * @param name The name of the resource.
+     * @param fallback The factory to use when the resource can't be opened from @c pack.
+     * @return The stream factory.
+     */
+    static std::function<std::unique_ptr<std::istream>()> createStreamFactory(
+        std::shared_ptr<AudioResourcePack> pack,
+        const std::string& name,
+        std::function<std::unique_ptr<std::istream>()> fallback);
+
+    /**
+     * Destructor.
+     */
+    ~AudioResourcePack();
+
+    /**
+     * Open a stream to a resource in the pack.
+     *
+     * @param name The name of the resource.
+     * @return A stream to the resource's data, or @c nullptr if the pack is invalid or does not hold the resource.
+     */
+    std::unique_ptr<std::istream> openStream(const std::string& name);
+
+private:
+    /// The location of a resource in the mapping.
+    struct Resource {
+        /// The offset of the resource data from the start of the file.
+        size_t offset;
+
+        /// The size of the resource data.
+        size_t size;
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param path The path of the pack file.
+     */
+    AudioResourcePack(const std::string& path);
+
+    /**
+     * Map the pack file and parse its index, if that has not been tried yet.  @c m_mutex must be held.
+     *
+     * @return Whether the pack is mapped and valid.
+     */
+    bool mapLocked();
+
+    /**
+     * Parse the index of the mapped file into @c m_resources.  @c m_mutex must be held.
+     *
+     * @return Whether the index is valid.
+     */
+    bool parseIndexLocked();
+
+    /// The path of the pack file.
+    const std::string m_path;
+
+    /// Serializes mapping the file.
+    std::mutex m_mutex;
+
+    /// Whether mapping the file has been tried.
+    bool m_mapAttempted;
+
+    /// The mapped file, or @c nullptr if it is not mapped.
+    const unsigned char* m_data;
+
+    /// The size of the mapped file.
+    size_t m_size;
+
+    /// The resources in the pack, by name.
+    std::unordered_map<std::string, Resource> m_resources;
+};
+
+}  // namespace audio
+}  // namespace resources
+}  // namespace applicationUtilities
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_APPLICATIONUTILITIES_RESOURCES_AUDIO_INCLUDE_AUDIO_AUDIORESOURCEPACK_H_
@@ -0,0 +1,53 @@
+#!/bin/bash
+
+# This is used to create an audio resource pack, which AudioResourcePack can memory map instead of using the sounds
+# compiled into this library.  Each file is stored under its base name, so the files should keep the names they are
+# downloaded with from https://developer.amazon.com/docs/alexa-voice-service/ux-design-overview.html#sounds.
+
+if [ "$#" -lt 2 ] || [ -f "${1}" ]; then
+  echo "Usage: $0 <output_pack_file> <file>..." >&2
+  exit 1
+fi
+
+OUTPUT_FILE=${1}
+shift
+
+for FILE in "$@"; do
+  if ! [ -f "${FILE}" ]; then
+    echo "No such file: ${FILE}" >&2
+    exit 1
+  fi
+done
+
+# Write an integer of the given number of bytes, little endian.
+write_integer() {
+  local VALUE=${1}
+  local BYTES=${2}
+  printf "%0$((BYTES * 2))x" "${VALUE}" | fold -w2 | tac | tr -d '\n' | xxd -r -p >> ${OUTPUT_FILE}
+}
+
+# The header is the magic, the version and the number of resources.
+INDEX_SIZE=16
+for FILE in "$@"; do
+  NAME=$(basename "${FILE}")
+  INDEX_SIZE=$((INDEX_SIZE + 4 + ${#NAME} + 16))
+done
+
+printf "ACSDKARP" > ${OUTPUT_FILE}
+write_integer 1 4
+write_integer $# 4
+
+OFFSET=${INDEX_SIZE}
+for FILE in "$@"; do
+  NAME=$(basename "${FILE}")
+  SIZE=$(wc -c < "${FILE}")
+  write_integer ${#NAME} 4
+  printf "%s" "${NAME}" >> ${OUTPUT_FILE}
+  write_integer ${OFFSET} 8
+  write_integer ${SIZE} 8
+  OFFSET=$((OFFSET + SIZE))
+done
+
+for FILE in "$@"; do
+  cat "${FILE}" >> ${OUTPUT_FILE}
+done
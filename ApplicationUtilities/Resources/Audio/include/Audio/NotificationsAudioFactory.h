@@ -16,19 +16,35 @@
 #ifndef ALEXA_CLIENT_SDK_APPLICATIONUTILITIES_RESOURCES_AUDIO_INCLUDE_AUDIO_NOTIFICATIONSAUDIOFACTORY_H_
 #define ALEXA_CLIENT_SDK_APPLICATIONUTILITIES_RESOURCES_AUDIO_INCLUDE_AUDIO_NOTIFICATIONSAUDIOFACTORY_H_
 
+#include <memory>
+
 #include <AVSCommon/SDKInterfaces/Audio/NotificationsAudioFactoryInterface.h>
 
+#include "Audio/AudioResourcePack.h"
+
 namespace alexaClientSDK {
 namespace applicationUtilities {
 namespace resources {
 namespace audio {
 
 /**
- * A class that delivers a stream to the audio data for the default notification sound.
+ * A class that delivers a stream to the audio data for the default notification sound.  The sound is read from an
+ * @c AudioResourcePack when one is given and holds it, and otherwise from the compiled-in data.
  */
 class NotificationsAudioFactory : public avsCommon::sdkInterfaces::audio::NotificationsAudioFactoryInterface {
 public:
+    /**
+     * Constructor.
+     *
+     * @param resourcePack The pack to read the sound from, or @c nullptr to use the compiled-in data.
+     */
+    explicit NotificationsAudioFactory(std::shared_ptr<AudioResourcePack> resourcePack = nullptr);
+
     std::function<std::unique_ptr<std::istream>()> notificationDefault() const override;
+
+private:
+    /// The pack to read the sound from, or @c nullptr.
+    std::shared_ptr<AudioResourcePack> m_resourcePack;
 };
 
 }  // namespace audio
@@ -17,62 +17,77 @@
 
 #include <AVSCommon/Utils/Stream/StreamFunctions.h>
 
+#ifdef COMPILED_IN_AUDIO_RESOURCES
 #include "Audio/Data/med_system_alerts_melodic_01._TTH_.mp3.h"
 #include "Audio/Data/med_system_alerts_melodic_01_short._TTH_.wav.h"
 #include "Audio/Data/med_system_alerts_melodic_02._TTH_.mp3.h"
 #include "Audio/Data/med_system_alerts_melodic_02_short._TTH_.wav.h"
 
+/// A stream to a compiled-in sound, identified by the name of its array.
+#define COMPILED_IN_SOUND(array) avsCommon::utils::stream::streamFromData(data::array, sizeof(data::array), #array)
+#else
+/// The compiled-in sounds are left out of this build, so they are only available from a resource pack.
+#define COMPILED_IN_SOUND(array) nullptr
+#endif
+
 namespace alexaClientSDK {
 namespace applicationUtilities {
 namespace resources {
 namespace audio {
 
+/// The name of the default alarm sound in a resource pack.
+static const std::string ALARM_DEFAULT_NAME = "med_system_alerts_melodic_01._TTH_.mp3";
+/// The name of the short alarm sound in a resource pack.
+static const std::string ALARM_SHORT_NAME = "med_system_alerts_melodic_01_short._TTH_.wav";
+/// The name of the default timer sound in a resource pack.
+static const std::string TIMER_DEFAULT_NAME = "med_system_alerts_melodic_02._TTH_.mp3";
+/// The name of the short timer sound in a resource pack.
+static const std::string TIMER_SHORT_NAME = "med_system_alerts_melodic_02_short._TTH_.wav";
+
 static std::unique_ptr<std::istream> alarmDefaultFactory() {
-    return avsCommon::utils::stream::streamFromData(
-        data::med_system_alerts_melodic_01__TTH__mp3, sizeof(data::med_system_alerts_melodic_01__TTH__mp3));
+    return COMPILED_IN_SOUND(med_system_alerts_melodic_01__TTH__mp3);
 }
 static std::unique_ptr<std::istream> alarmShortFactory() {
-    return avsCommon::utils::stream::streamFromData(
-        data::med_system_alerts_melodic_01_short__TTH__wav, sizeof(data::med_system_alerts_melodic_01_short__TTH__wav));
+    return COMPILED_IN_SOUND(med_system_alerts_melodic_01_short__TTH__wav);
 }
 
 static std::unique_ptr<std::istream> timerDefaultFactory() {
-    return avsCommon::utils::stream::streamFromData(
-        data::med_system_alerts_melodic_02__TTH__mp3, sizeof(data::med_system_alerts_melodic_02__TTH__mp3));
+    return COMPILED_IN_SOUND(med_system_alerts_melodic_02__TTH__mp3);
 }
 static std::unique_ptr<std::istream> timerShortFactory() {
-    return avsCommon::utils::stream::streamFromData(
-        data::med_system_alerts_melodic_02_short__TTH__wav, sizeof(data::med_system_alerts_melodic_02_short__TTH__wav));
+    return COMPILED_IN_SOUND(med_system_alerts_melodic_02_short__TTH__wav);
 }
 
 static std::unique_ptr<std::istream> reminderDefaultFactory() {
-    return avsCommon::utils::stream::streamFromData(
-        data::med_system_alerts_melodic_01__TTH__mp3, sizeof(data::med_system_alerts_melodic_01__TTH__mp3));
+    return COMPILED_IN_SOUND(med_system_alerts_melodic_01__TTH__mp3);
 }
 static std::unique_ptr<std::istream> reminderShortFactory() {
-    return avsCommon::utils::stream::streamFromData(
-        data::med_system_alerts_melodic_01_short__TTH__wav, sizeof(data::med_system_alerts_melodic_01_short__TTH__wav));
+    return COMPILED_IN_SOUND(med_system_alerts_melodic_01_short__TTH__wav);
+}
+
+AlertsAudioFactory::AlertsAudioFactory(std::shared_ptr<AudioResourcePack> resourcePack) :
+        m_resourcePack{resourcePack} {
 }
 
 std::function<std::unique_ptr<std::istream>()> AlertsAudioFactory::alarmDefault() const {
-    return alarmDefaultFactory;
+    return AudioResourcePack::createStreamFactory(m_resourcePack, ALARM_DEFAULT_NAME, alarmDefaultFactory);
 }
 std::function<std::unique_ptr<std::istream>()> AlertsAudioFactory::alarmShort() const {
-    return alarmShortFactory;
+    return AudioResourcePack::createStreamFactory(m_resourcePack, ALARM_SHORT_NAME, alarmShortFactory);
 }
 
 std::function<std::unique_ptr<std::istream>()> AlertsAudioFactory::timerDefault() const {
-    return timerDefaultFactory;
+    return AudioResourcePack::createStreamFactory(m_resourcePack, TIMER_DEFAULT_NAME, timerDefaultFactory);
 }
 std::function<std::unique_ptr<std::istream>()> AlertsAudioFactory::timerShort() const {
-    return timerShortFactory;
+    return AudioResourcePack::createStreamFactory(m_resourcePack, TIMER_SHORT_NAME, timerShortFactory);
 }
 
 std::function<std::unique_ptr<std::istream>()> AlertsAudioFactory::reminderDefault() const {
-    return reminderDefaultFactory;
+    return AudioResourcePack::createStreamFactory(m_resourcePack, ALARM_DEFAULT_NAME, reminderDefaultFactory);
 }
 std::function<std::unique_ptr<std::istream>()> AlertsAudioFactory::reminderShort() const {
-    return reminderShortFactory;
+    return AudioResourcePack::createStreamFactory(m_resourcePack, ALARM_SHORT_NAME, reminderShortFactory);
 }
 
 }  // namespace audio
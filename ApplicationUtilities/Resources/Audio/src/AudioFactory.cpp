@@ -23,13 +23,16 @@ namespace applicationUtilities {
 namespace resources {
 namespace audio {
 
+AudioFactory::AudioFactory(std::shared_ptr<AudioResourcePack> resourcePack) : m_resourcePack{resourcePack} {
+}
+
 std::shared_ptr<avsCommon::sdkInterfaces::audio::AlertsAudioFactoryInterface> AudioFactory::alerts() const {
-    return std::make_shared<AlertsAudioFactory>();
+    return std::make_shared<AlertsAudioFactory>(m_resourcePack);
 }
 
 std::shared_ptr<avsCommon::sdkInterfaces::audio::NotificationsAudioFactoryInterface> AudioFactory::notifications()
     const {
-    return std::make_shared<NotificationsAudioFactory>();
+    return std::make_shared<NotificationsAudioFactory>(m_resourcePack);
 }
 
 }  // namespace audio
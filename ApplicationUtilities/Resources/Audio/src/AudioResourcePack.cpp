@@ -0,0 +1,231 @@
+/*
+ * Copyright 2017-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "Audio/AudioResourcePack.h"
+
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+#include <AVSCommon/Utils/Stream/Streambuf.h>
+
+namespace alexaClientSDK {
+namespace applicationUtilities {
+namespace resources {
+namespace audio {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("AudioResourcePack");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The magic bytes at the start of a pack.
+static const char MAGIC[] = {'A', 'C', 'S', 'D', 'K', 'A', 'R', 'P'};
+
+/// The version of the pack format this reader understands.
+static const uint32_t VERSION = 1;
+
+/**
+ * Reads little endian integers from the index of a pack, checking each read against the end of the file.
+ */
+class IndexReader {
+public:
+    IndexReader(const unsigned char* data, size_t size) : m_data{data}, m_size{size}, m_offset{0} {
+    }
+
+    bool read(void* out, size_t length) {
+        if (length > m_size - m_offset) {
+            return false;
+        }
+        memcpy(out, m_data + m_offset, length);
+        m_offset += length;
+        return true;
+    }
+
+    template <typename Integer>
+    bool readInteger(Integer* out) {
+        unsigned char bytes[sizeof(Integer)];
+        if (!read(bytes, sizeof(bytes))) {
+            return false;
+        }
+        *out = 0;
+        for (size_t i = sizeof(Integer); i > 0; --i) {
+            *out = (*out << 8) | bytes[i - 1];
+        }
+        return true;
+    }
+
+private:
+    const unsigned char* m_data;
+    size_t m_size;
+    size_t m_offset;
+};
+
+/**
+ * An istream over a resource in the pack, which keeps the pack (and so the mapping) alive.
+ */
+class PackStream : public std::istream {
+public:
+    PackStream(
+        std::shared_ptr<AudioResourcePack> pack,
+        std::unique_ptr<avsCommon::utils::stream::Streambuf> buf) :
+            std::istream(buf.get()),
+            m_pack{std::move(pack)},
+            m_buf{std::move(buf)} {
+    }
+
+private:
+    std::shared_ptr<AudioResourcePack> m_pack;
+    std::unique_ptr<avsCommon::utils::stream::Streambuf> m_buf;
+};
+
+std::shared_ptr<AudioResourcePack> AudioResourcePack::create(const std::string& path) {
+    struct stat status;
+    if (path.empty() || stat(path.c_str(), &status) != 0 || !S_ISREG(status.st_mode)) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "fileNotFound").d("path", path));
+        return nullptr;
+    }
+    return std::shared_ptr<AudioResourcePack>(new AudioResourcePack(path));
+}
+
+std::function<std::unique_ptr<std::istream>()> AudioResourcePack::createStreamFactory(
+    std::shared_ptr<AudioResourcePack> pack,
+    const std::string& name,
+    std::function<std::unique_ptr<std::istream>()> fallback) {
+    if (!pack) {
+        return fallback;
+    }
+    return [pack, name, fallback]() {
+        auto stream = pack->openStream(name);
+        if (stream) {
+            return stream;
+        }
+        ACSDK_DEBUG5(LX("usingFallback").d("name", name));
+        return fallback();
+    };
+}
+
+AudioResourcePack::AudioResourcePack(const std::string& path) :
+        m_path{path},
+        m_mapAttempted{false},
+        m_data{nullptr},
+        m_size{0} {
+}
+
+AudioResourcePack::~AudioResourcePack() {
+    if (m_data) {
+        munmap(const_cast<unsigned char*>(m_data), m_size);
+    }
+}
+
+std::unique_ptr<std::istream> AudioResourcePack::openStream(const std::string& name) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!mapLocked()) {
+        return nullptr;
+    }
+    auto it = m_resources.find(name);
+    if (it == m_resources.end()) {
+        ACSDK_DEBUG5(LX("openStreamFailed").d("reason", "resourceNotFound").d("name", name));
+        return nullptr;
+    }
+    std::unique_ptr<avsCommon::utils::stream::Streambuf> buf(
+        new avsCommon::utils::stream::Streambuf(m_data + it->second.offset, it->second.size, m_path + ":" + name));
+    return std::unique_ptr<std::istream>(new PackStream(shared_from_this(), std::move(buf)));
+}
+
+bool AudioResourcePack::mapLocked() {
+    if (m_mapAttempted) {
+        return m_data != nullptr;
+    }
+    m_mapAttempted = true;
+
+    int fd = open(m_path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        ACSDK_ERROR(LX("mapFailed").d("reason", "openFailed").d("path", m_path).d("errno", errno));
+        return false;
+    }
+    struct stat status;
+    if (fstat(fd, &status) != 0 || status.st_size <= 0) {
+        ACSDK_ERROR(LX("mapFailed").d("reason", "emptyFile").d("path", m_path));
+        close(fd);
+        return false;
+    }
+    auto size = static_cast<size_t>(status.st_size);
+    auto data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping stays valid once the descriptor is closed.
+    close(fd);
+    if (MAP_FAILED == data) {
+        ACSDK_ERROR(LX("mapFailed").d("reason", "mmapFailed").d("path", m_path).d("errno", errno));
+        return false;
+    }
+    m_data = static_cast<const unsigned char*>(data);
+    m_size = size;
+
+    if (!parseIndexLocked()) {
+        ACSDK_ERROR(LX("mapFailed").d("reason", "invalidIndex").d("path", m_path));
+        munmap(data, size);
+        m_data = nullptr;
+        m_size = 0;
+        m_resources.clear();
+        return false;
+    }
+    ACSDK_INFO(LX("mapped").d("path", m_path).d("size", m_size).d("resources", m_resources.size()));
+    return true;
+}
+
+bool AudioResourcePack::parseIndexLocked() {
+    IndexReader reader(m_data, m_size);
+
+    char magic[sizeof(MAGIC)];
+    uint32_t version = 0;
+    uint32_t count = 0;
+    if (!reader.read(magic, sizeof(magic)) || memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        !reader.readInteger(&version) || version != VERSION || !reader.readInteger(&count)) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t nameLength = 0;
+        if (!reader.readInteger(&nameLength) || nameLength > m_size) {
+            return false;
+        }
+        std::string name(nameLength, '\0');
+        uint64_t offset = 0;
+        uint64_t size = 0;
+        if (!reader.read(&name[0], nameLength) || !reader.readInteger(&offset) || !reader.readInteger(&size)) {
+            return false;
+        }
+        if (offset > m_size || size > m_size - offset) {
+            ACSDK_ERROR(LX("parseIndexFailed").d("reason", "resourceOutOfBounds").d("name", name));
+            return false;
+        }
+        m_resources[name] = {static_cast<size_t>(offset), static_cast<size_t>(size)};
+    }
+    return true;
+}
+
+}  // namespace audio
+}  // namespace resources
+}  // namespace applicationUtilities
+}  // namespace alexaClientSDK
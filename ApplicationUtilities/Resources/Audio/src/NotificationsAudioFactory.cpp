@@ -17,20 +17,37 @@
 
 #include <AVSCommon/Utils/Stream/StreamFunctions.h>
 
+#ifdef COMPILED_IN_AUDIO_RESOURCES
 #include "Audio/Data/med_alerts_notification_01._TTH_.mp3.h"
+#endif
 
 namespace alexaClientSDK {
 namespace applicationUtilities {
 namespace resources {
 namespace audio {
 
+/// The name of the default notification sound in a resource pack.
+static const std::string NOTIFICATION_DEFAULT_NAME = "med_alerts_notification_01._TTH_.mp3";
+
 static std::unique_ptr<std::istream> notificationDefaultFactory() {
+#ifdef COMPILED_IN_AUDIO_RESOURCES
     return avsCommon::utils::stream::streamFromData(
-        data::med_alerts_notification_01__TTH__mp3, sizeof(data::med_alerts_notification_01__TTH__mp3));
+        data::med_alerts_notification_01__TTH__mp3,
+        sizeof(data::med_alerts_notification_01__TTH__mp3),
+        "med_alerts_notification_01__TTH__mp3");
+#else
+    // The compiled-in sound is left out of this build, so it is only available from a resource pack.
+    return nullptr;
+#endif
+}
+
+NotificationsAudioFactory::NotificationsAudioFactory(std::shared_ptr<AudioResourcePack> resourcePack) :
+        m_resourcePack{resourcePack} {
 }
 
 std::function<std::unique_ptr<std::istream>()> NotificationsAudioFactory::notificationDefault() const {
-    return notificationDefaultFactory;
+    return AudioResourcePack::createStreamFactory(
+        m_resourcePack, NOTIFICATION_DEFAULT_NAME, notificationDefaultFactory);
 }
 
 }  // namespace audio
@@ -0,0 +1,192 @@
+/*
+ * Copyright 2017-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Audio/AlertsAudioFactory.h"
+#include "Audio/AudioResourcePack.h"
+
+namespace alexaClientSDK {
+namespace applicationUtilities {
+namespace resources {
+namespace audio {
+namespace test {
+
+/// The path of the pack file written by the tests.
+static const std::string TEST_PACK_FILE_PATH = "audioResourcePackTest.pack";
+
+/// The name of the default alarm sound in a pack.
+static const std::string ALARM_DEFAULT_NAME = "med_system_alerts_melodic_01._TTH_.mp3";
+
+/// Append a little endian integer to @c out.
+template <typename Integer>
+static void appendInteger(std::string* out, Integer value) {
+    for (size_t i = 0; i < sizeof(Integer); ++i) {
+        out->push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+    }
+}
+
+/**
+ * Build the bytes of a pack holding @c resources.
+ *
+ * @param resources The name and data of each resource.
+ * @return The pack.
+ */
+static std::string buildPack(const std::vector<std::pair<std::string, std::string>>& resources) {
+    std::string index("ACSDKARP");
+    appendInteger<uint32_t>(&index, 1);
+    appendInteger<uint32_t>(&index, resources.size());
+
+    size_t indexSize = index.size();
+    for (auto& resource : resources) {
+        indexSize += sizeof(uint32_t) + resource.first.size() + 2 * sizeof(uint64_t);
+    }
+
+    std::string data;
+    for (auto& resource : resources) {
+        appendInteger<uint32_t>(&index, resource.first.size());
+        index += resource.first;
+        appendInteger<uint64_t>(&index, indexSize + data.size());
+        appendInteger<uint64_t>(&index, resource.second.size());
+        data += resource.second;
+    }
+    return index + data;
+}
+
+/// Read all of a stream into a string.
+static std::string readAll(std::istream& stream) {
+    std::ostringstream oss;
+    oss << stream.rdbuf();
+    return oss.str();
+}
+
+class AudioResourcePackTest : public ::testing::Test {
+public:
+    void TearDown() override {
+        std::remove(TEST_PACK_FILE_PATH.c_str());
+    }
+
+    /// Write @c contents to the test pack file and create a pack for it.
+    std::shared_ptr<AudioResourcePack> createPack(const std::string& contents) {
+        std::ofstream file(TEST_PACK_FILE_PATH, std::ios::binary | std::ios::trunc);
+        file.write(contents.data(), contents.size());
+        file.close();
+        return AudioResourcePack::create(TEST_PACK_FILE_PATH);
+    }
+};
+
+/**
+ * Test that creating a pack for a file which doesn't exist fails.
+ */
+TEST_F(AudioResourcePackTest, testCreateWithMissingFile) {
+    EXPECT_EQ(AudioResourcePack::create(""), nullptr);
+    EXPECT_EQ(AudioResourcePack::create(TEST_PACK_FILE_PATH), nullptr);
+}
+
+/**
+ * Test that each resource in a pack can be read, and that resources which aren't in the pack can't.
+ */
+TEST_F(AudioResourcePackTest, testOpenStream) {
+    std::string binary("\x00\x01\xff\x7f", 4);
+    auto pack = createPack(buildPack({{"first", "FIRST_DATA"}, {"second", binary}, {"empty", ""}}));
+    ASSERT_NE(pack, nullptr);
+
+    auto first = pack->openStream("first");
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(readAll(*first), "FIRST_DATA");
+
+    auto second = pack->openStream("second");
+    ASSERT_NE(second, nullptr);
+    EXPECT_EQ(readAll(*second), binary);
+
+    // Streams are seekable, so they can be replayed.
+    second->clear();
+    second->seekg(2);
+    EXPECT_EQ(readAll(*second), binary.substr(2));
+
+    auto empty = pack->openStream("empty");
+    ASSERT_NE(empty, nullptr);
+    EXPECT_EQ(readAll(*empty), "");
+
+    EXPECT_EQ(pack->openStream("missing"), nullptr);
+}
+
+/**
+ * Test that a stream stays readable after the last other reference to its pack is released.
+ */
+TEST_F(AudioResourcePackTest, testStreamKeepsPackAlive) {
+    auto pack = createPack(buildPack({{"first", "FIRST_DATA"}}));
+    ASSERT_NE(pack, nullptr);
+    auto stream = pack->openStream("first");
+    ASSERT_NE(stream, nullptr);
+    pack.reset();
+    EXPECT_EQ(readAll(*stream), "FIRST_DATA");
+}
+
+/**
+ * Test that packs with a bad header or a resource outside the file are rejected.
+ */
+TEST_F(AudioResourcePackTest, testInvalidPacksAreRejected) {
+    auto valid = buildPack({{"first", "FIRST_DATA"}});
+
+    auto badMagic = valid;
+    badMagic[0] = 'X';
+    auto pack = createPack(badMagic);
+    ASSERT_NE(pack, nullptr);
+    EXPECT_EQ(pack->openStream("first"), nullptr);
+
+    auto truncated = valid.substr(0, valid.size() - 1);
+    pack = createPack(truncated);
+    ASSERT_NE(pack, nullptr);
+    EXPECT_EQ(pack->openStream("first"), nullptr);
+
+    auto truncatedIndex = valid.substr(0, 20);
+    pack = createPack(truncatedIndex);
+    ASSERT_NE(pack, nullptr);
+    EXPECT_EQ(pack->openStream("first"), nullptr);
+}
+
+/**
+ * Test that the alerts factory reads sounds from a pack when it holds them, and otherwise falls back to the
+ * compiled-in sounds.
+ */
+TEST_F(AudioResourcePackTest, testAlertsFactoryPrefersPack) {
+    auto pack = createPack(buildPack({{ALARM_DEFAULT_NAME, "PACKED_ALARM"}}));
+    ASSERT_NE(pack, nullptr);
+    AlertsAudioFactory factory(pack);
+
+    auto alarm = factory.alarmDefault()();
+    ASSERT_NE(alarm, nullptr);
+    EXPECT_EQ(readAll(*alarm), "PACKED_ALARM");
+
+#ifdef COMPILED_IN_AUDIO_RESOURCES
+    auto timer = factory.timerDefault()();
+    ASSERT_NE(timer, nullptr);
+    EXPECT_FALSE(readAll(*timer).empty());
+#endif
+}
+
+}  // namespace test
+}  // namespace audio
+}  // namespace resources
+}  // namespace applicationUtilities
+}  // namespace alexaClientSDK
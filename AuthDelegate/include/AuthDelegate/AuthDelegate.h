@@ -29,6 +29,8 @@
 #include <AVSCommon/Utils/LibcurlUtils/HttpPostInterface.h>
 #include <AVSCommon/Utils/RetryTimer.h>
 
+#include "AuthDelegate/AuthTokenStorageInterface.h"
+
 namespace alexaClientSDK {
 namespace authDelegate {
 
@@ -36,11 +38,16 @@ namespace authDelegate {
  * AuthDelegate provides an implementation of the AuthDelegateInterface. It takes a configuration that
  * specifies LWA 'client ID', 'client Secret', and 'refresh token' values and uses those to keep a
  * valid authorization token available.
+ *
+ * If given an @c AuthTokenStorageInterface, the current access token is stored along with its expiration time.  A stored
+ * token which is still valid at startup is used straight away, so that a connection to AVS need not wait for a token
+ * refresh, and it is refreshed in the background.
  */
 class AuthDelegate : public avsCommon::sdkInterfaces::AuthDelegateInterface {
 public:
     /**
-     * Create an AuthDelegate.
+     * Create an AuthDelegate.  The access token is stored in an @c SQLiteAuthTokenStorage if a @c databaseFilePath is
+     * configured for it.
      * This function cannot be called if:
      * <ul>
      * <li>AlexaClientSDKInit::initalize has not been called yet.</li>
@@ -61,10 +68,12 @@ public:
      *
      * @param httpPost Instance that implement HttpPostInterface. Must not be @c nullptr. The behavior for passing in
      *     @c nullptr is undefined.
+     * @param authTokenStorage Where to store the access token across restarts, or @c nullptr to not store it.
      * @return If successful, returns a new AuthDelegate, otherwise @c nullptr.
      */
     static std::unique_ptr<AuthDelegate> create(
-        std::unique_ptr<avsCommon::utils::libcurlUtils::HttpPostInterface> httpPost);
+        std::unique_ptr<avsCommon::utils::libcurlUtils::HttpPostInterface> httpPost,
+        std::shared_ptr<AuthTokenStorageInterface> authTokenStorage = nullptr);
 
     /**
      * Deleted copy constructor
@@ -94,8 +103,11 @@ private:
      * AuthDelegate constructor.
      *
      * @param httpPost Instance that implement HttpPostInterface. Must not be @c nullptr, or the behavior is undefined.
+     * @param authTokenStorage Where to store the access token across restarts, or @c nullptr to not store it.
      */
-    AuthDelegate(std::unique_ptr<avsCommon::utils::libcurlUtils::HttpPostInterface> httpPost);
+    AuthDelegate(
+        std::unique_ptr<avsCommon::utils::libcurlUtils::HttpPostInterface> httpPost,
+        std::shared_ptr<AuthTokenStorageInterface> authTokenStorage);
 
     /**
      * init() is used by create() to perform initialization after construction but before returning the
@@ -105,6 +117,17 @@ private:
      */
     bool init();
 
+    /**
+     * Open @c m_authTokenStorage and use the access token stored in it if it was obtained with the configured
+     * credentials and is still valid.  Called by @c init() before @c m_refreshAndNotifyThread is started.
+     */
+    void loadStoredAuthToken();
+
+    /**
+     * Store the current access token in @c m_authTokenStorage, if there is one.
+     */
+    void storeAuthToken();
+
     /// Method run in its own thread to refresh the auth token and notify for auth state changes.
     void refreshAndNotifyThreadFunction();
 
@@ -228,6 +251,15 @@ private:
      * Access is not synchronized because it is only accessed by @c m_refreshAndNotifyThread.
      */
     std::unique_ptr<avsCommon::utils::libcurlUtils::HttpPostInterface> m_HttpPost;
+
+    /**
+     * Where to store the access token across restarts, or @c nullptr.
+     * Access is not synchronized because it is only accessed by @c init() and @c m_refreshAndNotifyThread.
+     */
+    std::shared_ptr<AuthTokenStorageInterface> m_authTokenStorage;
+
+    /// Identifies the configured credentials in @c m_authTokenStorage.
+    std::string m_credentialsId;
 };
 
 }  // namespace authDelegate
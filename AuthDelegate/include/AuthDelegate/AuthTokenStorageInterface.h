@@ -0,0 +1,103 @@
+/*
+ * Copyright 2017-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AUTHDELEGATE_INCLUDE_AUTHDELEGATE_AUTHTOKENSTORAGEINTERFACE_H_
+#define ALEXA_CLIENT_SDK_AUTHDELEGATE_INCLUDE_AUTHDELEGATE_AUTHTOKENSTORAGEINTERFACE_H_
+
+#include <chrono>
+#include <string>
+
+namespace alexaClientSDK {
+namespace authDelegate {
+
+/**
+ * An interface for storing the most recent LWA access token across restarts, so that @c AuthDelegate can use it while
+ * it is still valid instead of waiting for a token refresh before the first connection.
+ *
+ * The token grants access to AVS on behalf of the user, so implementations should keep it somewhere only the client
+ * can read, as for the refresh token in the configuration.
+ *
+ * This interface does not provide any thread-safety guarantees.
+ */
+class AuthTokenStorageInterface {
+public:
+    /**
+     * Destructor.
+     */
+    virtual ~AuthTokenStorageInterface() = default;
+
+    /**
+     * Creates a new database.
+     * If a database is already being handled by this object or there is an error creating it, this function returns
+     * false.
+     *
+     * @return @c true If the database is created ok, or @c false if a database is already being handled by this object
+     * or there is an internal error creating the database.
+     */
+    virtual bool createDatabase() = 0;
+
+    /**
+     * Open an existing database.  If this object is already managing an open database, or there is a problem opening
+     * the database, this function returns false.
+     *
+     * @return @c true If the database is opened ok, @c false if this object is already managing an open database, or if
+     * there is another internal reason the database could not be opened.
+     */
+    virtual bool open() = 0;
+
+    /**
+     * Close the currently open database, if one is open.
+     */
+    virtual void close() = 0;
+
+    /**
+     * Store an access token, replacing any stored before.
+     *
+     * @param credentialsId Identifies the credentials the token was obtained with, so that a token is not used with
+     * other credentials.
+     * @param authToken The access token.
+     * @param expirationTime When the access token expires.
+     * @return Whether the token was successfully stored.
+     */
+    virtual bool store(
+        const std::string& credentialsId,
+        const std::string& authToken,
+        std::chrono::system_clock::time_point expirationTime) = 0;
+
+    /**
+     * Load the stored access token.
+     *
+     * @param[out] credentialsId The @c credentialsId the token was stored with.
+     * @param[out] authToken The access token, or an empty string if none is stored.
+     * @param[out] expirationTime When the access token expires.
+     * @return Whether the database could be read.
+     */
+    virtual bool load(
+        std::string* credentialsId,
+        std::string* authToken,
+        std::chrono::system_clock::time_point* expirationTime) = 0;
+
+    /**
+     * Erase the stored access token.
+     *
+     * @return Whether the database was successfully cleared.
+     */
+    virtual bool clearDatabase() = 0;
+};
+
+}  // namespace authDelegate
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AUTHDELEGATE_INCLUDE_AUTHDELEGATE_AUTHTOKENSTORAGEINTERFACE_H_
@@ -0,0 +1,95 @@
+/*
+ * Copyright 2017-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_AUTHDELEGATE_INCLUDE_AUTHDELEGATE_SQLITEAUTHTOKENSTORAGE_H_
+#define ALEXA_CLIENT_SDK_AUTHDELEGATE_INCLUDE_AUTHDELEGATE_SQLITEAUTHTOKENSTORAGE_H_
+
+#include <memory>
+#include <string>
+
+#include <AVSCommon/Utils/Configuration/ConfigurationNode.h>
+#include <SQLiteStorage/SQLiteDatabase.h>
+
+#include "AuthDelegate/AuthTokenStorageInterface.h"
+
+namespace alexaClientSDK {
+namespace authDelegate {
+
+/**
+ * An implementation that allows us to store the access token using SQLite.
+ *
+ * The database file is made readable and writable by its owner only (mode 0600) when it is created, and again
+ * whenever it is opened.  The directory holding it should not be writable by other users, since they could otherwise
+ * replace the file.
+ *
+ * This class is not thread-safe.
+ */
+class SQLiteAuthTokenStorage : public AuthTokenStorageInterface {
+public:
+    /**
+     * Factory method for creating a storage object for the access token based on an SQLite database.
+     *
+     * @param configurationRoot The global config object.
+     * @return Pointer to the SQLiteAuthTokenStorage object, nullptr if there's an error creating it.
+     */
+    static std::unique_ptr<SQLiteAuthTokenStorage> create(
+        const avsCommon::utils::configuration::ConfigurationNode& configurationRoot);
+
+    /**
+     * Constructor.
+     *
+     * @param databaseFilePath The location of the SQLite database file.
+     */
+    SQLiteAuthTokenStorage(const std::string& databaseFilePath);
+
+    ~SQLiteAuthTokenStorage();
+
+    bool createDatabase() override;
+
+    bool open() override;
+
+    void close() override;
+
+    bool store(
+        const std::string& credentialsId,
+        const std::string& authToken,
+        std::chrono::system_clock::time_point expirationTime) override;
+
+    bool load(
+        std::string* credentialsId,
+        std::string* authToken,
+        std::chrono::system_clock::time_point* expirationTime) override;
+
+    bool clearDatabase() override;
+
+private:
+    /**
+     * Restrict the permissions of the database file to its owner.
+     *
+     * @return Whether the permissions were set.
+     */
+    bool restrictPermissions();
+
+    /// The location of the SQLite database file.
+    const std::string m_databaseFilePath;
+
+    /// The underlying database class.
+    alexaClientSDK::storage::sqliteStorage::SQLiteDatabase m_database;
+};
+
+}  // namespace authDelegate
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_AUTHDELEGATE_INCLUDE_AUTHDELEGATE_SQLITEAUTHTOKENSTORAGE_H_
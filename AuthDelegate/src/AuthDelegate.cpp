@@ -28,6 +28,7 @@
 #include <AVSCommon/Utils/Logger/Logger.h>
 
 #include "AuthDelegate/AuthDelegate.h"
+#include "AuthDelegate/SQLiteAuthTokenStorage.h"
 
 namespace alexaClientSDK {
 namespace authDelegate {
@@ -74,6 +75,12 @@ static const std::chrono::minutes DEFAULT_REQUEST_TIMEOUT = std::chrono::minutes
 /// Default value for authTokenRefreshHeadStart.
 static const std::chrono::minutes DEFAULT_AUTH_TOKEN_REFRESH_HEAD_START = std::chrono::minutes(10);
 
+/**
+ * The least time a stored access token must still be valid for to be used at startup.  A token which is about to
+ * expire is of little use for connecting, and would soon be reported as expired.
+ */
+static const std::chrono::minutes MIN_STORED_AUTH_TOKEN_LIFETIME = std::chrono::minutes(1);
+
 /// POST data before 'client_id' that is sent to LWA to refresh the auth token.
 static const std::string POST_DATA_UP_TO_CLIENT_ID = "grant_type=refresh_token&client_id=";
 
@@ -166,6 +173,25 @@ static AuthObserverInterface::Error getErrorCode(const std::string& error) {
     }
 }
 
+/**
+ * Helper function that derives an identifier of the credentials an access token is obtained with, so that a stored
+ * token is not used after the credentials are changed.  The credentials themselves are not stored.
+ *
+ * @param clientId The client ID.
+ * @param refreshToken The refresh token from the configuration.
+ * @return The identifier, a 64 bit FNV-1a hash of the credentials in hexadecimal.
+ */
+static std::string getCredentialsId(const std::string& clientId, const std::string& refreshToken) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (char c : clientId + '\n' + refreshToken) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+    std::ostringstream id;
+    id << std::hex << hash;
+    return id.str();
+}
+
 /**
  * Function to convert the number of times we have already retried to the time to perform the next retry.
  *
@@ -195,29 +221,35 @@ static std::chrono::steady_clock::time_point calculateTimeToRetry(int retryCount
 }
 
 std::unique_ptr<AuthDelegate> AuthDelegate::create() {
-    return AuthDelegate::create(avsCommon::utils::libcurlUtils::HttpPost::create());
+    return AuthDelegate::create(
+        avsCommon::utils::libcurlUtils::HttpPost::create(),
+        SQLiteAuthTokenStorage::create(avsCommon::utils::configuration::ConfigurationNode::getRoot()));
 }
 
 std::unique_ptr<AuthDelegate> AuthDelegate::create(
-    std::unique_ptr<avsCommon::utils::libcurlUtils::HttpPostInterface> httpPost) {
+    std::unique_ptr<avsCommon::utils::libcurlUtils::HttpPostInterface> httpPost,
+    std::shared_ptr<AuthTokenStorageInterface> authTokenStorage) {
     if (!avsCommon::avs::initialization::AlexaClientSDKInit::isInitialized()) {
         ACSDK_ERROR(LX("createFailed").d("reason", "sdkNotInitialized"));
         return nullptr;
     }
-    std::unique_ptr<AuthDelegate> instance(new AuthDelegate(std::move(httpPost)));
+    std::unique_ptr<AuthDelegate> instance(new AuthDelegate(std::move(httpPost), authTokenStorage));
     if (instance->init()) {
         return instance;
     }
     return nullptr;
 }
 
-AuthDelegate::AuthDelegate(std::unique_ptr<avsCommon::utils::libcurlUtils::HttpPostInterface> httpPost) :
+AuthDelegate::AuthDelegate(
+    std::unique_ptr<avsCommon::utils::libcurlUtils::HttpPostInterface> httpPost,
+    std::shared_ptr<AuthTokenStorageInterface> authTokenStorage) :
         m_authState{AuthObserverInterface::State::UNINITIALIZED},
         m_authError{AuthObserverInterface::Error::SUCCESS},
         m_isStopping{false},
         m_expirationTime{std::chrono::time_point<std::chrono::steady_clock>::max()},
         m_retryCount{0},
-        m_HttpPost{std::move(httpPost)} {
+        m_HttpPost{std::move(httpPost)},
+        m_authTokenStorage{authTokenStorage} {
 }
 
 AuthDelegate::~AuthDelegate() {
@@ -292,10 +324,69 @@ bool AuthDelegate::init() {
         return false;
     }
 
+    m_credentialsId = getCredentialsId(m_clientId, m_refreshToken);
+    loadStoredAuthToken();
+
     m_refreshAndNotifyThread = std::thread(&AuthDelegate::refreshAndNotifyThreadFunction, this);
     return true;
 }
 
+void AuthDelegate::loadStoredAuthToken() {
+    if (!m_authTokenStorage) {
+        return;
+    }
+
+    if (!m_authTokenStorage->open()) {
+        ACSDK_INFO(LX("loadStoredAuthToken : Database file does not exist.  Creating."));
+        if (!m_authTokenStorage->createDatabase()) {
+            ACSDK_ERROR(LX("loadStoredAuthTokenFailed").m("Could not create database file."));
+            m_authTokenStorage.reset();
+        }
+        return;
+    }
+
+    std::string credentialsId;
+    std::string authToken;
+    std::chrono::system_clock::time_point expirationTime;
+    if (!m_authTokenStorage->load(&credentialsId, &authToken, &expirationTime)) {
+        ACSDK_ERROR(LX("loadStoredAuthTokenFailed").m("Could not load the access token."));
+        return;
+    }
+    if (authToken.empty()) {
+        return;
+    }
+    if (credentialsId != m_credentialsId) {
+        ACSDK_INFO(LX("storedAuthTokenDiscarded").d("reason", "credentialsChanged"));
+        m_authTokenStorage->clearDatabase();
+        return;
+    }
+    auto timeLeft = expirationTime - std::chrono::system_clock::now();
+    if (timeLeft < MIN_STORED_AUTH_TOKEN_LIFETIME) {
+        ACSDK_INFO(LX("storedAuthTokenDiscarded").d("reason", "expired"));
+        return;
+    }
+
+    ACSDK_INFO(LX("usingStoredAuthToken")
+                   .d("expiresInSeconds", std::chrono::duration_cast<std::chrono::seconds>(timeLeft).count()));
+    m_authToken = authToken;
+    m_expirationTime =
+        std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeLeft);
+    m_authState = AuthObserverInterface::State::REFRESHED;
+    // m_timeToRefresh is left at its initial value, so the token is refreshed in the background straight away.
+}
+
+void AuthDelegate::storeAuthToken() {
+    if (!m_authTokenStorage) {
+        return;
+    }
+    auto expirationTime =
+        std::chrono::system_clock::now() + std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                                               m_expirationTime - std::chrono::steady_clock::now());
+    if (!m_authTokenStorage->store(m_credentialsId, m_authToken, expirationTime)) {
+        ACSDK_ERROR(LX("storeAuthTokenFailed").m("Could not store the access token."));
+    }
+}
+
 void AuthDelegate::refreshAndNotifyThreadFunction() {
     std::function<bool()> isStopping = [this] { return m_isStopping; };
 
@@ -406,6 +497,7 @@ AuthObserverInterface::Error AuthDelegate::handleLwaResponse(long code, const st
             std::lock_guard<std::mutex> lock(m_mutex);
             m_authToken = authToken;
         }
+        storeAuthToken();
         return AuthObserverInterface::Error::SUCCESS;
 
     } else {
@@ -436,6 +528,10 @@ void AuthDelegate::setState(AuthObserverInterface::State newState) {
         ACSDK_ERROR(LX("threadStopping").d("reason", "encounteredUnrecoverableError"));
         newState = AuthObserverInterface::State::UNRECOVERABLE_ERROR;
         m_isStopping = true;
+        // The credentials are no longer accepted, so neither should a token obtained with them be.
+        if (m_authTokenStorage) {
+            m_authTokenStorage->clearDatabase();
+        }
     }
 
     if (m_authState != newState) {
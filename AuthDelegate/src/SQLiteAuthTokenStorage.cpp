@@ -0,0 +1,240 @@
+/*
+ * Copyright 2017-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "AuthDelegate/SQLiteAuthTokenStorage.h"
+
+#include <cerrno>
+
+#include <sys/stat.h>
+
+#include <SQLiteStorage/SQLiteStatement.h>
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+namespace alexaClientSDK {
+namespace authDelegate {
+
+using namespace alexaClientSDK::storage::sqliteStorage;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("SQLiteAuthTokenStorage");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The key in our config file to find the root of settings for AuthDelegate.
+static const std::string AUTH_DELEGATE_CONFIGURATION_ROOT_KEY = "authDelegate";
+/// The key in our config file to find the database file path.
+static const std::string AUTH_DELEGATE_DB_FILE_PATH_KEY = "databaseFilePath";
+
+/// The name of the access token table.
+static const std::string AUTH_TOKEN_TABLE_NAME = "authToken";
+/// The name of the 'id' field we will use as the primary key in our table.
+static const std::string DATABASE_COLUMN_ID_NAME = "id";
+/// The name of the field identifying the credentials the token was obtained with.
+static const std::string DATABASE_COLUMN_CREDENTIALS_ID_NAME = "credentials_id";
+/// The name of the access token field.
+static const std::string DATABASE_COLUMN_AUTH_TOKEN_NAME = "auth_token";
+/// The name of the field holding the expiration time, in seconds since the epoch.
+static const std::string DATABASE_COLUMN_EXPIRATION_NAME = "expiration";
+/// The permissions of the database file: readable and writable by its owner only.
+static const mode_t DATABASE_FILE_MODE = S_IRUSR | S_IWUSR;
+/// The id of the only row of the table.
+static const int AUTH_TOKEN_ROW_ID = 1;
+/// The SQL string to create the access token table.
+static const std::string CREATE_AUTH_TOKEN_TABLE_SQL_STRING =
+    std::string("CREATE TABLE ") + AUTH_TOKEN_TABLE_NAME + " (" + DATABASE_COLUMN_ID_NAME + " INT PRIMARY KEY NOT NULL," +
+    DATABASE_COLUMN_CREDENTIALS_ID_NAME + " TEXT NOT NULL," + DATABASE_COLUMN_AUTH_TOKEN_NAME + " TEXT NOT NULL," +
+    DATABASE_COLUMN_EXPIRATION_NAME + " INT NOT NULL);";
+
+std::unique_ptr<SQLiteAuthTokenStorage> SQLiteAuthTokenStorage::create(
+    const avsCommon::utils::configuration::ConfigurationNode& configurationRoot) {
+    auto authDelegateConfigurationRoot = configurationRoot[AUTH_DELEGATE_CONFIGURATION_ROOT_KEY];
+    if (!authDelegateConfigurationRoot) {
+        ACSDK_ERROR(LX("createFailed")
+                        .d("reason", "Could not load config for the access token database")
+                        .d("key", AUTH_DELEGATE_CONFIGURATION_ROOT_KEY));
+        return nullptr;
+    }
+
+    std::string authTokenDatabaseFilePath;
+    if (!authDelegateConfigurationRoot.getString(AUTH_DELEGATE_DB_FILE_PATH_KEY, &authTokenDatabaseFilePath) ||
+        authTokenDatabaseFilePath.empty()) {
+        ACSDK_INFO(LX("createFailed").d("reason", "Could not load config value").d("key", AUTH_DELEGATE_DB_FILE_PATH_KEY));
+        return nullptr;
+    }
+
+    return std::unique_ptr<SQLiteAuthTokenStorage>(new SQLiteAuthTokenStorage(authTokenDatabaseFilePath));
+}
+
+SQLiteAuthTokenStorage::SQLiteAuthTokenStorage(const std::string& databaseFilePath) :
+        m_databaseFilePath{databaseFilePath},
+        m_database{databaseFilePath} {
+}
+
+SQLiteAuthTokenStorage::~SQLiteAuthTokenStorage() {
+    close();
+}
+
+bool SQLiteAuthTokenStorage::createDatabase() {
+    if (!m_database.initialize()) {
+        ACSDK_ERROR(LX("createDatabaseFailed"));
+        return false;
+    }
+
+    // The file is still empty here.  Restrict it before the token is written; SQLite creates its journal files with
+    // the same permissions as the database file.
+    if (!restrictPermissions()) {
+        ACSDK_ERROR(LX("createDatabaseFailed").m("Database file permissions could not be restricted."));
+        close();
+        return false;
+    }
+
+    if (!m_database.performQuery(CREATE_AUTH_TOKEN_TABLE_SQL_STRING)) {
+        ACSDK_ERROR(LX("createDatabaseFailed").m("Table could not be created."));
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+bool SQLiteAuthTokenStorage::open() {
+    if (!m_database.open()) {
+        return false;
+    }
+
+    // A database created by an earlier version may be readable by other users.
+    if (!restrictPermissions()) {
+        ACSDK_WARN(LX("openWarning").m("Database file permissions could not be restricted."));
+    }
+
+    return true;
+}
+
+void SQLiteAuthTokenStorage::close() {
+    m_database.close();
+}
+
+bool SQLiteAuthTokenStorage::store(
+    const std::string& credentialsId,
+    const std::string& authToken,
+    std::chrono::system_clock::time_point expirationTime) {
+    std::string sqlString = "INSERT OR REPLACE INTO " + AUTH_TOKEN_TABLE_NAME + " (" + DATABASE_COLUMN_ID_NAME + ", " +
+                            DATABASE_COLUMN_CREDENTIALS_ID_NAME + ", " + DATABASE_COLUMN_AUTH_TOKEN_NAME + ", " +
+                            DATABASE_COLUMN_EXPIRATION_NAME + ") VALUES (?, ?, ?, ?);";
+
+    auto statement = m_database.createStatement(sqlString);
+
+    if (!statement) {
+        ACSDK_ERROR(LX("storeFailed").m("Could not create statement."));
+        return false;
+    }
+
+    auto expiration = std::chrono::duration_cast<std::chrono::seconds>(expirationTime.time_since_epoch()).count();
+    int boundParam = 1;
+    if (!statement->bindIntParameter(boundParam++, AUTH_TOKEN_ROW_ID) ||
+        !statement->bindStringParameter(boundParam++, credentialsId) ||
+        !statement->bindStringParameter(boundParam++, authToken) ||
+        !statement->bindInt64Parameter(boundParam, expiration)) {
+        ACSDK_ERROR(LX("storeFailed").m("Could not bind parameter."));
+        return false;
+    }
+
+    if (!statement->step()) {
+        ACSDK_ERROR(LX("storeFailed").m("Could not perform step."));
+        return false;
+    }
+
+    return true;
+}
+
+bool SQLiteAuthTokenStorage::load(
+    std::string* credentialsId,
+    std::string* authToken,
+    std::chrono::system_clock::time_point* expirationTime) {
+    if (!credentialsId || !authToken || !expirationTime) {
+        ACSDK_ERROR(LX("loadFailed").m("An output parameter is nullptr."));
+        return false;
+    }
+
+    std::string sqlString = "SELECT * FROM " + AUTH_TOKEN_TABLE_NAME + " WHERE id=?;";
+
+    auto statement = m_database.createStatement(sqlString);
+
+    if (!statement) {
+        ACSDK_ERROR(LX("loadFailed").m("Could not create statement."));
+        return false;
+    }
+
+    if (!statement->bindIntParameter(1, AUTH_TOKEN_ROW_ID)) {
+        ACSDK_ERROR(LX("loadFailed").m("Could not bind id."));
+        return false;
+    }
+
+    if (!statement->step()) {
+        ACSDK_ERROR(LX("loadFailed").m("Could not perform step."));
+        return false;
+    }
+
+    credentialsId->clear();
+    authToken->clear();
+    *expirationTime = std::chrono::system_clock::time_point();
+
+    if (SQLITE_ROW == statement->getStepResult()) {
+        int numberColumns = statement->getColumnCount();
+
+        // SQLite cannot guarantee the order of the columns in a given row, so this logic is required.
+        for (int i = 0; i < numberColumns; i++) {
+            std::string columnName = statement->getColumnName(i);
+
+            if (DATABASE_COLUMN_CREDENTIALS_ID_NAME == columnName) {
+                *credentialsId = statement->getColumnText(i);
+            } else if (DATABASE_COLUMN_AUTH_TOKEN_NAME == columnName) {
+                *authToken = statement->getColumnText(i);
+            } else if (DATABASE_COLUMN_EXPIRATION_NAME == columnName) {
+                *expirationTime = std::chrono::system_clock::time_point(
+                    std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                        std::chrono::seconds(statement->getColumnInt64(i))));
+            }
+        }
+    }
+
+    return true;
+}
+
+bool SQLiteAuthTokenStorage::clearDatabase() {
+    if (!m_database.clearTable(AUTH_TOKEN_TABLE_NAME)) {
+        ACSDK_ERROR(LX("clearDatabaseFailed").m("could not clear authToken table."));
+        return false;
+    }
+
+    return true;
+}
+
+bool SQLiteAuthTokenStorage::restrictPermissions() {
+    if (chmod(m_databaseFilePath.c_str(), DATABASE_FILE_MODE) != 0) {
+        ACSDK_ERROR(LX("restrictPermissionsFailed").d("file path", m_databaseFilePath).d("errno", errno));
+        return false;
+    }
+    return true;
+}
+
+}  // namespace authDelegate
+}  // namespace alexaClientSDK
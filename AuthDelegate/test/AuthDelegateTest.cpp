@@ -23,6 +23,7 @@
 #include <gtest/gtest.h>
 
 #include "AuthDelegate/AuthDelegate.h"
+#include "AuthDelegate/MockAuthTokenStorage.h"
 #include "AuthDelegate/MockHttpPost.h"
 #include "AVSCommon/AVS/Initialization/AlexaClientSDKInit.h"
 #include "AVSCommon/Utils/LibcurlUtils/HttpResponseCodes.h"
@@ -51,6 +52,12 @@ static const auto TIME_OUT_IN_SECONDS = std::chrono::seconds(60);
  */
 static const std::string ERROR_CODE_INVALID_REQUEST = "invalid_request";
 
+/// The access token in the responses generated by @c generateValidLwaResponseWithExpiration.
+static const std::string LWA_AUTH_TOKEN = "Atza|IQEBLjAsAhQ3yD47Jkj09BfU_qgNk4";
+
+/// An access token stored by an earlier run.
+static const std::string STORED_AUTH_TOKEN = "Atza|stored_auth_token";
+
 /// The HTTP response code for a bad request.
 static const long HTTP_RESPONSE_CODE_BAD_REQUEST = 400;
 
@@ -68,7 +75,7 @@ static const std::string DEFAULT_SDK_CONFIGURATION = R"({
 class AuthDelegateTest : public ::testing::Test {
 protected:
     /// Initialize the objects for testing
-    AuthDelegateTest() {
+    AuthDelegateTest() : m_isObserverAdded{false} {
         m_mockHttpPost = std::unique_ptr<MockHttpPost>(new MockHttpPost());
         m_mockAuthObserver = std::make_shared<NiceMock<MockAuthObserver>>();
     }
@@ -98,6 +105,27 @@ protected:
         return m_cv.wait_for(lock, seconds, predicate);
     }
 
+    /**
+     * Add @c m_mockAuthObserver to an @c AuthDelegate and release any request blocked in @c waitForObserver().
+     *
+     * @param authDelegate The @c AuthDelegate to observe.
+     */
+    void addObserver(AuthDelegate* authDelegate) {
+        authDelegate->addAuthObserver(m_mockAuthObserver);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isObserverAdded = true;
+        m_cv.notify_all();
+    }
+
+    /**
+     * Block until @c addObserver() has been called.  Used by the first request of a test, which the refresh thread
+     * sends as soon as the @c AuthDelegate is created, so that its outcome is always reported to the observer as a
+     * state change rather than in the observer's initial state.
+     */
+    void waitForObserver() {
+        EXPECT_TRUE(waitFor(TIME_OUT_IN_SECONDS, [this]() { return m_isObserverAdded; }));
+    }
+
     /**
      * Generate a valid LWA response with specified expiration duration in seconds.
      *
@@ -106,7 +134,8 @@ protected:
      */
     std::string generateValidLwaResponseWithExpiration(std::chrono::seconds seconds) {
         std::string response = R"({
-                    "access_token":"Atza|IQEBLjAsAhQ3yD47Jkj09BfU_qgNk4",
+                    "access_token":")" +
+                               LWA_AUTH_TOKEN + R"(",
                     "expires_in":)";
         response += std::to_string(seconds.count());
         response += R"(,
@@ -132,6 +161,59 @@ protected:
         return response;
     }
 
+    /**
+     * Get the credentials id under which AuthDelegate stores access tokens obtained with the test configuration, by
+     * letting it store one.
+     *
+     * @return The credentials id.
+     */
+    std::string getCredentialsId() {
+        auto httpPost = std::unique_ptr<MockHttpPost>(new MockHttpPost());
+        auto storage = std::make_shared<NiceMock<MockAuthTokenStorage>>();
+        const auto& validResponse = generateValidLwaResponseWithExpiration(std::chrono::seconds(3600));
+        EXPECT_CALL(*httpPost, doPost(_, _, _, _))
+            .WillOnce(DoAll(SetArgReferee<3>(validResponse), Return(HTTPResponseCode::SUCCESS_OK)))
+            .WillRepeatedly(Return(HTTPResponseCode::HTTP_RESPONSE_CODE_UNDEFINED));
+        ON_CALL(*storage, open()).WillByDefault(Return(true));
+        ON_CALL(*storage, load(_, _, _)).WillByDefault(Return(true));
+
+        std::string credentialsId;
+        bool tokenStored = false;
+        EXPECT_CALL(*storage, store(_, LWA_AUTH_TOKEN, _))
+            .WillOnce(Invoke([this, &credentialsId, &tokenStored](
+                                 const std::string& id,
+                                 const std::string& authToken,
+                                 std::chrono::system_clock::time_point expirationTime) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                credentialsId = id;
+                tokenStored = true;
+                m_cv.notify_all();
+                return true;
+            }));
+
+        auto authDelegate = AuthDelegate::create(std::move(httpPost), storage);
+        EXPECT_TRUE(waitFor(TIME_OUT_IN_SECONDS, [&tokenStored]() { return tokenStored; }));
+        return credentialsId;
+    }
+
+    /**
+     * Make a storage mock return a token.
+     *
+     * @param storage The storage mock.
+     * @param credentialsId The credentials id of the token.
+     * @param timeLeft How long the token is still valid for.
+     */
+    void storeToken(MockAuthTokenStorage* storage, const std::string& credentialsId, std::chrono::seconds timeLeft) {
+        auto expirationTime = std::chrono::system_clock::now() + timeLeft;
+        ON_CALL(*storage, open()).WillByDefault(Return(true));
+        EXPECT_CALL(*storage, load(_, _, _))
+            .WillOnce(DoAll(
+                SetArgPointee<0>(credentialsId),
+                SetArgPointee<1>(STORED_AUTH_TOKEN),
+                SetArgPointee<2>(expirationTime),
+                Return(true)));
+    }
+
     /// Mock object of @c HttpPostInterface through which refresh token request is sent in AuthDelegate.
     std::unique_ptr<MockHttpPost> m_mockHttpPost;
 
@@ -143,6 +225,9 @@ protected:
 
     /// Mutex used with condition variable @c m_cv.
     std::mutex m_mutex;
+
+    /// Whether @c addObserver() has been called, serialized by @c m_mutex.
+    bool m_isObserverAdded;
 };
 
 /**
@@ -269,7 +354,9 @@ TEST_F(AuthDelegateTest, retry) {
     bool tokenRefreshed = false;
     const auto& validResponse = generateValidLwaResponseWithExpiration(std::chrono::seconds(60));
     EXPECT_CALL(*m_mockHttpPost, doPost(_, _, _, _))
-        .WillOnce(Return(HTTPResponseCode::HTTP_RESPONSE_CODE_UNDEFINED))
+        .WillOnce(DoAll(
+            InvokeWithoutArgs([this]() { waitForObserver(); }),
+            Return(HTTPResponseCode::HTTP_RESPONSE_CODE_UNDEFINED)))
         .WillOnce(Return(HTTPResponseCode::HTTP_RESPONSE_CODE_UNDEFINED))
         .WillOnce(DoAll(SetArgReferee<3>(validResponse), Return(HTTPResponseCode::SUCCESS_OK)));
 
@@ -287,7 +374,7 @@ TEST_F(AuthDelegateTest, retry) {
         }));
 
     auto authDelegate = AuthDelegate::create(std::move(m_mockHttpPost));
-    authDelegate->addAuthObserver(m_mockAuthObserver);
+    addObserver(authDelegate.get());
     ASSERT_TRUE(waitFor(TIME_OUT_IN_SECONDS, [&tokenRefreshed]() { return tokenRefreshed; }));
 }
 
@@ -302,7 +389,10 @@ TEST_F(AuthDelegateTest, expirationNotification) {
     const auto& validResponse = generateValidLwaResponseWithExpiration(std::chrono::seconds(1));
 
     EXPECT_CALL(*m_mockHttpPost, doPost(_, _, _, _))
-        .WillOnce(DoAll(SetArgReferee<3>(validResponse), Return(HTTPResponseCode::SUCCESS_OK)))
+        .WillOnce(DoAll(
+            InvokeWithoutArgs([this]() { waitForObserver(); }),
+            SetArgReferee<3>(validResponse),
+            Return(HTTPResponseCode::SUCCESS_OK)))
         .WillRepeatedly(Return(HTTPResponseCode::HTTP_RESPONSE_CODE_UNDEFINED));
 
     ::testing::InSequence s;
@@ -325,7 +415,7 @@ TEST_F(AuthDelegateTest, expirationNotification) {
         }));
 
     auto authDelegate = AuthDelegate::create(std::move(m_mockHttpPost));
-    authDelegate->addAuthObserver(m_mockAuthObserver);
+    addObserver(authDelegate.get());
     ASSERT_TRUE(waitFor(TIME_OUT_IN_SECONDS, [&tokenExpired]() { return tokenExpired; }));
 }
 
@@ -340,7 +430,10 @@ TEST_F(AuthDelegateTest, recoverAfterExpiration) {
     const auto& validResponse = generateValidLwaResponseWithExpiration(std::chrono::seconds(3));
 
     EXPECT_CALL(*m_mockHttpPost, doPost(_, _, _, _))
-        .WillOnce(DoAll(SetArgReferee<3>(validResponse), Return(HTTPResponseCode::SUCCESS_OK)))
+        .WillOnce(DoAll(
+            InvokeWithoutArgs([this]() { waitForObserver(); }),
+            SetArgReferee<3>(validResponse),
+            Return(HTTPResponseCode::SUCCESS_OK)))
         .WillOnce(Return(HTTPResponseCode::HTTP_RESPONSE_CODE_UNDEFINED))
         .WillOnce(Return(HTTPResponseCode::HTTP_RESPONSE_CODE_UNDEFINED))
         .WillOnce(Return(HTTPResponseCode::HTTP_RESPONSE_CODE_UNDEFINED))
@@ -371,7 +464,7 @@ TEST_F(AuthDelegateTest, recoverAfterExpiration) {
         }));
 
     auto authDelegate = AuthDelegate::create(std::move(m_mockHttpPost));
-    authDelegate->addAuthObserver(m_mockAuthObserver);
+    addObserver(authDelegate.get());
     ASSERT_TRUE(waitFor(TIME_OUT_IN_SECONDS, [&tokenRefreshed]() { return tokenRefreshed; }));
 }
 
@@ -386,7 +479,10 @@ TEST_F(AuthDelegateTest, unrecoverableErrorNotification) {
     const auto& invalidRequestResponse = generateErrorLwaResponseWithErrorCode(ERROR_CODE_INVALID_REQUEST);
 
     EXPECT_CALL(*m_mockHttpPost, doPost(_, _, _, _))
-        .WillOnce(DoAll(SetArgReferee<3>(invalidRequestResponse), Return(HTTP_RESPONSE_CODE_BAD_REQUEST)))
+        .WillOnce(DoAll(
+            InvokeWithoutArgs([this]() { waitForObserver(); }),
+            SetArgReferee<3>(invalidRequestResponse),
+            Return(HTTP_RESPONSE_CODE_BAD_REQUEST)))
         .WillRepeatedly(Return(HTTPResponseCode::HTTP_RESPONSE_CODE_UNDEFINED));
 
     EXPECT_CALL(
@@ -404,6 +500,107 @@ TEST_F(AuthDelegateTest, unrecoverableErrorNotification) {
         }));
 
     auto authDelegate = AuthDelegate::create(std::move(m_mockHttpPost));
-    authDelegate->addAuthObserver(m_mockAuthObserver);
+    addObserver(authDelegate.get());
     ASSERT_TRUE(waitFor(TIME_OUT_IN_SECONDS, [&errorReceived]() { return errorReceived; }));
 }
+
+/**
+ * Test that a refreshed access token is stored with an expiration time matching the LWA response.
+ */
+TEST_F(AuthDelegateTest, refreshedTokenIsStored) {
+    auto storage = std::make_shared<NiceMock<MockAuthTokenStorage>>();
+    const auto& validResponse = generateValidLwaResponseWithExpiration(std::chrono::seconds(3600));
+    EXPECT_CALL(*m_mockHttpPost, doPost(_, _, _, _))
+        .WillOnce(DoAll(SetArgReferee<3>(validResponse), Return(HTTPResponseCode::SUCCESS_OK)))
+        .WillRepeatedly(Return(HTTPResponseCode::HTTP_RESPONSE_CODE_UNDEFINED));
+    EXPECT_CALL(*storage, open()).WillOnce(Return(false));
+    EXPECT_CALL(*storage, createDatabase()).WillOnce(Return(true));
+
+    bool tokenStored = false;
+    std::chrono::system_clock::time_point storedExpirationTime;
+    EXPECT_CALL(*storage, store(_, LWA_AUTH_TOKEN, _))
+        .WillOnce(Invoke([this, &tokenStored, &storedExpirationTime](
+                             const std::string& credentialsId,
+                             const std::string& authToken,
+                             std::chrono::system_clock::time_point expirationTime) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            storedExpirationTime = expirationTime;
+            tokenStored = true;
+            m_cv.notify_all();
+            return true;
+        }));
+
+    auto authDelegate = AuthDelegate::create(std::move(m_mockHttpPost), storage);
+    ASSERT_TRUE(waitFor(TIME_OUT_IN_SECONDS, [&tokenStored]() { return tokenStored; }));
+    auto timeLeft = storedExpirationTime - std::chrono::system_clock::now();
+    EXPECT_GT(timeLeft, std::chrono::seconds(3590));
+    EXPECT_LE(timeLeft, std::chrono::seconds(3600));
+}
+
+/**
+ * Test that a valid stored access token is used straight away, before the refresh request made in the background has
+ * been answered.
+ */
+TEST_F(AuthDelegateTest, storedTokenIsUsedBeforeRefresh) {
+    auto credentialsId = getCredentialsId();
+    ASSERT_FALSE(credentialsId.empty());
+
+    auto storage = std::make_shared<NiceMock<MockAuthTokenStorage>>();
+    storeToken(storage.get(), credentialsId, std::chrono::seconds(3600));
+
+    bool refreshRequested = false;
+    bool releaseRefresh = false;
+    EXPECT_CALL(*m_mockHttpPost, doPost(_, _, _, _))
+        .WillOnce(InvokeWithoutArgs([this, &refreshRequested, &releaseRefresh]() {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            refreshRequested = true;
+            m_cv.notify_all();
+            m_cv.wait(lock, [&releaseRefresh]() { return releaseRefresh; });
+            return HTTPResponseCode::HTTP_RESPONSE_CODE_UNDEFINED;
+        }))
+        .WillRepeatedly(Return(HTTPResponseCode::HTTP_RESPONSE_CODE_UNDEFINED));
+    EXPECT_CALL(
+        *m_mockAuthObserver,
+        onAuthStateChange(AuthObserverInterface::State::REFRESHED, AuthObserverInterface::Error::SUCCESS))
+        .Times(1);
+
+    auto authDelegate = AuthDelegate::create(std::move(m_mockHttpPost), storage);
+    ASSERT_TRUE(authDelegate);
+    EXPECT_EQ(STORED_AUTH_TOKEN, authDelegate->getAuthToken());
+    authDelegate->addAuthObserver(m_mockAuthObserver);
+    EXPECT_TRUE(waitFor(TIME_OUT_IN_SECONDS, [&refreshRequested]() { return refreshRequested; }));
+
+    // A failed refresh leaves the stored token in use until it expires.
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        releaseRefresh = true;
+    }
+    m_cv.notify_all();
+    EXPECT_EQ(STORED_AUTH_TOKEN, authDelegate->getAuthToken());
+}
+
+/**
+ * Test that a stored access token which is about to expire is not used.
+ */
+TEST_F(AuthDelegateTest, expiringStoredTokenIsNotUsed) {
+    auto credentialsId = getCredentialsId();
+    auto storage = std::make_shared<NiceMock<MockAuthTokenStorage>>();
+    storeToken(storage.get(), credentialsId, std::chrono::seconds(10));
+
+    auto authDelegate = AuthDelegate::create(std::move(m_mockHttpPost), storage);
+    ASSERT_TRUE(authDelegate);
+    EXPECT_TRUE(authDelegate->getAuthToken().empty());
+}
+
+/**
+ * Test that a stored access token obtained with other credentials is not used, and is erased.
+ */
+TEST_F(AuthDelegateTest, storedTokenForOtherCredentialsIsNotUsed) {
+    auto storage = std::make_shared<NiceMock<MockAuthTokenStorage>>();
+    storeToken(storage.get(), "other credentials", std::chrono::seconds(3600));
+    EXPECT_CALL(*storage, clearDatabase()).WillOnce(Return(true));
+
+    auto authDelegate = AuthDelegate::create(std::move(m_mockHttpPost), storage);
+    ASSERT_TRUE(authDelegate);
+    EXPECT_TRUE(authDelegate->getAuthToken().empty());
+}
@@ -0,0 +1,194 @@
+/*
+ * Copyright 2017-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <sys/stat.h>
+
+#include <gtest/gtest.h>
+
+#include <AuthDelegate/SQLiteAuthTokenStorage.h>
+
+#include <AVSCommon/Utils/File/FileUtils.h>
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+
+namespace alexaClientSDK {
+namespace authDelegate {
+namespace test {
+
+using namespace avsCommon::utils::file;
+
+/// The filename we will use for the test database file.
+static const std::string TEST_DATABASE_FILE_PATH = "authTokenStorageTestDatabase.db";
+/// The path delimiter used by the OS to identify file locations.
+static const std::string PATH_DELIMITER = "/";
+/// The base of the filepaths to the database files we will create and delete during tests.
+static std::string g_dbTestFilePath;
+/// A test credentials id.
+static const std::string TEST_CREDENTIALS_ID = "0123456789abcdef";
+/// A test access token.
+static const std::string TEST_AUTH_TOKEN_ONE = "Atza|test_auth_token_one";
+/// The permissions the database file is expected to have.
+static const mode_t PRIVATE_FILE_MODE = S_IRUSR | S_IWUSR;
+/// The permission bits of a file mode.
+static const mode_t PERMISSION_BITS = S_IRWXU | S_IRWXG | S_IRWXO;
+/// A test access token.
+static const std::string TEST_AUTH_TOKEN_TWO = "Atza|test_auth_token_two";
+
+/**
+ * A class which helps drive this unit test suite.
+ */
+class SQLiteAuthTokenStorageTest : public ::testing::Test {
+public:
+    /**
+     * Constructor.
+     */
+    SQLiteAuthTokenStorageTest() :
+            m_dbFilePath{g_dbTestFilePath + "." + ::testing::UnitTest::GetInstance()->current_test_info()->name()},
+            m_storage{std::make_shared<SQLiteAuthTokenStorage>(m_dbFilePath)} {
+        cleanupLocalDbFile();
+    }
+
+    /**
+     * Destructor.
+     */
+    ~SQLiteAuthTokenStorageTest() {
+        m_storage->close();
+        cleanupLocalDbFile();
+    }
+
+    /**
+     * Utility function to cleanup the test database file, if it exists.
+     */
+    void cleanupLocalDbFile() {
+        if (g_dbTestFilePath.empty()) {
+            return;
+        }
+
+        if (fileExists(m_dbFilePath)) {
+            removeFile(m_dbFilePath.c_str());
+        }
+    }
+
+    /**
+     * Utility function to get the permission bits of the test database file.
+     *
+     * @param[out] mode The permission bits.
+     * @return Whether the file could be examined.
+     */
+    bool getDbFileMode(mode_t* mode) {
+        struct stat fileStat;
+        if (stat(m_dbFilePath.c_str(), &fileStat) != 0) {
+            return false;
+        }
+        *mode = fileStat.st_mode & PERMISSION_BITS;
+        return true;
+    }
+
+protected:
+    /// The database file for this test.  Each test uses its own, so that tests may run in parallel.
+    const std::string m_dbFilePath;
+
+    /// The access token database object we will test.
+    std::shared_ptr<AuthTokenStorageInterface> m_storage;
+};
+
+/**
+ * Test that a database cannot be opened before it is created, and that a new database has no token.
+ */
+TEST_F(SQLiteAuthTokenStorageTest, testDatabaseCreation) {
+    ASSERT_FALSE(m_storage->open());
+    ASSERT_TRUE(m_storage->createDatabase());
+
+    std::string credentialsId;
+    std::string authToken;
+    std::chrono::system_clock::time_point expirationTime;
+    ASSERT_TRUE(m_storage->load(&credentialsId, &authToken, &expirationTime));
+    EXPECT_TRUE(authToken.empty());
+}
+
+/**
+ * Test that a stored token is loaded back, to the second, and that storing another replaces it.
+ */
+TEST_F(SQLiteAuthTokenStorageTest, testStoreAndLoad) {
+    ASSERT_TRUE(m_storage->createDatabase());
+    auto expirationTime = std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::seconds(2000000000)));
+    ASSERT_TRUE(m_storage->store(TEST_CREDENTIALS_ID, TEST_AUTH_TOKEN_ONE, expirationTime));
+    ASSERT_TRUE(m_storage->store(TEST_CREDENTIALS_ID, TEST_AUTH_TOKEN_TWO, expirationTime));
+
+    // Reopen the database, as at the next startup.
+    m_storage->close();
+    ASSERT_TRUE(m_storage->open());
+
+    std::string credentialsId;
+    std::string authToken;
+    std::chrono::system_clock::time_point loadedExpirationTime;
+    ASSERT_TRUE(m_storage->load(&credentialsId, &authToken, &loadedExpirationTime));
+    EXPECT_EQ(TEST_CREDENTIALS_ID, credentialsId);
+    EXPECT_EQ(TEST_AUTH_TOKEN_TWO, authToken);
+    EXPECT_EQ(expirationTime, loadedExpirationTime);
+}
+
+/**
+ * Test that clearing the database erases the stored token.
+ */
+TEST_F(SQLiteAuthTokenStorageTest, testClearDatabase) {
+    ASSERT_TRUE(m_storage->createDatabase());
+    ASSERT_TRUE(m_storage->store(TEST_CREDENTIALS_ID, TEST_AUTH_TOKEN_ONE, std::chrono::system_clock::now()));
+    ASSERT_TRUE(m_storage->clearDatabase());
+
+    std::string credentialsId;
+    std::string authToken;
+    std::chrono::system_clock::time_point expirationTime;
+    ASSERT_TRUE(m_storage->load(&credentialsId, &authToken, &expirationTime));
+    EXPECT_TRUE(authToken.empty());
+}
+
+/**
+ * Test that the database file is only accessible by its owner, and that opening a database with looser permissions
+ * restricts them.
+ */
+TEST_F(SQLiteAuthTokenStorageTest, testDatabaseFileIsPrivate) {
+    ASSERT_TRUE(m_storage->createDatabase());
+    mode_t mode;
+    ASSERT_TRUE(getDbFileMode(&mode));
+    EXPECT_EQ(PRIVATE_FILE_MODE, mode);
+
+    m_storage->close();
+    ASSERT_EQ(0, chmod(m_dbFilePath.c_str(), S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH));
+    ASSERT_TRUE(m_storage->open());
+    ASSERT_TRUE(getDbFileMode(&mode));
+    EXPECT_EQ(PRIVATE_FILE_MODE, mode);
+}
+
+}  // namespace test
+}  // namespace authDelegate
+}  // namespace alexaClientSDK
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    if (argc < 2) {
+        std::cerr << "USAGE: " << std::string(argv[0]) << " <path_to_test_directory_location>" << std::endl;
+        return 1;
+    } else {
+        alexaClientSDK::authDelegate::test::g_dbTestFilePath =
+            std::string(argv[1]) + alexaClientSDK::authDelegate::test::PATH_DELIMITER +
+            alexaClientSDK::authDelegate::test::TEST_DATABASE_FILE_PATH;
+
+        return RUN_ALL_TESTS();
+    }
+}
@@ -0,0 +1,408 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file
+ * Runs 16 kHz mono LPCM through @c AudioEncoder with each compiled-in codec, the way @c AudioInputProcessor does for a
+ * Recognize upload, and reports the CPU time spent in the codec per second of audio and the bytes saved on the upload.
+ *
+ * USAGE: AudioEncoderBenchmark [path_to_wav_file ...] [--codec lpcm|opus]
+ *
+ * The WAV files must be 16 kHz, 16-bit, mono with a 44 byte header, such as the recordings in KWD/inputs.  Without
+ * files, ten seconds of synthetic voiced audio are used.  The @c lpcm codec copies samples unchanged, so its figures
+ * are the cost of the encoder thread and streams alone.  The @c opus codec is only available when built with
+ * -DOPUS=ON.
+ */
+
+#include <time.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <AVSCommon/AVS/AudioInputStream.h>
+#include <AVSCommon/Utils/AudioFormat.h>
+#include <AVSCommon/Utils/Memory/Memory.h>
+
+#include "AIP/AudioEncoder.h"
+#include "AIP/EncoderContext.h"
+
+#ifdef ENABLE_OPUS
+#include "AIP/OpusEncoderContext.h"
+#endif
+
+using namespace alexaClientSDK;
+using namespace alexaClientSDK::avsCommon::avs;
+using namespace alexaClientSDK::avsCommon::utils;
+using namespace alexaClientSDK::capabilityAgents::aip;
+
+/// The sample rate of the audio.
+static const unsigned int SAMPLE_RATE_HZ = 16000;
+
+/// The size of the RIFF header of the WAV files.
+static const size_t RIFF_HEADER_SIZE = 44;
+
+/// The duration of the synthetic audio used when no file is given.
+static const std::chrono::seconds SYNTHETIC_DURATION{10};
+
+/// The number of samples in each buffer written to the stream, as a microphone would deliver 10 ms of audio.
+static const size_t WRITE_SIZE = SAMPLE_RATE_HZ / 100;
+
+/// The maximum number of readers of the input stream.
+static const size_t MAX_READERS = 1;
+
+/// How long to wait for each read of the encoded stream.
+static const std::chrono::seconds READ_TIMEOUT{10};
+
+/// The 16 kHz, 16-bit, mono LPCM format of the audio.
+static const AudioFormat FORMAT = {AudioFormat::Encoding::LPCM,
+                                   AudioFormat::Endianness::LITTLE,
+                                   SAMPLE_RATE_HZ,
+                                   16,
+                                   1,
+                                   true,
+                                   AudioFormat::Layout::INTERLEAVED};
+
+/**
+ * An @c EncoderContext which copies 20 ms frames of LPCM unchanged.
+ */
+class LPCMEncoderContext : public EncoderContext {
+public:
+    bool init(const AudioFormat& inputFormat) override {
+        return true;
+    }
+
+    size_t getInputFrameSize() const override {
+        return FRAME_SAMPLES;
+    }
+
+    size_t getOutputFrameSize() const override {
+        return FRAME_SAMPLES * sizeof(int16_t);
+    }
+
+    AudioFormat getAudioFormat() const override {
+        return FORMAT;
+    }
+
+    std::string getAVSFormatName() const override {
+        return "AUDIO_L16_RATE_16000_CHANNELS_1";
+    }
+
+    ssize_t processSamples(const int16_t* input, uint8_t* output) override {
+        std::memcpy(output, input, getOutputFrameSize());
+        return getOutputFrameSize();
+    }
+
+    void close() override {
+    }
+
+private:
+    /// The number of samples in one frame.
+    static const size_t FRAME_SAMPLES = SAMPLE_RATE_HZ / 50;
+};
+
+/**
+ * An @c EncoderContext which measures the CPU time another one spends encoding.  The thread CPU clock is used, so time
+ * the encoder thread spends waiting for the streams is not counted.
+ */
+class TimedEncoderContext : public EncoderContext {
+public:
+    /**
+     * Constructor.
+     *
+     * @param encoderContext The codec to measure.
+     * @param[out] cpuNs Accumulates the CPU time spent in @c processSamples(), in nanoseconds.
+     */
+    TimedEncoderContext(std::unique_ptr<EncoderContext> encoderContext, int64_t* cpuNs) :
+            m_encoderContext{std::move(encoderContext)},
+            m_cpuNs{cpuNs} {
+    }
+
+    bool init(const AudioFormat& inputFormat) override {
+        return m_encoderContext->init(inputFormat);
+    }
+
+    size_t getInputFrameSize() const override {
+        return m_encoderContext->getInputFrameSize();
+    }
+
+    size_t getOutputFrameSize() const override {
+        return m_encoderContext->getOutputFrameSize();
+    }
+
+    AudioFormat getAudioFormat() const override {
+        return m_encoderContext->getAudioFormat();
+    }
+
+    std::string getAVSFormatName() const override {
+        return m_encoderContext->getAVSFormatName();
+    }
+
+    ssize_t processSamples(const int16_t* input, uint8_t* output) override {
+        auto start = threadCpuNs();
+        auto result = m_encoderContext->processSamples(input, output);
+        *m_cpuNs += threadCpuNs() - start;
+        return result;
+    }
+
+    void close() override {
+        m_encoderContext->close();
+    }
+
+private:
+    /**
+     * Get the CPU time used by the calling thread.
+     *
+     * @return The CPU time used by the calling thread, in nanoseconds.
+     */
+    static int64_t threadCpuNs() {
+        timespec now;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+        return static_cast<int64_t>(now.tv_sec) * 1000000000 + now.tv_nsec;
+    }
+
+    /// The codec being measured.
+    std::unique_ptr<EncoderContext> m_encoderContext;
+
+    /// Accumulates the CPU time spent in @c processSamples().
+    int64_t* m_cpuNs;
+};
+
+/// Creates the codec to benchmark.
+using CodecFactory = std::function<std::unique_ptr<EncoderContext>()>;
+
+/// A named codec to benchmark.
+struct Codec {
+    /// The name used on the command line and in the report.
+    std::string name;
+
+    /// Creates the codec.
+    CodecFactory create;
+};
+
+/// The results of encoding one input.
+struct Result {
+    /// The duration of the audio.
+    double audioMs = 0;
+
+    /// The CPU time spent in the codec.
+    double codecCpuMs = 0;
+
+    /// The CPU time used by the whole process, including the streams and the threads writing and reading them.
+    double processCpuMs = 0;
+
+    /// The size of the LPCM input.
+    size_t inputBytes = 0;
+
+    /// The size of the encoded output.
+    size_t outputBytes = 0;
+};
+
+/**
+ * Get the codecs which were compiled in.
+ *
+ * @return The codecs.
+ */
+static std::vector<Codec> getCodecs() {
+    std::vector<Codec> codecs;
+    codecs.push_back({"lpcm", [] { return memory::make_unique<LPCMEncoderContext>(); }});
+#ifdef ENABLE_OPUS
+    codecs.push_back({"opus", [] { return memory::make_unique<OpusEncoderContext>(); }});
+#endif
+    return codecs;
+}
+
+/**
+ * Read the samples of a WAV file.
+ *
+ * @param fileName The path of the file.
+ * @param[out] samples The samples.
+ * @return Whether the file could be read.
+ */
+static bool readAudioFromFile(const std::string& fileName, std::vector<int16_t>* samples) {
+    std::ifstream inputFile(fileName.c_str(), std::ifstream::binary);
+    if (!inputFile.good()) {
+        return false;
+    }
+    inputFile.seekg(0, std::ios::end);
+    int fileLengthInBytes = inputFile.tellg();
+    if (fileLengthInBytes <= static_cast<int>(RIFF_HEADER_SIZE)) {
+        return false;
+    }
+    inputFile.seekg(RIFF_HEADER_SIZE, std::ios::beg);
+    samples->resize((fileLengthInBytes - RIFF_HEADER_SIZE) / sizeof(int16_t));
+    inputFile.read(reinterpret_cast<char*>(samples->data()), samples->size() * sizeof(int16_t));
+    return !inputFile.bad();
+}
+
+/**
+ * Build synthetic voiced audio: a 150 Hz pulse train with a few harmonics, whose loudness rises and falls like
+ * syllables, over a low noise floor.
+ *
+ * @return The samples.
+ */
+static std::vector<int16_t> buildSyntheticAudio() {
+    const double pi = std::acos(-1.0);
+    std::vector<int16_t> samples(SYNTHETIC_DURATION.count() * SAMPLE_RATE_HZ);
+    unsigned int noise = 1;
+    for (size_t i = 0; i < samples.size(); ++i) {
+        double t = static_cast<double>(i) / SAMPLE_RATE_HZ;
+        double envelope = 0.5 + 0.5 * std::sin(2 * pi * 4 * t);
+        double voiced = 0;
+        for (int harmonic = 1; harmonic <= 5; ++harmonic) {
+            voiced += std::sin(2 * pi * 150 * harmonic * t) / harmonic;
+        }
+        noise = noise * 1103515245 + 12345;
+        double floor = static_cast<double>((noise >> 16) & 0x7fff) / 0x7fff - 0.5;
+        samples[i] = static_cast<int16_t>(6000 * envelope * voiced + 200 * floor);
+    }
+    return samples;
+}
+
+/**
+ * Encode audio as @c AudioInputProcessor does: start encoding a stream the audio is written to, stop encoding once it
+ * is all written, and read the encoded stream until it closes.
+ *
+ * @param codec The codec to use.
+ * @param samples The audio.
+ * @param[out] result The results.
+ * @return Whether the audio was encoded.
+ */
+static bool encode(const Codec& codec, const std::vector<int16_t>& samples, Result* result) {
+    int64_t codecCpuNs = 0;
+    auto encoder = AudioEncoder::create(memory::make_unique<TimedEncoderContext>(codec.create(), &codecCpuNs));
+    if (!encoder) {
+        std::cerr << "Unable to create the " << codec.name << " encoder" << std::endl;
+        return false;
+    }
+
+    // The stream holds all the audio, so that writing it as fast as possible never overruns the encoder.
+    auto bufferSize = AudioInputStream::calculateBufferSize(samples.size(), sizeof(int16_t), MAX_READERS);
+    auto buffer = std::make_shared<AudioInputStream::Buffer>(bufferSize);
+    std::shared_ptr<AudioInputStream> stream = AudioInputStream::create(buffer, sizeof(int16_t), MAX_READERS);
+    std::shared_ptr<AudioInputStream::Writer> writer =
+        stream ? stream->createWriter(AudioInputStream::Writer::Policy::NONBLOCKABLE) : nullptr;
+    if (!writer) {
+        std::cerr << "Unable to create the input stream" << std::endl;
+        return false;
+    }
+
+    auto cpuStart = std::clock();
+    auto encodedStream = encoder->startEncoding(stream, FORMAT, 0, AudioInputStream::Reader::Reference::ABSOLUTE);
+    std::shared_ptr<AudioInputStream::Reader> reader =
+        encodedStream ? encodedStream->createReader(AudioInputStream::Reader::Policy::BLOCKING) : nullptr;
+    if (!reader) {
+        std::cerr << "Unable to start encoding with " << codec.name << std::endl;
+        return false;
+    }
+
+    for (size_t offset = 0; offset < samples.size(); offset += WRITE_SIZE) {
+        writer->write(samples.data() + offset, std::min(WRITE_SIZE, samples.size() - offset));
+    }
+    encoder->stopEncoding();
+
+    std::vector<uint8_t> encoded(encodedStream->getDataSize());
+    while (true) {
+        auto wordsRead = reader->read(encoded.data(), encoded.size(), READ_TIMEOUT);
+        if (wordsRead > 0) {
+            result->outputBytes += wordsRead;
+        } else if (AudioInputStream::Reader::Error::CLOSED == wordsRead) {
+            break;
+        } else {
+            std::cerr << "Reading the " << codec.name << " stream failed: " << wordsRead << std::endl;
+            return false;
+        }
+    }
+    result->processCpuMs = 1000.0 * (std::clock() - cpuStart) / CLOCKS_PER_SEC;
+    result->codecCpuMs = codecCpuNs / 1000000.0;
+    result->audioMs = 1000.0 * samples.size() / SAMPLE_RATE_HZ;
+    result->inputBytes = samples.size() * sizeof(int16_t);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    std::vector<std::string> fileNames;
+    std::string selected;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if ("--codec" == arg && i + 1 < argc) {
+            selected = argv[++i];
+        } else if (arg.compare(0, 2, "--") == 0) {
+            std::cerr << "USAGE: " << std::string(argv[0]) << " [path_to_wav_file ...] [--codec lpcm|opus]"
+                      << std::endl;
+            return EXIT_FAILURE;
+        } else {
+            fileNames.push_back(arg);
+        }
+    }
+
+    auto codecs = getCodecs();
+    if (!selected.empty()) {
+        codecs.erase(
+            std::remove_if(codecs.begin(), codecs.end(), [&selected](const Codec& c) { return c.name != selected; }),
+            codecs.end());
+        if (codecs.empty()) {
+            std::cerr << "Codec " << selected << " was not compiled in" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::vector<std::pair<std::string, std::vector<int16_t>>> inputs;
+    if (fileNames.empty()) {
+        inputs.push_back({"synthetic", buildSyntheticAudio()});
+    }
+    for (const auto& fileName : fileNames) {
+        std::vector<int16_t> samples;
+        if (!readAudioFromFile(fileName, &samples)) {
+            std::cerr << "Unable to read " << fileName << std::endl;
+            return EXIT_FAILURE;
+        }
+        inputs.push_back({fileName.substr(fileName.find_last_of('/') + 1), std::move(samples)});
+    }
+
+    std::cout << std::left << std::setw(8) << "codec" << std::setw(30) << "input" << std::right << std::setw(10)
+              << "audioMs" << std::setw(12) << "codecCpuMs" << std::setw(16) << "codecMsPerSec" << std::setw(16)
+              << "processMsPerSec" << std::setw(12) << "inBytes" << std::setw(12) << "outBytes" << std::setw(10)
+              << "saved%" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+
+    bool succeeded = true;
+    for (const auto& codec : codecs) {
+        for (const auto& input : inputs) {
+            Result result;
+            if (!encode(codec, input.second, &result)) {
+                succeeded = false;
+                continue;
+            }
+            std::cout << std::left << std::setw(8) << codec.name << std::setw(30) << input.first << std::right
+                      << std::setw(10) << result.audioMs << std::setw(12) << result.codecCpuMs << std::setw(16)
+                      << result.codecCpuMs * 1000 / result.audioMs << std::setw(16)
+                      << result.processCpuMs * 1000 / result.audioMs << std::setw(12) << result.inputBytes
+                      << std::setw(12) << result.outputBytes << std::setw(10)
+                      << 100.0 * (1.0 - static_cast<double>(result.outputBytes) / result.inputBytes) << std::endl;
+        }
+    }
+    return succeeded ? EXIT_SUCCESS : EXIT_FAILURE;
+}
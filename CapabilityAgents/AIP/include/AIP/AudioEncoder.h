@@ -0,0 +1,168 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_CAPABILITYAGENTS_AIP_INCLUDE_AIP_AUDIOENCODER_H_
+#define ALEXA_CLIENT_SDK_CAPABILITYAGENTS_AIP_INCLUDE_AIP_AUDIOENCODER_H_
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <AVSCommon/AVS/AudioInputStream.h>
+#include <AVSCommon/Utils/AudioFormat.h>
+
+#include "EncoderContext.h"
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace aip {
+
+/**
+ * @c AudioEncoder is an optional stage which sits between an LPCM @c AudioInputStream and the Recognize attachment.
+ * While encoding, it reads frames from the input stream on its own thread, passes them through an @c EncoderContext,
+ * and writes the encoded bytes into an intermediate @c AudioInputStream which is uploaded instead of the raw audio.
+ *
+ * The intermediate stream holds a bounded amount of encoded audio; once it is full the encoder thread blocks until
+ * the uploader catches up, so the encoder never reads more than that look-ahead past what has been sent.
+ *
+ * At the end of each encoding session, the amount of audio encoded, the bytes saved and the time spent in the codec
+ * are logged, which gives the encode cost per second of audio and the upload savings on the target hardware.
+ */
+class AudioEncoder {
+public:
+    /**
+     * Creates a new @c AudioEncoder instance.
+     *
+     * @param encoderContext The codec to encode with.
+     * @param lookAheadFrames The maximum number of encoded frames buffered ahead of the uploader.
+     * @return A @c std::shared_ptr to the new @c AudioEncoder, or @c nullptr if the operation failed.
+     */
+    static std::shared_ptr<AudioEncoder> create(
+        std::unique_ptr<EncoderContext> encoderContext,
+        size_t lookAheadFrames = DEFAULT_LOOK_AHEAD_FRAMES);
+
+    /**
+     * Destructor.  Stops any encoding session in progress.
+     */
+    ~AudioEncoder();
+
+    /**
+     * Start encoding @c inputStream from the specified position.  Any encoding session already in progress is stopped
+     * immediately first.
+     *
+     * @param inputStream The LPCM stream to encode.
+     * @param inputFormat The @c AudioFormat of @c inputStream.
+     * @param begin The position in @c inputStream to start encoding from.
+     * @param reference The reference @c begin is relative to.
+     * @return A new stream which will receive the encoded audio, or @c nullptr if encoding could not be started.
+     */
+    std::shared_ptr<avsCommon::avs::AudioInputStream> startEncoding(
+        std::shared_ptr<avsCommon::avs::AudioInputStream> inputStream,
+        const avsCommon::utils::AudioFormat& inputFormat,
+        avsCommon::avs::AudioInputStream::Index begin,
+        avsCommon::avs::AudioInputStream::Reader::Reference reference);
+
+    /**
+     * Stop the current encoding session.  When the session ends, the writer of the encoded stream is closed so that
+     * readers see the end of the stream.
+     *
+     * @param stopImmediately If @c true, any input which has not been encoded yet is discarded.  If @c false, all the
+     *     input written before this call is encoded before the session ends.
+     */
+    void stopEncoding(bool stopImmediately = false);
+
+    /**
+     * Get the @c AudioFormat of the encoded output.
+     *
+     * @return The @c AudioFormat of the encoded output.
+     */
+    avsCommon::utils::AudioFormat getAudioFormat() const;
+
+    /**
+     * Get the format name to report to AVS in the Recognize event for the encoded output.
+     *
+     * @return The AVS format name of the encoded output.
+     */
+    std::string getAVSFormatName() const;
+
+    /// The default number of encoded frames buffered ahead of the uploader.
+    static const size_t DEFAULT_LOOK_AHEAD_FRAMES = 100;
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param encoderContext The codec to encode with.
+     * @param lookAheadFrames The maximum number of encoded frames buffered ahead of the uploader.
+     */
+    AudioEncoder(std::unique_ptr<EncoderContext> encoderContext, size_t lookAheadFrames);
+
+    /**
+     * The encoding loop, which runs on @c m_encodingThread until the input is closed or a stop is requested.
+     *
+     * @param reader The reader for the input stream.
+     * @param writer The writer for the encoded stream.
+     * @param inputSampleRateHz The sample rate of the input, used to report encoding statistics.
+     */
+    void encodingLoop(
+        std::shared_ptr<avsCommon::avs::AudioInputStream::Reader> reader,
+        std::shared_ptr<avsCommon::avs::AudioInputStream::Writer> writer,
+        unsigned int inputSampleRateHz);
+
+    /**
+     * Stop the current encoding session immediately and wait for @c m_encodingThread to exit.  The caller must hold
+     * @c m_mutex.
+     */
+    void stopAndJoinLocked();
+
+    /**
+     * Write a block of encoded bytes to the output stream, waiting for space as needed.
+     *
+     * @param writer The writer for the encoded stream.
+     * @param data The encoded bytes.
+     * @param size The number of bytes to write.
+     * @return @c true if all the bytes were written, else @c false.
+     */
+    bool writeEncodedBytes(
+        std::shared_ptr<avsCommon::avs::AudioInputStream::Writer> writer,
+        const uint8_t* data,
+        size_t size);
+
+    /// The codec used to encode frames.  This is only accessed from @c m_encodingThread while a session is running.
+    std::unique_ptr<EncoderContext> m_encoderContext;
+
+    /// The maximum number of encoded frames buffered ahead of the uploader.
+    const size_t m_lookAheadFrames;
+
+    /// Serializes @c startEncoding() and @c stopEncoding(), and protects @c m_inputReader.
+    std::mutex m_mutex;
+
+    /// The reader on the input stream for the current session.
+    std::shared_ptr<avsCommon::avs::AudioInputStream::Reader> m_inputReader;
+
+    /// Flag which tells @c m_encodingThread to discard pending input and finish.
+    std::atomic<bool> m_stopImmediately;
+
+    /// The thread which runs @c encodingLoop().
+    std::thread m_encodingThread;
+};
+
+}  // namespace aip
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_CAPABILITYAGENTS_AIP_INCLUDE_AIP_AUDIOENCODER_H_
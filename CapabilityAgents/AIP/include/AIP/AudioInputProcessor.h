@@ -36,7 +36,9 @@
 #include <AVSCommon/Utils/RequiresShutdown.h>
 #include <AVSCommon/Utils/Threading/Executor.h>
 #include <AVSCommon/Utils/Timing/Timer.h>
+#include "AudioEncoder.h"
 #include "AudioProvider.h"
+#include "Endpointer.h"
 #include "ESPData.h"
 #include "Initiator.h"
 
@@ -82,6 +84,13 @@ public:
      * @param defaultAudioProvider A default @c avsCommon::AudioProvider to use for ExpectSpeech if the previous
      *     provider is not readable (@c avsCommon::AudioProvider::alwaysReadable).  This parameter is optional and
      *     defaults to an invalid @c avsCommon::AudioProvider.
+     * @param audioEncoder An optional @c AudioEncoder used to compress LPCM audio before it is uploaded in a Recognize
+     *     event.  If @c nullptr (the default), LPCM audio is uploaded as is.  The encoder is only used while encoding
+     *     is enabled, which is read from the "encodeAudio" key of the "audioInputProcessor" configuration node
+     *     (disabled by default) and can be changed with @c setEncodingEnabled().
+     * @param endpointer An optional @c Endpointer used to stop capture when the end of speech is detected on the
+     *     device.  If @c nullptr (the default), capture is stopped only by a @c StopCapture directive or a call to
+     *     @c stopCapture().
      * @return A @c std::shared_ptr to the new @c AudioInputProcessor instance.
      */
     static std::shared_ptr<AudioInputProcessor> create(
@@ -92,7 +101,9 @@ public:
         std::shared_ptr<avsCommon::avs::DialogUXStateAggregator> dialogUXStateAggregator,
         std::shared_ptr<avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionEncounteredSender,
         std::shared_ptr<avsCommon::sdkInterfaces::UserActivityNotifierInterface> userActivityNotifier,
-        AudioProvider defaultAudioProvider = AudioProvider::null());
+        AudioProvider defaultAudioProvider = AudioProvider::null(),
+        std::shared_ptr<AudioEncoder> audioEncoder = nullptr,
+        std::shared_ptr<Endpointer> endpointer = nullptr);
 
     /**
      * Adds an observer to be notified of AudioInputProcessor state changes.
@@ -178,6 +189,16 @@ public:
      */
     std::future<void> resetState();
 
+    /**
+     * This function enables or disables encoding of the audio uploaded in Recognize events with the @c AudioEncoder
+     * passed to @c create().  The change applies from the next Recognize event; one already streaming is not affected.
+     * This has no effect if no @c AudioEncoder was passed to @c create().
+     *
+     * @param enabled Whether LPCM audio should be encoded before it is uploaded.
+     * @return A future which indicates when the change has been applied.
+     */
+    std::future<void> setEncodingEnabled(bool enabled);
+
     /// @name StateProviderInterface Functions
     /// @{
     void provideState(const avsCommon::avs::NamespaceAndName& stateProviderName, unsigned int stateRequestToken)
@@ -230,6 +251,11 @@ private:
      * @param defaultAudioProvider A default @c avsCommon::AudioProvider to use for ExpectSpeech if the previous
      *     provider is not readable (@c AudioProvider::alwaysReadable).  This parameter is optional, and ignored if set
      *     to @c AudioProvider::null().
+     * @param speculativeRecognize Whether to acquire the dialog channel in parallel with the context request instead
+     *     of waiting for the context to arrive first.
+     * @param audioEncoder An optional @c AudioEncoder used to compress LPCM audio before it is uploaded.
+     * @param isEncodingEnabled Whether @c audioEncoder is used until @c setEncodingEnabled() is called.
+     * @param endpointer An optional @c Endpointer used to stop capture when the end of speech is detected locally.
      *
      * @note This constructor is private so that users are forced to use the @c create() factory function.  The primary
      *     reason for this is to ensure that a @c std::shared_ptr to the instance exists, which is a requirement for
@@ -242,7 +268,11 @@ private:
         std::shared_ptr<avsCommon::sdkInterfaces::FocusManagerInterface> focusManager,
         std::shared_ptr<avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionEncounteredSender,
         std::shared_ptr<avsCommon::sdkInterfaces::UserActivityNotifierInterface> userActivityNotifier,
-        AudioProvider defaultAudioProvider);
+        AudioProvider defaultAudioProvider,
+        bool speculativeRecognize,
+        std::shared_ptr<AudioEncoder> audioEncoder,
+        bool isEncodingEnabled,
+        std::shared_ptr<Endpointer> endpointer);
 
     /// @name RequiresShutdown Functions
     /// @{
@@ -337,13 +367,25 @@ private:
      *     empty string.  This parameter is ignored if initiator is not @c WAKEWORD.  The only value currently
      *     accepted by AVS for keyword is "ALEXA".  See
      *     https://developer.amazon.com/public/solutions/alexa/alexa-voice-service/reference/context#recognizerstate
+     * @param keywordEnd The @c Index in @c audioProvider.stream where the wakeword ends.  This parameter is optional,
+     *     and defaults to @c INVALID_INDEX.  If specified, local endpointing starts here rather than at @c begin, so the
+     *     pause after the wakeword is not mistaken for the end of the utterance.
      * @return @c true if the Recognize Event was started successfully, else @c false.
      */
     bool executeRecognize(
         AudioProvider provider,
         const std::string& initiatorJson,
         avsCommon::avs::AudioInputStream::Index begin = INVALID_INDEX,
-        const std::string& keyword = "");
+        const std::string& keyword = "",
+        avsCommon::avs::AudioInputStream::Index keywordEnd = INVALID_INDEX);
+
+    /**
+     * This function handles the end of speech reported by @c m_endpointer.  If the utterance it was reported for is
+     * still being captured, capture is stopped after the audio already captured has been sent.
+     *
+     * @param reader The attachment reader of the utterance the end of speech was detected in.
+     */
+    void executeOnEndOfSpeech(std::shared_ptr<avsCommon::avs::attachment::InProcessAttachmentReader> reader);
 
     /**
      * This function receives the full system context from @c ContextManager.  Context requests are initiated by
@@ -398,6 +440,14 @@ private:
      */
     void executeResetState();
 
+    /**
+     * This function asks @c FocusManager for the dialog channel, unless it is already held or a request is already
+     * outstanding.
+     *
+     * @return @c true if the channel is held or was requested successfully, else @c false.
+     */
+    bool executeAcquireChannel();
+
     /**
      * This function tells the @c AudioInputProcessor to expect a Recognize event within the specified timeout.  If the
      * previous or default @c AudioProvider is capable of streaming immediately, this function will start the Recognize
@@ -475,6 +525,19 @@ private:
     /// The @c UserInactivityMonitor used to reset the inactivity timer of the user.
     std::shared_ptr<avsCommon::sdkInterfaces::UserActivityNotifierInterface> m_userActivityNotifier;
 
+    /**
+     * Whether the speculative Recognize path is enabled.  When set, the dialog channel is requested as soon as a
+     * Recognize starts, in parallel with the context request, so the event can go out as soon as context arrives.
+     * This is read from the "speculativeRecognize" key of the "audioInputProcessor" configuration node.
+     */
+    const bool m_speculativeRecognize;
+
+    /// The optional encoder used to compress LPCM audio before it is uploaded.
+    std::shared_ptr<AudioEncoder> m_audioEncoder;
+
+    /// The optional endpointer used to stop capture when the end of speech is detected locally.
+    std::shared_ptr<Endpointer> m_endpointer;
+
     /// Timer which runs in the @c EXPECTING_SPEECH state.
     avsCommon::utils::timing::Timer m_expectingSpeechTimer;
 
@@ -508,6 +571,22 @@ private:
      */
     std::shared_ptr<avsCommon::avs::attachment::InProcessAttachmentReader> m_reader;
 
+    /// Whether LPCM audio is uploaded through @c m_audioEncoder, if there is one.
+    bool m_isEncodingEnabled;
+
+    /**
+     * Whether @c m_reader is reading the output of @c m_audioEncoder rather than the @c AudioProvider stream directly.
+     * In that case, ending the upload is done by stopping the encoder, which closes the encoded stream once the
+     * pending audio has been encoded.
+     */
+    bool m_isEncoding;
+
+    /**
+     * Whether capture of the current utterance was stopped by @c m_endpointer.  In that case, a @c StopCapture
+     * directive which arrives afterwards is redundant rather than an error.
+     */
+    bool m_isEndOfSpeechDetectedLocally;
+
     /**
      * The payload for a ReportEchoSpatialPerceptionData event.  This string is populated by a call to @c
      * executeRecognize(), and later consumed by a call to @c executeOnContextAvailable() when the context arrives and
@@ -547,6 +626,9 @@ private:
     /// The current focus state of the @c AudioInputProcessor on the dialog channel.
     avsCommon::avs::FocusState m_focusState;
 
+    /// Whether a request for the dialog channel is outstanding and has not been answered by @c onFocusChanged() yet.
+    bool m_focusRequested;
+
     /**
      * The most recent wakeword used.  This variable defaults to "ALEXA", and is updated whenever a wakeword-enabled
      * call to @c executeRecognize() is made.  The @c executeProvideState() function uses this variable to populate the
@@ -0,0 +1,97 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_CAPABILITYAGENTS_AIP_INCLUDE_AIP_ENCODERCONTEXT_H_
+#define ALEXA_CLIENT_SDK_CAPABILITYAGENTS_AIP_INCLUDE_AIP_ENCODERCONTEXT_H_
+
+#include <cstdint>
+#include <string>
+
+#include <AVSCommon/Utils/AudioFormat.h>
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace aip {
+
+/**
+ * An @c EncoderContext wraps a specific audio codec for use by @c AudioEncoder.  The @c AudioEncoder owns the thread
+ * and the streams; the @c EncoderContext only converts one frame of 16-bit LPCM samples at a time into encoded bytes.
+ *
+ * An @c EncoderContext is only ever used from one thread at a time, so implementations need no synchronization.
+ */
+class EncoderContext {
+public:
+    /**
+     * Destructor.
+     */
+    virtual ~EncoderContext() = default;
+
+    /**
+     * Prepare the codec for a new encoding session.  This is called each time @c AudioEncoder starts encoding.
+     *
+     * @param inputFormat The @c AudioFormat of the LPCM samples which will be passed to @c processSamples().
+     * @return @c true if the codec supports @c inputFormat and is ready to encode, else @c false.
+     */
+    virtual bool init(const avsCommon::utils::AudioFormat& inputFormat) = 0;
+
+    /**
+     * Get the number of input samples which make up one frame.  Each call to @c processSamples() receives exactly
+     * this many samples.
+     *
+     * @return The number of input samples per frame.
+     */
+    virtual size_t getInputFrameSize() const = 0;
+
+    /**
+     * Get the maximum number of bytes produced by a single call to @c processSamples().
+     *
+     * @return The maximum size of one encoded frame in bytes.
+     */
+    virtual size_t getOutputFrameSize() const = 0;
+
+    /**
+     * Get the @c AudioFormat of the encoded output.
+     *
+     * @return The @c AudioFormat of the encoded output.
+     */
+    virtual avsCommon::utils::AudioFormat getAudioFormat() const = 0;
+
+    /**
+     * Get the format name to report to AVS in the Recognize event for the encoded output.
+     *
+     * @return The AVS format name of the encoded output.
+     */
+    virtual std::string getAVSFormatName() const = 0;
+
+    /**
+     * Encode one frame of samples.
+     *
+     * @param input Pointer to @c getInputFrameSize() samples to encode.
+     * @param output Buffer of at least @c getOutputFrameSize() bytes to receive the encoded frame.
+     * @return The number of bytes written to @c output, or a negative value if encoding failed.
+     */
+    virtual ssize_t processSamples(const int16_t* input, uint8_t* output) = 0;
+
+    /**
+     * Release any per-session codec state.  This is called each time @c AudioEncoder finishes encoding.
+     */
+    virtual void close() = 0;
+};
+
+}  // namespace aip
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_CAPABILITYAGENTS_AIP_INCLUDE_AIP_ENCODERCONTEXT_H_
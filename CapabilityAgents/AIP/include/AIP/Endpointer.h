@@ -0,0 +1,141 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_CAPABILITYAGENTS_AIP_INCLUDE_AIP_ENDPOINTER_H_
+#define ALEXA_CLIENT_SDK_CAPABILITYAGENTS_AIP_INCLUDE_AIP_ENDPOINTER_H_
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <AVSCommon/AVS/AudioInputStream.h>
+#include <AVSCommon/SDKInterfaces/VoiceActivityDetectorInterface.h>
+#include <AVSCommon/Utils/AudioFormat.h>
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace aip {
+
+/**
+ * The @c Endpointer detects the end of an utterance on the device.  It reads the same audio that is being uploaded in a
+ * Recognize event, classifies each frame with a @c VoiceActivityDetectorInterface, and reports the end of speech once
+ * the user has been silent for a configurable hangover period after speaking.
+ *
+ * This lets @c AudioInputProcessor stop streaming when the user stops talking instead of waiting for the @c StopCapture
+ * directive, which saves the upload of trailing silence and the network round trip.  If no speech is heard, or the
+ * endpointer falls behind the writer, nothing is reported and AVS endpointing applies as usual.
+ */
+class Endpointer {
+public:
+    /**
+     * Callback to report the end of speech.
+     *
+     * @param endOfSpeech The index in the stream just after the last frame containing speech.  The end of speech was
+     *     detected one hangover period after this.
+     */
+    using EndOfSpeechCallback = std::function<void(avsCommon::avs::AudioInputStream::Index endOfSpeech)>;
+
+    /**
+     * Creates a new @c Endpointer instance.
+     *
+     * @param voiceActivityDetector The detector used to classify frames as speech or non-speech.
+     * @param hangover How long the user must be silent after speaking before the end of speech is reported.
+     * @return A @c std::shared_ptr to the new @c Endpointer, or @c nullptr if the operation failed.
+     */
+    static std::shared_ptr<Endpointer> create(
+        std::shared_ptr<avsCommon::sdkInterfaces::VoiceActivityDetectorInterface> voiceActivityDetector,
+        std::chrono::milliseconds hangover = DEFAULT_HANGOVER);
+
+    /**
+     * Destructor.  Stops any utterance in progress.
+     */
+    ~Endpointer();
+
+    /**
+     * Start looking for the end of speech in @c stream.  Any utterance already in progress is stopped first.
+     *
+     * @param stream The stream to read audio from.
+     * @param format The @c AudioFormat of @c stream, which must be 16-bit LPCM.
+     * @param begin The position in @c stream to start reading from.
+     * @param reference The reference @c begin is relative to.
+     * @param callback Called at most once, from an internal thread, when the end of speech is detected.
+     * @return @c true if endpointing was started, else @c false.
+     */
+    bool start(
+        std::shared_ptr<avsCommon::avs::AudioInputStream> stream,
+        const avsCommon::utils::AudioFormat& format,
+        avsCommon::avs::AudioInputStream::Index begin,
+        avsCommon::avs::AudioInputStream::Reader::Reference reference,
+        EndOfSpeechCallback callback);
+
+    /**
+     * Stop looking for the end of speech.  Once this returns, the callback passed to @c start() will not be called.
+     */
+    void stop();
+
+    /// The default hangover.
+    static const std::chrono::milliseconds DEFAULT_HANGOVER;
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param voiceActivityDetector The detector used to classify frames as speech or non-speech.
+     * @param hangover How long the user must be silent after speaking before the end of speech is reported.
+     */
+    Endpointer(
+        std::shared_ptr<avsCommon::sdkInterfaces::VoiceActivityDetectorInterface> voiceActivityDetector,
+        std::chrono::milliseconds hangover);
+
+    /**
+     * The endpointing loop, which runs on @c m_thread until the end of speech is found, the stream is closed, or
+     * @c stop() is called.
+     *
+     * @param reader The reader for the audio stream.
+     * @param hangoverSamples The hangover in samples.
+     * @param callback The callback to report the end of speech to.
+     */
+    void endpointingLoop(
+        std::shared_ptr<avsCommon::avs::AudioInputStream::Reader> reader,
+        avsCommon::avs::AudioInputStream::Index hangoverSamples,
+        EndOfSpeechCallback callback);
+
+    /// The detector used to classify frames.  This is only accessed from @c m_thread while an utterance is running.
+    std::shared_ptr<avsCommon::sdkInterfaces::VoiceActivityDetectorInterface> m_voiceActivityDetector;
+
+    /// How long the user must be silent after speaking before the end of speech is reported.
+    const std::chrono::milliseconds m_hangover;
+
+    /// Serializes @c start() and @c stop(), and protects @c m_reader.
+    std::mutex m_mutex;
+
+    /// The reader for the current utterance.
+    std::shared_ptr<avsCommon::avs::AudioInputStream::Reader> m_reader;
+
+    /// Flag which tells @c m_thread to exit.
+    std::atomic<bool> m_isStopping;
+
+    /// The thread which runs @c endpointingLoop().
+    std::thread m_thread;
+};
+
+}  // namespace aip
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_CAPABILITYAGENTS_AIP_INCLUDE_AIP_ENDPOINTER_H_
@@ -0,0 +1,63 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_CAPABILITYAGENTS_AIP_INCLUDE_AIP_OPUSENCODERCONTEXT_H_
+#define ALEXA_CLIENT_SDK_CAPABILITYAGENTS_AIP_INCLUDE_AIP_OPUSENCODERCONTEXT_H_
+
+#include <opus.h>
+
+#include "EncoderContext.h"
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace aip {
+
+/**
+ * An @c EncoderContext which uses libopus to encode 16 kHz mono LPCM into the constant bitrate Opus stream accepted
+ * by AVS (32 kbit/s, 20 ms frames, no container).
+ */
+class OpusEncoderContext : public EncoderContext {
+public:
+    /**
+     * Constructor.
+     */
+    OpusEncoderContext();
+
+    /**
+     * Destructor.
+     */
+    ~OpusEncoderContext() override;
+
+    /// @name EncoderContext Functions
+    /// @{
+    bool init(const avsCommon::utils::AudioFormat& inputFormat) override;
+    size_t getInputFrameSize() const override;
+    size_t getOutputFrameSize() const override;
+    avsCommon::utils::AudioFormat getAudioFormat() const override;
+    std::string getAVSFormatName() const override;
+    ssize_t processSamples(const int16_t* input, uint8_t* output) override;
+    void close() override;
+    /// @}
+
+private:
+    /// The libopus encoder state for the current session, or @c nullptr between sessions.
+    OpusEncoder* m_encoder;
+};
+
+}  // namespace aip
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_CAPABILITYAGENTS_AIP_INCLUDE_AIP_OPUSENCODERCONTEXT_H_
@@ -0,0 +1,258 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <vector>
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "AIP/AudioEncoder.h"
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace aip {
+
+using namespace avsCommon::avs;
+using namespace avsCommon::utils;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("AudioEncoder");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The word size of the encoded stream; encoded frames are written as raw bytes.
+static const size_t ENCODED_WORD_SIZE = 1;
+
+/// The maximum number of readers of the encoded stream.
+static const size_t ENCODED_MAX_READERS = 1;
+
+/// The word size of the LPCM input stream.
+static const size_t INPUT_WORD_SIZE = sizeof(int16_t);
+
+/// How long a single read or write waits before re-checking whether the session was stopped.
+static const std::chrono::milliseconds WAIT_TIMEOUT{100};
+
+std::shared_ptr<AudioEncoder> AudioEncoder::create(
+    std::unique_ptr<EncoderContext> encoderContext,
+    size_t lookAheadFrames) {
+    if (!encoderContext) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "nullEncoderContext"));
+        return nullptr;
+    }
+    if (0 == lookAheadFrames) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "zeroLookAheadFrames"));
+        return nullptr;
+    }
+    if (0 == encoderContext->getInputFrameSize() || 0 == encoderContext->getOutputFrameSize()) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "invalidFrameSize"));
+        return nullptr;
+    }
+    return std::shared_ptr<AudioEncoder>(new AudioEncoder(std::move(encoderContext), lookAheadFrames));
+}
+
+AudioEncoder::AudioEncoder(std::unique_ptr<EncoderContext> encoderContext, size_t lookAheadFrames) :
+        m_encoderContext{std::move(encoderContext)},
+        m_lookAheadFrames{lookAheadFrames},
+        m_stopImmediately{false} {
+}
+
+AudioEncoder::~AudioEncoder() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    stopAndJoinLocked();
+}
+
+std::shared_ptr<AudioInputStream> AudioEncoder::startEncoding(
+    std::shared_ptr<AudioInputStream> inputStream,
+    const AudioFormat& inputFormat,
+    AudioInputStream::Index begin,
+    AudioInputStream::Reader::Reference reference) {
+    if (!inputStream) {
+        ACSDK_ERROR(LX("startEncodingFailed").d("reason", "nullInputStream"));
+        return nullptr;
+    }
+    if (inputFormat.encoding != AudioFormat::Encoding::LPCM || inputFormat.sampleSizeInBits != INPUT_WORD_SIZE * 8 ||
+        inputStream->getWordSize() != INPUT_WORD_SIZE) {
+        ACSDK_ERROR(LX("startEncodingFailed")
+                        .d("reason", "unsupportedInputFormat")
+                        .d("encoding", inputFormat.encoding)
+                        .d("sampleSize", inputFormat.sampleSizeInBits));
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    stopAndJoinLocked();
+
+    if (!m_encoderContext->init(inputFormat)) {
+        ACSDK_ERROR(LX("startEncodingFailed").d("reason", "encoderContextInitFailed"));
+        return nullptr;
+    }
+
+    auto bufferSize = AudioInputStream::calculateBufferSize(
+        m_lookAheadFrames * m_encoderContext->getOutputFrameSize(), ENCODED_WORD_SIZE, ENCODED_MAX_READERS);
+    auto buffer = std::make_shared<AudioInputStream::Buffer>(bufferSize);
+    std::shared_ptr<AudioInputStream> outputStream =
+        AudioInputStream::create(buffer, ENCODED_WORD_SIZE, ENCODED_MAX_READERS);
+    if (!outputStream) {
+        ACSDK_ERROR(LX("startEncodingFailed").d("reason", "createOutputStreamFailed"));
+        m_encoderContext->close();
+        return nullptr;
+    }
+    std::shared_ptr<AudioInputStream::Writer> writer =
+        outputStream->createWriter(AudioInputStream::Writer::Policy::BLOCKING);
+    std::shared_ptr<AudioInputStream::Reader> reader =
+        inputStream->createReader(AudioInputStream::Reader::Policy::BLOCKING);
+    if (!writer || !reader) {
+        ACSDK_ERROR(LX("startEncodingFailed").d("reason", "createReaderOrWriterFailed"));
+        m_encoderContext->close();
+        return nullptr;
+    }
+    if (!reader->seek(begin, reference)) {
+        ACSDK_ERROR(LX("startEncodingFailed").d("reason", "seekFailed").d("begin", begin));
+        m_encoderContext->close();
+        return nullptr;
+    }
+
+    m_inputReader = reader;
+    m_stopImmediately = false;
+    m_encodingThread = std::thread(&AudioEncoder::encodingLoop, this, reader, writer, inputFormat.sampleRateHz);
+    return outputStream;
+}
+
+void AudioEncoder::stopEncoding(bool stopImmediately) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_inputReader) {
+        return;
+    }
+    if (stopImmediately) {
+        m_stopImmediately = true;
+        m_inputReader->close();
+    } else {
+        // Let the encoder drain everything written so far, then see the input as closed.
+        m_inputReader->close(0, AudioInputStream::Reader::Reference::BEFORE_WRITER);
+    }
+    m_inputReader.reset();
+}
+
+AudioFormat AudioEncoder::getAudioFormat() const {
+    return m_encoderContext->getAudioFormat();
+}
+
+std::string AudioEncoder::getAVSFormatName() const {
+    return m_encoderContext->getAVSFormatName();
+}
+
+void AudioEncoder::stopAndJoinLocked() {
+    if (m_inputReader) {
+        m_stopImmediately = true;
+        m_inputReader->close();
+        m_inputReader.reset();
+    }
+    if (m_encodingThread.joinable()) {
+        m_stopImmediately = true;
+        m_encodingThread.join();
+    }
+}
+
+void AudioEncoder::encodingLoop(
+    std::shared_ptr<AudioInputStream::Reader> reader,
+    std::shared_ptr<AudioInputStream::Writer> writer,
+    unsigned int inputSampleRateHz) {
+    const size_t frameSize = m_encoderContext->getInputFrameSize();
+    std::vector<int16_t> input(frameSize);
+    std::vector<uint8_t> output(m_encoderContext->getOutputFrameSize());
+    size_t samplesInFrame = 0;
+    uint64_t samplesEncoded = 0;
+    uint64_t bytesEncoded = 0;
+    std::chrono::steady_clock::duration encodeTime{0};
+
+    bool inputClosed = false;
+    while (!inputClosed && !m_stopImmediately) {
+        auto wordsRead = reader->read(input.data() + samplesInFrame, frameSize - samplesInFrame, WAIT_TIMEOUT);
+        if (wordsRead > 0) {
+            samplesInFrame += wordsRead;
+            if (samplesInFrame < frameSize) {
+                continue;
+            }
+        } else if (AudioInputStream::Reader::Error::TIMEDOUT == wordsRead) {
+            continue;
+        } else {
+            if (wordsRead != AudioInputStream::Reader::Error::CLOSED) {
+                ACSDK_ERROR(LX("encodingLoopFailed").d("reason", "readFailed").d("error", wordsRead));
+                break;
+            }
+            inputClosed = true;
+            if (0 == samplesInFrame) {
+                break;
+            }
+            // Pad the final partial frame with silence so the codec always sees whole frames.
+            std::fill(input.begin() + samplesInFrame, input.end(), 0);
+        }
+
+        auto encodeStart = std::chrono::steady_clock::now();
+        auto bytes = m_encoderContext->processSamples(input.data(), output.data());
+        encodeTime += std::chrono::steady_clock::now() - encodeStart;
+        if (bytes < 0) {
+            ACSDK_ERROR(LX("encodingLoopFailed").d("reason", "processSamplesFailed"));
+            break;
+        }
+        samplesEncoded += samplesInFrame;
+        samplesInFrame = 0;
+        if (!writeEncodedBytes(writer, output.data(), bytes)) {
+            break;
+        }
+        bytesEncoded += bytes;
+    }
+
+    writer->close();
+    m_encoderContext->close();
+
+    auto audioMs = inputSampleRateHz ? samplesEncoded * 1000 / inputSampleRateHz : 0;
+    auto encodeMs = std::chrono::duration_cast<std::chrono::milliseconds>(encodeTime).count();
+    ACSDK_INFO(LX("encodingFinished")
+                   .d("audioMs", audioMs)
+                   .d("encodeMs", encodeMs)
+                   .d("encodeMsPerAudioSecond", audioMs ? encodeMs * 1000.0 / audioMs : 0)
+                   .d("inputBytes", samplesEncoded * INPUT_WORD_SIZE)
+                   .d("outputBytes", bytesEncoded));
+}
+
+bool AudioEncoder::writeEncodedBytes(
+    std::shared_ptr<AudioInputStream::Writer> writer,
+    const uint8_t* data,
+    size_t size) {
+    size_t written = 0;
+    while (written < size) {
+        if (m_stopImmediately) {
+            return false;
+        }
+        auto result = writer->write(data + written, size - written, WAIT_TIMEOUT);
+        if (result > 0) {
+            written += result;
+        } else if (result != AudioInputStream::Writer::Error::TIMEDOUT) {
+            ACSDK_ERROR(LX("writeEncodedBytesFailed").d("reason", "writeFailed").d("error", result));
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace aip
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
@@ -17,6 +17,7 @@
 
 #include <AVSCommon/AVS/FocusState.h>
 #include <AVSCommon/AVS/MessageRequest.h>
+#include <AVSCommon/Utils/Configuration/ConfigurationNode.h>
 #include <AVSCommon/Utils/JSON/JSONUtils.h>
 #include <AVSCommon/Utils/Logger/Logger.h>
 #include <AVSCommon/Utils/Memory/Memory.h>
@@ -59,6 +60,15 @@ static const avsCommon::avs::NamespaceAndName RECOGNIZER_STATE{NAMESPACE, "Recog
 /// The field identifying the initiator.
 static const std::string INITIATOR_KEY = "initiator";
 
+/// The root key for @c AudioInputProcessor settings in the configuration file.
+static const std::string AUDIO_INPUT_PROCESSOR_CONFIGURATION_ROOT_KEY = "audioInputProcessor";
+
+/// The key in our config file to enable the speculative Recognize path.
+static const std::string SPECULATIVE_RECOGNIZE_KEY = "speculativeRecognize";
+
+/// The key in our config file to encode Recognize audio with the @c AudioEncoder, if there is one.
+static const std::string ENCODE_AUDIO_KEY = "encodeAudio";
+
 std::shared_ptr<AudioInputProcessor> AudioInputProcessor::create(
     std::shared_ptr<avsCommon::sdkInterfaces::DirectiveSequencerInterface> directiveSequencer,
     std::shared_ptr<avsCommon::sdkInterfaces::MessageSenderInterface> messageSender,
@@ -67,7 +77,9 @@ std::shared_ptr<AudioInputProcessor> AudioInputProcessor::create(
     std::shared_ptr<avsCommon::avs::DialogUXStateAggregator> dialogUXStateAggregator,
     std::shared_ptr<avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionEncounteredSender,
     std::shared_ptr<avsCommon::sdkInterfaces::UserActivityNotifierInterface> userActivityNotifier,
-    AudioProvider defaultAudioProvider) {
+    AudioProvider defaultAudioProvider,
+    std::shared_ptr<AudioEncoder> audioEncoder,
+    std::shared_ptr<Endpointer> endpointer) {
     if (!directiveSequencer) {
         ACSDK_ERROR(LX("createFailed").d("reason", "nullDirectiveSequencer"));
         return nullptr;
@@ -91,6 +103,13 @@ std::shared_ptr<AudioInputProcessor> AudioInputProcessor::create(
         return nullptr;
     }
 
+    auto configurationRoot =
+        avsCommon::utils::configuration::ConfigurationNode::getRoot()[AUDIO_INPUT_PROCESSOR_CONFIGURATION_ROOT_KEY];
+    bool speculativeRecognize = false;
+    configurationRoot.getBool(SPECULATIVE_RECOGNIZE_KEY, &speculativeRecognize, false);
+    bool isEncodingEnabled = false;
+    configurationRoot.getBool(ENCODE_AUDIO_KEY, &isEncodingEnabled, false);
+
     auto aip = std::shared_ptr<AudioInputProcessor>(new AudioInputProcessor(
         directiveSequencer,
         messageSender,
@@ -98,7 +117,11 @@ std::shared_ptr<AudioInputProcessor> AudioInputProcessor::create(
         focusManager,
         exceptionEncounteredSender,
         userActivityNotifier,
-        defaultAudioProvider));
+        defaultAudioProvider,
+        speculativeRecognize,
+        audioEncoder,
+        isEncodingEnabled,
+        endpointer));
 
     if (aip) {
         contextManager->setStateProvider(RECOGNIZER_STATE, aip);
@@ -172,6 +195,10 @@ std::future<void> AudioInputProcessor::resetState() {
     return m_executor.submit([this]() { executeResetState(); });
 }
 
+std::future<void> AudioInputProcessor::setEncodingEnabled(bool enabled) {
+    return m_executor.submit([this, enabled]() { m_isEncodingEnabled = enabled; });
+}
+
 void AudioInputProcessor::provideState(
     const avsCommon::avs::NamespaceAndName& stateProviderName,
     unsigned int stateRequestToken) {
@@ -245,7 +272,11 @@ AudioInputProcessor::AudioInputProcessor(
     std::shared_ptr<avsCommon::sdkInterfaces::FocusManagerInterface> focusManager,
     std::shared_ptr<avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionEncounteredSender,
     std::shared_ptr<avsCommon::sdkInterfaces::UserActivityNotifierInterface> userActivityNotifier,
-    AudioProvider defaultAudioProvider) :
+    AudioProvider defaultAudioProvider,
+    bool speculativeRecognize,
+    std::shared_ptr<AudioEncoder> audioEncoder,
+    bool isEncodingEnabled,
+    std::shared_ptr<Endpointer> endpointer) :
         CapabilityAgent{NAMESPACE, exceptionEncounteredSender},
         RequiresShutdown{"AudioInputProcessor"},
         m_directiveSequencer{directiveSequencer},
@@ -253,10 +284,17 @@ AudioInputProcessor::AudioInputProcessor(
         m_contextManager{contextManager},
         m_focusManager{focusManager},
         m_userActivityNotifier{userActivityNotifier},
+        m_speculativeRecognize{speculativeRecognize},
+        m_audioEncoder{audioEncoder},
+        m_endpointer{endpointer},
         m_defaultAudioProvider{defaultAudioProvider},
         m_lastAudioProvider{AudioProvider::null()},
+        m_isEncodingEnabled{isEncodingEnabled},
+        m_isEncoding{false},
+        m_isEndOfSpeechDetectedLocally{false},
         m_state{ObserverInterface::State::IDLE},
         m_focusState{avsCommon::avs::FocusState::NONE},
+        m_focusRequested{false},
         m_preparingToSend{false},
         m_initialDialogUXStateReceived{false},
         m_precedingExpectSpeechInitiator{nullptr} {
@@ -377,14 +415,15 @@ bool AudioInputProcessor::executeRecognize(
                R"(})";
     // clang-format on
 
-    return executeRecognize(provider, initiatorJson.str(), begin, keyword);
+    return executeRecognize(provider, initiatorJson.str(), begin, keyword, end);
 }
 
 bool AudioInputProcessor::executeRecognize(
     AudioProvider provider,
     const std::string& initiatorJson,
     avsCommon::avs::AudioInputStream::Index begin,
-    const std::string& keyword) {
+    const std::string& keyword,
+    avsCommon::avs::AudioInputStream::Index keywordEnd) {
     if (!provider.stream) {
         ACSDK_ERROR(LX("executeRecognizeFailed").d("reason", "nullAudioInputStream"));
         return false;
@@ -408,7 +447,8 @@ bool AudioInputProcessor::executeRecognize(
                 return false;
             }
 
-            avsEncodingFormat = "AUDIO_L16_RATE_16000_CHANNELS_1";
+            avsEncodingFormat = m_audioEncoder && m_isEncodingEnabled ? m_audioEncoder->getAVSFormatName()
+                                                                      : "AUDIO_L16_RATE_16000_CHANNELS_1";
             break;
         case avsCommon::utils::AudioFormat::Encoding::OPUS:
             itSampleRateAVSEncoding = mapSampleRatesAVSEncoding.find(provider.format.sampleRateHz);
@@ -496,12 +536,57 @@ bool AudioInputProcessor::executeRecognize(
         offset = begin;
         reference = avsCommon::avs::attachment::InProcessAttachmentReader::SDSTypeReader::Reference::ABSOLUTE;
     }
+    // Local endpointing reads the raw audio from the end of the wakeword if we know it, else from where the upload
+    // starts.
+    auto endpointerOffset = offset;
+    auto endpointerReference = reference;
+    if (INVALID_INDEX != keywordEnd) {
+        endpointerOffset = keywordEnd;
+        endpointerReference =
+            avsCommon::avs::attachment::InProcessAttachmentReader::SDSTypeReader::Reference::ABSOLUTE;
+    }
+    // If encoding is enabled, upload the encoder's output instead of the raw audio.  The encoder starts reading the
+    // provider's stream from the requested position, so the attachment starts at the beginning of the encoded stream.
+    auto uploadStream = provider.stream;
+    bool useEncoder = m_audioEncoder && m_isEncodingEnabled &&
+                      avsCommon::utils::AudioFormat::Encoding::LPCM == provider.format.encoding;
+    if (useEncoder) {
+        uploadStream = m_audioEncoder->startEncoding(provider.stream, provider.format, offset, reference);
+        if (!uploadStream) {
+            ACSDK_ERROR(LX("executeRecognizeFailed").d("reason", "Failed to start encoding"));
+            return false;
+        }
+        offset = 0;
+        reference = avsCommon::avs::attachment::InProcessAttachmentReader::SDSTypeReader::Reference::ABSOLUTE;
+    }
     m_reader = avsCommon::avs::attachment::InProcessAttachmentReader::create(
-        sds::ReaderPolicy::NONBLOCKING, provider.stream, offset, reference);
+        sds::ReaderPolicy::NONBLOCKING, uploadStream, offset, reference);
     if (!m_reader) {
         ACSDK_ERROR(LX("executeRecognizeFailed").d("reason", "Failed to create attachment reader"));
+        if (useEncoder) {
+            m_audioEncoder->stopEncoding(true);
+        }
         return false;
     }
+    m_isEncoding = useEncoder;
+
+    // Don't endpoint locally for close-talk, where the user decides when the utterance ends.
+    m_isEndOfSpeechDetectedLocally = false;
+    if (m_endpointer && ASRProfile::CLOSE_TALK != provider.profile &&
+        avsCommon::utils::AudioFormat::Encoding::LPCM == provider.format.encoding) {
+        auto reader = m_reader;
+        if (!m_endpointer->start(
+                provider.stream,
+                provider.format,
+                endpointerOffset,
+                endpointerReference,
+                [this, reader](avsCommon::avs::AudioInputStream::Index endOfSpeech) {
+                    m_executor.submit([this, reader]() { executeOnEndOfSpeech(reader); });
+                })) {
+            // AVS will still endpoint the utterance, so carry on without local endpointing.
+            ACSDK_WARN(LX("startEndpointerFailed"));
+        }
+    }
 
     // Code below this point changes the state of AIP.  Formally update state now, and don't error out without calling
     // executeResetState() after this point.
@@ -519,6 +604,14 @@ bool AudioInputProcessor::executeRecognize(
     //  Start assembling the context; we'll service the callback after assembling our Recognize event.
     m_contextManager->getContext(shared_from_this());
 
+    // In speculative mode, acquire the channel while context is being gathered rather than after it arrives, so the
+    // Recognize event can be sent as soon as the context is available.
+    if (m_speculativeRecognize && !executeAcquireChannel()) {
+        ACSDK_ERROR(LX("executeRecognizeFailed").d("reason", "Unable to acquire channel"));
+        executeResetState();
+        return false;
+    }
+
     // Stop the ExpectSpeech timer so we don't get a timeout.
     m_expectingSpeechTimer.stop();
 
@@ -558,12 +651,10 @@ void AudioInputProcessor::executeOnContextAvailable(const std::string jsonContex
     }
 
     // Start acquiring the channel right away; we'll service the callback after assembling our Recognize event.
-    if (m_focusState != avsCommon::avs::FocusState::FOREGROUND) {
-        if (!m_focusManager->acquireChannel(CHANNEL_NAME, shared_from_this(), NAMESPACE)) {
-            ACSDK_ERROR(LX("executeOnContextAvailableFailed").d("reason", "Unable to acquire channel"));
-            executeResetState();
-            return;
-        }
+    if (!executeAcquireChannel()) {
+        ACSDK_ERROR(LX("executeOnContextAvailableFailed").d("reason", "Unable to acquire channel"));
+        executeResetState();
+        return;
     }
 
     // Assemble the MessageRequest.  It will be sent by executeOnFocusChanged when we acquire the channel.
@@ -596,6 +687,7 @@ void AudioInputProcessor::executeOnFocusChanged(avsCommon::avs::FocusState newFo
 
     // Note new focus state.
     m_focusState = newFocus;
+    m_focusRequested = false;
 
     // If we're losing focus, stop using the channel.
     if (newFocus != avsCommon::avs::FocusState::FOREGROUND) {
@@ -620,6 +712,15 @@ bool AudioInputProcessor::executeStopCapture(bool stopImmediately, std::shared_p
         ACSDK_DEBUG(LX("stopCaptureIgnored").d("reason", "isCancelled"));
         return true;
     }
+    if (info && ObserverInterface::State::BUSY == m_state && m_isEndOfSpeechDetectedLocally) {
+        // We already stopped capture at the locally detected end of speech.
+        ACSDK_DEBUG(LX("stopCaptureIgnored").d("reason", "endOfSpeechDetectedLocally"));
+        if (info->result) {
+            info->result->setCompleted();
+        }
+        removeDirective(info);
+        return true;
+    }
     if (m_state != ObserverInterface::State::RECOGNIZING) {
         static const char* errorMessage = "StopCapture only allowed in RECOGNIZING state.";
         if (info) {
@@ -637,7 +738,17 @@ bool AudioInputProcessor::executeStopCapture(bool stopImmediately, std::shared_p
     // Create a lambda to do the StopCapture.
     std::function<void()> stopCapture = [=] {
         ACSDK_DEBUG(LX("stopCapture").d("stopImmediately", stopImmediately));
-        if (stopImmediately) {
+        if (m_endpointer) {
+            m_endpointer->stop();
+        }
+        if (m_isEncoding) {
+            // The encoder closes its output once the audio captured so far is encoded, which ends the upload.
+            m_audioEncoder->stopEncoding(stopImmediately);
+            m_isEncoding = false;
+            if (stopImmediately) {
+                m_reader->close(avsCommon::avs::attachment::AttachmentReader::ClosePoint::IMMEDIATELY);
+            }
+        } else if (stopImmediately) {
             m_reader->close(avsCommon::avs::attachment::AttachmentReader::ClosePoint::IMMEDIATELY);
         } else {
             m_reader->close(avsCommon::avs::attachment::AttachmentReader::ClosePoint::AFTER_DRAINING_CURRENT_BUFFER);
@@ -669,6 +780,14 @@ void AudioInputProcessor::executeResetState() {
     // Irrespective of current state, clean up and go back to idle.
     m_expectingSpeechTimer.stop();
     m_precedingExpectSpeechInitiator.reset();
+    if (m_endpointer) {
+        m_endpointer->stop();
+    }
+    m_isEndOfSpeechDetectedLocally = false;
+    if (m_isEncoding) {
+        m_audioEncoder->stopEncoding(true);
+        m_isEncoding = false;
+    }
     if (m_reader) {
         m_reader->close();
     }
@@ -677,13 +796,37 @@ void AudioInputProcessor::executeResetState() {
     m_espRequest.reset();
     m_preparingToSend = false;
     m_deferredStopCapture = nullptr;
-    if (m_focusState != avsCommon::avs::FocusState::NONE) {
+    if (m_focusState != avsCommon::avs::FocusState::NONE || m_focusRequested) {
         m_focusManager->releaseChannel(CHANNEL_NAME, shared_from_this());
     }
     m_focusState = avsCommon::avs::FocusState::NONE;
+    m_focusRequested = false;
     setState(ObserverInterface::State::IDLE);
 }
 
+void AudioInputProcessor::executeOnEndOfSpeech(
+    std::shared_ptr<avsCommon::avs::attachment::InProcessAttachmentReader> reader) {
+    if (reader != m_reader || m_state != ObserverInterface::State::RECOGNIZING) {
+        ACSDK_DEBUG(LX("endOfSpeechIgnored").d("reason", "staleUtterance").d("state", m_state));
+        return;
+    }
+    ACSDK_INFO(LX("localEndOfSpeech"));
+    if (executeStopCapture()) {
+        m_isEndOfSpeechDetectedLocally = true;
+    }
+}
+
+bool AudioInputProcessor::executeAcquireChannel() {
+    if (avsCommon::avs::FocusState::FOREGROUND == m_focusState || m_focusRequested) {
+        return true;
+    }
+    if (!m_focusManager->acquireChannel(CHANNEL_NAME, shared_from_this(), NAMESPACE)) {
+        return false;
+    }
+    m_focusRequested = true;
+    return true;
+}
+
 bool AudioInputProcessor::executeExpectSpeech(std::chrono::milliseconds timeout, std::shared_ptr<DirectiveInfo> info) {
     if (info && info->isCancelled) {
         ACSDK_DEBUG(LX("expectSpeechIgnored").d("reason", "isCancelled"));
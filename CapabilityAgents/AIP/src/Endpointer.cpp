@@ -0,0 +1,174 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <vector>
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "AIP/Endpointer.h"
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace aip {
+
+using namespace avsCommon::avs;
+using namespace avsCommon::sdkInterfaces;
+using namespace avsCommon::utils;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("Endpointer");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The only sample size supported by @c VoiceActivityDetectorInterface.
+static const unsigned int SAMPLE_SIZE_IN_BITS = 16;
+
+/// How long a single read waits before re-checking whether the endpointer was stopped.
+static const std::chrono::milliseconds WAIT_TIMEOUT{100};
+
+const std::chrono::milliseconds Endpointer::DEFAULT_HANGOVER{800};
+
+std::shared_ptr<Endpointer> Endpointer::create(
+    std::shared_ptr<VoiceActivityDetectorInterface> voiceActivityDetector,
+    std::chrono::milliseconds hangover) {
+    if (!voiceActivityDetector) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "nullVoiceActivityDetector"));
+        return nullptr;
+    }
+    if (0 == voiceActivityDetector->getFrameSize()) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "invalidFrameSize"));
+        return nullptr;
+    }
+    if (hangover <= std::chrono::milliseconds::zero()) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "invalidHangover").d("hangoverMs", hangover.count()));
+        return nullptr;
+    }
+    return std::shared_ptr<Endpointer>(new Endpointer(voiceActivityDetector, hangover));
+}
+
+Endpointer::Endpointer(
+    std::shared_ptr<VoiceActivityDetectorInterface> voiceActivityDetector,
+    std::chrono::milliseconds hangover) :
+        m_voiceActivityDetector{voiceActivityDetector},
+        m_hangover{hangover},
+        m_isStopping{false} {
+}
+
+Endpointer::~Endpointer() {
+    stop();
+}
+
+bool Endpointer::start(
+    std::shared_ptr<AudioInputStream> stream,
+    const AudioFormat& format,
+    AudioInputStream::Index begin,
+    AudioInputStream::Reader::Reference reference,
+    EndOfSpeechCallback callback) {
+    if (!stream || !callback) {
+        ACSDK_ERROR(LX("startFailed").d("reason", "nullStreamOrCallback"));
+        return false;
+    }
+    if (format.encoding != AudioFormat::Encoding::LPCM || format.sampleSizeInBits != SAMPLE_SIZE_IN_BITS ||
+        stream->getWordSize() != sizeof(int16_t)) {
+        ACSDK_ERROR(LX("startFailed")
+                        .d("reason", "unsupportedFormat")
+                        .d("encoding", format.encoding)
+                        .d("sampleSize", format.sampleSizeInBits));
+        return false;
+    }
+
+    stop();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::shared_ptr<AudioInputStream::Reader> reader =
+        stream->createReader(AudioInputStream::Reader::Policy::BLOCKING);
+    if (!reader) {
+        ACSDK_ERROR(LX("startFailed").d("reason", "createReaderFailed"));
+        return false;
+    }
+    if (!reader->seek(begin, reference)) {
+        ACSDK_ERROR(LX("startFailed").d("reason", "seekFailed").d("begin", begin));
+        return false;
+    }
+
+    AudioInputStream::Index hangoverSamples = m_hangover.count() * format.sampleRateHz / 1000;
+    m_reader = reader;
+    m_isStopping = false;
+    m_thread = std::thread(&Endpointer::endpointingLoop, this, reader, hangoverSamples, callback);
+    return true;
+}
+
+void Endpointer::stop() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_isStopping = true;
+    if (m_reader) {
+        m_reader->close();
+        m_reader.reset();
+    }
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void Endpointer::endpointingLoop(
+    std::shared_ptr<AudioInputStream::Reader> reader,
+    AudioInputStream::Index hangoverSamples,
+    EndOfSpeechCallback callback) {
+    const size_t frameSize = m_voiceActivityDetector->getFrameSize();
+    std::vector<int16_t> frame(frameSize);
+    size_t samplesInFrame = 0;
+    bool speechDetected = false;
+    AudioInputStream::Index endOfSpeech = 0;
+
+    m_voiceActivityDetector->reset();
+    while (!m_isStopping) {
+        auto wordsRead = reader->read(frame.data() + samplesInFrame, frameSize - samplesInFrame, WAIT_TIMEOUT);
+        if (AudioInputStream::Reader::Error::TIMEDOUT == wordsRead) {
+            continue;
+        } else if (wordsRead <= 0) {
+            // A closed stream is the normal end of an utterance which was ended some other way; anything else means we
+            // fell behind the writer, so leave endpointing to AVS.
+            if (wordsRead != AudioInputStream::Reader::Error::CLOSED) {
+                ACSDK_ERROR(LX("endpointingLoopFailed").d("reason", "readFailed").d("error", wordsRead));
+            }
+            return;
+        }
+
+        samplesInFrame += wordsRead;
+        if (samplesInFrame < frameSize) {
+            continue;
+        }
+        samplesInFrame = 0;
+
+        auto position = reader->tell();
+        if (m_voiceActivityDetector->isSpeech(frame.data())) {
+            speechDetected = true;
+            endOfSpeech = position;
+        } else if (speechDetected && position - endOfSpeech >= hangoverSamples) {
+            ACSDK_DEBUG(LX("endOfSpeechDetected").d("endOfSpeech", endOfSpeech).d("position", position));
+            callback(endOfSpeech);
+            return;
+        }
+    }
+}
+
+}  // namespace aip
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
@@ -0,0 +1,136 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "AIP/OpusEncoderContext.h"
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace aip {
+
+using namespace avsCommon::utils;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("OpusEncoderContext");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The input sample rate supported by AVS for Opus.
+static const unsigned int SAMPLE_RATE_HZ = 16000;
+
+/// The bitrate expected by AVS for Opus.
+static const opus_int32 BITRATE_BPS = 32000;
+
+/// The frame duration expected by AVS for Opus.
+static const unsigned int FRAME_DURATION_MS = 20;
+
+/// The number of input samples in one frame.
+static const size_t FRAME_SAMPLES = SAMPLE_RATE_HZ * FRAME_DURATION_MS / 1000;
+
+/// The size of one constant bitrate output frame in bytes.
+static const size_t FRAME_BYTES = BITRATE_BPS / 8 * FRAME_DURATION_MS / 1000;
+
+/// The @c AudioFormat sample rate which @c AudioInputProcessor maps to the AVS "OPUS" format.
+static const unsigned int AVS_OPUS_FORMAT_RATE = 32000;
+
+/// The AVS format name for Opus.
+static const std::string AVS_FORMAT_NAME = "OPUS";
+
+OpusEncoderContext::OpusEncoderContext() : m_encoder{nullptr} {
+}
+
+OpusEncoderContext::~OpusEncoderContext() {
+    close();
+}
+
+bool OpusEncoderContext::init(const AudioFormat& inputFormat) {
+    if (inputFormat.sampleRateHz != SAMPLE_RATE_HZ || inputFormat.numChannels != 1) {
+        ACSDK_ERROR(LX("initFailed")
+                        .d("reason", "unsupportedInputFormat")
+                        .d("sampleRate", inputFormat.sampleRateHz)
+                        .d("channels", inputFormat.numChannels));
+        return false;
+    }
+    close();
+
+    int error = OPUS_OK;
+    m_encoder = opus_encoder_create(SAMPLE_RATE_HZ, 1, OPUS_APPLICATION_VOIP, &error);
+    if (OPUS_OK != error || !m_encoder) {
+        ACSDK_ERROR(LX("initFailed").d("reason", "opusEncoderCreateFailed").d("error", opus_strerror(error)));
+        m_encoder = nullptr;
+        return false;
+    }
+    if (opus_encoder_ctl(m_encoder, OPUS_SET_BITRATE(BITRATE_BPS)) != OPUS_OK ||
+        opus_encoder_ctl(m_encoder, OPUS_SET_VBR(0)) != OPUS_OK) {
+        ACSDK_ERROR(LX("initFailed").d("reason", "opusEncoderCtlFailed"));
+        close();
+        return false;
+    }
+    return true;
+}
+
+size_t OpusEncoderContext::getInputFrameSize() const {
+    return FRAME_SAMPLES;
+}
+
+size_t OpusEncoderContext::getOutputFrameSize() const {
+    return FRAME_BYTES;
+}
+
+AudioFormat OpusEncoderContext::getAudioFormat() const {
+    AudioFormat format;
+    format.encoding = AudioFormat::Encoding::OPUS;
+    format.endianness = AudioFormat::Endianness::LITTLE;
+    format.sampleRateHz = AVS_OPUS_FORMAT_RATE;
+    format.sampleSizeInBits = 16;
+    format.numChannels = 1;
+    format.dataSigned = true;
+    format.layout = AudioFormat::Layout::INTERLEAVED;
+    return format;
+}
+
+std::string OpusEncoderContext::getAVSFormatName() const {
+    return AVS_FORMAT_NAME;
+}
+
+ssize_t OpusEncoderContext::processSamples(const int16_t* input, uint8_t* output) {
+    if (!m_encoder) {
+        ACSDK_ERROR(LX("processSamplesFailed").d("reason", "notInitialized"));
+        return -1;
+    }
+    auto bytes = opus_encode(m_encoder, input, FRAME_SAMPLES, output, FRAME_BYTES);
+    if (bytes < 0) {
+        ACSDK_ERROR(LX("processSamplesFailed").d("reason", "opusEncodeFailed").d("error", opus_strerror(bytes)));
+        return -1;
+    }
+    return bytes;
+}
+
+void OpusEncoderContext::close() {
+    if (m_encoder) {
+        opus_encoder_destroy(m_encoder);
+        m_encoder = nullptr;
+    }
+}
+
+}  // namespace aip
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
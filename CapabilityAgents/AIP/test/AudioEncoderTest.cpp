@@ -0,0 +1,273 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+/// @file AudioEncoderTest.cpp
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <AVSCommon/Utils/Memory/Memory.h>
+
+#include "AIP/AudioEncoder.h"
+
+using namespace testing;
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace aip {
+namespace test {
+
+using namespace avsCommon::avs;
+using namespace avsCommon::utils;
+
+/// The number of samples in one frame of the fake codec.
+static const size_t INPUT_FRAME_SIZE = 4;
+
+/// The number of bytes the fake codec produces per frame.
+static const size_t OUTPUT_FRAME_SIZE = 1;
+
+/// The number of samples in the input SDS.
+static const size_t SDS_WORDS = 1000;
+
+/// The word size of the input SDS.
+static const size_t SDS_WORD_SIZE = sizeof(int16_t);
+
+/// The maximum number of readers of the input SDS.
+static const size_t SDS_MAX_READERS = 2;
+
+/// How long to wait for encoded output before failing a test.
+static const std::chrono::seconds TIMEOUT{2};
+
+/// The input format used in the tests.
+static const AudioFormat INPUT_FORMAT = {AudioFormat::Encoding::LPCM,
+                                         AudioFormat::Endianness::LITTLE,
+                                         16000,
+                                         16,
+                                         1,
+                                         false,
+                                         AudioFormat::Layout::INTERLEAVED};
+
+/**
+ * A fake codec which "encodes" each frame into a single byte holding the low byte of the frame's first sample, so tests
+ * can tell which frames were encoded and in what order.
+ */
+class FakeEncoderContext : public EncoderContext {
+public:
+    /**
+     * Constructor.
+     *
+     * @param initResult The value to return from @c init().
+     */
+    FakeEncoderContext(bool initResult = true) : m_initResult{initResult} {
+    }
+
+    bool init(const AudioFormat& inputFormat) override {
+        return m_initResult;
+    }
+
+    size_t getInputFrameSize() const override {
+        return INPUT_FRAME_SIZE;
+    }
+
+    size_t getOutputFrameSize() const override {
+        return OUTPUT_FRAME_SIZE;
+    }
+
+    AudioFormat getAudioFormat() const override {
+        return INPUT_FORMAT;
+    }
+
+    std::string getAVSFormatName() const override {
+        return "FAKE";
+    }
+
+    ssize_t processSamples(const int16_t* input, uint8_t* output) override {
+        output[0] = static_cast<uint8_t>(input[0]);
+        return OUTPUT_FRAME_SIZE;
+    }
+
+    void close() override {
+    }
+
+private:
+    /// The value to return from @c init().
+    const bool m_initResult;
+};
+
+/// Test harness for @c AudioEncoder class.
+class AudioEncoderTest : public ::testing::Test {
+public:
+    void SetUp() override;
+
+    /**
+     * Write samples to the input SDS.  The first sample of frame @c n is set to @c n + 1, and all others are zero.
+     *
+     * @param numSamples The number of samples to write.
+     */
+    void writeSamples(size_t numSamples);
+
+    /**
+     * Read the encoded stream until it is closed.
+     *
+     * @param encodedStream The stream to read.
+     * @return The bytes read from the stream.
+     */
+    std::vector<uint8_t> readUntilClosed(std::shared_ptr<AudioInputStream> encodedStream);
+
+    /// The input SDS.
+    std::shared_ptr<AudioInputStream> m_inputStream;
+
+    /// The writer for the input SDS.
+    std::shared_ptr<AudioInputStream::Writer> m_writer;
+
+    /// The number of samples written so far.
+    size_t m_samplesWritten;
+};
+
+void AudioEncoderTest::SetUp() {
+    auto bufferSize = AudioInputStream::calculateBufferSize(SDS_WORDS, SDS_WORD_SIZE, SDS_MAX_READERS);
+    auto buffer = std::make_shared<AudioInputStream::Buffer>(bufferSize);
+    m_inputStream = AudioInputStream::create(buffer, SDS_WORD_SIZE, SDS_MAX_READERS);
+    ASSERT_NE(m_inputStream, nullptr);
+    m_writer = m_inputStream->createWriter(AudioInputStream::Writer::Policy::NONBLOCKABLE);
+    ASSERT_NE(m_writer, nullptr);
+    m_samplesWritten = 0;
+}
+
+void AudioEncoderTest::writeSamples(size_t numSamples) {
+    std::vector<int16_t> samples(numSamples, 0);
+    for (size_t i = 0; i < numSamples; ++i, ++m_samplesWritten) {
+        if (0 == m_samplesWritten % INPUT_FRAME_SIZE) {
+            samples[i] = m_samplesWritten / INPUT_FRAME_SIZE + 1;
+        }
+    }
+    ASSERT_EQ(m_writer->write(samples.data(), samples.size()), static_cast<ssize_t>(numSamples));
+}
+
+std::vector<uint8_t> AudioEncoderTest::readUntilClosed(std::shared_ptr<AudioInputStream> encodedStream) {
+    std::vector<uint8_t> result;
+    auto reader = encodedStream->createReader(AudioInputStream::Reader::Policy::BLOCKING);
+    EXPECT_NE(reader, nullptr);
+    if (!reader) {
+        return result;
+    }
+    uint8_t byte;
+    while (true) {
+        auto wordsRead = reader->read(&byte, 1, TIMEOUT);
+        if (wordsRead <= 0) {
+            EXPECT_EQ(wordsRead, AudioInputStream::Reader::Error::CLOSED);
+            break;
+        }
+        result.push_back(byte);
+    }
+    return result;
+}
+
+/// Function to verify that @c AudioEncoder::create() errors out with an invalid @c EncoderContext.
+TEST_F(AudioEncoderTest, createWithoutEncoderContext) {
+    EXPECT_EQ(AudioEncoder::create(nullptr), nullptr);
+}
+
+/// Function to verify that @c AudioEncoder::create() errors out with no look-ahead.
+TEST_F(AudioEncoderTest, createWithZeroLookAhead) {
+    EXPECT_EQ(AudioEncoder::create(memory::make_unique<FakeEncoderContext>(), 0), nullptr);
+}
+
+/// Function to verify that @c AudioEncoder::startEncoding() fails if the codec does not accept the input.
+TEST_F(AudioEncoderTest, startEncodingFailsIfInitFails) {
+    auto encoder = AudioEncoder::create(memory::make_unique<FakeEncoderContext>(false));
+    ASSERT_NE(encoder, nullptr);
+    EXPECT_EQ(
+        encoder->startEncoding(m_inputStream, INPUT_FORMAT, 0, AudioInputStream::Reader::Reference::ABSOLUTE),
+        nullptr);
+}
+
+/// Function to verify that @c AudioEncoder::startEncoding() rejects non-LPCM input.
+TEST_F(AudioEncoderTest, startEncodingFailsWithNonLPCMInput) {
+    auto encoder = AudioEncoder::create(memory::make_unique<FakeEncoderContext>());
+    ASSERT_NE(encoder, nullptr);
+    auto format = INPUT_FORMAT;
+    format.encoding = AudioFormat::Encoding::OPUS;
+    EXPECT_EQ(encoder->startEncoding(m_inputStream, format, 0, AudioInputStream::Reader::Reference::ABSOLUTE), nullptr);
+}
+
+/// Function to verify that all frames written before a draining stop are encoded, with the last frame padded.
+TEST_F(AudioEncoderTest, stopEncodingDrainsInput) {
+    auto encoder = AudioEncoder::create(memory::make_unique<FakeEncoderContext>());
+    ASSERT_NE(encoder, nullptr);
+    EXPECT_EQ(encoder->getAVSFormatName(), "FAKE");
+
+    writeSamples(INPUT_FRAME_SIZE * 2);
+    auto encodedStream =
+        encoder->startEncoding(m_inputStream, INPUT_FORMAT, 0, AudioInputStream::Reader::Reference::ABSOLUTE);
+    ASSERT_NE(encodedStream, nullptr);
+    writeSamples(INPUT_FRAME_SIZE + 1);
+    encoder->stopEncoding();
+
+    std::vector<uint8_t> expected = {1, 2, 3, 4};
+    EXPECT_EQ(readUntilClosed(encodedStream), expected);
+}
+
+/// Function to verify that encoding starts from the requested position in the input.
+TEST_F(AudioEncoderTest, startEncodingFromOffset) {
+    auto encoder = AudioEncoder::create(memory::make_unique<FakeEncoderContext>());
+    ASSERT_NE(encoder, nullptr);
+
+    writeSamples(INPUT_FRAME_SIZE * 3);
+    auto encodedStream = encoder->startEncoding(
+        m_inputStream, INPUT_FORMAT, INPUT_FRAME_SIZE, AudioInputStream::Reader::Reference::ABSOLUTE);
+    ASSERT_NE(encodedStream, nullptr);
+    encoder->stopEncoding();
+
+    std::vector<uint8_t> expected = {2, 3};
+    EXPECT_EQ(readUntilClosed(encodedStream), expected);
+}
+
+/// Function to verify that an immediate stop closes the encoded stream even while input is still being written.
+TEST_F(AudioEncoderTest, stopEncodingImmediately) {
+    auto encoder = AudioEncoder::create(memory::make_unique<FakeEncoderContext>());
+    ASSERT_NE(encoder, nullptr);
+
+    auto encodedStream =
+        encoder->startEncoding(m_inputStream, INPUT_FORMAT, 0, AudioInputStream::Reader::Reference::ABSOLUTE);
+    ASSERT_NE(encodedStream, nullptr);
+    encoder->stopEncoding(true);
+    writeSamples(INPUT_FRAME_SIZE * 2);
+
+    EXPECT_TRUE(readUntilClosed(encodedStream).empty());
+}
+
+/// Function to verify that starting a new session ends the previous one.
+TEST_F(AudioEncoderTest, startEncodingStopsPreviousSession) {
+    auto encoder = AudioEncoder::create(memory::make_unique<FakeEncoderContext>());
+    ASSERT_NE(encoder, nullptr);
+
+    auto firstStream =
+        encoder->startEncoding(m_inputStream, INPUT_FORMAT, 0, AudioInputStream::Reader::Reference::ABSOLUTE);
+    ASSERT_NE(firstStream, nullptr);
+    auto secondStream =
+        encoder->startEncoding(m_inputStream, INPUT_FORMAT, 0, AudioInputStream::Reader::Reference::ABSOLUTE);
+    ASSERT_NE(secondStream, nullptr);
+
+    writeSamples(INPUT_FRAME_SIZE);
+    encoder->stopEncoding();
+    std::vector<uint8_t> expected = {1};
+    EXPECT_EQ(readUntilClosed(secondStream), expected);
+}
+
+}  // namespace test
+}  // namespace aip
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
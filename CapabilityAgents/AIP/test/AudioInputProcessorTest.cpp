@@ -35,6 +35,7 @@
 #include <AVSCommon/SDKInterfaces/MockUserActivityNotifier.h>
 #include <AVSCommon/Utils/UUIDGeneration/UUIDGeneration.h>
 #include <AVSCommon/AVS/Attachment/MockAttachmentManager.h>
+#include <AVSCommon/Utils/Configuration/ConfigurationNode.h>
 #include <AVSCommon/Utils/JSON/JSONUtils.h>
 #include <AVSCommon/Utils/Memory/Memory.h>
 
@@ -1963,6 +1964,228 @@ TEST_F(AudioInputProcessorTest, recognizeOPUSWithWakeWord) {
     m_audioProvider->format.sampleRateHz = 32000;
     EXPECT_TRUE(testRecognizeSucceeds(*m_audioProvider, Initiator::WAKEWORD, begin, end, KEYWORD_TEXT));
 }
+
+/**
+ * This function verifies that with the speculative Recognize path enabled, @c AudioInputProcessor requests the dialog
+ * channel while the context is still being gathered, and sends the Recognize event as soon as the context arrives.
+ */
+TEST_F(AudioInputProcessorTest, speculativeRecognizeAcquiresChannelBeforeContext) {
+    std::stringstream configuration(R"({"audioInputProcessor":{"speculativeRecognize":true}})");
+    ASSERT_TRUE(avsCommon::utils::configuration::ConfigurationNode::initialize({&configuration}));
+    EXPECT_CALL(*m_mockContextManager, setStateProvider(RECOGNIZER_STATE, Ne(nullptr)));
+    m_audioInputProcessor->removeObserver(m_dialogUXStateAggregator);
+    m_audioInputProcessor = AudioInputProcessor::create(
+        m_mockDirectiveSequencer,
+        m_mockMessageSender,
+        m_mockContextManager,
+        m_mockFocusManager,
+        m_dialogUXStateAggregator,
+        m_mockExceptionEncounteredSender,
+        m_mockUserActivityNotifier,
+        *m_audioProvider);
+    avsCommon::utils::configuration::ConfigurationNode::uninitialize();
+    ASSERT_NE(m_audioInputProcessor, nullptr);
+    m_audioInputProcessor->addObserver(m_mockObserver);
+    m_audioInputProcessor->addObserver(m_dialogUXStateAggregator);
+
+    std::promise<void> channelRequested;
+    std::promise<void> recognizeSent;
+    EXPECT_CALL(*m_mockUserActivityNotifier, onUserActive()).Times(AtLeast(1));
+    EXPECT_CALL(*m_mockObserver, onStateChanged(AudioInputProcessorObserverInterface::State::RECOGNIZING));
+    EXPECT_CALL(*m_mockContextManager, getContext(_));
+    EXPECT_CALL(*m_mockFocusManager, acquireChannel(CHANNEL_NAME, _, NAMESPACE))
+        .WillOnce(InvokeWithoutArgs([&channelRequested] {
+            channelRequested.set_value();
+            return true;
+        }));
+    EXPECT_CALL(*m_mockDirectiveSequencer, setDialogRequestId(_));
+    EXPECT_CALL(*m_mockMessageSender, sendMessage(_)).WillOnce(InvokeWithoutArgs([&recognizeSent] {
+        recognizeSent.set_value();
+    }));
+
+    EXPECT_TRUE(m_audioInputProcessor->recognize(*m_audioProvider, Initiator::TAP).get());
+    auto channelRequestedFuture = channelRequested.get_future();
+    ASSERT_EQ(channelRequestedFuture.wait_for(TEST_TIMEOUT), std::future_status::ready);
+
+    m_audioInputProcessor->onFocusChanged(avsCommon::avs::FocusState::FOREGROUND);
+    m_audioInputProcessor->onContextAvailable(R"({"context":[]})");
+    auto recognizeSentFuture = recognizeSent.get_future();
+    EXPECT_EQ(recognizeSentFuture.wait_for(TEST_TIMEOUT), std::future_status::ready);
+}
+
+/// A @c VoiceActivityDetectorInterface which treats each non-zero sample as speech.
+class SampleVoiceActivityDetector : public avsCommon::sdkInterfaces::VoiceActivityDetectorInterface {
+public:
+    size_t getFrameSize() const override {
+        return 1;
+    }
+
+    void reset() override {
+    }
+
+    bool isSpeech(const int16_t* frame) override {
+        return *frame != 0;
+    }
+};
+
+/**
+ * This function verifies that when an @c Endpointer is provided, @c AudioInputProcessor stops capture at the locally
+ * detected end of speech, and treats a later @c StopCapture directive as redundant.
+ */
+TEST_F(AudioInputProcessorTest, localEndOfSpeechStopsCapture) {
+    auto endpointer = Endpointer::create(std::make_shared<SampleVoiceActivityDetector>(), std::chrono::milliseconds(1));
+    ASSERT_NE(endpointer, nullptr);
+    EXPECT_CALL(*m_mockContextManager, setStateProvider(RECOGNIZER_STATE, Ne(nullptr)));
+    m_audioInputProcessor->removeObserver(m_dialogUXStateAggregator);
+    m_audioInputProcessor = AudioInputProcessor::create(
+        m_mockDirectiveSequencer,
+        m_mockMessageSender,
+        m_mockContextManager,
+        m_mockFocusManager,
+        m_dialogUXStateAggregator,
+        m_mockExceptionEncounteredSender,
+        m_mockUserActivityNotifier,
+        *m_audioProvider,
+        nullptr,
+        endpointer);
+    ASSERT_NE(m_audioInputProcessor, nullptr);
+    m_audioInputProcessor->addObserver(m_mockObserver);
+    m_audioInputProcessor->addObserver(m_dialogUXStateAggregator);
+
+    std::promise<void> recognizeSent;
+    std::promise<void> captureStopped;
+    EXPECT_CALL(*m_mockUserActivityNotifier, onUserActive()).Times(AtLeast(1));
+    EXPECT_CALL(*m_mockObserver, onStateChanged(AudioInputProcessorObserverInterface::State::RECOGNIZING));
+    EXPECT_CALL(*m_mockContextManager, getContext(_));
+    EXPECT_CALL(*m_mockFocusManager, acquireChannel(CHANNEL_NAME, _, NAMESPACE)).WillOnce(Return(true));
+    EXPECT_CALL(*m_mockDirectiveSequencer, setDialogRequestId(_));
+    EXPECT_CALL(*m_mockMessageSender, sendMessage(_)).WillOnce(InvokeWithoutArgs([&recognizeSent] {
+        recognizeSent.set_value();
+    }));
+    EXPECT_CALL(*m_mockObserver, onStateChanged(AudioInputProcessorObserverInterface::State::BUSY))
+        .WillOnce(InvokeWithoutArgs([&captureStopped] { captureStopped.set_value(); }));
+    EXPECT_CALL(*m_mockFocusManager, releaseChannel(CHANNEL_NAME, _)).Times(AtMost(1));
+    EXPECT_CALL(*m_mockObserver, onStateChanged(AudioInputProcessorObserverInterface::State::IDLE)).Times(AtMost(1));
+
+    EXPECT_TRUE(m_audioInputProcessor->recognize(*m_audioProvider, Initiator::TAP).get());
+    m_audioInputProcessor->onContextAvailable(R"({"context":[]})");
+    m_audioInputProcessor->onFocusChanged(avsCommon::avs::FocusState::FOREGROUND);
+    auto recognizeSentFuture = recognizeSent.get_future();
+    ASSERT_EQ(recognizeSentFuture.wait_for(TEST_TIMEOUT), std::future_status::ready);
+
+    // Some speech followed by more than a hangover of silence.
+    std::vector<Sample> speech(SAMPLE_RATE_HZ / 1000, 1);
+    std::vector<Sample> silence(SAMPLE_RATE_HZ / 100, 0);
+    EXPECT_EQ(m_writer->write(speech.data(), speech.size()), static_cast<ssize_t>(speech.size()));
+    EXPECT_EQ(m_writer->write(silence.data(), silence.size()), static_cast<ssize_t>(silence.size()));
+    auto captureStoppedFuture = captureStopped.get_future();
+    ASSERT_EQ(captureStoppedFuture.wait_for(TEST_TIMEOUT), std::future_status::ready);
+
+    // The StopCapture directive which AVS sends for the same utterance should complete without an exception.
+    auto result = avsCommon::utils::memory::make_unique<avsCommon::sdkInterfaces::test::MockDirectiveHandlerResult>();
+    std::promise<void> directiveCompleted;
+    EXPECT_CALL(*result, setCompleted()).WillOnce(InvokeWithoutArgs([&directiveCompleted] {
+        directiveCompleted.set_value();
+    }));
+    auto avsDirective = createAVSDirective(STOP_CAPTURE, true);
+    std::shared_ptr<avsCommon::sdkInterfaces::DirectiveHandlerInterface> directiveHandler = m_audioInputProcessor;
+    directiveHandler->preHandleDirective(avsDirective, std::move(result));
+    EXPECT_TRUE(directiveHandler->handleDirective(avsDirective->getMessageId()));
+    auto directiveCompletedFuture = directiveCompleted.get_future();
+    EXPECT_EQ(directiveCompletedFuture.wait_for(TEST_TIMEOUT), std::future_status::ready);
+}
+
+/// An @c EncoderContext which reports the Opus format name and encodes each sample as one byte.
+class OneByteEncoderContext : public EncoderContext {
+public:
+    bool init(const avsCommon::utils::AudioFormat& inputFormat) override {
+        return true;
+    }
+
+    size_t getInputFrameSize() const override {
+        return 1;
+    }
+
+    size_t getOutputFrameSize() const override {
+        return 1;
+    }
+
+    avsCommon::utils::AudioFormat getAudioFormat() const override {
+        return avsCommon::utils::AudioFormat();
+    }
+
+    std::string getAVSFormatName() const override {
+        return "OPUS";
+    }
+
+    ssize_t processSamples(const int16_t* input, uint8_t* output) override {
+        output[0] = static_cast<uint8_t>(input[0]);
+        return 1;
+    }
+
+    void close() override {
+    }
+};
+
+/**
+ * This function verifies that an @c AudioEncoder given to @c AudioInputProcessor is only used once encoding is
+ * enabled, and that it can be enabled and disabled between Recognize events.
+ */
+TEST_F(AudioInputProcessorTest, encodingIsSwitchedAtRuntime) {
+    auto audioEncoder = AudioEncoder::create(avsCommon::utils::memory::make_unique<OneByteEncoderContext>());
+    ASSERT_NE(audioEncoder, nullptr);
+    EXPECT_CALL(*m_mockContextManager, setStateProvider(RECOGNIZER_STATE, Ne(nullptr)));
+    m_audioInputProcessor->removeObserver(m_dialogUXStateAggregator);
+    m_audioInputProcessor = AudioInputProcessor::create(
+        m_mockDirectiveSequencer,
+        m_mockMessageSender,
+        m_mockContextManager,
+        m_mockFocusManager,
+        m_dialogUXStateAggregator,
+        m_mockExceptionEncounteredSender,
+        m_mockUserActivityNotifier,
+        *m_audioProvider,
+        audioEncoder);
+    ASSERT_NE(m_audioInputProcessor, nullptr);
+    m_audioInputProcessor->addObserver(m_mockObserver);
+    m_audioInputProcessor->addObserver(m_dialogUXStateAggregator);
+
+    EXPECT_CALL(*m_mockUserActivityNotifier, onUserActive()).Times(AnyNumber());
+    EXPECT_CALL(*m_mockObserver, onStateChanged(_)).Times(AnyNumber());
+    EXPECT_CALL(*m_mockContextManager, getContext(_)).Times(AnyNumber());
+    EXPECT_CALL(*m_mockFocusManager, acquireChannel(CHANNEL_NAME, _, NAMESPACE)).WillRepeatedly(Return(true));
+    EXPECT_CALL(*m_mockFocusManager, releaseChannel(CHANNEL_NAME, _)).Times(AnyNumber());
+    EXPECT_CALL(*m_mockDirectiveSequencer, setDialogRequestId(_)).Times(AnyNumber());
+
+    // Send a Recognize event and return the audio format it reports.
+    auto recognizeFormat = [this]() -> std::string {
+        std::promise<std::string> formatSent;
+        EXPECT_CALL(*m_mockMessageSender, sendMessage(_))
+            .WillOnce(Invoke([&formatSent](std::shared_ptr<avsCommon::avs::MessageRequest> request) {
+                rapidjson::Document document;
+                document.Parse(request->getJsonContent().c_str());
+                auto event = document.FindMember(MESSAGE_EVENT_KEY);
+                auto payload = event->value.FindMember(MESSAGE_PAYLOAD_KEY);
+                formatSent.set_value(getJsonString(payload->value, AUDIO_FORMAT_KEY));
+            }));
+        EXPECT_TRUE(m_audioInputProcessor->recognize(*m_audioProvider, Initiator::TAP).get());
+        m_audioInputProcessor->onContextAvailable(R"({"context":[]})");
+        m_audioInputProcessor->onFocusChanged(avsCommon::avs::FocusState::FOREGROUND);
+        auto formatSentFuture = formatSent.get_future();
+        if (formatSentFuture.wait_for(TEST_TIMEOUT) != std::future_status::ready) {
+            return "";
+        }
+        m_audioInputProcessor->resetState().wait();
+        return formatSentFuture.get();
+    };
+
+    EXPECT_EQ(recognizeFormat(), "AUDIO_L16_RATE_16000_CHANNELS_1");
+    m_audioInputProcessor->setEncodingEnabled(true).wait();
+    EXPECT_EQ(recognizeFormat(), "OPUS");
+    m_audioInputProcessor->setEncodingEnabled(false).wait();
+    EXPECT_EQ(recognizeFormat(), "AUDIO_L16_RATE_16000_CHANNELS_1");
+}
+
 }  // namespace test
 }  // namespace aip
 }  // namespace capabilityAgents
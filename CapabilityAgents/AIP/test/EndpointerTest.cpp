@@ -0,0 +1,365 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+/// @file EndpointerTest.cpp
+
+#include <cmath>
+#include <fstream>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <AVSCommon/AVS/EnergyVoiceActivityDetector.h>
+
+#include "AIP/Endpointer.h"
+
+namespace alexaClientSDK {
+namespace capabilityAgents {
+namespace aip {
+namespace test {
+
+using namespace avsCommon::avs;
+using namespace avsCommon::utils;
+
+/// The path to the folder holding the evaluation audio files.
+std::string inputsDirPath;
+
+/// The sample rate of the test audio.
+static const unsigned int SAMPLE_RATE_HZ = 16000;
+
+/// The number of samples per millisecond.
+static const size_t SAMPLES_PER_MS = SAMPLE_RATE_HZ / 1000;
+
+/// The word size of the test streams.
+static const size_t SDS_WORD_SIZE = sizeof(int16_t);
+
+/// The maximum number of readers of the test streams.
+static const size_t SDS_MAX_READERS = 2;
+
+/// The hangover used in the tests.
+static const std::chrono::milliseconds HANGOVER{500};
+
+/// How long to wait for the end of speech to be reported before failing a test.
+static const std::chrono::seconds TIMEOUT{2};
+
+/// How long to wait before deciding that the end of speech will not be reported.
+static const std::chrono::milliseconds NO_CALLBACK_TIMEOUT{500};
+
+/// The amplitude of the synthetic speech.
+static const double SPEECH_AMPLITUDE = 5000;
+
+/// The frequency of the synthetic speech.
+static const double SPEECH_FREQUENCY_HZ = 440;
+
+/// The ratio of a circle's circumference to its diameter.
+static const double PI = 3.14159265358979323846;
+
+/// The length of the RIFF header which precedes the chunks of a wav file.
+static const size_t RIFF_HEADER_SIZE = 12;
+
+/// The length of a wav chunk identifier.
+static const size_t CHUNK_ID_SIZE = 4;
+
+/// The identifier of the wav chunk holding the samples.
+static const std::string DATA_CHUNK_ID = "data";
+
+/// Samples louder than this are treated as speech when deriving the reference end of speech for evaluation.
+static const int REFERENCE_SPEECH_AMPLITUDE = 500;
+
+/// How far the detected end of speech may be from the reference before it counts as a miss.
+static const std::chrono::milliseconds EVALUATION_TOLERANCE{100};
+
+/// The 16 kHz, 16-bit, mono LPCM format of the test audio.
+static const AudioFormat FORMAT = {AudioFormat::Encoding::LPCM,
+                                   AudioFormat::Endianness::LITTLE,
+                                   SAMPLE_RATE_HZ,
+                                   16,
+                                   1,
+                                   true,
+                                   AudioFormat::Layout::INTERLEAVED};
+
+/// The utterances used for the offline evaluation, all 16 kHz 16-bit mono LPCM.
+static const std::vector<std::string> EVALUATION_FILES = {"/alexa_recognize_joke_test.wav",
+                                                          "/alexa_recognize_silence_test.wav",
+                                                          "/alexa_recognize_wiki_test.wav",
+                                                          "/recognize_cancel_timer_test.wav",
+                                                          "/recognize_flashbriefing_test.wav",
+                                                          "/recognize_joke_test.wav",
+                                                          "/recognize_lions_test.wav",
+                                                          "/recognize_long_timer_test.wav",
+                                                          "/recognize_sing_song_test.wav",
+                                                          "/recognize_stop_test.wav",
+                                                          "/recognize_stop_timer_test.wav",
+                                                          "/recognize_test.wav",
+                                                          "/recognize_timer_test.wav",
+                                                          "/recognize_very_long_timer_test.wav",
+                                                          "/recognize_volume_up_test.wav",
+                                                          "/recognize_weather_test.wav",
+                                                          "/recognize_whats_up_test.wav",
+                                                          "/recognize_wiki_test.wav",
+                                                          "/silence_test.wav"};
+
+/**
+ * Convert a number of samples to milliseconds.
+ *
+ * @param samples The number of samples.
+ * @return The duration of @c samples in milliseconds.
+ */
+static size_t toMs(size_t samples) {
+    return samples / SAMPLES_PER_MS;
+}
+
+/**
+ * Read the samples of a wav file.  Only the "data" chunk is read, since some of the files carry extra chunks before it.
+ *
+ * @param fileName The path to the file.
+ * @param[out] samples The samples read from the file.
+ * @return @c true if the file was read, else @c false.
+ */
+static bool readWavFile(const std::string& fileName, std::vector<int16_t>* samples) {
+    std::ifstream inputFile(fileName.c_str(), std::ifstream::binary);
+    if (!inputFile.good()) {
+        return false;
+    }
+    inputFile.seekg(RIFF_HEADER_SIZE, std::ios::beg);
+    char chunkId[CHUNK_ID_SIZE];
+    uint32_t chunkSize = 0;
+    while (inputFile.read(chunkId, CHUNK_ID_SIZE) &&
+           inputFile.read(reinterpret_cast<char*>(&chunkSize), sizeof(chunkSize))) {
+        if (std::string(chunkId, CHUNK_ID_SIZE) == DATA_CHUNK_ID) {
+            samples->resize(chunkSize / sizeof(int16_t));
+            inputFile.read(reinterpret_cast<char*>(samples->data()), samples->size() * sizeof(int16_t));
+            return static_cast<size_t>(inputFile.gcount()) == samples->size() * sizeof(int16_t);
+        }
+        inputFile.seekg(chunkSize + (chunkSize & 1), std::ios::cur);
+    }
+    return false;
+}
+
+/// Test harness for @c Endpointer class.
+class EndpointerTest : public ::testing::Test {
+public:
+    void SetUp() override;
+
+    /**
+     * Create the test stream, write @c samples to it and close the writer.
+     *
+     * @param samples The samples to write.
+     */
+    void writeAndClose(const std::vector<int16_t>& samples);
+
+    /**
+     * Start @c m_endpointer at the beginning of the test stream.
+     *
+     * @return A future which receives the reported end of speech.
+     */
+    std::future<AudioInputStream::Index> start();
+
+    /// The endpointer under test.
+    std::shared_ptr<Endpointer> m_endpointer;
+
+    /// The test stream.
+    std::shared_ptr<AudioInputStream> m_stream;
+
+    /// The promise fulfilled by the end of speech callback.
+    std::promise<AudioInputStream::Index> m_endOfSpeech;
+};
+
+void EndpointerTest::SetUp() {
+    m_endpointer = Endpointer::create(std::make_shared<EnergyVoiceActivityDetector>(), HANGOVER);
+    ASSERT_NE(m_endpointer, nullptr);
+}
+
+void EndpointerTest::writeAndClose(const std::vector<int16_t>& samples) {
+    auto bufferSize = AudioInputStream::calculateBufferSize(samples.size(), SDS_WORD_SIZE, SDS_MAX_READERS);
+    auto buffer = std::make_shared<AudioInputStream::Buffer>(bufferSize);
+    m_stream = AudioInputStream::create(buffer, SDS_WORD_SIZE, SDS_MAX_READERS);
+    ASSERT_NE(m_stream, nullptr);
+    auto writer = m_stream->createWriter(AudioInputStream::Writer::Policy::NONBLOCKABLE);
+    ASSERT_NE(writer, nullptr);
+    ASSERT_EQ(writer->write(samples.data(), samples.size()), static_cast<ssize_t>(samples.size()));
+    writer->close();
+}
+
+std::future<AudioInputStream::Index> EndpointerTest::start() {
+    EXPECT_TRUE(m_endpointer->start(
+        m_stream,
+        FORMAT,
+        0,
+        AudioInputStream::Reader::Reference::ABSOLUTE,
+        [this](AudioInputStream::Index endOfSpeech) { m_endOfSpeech.set_value(endOfSpeech); }));
+    return m_endOfSpeech.get_future();
+}
+
+/**
+ * Generate synthetic audio of a tone followed by silence.
+ *
+ * @param speech The duration of the tone.
+ * @param silence The duration of the silence.
+ * @return The generated samples.
+ */
+static std::vector<int16_t> generateUtterance(std::chrono::milliseconds speech, std::chrono::milliseconds silence) {
+    std::vector<int16_t> samples((speech.count() + silence.count()) * SAMPLES_PER_MS, 0);
+    for (size_t i = 0; i < static_cast<size_t>(speech.count()) * SAMPLES_PER_MS; ++i) {
+        samples[i] =
+            static_cast<int16_t>(SPEECH_AMPLITUDE * std::sin(2 * PI * SPEECH_FREQUENCY_HZ * i / SAMPLE_RATE_HZ));
+    }
+    return samples;
+}
+
+/// Function to verify that @c Endpointer::create() errors out with an invalid @c VoiceActivityDetectorInterface.
+TEST_F(EndpointerTest, createWithoutVoiceActivityDetector) {
+    EXPECT_EQ(Endpointer::create(nullptr), nullptr);
+}
+
+/// Function to verify that @c Endpointer::create() errors out with an invalid hangover.
+TEST_F(EndpointerTest, createWithZeroHangover) {
+    EXPECT_EQ(
+        Endpointer::create(std::make_shared<EnergyVoiceActivityDetector>(), std::chrono::milliseconds::zero()),
+        nullptr);
+}
+
+/// Function to verify that @c Endpointer::start() rejects audio which is not 16-bit LPCM.
+TEST_F(EndpointerTest, startWithUnsupportedFormat) {
+    writeAndClose(generateUtterance(std::chrono::milliseconds(100), std::chrono::milliseconds(0)));
+    auto format = FORMAT;
+    format.encoding = AudioFormat::Encoding::OPUS;
+    EXPECT_FALSE(m_endpointer->start(
+        m_stream, format, 0, AudioInputStream::Reader::Reference::ABSOLUTE, [](AudioInputStream::Index) {}));
+}
+
+/// Function to verify that the end of speech is reported one hangover after the speech ends.
+TEST_F(EndpointerTest, endOfSpeechAfterHangover) {
+    auto speech = std::chrono::milliseconds(1000);
+    writeAndClose(generateUtterance(speech, HANGOVER * 2));
+    auto endOfSpeech = start();
+    ASSERT_EQ(endOfSpeech.wait_for(TIMEOUT), std::future_status::ready);
+    auto endOfSpeechMs = static_cast<int>(toMs(endOfSpeech.get()));
+    EXPECT_NEAR(endOfSpeechMs, speech.count(), EVALUATION_TOLERANCE.count());
+}
+
+/// Function to verify that the end of speech is not reported if the silence is shorter than the hangover.
+TEST_F(EndpointerTest, noEndOfSpeechWithinHangover) {
+    writeAndClose(generateUtterance(std::chrono::milliseconds(1000), HANGOVER / 2));
+    auto endOfSpeech = start();
+    EXPECT_EQ(endOfSpeech.wait_for(NO_CALLBACK_TIMEOUT), std::future_status::timeout);
+}
+
+/// Function to verify that the end of speech is not reported if nothing was said.
+TEST_F(EndpointerTest, noEndOfSpeechWithoutSpeech) {
+    writeAndClose(generateUtterance(std::chrono::milliseconds(0), HANGOVER * 4));
+    auto endOfSpeech = start();
+    EXPECT_EQ(endOfSpeech.wait_for(NO_CALLBACK_TIMEOUT), std::future_status::timeout);
+}
+
+/// Function to verify that no end of speech is reported if @c Endpointer::stop() is called within the hangover.
+TEST_F(EndpointerTest, noEndOfSpeechAfterStop) {
+    auto speech = generateUtterance(std::chrono::milliseconds(500), HANGOVER / 2);
+    auto silence = generateUtterance(std::chrono::milliseconds(0), HANGOVER * 2);
+    auto bufferSize =
+        AudioInputStream::calculateBufferSize(speech.size() + silence.size(), SDS_WORD_SIZE, SDS_MAX_READERS);
+    m_stream = AudioInputStream::create(
+        std::make_shared<AudioInputStream::Buffer>(bufferSize), SDS_WORD_SIZE, SDS_MAX_READERS);
+    ASSERT_NE(m_stream, nullptr);
+    auto writer = m_stream->createWriter(AudioInputStream::Writer::Policy::NONBLOCKABLE);
+    ASSERT_NE(writer, nullptr);
+
+    auto endOfSpeech = start();
+    ASSERT_EQ(writer->write(speech.data(), speech.size()), static_cast<ssize_t>(speech.size()));
+    // Give the endpointer time to read the speech; it cannot report the end of it yet.
+    ASSERT_EQ(endOfSpeech.wait_for(NO_CALLBACK_TIMEOUT), std::future_status::timeout);
+
+    m_endpointer->stop();
+    ASSERT_EQ(writer->write(silence.data(), silence.size()), static_cast<ssize_t>(silence.size()));
+    EXPECT_EQ(endOfSpeech.wait_for(NO_CALLBACK_TIMEOUT), std::future_status::timeout);
+}
+
+/**
+ * Offline accuracy and latency evaluation over the recorded utterances in the inputs folder, using the default
+ * hangover.  The reference end of speech is the last sample louder than @c REFERENCE_SPEECH_AMPLITUDE.  For each file
+ * this prints the reference end of speech, the end of speech found by the @c Endpointer, when it was reported (one
+ * hangover later), and how much audio would not have been uploaded.  It fails if the end of speech is reported in the
+ * middle of an utterance or is further than @c EVALUATION_TOLERANCE from the reference.
+ */
+TEST_F(EndpointerTest, evaluateOverInputs) {
+    const auto hangover = Endpointer::DEFAULT_HANGOVER;
+    m_endpointer = Endpointer::create(std::make_shared<EnergyVoiceActivityDetector>(), hangover);
+    ASSERT_NE(m_endpointer, nullptr);
+
+    std::cout << std::left << std::setw(40) << "file" << std::right << std::setw(10) << "audioMs" << std::setw(12)
+              << "referenceMs" << std::setw(14) << "endOfSpeechMs" << std::setw(12) << "reportedMs" << std::setw(10)
+              << "savedMs" << std::endl;
+
+    size_t totalAudioMs = 0;
+    size_t totalSavedMs = 0;
+    for (const auto& fileName : EVALUATION_FILES) {
+        std::vector<int16_t> samples;
+        ASSERT_TRUE(readWavFile(inputsDirPath + fileName, &samples)) << "Unable to read " << inputsDirPath + fileName;
+
+        size_t referenceEnd = 0;
+        for (size_t i = 0; i < samples.size(); ++i) {
+            if (std::abs(samples[i]) > REFERENCE_SPEECH_AMPLITUDE) {
+                referenceEnd = i + 1;
+            }
+        }
+
+        m_endOfSpeech = std::promise<AudioInputStream::Index>();
+        writeAndClose(samples);
+        auto endOfSpeechFuture = start();
+        // The end of speech can only be reported if the recording has at least a hangover of silence at the end.
+        bool expectEndOfSpeech =
+            referenceEnd > 0 && toMs(samples.size() - referenceEnd) > static_cast<size_t>(2 * hangover.count());
+        auto status = endOfSpeechFuture.wait_for(expectEndOfSpeech ? TIMEOUT : NO_CALLBACK_TIMEOUT);
+        m_endpointer->stop();
+
+        totalAudioMs += toMs(samples.size());
+        std::cout << std::left << std::setw(40) << fileName << std::right << std::setw(10) << toMs(samples.size())
+                  << std::setw(12) << toMs(referenceEnd);
+        if (std::future_status::ready != status) {
+            std::cout << std::setw(14) << "-" << std::setw(12) << "-" << std::setw(10) << 0 << std::endl;
+            EXPECT_FALSE(expectEndOfSpeech) << fileName;
+            continue;
+        }
+
+        auto endOfSpeech = endOfSpeechFuture.get();
+        auto reported = std::min<size_t>(endOfSpeech + hangover.count() * SAMPLES_PER_MS, samples.size());
+        totalSavedMs += toMs(samples.size() - reported);
+        std::cout << std::setw(14) << toMs(endOfSpeech) << std::setw(12) << toMs(reported) << std::setw(10)
+                  << toMs(samples.size() - reported) << std::endl;
+        EXPECT_NEAR(
+            static_cast<int>(toMs(endOfSpeech)), static_cast<int>(toMs(referenceEnd)), EVALUATION_TOLERANCE.count())
+            << fileName;
+    }
+    std::cout << "total audioMs=" << totalAudioMs << " savedMs=" << totalSavedMs << std::endl;
+}
+
+}  // namespace test
+}  // namespace aip
+}  // namespace capabilityAgents
+}  // namespace alexaClientSDK
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    if (argc < 2) {
+        std::cerr << "USAGE: " << std::string(argv[0]) << " <path_to_inputs_folder>" << std::endl;
+        return 1;
+    } else {
+        alexaClientSDK::capabilityAgents::aip::test::inputsDirPath = std::string(argv[1]);
+        return RUN_ALL_TESTS();
+    }
+}
@@ -64,6 +64,9 @@ public:
      * @param contextManager The AVS Context manager used to generate system context for events.
      * @param exceptionSender The object to use for sending AVS Exception messages.
      * @param playbackRouter The @c PlaybackRouterInterface instance to use when @c AudioPlayer becomes active.
+     * @param prefetchMediaPlayer An optional second @c MediaPlayerInterface.  If provided, the next @c AudioItem is
+     *     requested shortly before the current one ends, set as its source and prerolled, and the two players swap
+     *     roles just before the current item ends so the next item starts without waiting to be fetched.
      * @return A @c std::shared_ptr to the new @c AudioPlayer instance.
      */
     static std::shared_ptr<AudioPlayer> create(
@@ -72,7 +75,8 @@ public:
         std::shared_ptr<avsCommon::sdkInterfaces::FocusManagerInterface> focusManager,
         std::shared_ptr<avsCommon::sdkInterfaces::ContextManagerInterface> contextManager,
         std::shared_ptr<avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionSender,
-        std::shared_ptr<avsCommon::sdkInterfaces::PlaybackRouterInterface> playbackRouter);
+        std::shared_ptr<avsCommon::sdkInterfaces::PlaybackRouterInterface> playbackRouter,
+        std::shared_ptr<avsCommon::utils::mediaPlayer::MediaPlayerInterface> prefetchMediaPlayer = nullptr);
 
     /// @name StateProviderInterface Functions
     /// @{
@@ -125,6 +129,7 @@ private:
      * @param contextManager The AVS Context manager used to generate system context for events.
      * @param exceptionSender The object to use for sending AVS Exception messages.
      * @param playbackRouter The playback router used for switching playback buttons handler to default.
+     * @param prefetchMediaPlayer The optional @c MediaPlayerInterface used to prefetch the next @c AudioItem.
      * @return A @c std::shared_ptr to the new @c AudioPlayer instance.
      */
     AudioPlayer(
@@ -133,7 +138,8 @@ private:
         std::shared_ptr<avsCommon::sdkInterfaces::FocusManagerInterface> focusManager,
         std::shared_ptr<avsCommon::sdkInterfaces::ContextManagerInterface> contextManager,
         std::shared_ptr<avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionSender,
-        std::shared_ptr<avsCommon::sdkInterfaces::PlaybackRouterInterface> playbackRouter);
+        std::shared_ptr<avsCommon::sdkInterfaces::PlaybackRouterInterface> playbackRouter,
+        std::shared_ptr<avsCommon::utils::mediaPlayer::MediaPlayerInterface> prefetchMediaPlayer);
 
     /// @name RequiresShutdown Functions
     /// @{
@@ -233,6 +239,32 @@ private:
     /// Cancels the timers when playback has stopped/finished.
     void cancelTimers();
 
+    /**
+     * When prefetching is enabled, start the timers which request and prefetch the next @c AudioItem, and switch to
+     * it, near the end of the current one.  These are only started if the duration of the current source is known;
+     * otherwise the next item is requested when the current one finishes.
+     */
+    void startEndOfItemTimers();
+
+    /// Cancels the timers started by @c startEndOfItemTimers().
+    void cancelEndOfItemTimers();
+
+    /**
+     * Send @c PlaybackNearlyFinished for the current source, if it has not been sent already, and prefetch the next
+     * @c AudioItem if it has already been queued.
+     *
+     * @param id The id of the source which is nearly finished.
+     */
+    void executeOnPlaybackNearlyFinished(SourceId id);
+
+    /**
+     * Finish the current source and start playing the prefetched one, without waiting for the current source to
+     * report that it has finished.
+     *
+     * @param id The id of the source to switch from.
+     */
+    void executeSwitchToPrefetchedItem(SourceId id);
+
     /// @copydoc MediaPlayerObserverInterface::onPlaybackError()
     void executeOnPlaybackError(SourceId id, const avsCommon::utils::mediaPlayer::ErrorType& type, std::string error);
 
@@ -262,6 +294,20 @@ private:
     /// This fuction plays the next @c AudioItem in the queue.
     void playNextItem();
 
+    /**
+     * If prefetching is enabled, @c PlaybackNearlyFinished has been sent for the current item and nothing is
+     * prefetched yet, set the next queued @c AudioItem as the source of @c m_prefetchMediaPlayer and preroll it so
+     * that it is resolved and buffered before the current item ends.  Only URL items are prefetched; attachment items
+     * are already local.
+     */
+    void prefetchNextItem();
+
+    /**
+     * Discard any prefetched source.  This must be called whenever the front of @c m_audioItems is removed other
+     * than by @c playNextItem().
+     */
+    void cancelPrefetch();
+
     /**
      * This function stops playback of the current song, and optionally starts the next queued song.
      *
@@ -370,6 +416,12 @@ private:
     /// MediaPlayerInterface instance to send audio attachments to.
     std::shared_ptr<avsCommon::utils::mediaPlayer::MediaPlayerInterface> m_mediaPlayer;
 
+    /**
+     * The idle MediaPlayerInterface instance used to prefetch the next @c AudioItem, or @c nullptr if prefetching is
+     * disabled.  This is swapped with @c m_mediaPlayer when a prefetched item starts playing.
+     */
+    std::shared_ptr<avsCommon::utils::mediaPlayer::MediaPlayerInterface> m_prefetchMediaPlayer;
+
     /// The object to use for sending events.
     std::shared_ptr<avsCommon::sdkInterfaces::MessageSenderInterface> m_messageSender;
 
@@ -433,12 +485,39 @@ private:
     /// When in the @c BUFFER_UNDERRUN state, this records the time at which the state was entered.
     std::chrono::steady_clock::time_point m_bufferUnderrunTimestamp;
 
+    /// The id of the @c m_prefetchMediaPlayer source for the front of @c m_audioItems, or @c ERROR if none.
+    SourceId m_prefetchSourceId;
+
+    /// Whether the current source was prefetched.
+    bool m_isPlayingPrefetchedItem;
+
+    /// Whether @c PlaybackNearlyFinished has been sent for the current source.
+    bool m_isNearlyFinishedSent;
+
+    /**
+     * The id of the source which was switched away from before it finished, or @c ERROR if none.  Its remaining
+     * callbacks are expected and ignored.
+     */
+    SourceId m_switchedFromSourceId;
+
+    /**
+     * The time at which the previous @c AudioItem finished if the next one has not started yet, or
+     * @c time_point::min() otherwise.  This is used to measure the gap between items.
+     */
+    std::chrono::steady_clock::time_point m_previousItemFinishedTimestamp;
+
     /// This timer is used to send @c ProgressReportDelayElapsed events.
     avsCommon::utils::timing::Timer m_delayTimer;
 
     /// This timer is used to send @c ProgressReportIntervalElapsed events.
     avsCommon::utils::timing::Timer m_intervalTimer;
 
+    /// This timer is used to send @c PlaybackNearlyFinished and prefetch the next item when prefetching is enabled.
+    avsCommon::utils::timing::Timer m_nearlyFinishedTimer;
+
+    /// This timer is used to switch to the prefetched item just before the current one ends.
+    avsCommon::utils::timing::Timer m_switchTimer;
+
     /**
      * This keeps track of the current offset in the audio stream.  Reading the offset from @c MediaPlayer is
      * insufficient because @c MediaPlayer only returns a valid offset when it is actively playing, but @c AudioPlayer
@@ -17,6 +17,8 @@
 
 #include "AudioPlayer/AudioPlayer.h"
 
+#include <algorithm>
+
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 #include <rapidjson/error/en.h>
@@ -86,13 +88,24 @@ static const char STUTTER_DURATION_KEY[] = "stutterDurationInMilliseconds";
 /// The duration to wait for a state change in @c onFocusChanged before failing.
 static const std::chrono::seconds TIMEOUT{2};
 
+/**
+ * When prefetching, how long before the end of the current item to send @c PlaybackNearlyFinished and prefetch the
+ * next item.  This is long enough to fetch and buffer the start of the next item, but short enough that its URL is
+ * not left open for long before it plays.
+ */
+static const std::chrono::seconds PREFETCH_LEAD_TIME{10};
+
+/// When prefetching, how long before the end of the current item to start playing the prerolled next item.
+static const std::chrono::milliseconds SWITCH_LEAD_TIME{20};
+
 std::shared_ptr<AudioPlayer> AudioPlayer::create(
     std::shared_ptr<MediaPlayerInterface> mediaPlayer,
     std::shared_ptr<MessageSenderInterface> messageSender,
     std::shared_ptr<FocusManagerInterface> focusManager,
     std::shared_ptr<ContextManagerInterface> contextManager,
     std::shared_ptr<ExceptionEncounteredSenderInterface> exceptionSender,
-    std::shared_ptr<PlaybackRouterInterface> playbackRouter) {
+    std::shared_ptr<PlaybackRouterInterface> playbackRouter,
+    std::shared_ptr<MediaPlayerInterface> prefetchMediaPlayer) {
     if (nullptr == mediaPlayer) {
         ACSDK_ERROR(LX("createFailed").d("reason", "nullMediaPlayer"));
         return nullptr;
@@ -113,9 +126,23 @@ std::shared_ptr<AudioPlayer> AudioPlayer::create(
         return nullptr;
     }
 
-    auto audioPlayer = std::shared_ptr<AudioPlayer>(
-        new AudioPlayer(mediaPlayer, messageSender, focusManager, contextManager, exceptionSender, playbackRouter));
+    if (prefetchMediaPlayer == mediaPlayer) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "prefetchMediaPlayerIsMediaPlayer"));
+        return nullptr;
+    }
+
+    auto audioPlayer = std::shared_ptr<AudioPlayer>(new AudioPlayer(
+        mediaPlayer,
+        messageSender,
+        focusManager,
+        contextManager,
+        exceptionSender,
+        playbackRouter,
+        prefetchMediaPlayer));
     mediaPlayer->setObserver(audioPlayer);
+    if (prefetchMediaPlayer) {
+        prefetchMediaPlayer->setObserver(audioPlayer);
+    }
     contextManager->setStateProvider(STATE, audioPlayer);
     return audioPlayer;
 }
@@ -169,6 +196,7 @@ void AudioPlayer::onDeregistered() {
     ACSDK_DEBUG(LX("onDeregistered"));
     m_executor.submit([this] {
         executeStop();
+        cancelPrefetch();
         m_audioItems.clear();
     });
 }
@@ -336,10 +364,12 @@ AudioPlayer::AudioPlayer(
     std::shared_ptr<FocusManagerInterface> focusManager,
     std::shared_ptr<ContextManagerInterface> contextManager,
     std::shared_ptr<ExceptionEncounteredSenderInterface> exceptionSender,
-    std::shared_ptr<PlaybackRouterInterface> playbackRouter) :
+    std::shared_ptr<PlaybackRouterInterface> playbackRouter,
+    std::shared_ptr<MediaPlayerInterface> prefetchMediaPlayer) :
         CapabilityAgent{NAMESPACE, exceptionSender},
         RequiresShutdown{"AudioPlayer"},
         m_mediaPlayer{mediaPlayer},
+        m_prefetchMediaPlayer{prefetchMediaPlayer},
         m_messageSender{messageSender},
         m_focusManager{focusManager},
         m_contextManager{contextManager},
@@ -348,6 +378,11 @@ AudioPlayer::AudioPlayer(
         m_focus{FocusState::NONE},
         m_initialOffset{0},
         m_sourceId{MediaPlayerInterface::ERROR},
+        m_prefetchSourceId{MediaPlayerInterface::ERROR},
+        m_isPlayingPrefetchedItem{false},
+        m_isNearlyFinishedSent{false},
+        m_switchedFromSourceId{MediaPlayerInterface::ERROR},
+        m_previousItemFinishedTimestamp{std::chrono::steady_clock::time_point::min()},
         m_offset{std::chrono::milliseconds{std::chrono::milliseconds::zero()}},
         m_isStopCalled{false} {
 }
@@ -355,8 +390,13 @@ AudioPlayer::AudioPlayer(
 void AudioPlayer::doShutdown() {
     m_executor.shutdown();
     executeStop();
+    cancelPrefetch();
     m_mediaPlayer->setObserver(nullptr);
     m_mediaPlayer.reset();
+    if (m_prefetchMediaPlayer) {
+        m_prefetchMediaPlayer->setObserver(nullptr);
+        m_prefetchMediaPlayer.reset();
+    }
     m_messageSender.reset();
     m_focusManager.reset();
     m_contextManager->setStateProvider(STATE, nullptr);
@@ -670,6 +710,7 @@ void AudioPlayer::executeOnFocusChanged(FocusState newFocus) {
                 case PlayerActivity::BUFFER_UNDERRUN:
                     // If the focus change came in while we were in a 'playing' state, we need to stop because we are
                     // yielding the channel.
+                    cancelPrefetch();
                     m_audioItems.clear();
                     ACSDK_DEBUG1(LX("executeOnFocusChanged").d("action", "executeStop"));
                     executeStop();
@@ -698,12 +739,26 @@ void AudioPlayer::executeOnPlaybackStarted(SourceId id) {
     m_playbackRouter->switchToDefaultHandler();
     changeActivity(PlayerActivity::PLAYING);
 
+    if (m_previousItemFinishedTimestamp != std::chrono::steady_clock::time_point::min()) {
+        auto gap = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - m_previousItemFinishedTimestamp);
+        ACSDK_INFO(LX("audioItemGap").d("gapMs", gap.count()).d("prefetched", m_isPlayingPrefetchedItem));
+        m_previousItemFinishedTimestamp = std::chrono::steady_clock::time_point::min();
+    }
+
     sendPlaybackStartedEvent();
+    startEndOfItemTimers();
 }
 
 void AudioPlayer::executeOnPlaybackStopped(SourceId id) {
     ACSDK_DEBUG1(LX("executeOnPlaybackStopped").d("id", id));
 
+    if (MediaPlayerInterface::ERROR != m_switchedFromSourceId && id == m_switchedFromSourceId) {
+        ACSDK_DEBUG1(LX("executeOnPlaybackStopped").d("action", "ignoreSwitchedFromSource"));
+        m_switchedFromSourceId = MediaPlayerInterface::ERROR;
+        return;
+    }
+
     if (id != m_sourceId) {
         ACSDK_ERROR(LX("executeOnPlaybackStoppedFailed")
                         .d("reason", "invalidSourceId")
@@ -749,6 +804,13 @@ void AudioPlayer::executeOnPlaybackStopped(SourceId id) {
 void AudioPlayer::executeOnPlaybackFinished(SourceId id) {
     ACSDK_DEBUG1(LX("executeOnPlaybackFinished").d("id", id));
 
+    if (MediaPlayerInterface::ERROR != m_switchedFromSourceId && id == m_switchedFromSourceId) {
+        // The prefetched item was started just before this one ended.
+        ACSDK_DEBUG1(LX("executeOnPlaybackFinished").d("action", "ignoreSwitchedFromSource"));
+        m_switchedFromSourceId = MediaPlayerInterface::ERROR;
+        return;
+    }
+
     if (id != m_sourceId) {
         ACSDK_ERROR(LX("executeOnPlaybackFinishedFailed")
                         .d("reason", "invalidSourceId")
@@ -768,14 +830,19 @@ void AudioPlayer::executeOnPlaybackFinished(SourceId id) {
              * by the time we open the url, the url has already expired so we got a 403 reponse. To address this
              * problem, we are sending the PlaybackNearlyFinished event just before we send PlaybackFinished.
              *
-             * TODO: Once MediaPlayer can notify of nearly finished, send there instead (ACSDK-417).
+             * When prefetching and the duration is known, it is instead sent shortly before the end of the item by
+             * m_nearlyFinishedTimer, and the next item is opened as soon as it arrives.
              */
-            sendPlaybackNearlyFinishedEvent();
+            if (!m_isNearlyFinishedSent) {
+                m_isNearlyFinishedSent = true;
+                sendPlaybackNearlyFinishedEvent();
+            }
 
             sendPlaybackFinishedEvent();
             if (m_audioItems.empty()) {
                 handlePlaybackCompleted();
             } else {
+                m_previousItemFinishedTimestamp = std::chrono::steady_clock::now();
                 playNextItem();
             }
             return;
@@ -798,10 +865,70 @@ void AudioPlayer::cancelTimers() {
     ACSDK_DEBUG(LX("cancelTimers"));
     m_delayTimer.stop();
     m_intervalTimer.stop();
+    cancelEndOfItemTimers();
+}
+
+void AudioPlayer::startEndOfItemTimers() {
+    cancelEndOfItemTimers();
+    if (!m_prefetchMediaPlayer) {
+        return;
+    }
+    auto duration = m_mediaPlayer->getDuration(m_sourceId);
+    if (duration <= std::chrono::milliseconds::zero()) {
+        ACSDK_DEBUG1(LX("startEndOfItemTimersSkipped").d("reason", "durationUnknown"));
+        return;
+    }
+    auto remaining = duration - getOffset();
+    auto id = m_sourceId;
+    ACSDK_DEBUG1(LX("startEndOfItemTimers").d("id", id).d("remainingMs", remaining.count()));
+
+    if (!m_isNearlyFinishedSent) {
+        m_nearlyFinishedTimer.start(
+            std::max<std::chrono::milliseconds>(remaining - PREFETCH_LEAD_TIME, std::chrono::milliseconds::zero()),
+            [this, id] { m_executor.submit([this, id] { executeOnPlaybackNearlyFinished(id); }); });
+    }
+    m_switchTimer.start(
+        std::max<std::chrono::milliseconds>(remaining - SWITCH_LEAD_TIME, std::chrono::milliseconds::zero()),
+        [this, id] { m_executor.submit([this, id] { executeSwitchToPrefetchedItem(id); }); });
+}
+
+void AudioPlayer::cancelEndOfItemTimers() {
+    m_nearlyFinishedTimer.stop();
+    m_switchTimer.stop();
+}
+
+void AudioPlayer::executeOnPlaybackNearlyFinished(SourceId id) {
+    ACSDK_DEBUG1(LX("executeOnPlaybackNearlyFinished").d("id", id));
+    if (id != m_sourceId || m_isNearlyFinishedSent) {
+        return;
+    }
+    m_isNearlyFinishedSent = true;
+    sendPlaybackNearlyFinishedEvent();
+    prefetchNextItem();
+}
+
+void AudioPlayer::executeSwitchToPrefetchedItem(SourceId id) {
+    ACSDK_DEBUG1(LX("executeSwitchToPrefetchedItem").d("id", id).d("prefetchSourceId", m_prefetchSourceId));
+    if (id != m_sourceId || PlayerActivity::PLAYING != m_currentActivity) {
+        return;
+    }
+    if (MediaPlayerInterface::ERROR == m_prefetchSourceId) {
+        // The next item did not arrive in time, or cannot be prefetched; it is played when this one finishes.
+        ACSDK_DEBUG1(LX("executeSwitchToPrefetchedItemSkipped").d("reason", "nothingPrefetched"));
+        return;
+    }
+
+    // The rest of the current source plays out on what becomes m_prefetchMediaPlayer.
+    m_switchedFromSourceId = id;
+    changeActivity(PlayerActivity::FINISHED);
+    sendPlaybackFinishedEvent();
+    m_previousItemFinishedTimestamp = std::chrono::steady_clock::now();
+    playNextItem();
 }
 
 void AudioPlayer::handlePlaybackCompleted() {
     cancelTimers();
+    m_previousItemFinishedTimestamp = std::chrono::steady_clock::time_point::min();
     if (m_focus != avsCommon::avs::FocusState::NONE) {
         m_focusManager->releaseChannel(CHANNEL_NAME, shared_from_this());
     }
@@ -810,6 +937,13 @@ void AudioPlayer::handlePlaybackCompleted() {
 void AudioPlayer::executeOnPlaybackError(SourceId id, const ErrorType& type, std::string error) {
     ACSDK_ERROR(LX("executeOnPlaybackError").d("id", id).d("type", type).d("error", error));
 
+    if (MediaPlayerInterface::ERROR != m_prefetchSourceId && id == m_prefetchSourceId) {
+        // The next item will be fetched again when it is due to play, and any error reported then.
+        ACSDK_WARN(LX("executeOnPlaybackError").d("action", "discardPrefetchedSource"));
+        m_prefetchSourceId = MediaPlayerInterface::ERROR;
+        return;
+    }
+
     if (id != m_sourceId) {
         ACSDK_ERROR(
             LX("executeOnPlaybackErrorFailed").d("reason", "invalidSourceId").d("id", id).d("m_sourceId", m_sourceId));
@@ -834,6 +968,7 @@ void AudioPlayer::executeOnPlaybackPaused(SourceId id) {
         return;
     }
 
+    cancelEndOfItemTimers();
     // TODO: AVS recommends sending this after a recognize event to reduce latency (ACSDK-371).
     sendPlaybackPausedEvent();
     changeActivity(PlayerActivity::PAUSED);
@@ -857,6 +992,7 @@ void AudioPlayer::executeOnPlaybackResumed(SourceId id) {
 
     sendPlaybackResumedEvent();
     changeActivity(PlayerActivity::PLAYING);
+    startEndOfItemTimers();
 }
 
 void AudioPlayer::executeOnBufferUnderrun(SourceId id) {
@@ -872,6 +1008,7 @@ void AudioPlayer::executeOnBufferUnderrun(SourceId id) {
         ACSDK_ERROR(LX("executeOnBufferUnderrunFailed").d("reason", "alreadyInUnderrun"));
         return;
     }
+    cancelEndOfItemTimers();
     m_bufferUnderrunTimestamp = std::chrono::steady_clock::now();
     sendPlaybackStutterStartedEvent();
     changeActivity(PlayerActivity::BUFFER_UNDERRUN);
@@ -888,6 +1025,7 @@ void AudioPlayer::executeOnBufferRefilled(SourceId id) {
 
     sendPlaybackStutterFinishedEvent();
     changeActivity(PlayerActivity::PLAYING);
+    startEndOfItemTimers();
 }
 
 void AudioPlayer::executeOnTags(SourceId id, std::shared_ptr<const VectorOfTags> vectorOfTags) {
@@ -924,6 +1062,7 @@ void AudioPlayer::executePlay(PlayBehavior playBehavior, const AudioItem& audioI
             executeStop(true);
         // FALL-THROUGH
         case PlayBehavior::REPLACE_ENQUEUED:
+            cancelPrefetch();
             m_audioItems.clear();
         // FALL-THROUGH
         case PlayBehavior::ENQUEUE:
@@ -956,8 +1095,8 @@ void AudioPlayer::executePlay(PlayBehavior playBehavior, const AudioItem& audioI
         case PlayerActivity::PLAYING:
         case PlayerActivity::PAUSED:
         case PlayerActivity::BUFFER_UNDERRUN:
-            // If we're already 'playing', the new song should have been enqueued above and there's nothing more to do
-            // here.
+            // If we're already 'playing', the new song should have been enqueued above, and may need prefetching.
+            prefetchNextItem();
             return;
     }
     ACSDK_ERROR(LX("executePlayFailed").d("reason", "unexpectedActivity").d("m_currentActivity", m_currentActivity));
@@ -980,8 +1119,15 @@ void AudioPlayer::playNextItem() {
     m_token = item.stream.token;
     m_audioItemId = item.id;
     m_initialOffset = item.stream.offset;
-
-    if (item.stream.reader) {
+    m_isNearlyFinishedSent = false;
+    m_isPlayingPrefetchedItem = MediaPlayerInterface::ERROR != m_prefetchSourceId;
+
+    if (m_isPlayingPrefetchedItem) {
+        ACSDK_DEBUG9(LX("playingPrefetchedSource").d("prefetchSourceId", m_prefetchSourceId));
+        std::swap(m_mediaPlayer, m_prefetchMediaPlayer);
+        m_sourceId = m_prefetchSourceId;
+        m_prefetchSourceId = MediaPlayerInterface::ERROR;
+    } else if (item.stream.reader) {
         m_sourceId = m_mediaPlayer->setSource(std::move(item.stream.reader));
         if (MediaPlayerInterface::ERROR == m_sourceId) {
             sendPlaybackFailedEvent(
@@ -1029,6 +1175,38 @@ void AudioPlayer::playNextItem() {
     }
 }
 
+void AudioPlayer::prefetchNextItem() {
+    if (!m_prefetchMediaPlayer || !m_isNearlyFinishedSent || MediaPlayerInterface::ERROR != m_prefetchSourceId ||
+        m_audioItems.empty()) {
+        return;
+    }
+    const auto& item = m_audioItems.front();
+    if (item.stream.reader) {
+        return;
+    }
+    ACSDK_DEBUG1(LX("prefetchNextItem").d("audioItemId", item.id));
+    m_prefetchSourceId = m_prefetchMediaPlayer->setSource(item.stream.url, item.stream.offset);
+    if (MediaPlayerInterface::ERROR == m_prefetchSourceId) {
+        // Not fatal; the item will be fetched again when it is due to play.
+        ACSDK_WARN(LX("prefetchNextItemFailed").d("reason", "setSourceFailed"));
+        return;
+    }
+    if (!m_prefetchMediaPlayer->preroll(m_prefetchSourceId)) {
+        // Not fatal; the source is opened when it is played instead.
+        ACSDK_DEBUG1(LX("prefetchNextItem").d("reason", "prerollNotStarted"));
+    }
+}
+
+void AudioPlayer::cancelPrefetch() {
+    if (MediaPlayerInterface::ERROR == m_prefetchSourceId) {
+        return;
+    }
+    ACSDK_DEBUG1(LX("cancelPrefetch").d("prefetchSourceId", m_prefetchSourceId));
+    // A source which has not started playing is released when the next source is set on m_prefetchMediaPlayer.
+    m_prefetchMediaPlayer->stop(m_prefetchSourceId);
+    m_prefetchSourceId = MediaPlayerInterface::ERROR;
+}
+
 void AudioPlayer::executeStop(bool playNextItem) {
     ACSDK_DEBUG1(LX("executeStop").d("playNextItem", playNextItem).d("m_currentActivity", m_currentActivity));
     switch (m_currentActivity) {
@@ -1062,6 +1240,7 @@ void AudioPlayer::executeClearQueue(ClearBehavior clearBehavior) {
             executeStop();
         // FALL-THROUGH
         case ClearBehavior::CLEAR_ENQUEUED:
+            cancelPrefetch();
             m_audioItems.clear();
             sendPlaybackQueueClearedEvent();
             return;
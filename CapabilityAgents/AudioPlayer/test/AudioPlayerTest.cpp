@@ -110,6 +110,18 @@ static const std::string FORMAT_TEST("AUDIO_MPEG");
 /// URL for testing.
 static const std::string URL_TEST("cid:Test");
 
+/// A URL which is not an attachment, for testing.
+static const std::string HTTP_URL_TEST("https://example.com/next.mp3");
+
+/// A duration which is close enough to its end for the next item to be prefetched, but far from switching to it.
+static const std::chrono::milliseconds DURATION_NEAR_END_TEST{5000};
+
+/// A duration which is too far from its end for the next item to be prefetched during a test.
+static const std::chrono::milliseconds DURATION_LONG_TEST{600000};
+
+/// A duration which ends shortly after playback starts.
+static const std::chrono::milliseconds DURATION_SHORT_TEST{500};
+
 /// ENQUEUE playBehavior.
 static const std::string NAME_ENQUEUE("ENQUEUE");
 
@@ -189,6 +201,23 @@ static std::string createEnqueuePayloadTest(long offsetInMilliseconds) {
     return ENQUEUE_PAYLOAD_TEST;
 }
 
+// clang-format off
+static const std::string ENQUEUE_HTTP_URL_PAYLOAD_TEST =
+"{"
+    "\"playBehavior\":\"" + NAME_ENQUEUE + "\","
+    "\"audioItem\": {"
+        "\"audioItemId\":\"" + AUDIO_ITEM_ID_2 + "\","
+        "\"stream\": {"
+            "\"url\":\"" + HTTP_URL_TEST + "\","
+            "\"streamFormat\":\"" + FORMAT_TEST + "\","
+            "\"offsetInMilliseconds\":0,"
+            "\"token\":\"" + TOKEN_TEST + "\","
+            "\"expectedPreviousToken\":\"\""
+        "}"
+    "}"
+"}";
+// clang-format on
+
 // clang-format off
 static const std::string REPLACE_ALL_PAYLOAD_TEST =
 "{"
@@ -461,6 +490,28 @@ public:
      */
     void sendPlayDirective(long offsetInMilliseconds = OFFSET_IN_MILLISECONDS_TEST);
 
+    /**
+     * Replace @c m_audioPlayer with one which prefetches into @c m_mockPrefetchMediaPlayer.
+     *
+     * @param duration The duration @c m_mockMediaPlayer reports for its sources.
+     */
+    void enablePrefetch(std::chrono::milliseconds duration = DURATION_NEAR_END_TEST);
+
+    /**
+     * Send a Play directive which enqueues an @c AudioItem with an HTTP URL.
+     */
+    void sendEnqueueHttpUrlDirective();
+
+    /**
+     * Send a Play directive which enqueues an @c AudioItem with an HTTP URL, and wait for it to be prefetched.
+     *
+     * @return The id of the prefetched source.
+     */
+    MediaPlayerInterface::SourceId enqueueAndWaitForPrefetch();
+
+    /// The second player, used when testing prefetch.
+    std::shared_ptr<MockMediaPlayer> m_mockPrefetchMediaPlayer;
+
     /**
      * Consolidate code to send ClearQueue directive
      */
@@ -553,6 +604,9 @@ void AudioPlayerTest::SetUp() {
 void AudioPlayerTest::TearDown() {
     m_audioPlayer->shutdown();
     m_mockMediaPlayer->shutdown();
+    if (m_mockPrefetchMediaPlayer) {
+        m_mockPrefetchMediaPlayer->shutdown();
+    }
 }
 
 SetStateResult AudioPlayerTest::wakeOnSetState() {
@@ -599,6 +653,56 @@ void AudioPlayerTest::sendPlayDirective(long offsetInMilliseconds) {
     ASSERT_TRUE(m_testAudioPlayerObserver->waitFor(PlayerActivity::PLAYING, WAIT_TIMEOUT));
 }
 
+void AudioPlayerTest::enablePrefetch(std::chrono::milliseconds duration) {
+    m_audioPlayer->shutdown();
+    ON_CALL(*m_mockMediaPlayer, getDuration(_)).WillByDefault(Return(duration));
+    m_mockPrefetchMediaPlayer = MockMediaPlayer::create();
+    // Real MediaPlayer source ids are unique across players, so keep those of the two mocks apart too.
+    for (int i = 0; i < 10; ++i) {
+        m_mockPrefetchMediaPlayer->mockSetSource();
+    }
+    m_audioPlayer = AudioPlayer::create(
+        m_mockMediaPlayer,
+        m_mockMessageSender,
+        m_mockFocusManager,
+        m_mockContextManager,
+        m_mockExceptionSender,
+        m_mockPlaybackRouter,
+        m_mockPrefetchMediaPlayer);
+    ASSERT_TRUE(m_audioPlayer);
+    m_audioPlayer->addObserver(m_testAudioPlayerObserver);
+}
+
+void AudioPlayerTest::sendEnqueueHttpUrlDirective() {
+    auto avsMessageHeader =
+        std::make_shared<AVSMessageHeader>(NAMESPACE_AUDIO_PLAYER, NAME_PLAY, MESSAGE_ID_TEST_2, PLAY_REQUEST_ID_TEST);
+    std::shared_ptr<AVSDirective> playDirective = AVSDirective::create(
+        "", avsMessageHeader, ENQUEUE_HTTP_URL_PAYLOAD_TEST, m_attachmentManager, CONTEXT_ID_TEST_2);
+    auto mockDirectiveHandlerResult = std::unique_ptr<MockDirectiveHandlerResult>(new MockDirectiveHandlerResult);
+    EXPECT_CALL(*mockDirectiveHandlerResult, setCompleted());
+    m_audioPlayer->CapabilityAgent::preHandleDirective(playDirective, std::move(mockDirectiveHandlerResult));
+    m_audioPlayer->CapabilityAgent::handleDirective(MESSAGE_ID_TEST_2);
+}
+
+MediaPlayerInterface::SourceId AudioPlayerTest::enqueueAndWaitForPrefetch() {
+    std::promise<MediaPlayerInterface::SourceId> prefetchPromise;
+    auto prefetchFuture = prefetchPromise.get_future();
+    EXPECT_CALL(*m_mockPrefetchMediaPlayer, urlSetSource(HTTP_URL_TEST))
+        .WillOnce(Invoke([this, &prefetchPromise](const std::string&) {
+            auto id = m_mockPrefetchMediaPlayer->mockSetSource();
+            prefetchPromise.set_value(id);
+            return id;
+        }));
+
+    sendEnqueueHttpUrlDirective();
+
+    if (std::future_status::ready != prefetchFuture.wait_for(WAIT_TIMEOUT)) {
+        ADD_FAILURE() << "next item was not prefetched";
+        return MediaPlayerInterface::ERROR;
+    }
+    return prefetchFuture.get();
+}
+
 void AudioPlayerTest::sendClearQueueDirective() {
     auto avsClearMessageHeader = std::make_shared<AVSMessageHeader>(
         NAMESPACE_AUDIO_PLAYER, NAME_CLEARQUEUE, MESSAGE_ID_TEST, PLAY_REQUEST_ID_TEST);
@@ -1638,6 +1742,102 @@ TEST_F(AudioPlayerTest, testProgressReportIntervalElapsedIntervalLessThanOffset)
     ASSERT_TRUE(result);
 }
 
+/**
+ * Test that with prefetching enabled, an item enqueued near the end of playback is set as the source of the prefetch
+ * player, which then plays it when the current item finishes, without the item being fetched again.
+ */
+TEST_F(AudioPlayerTest, testPrefetchedItemPlaysOnPrefetchPlayer) {
+    enablePrefetch();
+    EXPECT_CALL(*m_mockMediaPlayer, urlSetSource(_)).Times(0);
+
+    sendPlayDirective();
+    auto prefetchSourceId = enqueueAndWaitForPrefetch();
+    ASSERT_TRUE(MediaPlayerInterface::ERROR != prefetchSourceId);
+
+    EXPECT_CALL(*m_mockPrefetchMediaPlayer, play(prefetchSourceId));
+    m_mockMediaPlayer->mockFinished(m_mockMediaPlayer->getCurrentSourceId());
+
+    ASSERT_TRUE(m_mockPrefetchMediaPlayer->waitUntilPlaybackStarted(WAIT_TIMEOUT));
+    ASSERT_TRUE(m_testAudioPlayerObserver->waitFor(PlayerActivity::PLAYING, WAIT_TIMEOUT));
+}
+
+/**
+ * Test that with prefetching enabled, clearing the queue stops the prefetched source.
+ */
+TEST_F(AudioPlayerTest, testClearQueueCancelsPrefetch) {
+    enablePrefetch();
+
+    sendPlayDirective();
+    auto prefetchSourceId = enqueueAndWaitForPrefetch();
+    ASSERT_TRUE(MediaPlayerInterface::ERROR != prefetchSourceId);
+
+    std::promise<void> stopPromise;
+    auto stopFuture = stopPromise.get_future();
+    EXPECT_CALL(*m_mockPrefetchMediaPlayer, stop(prefetchSourceId)).WillOnce(InvokeWithoutArgs([&stopPromise] {
+        stopPromise.set_value();
+        return false;
+    }));
+    sendClearQueueDirective();
+
+    ASSERT_EQ(std::future_status::ready, stopFuture.wait_for(WAIT_TIMEOUT));
+}
+
+/**
+ * Test that with prefetching enabled, @c PlaybackNearlyFinished is not sent and nothing is prefetched while the end of
+ * the current item is far away, so the item which finishes sends @c PlaybackNearlyFinished once and then plays the next
+ * item from its URL.
+ */
+TEST_F(AudioPlayerTest, testPrefetchWaitsUntilNearlyFinished) {
+    enablePrefetch(DURATION_LONG_TEST);
+    int nearlyFinishedCount = 0;
+    EXPECT_CALL(*m_mockMessageSender, sendMessage(_))
+        .WillRepeatedly(Invoke([this, &nearlyFinishedCount](std::shared_ptr<avsCommon::avs::MessageRequest> request) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (verifyMessage(request, PLAYBACK_NEARLY_FINISHED_NAME)) {
+                ++nearlyFinishedCount;
+            }
+        }));
+    EXPECT_CALL(*m_mockPrefetchMediaPlayer, urlSetSource(_)).Times(0);
+
+    sendPlayDirective();
+    auto firstSourceId = m_mockMediaPlayer->getCurrentSourceId();
+    std::promise<void> setSourcePromise;
+    auto setSourceFuture = setSourcePromise.get_future();
+    EXPECT_CALL(*m_mockMediaPlayer, urlSetSource(HTTP_URL_TEST)).WillOnce(InvokeWithoutArgs([this, &setSourcePromise] {
+        setSourcePromise.set_value();
+        return m_mockMediaPlayer->mockSetSource();
+    }));
+    sendEnqueueHttpUrlDirective();
+    m_mockMediaPlayer->mockFinished(firstSourceId);
+
+    // PlaybackNearlyFinished is sent before the next item is set as the source.
+    ASSERT_EQ(std::future_status::ready, setSourceFuture.wait_for(WAIT_TIMEOUT));
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ASSERT_EQ(1, nearlyFinishedCount);
+}
+
+/**
+ * Test that with prefetching enabled, the prefetched item is prerolled and starts playing just before the current item
+ * ends, without waiting for the current item to finish, and that the current item finishing afterwards is ignored.
+ */
+TEST_F(AudioPlayerTest, testSwitchesToPrefetchedItemBeforeEnd) {
+    enablePrefetch(DURATION_SHORT_TEST);
+    EXPECT_CALL(*m_mockMediaPlayer, urlSetSource(_)).Times(0);
+    EXPECT_CALL(*m_mockPrefetchMediaPlayer, preroll(_)).WillOnce(Return(true));
+
+    sendPlayDirective();
+    auto firstSourceId = m_mockMediaPlayer->getCurrentSourceId();
+    auto prefetchSourceId = enqueueAndWaitForPrefetch();
+    ASSERT_TRUE(MediaPlayerInterface::ERROR != prefetchSourceId);
+
+    EXPECT_CALL(*m_mockPrefetchMediaPlayer, play(prefetchSourceId));
+    ASSERT_TRUE(m_mockPrefetchMediaPlayer->waitUntilPlaybackStarted(WAIT_TIMEOUT));
+    ASSERT_TRUE(m_testAudioPlayerObserver->waitFor(PlayerActivity::PLAYING, WAIT_TIMEOUT));
+
+    m_mockMediaPlayer->mockFinished(firstSourceId);
+    ASSERT_FALSE(m_testAudioPlayerObserver->waitFor(PlayerActivity::FINISHED, DURATION_SHORT_TEST));
+}
+
 }  // namespace test
 }  // namespace audioPlayer
 }  // namespace capabilityAgents
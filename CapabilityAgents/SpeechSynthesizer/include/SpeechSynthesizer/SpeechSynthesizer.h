@@ -16,6 +16,8 @@
 #ifndef ALEXA_CLIENT_SDK_CAPABILITYAGENTS_SPEECHSYNTHESIZER_INCLUDE_SPEECHSYNTHESIZER_SPEECHSYNTHESIZER_H_
 #define ALEXA_CLIENT_SDK_CAPABILITYAGENTS_SPEECHSYNTHESIZER_INCLUDE_SPEECHSYNTHESIZER_SPEECHSYNTHESIZER_H_
 
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -65,6 +67,10 @@ public:
      * of the @c SpeechSynthesizer.
      * @param exceptionSender The instance of the @c ExceptionEncounteredSenderInterface to use to notify AVS
      * when a directive cannot be processed.
+     * @param dialogUXStateAggregator The @c DialogUXStateAggregator to register with.
+     * @param prestageMediaPlayer An optional second @c MediaPlayerInterface.  When provided, the next pre-handled
+     * @c Speak is set and prerolled on it while the current @c Speak plays, and the two players swap roles when it
+     * starts.  It must be a different instance from @c mediaPlayer.
      *
      * @return Returns a new @c SpeechSynthesizer, or @c nullptr if the operation failed.
      */
@@ -74,7 +80,8 @@ public:
         std::shared_ptr<avsCommon::sdkInterfaces::FocusManagerInterface> focusManager,
         std::shared_ptr<avsCommon::sdkInterfaces::ContextManagerInterface> contextManager,
         std::shared_ptr<avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionSender,
-        std::shared_ptr<avsCommon::avs::DialogUXStateAggregator> dialogUXStateAggregator);
+        std::shared_ptr<avsCommon::avs::DialogUXStateAggregator> dialogUXStateAggregator,
+        std::shared_ptr<avsCommon::utils::mediaPlayer::MediaPlayerInterface> prestageMediaPlayer = nullptr);
 
     void onDialogUXStateChanged(DialogUXState newState) override;
 
@@ -160,6 +167,9 @@ private:
 
         /// A flag to indicate if the directive complete message has to be sent to the @c DirectiveSequencer.
         bool sendCompletedMessage;
+
+        /// The order in which this Speak was pre-handled, used to pick the next Speak to prestage.
+        uint64_t preHandleSequence;
     };
 
     /**
@@ -172,13 +182,15 @@ private:
      * of the SpeechSynthesizer.
      * @param exceptionSender The instance of the @c ExceptionEncounteredSenderInterface to use to notify AVS
      * when a directive cannot be processed.
+     * @param prestageMediaPlayer The optional @c MediaPlayerInterface used to prestage the next @c Speak.
      */
     SpeechSynthesizer(
         std::shared_ptr<avsCommon::utils::mediaPlayer::MediaPlayerInterface> mediaPlayer,
         std::shared_ptr<avsCommon::sdkInterfaces::MessageSenderInterface> messageSender,
         std::shared_ptr<avsCommon::sdkInterfaces::FocusManagerInterface> focusManager,
         std::shared_ptr<avsCommon::sdkInterfaces::ContextManagerInterface> contextManager,
-        std::shared_ptr<avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionSender);
+        std::shared_ptr<avsCommon::sdkInterfaces::ExceptionEncounteredSenderInterface> exceptionSender,
+        std::shared_ptr<avsCommon::utils::mediaPlayer::MediaPlayerInterface> prestageMediaPlayer);
 
     void doShutdown() override;
 
@@ -311,6 +323,27 @@ private:
      */
     void stopPlaying();
 
+    /**
+     * Set the earliest pre-handled @c Speak that is not the current one as the source of @c m_prestagePlayer and
+     * preroll it, so that @c startPlaying() only has to swap players and call @c play().  Does nothing if there is no
+     * prestage player or a @c Speak is already prestaged.
+     */
+    void prestageNextSpeak();
+
+    /**
+     * Drop the prestaged @c Speak (if any), stopping its source on @c m_prestagePlayer.
+     */
+    void discardPrestagedSpeak();
+
+    /**
+     * Check whether a @c MediaPlayer callback refers to a prestaged (or discarded prestaged) source rather than the
+     * one that is playing.  This may be called from @c MediaPlayer threads.
+     *
+     * @param id The @c SourceId passed to the callback.
+     * @return Whether the callback should be ignored by the playback state machine.
+     */
+    bool isPrestagedSourceId(SourceId id) const;
+
     /**
      * Set the current state of the @c SpeechSynthesizer. The method updates the
      * @c ContextManager with the new state and send an event with the updated state to AVS where applicable.
@@ -439,6 +472,33 @@ private:
     /// MediaPlayerInterface instance to send audio attachments to
     std::shared_ptr<avsCommon::utils::mediaPlayer::MediaPlayerInterface> m_speechPlayer;
 
+    /**
+     * Optional second player on which the next @c Speak is prestaged.  It swaps roles with @c m_speechPlayer when the
+     * prestaged @c Speak starts.  Only accessed from the executor.
+     */
+    std::shared_ptr<avsCommon::utils::mediaPlayer::MediaPlayerInterface> m_prestagePlayer;
+
+    /// The @c SpeakDirectiveInfo whose audio is set on @c m_prestagePlayer, if any.
+    std::shared_ptr<SpeakDirectiveInfo> m_prestagedInfo;
+
+    /// The id of the source set on @c m_prestagePlayer.  Read from @c MediaPlayer callback threads.
+    std::atomic<SourceId> m_prestagedSourceId;
+
+    /// The id of the last prestaged source that was discarded, whose stop notification must be ignored.
+    std::atomic<SourceId> m_discardedSourceId;
+
+    /// Counter used to order pre-handled @c Speak directives.
+    uint64_t m_preHandleCount;
+
+    /// Whether the current @c Speak was started from @c m_prestagePlayer.
+    bool m_isPlayingPrestagedSpeak;
+
+    /**
+     * When the previous @c Speak finished with another @c Speak already pre-handled, used to report the gap until the
+     * next one starts.  @c time_point::min() otherwise.
+     */
+    std::chrono::steady_clock::time_point m_previousSpeakFinishedTimestamp;
+
     /// Object used to send events.
     std::shared_ptr<avsCommon::sdkInterfaces::MessageSenderInterface> m_messageSender;
 
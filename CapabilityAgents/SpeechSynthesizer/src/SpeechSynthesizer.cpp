@@ -98,7 +98,8 @@ std::shared_ptr<SpeechSynthesizer> SpeechSynthesizer::create(
     std::shared_ptr<FocusManagerInterface> focusManager,
     std::shared_ptr<ContextManagerInterface> contextManager,
     std::shared_ptr<ExceptionEncounteredSenderInterface> exceptionSender,
-    std::shared_ptr<avsCommon::avs::DialogUXStateAggregator> dialogUXStateAggregator) {
+    std::shared_ptr<avsCommon::avs::DialogUXStateAggregator> dialogUXStateAggregator,
+    std::shared_ptr<MediaPlayerInterface> prestageMediaPlayer) {
     if (!mediaPlayer) {
         ACSDK_ERROR(LX("SpeechSynthesizerCreationFailed").d("reason", "mediaPlayerNullReference"));
         return nullptr;
@@ -119,8 +120,12 @@ std::shared_ptr<SpeechSynthesizer> SpeechSynthesizer::create(
         ACSDK_ERROR(LX("SpeechSynthesizerCreationFailed").d("reason", "exceptionSenderNullReference"));
         return nullptr;
     }
-    auto speechSynthesizer = std::shared_ptr<SpeechSynthesizer>(
-        new SpeechSynthesizer(mediaPlayer, messageSender, focusManager, contextManager, exceptionSender));
+    if (prestageMediaPlayer == mediaPlayer) {
+        ACSDK_ERROR(LX("SpeechSynthesizerCreationFailed").d("reason", "prestageMediaPlayerIsMediaPlayer"));
+        return nullptr;
+    }
+    auto speechSynthesizer = std::shared_ptr<SpeechSynthesizer>(new SpeechSynthesizer(
+        mediaPlayer, messageSender, focusManager, contextManager, exceptionSender, prestageMediaPlayer));
     speechSynthesizer->init();
 
     dialogUXStateAggregator->addObserver(speechSynthesizer);
@@ -232,6 +237,10 @@ void SpeechSynthesizer::onContextFailure(const ContextRequestError error) {
 
 void SpeechSynthesizer::onPlaybackStarted(SourceId id) {
     ACSDK_DEBUG9(LX("onPlaybackStarted").d("callbackSourceId", id));
+    if (id != m_mediaSourceId && isPrestagedSourceId(id)) {
+        ACSDK_DEBUG9(LX("onPlaybackStartedIgnored").d("reason", "prestagedSource").d("callbackSourceId", id));
+        return;
+    }
     ACSDK_METRIC_IDS(TAG, "SpeechStarted", "", "", Metrics::Location::SPEECH_SYNTHESIZER_RECEIVE);
     if (id != m_mediaSourceId) {
         ACSDK_ERROR(LX("queueingExecutePlaybackStartedFailed")
@@ -248,6 +257,10 @@ void SpeechSynthesizer::onPlaybackStarted(SourceId id) {
 
 void SpeechSynthesizer::onPlaybackFinished(SourceId id) {
     ACSDK_DEBUG9(LX("onPlaybackFinished").d("callbackSourceId", id));
+    if (id != m_mediaSourceId && isPrestagedSourceId(id)) {
+        ACSDK_DEBUG9(LX("onPlaybackFinishedIgnored").d("reason", "prestagedSource").d("callbackSourceId", id));
+        return;
+    }
     ACSDK_METRIC_IDS(TAG, "SpeechFinished", "", "", Metrics::Location::SPEECH_SYNTHESIZER_RECEIVE);
 
     if (id != m_mediaSourceId) {
@@ -268,6 +281,17 @@ void SpeechSynthesizer::onPlaybackError(
     const avsCommon::utils::mediaPlayer::ErrorType& type,
     std::string error) {
     ACSDK_DEBUG9(LX("onPlaybackError").d("callbackSourceId", id));
+    if (id != m_mediaSourceId && isPrestagedSourceId(id)) {
+        // The prestaged Speak will fail when it is played, since its attachment now belongs to the failed source.
+        ACSDK_ERROR(LX("prestagedSourceFailed").d("callbackSourceId", id).d("type", type).d("error", error));
+        m_executor.submit([this, id]() {
+            if (id == m_prestagedSourceId) {
+                m_prestagedInfo.reset();
+                m_prestagedSourceId = MediaPlayerInterface::ERROR;
+            }
+        });
+        return;
+    }
     m_executor.submit([this, type, error]() { executePlaybackError(type, error); });
 }
 
@@ -281,7 +305,8 @@ SpeechSynthesizer::SpeakDirectiveInfo::SpeakDirectiveInfo(std::shared_ptr<Direct
         result{directiveInfo->result},
         sendPlaybackStartedMessage{false},
         sendPlaybackFinishedMessage{false},
-        sendCompletedMessage{false} {
+        sendCompletedMessage{false},
+        preHandleSequence{0} {
 }
 
 void SpeechSynthesizer::SpeakDirectiveInfo::clear() {
@@ -296,11 +321,18 @@ SpeechSynthesizer::SpeechSynthesizer(
     std::shared_ptr<MessageSenderInterface> messageSender,
     std::shared_ptr<FocusManagerInterface> focusManager,
     std::shared_ptr<ContextManagerInterface> contextManager,
-    std::shared_ptr<ExceptionEncounteredSenderInterface> exceptionSender) :
+    std::shared_ptr<ExceptionEncounteredSenderInterface> exceptionSender,
+    std::shared_ptr<MediaPlayerInterface> prestageMediaPlayer) :
         CapabilityAgent{NAMESPACE, exceptionSender},
         RequiresShutdown{"SpeechSynthesizer"},
         m_mediaSourceId{MediaPlayerInterface::ERROR},
         m_speechPlayer{mediaPlayer},
+        m_prestagePlayer{prestageMediaPlayer},
+        m_prestagedSourceId{MediaPlayerInterface::ERROR},
+        m_discardedSourceId{MediaPlayerInterface::ERROR},
+        m_preHandleCount{0},
+        m_isPlayingPrestagedSpeak{false},
+        m_previousSpeakFinishedTimestamp{std::chrono::steady_clock::time_point::min()},
         m_messageSender{messageSender},
         m_focusManager{focusManager},
         m_contextManager{contextManager},
@@ -313,7 +345,12 @@ SpeechSynthesizer::SpeechSynthesizer(
 
 void SpeechSynthesizer::doShutdown() {
     ACSDK_DEBUG9(LX("doShutdown"));
+    // The executor swaps the speech and prestage players when a prestaged Speak starts, so stop it before using either.
+    m_executor.shutdown();
     m_speechPlayer->setObserver(nullptr);
+    if (m_prestagePlayer) {
+        m_prestagePlayer->setObserver(nullptr);
+    }
     {
         std::unique_lock<std::mutex> lock(m_mutex);
         if (SpeechSynthesizerObserverInterface::SpeechSynthesizerState::PLAYING == m_currentState ||
@@ -338,7 +375,8 @@ void SpeechSynthesizer::doShutdown() {
             removeDirective(info.get()->directive->getMessageId());
         }
     }
-    m_executor.shutdown();
+    discardPrestagedSpeak();
+    m_prestagePlayer.reset();
     m_speechPlayer.reset();
     m_waitOnStateChange.notify_one();
     m_messageSender.reset();
@@ -349,6 +387,9 @@ void SpeechSynthesizer::doShutdown() {
 
 void SpeechSynthesizer::init() {
     m_speechPlayer->setObserver(shared_from_this());
+    if (m_prestagePlayer) {
+        m_prestagePlayer->setObserver(shared_from_this());
+    }
     m_contextManager->setStateProvider(CONTEXT_MANAGER_SPEECH_STATE, shared_from_this());
 }
 
@@ -430,11 +471,14 @@ void SpeechSynthesizer::executePreHandleAfterValidation(std::shared_ptr<SpeakDir
     }
 
     // If everything checks out, add the speakInfo to the map.
+    speakInfo->preHandleSequence = m_preHandleCount++;
     if (!setSpeakDirectiveInfo(speakInfo->directive->getMessageId(), speakInfo)) {
         ACSDK_ERROR(LX("executePreHandleFailed")
                         .d("reason", "prehandleCalledTwiceOnSameDirective")
                         .d("messageId", speakInfo->directive->getMessageId()));
+        return;
     }
+    prestageNextSpeak();
 }
 
 void SpeechSynthesizer::executeHandleAfterValidation(std::shared_ptr<SpeakDirectiveInfo> speakInfo) {
@@ -475,7 +519,11 @@ void SpeechSynthesizer::executeCancel(std::shared_ptr<DirectiveInfo> info) {
         ACSDK_ERROR(LX("executeCancelFailed").d("reason", "invalidDirectiveInfo"));
         return;
     }
+    m_previousSpeakFinishedTimestamp = std::chrono::steady_clock::time_point::min();
     if (speakInfo != m_currentInfo) {
+        if (speakInfo == m_prestagedInfo) {
+            discardPrestagedSpeak();
+        }
         speakInfo->clear();
         removeSpeakDirectiveInfo(speakInfo->directive->getMessageId());
         {
@@ -588,6 +636,13 @@ void SpeechSynthesizer::executePlaybackStarted() {
         setCurrentStateLocked(SpeechSynthesizerObserverInterface::SpeechSynthesizerState::PLAYING);
     }
     m_waitOnStateChange.notify_one();
+    if (m_previousSpeakFinishedTimestamp != std::chrono::steady_clock::time_point::min()) {
+        auto gap = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - m_previousSpeakFinishedTimestamp);
+        ACSDK_INFO(LX("speechGap").d("gapMs", gap.count()).d("prestaged", m_isPlayingPrestagedSpeak));
+        m_previousSpeakFinishedTimestamp = std::chrono::steady_clock::time_point::min();
+    }
+    prestageNextSpeak();
     if (m_currentInfo->sendPlaybackStartedMessage) {
         auto payload = buildPayload(m_currentInfo->token);
         if (payload.empty()) {
@@ -630,6 +685,13 @@ void SpeechSynthesizer::executePlaybackFinished() {
         setHandlingCompleted();
     }
     resetCurrentInfo();
+    {
+        // Only back-to-back Speaks (the next one already pre-handled) are reported as a gap.
+        std::lock_guard<std::mutex> lock(m_speakDirectiveInfoMutex);
+        if (!m_speakDirectiveInfoMap.empty()) {
+            m_previousSpeakFinishedTimestamp = std::chrono::steady_clock::now();
+        }
+    }
     {
         std::lock_guard<std::mutex> lock_guard(m_speakInfoQueueMutex);
         m_speakInfoQueue.pop_front();
@@ -650,6 +712,7 @@ void SpeechSynthesizer::executePlaybackError(const avsCommon::utils::mediaPlayer
         setCurrentStateLocked(SpeechSynthesizerObserverInterface::SpeechSynthesizerState::FINISHED);
     }
     m_waitOnStateChange.notify_one();
+    m_previousSpeakFinishedTimestamp = std::chrono::steady_clock::time_point::min();
     releaseForegroundFocus();
     resetCurrentInfo();
     resetMediaSourceId();
@@ -711,7 +774,15 @@ std::string SpeechSynthesizer::buildPayload(std::string& token) {
 
 void SpeechSynthesizer::startPlaying() {
     ACSDK_DEBUG9(LX("startPlaying"));
-    m_mediaSourceId = m_speechPlayer->setSource(std::move(m_currentInfo->attachmentReader));
+    m_isPlayingPrestagedSpeak = m_prestagedInfo && m_prestagedInfo == m_currentInfo;
+    if (m_isPlayingPrestagedSpeak) {
+        std::swap(m_speechPlayer, m_prestagePlayer);
+        m_mediaSourceId = m_prestagedSourceId;
+        m_prestagedInfo.reset();
+        m_prestagedSourceId = MediaPlayerInterface::ERROR;
+    } else {
+        m_mediaSourceId = m_speechPlayer->setSource(std::move(m_currentInfo->attachmentReader));
+    }
     if (MediaPlayerInterface::ERROR == m_mediaSourceId) {
         ACSDK_ERROR(LX("startPlayingFailed").d("reason", "setSourceFailed"));
         executePlaybackError(ErrorType::MEDIA_ERROR_INTERNAL_DEVICE_ERROR, "playFailed");
@@ -737,6 +808,59 @@ void SpeechSynthesizer::stopPlaying() {
     }
 }
 
+void SpeechSynthesizer::prestageNextSpeak() {
+    if (!m_prestagePlayer || m_prestagedInfo) {
+        return;
+    }
+    std::shared_ptr<SpeakDirectiveInfo> next;
+    {
+        std::lock_guard<std::mutex> lock(m_speakDirectiveInfoMutex);
+        for (auto& entry : m_speakDirectiveInfoMap) {
+            auto& info = entry.second;
+            if (info == m_currentInfo || !info->attachmentReader) {
+                continue;
+            }
+            if (!next || info->preHandleSequence < next->preHandleSequence) {
+                next = info;
+            }
+        }
+    }
+    if (!next) {
+        return;
+    }
+    auto sourceId = m_prestagePlayer->setSource(std::move(next->attachmentReader));
+    if (MediaPlayerInterface::ERROR == sourceId) {
+        // The attachment was consumed by the failed setSource(), so the Speak will fail when it is played.
+        ACSDK_ERROR(LX("prestageNextSpeakFailed")
+                        .d("reason", "setSourceFailed")
+                        .d("messageId", next->directive->getMessageId()));
+        return;
+    }
+    m_prestagedInfo = next;
+    m_prestagedSourceId = sourceId;
+    if (!m_prestagePlayer->preroll(sourceId)) {
+        // The Speak still plays from the prestage player, it just starts without a head start.
+        ACSDK_DEBUG(LX("prerollNotSupported").d("sourceId", sourceId));
+    }
+    ACSDK_DEBUG(LX("prestagedSpeak").d("messageId", next->directive->getMessageId()).d("sourceId", sourceId));
+}
+
+void SpeechSynthesizer::discardPrestagedSpeak() {
+    if (!m_prestagedInfo) {
+        return;
+    }
+    ACSDK_DEBUG(LX("discardPrestagedSpeak").d("messageId", m_prestagedInfo->directive->getMessageId()));
+    SourceId sourceId = m_prestagedSourceId;
+    m_discardedSourceId = sourceId;
+    m_prestagedSourceId = MediaPlayerInterface::ERROR;
+    m_prestagedInfo.reset();
+    m_prestagePlayer->stop(sourceId);
+}
+
+bool SpeechSynthesizer::isPrestagedSourceId(SourceId id) const {
+    return MediaPlayerInterface::ERROR != id && (id == m_prestagedSourceId || id == m_discardedSourceId);
+}
+
 void SpeechSynthesizer::setCurrentStateLocked(SpeechSynthesizerObserverInterface::SpeechSynthesizerState newState) {
     ACSDK_DEBUG9(LX("setCurrentStateLocked").d("state", newState));
     m_currentState = newState;
@@ -794,6 +918,11 @@ void SpeechSynthesizer::sendExceptionEncounteredAndReportFailed(
     }
     speakInfo->clear();
     removeDirective(speakInfo->directive->getMessageId());
+    m_executor.submit([this, speakInfo]() {
+        if (speakInfo == m_prestagedInfo) {
+            discardPrestagedSpeak();
+        }
+    });
     std::unique_lock<std::mutex> lock(m_mutex);
     if (SpeechSynthesizerObserverInterface::SpeechSynthesizerState::PLAYING == m_currentState ||
         SpeechSynthesizerObserverInterface::SpeechSynthesizerState::GAINING_FOCUS == m_currentState) {
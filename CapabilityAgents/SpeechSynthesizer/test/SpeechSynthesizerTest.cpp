@@ -176,6 +176,14 @@ public:
     /// Player to send the audio to.
     std::shared_ptr<MockMediaPlayer> m_mockSpeechPlayer;
 
+    /// Player on which the next Speak is prestaged, if @c enablePrestage() was called.
+    std::shared_ptr<MockMediaPlayer> m_mockPrestagePlayer;
+
+    /**
+     * Replaces @c m_speechSynthesizer with one that prestages the next Speak on @c m_mockPrestagePlayer.
+     */
+    void enablePrestage();
+
     /// @c ContextManager to provide state and update state.
     std::shared_ptr<MockContextManager> m_mockContextManager;
 
@@ -323,6 +331,29 @@ void SpeechSynthesizerTest::SetUp() {
 void SpeechSynthesizerTest::TearDown() {
     m_speechSynthesizer->removeObserver(m_dialogUXStateAggregator);
     m_speechSynthesizer->shutdown();
+    if (m_mockPrestagePlayer) {
+        m_mockPrestagePlayer->shutdown();
+    }
+}
+
+void SpeechSynthesizerTest::enablePrestage() {
+    m_speechSynthesizer->removeObserver(m_dialogUXStateAggregator);
+    m_speechSynthesizer->shutdown();
+    m_mockPrestagePlayer = MockMediaPlayer::create();
+    // Real MediaPlayer source ids are unique across players; keep the two mocks' ids apart to match.
+    for (int i = 0; i < 10; ++i) {
+        m_mockPrestagePlayer->mockSetSource();
+    }
+    m_speechSynthesizer = SpeechSynthesizer::create(
+        m_mockSpeechPlayer,
+        m_mockMessageSender,
+        m_mockFocusManager,
+        m_mockContextManager,
+        m_mockExceptionSender,
+        m_dialogUXStateAggregator,
+        m_mockPrestagePlayer);
+    ASSERT_TRUE(m_speechSynthesizer);
+    m_speechSynthesizer->addObserver(m_dialogUXStateAggregator);
 }
 
 SetStateResult SpeechSynthesizerTest::wakeOnSetState() {
@@ -922,6 +953,106 @@ TEST_F(SpeechSynthesizerTest, testSetStateTimeout) {
     m_speechSynthesizer->onFocusChanged(FocusState::BACKGROUND);
 }
 
+/**
+ * Testing prestaging of Speak directives.
+ * Pre-handle a Speak with a prestage player.  Expect its source to be set and prerolled on the prestage player, and
+ * played there once focus is acquired.  Then pre-handle a second Speak and expect it to be prestaged on the original
+ * player, which is now the spare one.
+ */
+TEST_F(SpeechSynthesizerTest, testPrestagedSpeakPlaysOnPrestagePlayer) {
+    enablePrestage();
+
+    auto avsMessageHeader = std::make_shared<AVSMessageHeader>(
+        NAMESPACE_SPEECH_SYNTHESIZER, NAME_SPEAK, MESSAGE_ID_TEST, DIALOG_REQUEST_ID_TEST);
+    std::shared_ptr<AVSDirective> directive =
+        AVSDirective::create("", avsMessageHeader, PAYLOAD_TEST, m_attachmentManager, CONTEXT_ID_TEST);
+
+    auto avsMessageHeader2 = std::make_shared<AVSMessageHeader>(
+        NAMESPACE_SPEECH_SYNTHESIZER, NAME_SPEAK, MESSAGE_ID_TEST_2, DIALOG_REQUEST_ID_TEST);
+    std::shared_ptr<AVSDirective> directive2 =
+        AVSDirective::create("", avsMessageHeader2, PAYLOAD_TEST, m_attachmentManager, CONTEXT_ID_TEST_2);
+
+    EXPECT_CALL(*(m_mockFocusManager.get()), acquireChannel(CHANNEL_NAME, _, NAMESPACE_SPEECH_SYNTHESIZER))
+        .Times(1)
+        .WillOnce(InvokeWithoutArgs(this, &SpeechSynthesizerTest::wakeOnAcquireChannel));
+    std::promise<void> prestagedPromise;
+    auto prestagedFuture = prestagedPromise.get_future();
+    EXPECT_CALL(
+        *(m_mockPrestagePlayer.get()),
+        attachmentSetSource(A<std::shared_ptr<avsCommon::avs::attachment::AttachmentReader>>(), nullptr))
+        .Times(1)
+        .WillOnce(InvokeWithoutArgs([this, &prestagedPromise]() {
+            prestagedPromise.set_value();
+            return m_mockPrestagePlayer->mockSetSource();
+        }));
+    EXPECT_CALL(*(m_mockPrestagePlayer.get()), preroll(_)).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*(m_mockPrestagePlayer.get()), play(_)).Times(1);
+    std::promise<void> secondPrestagedPromise;
+    auto secondPrestagedFuture = secondPrestagedPromise.get_future();
+    EXPECT_CALL(
+        *(m_mockSpeechPlayer.get()),
+        attachmentSetSource(A<std::shared_ptr<avsCommon::avs::attachment::AttachmentReader>>(), nullptr))
+        .Times(1)
+        .WillOnce(InvokeWithoutArgs([this, &secondPrestagedPromise]() {
+            secondPrestagedPromise.set_value();
+            return m_mockSpeechPlayer->mockSetSource();
+        }));
+    EXPECT_CALL(*(m_mockSpeechPlayer.get()), play(_)).Times(0);
+    EXPECT_CALL(*(m_mockSpeechPlayer.get()), preroll(_)).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*(m_mockExceptionSender.get()), sendExceptionEncountered(_, _, _)).Times(0);
+
+    m_speechSynthesizer->CapabilityAgent::preHandleDirective(directive, std::move(m_mockDirHandlerResult));
+    ASSERT_TRUE(std::future_status::ready == prestagedFuture.wait_for(WAIT_TIMEOUT));
+    m_speechSynthesizer->CapabilityAgent::handleDirective(MESSAGE_ID_TEST);
+    ASSERT_TRUE(std::future_status::ready == m_wakeAcquireChannelFuture.wait_for(WAIT_TIMEOUT));
+    m_speechSynthesizer->onFocusChanged(FocusState::FOREGROUND);
+    ASSERT_TRUE(m_mockPrestagePlayer->waitUntilPlaybackStarted());
+
+    std::unique_ptr<MockDirectiveHandlerResult> result2(new NiceMock<MockDirectiveHandlerResult>);
+    m_speechSynthesizer->CapabilityAgent::preHandleDirective(directive2, std::move(result2));
+    ASSERT_TRUE(std::future_status::ready == secondPrestagedFuture.wait_for(WAIT_TIMEOUT));
+}
+
+/**
+ * Testing cancelling a prestaged Speak.
+ * Pre-handle a Speak with a prestage player, then cancel it.  Expect its source to be stopped on the prestage player
+ * without reporting an error.
+ */
+TEST_F(SpeechSynthesizerTest, testCancelPrestagedSpeakStopsPrestagePlayer) {
+    enablePrestage();
+
+    auto avsMessageHeader = std::make_shared<AVSMessageHeader>(
+        NAMESPACE_SPEECH_SYNTHESIZER, NAME_SPEAK, MESSAGE_ID_TEST, DIALOG_REQUEST_ID_TEST);
+    std::shared_ptr<AVSDirective> directive =
+        AVSDirective::create("", avsMessageHeader, PAYLOAD_TEST, m_attachmentManager, CONTEXT_ID_TEST);
+
+    std::promise<void> prestagedPromise;
+    auto prestagedFuture = prestagedPromise.get_future();
+    EXPECT_CALL(
+        *(m_mockPrestagePlayer.get()),
+        attachmentSetSource(A<std::shared_ptr<avsCommon::avs::attachment::AttachmentReader>>(), nullptr))
+        .Times(1)
+        .WillOnce(InvokeWithoutArgs([this, &prestagedPromise]() {
+            prestagedPromise.set_value();
+            return m_mockPrestagePlayer->mockSetSource();
+        }));
+    EXPECT_CALL(*(m_mockPrestagePlayer.get()), stop(_))
+        .Times(1)
+        .WillOnce(Invoke([this](MediaPlayerInterface::SourceId id) {
+            wakeOnStopped();
+            return m_mockPrestagePlayer->mockStop(id);
+        }));
+    EXPECT_CALL(*(m_mockSpeechPlayer.get()), play(_)).Times(0);
+    EXPECT_CALL(*(m_mockExceptionSender.get()), sendExceptionEncountered(_, _, _)).Times(0);
+    EXPECT_CALL(*(m_mockContextManager.get()), setState(_, _, _, _)).Times(0);
+
+    m_speechSynthesizer->CapabilityAgent::preHandleDirective(directive, std::move(m_mockDirHandlerResult));
+    ASSERT_TRUE(std::future_status::ready == prestagedFuture.wait_for(WAIT_TIMEOUT));
+    m_speechSynthesizer->CapabilityAgent::cancelDirective(MESSAGE_ID_TEST);
+    ASSERT_TRUE(std::future_status::ready == m_wakeStoppedFuture.wait_for(WAIT_TIMEOUT));
+    ASSERT_TRUE(m_mockPrestagePlayer->waitUntilPlaybackStopped());
+}
+
 }  // namespace test
 }  // namespace speechSynthesizer
 }  // namespace capabilityAgents
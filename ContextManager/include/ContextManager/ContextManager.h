@@ -30,6 +30,7 @@
 #include <rapidjson/writer.h>
 
 #include <AVSCommon/SDKInterfaces/ContextManagerInterface.h>
+#include <AVSCommon/SDKInterfaces/ContextManagerObserverInterface.h>
 #include <AVSCommon/SDKInterfaces/ContextRequesterInterface.h>
 #include <AVSCommon/SDKInterfaces/StateProviderInterface.h>
 #include <AVSCommon/AVS/StateRefreshPolicy.h>
@@ -66,6 +67,12 @@ public:
 
     void getContext(std::shared_ptr<avsCommon::sdkInterfaces::ContextRequesterInterface> contextRequester) override;
 
+    void addContextManagerObserver(
+        std::shared_ptr<avsCommon::sdkInterfaces::ContextManagerObserverInterface> observer) override;
+
+    void removeContextManagerObserver(
+        std::shared_ptr<avsCommon::sdkInterfaces::ContextManagerObserverInterface> observer) override;
+
 private:
     /**
      * This class has all the information about a @c StateProviderInterface needed by the contextManager.
@@ -172,6 +179,12 @@ private:
      */
     void sendContextToRequesters();
 
+    /**
+     * Notifies the @c ContextManagerObserverInterfaces that the context has changed. @c m_stateProviderMutex must not
+     * be held when this function is called.
+     */
+    void notifyObservers();
+
     /**
      * Map of state provider namespace and name to the state information. @c m_stateProviderMutex must be acquired
      * before accessing the map.
@@ -220,6 +233,12 @@ private:
      * modified or read.
      */
     bool m_shutdown;
+
+    /// Mutex to protect @c m_observers.
+    std::mutex m_observerMutex;
+
+    /// The observers notified when the context changes.
+    std::unordered_set<std::shared_ptr<avsCommon::sdkInterfaces::ContextManagerObserverInterface>> m_observers;
 };
 
 }  // namespace contextManager
@@ -76,18 +76,24 @@ ContextManager::~ContextManager() {
 void ContextManager::setStateProvider(
     const NamespaceAndName& stateProviderName,
     std::shared_ptr<StateProviderInterface> stateProvider) {
-    std::lock_guard<std::mutex> stateProviderLock(m_stateProviderMutex);
+    std::unique_lock<std::mutex> stateProviderLock(m_stateProviderMutex);
     if (!stateProvider) {
-        m_namespaceNameToStateInfo.erase(stateProviderName);
+        auto removed = m_namespaceNameToStateInfo.erase(stateProviderName);
+        stateProviderLock.unlock();
         ACSDK_DEBUG(LX("setStateProvider")
                         .d("action", "removedStateProvider")
                         .d("namespace", stateProviderName.nameSpace)
                         .d("name", stateProviderName.name));
+        if (removed) {
+            notifyObservers();
+        }
         return;
     }
     auto stateInfoMappingIt = m_namespaceNameToStateInfo.find(stateProviderName);
     if (m_namespaceNameToStateInfo.end() == stateInfoMappingIt) {
         m_namespaceNameToStateInfo[stateProviderName] = std::make_shared<StateInfo>(stateProvider);
+        stateProviderLock.unlock();
+        notifyObservers();
     } else {
         stateInfoMappingIt->second->stateProvider = stateProvider;
     }
@@ -98,9 +104,23 @@ SetStateResult ContextManager::setState(
     const std::string& jsonState,
     const StateRefreshPolicy& refreshPolicy,
     const unsigned int stateRequestToken) {
-    std::lock_guard<std::mutex> stateProviderLock(m_stateProviderMutex);
+    std::unique_lock<std::mutex> stateProviderLock(m_stateProviderMutex);
     if (0 == stateRequestToken) {
-        return updateStateLocked(stateProviderName, jsonState, refreshPolicy);
+        /*
+         * A state set without a token was changed by the state provider of its own accord, so any context built
+         * before no longer matches. States set in response to provideState are not reported, as every getContext
+         * request refreshes them anyway.
+         */
+        auto stateInfoMappingIt = m_namespaceNameToStateInfo.find(stateProviderName);
+        bool stateChanged = m_namespaceNameToStateInfo.end() == stateInfoMappingIt ||
+                            stateInfoMappingIt->second->jsonState != jsonState ||
+                            stateInfoMappingIt->second->refreshPolicy != refreshPolicy;
+        auto status = updateStateLocked(stateProviderName, jsonState, refreshPolicy);
+        stateProviderLock.unlock();
+        if (SetStateResult::SUCCESS == status && stateChanged) {
+            notifyObservers();
+        }
+        return status;
     }
     if (stateRequestToken != m_stateRequestToken) {
         ACSDK_ERROR(LX("setStateFailed")
@@ -142,6 +162,24 @@ void ContextManager::getContext(std::shared_ptr<ContextRequesterInterface> conte
     }
 }
 
+void ContextManager::addContextManagerObserver(std::shared_ptr<ContextManagerObserverInterface> observer) {
+    if (!observer) {
+        ACSDK_ERROR(LX("addContextManagerObserverFailed").d("reason", "nullObserver"));
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_observerMutex);
+    m_observers.insert(observer);
+}
+
+void ContextManager::removeContextManagerObserver(std::shared_ptr<ContextManagerObserverInterface> observer) {
+    if (!observer) {
+        ACSDK_ERROR(LX("removeContextManagerObserverFailed").d("reason", "nullObserver"));
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_observerMutex);
+    m_observers.erase(observer);
+}
+
 ContextManager::StateInfo::StateInfo(
     std::shared_ptr<avsCommon::sdkInterfaces::StateProviderInterface> initStateProvider,
     std::string initJsonState,
@@ -210,17 +248,23 @@ void ContextManager::requestStatesLocked(std::unique_lock<std::mutex>& stateProv
 void ContextManager::sendContextAndClearQueue(
     const std::string& context,
     const ContextRequestError& contextRequestError) {
-    std::unique_lock<std::mutex> contextRequesterLock(m_contextRequesterMutex);
-    while (!m_contextRequesterQueue.empty()) {
-        auto currentContextRequester = m_contextRequesterQueue.front();
-        contextRequesterLock.unlock();
+    /*
+     * Take the requesters out of the queue before answering them, so that a requester asking for context again from
+     * its callback is answered by a new round of state updates, rather than with this (possibly outdated) context.
+     */
+    std::queue<std::shared_ptr<ContextRequesterInterface>> contextRequesters;
+    {
+        std::lock_guard<std::mutex> contextRequesterLock(m_contextRequesterMutex);
+        std::swap(contextRequesters, m_contextRequesterQueue);
+    }
+    while (!contextRequesters.empty()) {
+        auto currentContextRequester = contextRequesters.front();
         if (!context.empty()) {
             currentContextRequester->onContextAvailable(context);
         } else {
             currentContextRequester->onContextFailure(contextRequestError);
         }
-        contextRequesterLock.lock();
-        m_contextRequesterQueue.pop();
+        contextRequesters.pop();
     }
 }
 
@@ -334,5 +378,15 @@ void ContextManager::sendContextToRequesters() {
     }
 }
 
+void ContextManager::notifyObservers() {
+    std::unique_lock<std::mutex> lock(m_observerMutex);
+    auto observers = m_observers;
+    lock.unlock();
+
+    for (auto observer : observers) {
+        observer->onContextChanged();
+    }
+}
+
 }  // namespace contextManager
 }  // namespace alexaClientSDK
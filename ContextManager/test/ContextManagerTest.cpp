@@ -419,6 +419,14 @@ unsigned int MockStateProvider::getCurrentstateRequestToken() {
     return m_stateRequestToken;
 }
 
+/**
+ * @c MockContextManagerObserver used to verify @c ContextManager change notifications.
+ */
+class MockContextManagerObserver : public ContextManagerObserverInterface {
+public:
+    MOCK_METHOD0(onContextChanged, void());
+};
+
 /// Context Manager Test
 class ContextManagerTest : public ::testing::Test {
 public:
@@ -689,6 +697,49 @@ TEST_F(ContextManagerTest, testEmptyProvider) {
 }
 #endif
 
+/**
+ * Set a state without a token, twice with the same value and then with another value. Expect that observers are
+ * notified only when the state changes.
+ */
+TEST_F(ContextManagerTest, testObserverNotifiedOfStateChange) {
+    auto observer = std::make_shared<MockContextManagerObserver>();
+    m_contextManager->addContextManagerObserver(observer);
+    EXPECT_CALL(*observer, onContextChanged()).Times(2);
+    ASSERT_EQ(SetStateResult::SUCCESS, m_contextManager->setState(ALERTS, ALERTS_PAYLOAD, StateRefreshPolicy::NEVER));
+    ASSERT_EQ(SetStateResult::SUCCESS, m_contextManager->setState(ALERTS, ALERTS_PAYLOAD, StateRefreshPolicy::NEVER));
+    ASSERT_EQ(SetStateResult::SUCCESS, m_contextManager->setState(ALERTS, "{}", StateRefreshPolicy::NEVER));
+
+    m_contextManager->removeContextManagerObserver(observer);
+    ASSERT_EQ(SetStateResult::SUCCESS, m_contextManager->setState(ALERTS, ALERTS_PAYLOAD, StateRefreshPolicy::NEVER));
+}
+
+/**
+ * Register and then remove a @c StateProviderInterface. Expect that observers are notified of both.
+ */
+TEST_F(ContextManagerTest, testObserverNotifiedOfProviderChange) {
+    auto observer = std::make_shared<MockContextManagerObserver>();
+    m_contextManager->addContextManagerObserver(observer);
+    EXPECT_CALL(*observer, onContextChanged()).Times(2);
+    m_alerts = MockStateProvider::create(
+        m_contextManager, ALERTS, ALERTS_PAYLOAD, StateRefreshPolicy::NEVER, DEFAULT_SLEEP_TIME);
+    m_contextManager->setStateProvider(ALERTS, m_alerts);
+    m_contextManager->setStateProvider(ALERTS, nullptr);
+    m_contextManager->removeContextManagerObserver(observer);
+}
+
+/**
+ * Request for context by calling @c getContext. Expect that the states provided in response do not notify observers,
+ * as they are refreshed by each request anyway.
+ */
+TEST_F(ContextManagerTest, testObserverNotNotifiedOfRequestedState) {
+    auto observer = std::make_shared<MockContextManagerObserver>();
+    m_contextManager->addContextManagerObserver(observer);
+    EXPECT_CALL(*observer, onContextChanged()).Times(0);
+    m_contextManager->getContext(m_contextRequester);
+    EXPECT_TRUE(m_contextRequester->waitForContext(DEFAULT_TIMEOUT));
+    m_contextManager->removeContextManagerObserver(observer);
+}
+
 }  // namespace test
 }  // namespace contextManager
 }  // namespace alexaClientSDK
@@ -36,6 +36,8 @@ public:
      */
     DummyESPDataProvider();
 
+    using ESPDataProviderInterface::getESPData;
+
     /// @name Overridden ESPDataProviderInterface methods.
     /// @{
     capabilityAgents::aip::ESPData getESPData() override;
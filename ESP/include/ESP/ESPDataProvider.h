@@ -26,23 +26,38 @@
 #include <AIP/ESPData.h>
 #include <AVSCommon/AVS/AudioInputStream.h>
 #include <ESP/ESPDataProviderInterface.h>
+#include <ESP/ESPFrameAssembler.h>
+#include <ESP/ESPFrameRing.h>
+#include <KWD/KeywordDetectorAudioObserverInterface.h>
 
 namespace alexaClientSDK {
 namespace esp {
 
 /**
- * The ESPDataProvider is used to connect the sample app with the ESP library. When enabled, the ESPDataProvider object
- * feeds the ESP Library constantly using its own thread.
+ * The ESPDataProvider is used to connect the sample app with the ESP library.  Every frame of audio is run through the
+ * VAD and the result kept in a ring indexed by stream position, so the voiced and ambient energy can be computed for
+ * exactly the span of a detected keyword.
+ *
+ * By default the ESPDataProvider feeds the ESP library using its own reader and thread.  Alternatively it can be
+ * created without a reader and added as an audio observer of the keyword detector, so that it processes the buffers
+ * the detector reads instead of reading the stream a second time.
  */
-class ESPDataProvider : public ESPDataProviderInterface {
+class ESPDataProvider
+        : public ESPDataProviderInterface
+        , public kwd::KeywordDetectorAudioObserverInterface {
 public:
     /**
      * Create a unique pointer for an ESPDataProvider.
      *
      * @param audioProvider Should have the audio input stream used by the wakeword engine and the input parameters.
+     * @param useOwnReader Whether to read @c audioProvider.stream on an internal thread.  If @c false, audio must be
+     * passed in through @c onAudioRead(), typically by adding this object as an audio observer of the keyword
+     * detector reading the same stream.
      * @return A valid ESPDataProvider pointer if creation succeeds and a empty pointer if it fails.
      */
-    static std::unique_ptr<ESPDataProvider> create(const capabilityAgents::aip::AudioProvider& audioProvider);
+    static std::unique_ptr<ESPDataProvider> create(
+        const capabilityAgents::aip::AudioProvider& audioProvider,
+        bool useOwnReader = true);
 
     /**
      * ESPDataProvider Destructor.
@@ -52,11 +67,22 @@ public:
     /// @name Overridden ESPDataProviderInterface methods.
     /// @{
     capabilityAgents::aip::ESPData getESPData() override;
+    capabilityAgents::aip::ESPData getESPData(
+        avsCommon::avs::AudioInputStream::Index beginIndex,
+        avsCommon::avs::AudioInputStream::Index endIndex) override;
     bool isEnabled() const override;
     void disable() override;
     void enable() override;
     /// @}
 
+    /// @name Overridden KeywordDetectorAudioObserverInterface methods.
+    /// @{
+    void onAudioRead(
+        const int16_t* samples,
+        size_t numSamples,
+        avsCommon::avs::AudioInputStream::Index beginIndex) override;
+    /// @}
+
     /**
      * Delete ESPDataProvider default constructor.
      */
@@ -79,11 +105,20 @@ private:
      */
     void espLoop();
 
+    /**
+     * Run one frame through the VAD, update the running energy and record the result in the ring.
+     *
+     * @param frame The @c m_frameSize samples of the frame.
+     * @param beginIndex The absolute index in the stream of the first sample of the frame.
+     */
+    void processFrame(short* frame, avsCommon::avs::AudioInputStream::Index beginIndex);
+
     /**
      * ESPDataProvider constructor.
      *
-     * @param reader Audio input stream that should be used to feed the ESP library.
-     * @param frameSize The audio frame size per ms in bits.
+     * @param reader Audio input stream that should be used to feed the ESP library, or @c nullptr if audio will be
+     * passed in through @c onAudioRead().
+     * @param frameSize The number of samples in each ESP frame.
      */
     ESPDataProvider(std::unique_ptr<avsCommon::avs::AudioInputStream::Reader> reader, unsigned int frameSize);
 
@@ -96,10 +131,16 @@ private:
     /// Object used to calculate the frame energy. The access to this variable is guarded by @c m_mutex.
     FrameEnergyClass m_frameEnergyCompute;
 
-    /// Thread that keeps feeding audio to ESP library.
+    /// The recent per-frame VAD results.  The access to this variable is guarded by @c m_mutex.
+    ESPFrameRing m_frames;
+
+    /// Cuts the buffers passed to @c onAudioRead() into frames.
+    ESPFrameAssembler m_assembler;
+
+    /// Thread that keeps feeding audio to ESP library, if it has its own reader.
     std::thread m_thread;
 
-    /// Serializes access to m_FrameEnergyCompute.
+    /// Serializes access to m_FrameEnergyCompute and m_frames.
     std::mutex m_mutex;
 
     /// Indicates if ESP data is provided or not. The access to this variable is guarded by @c m_mutex.
@@ -16,6 +16,7 @@
 #define ALEXA_CLIENT_SDK_ESP_INCLUDE_ESP_ESPDATAPROVIDERINTERFACE_H_
 
 #include <AIP/ESPData.h>
+#include <AVSCommon/AVS/AudioInputStream.h>
 
 namespace alexaClientSDK {
 namespace esp {
@@ -37,6 +38,21 @@ public:
      */
     virtual capabilityAgents::aip::ESPData getESPData() = 0;
 
+    /**
+     * Retrieve the ESPData for a span of the audio stream, such as the keyword reported by a keyword detector.
+     * Providers which only keep running values return the same as @c getESPData().
+     *
+     * @param beginIndex The absolute index of the first sample of the span, or
+     * @c KeyWordObserverInterface::UNSPECIFIED_INDEX if only the end is known.
+     * @param endIndex The absolute index just past the last sample of the span.
+     * @return Collected ESPData if ESP is enabled, otherwise it returns ESPData::EMPTY_ESP_DATA.
+     */
+    virtual capabilityAgents::aip::ESPData getESPData(
+        avsCommon::avs::AudioInputStream::Index beginIndex,
+        avsCommon::avs::AudioInputStream::Index endIndex) {
+        return getESPData();
+    }
+
     /**
      * Return whether the ESP is enabled or not.
      *
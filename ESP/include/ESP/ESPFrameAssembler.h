@@ -0,0 +1,81 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_ESP_INCLUDE_ESP_ESPFRAMEASSEMBLER_H_
+#define ALEXA_CLIENT_SDK_ESP_INCLUDE_ESP_ESPFRAMEASSEMBLER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <AVSCommon/AVS/AudioInputStream.h>
+
+namespace alexaClientSDK {
+namespace esp {
+
+/**
+ * Cuts audio passed in buffers of any size into the fixed size frames the ESP library processes, keeping the stream
+ * index of each frame.  This lets ESP run over the buffers another reader of the stream (such as a keyword detector)
+ * reads, rather than reading the stream itself.
+ *
+ * This class is not thread-safe.
+ */
+class ESPFrameAssembler {
+public:
+    /**
+     * Called with each complete frame.
+     *
+     * @param frame The samples of the frame, valid only for the duration of the call.
+     * @param beginIndex The absolute index in the stream of the first sample of the frame.
+     */
+    using FrameHandler = std::function<void(short* frame, avsCommon::avs::AudioInputStream::Index beginIndex)>;
+
+    /**
+     * Constructor.
+     *
+     * @param frameSize The number of samples in each frame.
+     * @param frameHandler Called with each complete frame.
+     */
+    ESPFrameAssembler(size_t frameSize, FrameHandler frameHandler);
+
+    /**
+     * Add the next buffer of audio, calling the frame handler for each frame it completes.  If @c beginIndex does not
+     * follow the samples passed before (after an overrun, for example), the partial frame held is dropped.
+     *
+     * @param samples The samples to add.
+     * @param numSamples The number of samples in @c samples.
+     * @param beginIndex The absolute index in the stream of the first sample in @c samples.
+     */
+    void push(const int16_t* samples, size_t numSamples, avsCommon::avs::AudioInputStream::Index beginIndex);
+
+private:
+    /// The number of samples in each frame.
+    const size_t m_frameSize;
+
+    /// Called with each complete frame.
+    const FrameHandler m_frameHandler;
+
+    /// Samples of a partial frame, waiting for the rest of the frame.
+    std::vector<short> m_pendingSamples;
+
+    /// The absolute index of the first sample in @c m_pendingSamples.
+    avsCommon::avs::AudioInputStream::Index m_pendingBeginIndex;
+};
+
+}  // namespace esp
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_ESP_INCLUDE_ESP_ESPFRAMEASSEMBLER_H_
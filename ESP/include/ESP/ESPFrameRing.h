@@ -0,0 +1,114 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_ESP_INCLUDE_ESP_ESPFRAMERING_H_
+#define ALEXA_CLIENT_SDK_ESP_INCLUDE_ESP_ESPFRAMERING_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <AVSCommon/AVS/AudioInputStream.h>
+
+namespace alexaClientSDK {
+namespace esp {
+
+/**
+ * A fixed capacity ring of per-frame ESP measurements, keyed by the stream index of each frame.  Keeping the raw
+ * measurements rather than only the running totals lets the voiced and ambient energy be computed for exactly the
+ * audio a keyword occupied, after the keyword has been detected.
+ *
+ * Frames must be pushed in increasing stream order.  Gaps (after an overrun or a reset) are allowed.  This class is not
+ * thread-safe.
+ */
+class ESPFrameRing {
+public:
+    /// The measurements for one ESP frame.
+    struct Frame {
+        /// The absolute index in the stream of the first sample of the frame.
+        avsCommon::avs::AudioInputStream::Index beginIndex;
+
+        /// The frame energy reported by the VAD.
+        int64_t energy;
+
+        /// Whether the VAD classified the frame as voiced.
+        bool isVoiced;
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param capacity The maximum number of frames kept.  Once full, the oldest frame is dropped on each push.
+     * @param frameSize The number of samples in each frame.
+     */
+    ESPFrameRing(size_t capacity, size_t frameSize);
+
+    /**
+     * Add the measurements for the frame following the last one pushed.
+     *
+     * @param frame The frame to add.  Its @c beginIndex must be greater than that of the last frame pushed.
+     * @return @c false if the frame is out of order and was dropped, else @c true.
+     */
+    bool push(const Frame& frame);
+
+    /**
+     * Retrieve the frames overlapping the samples in [@c beginIndex, @c endIndex).
+     *
+     * @param beginIndex The absolute index of the first sample of interest.
+     * @param endIndex The absolute index just past the last sample of interest.
+     * @param[out] frames The matching frames are appended here, oldest first.
+     * @return The number of frames appended.
+     */
+    size_t getFrames(
+        avsCommon::avs::AudioInputStream::Index beginIndex,
+        avsCommon::avs::AudioInputStream::Index endIndex,
+        std::vector<Frame>* frames) const;
+
+    /**
+     * @return The number of frames currently held.
+     */
+    size_t size() const;
+
+    /**
+     * Drop all frames.
+     */
+    void clear();
+
+private:
+    /**
+     * Map a position in the ring, counted from the oldest frame held, to its slot in @c m_frames.
+     *
+     * @param position The position from the oldest frame, which must be less than @c m_size.
+     * @return The frame at that position.
+     */
+    const Frame& at(size_t position) const;
+
+    /// Storage for the ring.
+    std::vector<Frame> m_frames;
+
+    /// The number of samples in each frame.
+    const size_t m_frameSize;
+
+    /// The slot the next frame is written to.
+    size_t m_next;
+
+    /// The number of frames held.
+    size_t m_size;
+};
+
+}  // namespace esp
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_ESP_INCLUDE_ESP_ESPFRAMERING_H_
@@ -0,0 +1,52 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_ESP_INCLUDE_ESP_ESPVOICEACTIVITYDETECTOR_H_
+#define ALEXA_CLIENT_SDK_ESP_INCLUDE_ESP_ESPVOICEACTIVITYDETECTOR_H_
+
+#include "VAD_Features/VAD_class.h"
+
+#include <AVSCommon/SDKInterfaces/VoiceActivityDetectorInterface.h>
+
+namespace alexaClientSDK {
+namespace esp {
+
+/**
+ * Adapts the ESP library's VAD, which @c ESPDataProvider uses to compute the voiced energy, for use by the
+ * @c capabilityAgents::aip::Endpointer.
+ */
+class ESPVoiceActivityDetector : public avsCommon::sdkInterfaces::VoiceActivityDetectorInterface {
+public:
+    /**
+     * Constructor.
+     */
+    ESPVoiceActivityDetector();
+
+    /// @name VoiceActivityDetectorInterface methods
+    /// @{
+    size_t getFrameSize() const override;
+    void reset() override;
+    bool isSpeech(const int16_t* frame) override;
+    /// @}
+
+private:
+    /// Object responsible for VAD algorithm.
+    VADClass m_vad;
+};
+
+}  // namespace esp
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_ESP_INCLUDE_ESP_ESPVOICEACTIVITYDETECTOR_H_
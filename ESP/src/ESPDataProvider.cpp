@@ -39,6 +39,18 @@ static const unsigned int ESP_COMPATIBLE_SAMPLE_SIZE_IN_BITS = 16;
 /// The ESP frame size in ms.  The ESP library supports 8ms, 15ms and 16ms
 static const unsigned int ESP_FRAMES_IN_MILLISECONDS = 16;
 
+/// The number of samples per millisecond at the ESP compatible sample rate.
+static const unsigned int SAMPLES_PER_MILLISECOND = ESP_COMPATIBLE_SAMPLE_RATE / 1000;
+
+/// How much history the frame ring keeps, in ms.  This must cover a keyword plus the time taken to report it.
+static const unsigned int FRAME_HISTORY_IN_MILLISECONDS = 10000;
+
+/// How much audio before a keyword is included when measuring it, in ms, so the ambient energy has a baseline.
+static const unsigned int AMBIENT_CONTEXT_IN_MILLISECONDS = 1000;
+
+/// The keyword length assumed when the detector only reports where the keyword ended, in ms.
+static const unsigned int DEFAULT_KEYWORD_LENGTH_IN_MILLISECONDS = 800;
+
 namespace alexaClientSDK {
 namespace esp {
 
@@ -46,8 +58,11 @@ static const auto TIMEOUT = std::chrono::seconds(1);
 
 using AudioInputStream = avsCommon::avs::AudioInputStream;
 using ESPData = alexaClientSDK::capabilityAgents::aip::ESPData;
+using KeyWordObserverInterface = avsCommon::sdkInterfaces::KeyWordObserverInterface;
 
-std::unique_ptr<ESPDataProvider> ESPDataProvider::create(const capabilityAgents::aip::AudioProvider& audioProvider) {
+std::unique_ptr<ESPDataProvider> ESPDataProvider::create(
+    const capabilityAgents::aip::AudioProvider& audioProvider,
+    bool useOwnReader) {
     if ((ESP_COMPATIBLE_SAMPLE_RATE != audioProvider.format.sampleRateHz) ||
         (ESP_COMPATIBLE_SAMPLE_SIZE_IN_BITS != audioProvider.format.sampleSizeInBits)) {
         ACSDK_ERROR(LX(__func__)
@@ -59,10 +74,17 @@ std::unique_ptr<ESPDataProvider> ESPDataProvider::create(const capabilityAgents:
 
     unsigned int frameSize = (audioProvider.format.sampleRateHz / 1000) * ESP_FRAMES_IN_MILLISECONDS;
 
-    auto reader = audioProvider.stream->createReader(avsCommon::avs::AudioInputStream::Reader::Policy::BLOCKING);
-    if (!reader) {
-        ACSDK_ERROR(LX(__func__).d("reason", "createReaderFailed"));
-        return nullptr;
+    std::unique_ptr<AudioInputStream::Reader> reader;
+    if (useOwnReader) {
+        if (!audioProvider.stream) {
+            ACSDK_ERROR(LX(__func__).d("reason", "nullStream"));
+            return nullptr;
+        }
+        reader = audioProvider.stream->createReader(avsCommon::avs::AudioInputStream::Reader::Policy::BLOCKING);
+        if (!reader) {
+            ACSDK_ERROR(LX(__func__).d("reason", "createReaderFailed"));
+            return nullptr;
+        }
     }
 
     auto connector = std::unique_ptr<ESPDataProvider>(new ESPDataProvider(std::move(reader), frameSize));
@@ -86,6 +108,44 @@ ESPData ESPDataProvider::getESPData() {
     return ESPData::EMPTY_ESP_DATA;
 }
 
+ESPData ESPDataProvider::getESPData(AudioInputStream::Index beginIndex, AudioInputStream::Index endIndex) {
+    if (KeyWordObserverInterface::UNSPECIFIED_INDEX == endIndex) {
+        return getESPData();
+    }
+    if (KeyWordObserverInterface::UNSPECIFIED_INDEX == beginIndex || beginIndex >= endIndex) {
+        const AudioInputStream::Index keywordLength =
+            DEFAULT_KEYWORD_LENGTH_IN_MILLISECONDS * SAMPLES_PER_MILLISECOND;
+        beginIndex = endIndex > keywordLength ? endIndex - keywordLength : 0;
+    }
+    const AudioInputStream::Index context = AMBIENT_CONTEXT_IN_MILLISECONDS * SAMPLES_PER_MILLISECOND;
+    const AudioInputStream::Index contextBeginIndex = beginIndex > context ? beginIndex - context : 0;
+
+    std::vector<ESPFrameRing::Frame> frames;
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        if (!m_isEnabled) {
+            return ESPData::EMPTY_ESP_DATA;
+        }
+        if (!m_frames.getFrames(contextBeginIndex, endIndex, &frames)) {
+            ACSDK_WARN(LX("getESPDataForSpan")
+                           .d("reason", "noFramesInSpan")
+                           .d("beginIndex", beginIndex)
+                           .d("endIndex", endIndex));
+            return ESPData{std::to_string(m_frameEnergyCompute.getVoicedEnergy()),
+                           std::to_string(m_frameEnergyCompute.getAmbientEnergy())};
+        }
+    }
+
+    // Replay the span through a fresh energy computation so the result reflects only the keyword and its context.
+    FrameEnergyClass frameEnergyCompute{m_frameSize};
+    frameEnergyCompute.blkReset();
+    for (const auto& frame : frames) {
+        frameEnergyCompute.process(frame.isVoiced, static_cast<Word64>(frame.energy));
+    }
+    return ESPData{std::to_string(frameEnergyCompute.getVoicedEnergy()),
+                   std::to_string(frameEnergyCompute.getAmbientEnergy())};
+}
+
 bool ESPDataProvider::isEnabled() const {
     return m_isEnabled;
 }
@@ -100,23 +160,34 @@ void ESPDataProvider::enable() {
     m_isEnabled = true;
 }
 
-void ESPDataProvider::espLoop() {
+void ESPDataProvider::onAudioRead(const int16_t* samples, size_t numSamples, AudioInputStream::Index beginIndex) {
+    m_assembler.push(samples, numSamples, beginIndex);
+}
+
+void ESPDataProvider::processFrame(short* frame, AudioInputStream::Index beginIndex) {
     Word64 currentFrameEnergy = 0;
-    short procBuff[m_frameSize];
-    const auto numWords = sizeof(procBuff) / m_reader->getWordSize();
     bool GVAD = false;
+
+    // Call VAD and get frame energy
+    m_vad.process(frame, GVAD, currentFrameEnergy);
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_frameEnergyCompute.process(GVAD, currentFrameEnergy);
+        m_frames.push({beginIndex, static_cast<int64_t>(currentFrameEnergy), GVAD});
+    }
+}
+
+void ESPDataProvider::espLoop() {
+    std::vector<short> procBuff(m_frameSize);
+    const auto numWords = procBuff.size() * sizeof(short) / m_reader->getWordSize();
     bool hasErrorOccurred = false;
 
     while (!m_isShuttingDown) {
-        auto words = m_reader->read(&procBuff, numWords, TIMEOUT);
+        auto beginIndex = m_reader->tell();
+        auto words = m_reader->read(procBuff.data(), numWords, TIMEOUT);
 
         if (words > 0) {
-            // Call VAD and get frame energy
-            m_vad.process(procBuff, GVAD, currentFrameEnergy);
-            {
-                std::lock_guard<std::mutex> lock{m_mutex};
-                m_frameEnergyCompute.process(GVAD, currentFrameEnergy);
-            }
+            processFrame(procBuff.data(), beginIndex);
         } else {
             switch (words) {
                 case AudioInputStream::Reader::Error::CLOSED:
@@ -154,12 +225,17 @@ ESPDataProvider::ESPDataProvider(
         m_reader{std::move(reader)},
         m_vad{frameSize},
         m_frameEnergyCompute{frameSize},
+        m_frames{FRAME_HISTORY_IN_MILLISECONDS / ESP_FRAMES_IN_MILLISECONDS, frameSize},
+        m_assembler{frameSize,
+                    [this](short* frame, AudioInputStream::Index beginIndex) { processFrame(frame, beginIndex); }},
         m_isEnabled{true},
         m_isShuttingDown{false},
         m_frameSize{frameSize} {
     m_vad.blkReset();
     m_frameEnergyCompute.blkReset();
-    m_thread = std::thread(&ESPDataProvider::espLoop, this);
+    if (m_reader) {
+        m_thread = std::thread(&ESPDataProvider::espLoop, this);
+    }
 }
 
 }  // namespace esp
@@ -0,0 +1,60 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+
+#include "ESP/ESPFrameAssembler.h"
+
+namespace alexaClientSDK {
+namespace esp {
+
+using Index = avsCommon::avs::AudioInputStream::Index;
+
+ESPFrameAssembler::ESPFrameAssembler(size_t frameSize, FrameHandler frameHandler) :
+        m_frameSize{frameSize},
+        m_frameHandler{frameHandler},
+        m_pendingBeginIndex{0} {
+    m_pendingSamples.reserve(frameSize);
+}
+
+void ESPFrameAssembler::push(const int16_t* samples, size_t numSamples, Index beginIndex) {
+    if (!samples || 0 == m_frameSize) {
+        return;
+    }
+
+    // A jump in the stream leaves the partial frame incomplete, so drop it.
+    if (!m_pendingSamples.empty() && beginIndex != m_pendingBeginIndex + m_pendingSamples.size()) {
+        m_pendingSamples.clear();
+    }
+
+    size_t offset = 0;
+    while (offset < numSamples) {
+        if (m_pendingSamples.empty()) {
+            m_pendingBeginIndex = beginIndex + offset;
+        }
+        size_t toCopy = std::min(m_frameSize - m_pendingSamples.size(), numSamples - offset);
+        m_pendingSamples.insert(m_pendingSamples.end(), samples + offset, samples + offset + toCopy);
+        offset += toCopy;
+        if (m_pendingSamples.size() == m_frameSize) {
+            if (m_frameHandler) {
+                m_frameHandler(m_pendingSamples.data(), m_pendingBeginIndex);
+            }
+            m_pendingSamples.clear();
+        }
+    }
+}
+
+}  // namespace esp
+}  // namespace alexaClientSDK
@@ -0,0 +1,84 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "ESP/ESPFrameRing.h"
+
+namespace alexaClientSDK {
+namespace esp {
+
+using Index = avsCommon::avs::AudioInputStream::Index;
+
+ESPFrameRing::ESPFrameRing(size_t capacity, size_t frameSize) :
+        m_frames(capacity),
+        m_frameSize{frameSize},
+        m_next{0},
+        m_size{0} {
+}
+
+bool ESPFrameRing::push(const Frame& frame) {
+    if (m_frames.empty()) {
+        return false;
+    }
+    if (m_size > 0 && frame.beginIndex < at(m_size - 1).beginIndex + m_frameSize) {
+        return false;
+    }
+    m_frames[m_next] = frame;
+    m_next = (m_next + 1) % m_frames.size();
+    if (m_size < m_frames.size()) {
+        ++m_size;
+    }
+    return true;
+}
+
+size_t ESPFrameRing::getFrames(Index beginIndex, Index endIndex, std::vector<Frame>* frames) const {
+    if (!frames || beginIndex >= endIndex) {
+        return 0;
+    }
+
+    // Frames are sorted by index, so binary search for the first one which ends after beginIndex.
+    size_t low = 0;
+    size_t high = m_size;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (at(middle).beginIndex + m_frameSize <= beginIndex) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    size_t count = 0;
+    for (size_t position = low; position < m_size && at(position).beginIndex < endIndex; ++position) {
+        frames->push_back(at(position));
+        ++count;
+    }
+    return count;
+}
+
+size_t ESPFrameRing::size() const {
+    return m_size;
+}
+
+void ESPFrameRing::clear() {
+    m_next = 0;
+    m_size = 0;
+}
+
+const ESPFrameRing::Frame& ESPFrameRing::at(size_t position) const {
+    return m_frames[(m_next + m_frames.size() - m_size + position) % m_frames.size()];
+}
+
+}  // namespace esp
+}  // namespace alexaClientSDK
@@ -0,0 +1,45 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "ESP/ESPVoiceActivityDetector.h"
+
+namespace alexaClientSDK {
+namespace esp {
+
+/// The ESP frame size in samples; 16ms at the ESP compatible sample rate of 16 kHz.
+static const unsigned int ESP_FRAME_SIZE = 256;
+
+ESPVoiceActivityDetector::ESPVoiceActivityDetector() : m_vad{ESP_FRAME_SIZE} {
+    m_vad.blkReset();
+}
+
+size_t ESPVoiceActivityDetector::getFrameSize() const {
+    return ESP_FRAME_SIZE;
+}
+
+void ESPVoiceActivityDetector::reset() {
+    m_vad.blkReset();
+}
+
+bool ESPVoiceActivityDetector::isSpeech(const int16_t* frame) {
+    bool GVAD = false;
+    Word64 frameEnergy = 0;
+    // The ESP library does not modify the input, but does not take it as const either.
+    m_vad.process(const_cast<int16_t*>(frame), GVAD, frameEnergy);
+    return GVAD;
+}
+
+}  // namespace esp
+}  // namespace alexaClientSDK
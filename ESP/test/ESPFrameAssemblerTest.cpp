@@ -0,0 +1,107 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ESP/ESPFrameAssembler.h"
+
+namespace alexaClientSDK {
+namespace esp {
+namespace test {
+
+using Index = avsCommon::avs::AudioInputStream::Index;
+
+/// The number of samples per frame used in these tests.
+static const size_t FRAME_SIZE = 4;
+
+/// A frame passed to the frame handler.
+struct AssembledFrame {
+    /// The samples of the frame.
+    std::vector<short> samples;
+
+    /// The absolute index of the first sample of the frame.
+    Index beginIndex;
+};
+
+/**
+ * Our GTest class.
+ */
+class ESPFrameAssemblerTest : public ::testing::Test {
+public:
+    /// Constructor.
+    ESPFrameAssemblerTest() :
+            m_assembler{FRAME_SIZE, [this](short* frame, Index beginIndex) {
+                            m_frames.push_back({std::vector<short>(frame, frame + FRAME_SIZE), beginIndex});
+                        }} {
+    }
+
+    /**
+     * Push samples numbered from their stream index.
+     *
+     * @param beginIndex The absolute index of the first sample.
+     * @param numSamples The number of samples.
+     */
+    void push(Index beginIndex, size_t numSamples) {
+        std::vector<int16_t> samples(numSamples);
+        for (size_t i = 0; i < numSamples; ++i) {
+            samples[i] = static_cast<int16_t>(beginIndex + i);
+        }
+        m_assembler.push(samples.data(), samples.size(), beginIndex);
+    }
+
+    /// The frames passed to the frame handler.
+    std::vector<AssembledFrame> m_frames;
+
+    /// The assembler under test.
+    ESPFrameAssembler m_assembler;
+};
+
+/// Verify that a buffer holding whole frames is split into them.
+TEST_F(ESPFrameAssemblerTest, splitsBufferIntoFrames) {
+    push(0, 2 * FRAME_SIZE);
+    ASSERT_EQ(2u, m_frames.size());
+    EXPECT_EQ(0u, m_frames[0].beginIndex);
+    EXPECT_EQ(FRAME_SIZE, m_frames[1].beginIndex);
+    EXPECT_EQ(std::vector<short>({4, 5, 6, 7}), m_frames[1].samples);
+}
+
+/// Verify that frames spanning several buffers are joined, and that a partial frame is held until completed.
+TEST_F(ESPFrameAssemblerTest, joinsFramesAcrossBuffers) {
+    push(0, 3);
+    EXPECT_TRUE(m_frames.empty());
+    push(3, 3);
+    ASSERT_EQ(1u, m_frames.size());
+    EXPECT_EQ(0u, m_frames[0].beginIndex);
+    EXPECT_EQ(std::vector<short>({0, 1, 2, 3}), m_frames[0].samples);
+    push(6, 2);
+    ASSERT_EQ(2u, m_frames.size());
+    EXPECT_EQ(4u, m_frames[1].beginIndex);
+    EXPECT_EQ(std::vector<short>({4, 5, 6, 7}), m_frames[1].samples);
+}
+
+/// Verify that a jump in the stream drops the partial frame, and frames restart from the new position.
+TEST_F(ESPFrameAssemblerTest, jumpDropsPartialFrame) {
+    push(0, 3);
+    push(100, FRAME_SIZE);
+    ASSERT_EQ(1u, m_frames.size());
+    EXPECT_EQ(100u, m_frames[0].beginIndex);
+    EXPECT_EQ(std::vector<short>({100, 101, 102, 103}), m_frames[0].samples);
+}
+
+}  // namespace test
+}  // namespace esp
+}  // namespace alexaClientSDK
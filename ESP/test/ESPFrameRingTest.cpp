@@ -0,0 +1,121 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ESP/ESPFrameRing.h"
+
+namespace alexaClientSDK {
+namespace esp {
+namespace test {
+
+/// The number of samples per frame used in these tests.
+static const size_t FRAME_SIZE = 256;
+
+/// The number of frames the ring under test holds.
+static const size_t CAPACITY = 8;
+
+/**
+ * Push @c count contiguous frames starting at @c firstBeginIndex, with energy equal to the frame number.
+ */
+static void pushFrames(ESPFrameRing* ring, size_t firstBeginIndex, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        ring->push(
+            {firstBeginIndex + i * FRAME_SIZE, static_cast<int64_t>(firstBeginIndex / FRAME_SIZE + i), i % 2 != 0});
+    }
+}
+
+/// Verify that an empty ring returns no frames.
+TEST(ESPFrameRingTest, emptyRingReturnsNoFrames) {
+    ESPFrameRing ring{CAPACITY, FRAME_SIZE};
+    std::vector<ESPFrameRing::Frame> frames;
+    EXPECT_EQ(0u, ring.getFrames(0, 1000, &frames));
+    EXPECT_TRUE(frames.empty());
+}
+
+/// Verify that only the frames overlapping the requested span are returned, in stream order.
+TEST(ESPFrameRingTest, returnsFramesOverlappingSpan) {
+    ESPFrameRing ring{CAPACITY, FRAME_SIZE};
+    pushFrames(&ring, 0, 6);
+
+    std::vector<ESPFrameRing::Frame> frames;
+    // Starts in the middle of frame 1 and ends in the middle of frame 3.
+    ASSERT_EQ(3u, ring.getFrames(FRAME_SIZE + 10, 3 * FRAME_SIZE + 10, &frames));
+    EXPECT_EQ(1, frames[0].energy);
+    EXPECT_EQ(2, frames[1].energy);
+    EXPECT_EQ(3, frames[2].energy);
+    EXPECT_TRUE(frames[0].isVoiced);
+    EXPECT_FALSE(frames[1].isVoiced);
+}
+
+/// Verify that the end of the span is exclusive.
+TEST(ESPFrameRingTest, endIndexIsExclusive) {
+    ESPFrameRing ring{CAPACITY, FRAME_SIZE};
+    pushFrames(&ring, 0, 4);
+
+    std::vector<ESPFrameRing::Frame> frames;
+    ASSERT_EQ(2u, ring.getFrames(0, 2 * FRAME_SIZE, &frames));
+    EXPECT_EQ(1, frames.back().energy);
+}
+
+/// Verify that the oldest frames are dropped once the ring is full.
+TEST(ESPFrameRingTest, dropsOldestFramesWhenFull) {
+    ESPFrameRing ring{CAPACITY, FRAME_SIZE};
+    pushFrames(&ring, 0, CAPACITY + 3);
+    EXPECT_EQ(CAPACITY, ring.size());
+
+    std::vector<ESPFrameRing::Frame> frames;
+    ASSERT_EQ(CAPACITY, ring.getFrames(0, (CAPACITY + 3) * FRAME_SIZE, &frames));
+    EXPECT_EQ(3, frames.front().energy);
+    EXPECT_EQ(static_cast<int64_t>(CAPACITY + 2), frames.back().energy);
+}
+
+/// Verify that gaps in the stream are allowed and spans falling in a gap return nothing.
+TEST(ESPFrameRingTest, handlesGaps) {
+    ESPFrameRing ring{CAPACITY, FRAME_SIZE};
+    pushFrames(&ring, 0, 2);
+    pushFrames(&ring, 10 * FRAME_SIZE, 2);
+
+    std::vector<ESPFrameRing::Frame> frames;
+    EXPECT_EQ(0u, ring.getFrames(3 * FRAME_SIZE, 9 * FRAME_SIZE, &frames));
+    ASSERT_EQ(2u, ring.getFrames(FRAME_SIZE, 11 * FRAME_SIZE, &frames));
+    EXPECT_EQ(1, frames[0].energy);
+    EXPECT_EQ(10, frames[1].energy);
+}
+
+/// Verify that frames pushed out of order are rejected.
+TEST(ESPFrameRingTest, rejectsOutOfOrderFrames) {
+    ESPFrameRing ring{CAPACITY, FRAME_SIZE};
+    EXPECT_TRUE(ring.push({FRAME_SIZE * 4, 0, false}));
+    EXPECT_FALSE(ring.push({FRAME_SIZE * 4, 0, false}));
+    EXPECT_FALSE(ring.push({FRAME_SIZE * 4 + 1, 0, false}));
+    EXPECT_TRUE(ring.push({FRAME_SIZE * 5, 0, false}));
+    EXPECT_EQ(2u, ring.size());
+}
+
+/// Verify that clear empties the ring and allows indices to restart.
+TEST(ESPFrameRingTest, clearEmptiesRing) {
+    ESPFrameRing ring{CAPACITY, FRAME_SIZE};
+    pushFrames(&ring, FRAME_SIZE * 4, 3);
+    ring.clear();
+    EXPECT_EQ(0u, ring.size());
+    EXPECT_TRUE(ring.push({0, 0, false}));
+}
+
+}  // namespace test
+}  // namespace esp
+}  // namespace alexaClientSDK
@@ -0,0 +1,87 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_KWD_KITTAI_INCLUDE_KITTAI_KITTAIKEYWORDENGINE_H_
+#define ALEXA_CLIENT_SDK_KWD_KITTAI_INCLUDE_KITTAI_KITTAIKEYWORDENGINE_H_
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <AVSCommon/Utils/AudioFormat.h>
+
+#include "KWD/KeywordEngineInterface.h"
+#include "KittAi/KittAiKeyWordDetector.h"
+#include "snowboy-detect.h"
+
+namespace alexaClientSDK {
+namespace kwd {
+
+/**
+ * A Kitt.ai engine which can run alongside other engines under a @c MultiEngineKeywordDetector, instead of reading the
+ * stream itself as @c KittAiKeyWordDetector does.
+ */
+class KittAiKeywordEngine : public KeywordEngineInterface {
+public:
+    /**
+     * Creates a @c KittAiKeywordEngine.
+     *
+     * @param audioFormat The format of the audio which will be passed to @c process().
+     * @param resourceFilePath The path to the resource file.
+     * @param kittAiConfigurations The models and keywords to detect.
+     * @param audioGain This controls whether to increase (>1) or decrease (<1) input volume.
+     * @param applyFrontEnd Whether to apply frontend audio processing.
+     * @return A new @c KittAiKeywordEngine, or @c nullptr if the operation failed.
+     * @see https://github.com/Kitt-AI/snowboy for more information regarding @c audioGain and @c applyFrontEnd.
+     */
+    static std::unique_ptr<KittAiKeywordEngine> create(
+        avsCommon::utils::AudioFormat audioFormat,
+        const std::string& resourceFilePath,
+        const std::vector<KittAiKeyWordDetector::KittAiConfiguration> kittAiConfigurations,
+        float audioGain,
+        bool applyFrontEnd);
+
+    /// @name KeywordEngineInterface Functions
+    /// @{
+    bool process(
+        const int16_t* samples,
+        size_t numSamples,
+        avsCommon::avs::AudioInputStream::Index beginIndex,
+        std::vector<Detection>* detections) override;
+    /// @}
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param kittAiEngine The Kitt.ai engine instantiation.
+     * @param detectionResultsToKeyWords Maps each detection result of @c kittAiEngine to its keyword.
+     */
+    KittAiKeywordEngine(
+        std::unique_ptr<snowboy::SnowboyDetect> kittAiEngine,
+        std::unordered_map<unsigned int, std::string> detectionResultsToKeyWords);
+
+    /// The Kitt.ai engine instantiation.
+    std::unique_ptr<snowboy::SnowboyDetect> m_kittAiEngine;
+
+    /// Maps each detection result of @c m_kittAiEngine to its keyword.
+    std::unordered_map<unsigned int, std::string> m_detectionResultsToKeyWords;
+};
+
+}  // namespace kwd
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_KWD_KITTAI_INCLUDE_KITTAI_KITTAIKEYWORDENGINE_H_
@@ -0,0 +1,117 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <sstream>
+
+#include <AVSCommon/SDKInterfaces/KeyWordObserverInterface.h>
+#include <AVSCommon/Utils/Logger/Logger.h>
+#include <AVSCommon/Utils/Memory/Memory.h>
+
+#include "KittAi/KittAiKeywordEngine.h"
+
+namespace alexaClientSDK {
+namespace kwd {
+
+using namespace avsCommon::avs;
+using namespace avsCommon::sdkInterfaces;
+using namespace avsCommon::utils;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("KittAiKeywordEngine");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The delimiter for Kitt.ai engine constructor parameters
+static const std::string KITT_DELIMITER = ",";
+
+/// Kitt.ai returns -1 if an error occurred.
+static const int KITT_AI_ERROR_DETECTION_RESULT = -1;
+
+std::unique_ptr<KittAiKeywordEngine> KittAiKeywordEngine::create(
+    AudioFormat audioFormat,
+    const std::string& resourceFilePath,
+    const std::vector<KittAiKeyWordDetector::KittAiConfiguration> kittAiConfigurations,
+    float audioGain,
+    bool applyFrontEnd) {
+    std::stringstream sensitivities;
+    std::stringstream modelPaths;
+    std::unordered_map<unsigned int, std::string> detectionResultsToKeyWords;
+    for (unsigned int i = 0; i < kittAiConfigurations.size(); ++i) {
+        modelPaths << kittAiConfigurations.at(i).modelFilePath;
+        sensitivities << kittAiConfigurations.at(i).sensitivity;
+        detectionResultsToKeyWords[i + 1] = kittAiConfigurations.at(i).keyword;
+        if (kittAiConfigurations.size() - 1 != i) {
+            modelPaths << KITT_DELIMITER;
+            sensitivities << KITT_DELIMITER;
+        }
+    }
+    auto kittAiEngine = memory::make_unique<snowboy::SnowboyDetect>(resourceFilePath, modelPaths.str());
+    kittAiEngine->SetSensitivity(sensitivities.str());
+    kittAiEngine->SetAudioGain(audioGain);
+    kittAiEngine->ApplyFrontend(applyFrontEnd);
+
+    if (audioFormat.encoding != AudioFormat::Encoding::LPCM ||
+        audioFormat.endianness != AudioFormat::Endianness::LITTLE ||
+        audioFormat.numChannels != static_cast<unsigned int>(kittAiEngine->NumChannels()) ||
+        audioFormat.sampleRateHz != static_cast<unsigned int>(kittAiEngine->SampleRate()) ||
+        audioFormat.sampleSizeInBits != static_cast<unsigned int>(kittAiEngine->BitsPerSample())) {
+        ACSDK_ERROR(LX("createFailed")
+                        .d("reason", "incompatibleAudioFormat")
+                        .d("encoding", audioFormat.encoding)
+                        .d("endianness", audioFormat.endianness)
+                        .d("numChannels", audioFormat.numChannels)
+                        .d("sampleRate", audioFormat.sampleRateHz)
+                        .d("sampleSizeInBits", audioFormat.sampleSizeInBits));
+        return nullptr;
+    }
+
+    return std::unique_ptr<KittAiKeywordEngine>(
+        new KittAiKeywordEngine(std::move(kittAiEngine), detectionResultsToKeyWords));
+}
+
+KittAiKeywordEngine::KittAiKeywordEngine(
+    std::unique_ptr<snowboy::SnowboyDetect> kittAiEngine,
+    std::unordered_map<unsigned int, std::string> detectionResultsToKeyWords) :
+        m_kittAiEngine{std::move(kittAiEngine)},
+        m_detectionResultsToKeyWords{detectionResultsToKeyWords} {
+}
+
+bool KittAiKeywordEngine::process(
+    const int16_t* samples,
+    size_t numSamples,
+    AudioInputStream::Index beginIndex,
+    std::vector<Detection>* detections) {
+    int detectionResult = m_kittAiEngine->RunDetection(samples, numSamples);
+    if (detectionResult > 0) {
+        auto it = m_detectionResultsToKeyWords.find(detectionResult);
+        if (it == m_detectionResultsToKeyWords.end()) {
+            ACSDK_ERROR(LX("processFailed").d("reason", "retrievingDetectedKeyWordFailed"));
+            return false;
+        }
+        detections->push_back({it->second, KeyWordObserverInterface::UNSPECIFIED_INDEX, beginIndex + numSamples});
+    } else if (KITT_AI_ERROR_DETECTION_RESULT == detectionResult) {
+        ACSDK_ERROR(LX("processFailed").d("reason", "kittAiEngineError"));
+        return false;
+    }
+    return true;
+}
+
+}  // namespace kwd
+}  // namespace alexaClientSDK
@@ -0,0 +1,467 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file
+ * Replays the recordings in KWD/inputs through each compiled-in keyword detector and reports its CPU cost, how long
+ * after the end of each keyword it was reported, and any missed or extra detections.
+ *
+ * USAGE: KeywordDetectorBenchmark <path_to_inputs_folder> [--realtime] [--detector stub|kittai|sensory]
+ *
+ * By default the audio is written as fast as the detector can read it, which measures CPU cost; with @c --realtime it
+ * is written in 10 ms buffers at the rate a microphone would deliver it, which makes the latencies meaningful.  The
+ * @c stub detector runs a @c MultiEngineKeywordDetector with an engine that reports each keyword as soon as it sees its
+ * end index, so its figures are the floor set by the stream and the detector thread.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <AVSCommon/AVS/AudioInputStream.h>
+#include <AVSCommon/SDKInterfaces/KeyWordDetectorStateObserverInterface.h>
+#include <AVSCommon/SDKInterfaces/KeyWordObserverInterface.h>
+#include <AVSCommon/Utils/AudioFormat.h>
+
+#include "KWD/AbstractKeywordDetector.h"
+#include "KWD/MultiEngineKeywordDetector.h"
+
+#if defined(KWD_KITTAI)
+#include <KittAi/KittAiKeyWordDetector.h>
+#endif
+#if defined(KWD_SENSORY)
+#include <Sensory/SensoryKeywordDetector.h>
+#endif
+
+using namespace alexaClientSDK;
+using namespace alexaClientSDK::avsCommon::avs;
+using namespace alexaClientSDK::avsCommon::sdkInterfaces;
+using namespace alexaClientSDK::avsCommon::utils;
+using namespace alexaClientSDK::kwd;
+
+/// The keyword spoken in the recordings.
+static const std::string KEYWORD = "ALEXA";
+
+/// The number of samples per millisecond in the recordings.
+static const size_t SAMPLES_PER_MS = 16;
+
+/// The size of the RIFF header of the recordings.
+static const size_t RIFF_HEADER_SIZE = 44;
+
+/// The duration of each buffer written to the stream.
+static const std::chrono::milliseconds WRITE_DURATION{10};
+
+/// The number of samples in each buffer written to the stream.
+static const size_t WRITE_SIZE = WRITE_DURATION.count() * SAMPLES_PER_MS;
+
+/// How far a detection may be from the expected end of a keyword and still count as a hit.
+static const std::chrono::milliseconds MATCH_MARGIN{250};
+
+/// How long to wait for a detector to finish reading a recording.
+static const std::chrono::seconds FINISH_TIMEOUT{60};
+
+/// The name of the Kitt.ai resource file in the inputs folder.
+static const std::string KITTAI_RESOURCE_FILE = "/KittAiModels/common.res";
+
+/// The name of the Kitt.ai model file in the inputs folder.
+static const std::string KITTAI_MODEL_FILE = "/KittAiModels/alexa.umdl";
+
+/// The Kitt.ai sensitivity, as used by the Kitt.ai tests.
+static const double KITTAI_SENSITIVITY = 0.6;
+
+/// The Kitt.ai audio gain, as used by the Kitt.ai tests.
+static const float KITTAI_AUDIO_GAIN = 2.0;
+
+/// The name of the Sensory model file in the inputs folder.
+static const std::string SENSORY_MODEL_FILE = "/SensoryModels/spot-alexa-rpi-31000.snsr";
+
+/// A recording and the approximate end indices of the keywords in it.
+struct Recording {
+    /// The name of the file in the inputs folder.
+    std::string fileName;
+
+    /// The approximate end indices of the keywords.
+    std::vector<AudioInputStream::Index> keywordEndIndices;
+};
+
+/// The recordings to replay.
+static const std::vector<Recording> RECORDINGS = {{"/four_alexa.wav", {21440, 52800, 72480, 91552}},
+                                                  {"/alexa_stop_alexa_joke.wav", {20960, 51312}}};
+
+/// The 16 kHz, 16-bit, mono LPCM format of the recordings.
+static const AudioFormat FORMAT = {AudioFormat::Encoding::LPCM,
+                                   AudioFormat::Endianness::LITTLE,
+                                   16000,
+                                   16,
+                                   1,
+                                   true,
+                                   AudioFormat::Layout::INTERLEAVED};
+
+/// Creates a detector reading the given stream and notifying the given observer.
+using DetectorFactory = std::function<std::unique_ptr<AbstractKeywordDetector>(
+    std::shared_ptr<AudioInputStream> stream,
+    const Recording& recording,
+    std::shared_ptr<KeyWordObserverInterface> keyWordObserver,
+    std::shared_ptr<KeyWordDetectorStateObserverInterface> stateObserver)>;
+
+/// A named detector to benchmark.
+struct Detector {
+    /// The name used on the command line and in the report.
+    std::string name;
+
+    /// Creates the detector.
+    DetectorFactory create;
+};
+
+/// An engine which reports a keyword at each of the expected end indices.
+class StubEngine : public KeywordEngineInterface {
+public:
+    /**
+     * Constructor.
+     *
+     * @param keywordEndIndices The indices at which to report a keyword.
+     */
+    StubEngine(const std::vector<AudioInputStream::Index>& keywordEndIndices) : m_keywordEndIndices{keywordEndIndices} {
+    }
+
+    bool process(
+        const int16_t* samples,
+        size_t numSamples,
+        AudioInputStream::Index beginIndex,
+        std::vector<Detection>* detections) override {
+        for (auto endIndex : m_keywordEndIndices) {
+            if (endIndex >= beginIndex && endIndex < beginIndex + numSamples) {
+                detections->push_back({KEYWORD, KeyWordObserverInterface::UNSPECIFIED_INDEX, endIndex});
+            }
+        }
+        return true;
+    }
+
+private:
+    /// The indices at which to report a keyword.
+    const std::vector<AudioInputStream::Index> m_keywordEndIndices;
+};
+
+/// Records the detections reported for one recording and waits for the detector to reach the end of it.
+class BenchmarkObserver
+        : public KeyWordObserverInterface
+        , public KeyWordDetectorStateObserverInterface {
+public:
+    /// A reported keyword.
+    struct Detection {
+        /// The end index reported.
+        AudioInputStream::Index endIndex;
+
+        /// When it was reported.
+        std::chrono::steady_clock::time_point time;
+    };
+
+    void onKeyWordDetected(
+        std::shared_ptr<AudioInputStream> stream,
+        std::string keyword,
+        AudioInputStream::Index beginIndex,
+        AudioInputStream::Index endIndex) override {
+        auto now = std::chrono::steady_clock::now();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_detections.push_back({endIndex, now});
+    }
+
+    void onStateChanged(KeyWordDetectorState state) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (KeyWordDetectorState::STREAM_CLOSED == state || KeyWordDetectorState::ERROR == state) {
+            m_finished = true;
+            m_finishedTrigger.notify_all();
+        }
+    }
+
+    /**
+     * Wait for the detector to stop reading, because the stream was closed or it failed.
+     *
+     * @return Whether the detector stopped before @c FINISH_TIMEOUT.
+     */
+    bool waitForFinish() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_finishedTrigger.wait_for(lock, FINISH_TIMEOUT, [this] { return m_finished; });
+    }
+
+    /// @return The detections reported so far.
+    std::vector<Detection> getDetections() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_detections;
+    }
+
+private:
+    /// Serializes access to the members below.
+    std::mutex m_mutex;
+
+    /// Notified when the detector stops reading.
+    std::condition_variable m_finishedTrigger;
+
+    /// Whether the detector has stopped reading.
+    bool m_finished = false;
+
+    /// The detections reported so far.
+    std::vector<Detection> m_detections;
+};
+
+/// The results of replaying one recording through one detector.
+struct Result {
+    /// The duration of the recording.
+    double audioMs = 0;
+
+    /// The CPU time used while the detector read the recording.
+    double cpuMs = 0;
+
+    /// The number of keywords detected near their expected end index.
+    size_t hits = 0;
+
+    /// The number of keywords not detected.
+    size_t missed = 0;
+
+    /// The number of detections not near any expected keyword.
+    size_t extra = 0;
+
+    /// For each hit, the time from writing the keyword's end to its detection.
+    std::vector<double> latenciesMs;
+};
+
+/**
+ * Read the samples of a recording.
+ *
+ * @param fileName The path to the file.
+ * @param[out] samples The samples read from the file.
+ * @return @c true if the file was read, else @c false.
+ */
+static bool readAudioFromFile(const std::string& fileName, std::vector<int16_t>* samples) {
+    std::ifstream inputFile(fileName.c_str(), std::ifstream::binary);
+    if (!inputFile.good()) {
+        return false;
+    }
+    inputFile.seekg(0, std::ios::end);
+    size_t fileLengthInBytes = inputFile.tellg();
+    if (fileLengthInBytes <= RIFF_HEADER_SIZE) {
+        return false;
+    }
+    inputFile.seekg(RIFF_HEADER_SIZE, std::ios::beg);
+    samples->resize((fileLengthInBytes - RIFF_HEADER_SIZE) / sizeof(int16_t));
+    inputFile.read(reinterpret_cast<char*>(samples->data()), samples->size() * sizeof(int16_t));
+    return inputFile.gcount() == static_cast<std::streamsize>(samples->size() * sizeof(int16_t));
+}
+
+/**
+ * Replay one recording through one detector.
+ *
+ * @param detector The detector to benchmark.
+ * @param recording The recording.
+ * @param samples The samples of the recording.
+ * @param realTime Whether to write the audio at the rate it was recorded.
+ * @param[out] result The results.
+ * @return @c true if the recording was replayed, else @c false.
+ */
+static bool replay(
+    const Detector& detector,
+    const Recording& recording,
+    const std::vector<int16_t>& samples,
+    bool realTime,
+    Result* result) {
+    // The stream holds the whole recording so that a slow detector is measured rather than overrun.
+    size_t bufferSize = AudioInputStream::calculateBufferSize(samples.size(), sizeof(int16_t), 1);
+    std::shared_ptr<AudioInputStream> stream =
+        AudioInputStream::create(std::make_shared<AudioInputStream::Buffer>(bufferSize), sizeof(int16_t), 1);
+    if (!stream) {
+        return false;
+    }
+    auto writer = stream->createWriter(AudioInputStream::Writer::Policy::NONBLOCKABLE);
+    auto observer = std::make_shared<BenchmarkObserver>();
+    auto keywordDetector = detector.create(stream, recording, observer, observer);
+    if (!writer || !keywordDetector) {
+        std::cerr << "Unable to create " << detector.name << std::endl;
+        return false;
+    }
+
+    // Record when each buffer was written, so that latencies can be measured from when the keyword's end was written.
+    std::vector<std::chrono::steady_clock::time_point> writeTimes;
+    auto cpuStart = std::clock();
+    auto start = std::chrono::steady_clock::now();
+    for (size_t offset = 0; offset < samples.size(); offset += WRITE_SIZE) {
+        if (realTime) {
+            std::this_thread::sleep_until(start + WRITE_DURATION * writeTimes.size());
+        }
+        writer->write(samples.data() + offset, std::min(WRITE_SIZE, samples.size() - offset));
+        writeTimes.push_back(std::chrono::steady_clock::now());
+    }
+    writer->close();
+    if (!observer->waitForFinish()) {
+        std::cerr << detector.name << " did not finish " << recording.fileName << std::endl;
+        return false;
+    }
+    result->cpuMs = 1000.0 * (std::clock() - cpuStart) / CLOCKS_PER_SEC;
+    result->audioMs = static_cast<double>(samples.size()) / SAMPLES_PER_MS;
+    keywordDetector.reset();
+
+    auto detections = observer->getDetections();
+    std::vector<bool> matched(detections.size(), false);
+    const AudioInputStream::Index margin = MATCH_MARGIN.count() * SAMPLES_PER_MS;
+    for (auto expected : recording.keywordEndIndices) {
+        bool found = false;
+        for (size_t i = 0; i < detections.size() && !found; ++i) {
+            auto distance = detections[i].endIndex > expected ? detections[i].endIndex - expected
+                                                              : expected - detections[i].endIndex;
+            if (!matched[i] && distance <= margin) {
+                matched[i] = true;
+                found = true;
+                auto written = writeTimes[std::min<size_t>(expected / WRITE_SIZE, writeTimes.size() - 1)];
+                result->latenciesMs.push_back(
+                    std::chrono::duration<double, std::milli>(detections[i].time - written).count());
+            }
+        }
+        found ? ++result->hits : ++result->missed;
+    }
+    result->extra = std::count(matched.begin(), matched.end(), false);
+    return true;
+}
+
+/**
+ * Build the list of detectors which were compiled in.
+ *
+ * @param inputsDirPath The path to the inputs folder, which holds the models.
+ * @return The detectors.
+ */
+static std::vector<Detector> getDetectors(const std::string& inputsDirPath) {
+    std::vector<Detector> detectors;
+    detectors.push_back({"stub",
+                         [](std::shared_ptr<AudioInputStream> stream,
+                            const Recording& recording,
+                            std::shared_ptr<KeyWordObserverInterface> keyWordObserver,
+                            std::shared_ptr<KeyWordDetectorStateObserverInterface> stateObserver) {
+                             return std::unique_ptr<AbstractKeywordDetector>(MultiEngineKeywordDetector::create(
+                                 stream,
+                                 FORMAT,
+                                 {keyWordObserver},
+                                 {stateObserver},
+                                 {std::make_shared<StubEngine>(recording.keywordEndIndices)}));
+                         }});
+#if defined(KWD_KITTAI)
+    detectors.push_back({"kittai",
+                         [inputsDirPath](
+                             std::shared_ptr<AudioInputStream> stream,
+                             const Recording& recording,
+                             std::shared_ptr<KeyWordObserverInterface> keyWordObserver,
+                             std::shared_ptr<KeyWordDetectorStateObserverInterface> stateObserver) {
+                             return std::unique_ptr<AbstractKeywordDetector>(KittAiKeyWordDetector::create(
+                                 stream,
+                                 FORMAT,
+                                 {keyWordObserver},
+                                 {stateObserver},
+                                 inputsDirPath + KITTAI_RESOURCE_FILE,
+                                 {{inputsDirPath + KITTAI_MODEL_FILE, KEYWORD, KITTAI_SENSITIVITY}},
+                                 KITTAI_AUDIO_GAIN,
+                                 false));
+                         }});
+#endif
+#if defined(KWD_SENSORY)
+    detectors.push_back({"sensory",
+                         [inputsDirPath](
+                             std::shared_ptr<AudioInputStream> stream,
+                             const Recording& recording,
+                             std::shared_ptr<KeyWordObserverInterface> keyWordObserver,
+                             std::shared_ptr<KeyWordDetectorStateObserverInterface> stateObserver) {
+                             return std::unique_ptr<AbstractKeywordDetector>(SensoryKeywordDetector::create(
+                                 stream,
+                                 FORMAT,
+                                 {keyWordObserver},
+                                 {stateObserver},
+                                 inputsDirPath + SENSORY_MODEL_FILE));
+                         }});
+#endif
+    return detectors;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "USAGE: " << std::string(argv[0])
+                  << " <path_to_inputs_folder> [--realtime] [--detector stub|kittai|sensory]" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::string inputsDirPath = argv[1];
+    bool realTime = false;
+    std::string selected;
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        if ("--realtime" == arg) {
+            realTime = true;
+        } else if ("--detector" == arg && i + 1 < argc) {
+            selected = argv[++i];
+        } else {
+            std::cerr << "Unknown argument: " << arg << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    auto detectors = getDetectors(inputsDirPath);
+    if (!selected.empty()) {
+        detectors.erase(
+            std::remove_if(
+                detectors.begin(), detectors.end(), [&selected](const Detector& d) { return d.name != selected; }),
+            detectors.end());
+        if (detectors.empty()) {
+            std::cerr << "Detector " << selected << " was not compiled in" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::cout << std::left << std::setw(10) << "detector" << std::setw(30) << "file" << std::right << std::setw(10)
+              << "audioMs" << std::setw(10) << "cpuMs" << std::setw(14) << "cpuMsPerSec" << std::setw(6) << "hits"
+              << std::setw(8) << "missed" << std::setw(7) << "extra" << std::setw(15) << "meanLatencyMs"
+              << std::setw(14) << "maxLatencyMs" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+
+    bool succeeded = true;
+    for (const auto& detector : detectors) {
+        for (const auto& recording : RECORDINGS) {
+            std::vector<int16_t> samples;
+            if (!readAudioFromFile(inputsDirPath + recording.fileName, &samples)) {
+                std::cerr << "Unable to read " << inputsDirPath + recording.fileName << std::endl;
+                return EXIT_FAILURE;
+            }
+            Result result;
+            if (!replay(detector, recording, samples, realTime, &result)) {
+                succeeded = false;
+                continue;
+            }
+            double meanLatencyMs = 0;
+            double maxLatencyMs = 0;
+            for (auto latencyMs : result.latenciesMs) {
+                meanLatencyMs += latencyMs / result.latenciesMs.size();
+                maxLatencyMs = std::max(maxLatencyMs, latencyMs);
+            }
+            std::cout << std::left << std::setw(10) << detector.name << std::setw(30) << recording.fileName
+                      << std::right << std::setw(10) << result.audioMs << std::setw(10) << result.cpuMs
+                      << std::setw(14) << result.cpuMs * 1000 / result.audioMs << std::setw(6) << result.hits
+                      << std::setw(8) << result.missed << std::setw(7) << result.extra << std::setw(15)
+                      << meanLatencyMs << std::setw(14) << maxLatencyMs << std::endl;
+        }
+    }
+    return succeeded ? EXIT_SUCCESS : EXIT_FAILURE;
+}
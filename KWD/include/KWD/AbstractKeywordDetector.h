@@ -24,6 +24,8 @@
 #include <AVSCommon/SDKInterfaces/KeyWordObserverInterface.h>
 #include <AVSCommon/SDKInterfaces/KeyWordDetectorStateObserverInterface.h>
 
+#include "KWD/KeywordDetectorAudioObserverInterface.h"
+
 namespace alexaClientSDK {
 namespace kwd {
 
@@ -59,6 +61,21 @@ public:
     void removeKeyWordDetectorStateObserver(
         std::shared_ptr<avsCommon::sdkInterfaces::KeyWordDetectorStateObserverInterface> keyWordDetectorStateObserver);
 
+    /**
+     * Adds the specified observer to the list of observers to notify of the audio read by the detector.  Only
+     * detectors which read through @c readFromStream() notify these observers, and only for streams of 16-bit words.
+     *
+     * @param audioObserver The observer to add.
+     */
+    void addAudioObserver(std::shared_ptr<KeywordDetectorAudioObserverInterface> audioObserver);
+
+    /**
+     * Removes the specified observer from the list of observers to notify of the audio read by the detector.
+     *
+     * @param audioObserver The observer to remove.
+     */
+    void removeAudioObserver(std::shared_ptr<KeywordDetectorAudioObserverInterface> audioObserver);
+
     /**
      * Destructor.
      */
@@ -102,7 +119,7 @@ protected:
 
     /**
      * Reads from the specified stream into the specified buffer and does the appropriate error checking and observer
-     * notifications.
+     * notifications.  Audio observers are passed the words read.
      *
      * @param reader The stream reader. This should be a blocking reader.
      * @param buf The buffer to read into.
@@ -147,6 +164,12 @@ private:
     /// Lock to protect m_keyWordDetectorStateObservers when users wish to add or remove observers
     mutable std::mutex m_keyWordDetectorStateObserversMutex;
 
+    /// The observers to notify of the audio read.  This should be locked with m_audioObserversMutex prior to usage.
+    std::unordered_set<std::shared_ptr<KeywordDetectorAudioObserverInterface>> m_audioObservers;
+
+    /// Lock to protect m_audioObservers when users wish to add or remove observers
+    std::mutex m_audioObserversMutex;
+
     /**
      * The current state of the detector. This is stored so that we don't notify observers of the same change in state
      * multiple times.
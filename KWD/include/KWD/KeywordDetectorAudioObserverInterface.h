@@ -0,0 +1,57 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_KWD_INCLUDE_KWD_KEYWORDDETECTORAUDIOOBSERVERINTERFACE_H_
+#define ALEXA_CLIENT_SDK_KWD_INCLUDE_KWD_KEYWORDDETECTORAUDIOOBSERVERINTERFACE_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include <AVSCommon/AVS/AudioInputStream.h>
+
+namespace alexaClientSDK {
+namespace kwd {
+
+/**
+ * An observer of the audio a keyword detector reads, which lets another consumer of the same stream (such as an ESP
+ * provider) process it without a reader and a thread of its own.
+ */
+class KeywordDetectorAudioObserverInterface {
+public:
+    /**
+     * Destructor.
+     */
+    virtual ~KeywordDetectorAudioObserverInterface() = default;
+
+    /**
+     * Called from the detector's reading thread with each buffer it reads, before the detector processes it.  Buffers
+     * are passed in stream order, and @c beginIndex jumps forward after an overrun.  The samples are as read from the
+     * stream, before any byte swapping.  Implementations should return quickly, as the detector does not read the
+     * next buffer until they do.
+     *
+     * @param samples The samples read.
+     * @param numSamples The number of samples in @c samples.
+     * @param beginIndex The absolute index in the stream of the first sample in @c samples.
+     */
+    virtual void onAudioRead(
+        const int16_t* samples,
+        size_t numSamples,
+        avsCommon::avs::AudioInputStream::Index beginIndex) = 0;
+};
+
+}  // namespace kwd
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_KWD_INCLUDE_KWD_KEYWORDDETECTORAUDIOOBSERVERINTERFACE_H_
@@ -0,0 +1,73 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_KWD_INCLUDE_KWD_KEYWORDENGINEINTERFACE_H_
+#define ALEXA_CLIENT_SDK_KWD_INCLUDE_KWD_KEYWORDENGINEINTERFACE_H_
+
+#include <string>
+#include <vector>
+
+#include <AVSCommon/AVS/AudioInputStream.h>
+
+namespace alexaClientSDK {
+namespace kwd {
+
+/**
+ * A keyword engine consumes audio and reports keyword detections, without reading from a stream itself.  This lets a
+ * @c MultiEngineKeywordDetector read each frame once and hand the same buffer to several engines.
+ */
+class KeywordEngineInterface {
+public:
+    /// A keyword detected by an engine.
+    struct Detection {
+        /// The keyword detected.
+        std::string keyword;
+
+        /**
+         * The absolute index in the stream of the first sample of the keyword, or
+         * @c KeyWordObserverInterface::UNSPECIFIED_INDEX if the engine does not report it.
+         */
+        avsCommon::avs::AudioInputStream::Index beginIndex;
+
+        /// The absolute index in the stream just past the last sample of the keyword.
+        avsCommon::avs::AudioInputStream::Index endIndex;
+    };
+
+    /**
+     * Destructor.
+     */
+    virtual ~KeywordEngineInterface() = default;
+
+    /**
+     * Run detection over the next buffer of audio.  Buffers are passed in stream order with no gaps, except after an
+     * overrun or across audio skipped by a @c VoiceActivityGate, when @c beginIndex jumps forward.
+     *
+     * @param samples The samples to process, in the detector's audio format.
+     * @param numSamples The number of samples in @c samples.
+     * @param beginIndex The absolute index in the stream of the first sample in @c samples.
+     * @param[out] detections Any keywords detected in this buffer are appended here.
+     * @return @c false if the engine hit an unrecoverable error, else @c true.
+     */
+    virtual bool process(
+        const int16_t* samples,
+        size_t numSamples,
+        avsCommon::avs::AudioInputStream::Index beginIndex,
+        std::vector<Detection>* detections) = 0;
+};
+
+}  // namespace kwd
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_KWD_INCLUDE_KWD_KEYWORDENGINEINTERFACE_H_
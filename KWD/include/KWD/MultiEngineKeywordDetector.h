@@ -0,0 +1,224 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_KWD_INCLUDE_KWD_MULTIENGINEKEYWORDDETECTOR_H_
+#define ALEXA_CLIENT_SDK_KWD_INCLUDE_KWD_MULTIENGINEKEYWORDDETECTOR_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include <AVSCommon/AVS/AudioInputStream.h>
+#include <AVSCommon/SDKInterfaces/KeyWordDetectorStateObserverInterface.h>
+#include <AVSCommon/SDKInterfaces/KeyWordObserverInterface.h>
+#include <AVSCommon/Utils/AudioFormat.h>
+
+#include "KWD/AbstractKeywordDetector.h"
+#include "KWD/KeywordEngineInterface.h"
+#include "KWD/VoiceActivityGate.h"
+
+namespace alexaClientSDK {
+namespace kwd {
+
+/**
+ * A keyword detector which runs several @c KeywordEngineInterface engines over one stream.  A single reader pulls each
+ * buffer from the stream once and the same buffer is handed to every engine, so adding an engine (for example, a
+ * second locale) costs only its own inference rather than another reader and another thread waking on every write.
+ *
+ * Engines may be spread over several threads.  The reading thread waits for every engine to finish a buffer before
+ * reading the next one, and then notifies observers of any detections in engine order, so observers are always called
+ * from one thread with indices taken from the one reader.
+ *
+ * An optional @c VoiceActivityGate can be placed in front of the engines, in which case they only see the audio around
+ * speech.  Buffers then jump forward in the stream across skipped audio, as they do after an overrun.
+ */
+class MultiEngineKeywordDetector : public AbstractKeywordDetector {
+public:
+    /**
+     * Creates a @c MultiEngineKeywordDetector.
+     *
+     * @param stream The stream of audio data. This should be formatted in LPCM encoded with 16 bits per sample and in
+     * the platform's byte order.
+     * @param audioFormat The format of the audio data located within the stream.
+     * @param keyWordObservers The observers to notify of keyword detections.
+     * @param keyWordDetectorStateObservers The observers to notify of state changes in the engine.
+     * @param engines The engines to run over the stream.  These must all accept @c audioFormat.
+     * @param numThreads The number of threads to run the engines on, including the thread that reads the stream.  This
+     * is capped at the number of engines.
+     * @param msToPushPerIteration The amount of data in milliseconds to push to the engines at a time.
+     * @param voiceActivityGate An optional gate which skips audio without speech.  This requires 16 kHz mono audio.
+     * @return A new @c MultiEngineKeywordDetector, or @c nullptr if the operation failed.
+     */
+    static std::unique_ptr<MultiEngineKeywordDetector> create(
+        std::shared_ptr<avsCommon::avs::AudioInputStream> stream,
+        avsCommon::utils::AudioFormat audioFormat,
+        std::unordered_set<std::shared_ptr<avsCommon::sdkInterfaces::KeyWordObserverInterface>> keyWordObservers,
+        std::unordered_set<std::shared_ptr<avsCommon::sdkInterfaces::KeyWordDetectorStateObserverInterface>>
+            keyWordDetectorStateObservers,
+        std::vector<std::shared_ptr<KeywordEngineInterface>> engines,
+        size_t numThreads = 1,
+        std::chrono::milliseconds msToPushPerIteration = std::chrono::milliseconds(20),
+        std::shared_ptr<VoiceActivityGate> voiceActivityGate = nullptr);
+
+    /**
+     * Destructor.
+     */
+    ~MultiEngineKeywordDetector() override;
+
+private:
+    /// The outcome of running one engine over the current buffer.
+    struct EngineResult {
+        /// The keywords detected.
+        std::vector<KeywordEngineInterface::Detection> detections;
+
+        /// Whether the engine succeeded.
+        bool succeeded;
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param stream The stream of audio data.
+     * @param keyWordObservers The observers to notify of keyword detections.
+     * @param keyWordDetectorStateObservers The observers to notify of state changes in the engine.
+     * @param engines The engines to run over the stream.
+     * @param numThreads The number of threads to run the engines on.
+     * @param samplesPerPush The number of samples to push to the engines at a time.
+     * @param voiceActivityGate An optional gate which skips audio without speech.
+     */
+    MultiEngineKeywordDetector(
+        std::shared_ptr<avsCommon::avs::AudioInputStream> stream,
+        std::unordered_set<std::shared_ptr<avsCommon::sdkInterfaces::KeyWordObserverInterface>> keyWordObservers,
+        std::unordered_set<std::shared_ptr<avsCommon::sdkInterfaces::KeyWordDetectorStateObserverInterface>>
+            keyWordDetectorStateObservers,
+        std::vector<std::shared_ptr<KeywordEngineInterface>> engines,
+        size_t numThreads,
+        size_t samplesPerPush,
+        std::shared_ptr<VoiceActivityGate> voiceActivityGate);
+
+    /**
+     * Initializes the stream reader and starts the reading and worker threads.
+     *
+     * @return @c true if the detector was initialized properly and @c false otherwise.
+     */
+    bool init();
+
+    /// The main function that reads data and hands it to the engines.
+    void detectionLoop();
+
+    /**
+     * Hand a buffer to every engine, wait for them all to finish, and notify observers of any detections.
+     *
+     * @param samples The samples to process.
+     * @param numSamples The number of samples in @c samples.
+     * @param beginIndex The absolute index in the stream of the first sample in @c samples.
+     * @return @c false if an engine failed, else @c true.
+     */
+    bool dispatch(const int16_t* samples, size_t numSamples, avsCommon::avs::AudioInputStream::Index beginIndex);
+
+    /**
+     * Log the counts of frames seen by @c m_voiceActivityGate and the fraction of them which were skipped.
+     */
+    void logVoiceActivityGateStatistics();
+
+    /**
+     * The function run by each worker thread.
+     *
+     * @param worker The index of the worker, which selects the engines it runs.
+     */
+    void workerLoop(size_t worker);
+
+    /**
+     * Run the engines assigned to a worker over the current buffer.
+     *
+     * @param worker The index of the worker.
+     */
+    void runEngines(size_t worker);
+
+    /// Indicates whether the internal main loop should keep running.
+    std::atomic<bool> m_isShuttingDown;
+
+    /// The stream of audio data.
+    const std::shared_ptr<avsCommon::avs::AudioInputStream> m_stream;
+
+    /// The reader that will be used to read audio data from the stream.
+    std::shared_ptr<avsCommon::avs::AudioInputStream::Reader> m_streamReader;
+
+    /// The engines, in the order their detections are reported.
+    const std::vector<std::shared_ptr<KeywordEngineInterface>> m_engines;
+
+    /// The number of threads running engines, including the reading thread.
+    const size_t m_numThreads;
+
+    /// The number of samples to push to the engines at a time.
+    const size_t m_samplesPerPush;
+
+    /// An optional gate which skips audio without speech.
+    const std::shared_ptr<VoiceActivityGate> m_voiceActivityGate;
+
+    /// The buffer audio is read into.
+    std::vector<int16_t> m_buffer;
+
+    /// The audio which passed @c m_voiceActivityGate from the latest read.
+    std::vector<VoiceActivityGate::Segment> m_segments;
+
+    /// The number of samples read since the statistics of @c m_voiceActivityGate were last logged.
+    size_t m_samplesSinceGateStatistics;
+
+    /// The samples shared by all engines for the current dispatch.
+    const int16_t* m_samples;
+
+    /// The number of samples in @c m_samples.
+    size_t m_numSamples;
+
+    /// The absolute stream index of the first sample in @c m_samples.
+    avsCommon::avs::AudioInputStream::Index m_beginIndex;
+
+    /// The result of each engine for the current buffer.  Each entry is written only by the thread running its engine.
+    std::vector<EngineResult> m_results;
+
+    /// Serializes access to the members below, which hand buffers between the reading thread and the workers.
+    std::mutex m_workMutex;
+
+    /// Wakes workers when a new buffer is ready or the detector is shutting down.
+    std::condition_variable m_workReady;
+
+    /// Wakes the reading thread when all workers have finished the current buffer.
+    std::condition_variable m_workDone;
+
+    /// Incremented for each buffer handed to the workers.
+    uint64_t m_generation;
+
+    /// The number of workers which have not finished the current buffer.
+    size_t m_pendingWorkers;
+
+    /// Tells the workers to exit.
+    bool m_stopWorkers;
+
+    /// The threads running engines other than those run by the reading thread.
+    std::vector<std::thread> m_workerThreads;
+
+    /// Internal thread that reads audio from the stream and hands it to the engines.
+    std::thread m_detectionThread;
+};
+
+}  // namespace kwd
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_KWD_INCLUDE_KWD_MULTIENGINEKEYWORDDETECTOR_H_
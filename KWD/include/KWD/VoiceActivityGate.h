@@ -0,0 +1,194 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_KWD_INCLUDE_KWD_VOICEACTIVITYGATE_H_
+#define ALEXA_CLIENT_SDK_KWD_INCLUDE_KWD_VOICEACTIVITYGATE_H_
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include <AVSCommon/AVS/AudioInputStream.h>
+#include <AVSCommon/SDKInterfaces/VoiceActivityDetectorInterface.h>
+
+namespace alexaClientSDK {
+namespace kwd {
+
+/**
+ * A @c VoiceActivityGate sits in front of keyword engines and only lets through audio which a cheap voice activity
+ * detector classifies as speech, so that engines do not run full inference on every frame of a silent room.
+ *
+ * When speech starts the gate opens and first passes on the pre-roll, the audio just before the speech, so that an
+ * engine sees the start of the keyword even if the detector is slow to trigger.  The gate stays open for a hangover
+ * after the last speech frame so that short pauses do not split a keyword.
+ *
+ * Audio is classified in whole detector frames; a partial frame at the end of a buffer is held until the next call.
+ * The pre-roll is kept in a ring of frames, and the audio passed on is gathered into a buffer owned by the gate, so
+ * once that buffer has reached its working size @c process() does not allocate.  This class is not thread-safe, except
+ * for @c getStatistics().
+ */
+class VoiceActivityGate {
+public:
+    /// A contiguous run of audio which passed the gate.
+    struct Segment {
+        /// The absolute index in the stream of the first sample.
+        avsCommon::avs::AudioInputStream::Index beginIndex;
+
+        /// The samples, which belong to the gate and remain valid until the next call to @c process().
+        const int16_t* samples;
+
+        /// The number of samples.
+        size_t numSamples;
+    };
+
+    /// Counts of the frames seen by the gate.
+    struct Statistics {
+        /// The number of frames classified.
+        uint64_t framesProcessed;
+
+        /// The number of frames which were not passed on when they arrived.  Some may be passed on later as pre-roll.
+        uint64_t framesSkipped;
+    };
+
+    /// The default pre-roll.
+    static const std::chrono::milliseconds DEFAULT_PRE_ROLL;
+
+    /// The default hangover.
+    static const std::chrono::milliseconds DEFAULT_HANGOVER;
+
+    /**
+     * Creates a @c VoiceActivityGate.
+     *
+     * @param voiceActivityDetector The detector used to classify frames of 16 kHz, 16-bit, mono LPCM.
+     * @param preRoll How much audio from before the start of speech to pass on when the gate opens.
+     * @param hangover How long the gate stays open after the last speech frame.
+     * @return A new @c VoiceActivityGate, or @c nullptr if the operation failed.
+     */
+    static std::unique_ptr<VoiceActivityGate> create(
+        std::shared_ptr<avsCommon::sdkInterfaces::VoiceActivityDetectorInterface> voiceActivityDetector,
+        std::chrono::milliseconds preRoll = DEFAULT_PRE_ROLL,
+        std::chrono::milliseconds hangover = DEFAULT_HANGOVER);
+
+    /**
+     * Classify the next buffer of audio.  If @c beginIndex does not follow on from the previous buffer, for example
+     * after an overrun, the gate closes and discards any held audio first.
+     *
+     * @param samples The samples to classify.
+     * @param numSamples The number of samples in @c samples.
+     * @param beginIndex The absolute index in the stream of the first sample in @c samples.
+     * @param[out] segments Replaced by the audio which passed the gate, in stream order.
+     */
+    void process(
+        const int16_t* samples,
+        size_t numSamples,
+        avsCommon::avs::AudioInputStream::Index beginIndex,
+        std::vector<Segment>* segments);
+
+    /**
+     * Get the counts of frames seen so far.  This may be called from any thread.
+     *
+     * @return The counts of frames seen so far.
+     */
+    Statistics getStatistics() const;
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param voiceActivityDetector The detector used to classify frames.
+     * @param preRollFrames The number of frames of pre-roll.
+     * @param hangoverFrames The number of silent frames for which the gate stays open.
+     */
+    VoiceActivityGate(
+        std::shared_ptr<avsCommon::sdkInterfaces::VoiceActivityDetectorInterface> voiceActivityDetector,
+        size_t preRollFrames,
+        size_t hangoverFrames);
+
+    /**
+     * Classify the frame in @c m_frame and pass it on or hold it as pre-roll.
+     *
+     * @param[out] segments The segments to append the frame to if the gate is open.
+     */
+    void processFrame(std::vector<Segment>* segments);
+
+    /**
+     * Append samples to @c m_output, extending the last segment or starting a new one if they do not follow on from
+     * it.  The segments' @c samples pointers are filled in at the end of @c process(), once @c m_output is complete.
+     *
+     * @param beginIndex The absolute index in the stream of the first sample.
+     * @param samples The samples.
+     * @param numSamples The number of samples.
+     * @param[out] segments The segments to append to.
+     */
+    void append(
+        avsCommon::avs::AudioInputStream::Index beginIndex,
+        const int16_t* samples,
+        size_t numSamples,
+        std::vector<Segment>* segments);
+
+    /// The detector used to classify frames.
+    std::shared_ptr<avsCommon::sdkInterfaces::VoiceActivityDetectorInterface> m_voiceActivityDetector;
+
+    /// The number of samples in each frame.
+    const size_t m_frameSize;
+
+    /// The maximum number of frames of pre-roll.
+    const size_t m_preRollFrames;
+
+    /// The number of silent frames for which the gate stays open.
+    const size_t m_hangoverFrames;
+
+    /// The frame being filled.
+    std::vector<int16_t> m_frame;
+
+    /// The absolute index in the stream of the first sample in @c m_frame.
+    avsCommon::avs::AudioInputStream::Index m_frameBeginIndex;
+
+    /// The absolute index in the stream expected at the start of the next buffer.
+    avsCommon::avs::AudioInputStream::Index m_nextIndex;
+
+    /// Whether any audio has been processed yet.
+    bool m_isStarted;
+
+    /// A ring of @c m_preRollFrames frames holding the most recent skipped audio.
+    std::vector<int16_t> m_preRoll;
+
+    /// The slot in @c m_preRoll which the next skipped frame is written to.
+    size_t m_preRollNext;
+
+    /// The number of frames in @c m_preRoll, which end just before @c m_frameBeginIndex.
+    size_t m_preRollCount;
+
+    /// The audio passed on by the latest call to @c process(), which the returned segments point into.
+    std::vector<int16_t> m_output;
+
+    /// Whether audio is currently being passed on.
+    bool m_isOpen;
+
+    /// The number of silent frames since the last speech frame.
+    size_t m_silentFrames;
+
+    /// The number of frames classified.
+    std::atomic<uint64_t> m_framesProcessed;
+
+    /// The number of frames not passed on when they arrived.
+    std::atomic<uint64_t> m_framesSkipped;
+};
+
+}  // namespace kwd
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_KWD_INCLUDE_KWD_VOICEACTIVITYGATE_H_
@@ -56,6 +56,17 @@ void AbstractKeywordDetector::removeKeyWordDetectorStateObserver(
     m_keyWordDetectorStateObservers.erase(keyWordDetectorStateObserver);
 }
 
+void AbstractKeywordDetector::addAudioObserver(std::shared_ptr<KeywordDetectorAudioObserverInterface> audioObserver) {
+    std::lock_guard<std::mutex> lock(m_audioObserversMutex);
+    m_audioObservers.insert(audioObserver);
+}
+
+void AbstractKeywordDetector::removeAudioObserver(
+    std::shared_ptr<KeywordDetectorAudioObserverInterface> audioObserver) {
+    std::lock_guard<std::mutex> lock(m_audioObserversMutex);
+    m_audioObservers.erase(audioObserver);
+}
+
 AbstractKeywordDetector::AbstractKeywordDetector(
     std::unordered_set<std::shared_ptr<KeyWordObserverInterface>> keyWordObservers,
     std::unordered_set<std::shared_ptr<KeyWordDetectorStateObserverInterface>> keyWordDetectorStateObservers) :
@@ -97,8 +108,16 @@ ssize_t AbstractKeywordDetector::readFromStream(
         *errorOccurred = false;
     }
     ssize_t wordsRead = reader->read(buf, nWords, timeout);
+    if (wordsRead > 0) {
+        std::lock_guard<std::mutex> lock(m_audioObserversMutex);
+        if (!m_audioObservers.empty() && sizeof(int16_t) == reader->getWordSize()) {
+            auto beginIndex = reader->tell() - wordsRead;
+            for (auto audioObserver : m_audioObservers) {
+                audioObserver->onAudioRead(static_cast<const int16_t*>(buf), wordsRead, beginIndex);
+            }
+        }
     // Stream has been closed
-    if (wordsRead == 0) {
+    } else if (wordsRead == 0) {
         ACSDK_DEBUG(LX("readFromStream").d("event", "streamClosed"));
         notifyKeyWordDetectorStateObservers(KeyWordDetectorStateObserverInterface::KeyWordDetectorState::STREAM_CLOSED);
         if (errorOccurred) {
@@ -0,0 +1,297 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "KWD/MultiEngineKeywordDetector.h"
+
+namespace alexaClientSDK {
+namespace kwd {
+
+using namespace avsCommon;
+using namespace avsCommon::avs;
+using namespace avsCommon::sdkInterfaces;
+using namespace avsCommon::utils;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("MultiEngineKeywordDetector");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The number of hertz per kilohertz.
+static const size_t HERTZ_PER_KILOHERTZ = 1000;
+
+/// The timeout to use for read calls to the SharedDataStream.
+static const std::chrono::milliseconds TIMEOUT_FOR_READ_CALLS = std::chrono::milliseconds(1000);
+
+/// The only supported sample size.
+static const unsigned int SAMPLE_SIZE_IN_BITS = 16;
+
+/// The sample rate required by a @c VoiceActivityGate.
+static const unsigned int GATE_SAMPLE_RATE_HZ = 16000;
+
+/// How much audio is read between logs of the statistics of the @c VoiceActivityGate.
+static const std::chrono::minutes GATE_STATISTICS_INTERVAL(1);
+
+/// The number of samples read between logs of the statistics of the @c VoiceActivityGate.
+static const size_t GATE_STATISTICS_INTERVAL_SAMPLES =
+    std::chrono::duration_cast<std::chrono::seconds>(GATE_STATISTICS_INTERVAL).count() * GATE_SAMPLE_RATE_HZ;
+
+std::unique_ptr<MultiEngineKeywordDetector> MultiEngineKeywordDetector::create(
+    std::shared_ptr<AudioInputStream> stream,
+    AudioFormat audioFormat,
+    std::unordered_set<std::shared_ptr<KeyWordObserverInterface>> keyWordObservers,
+    std::unordered_set<std::shared_ptr<KeyWordDetectorStateObserverInterface>> keyWordDetectorStateObservers,
+    std::vector<std::shared_ptr<KeywordEngineInterface>> engines,
+    size_t numThreads,
+    std::chrono::milliseconds msToPushPerIteration,
+    std::shared_ptr<VoiceActivityGate> voiceActivityGate) {
+    if (!stream) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "nullStream"));
+        return nullptr;
+    }
+    if (engines.empty()) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "noEngines"));
+        return nullptr;
+    }
+    for (auto& engine : engines) {
+        if (!engine) {
+            ACSDK_ERROR(LX("createFailed").d("reason", "nullEngine"));
+            return nullptr;
+        }
+    }
+    if (isByteswappingRequired(audioFormat)) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "endianMismatch"));
+        return nullptr;
+    }
+    if (audioFormat.encoding != AudioFormat::Encoding::LPCM || audioFormat.sampleSizeInBits != SAMPLE_SIZE_IN_BITS ||
+        stream->getWordSize() != sizeof(int16_t)) {
+        ACSDK_ERROR(LX("createFailed")
+                        .d("reason", "unsupportedFormat")
+                        .d("encoding", audioFormat.encoding)
+                        .d("sampleSizeInBits", audioFormat.sampleSizeInBits)
+                        .d("wordSize", stream->getWordSize()));
+        return nullptr;
+    }
+    size_t samplesPerPush = (audioFormat.sampleRateHz / HERTZ_PER_KILOHERTZ) * audioFormat.numChannels *
+                            static_cast<size_t>(msToPushPerIteration.count());
+    if (0 == samplesPerPush) {
+        ACSDK_ERROR(LX("createFailed")
+                        .d("reason", "invalidPushSize")
+                        .d("sampleRateHz", audioFormat.sampleRateHz)
+                        .d("numChannels", audioFormat.numChannels)
+                        .d("msToPushPerIteration", msToPushPerIteration.count()));
+        return nullptr;
+    }
+    if (voiceActivityGate && (audioFormat.sampleRateHz != GATE_SAMPLE_RATE_HZ || audioFormat.numChannels != 1)) {
+        ACSDK_ERROR(LX("createFailed")
+                        .d("reason", "unsupportedFormatForGate")
+                        .d("sampleRateHz", audioFormat.sampleRateHz)
+                        .d("numChannels", audioFormat.numChannels));
+        return nullptr;
+    }
+    numThreads = std::max<size_t>(1, std::min(numThreads, engines.size()));
+
+    std::unique_ptr<MultiEngineKeywordDetector> detector(new MultiEngineKeywordDetector(
+        stream,
+        keyWordObservers,
+        keyWordDetectorStateObservers,
+        engines,
+        numThreads,
+        samplesPerPush,
+        voiceActivityGate));
+    if (!detector->init()) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "initDetectorFailed"));
+        return nullptr;
+    }
+    return detector;
+}
+
+MultiEngineKeywordDetector::~MultiEngineKeywordDetector() {
+    m_isShuttingDown = true;
+    if (m_detectionThread.joinable()) {
+        m_detectionThread.join();
+    }
+}
+
+MultiEngineKeywordDetector::MultiEngineKeywordDetector(
+    std::shared_ptr<AudioInputStream> stream,
+    std::unordered_set<std::shared_ptr<KeyWordObserverInterface>> keyWordObservers,
+    std::unordered_set<std::shared_ptr<KeyWordDetectorStateObserverInterface>> keyWordDetectorStateObservers,
+    std::vector<std::shared_ptr<KeywordEngineInterface>> engines,
+    size_t numThreads,
+    size_t samplesPerPush,
+    std::shared_ptr<VoiceActivityGate> voiceActivityGate) :
+        AbstractKeywordDetector(keyWordObservers, keyWordDetectorStateObservers),
+        m_isShuttingDown{false},
+        m_stream{stream},
+        m_engines{engines},
+        m_numThreads{numThreads},
+        m_samplesPerPush{samplesPerPush},
+        m_voiceActivityGate{voiceActivityGate},
+        m_buffer(samplesPerPush),
+        m_samplesSinceGateStatistics{0},
+        m_samples{nullptr},
+        m_numSamples{0},
+        m_beginIndex{0},
+        m_results(engines.size()),
+        m_generation{0},
+        m_pendingWorkers{0},
+        m_stopWorkers{false} {
+}
+
+bool MultiEngineKeywordDetector::init() {
+    m_streamReader = m_stream->createReader(AudioInputStream::Reader::Policy::BLOCKING);
+    if (!m_streamReader) {
+        ACSDK_ERROR(LX("initFailed").d("reason", "createStreamReaderFailed"));
+        return false;
+    }
+    // The reading thread runs the engines for worker 0 itself.
+    for (size_t worker = 1; worker < m_numThreads; ++worker) {
+        m_workerThreads.emplace_back(&MultiEngineKeywordDetector::workerLoop, this, worker);
+    }
+    m_detectionThread = std::thread(&MultiEngineKeywordDetector::detectionLoop, this);
+    return true;
+}
+
+void MultiEngineKeywordDetector::detectionLoop() {
+    notifyKeyWordDetectorStateObservers(KeyWordDetectorStateObserverInterface::KeyWordDetectorState::ACTIVE);
+    while (!m_isShuttingDown) {
+        bool didErrorOccur;
+        ssize_t wordsRead = readFromStream(
+            m_streamReader, m_stream, m_buffer.data(), m_samplesPerPush, TIMEOUT_FOR_READ_CALLS, &didErrorOccur);
+        if (didErrorOccur) {
+            break;
+        } else if (wordsRead <= 0) {
+            continue;
+        }
+        notifyKeyWordDetectorStateObservers(KeyWordDetectorStateObserverInterface::KeyWordDetectorState::ACTIVE);
+        auto beginIndex = m_streamReader->tell() - wordsRead;
+
+        bool didEngineFail = false;
+        if (m_voiceActivityGate) {
+            m_voiceActivityGate->process(m_buffer.data(), wordsRead, beginIndex, &m_segments);
+            for (auto& segment : m_segments) {
+                if (!dispatch(segment.samples, segment.numSamples, segment.beginIndex)) {
+                    didEngineFail = true;
+                    break;
+                }
+            }
+            m_samplesSinceGateStatistics += wordsRead;
+            if (m_samplesSinceGateStatistics >= GATE_STATISTICS_INTERVAL_SAMPLES) {
+                logVoiceActivityGateStatistics();
+                m_samplesSinceGateStatistics = 0;
+            }
+        } else {
+            didEngineFail = !dispatch(m_buffer.data(), wordsRead, beginIndex);
+        }
+        if (didEngineFail) {
+            ACSDK_ERROR(LX("detectionLoopFailed").d("reason", "engineError"));
+            notifyKeyWordDetectorStateObservers(KeyWordDetectorStateObserverInterface::KeyWordDetectorState::ERROR);
+            break;
+        }
+    }
+
+    if (m_voiceActivityGate) {
+        logVoiceActivityGateStatistics();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_workMutex);
+        m_stopWorkers = true;
+        m_workReady.notify_all();
+    }
+    for (auto& thread : m_workerThreads) {
+        thread.join();
+    }
+    m_streamReader->close();
+}
+
+void MultiEngineKeywordDetector::logVoiceActivityGateStatistics() {
+    auto statistics = m_voiceActivityGate->getStatistics();
+    double skippedFraction =
+        statistics.framesProcessed ? static_cast<double>(statistics.framesSkipped) / statistics.framesProcessed : 0;
+    ACSDK_INFO(LX("voiceActivityGateStatistics")
+                   .d("framesProcessed", statistics.framesProcessed)
+                   .d("framesSkipped", statistics.framesSkipped)
+                   .d("skippedFraction", skippedFraction));
+}
+
+bool MultiEngineKeywordDetector::dispatch(
+    const int16_t* samples,
+    size_t numSamples,
+    AudioInputStream::Index beginIndex) {
+    m_samples = samples;
+    m_numSamples = numSamples;
+    m_beginIndex = beginIndex;
+
+    if (m_numThreads > 1) {
+        std::lock_guard<std::mutex> lock(m_workMutex);
+        m_pendingWorkers = m_numThreads - 1;
+        ++m_generation;
+        m_workReady.notify_all();
+    }
+    runEngines(0);
+    if (m_numThreads > 1) {
+        std::unique_lock<std::mutex> lock(m_workMutex);
+        m_workDone.wait(lock, [this] { return 0 == m_pendingWorkers; });
+    }
+
+    bool didEngineFail = false;
+    for (auto& result : m_results) {
+        for (auto& detection : result.detections) {
+            notifyKeyWordObservers(m_stream, detection.keyword, detection.beginIndex, detection.endIndex);
+        }
+        didEngineFail |= !result.succeeded;
+    }
+    return !didEngineFail;
+}
+
+void MultiEngineKeywordDetector::workerLoop(size_t worker) {
+    uint64_t generation = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_workMutex);
+            m_workReady.wait(lock, [this, generation] { return m_stopWorkers || m_generation != generation; });
+            if (m_stopWorkers) {
+                return;
+            }
+            generation = m_generation;
+        }
+        runEngines(worker);
+        std::lock_guard<std::mutex> lock(m_workMutex);
+        if (0 == --m_pendingWorkers) {
+            m_workDone.notify_one();
+        }
+    }
+}
+
+void MultiEngineKeywordDetector::runEngines(size_t worker) {
+    for (size_t i = worker; i < m_engines.size(); i += m_numThreads) {
+        auto& result = m_results[i];
+        result.detections.clear();
+        result.succeeded = m_engines[i]->process(m_samples, m_numSamples, m_beginIndex, &result.detections);
+    }
+}
+
+}  // namespace kwd
+}  // namespace alexaClientSDK
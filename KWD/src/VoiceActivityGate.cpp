@@ -0,0 +1,190 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "KWD/VoiceActivityGate.h"
+
+namespace alexaClientSDK {
+namespace kwd {
+
+using namespace avsCommon::avs;
+using namespace avsCommon::sdkInterfaces;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("VoiceActivityGate");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The number of samples per millisecond at the 16 kHz rate the detectors expect.
+static const size_t SAMPLES_PER_MS = 16;
+
+const std::chrono::milliseconds VoiceActivityGate::DEFAULT_PRE_ROLL{500};
+const std::chrono::milliseconds VoiceActivityGate::DEFAULT_HANGOVER{500};
+
+/**
+ * Convert a duration to a whole number of frames, rounding up.
+ *
+ * @param duration The duration.
+ * @param frameSize The number of samples per frame.
+ * @return The number of frames.
+ */
+static size_t toFrames(std::chrono::milliseconds duration, size_t frameSize) {
+    return (static_cast<size_t>(duration.count()) * SAMPLES_PER_MS + frameSize - 1) / frameSize;
+}
+
+std::unique_ptr<VoiceActivityGate> VoiceActivityGate::create(
+    std::shared_ptr<VoiceActivityDetectorInterface> voiceActivityDetector,
+    std::chrono::milliseconds preRoll,
+    std::chrono::milliseconds hangover) {
+    if (!voiceActivityDetector) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "nullVoiceActivityDetector"));
+        return nullptr;
+    }
+    auto frameSize = voiceActivityDetector->getFrameSize();
+    if (0 == frameSize) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "invalidFrameSize"));
+        return nullptr;
+    }
+    if (preRoll.count() < 0 || hangover.count() < 0) {
+        ACSDK_ERROR(LX("createFailed")
+                        .d("reason", "negativeDuration")
+                        .d("preRollMs", preRoll.count())
+                        .d("hangoverMs", hangover.count()));
+        return nullptr;
+    }
+    return std::unique_ptr<VoiceActivityGate>(new VoiceActivityGate(
+        voiceActivityDetector, toFrames(preRoll, frameSize), toFrames(hangover, frameSize)));
+}
+
+VoiceActivityGate::VoiceActivityGate(
+    std::shared_ptr<VoiceActivityDetectorInterface> voiceActivityDetector,
+    size_t preRollFrames,
+    size_t hangoverFrames) :
+        m_voiceActivityDetector{voiceActivityDetector},
+        m_frameSize{voiceActivityDetector->getFrameSize()},
+        m_preRollFrames{preRollFrames},
+        m_hangoverFrames{hangoverFrames},
+        m_frameBeginIndex{0},
+        m_nextIndex{0},
+        m_isStarted{false},
+        m_preRoll(preRollFrames * m_frameSize),
+        m_preRollNext{0},
+        m_preRollCount{0},
+        m_isOpen{false},
+        m_silentFrames{0},
+        m_framesProcessed{0},
+        m_framesSkipped{0} {
+    m_frame.reserve(m_frameSize);
+    m_voiceActivityDetector->reset();
+}
+
+void VoiceActivityGate::process(
+    const int16_t* samples,
+    size_t numSamples,
+    AudioInputStream::Index beginIndex,
+    std::vector<Segment>* segments) {
+    segments->clear();
+    m_output.clear();
+    if (m_isStarted && beginIndex != m_nextIndex) {
+        ACSDK_DEBUG(LX("process").d("event", "discontinuity").d("expected", m_nextIndex).d("actual", beginIndex));
+        m_frame.clear();
+        m_preRollCount = 0;
+        m_isOpen = false;
+        m_silentFrames = 0;
+    }
+    m_isStarted = true;
+    m_nextIndex = beginIndex + numSamples;
+
+    size_t offset = 0;
+    while (offset < numSamples) {
+        if (m_frame.empty()) {
+            m_frameBeginIndex = beginIndex + offset;
+        }
+        auto count = std::min(m_frameSize - m_frame.size(), numSamples - offset);
+        m_frame.insert(m_frame.end(), samples + offset, samples + offset + count);
+        offset += count;
+        if (m_frame.size() == m_frameSize) {
+            processFrame(segments);
+            m_frame.clear();
+        }
+    }
+
+    size_t outputOffset = 0;
+    for (auto& segment : *segments) {
+        segment.samples = m_output.data() + outputOffset;
+        outputOffset += segment.numSamples;
+    }
+}
+
+VoiceActivityGate::Statistics VoiceActivityGate::getStatistics() const {
+    return {m_framesProcessed, m_framesSkipped};
+}
+
+void VoiceActivityGate::processFrame(std::vector<Segment>* segments) {
+    ++m_framesProcessed;
+    if (m_voiceActivityDetector->isSpeech(m_frame.data())) {
+        m_silentFrames = 0;
+        if (!m_isOpen) {
+            m_isOpen = true;
+            // Pass on the pre-roll, oldest frame first.
+            auto preRollBeginIndex = m_frameBeginIndex - m_preRollCount * m_frameSize;
+            for (size_t i = 0; i < m_preRollCount; ++i) {
+                auto slot = (m_preRollNext + m_preRollFrames - m_preRollCount + i) % m_preRollFrames;
+                append(
+                    preRollBeginIndex + i * m_frameSize, m_preRoll.data() + slot * m_frameSize, m_frameSize, segments);
+            }
+            m_preRollCount = 0;
+        }
+    } else if (m_isOpen && ++m_silentFrames > m_hangoverFrames) {
+        m_isOpen = false;
+    }
+
+    if (m_isOpen) {
+        append(m_frameBeginIndex, m_frame.data(), m_frame.size(), segments);
+        return;
+    }
+    ++m_framesSkipped;
+    if (m_preRollFrames > 0) {
+        std::copy(m_frame.begin(), m_frame.end(), m_preRoll.begin() + m_preRollNext * m_frameSize);
+        m_preRollNext = (m_preRollNext + 1) % m_preRollFrames;
+        m_preRollCount = std::min(m_preRollCount + 1, m_preRollFrames);
+    }
+}
+
+void VoiceActivityGate::append(
+    AudioInputStream::Index beginIndex,
+    const int16_t* samples,
+    size_t numSamples,
+    std::vector<Segment>* segments) {
+    if (0 == numSamples) {
+        return;
+    }
+    if (segments->empty() || segments->back().beginIndex + segments->back().numSamples != beginIndex) {
+        segments->push_back({beginIndex, nullptr, 0});
+    }
+    m_output.insert(m_output.end(), samples, samples + numSamples);
+    segments->back().numSamples += numSamples;
+}
+
+}  // namespace kwd
+}  // namespace alexaClientSDK
@@ -17,6 +17,7 @@
 #include <gmock/gmock.h>
 
 #include <unordered_set>
+#include <vector>
 
 #include <AVSCommon/Utils/AudioFormat.h>
 #include <AVSCommon/AVS/AudioInputStream.h>
@@ -30,6 +31,10 @@ namespace kwd {
 namespace test {
 
 using ::testing::_;
+using ::testing::ElementsAre;
+using ::testing::Invoke;
+
+using avsCommon::avs::AudioInputStream;
 
 /// A test observer that mocks out the KeyWordObserverInterface##onKeyWordDetected() call.
 class MockKeyWordObserver : public avsCommon::sdkInterfaces::KeyWordObserverInterface {
@@ -52,6 +57,12 @@ public:
                  keyWordDetectorState));
 };
 
+/// A test observer that mocks out the KeywordDetectorAudioObserverInterface##onAudioRead() call.
+class MockAudioObserver : public KeywordDetectorAudioObserverInterface {
+public:
+    MOCK_METHOD3(onAudioRead, void(const int16_t* samples, size_t numSamples, AudioInputStream::Index beginIndex));
+};
+
 /**
  * A mock Keyword Detector that inherits from KeyWordDetector.
  */
@@ -73,6 +84,23 @@ public:
         avsCommon::sdkInterfaces::KeyWordDetectorStateObserverInterface::KeyWordDetectorState state) {
         notifyKeyWordDetectorStateObservers(state);
     };
+
+    /**
+     * Reads from a stream as a detector does.
+     *
+     * @param reader The stream reader.
+     * @param stream The stream.
+     * @param buf The buffer to read into.
+     * @param nWords The number of words to read.
+     * @return The number of words read.
+     */
+    ssize_t read(
+        std::shared_ptr<AudioInputStream::Reader> reader,
+        std::shared_ptr<AudioInputStream> stream,
+        int16_t* buf,
+        size_t nWords) {
+        return readFromStream(reader, stream, buf, nWords, std::chrono::milliseconds(0), nullptr);
+    }
 };
 
 class AbstractKeyWordDetectorTest : public ::testing::Test {
@@ -170,6 +198,43 @@ TEST_F(AbstractKeyWordDetectorTest, testObserversDontGetNotifiedOfSameStateTwice
         avsCommon::sdkInterfaces::KeyWordDetectorStateObserverInterface::KeyWordDetectorState::ACTIVE);
 }
 
+/**
+ * Verify that audio observers are passed each buffer read from the stream with its stream index, and that removed
+ * observers are not.
+ */
+TEST_F(AbstractKeyWordDetectorTest, testAudioObserversSeeAudioRead) {
+    const size_t wordSize = sizeof(int16_t);
+    const size_t maxReaders = 1;
+    auto size = AudioInputStream::calculateBufferSize(16, wordSize, maxReaders);
+    std::shared_ptr<AudioInputStream> stream =
+        AudioInputStream::create(std::make_shared<AudioInputStream::Buffer>(size), wordSize, maxReaders);
+    ASSERT_TRUE(stream);
+    std::shared_ptr<AudioInputStream::Reader> reader =
+        stream->createReader(AudioInputStream::Reader::Policy::NONBLOCKING);
+    auto writer = stream->createWriter(AudioInputStream::Writer::Policy::NONBLOCKABLE);
+    const std::vector<int16_t> samples = {1, 2, 3, 4, 5, 6};
+    ASSERT_EQ(static_cast<ssize_t>(samples.size()), writer->write(samples.data(), samples.size()));
+
+    auto audioObserver = std::make_shared<MockAudioObserver>();
+    detector->addAudioObserver(audioObserver);
+    std::vector<int16_t> seen;
+    EXPECT_CALL(*audioObserver, onAudioRead(_, 4, 0))
+        .WillOnce(Invoke([&seen](const int16_t* samples, size_t numSamples, AudioInputStream::Index beginIndex) {
+            seen.assign(samples, samples + numSamples);
+        }));
+    std::vector<int16_t> buffer(4);
+    ASSERT_EQ(4, detector->read(reader, stream, buffer.data(), buffer.size()));
+    EXPECT_THAT(seen, ElementsAre(1, 2, 3, 4));
+
+    EXPECT_CALL(*audioObserver, onAudioRead(_, 2, 4)).Times(1);
+    ASSERT_EQ(2, detector->read(reader, stream, buffer.data(), buffer.size()));
+
+    detector->removeAudioObserver(audioObserver);
+    ASSERT_EQ(static_cast<ssize_t>(samples.size()), writer->write(samples.data(), samples.size()));
+    EXPECT_CALL(*audioObserver, onAudioRead(_, _, _)).Times(0);
+    ASSERT_EQ(4, detector->read(reader, stream, buffer.data(), buffer.size()));
+}
+
 }  // namespace test
 }  // namespace kwd
 }  // namespace alexaClientSDK
@@ -0,0 +1,384 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <AVSCommon/AVS/AudioInputStream.h>
+#include <AVSCommon/SDKInterfaces/KeyWordDetectorStateObserverInterface.h>
+#include <AVSCommon/SDKInterfaces/KeyWordObserverInterface.h>
+#include <AVSCommon/Utils/AudioFormat.h>
+
+#include "KWD/MultiEngineKeywordDetector.h"
+
+namespace alexaClientSDK {
+namespace kwd {
+namespace test {
+
+using namespace avsCommon::avs;
+using namespace avsCommon::sdkInterfaces;
+using namespace avsCommon::utils;
+
+/// The word size of the stream.
+static const size_t WORD_SIZE = sizeof(int16_t);
+
+/// The number of words in the stream buffer.
+static const size_t BUFFER_WORDS = 16000;
+
+/// Only one reader is allowed, so a detector which opened a reader per engine would fail to start.
+static const size_t MAX_READERS = 1;
+
+/// The number of samples written in each test.
+static const size_t NUM_SAMPLES = 4000;
+
+/// The sample value which the test engines treat as their keyword.
+static const int16_t MARKER = 1000;
+
+/// The frame size of @c MarkerVoiceActivityDetector, which is one millisecond at 16 kHz.
+static const size_t GATE_FRAME_SIZE = 16;
+
+/// How long to wait for the detector to react.
+static const std::chrono::seconds TIMEOUT(5);
+
+/// An engine which records the audio it is given and detects a marker sample.
+class TestEngine : public KeywordEngineInterface {
+public:
+    /**
+     * Constructor.
+     *
+     * @param keyword The keyword to report when @c MARKER is seen.
+     * @param fail Whether @c process() should report an error.
+     */
+    TestEngine(const std::string& keyword, bool fail = false) : m_keyword{keyword}, m_fail{fail}, m_nextIndex{0} {
+    }
+
+    bool process(
+        const int16_t* samples,
+        size_t numSamples,
+        AudioInputStream::Index beginIndex,
+        std::vector<Detection>* detections) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (beginIndex != m_nextIndex) {
+            m_gap = true;
+        }
+        m_samples.insert(m_samples.end(), samples, samples + numSamples);
+        m_nextIndex = beginIndex + numSamples;
+        for (size_t i = 0; i < numSamples; ++i) {
+            if (MARKER == samples[i]) {
+                detections->push_back({m_keyword, KeyWordObserverInterface::UNSPECIFIED_INDEX, beginIndex + i + 1});
+            }
+        }
+        return !m_fail;
+    }
+
+    /// @return The samples processed so far.
+    std::vector<int16_t> getSamples() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_samples;
+    }
+
+    /// @return Whether the engine was given a buffer which did not follow on from the previous one.
+    bool sawGap() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_gap;
+    }
+
+private:
+    /// The keyword to report.
+    const std::string m_keyword;
+
+    /// Whether to report an error.
+    const bool m_fail;
+
+    /// Serializes access to the members below.
+    std::mutex m_mutex;
+
+    /// The samples processed so far.
+    std::vector<int16_t> m_samples;
+
+    /// The index expected for the next buffer.
+    AudioInputStream::Index m_nextIndex;
+
+    /// Whether a buffer did not follow on from the previous one.
+    bool m_gap = false;
+};
+
+/// A detector which classifies a frame as speech if its first sample is @c MARKER.
+class MarkerVoiceActivityDetector : public avsCommon::sdkInterfaces::VoiceActivityDetectorInterface {
+public:
+    size_t getFrameSize() const override {
+        return GATE_FRAME_SIZE;
+    }
+
+    void reset() override {
+    }
+
+    bool isSpeech(const int16_t* frame) override {
+        return MARKER == frame[0];
+    }
+};
+
+/// An observer which records detections and state changes.
+class TestObserver
+        : public KeyWordObserverInterface
+        , public KeyWordDetectorStateObserverInterface {
+public:
+    void onKeyWordDetected(
+        std::shared_ptr<AudioInputStream> stream,
+        std::string keyword,
+        AudioInputStream::Index beginIndex,
+        AudioInputStream::Index endIndex) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_detections.push_back({keyword, beginIndex, endIndex});
+        m_wake.notify_all();
+    }
+
+    void onStateChanged(KeyWordDetectorState state) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_states.push_back(state);
+        m_wake.notify_all();
+    }
+
+    /**
+     * Wait for the detector to report a state.
+     *
+     * @param state The state to wait for.
+     * @return Whether the state was reported before @c TIMEOUT.
+     */
+    bool waitForState(KeyWordDetectorState state) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_wake.wait_for(lock, TIMEOUT, [this, state] {
+            return std::find(m_states.begin(), m_states.end(), state) != m_states.end();
+        });
+    }
+
+    /// @return The detections so far.
+    std::vector<KeywordEngineInterface::Detection> getDetections() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_detections;
+    }
+
+private:
+    /// Serializes access to the members below.
+    std::mutex m_mutex;
+
+    /// Notified on every callback.
+    std::condition_variable m_wake;
+
+    /// The states reported so far.
+    std::vector<KeyWordDetectorState> m_states;
+
+    /// The detections so far.
+    std::vector<KeywordEngineInterface::Detection> m_detections;
+};
+
+class MultiEngineKeywordDetectorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        auto size = AudioInputStream::calculateBufferSize(BUFFER_WORDS, WORD_SIZE, MAX_READERS);
+        m_stream = AudioInputStream::create(std::make_shared<AudioInputStream::Buffer>(size), WORD_SIZE, MAX_READERS);
+        ASSERT_NE(m_stream, nullptr);
+        m_writer = m_stream->createWriter(AudioInputStream::Writer::Policy::NONBLOCKABLE);
+        ASSERT_NE(m_writer, nullptr);
+        m_observer = std::make_shared<TestObserver>();
+
+        m_format.encoding = AudioFormat::Encoding::LPCM;
+        m_format.endianness = AudioFormat::Endianness::LITTLE;
+        m_format.sampleRateHz = 16000;
+        m_format.sampleSizeInBits = 16;
+        m_format.numChannels = 1;
+        m_format.dataSigned = true;
+        m_format.layout = AudioFormat::Layout::INTERLEAVED;
+
+        m_samples.resize(NUM_SAMPLES);
+        for (size_t i = 0; i < m_samples.size(); ++i) {
+            m_samples[i] = static_cast<int16_t>(i % MARKER);
+        }
+    }
+
+    /**
+     * Create a detector over the test stream.
+     *
+     * @param engines The engines to run.
+     * @param numThreads The number of threads to run them on.
+     * @return The detector.
+     */
+    std::unique_ptr<MultiEngineKeywordDetector> createDetector(
+        std::vector<std::shared_ptr<KeywordEngineInterface>> engines,
+        size_t numThreads,
+        std::shared_ptr<VoiceActivityGate> voiceActivityGate = nullptr) {
+        return MultiEngineKeywordDetector::create(
+            m_stream,
+            m_format,
+            {m_observer},
+            {m_observer},
+            engines,
+            numThreads,
+            std::chrono::milliseconds(20),
+            voiceActivityGate);
+    }
+
+    /**
+     * Write the test samples and close the stream.
+     */
+    void writeAndClose() {
+        ASSERT_EQ(m_writer->write(m_samples.data(), m_samples.size()), static_cast<ssize_t>(m_samples.size()));
+        m_writer->close();
+    }
+
+    /// The stream the detectors read.
+    std::shared_ptr<AudioInputStream> m_stream;
+
+    /// The writer of @c m_stream.
+    std::shared_ptr<AudioInputStream::Writer> m_writer;
+
+    /// The observer of keywords and states.
+    std::shared_ptr<TestObserver> m_observer;
+
+    /// The format of @c m_stream.
+    AudioFormat m_format;
+
+    /// The samples written to @c m_stream.
+    std::vector<int16_t> m_samples;
+};
+
+/**
+ * Verify that creation fails without a stream or engines, or with a format the detector cannot hand to engines.
+ */
+TEST_F(MultiEngineKeywordDetectorTest, createFailsWithInvalidParameters) {
+    auto engine = std::make_shared<TestEngine>("ALEXA");
+    EXPECT_EQ(MultiEngineKeywordDetector::create(nullptr, m_format, {}, {}, {engine}), nullptr);
+    EXPECT_EQ(createDetector({}, 1), nullptr);
+    EXPECT_EQ(createDetector({nullptr}, 1), nullptr);
+
+    m_format.encoding = AudioFormat::Encoding::OPUS;
+    EXPECT_EQ(createDetector({engine}, 1), nullptr);
+}
+
+/**
+ * Verify that several engines share one reader and each sees the whole stream in order, for both one thread and one
+ * thread per engine.
+ */
+TEST_F(MultiEngineKeywordDetectorTest, enginesShareOneReader) {
+    for (size_t numThreads : {1, 3}) {
+        SetUp();
+        std::vector<std::shared_ptr<TestEngine>> engines = {std::make_shared<TestEngine>("ALEXA"),
+                                                            std::make_shared<TestEngine>("COMPUTER"),
+                                                            std::make_shared<TestEngine>("ECHO")};
+        auto detector = createDetector({engines.begin(), engines.end()}, numThreads);
+        ASSERT_NE(detector, nullptr);
+
+        writeAndClose();
+        ASSERT_TRUE(
+            m_observer->waitForState(KeyWordDetectorStateObserverInterface::KeyWordDetectorState::STREAM_CLOSED));
+
+        for (auto& engine : engines) {
+            EXPECT_EQ(engine->getSamples(), m_samples);
+            EXPECT_FALSE(engine->sawGap());
+        }
+    }
+}
+
+/**
+ * Verify that detections from all engines are reported with absolute stream indices, in engine order.
+ */
+TEST_F(MultiEngineKeywordDetectorTest, detectionsUseStreamIndices) {
+    // Start the stream part way through so that indices relative to the reader would differ from absolute ones.
+    std::vector<int16_t> lead(NUM_SAMPLES / 2);
+    ASSERT_EQ(m_writer->write(lead.data(), lead.size()), static_cast<ssize_t>(lead.size()));
+
+    auto detector = createDetector({std::make_shared<TestEngine>("ALEXA"), std::make_shared<TestEngine>("ECHO")}, 2);
+    ASSERT_NE(detector, nullptr);
+    m_samples[NUM_SAMPLES / 4] = MARKER;
+    writeAndClose();
+    ASSERT_TRUE(m_observer->waitForState(KeyWordDetectorStateObserverInterface::KeyWordDetectorState::STREAM_CLOSED));
+
+    // The marker's absolute index includes the lead-in, whichever sample the reader started at.
+    auto detections = m_observer->getDetections();
+    ASSERT_EQ(detections.size(), 2u);
+    EXPECT_EQ(detections[0].keyword, "ALEXA");
+    EXPECT_EQ(detections[1].keyword, "ECHO");
+    for (auto& detection : detections) {
+        EXPECT_TRUE(KeyWordObserverInterface::UNSPECIFIED_INDEX == detection.beginIndex);
+        EXPECT_EQ(detection.endIndex, lead.size() + NUM_SAMPLES / 4 + 1);
+    }
+}
+
+/**
+ * Verify that with a @c VoiceActivityGate the engines only see speech, with its pre-roll and hangover, at its stream
+ * index.
+ */
+TEST_F(MultiEngineKeywordDetectorTest, voiceActivityGateSkipsSilence) {
+    std::shared_ptr<VoiceActivityGate> gate = VoiceActivityGate::create(
+        std::make_shared<MarkerVoiceActivityDetector>(), std::chrono::milliseconds(1), std::chrono::milliseconds(1));
+    ASSERT_NE(gate, nullptr);
+    auto engine = std::make_shared<TestEngine>("ALEXA");
+    auto detector = createDetector({engine}, 1, gate);
+    ASSERT_NE(detector, nullptr);
+
+    // One frame of speech in the middle of the stream.
+    const size_t speechFrame = NUM_SAMPLES / GATE_FRAME_SIZE / 2;
+    m_samples.assign(NUM_SAMPLES, 0);
+    std::fill(
+        m_samples.begin() + speechFrame * GATE_FRAME_SIZE,
+        m_samples.begin() + (speechFrame + 1) * GATE_FRAME_SIZE,
+        MARKER);
+    writeAndClose();
+    ASSERT_TRUE(m_observer->waitForState(KeyWordDetectorStateObserverInterface::KeyWordDetectorState::STREAM_CLOSED));
+
+    // One frame each of pre-roll, speech and hangover.
+    EXPECT_EQ(
+        engine->getSamples(),
+        std::vector<int16_t>(
+            m_samples.begin() + (speechFrame - 1) * GATE_FRAME_SIZE,
+            m_samples.begin() + (speechFrame + 2) * GATE_FRAME_SIZE));
+    auto detections = m_observer->getDetections();
+    ASSERT_FALSE(detections.empty());
+    EXPECT_EQ(detections[0].endIndex, speechFrame * GATE_FRAME_SIZE + 1);
+
+    auto statistics = gate->getStatistics();
+    EXPECT_EQ(statistics.framesProcessed, NUM_SAMPLES / GATE_FRAME_SIZE);
+    EXPECT_EQ(statistics.framesSkipped, NUM_SAMPLES / GATE_FRAME_SIZE - 2);
+}
+
+/**
+ * Verify that a gate is rejected for audio it cannot classify.
+ */
+TEST_F(MultiEngineKeywordDetectorTest, voiceActivityGateRequiresMonoAudio) {
+    std::shared_ptr<VoiceActivityGate> gate = VoiceActivityGate::create(std::make_shared<MarkerVoiceActivityDetector>());
+    ASSERT_NE(gate, nullptr);
+    m_format.numChannels = 2;
+    EXPECT_EQ(createDetector({std::make_shared<TestEngine>("ALEXA")}, 1, gate), nullptr);
+}
+
+/**
+ * Verify that an engine error stops detection and is reported to observers.
+ */
+TEST_F(MultiEngineKeywordDetectorTest, engineErrorStopsDetection) {
+    auto detector =
+        createDetector({std::make_shared<TestEngine>("ALEXA"), std::make_shared<TestEngine>("ECHO", true)}, 2);
+    ASSERT_NE(detector, nullptr);
+    writeAndClose();
+    EXPECT_TRUE(m_observer->waitForState(KeyWordDetectorStateObserverInterface::KeyWordDetectorState::ERROR));
+}
+
+}  // namespace test
+}  // namespace kwd
+}  // namespace alexaClientSDK
@@ -0,0 +1,313 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <AVSCommon/AVS/EnergyVoiceActivityDetector.h>
+
+#include "KWD/VoiceActivityGate.h"
+
+namespace alexaClientSDK {
+namespace kwd {
+namespace test {
+
+using namespace avsCommon::avs;
+using namespace avsCommon::sdkInterfaces;
+
+/// The path to the inputs folder that should be passed in via command line argument.
+std::string inputsDirPath;
+
+/// The frame size of the scripted detector, which is one millisecond at 16 kHz.
+static const size_t FRAME_SIZE = 16;
+
+/// The pre-roll used in the unit tests, which is two scripted frames.
+static const std::chrono::milliseconds PRE_ROLL{2};
+
+/// The hangover used in the unit tests, which is three scripted frames.
+static const std::chrono::milliseconds HANGOVER{3};
+
+/// The number of samples per millisecond in the recorded audio.
+static const size_t SAMPLES_PER_MS = 16;
+
+/// The size of the RIFF header of the recorded audio.
+static const size_t RIFF_HEADER_SIZE = 44;
+
+/// How much audio before the end of a keyword an engine needs to detect it.
+static const std::chrono::milliseconds KEYWORD_WINDOW{800};
+
+/// The margin on the approximate end indices of the keywords.
+static const std::chrono::milliseconds MARGIN{100};
+
+/// A recording and the approximate end indices of the "Alexa" keywords in it.
+struct Recording {
+    /// The name of the file in the inputs folder.
+    std::string fileName;
+
+    /// The approximate end indices of the keywords.
+    std::vector<AudioInputStream::Index> keywordEndIndices;
+};
+
+/// The recordings used for the false-reject evaluation.
+static const std::vector<Recording> RECORDINGS = {{"/four_alexa.wav", {21440, 52800, 72480, 91552}},
+                                                  {"/alexa_stop_alexa_joke.wav", {20960, 51312}}};
+
+/// A copy of the audio which passed the gate, gathered across calls to @c VoiceActivityGate::process().
+struct PassedAudio {
+    /// The absolute index in the stream of the first sample.
+    AudioInputStream::Index beginIndex;
+
+    /// The samples.
+    std::vector<int16_t> samples;
+};
+
+/// A detector which classifies a frame as speech if its first sample is non-zero.
+class ScriptedVoiceActivityDetector : public VoiceActivityDetectorInterface {
+public:
+    size_t getFrameSize() const override {
+        return FRAME_SIZE;
+    }
+
+    void reset() override {
+    }
+
+    bool isSpeech(const int16_t* frame) override {
+        return frame[0] != 0;
+    }
+};
+
+/**
+ * Build audio for the scripted detector from a pattern of speech ('s') and silence ('-') frames.  Each sample holds
+ * its frame's number, plus one, for speech frames, so that the test can tell which frames were passed on.
+ *
+ * @param pattern The pattern of frames.
+ * @return The audio.
+ */
+static std::vector<int16_t> makeAudio(const std::string& pattern) {
+    std::vector<int16_t> audio;
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        audio.insert(audio.end(), FRAME_SIZE, 's' == pattern[i] ? static_cast<int16_t>(i + 1) : 0);
+    }
+    return audio;
+}
+
+/**
+ * Read the samples of a recording.
+ *
+ * @param fileName The path to the file.
+ * @param[out] samples The samples read from the file.
+ * @return @c true if the file was read, else @c false.
+ */
+static bool readAudioFromFile(const std::string& fileName, std::vector<int16_t>* samples) {
+    std::ifstream inputFile(fileName.c_str(), std::ifstream::binary);
+    if (!inputFile.good()) {
+        return false;
+    }
+    inputFile.seekg(0, std::ios::end);
+    size_t fileLengthInBytes = inputFile.tellg();
+    if (fileLengthInBytes <= RIFF_HEADER_SIZE) {
+        return false;
+    }
+    inputFile.seekg(RIFF_HEADER_SIZE, std::ios::beg);
+    samples->resize((fileLengthInBytes - RIFF_HEADER_SIZE) / sizeof(int16_t));
+    inputFile.read(reinterpret_cast<char*>(samples->data()), samples->size() * sizeof(int16_t));
+    return inputFile.gcount() == static_cast<std::streamsize>(samples->size() * sizeof(int16_t));
+}
+
+class VoiceActivityGateTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        m_gate = VoiceActivityGate::create(std::make_shared<ScriptedVoiceActivityDetector>(), PRE_ROLL, HANGOVER);
+        ASSERT_NE(m_gate, nullptr);
+    }
+
+    /**
+     * Pass audio through the gate in buffers of the given size.
+     *
+     * @param audio The audio.
+     * @param bufferSize The number of samples per call to @c process().
+     * @param beginIndex The stream index of the first sample.
+     * @return The audio which passed the gate, with contiguous segments merged across calls.
+     */
+    std::vector<PassedAudio> run(
+        const std::vector<int16_t>& audio,
+        size_t bufferSize,
+        AudioInputStream::Index beginIndex = 0) {
+        std::vector<PassedAudio> passed;
+        std::vector<VoiceActivityGate::Segment> segments;
+        for (size_t offset = 0; offset < audio.size(); offset += bufferSize) {
+            m_gate->process(
+                audio.data() + offset, std::min(bufferSize, audio.size() - offset), beginIndex + offset, &segments);
+            for (const auto& segment : segments) {
+                if (passed.empty() || passed.back().beginIndex + passed.back().samples.size() != segment.beginIndex) {
+                    passed.push_back({segment.beginIndex, {}});
+                }
+                passed.back().samples.insert(
+                    passed.back().samples.end(), segment.samples, segment.samples + segment.numSamples);
+            }
+        }
+        return passed;
+    }
+
+    /// The gate under test.
+    std::unique_ptr<VoiceActivityGate> m_gate;
+};
+
+/**
+ * Verify that creation fails without a detector or with negative durations.
+ */
+TEST_F(VoiceActivityGateTest, createFailsWithInvalidParameters) {
+    EXPECT_EQ(VoiceActivityGate::create(nullptr), nullptr);
+    auto detector = std::make_shared<ScriptedVoiceActivityDetector>();
+    EXPECT_EQ(VoiceActivityGate::create(detector, std::chrono::milliseconds(-1)), nullptr);
+    EXPECT_EQ(VoiceActivityGate::create(detector, PRE_ROLL, std::chrono::milliseconds(-1)), nullptr);
+}
+
+/**
+ * Verify that silence is skipped and counted.
+ */
+TEST_F(VoiceActivityGateTest, skipsSilence) {
+    EXPECT_TRUE(run(makeAudio("----------"), FRAME_SIZE).empty());
+    auto statistics = m_gate->getStatistics();
+    EXPECT_EQ(statistics.framesProcessed, 10u);
+    EXPECT_EQ(statistics.framesSkipped, 10u);
+}
+
+/**
+ * Verify that speech is passed on with its pre-roll and hangover as one segment with the right stream index, however
+ * the audio is split into buffers.
+ */
+TEST_F(VoiceActivityGateTest, passesSpeechWithPreRollAndHangover) {
+    auto audio = makeAudio("-----sss-s------");
+    for (size_t bufferSize : {FRAME_SIZE, FRAME_SIZE * 3, static_cast<size_t>(7), audio.size()}) {
+        SetUp();
+        auto segments = run(audio, bufferSize, 1000);
+        ASSERT_EQ(segments.size(), 1u) << bufferSize;
+        // Two frames of pre-roll, five of speech and pause, three of hangover.
+        EXPECT_EQ(segments[0].beginIndex, 1000 + 3 * FRAME_SIZE) << bufferSize;
+        EXPECT_EQ(
+            segments[0].samples,
+            std::vector<int16_t>(audio.begin() + 3 * FRAME_SIZE, audio.begin() + 13 * FRAME_SIZE))
+            << bufferSize;
+        auto statistics = m_gate->getStatistics();
+        EXPECT_EQ(statistics.framesProcessed, 16u);
+        EXPECT_EQ(statistics.framesSkipped, 8u);
+    }
+}
+
+/**
+ * Verify that when speech starts before the pre-roll has filled up, only the audio which was seen is passed on.
+ */
+TEST_F(VoiceActivityGateTest, passesPartialPreRoll) {
+    auto audio = makeAudio("-s");
+    auto passed = run(audio, audio.size());
+    ASSERT_EQ(passed.size(), 1u);
+    EXPECT_EQ(passed[0].beginIndex, 0u);
+    EXPECT_EQ(passed[0].samples, audio);
+}
+
+/**
+ * Verify that speech separated by more than the hangover produces separate segments, and that pre-roll never repeats
+ * audio which was already passed on.
+ */
+TEST_F(VoiceActivityGateTest, separatesUtterances) {
+    auto audio = makeAudio("s--------s");
+    auto segments = run(audio, audio.size());
+    ASSERT_EQ(segments.size(), 2u);
+    EXPECT_EQ(segments[0].beginIndex, 0u);
+    EXPECT_EQ(segments[0].samples.size(), 4 * FRAME_SIZE);
+    EXPECT_EQ(segments[1].beginIndex, 7 * FRAME_SIZE);
+    EXPECT_EQ(segments[1].samples.size(), 3 * FRAME_SIZE);
+}
+
+/**
+ * Verify that a jump in the stream discards held audio rather than passing it on as pre-roll for later speech.
+ */
+TEST_F(VoiceActivityGateTest, discontinuityDiscardsPreRoll) {
+    std::vector<VoiceActivityGate::Segment> segments;
+    auto silence = makeAudio("---");
+    m_gate->process(silence.data(), silence.size(), 0, &segments);
+    EXPECT_TRUE(segments.empty());
+    auto speech = makeAudio("s");
+    m_gate->process(speech.data(), speech.size(), 100 * FRAME_SIZE, &segments);
+    ASSERT_EQ(segments.size(), 1u);
+    EXPECT_EQ(segments[0].beginIndex, 100 * FRAME_SIZE);
+    EXPECT_EQ(std::vector<int16_t>(segments[0].samples, segments[0].samples + segments[0].numSamples), speech);
+}
+
+/**
+ * False-reject evaluation over the recordings in the inputs folder, using the energy detector and the default pre-roll
+ * and hangover.  A keyword is rejected if any audio was skipped from @c KEYWORD_WINDOW before its end to @c MARGIN
+ * after it, since an engine needs both the keyword and the audio up to the point where it reports it.  For each file
+ * this prints the number of keywords, how many were rejected, and the fraction of frames skipped.
+ */
+TEST_F(VoiceActivityGateTest, evaluateFalseRejectsOverInputs) {
+    std::cout << std::left << std::setw(32) << "file" << std::right << std::setw(10) << "audioMs" << std::setw(10)
+              << "keywords" << std::setw(10) << "rejected" << std::setw(12) << "skipped%" << std::endl;
+
+    for (const auto& recording : RECORDINGS) {
+        std::vector<int16_t> samples;
+        auto path = inputsDirPath + recording.fileName;
+        ASSERT_TRUE(readAudioFromFile(path, &samples)) << "Unable to read " << path;
+
+        auto gate = VoiceActivityGate::create(std::make_shared<EnergyVoiceActivityDetector>());
+        ASSERT_NE(gate, nullptr);
+        std::vector<VoiceActivityGate::Segment> segments;
+        gate->process(samples.data(), samples.size(), 0, &segments);
+
+        std::vector<bool> passed(samples.size(), false);
+        for (const auto& segment : segments) {
+            std::fill(
+                passed.begin() + segment.beginIndex, passed.begin() + segment.beginIndex + segment.numSamples, true);
+        }
+
+        size_t rejected = 0;
+        for (auto end : recording.keywordEndIndices) {
+            auto windowEnd = std::min<size_t>(end + MARGIN.count() * SAMPLES_PER_MS, samples.size());
+            auto windowBegin = end - std::min<size_t>(end, KEYWORD_WINDOW.count() * SAMPLES_PER_MS);
+            if (std::find(passed.begin() + windowBegin, passed.begin() + windowEnd, false) !=
+                passed.begin() + windowEnd) {
+                ++rejected;
+            }
+        }
+
+        auto statistics = gate->getStatistics();
+        std::cout << std::left << std::setw(32) << recording.fileName << std::right << std::setw(10)
+                  << samples.size() / SAMPLES_PER_MS << std::setw(10) << recording.keywordEndIndices.size()
+                  << std::setw(10) << rejected << std::setw(12) << std::fixed << std::setprecision(1)
+                  << 100.0 * statistics.framesSkipped / statistics.framesProcessed << std::endl;
+        EXPECT_EQ(rejected, 0u) << recording.fileName;
+    }
+}
+
+}  // namespace test
+}  // namespace kwd
+}  // namespace alexaClientSDK
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    if (argc < 2) {
+        std::cerr << "USAGE: " << std::string(argv[0]) << " <path_to_inputs_folder>" << std::endl;
+        return 1;
+    } else {
+        alexaClientSDK::kwd::test::inputsDirPath = std::string(argv[1]);
+        return RUN_ALL_TESTS();
+    }
+}
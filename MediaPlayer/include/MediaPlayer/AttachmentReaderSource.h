@@ -17,6 +17,7 @@
 #define ALEXA_CLIENT_SDK_MEDIAPLAYER_INCLUDE_MEDIAPLAYER_ATTACHMENTREADERSOURCE_H_
 
 #include <memory>
+#include <vector>
 
 #include <gst/gst.h>
 #include <gst/app/gstappsrc.h>
@@ -67,8 +68,26 @@ private:
     void close() override;
     gboolean handleReadData() override;
     gboolean handleSeekData(guint64 offset) override;
+    bool setDataAvailableCallback(std::function<void()> callback) override;
     /// @}
 
+    /**
+     * Get an empty buffer from the pool of the smallest buffers with room for @c size bytes, or allocate one if that
+     * pool is not available.
+     *
+     * @param size The number of bytes to be read into the buffer, which is at most @c MAX_CHUNK_SIZE.
+     * @return A new buffer, or @c nullptr if none could be allocated.
+     */
+    GstBuffer* acquireBuffer(size_t size);
+
+    /**
+     * Work out how many bytes to read next.  Reads are sized to what is already waiting in the attachment, so
+     * buffered data is pushed in a few large chunks while data near the live edge is pushed as soon as it arrives.
+     *
+     * @return The number of bytes to read.
+     */
+    size_t getChunkSize();
+
     /// @name RequiresShutdown Functions
     /// @{
     void doShutdown() override{};
@@ -77,6 +96,13 @@ private:
 private:
     /// The @c AttachmentReader to read audioData from.
     std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> m_reader;
+
+    /**
+     * Pools of buffers to read into, so each read does not allocate, in order of buffer size.  Each read uses the
+     * smallest buffers which fit it, so buffers queued in the pipeline do not take up much more memory than the data
+     * they hold.  A pool may be @c nullptr if it failed to start.
+     */
+    std::vector<GstBufferPool*> m_bufferPools;
 };
 
 }  // namespace mediaPlayer
@@ -16,7 +16,10 @@
 #ifndef ALEXA_CLIENT_SDK_MEDIAPLAYER_INCLUDE_MEDIAPLAYER_BASESTREAMSOURCE_H_
 #define ALEXA_CLIENT_SDK_MEDIAPLAYER_INCLUDE_MEDIAPLAYER_BASESTREAMSOURCE_H_
 
+#include <atomic>
+#include <functional>
 #include <memory>
+#include <mutex>
 
 #include <gst/gst.h>
 #include <gst/app/gstappsrc.h>
@@ -82,6 +85,17 @@ protected:
      */
     virtual gboolean handleSeekData(guint64 offset) = 0;
 
+    /**
+     * Set a function to be called, on any thread, whenever data is added to this instance or it is closed.  Sources
+     * which can't report this keep the default implementation, in which case reads are retried at increasing
+     * intervals instead.  Subclasses overriding this must set it back to @c nullptr before the state it uses is
+     * released, and must not call the function once that has returned.
+     *
+     * @param callback The function to call, or @c nullptr to stop calling it.
+     * @return Whether @c callback will be called.
+     */
+    virtual bool setDataAvailableCallback(std::function<void()> callback);
+
     /**
      * Get the AppSrc to which this instance should feed audio data.
      *
@@ -100,7 +114,9 @@ protected:
     void installOnReadDataHandler();
 
     /**
-     * Update when to call @c onReadData() handler based upon the number of retries since data was last read.
+     * Update when to call @c onReadData() handler after a read found no data.  If this source reports when data
+     * arrives, the handler is uninstalled and reinstalled by @c m_dataAvailableSource once it does.  Otherwise, it is
+     * rescheduled based upon the number of retries since data was last read.
      */
     void updateOnReadDataHandler();
 
@@ -157,6 +173,32 @@ private:
      */
     static gboolean onReadData(gpointer source);
 
+    /**
+     * Create @c m_dataAvailableSource and attach it to the main loop, if this source reports when data arrives.
+     */
+    void createDataAvailableSource();
+
+    /**
+     * Called by this source, on any thread, when data arrives.  Wakes @c m_dataAvailableSource if the @c onReadData()
+     * handler is waiting for data.
+     */
+    void onDataAvailable();
+
+    /**
+     * The callback of @c m_dataAvailableSource.
+     *
+     * @param source The instance to which data has been added.
+     * @return @c true always, to keep @c m_dataAvailableSource attached.
+     */
+    static gboolean onDataAvailableDispatch(gpointer source);
+
+    /**
+     * Reinstalls the @c onReadData() handler once data has arrived, if the appsrc element still needs data.
+     *
+     * @return @c true always.
+     */
+    gboolean handleDataAvailable();
+
     /// The @c PipelineInterface through which the source of the @c AudioPipeline may be set.
     PipelineInterface* m_pipeline;
 
@@ -172,6 +214,10 @@ private:
     /// Function to invoke on the worker thread thread when there is enough data.
     const std::function<gboolean()> m_handleEnoughDataFunction;
 
+    /// Whether the appsrc element has asked for data and not yet reported it has enough.  Only accessed on the
+    /// worker thread.
+    bool m_needsData;
+
     /// ID of the handler installed to receive need data signals.
     guint m_needDataHandlerId;
 
@@ -189,6 +235,15 @@ private:
 
     /// ID of idle callback to handle enough data.
     guint m_enoughDataCallbackId;
+
+    /**
+     * A source attached to the main loop which dispatches @c handleDataAvailable() when it is made ready by
+     * @c onDataAvailable(), or @c nullptr if this source does not report when data arrives.
+     */
+    GSource* m_dataAvailableSource;
+
+    /// Whether the @c onReadData() handler is, or is about to be, uninstalled until data arrives.
+    std::atomic<bool> m_isWaitingForData;
 };
 
 }  // namespace mediaPlayer
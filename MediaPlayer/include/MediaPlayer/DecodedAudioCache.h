@@ -0,0 +1,184 @@
+/*
+ * Copyright 2017-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_MEDIAPLAYER_INCLUDE_MEDIAPLAYER_DECODEDAUDIOCACHE_H_
+#define ALEXA_CLIENT_SDK_MEDIAPLAYER_INCLUDE_MEDIAPLAYER_DECODEDAUDIOCACHE_H_
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <AVSCommon/Utils/AudioFormat.h>
+#include <AVSCommon/Utils/Threading/Executor.h>
+
+namespace alexaClientSDK {
+namespace mediaPlayer {
+
+/// Raw PCM audio along with the format needed to play it.
+struct DecodedAudio {
+    /// The format of @c pcm.
+    avsCommon::utils::AudioFormat format;
+
+    /// The decoded samples.
+    std::vector<unsigned char> pcm;
+};
+
+/**
+ * A cache of decoded PCM for short encoded sounds, such as alert and notification tones, which are played over and
+ * over from the same bytes.  Entries are keyed by an identifier of the resource supplied by the caller, so every
+ * stream of the same resource shares one entry, and the least recently used entries are evicted to keep the total
+ * PCM size within a byte limit.  Sounds without an identifier can be keyed by their content with @c buildContentKey().
+ *
+ * A lookup that misses reads the encoded bytes once, schedules the sound to be decoded on a worker thread and returns
+ * straight away, so the first play of a sound is never delayed by decoding.  Later plays are served from the cached
+ * PCM without reading the encoded bytes at all.
+ */
+class DecodedAudioCache {
+public:
+    /**
+     * A function which decodes a whole encoded sound.
+     *
+     * @param encoded The encoded bytes.
+     * @return The decoded audio, or @c nullptr if it could not be decoded.
+     */
+    using Decoder = std::function<std::shared_ptr<const DecodedAudio>(const std::string& encoded)>;
+
+    /**
+     * A function which reads the whole encoded sound for a lookup that needs to decode it.
+     *
+     * @return The encoded bytes, or an empty string if they can't be read or are too large to cache.
+     */
+    using EncodedReader = std::function<std::string()>;
+
+    /**
+     * Get the cache shared by every @c MediaPlayer, creating it if no player currently holds it.  Sounds are decoded
+     * with GStreamer.
+     *
+     * @param maxBytes The maximum total size of the cached PCM, used if the cache is created by this call.
+     * @return The shared cache.
+     */
+    static std::shared_ptr<DecodedAudioCache> acquire(size_t maxBytes);
+
+    /**
+     * Create a cache.
+     *
+     * @param maxBytes The maximum total size of the cached PCM.
+     * @param decoder The function used to decode sounds that are not cached yet.
+     * @return The new cache, or @c nullptr if the parameters are invalid.
+     */
+    static std::shared_ptr<DecodedAudioCache> create(size_t maxBytes, Decoder decoder);
+
+    /**
+     * Look up the decoded audio for a sound.  If it is not cached, and the sound is neither being decoded already nor
+     * known not to fit, its encoded bytes are read with @c readEncoded, decoding is scheduled and @c nullptr is
+     * returned.
+     *
+     * @param key The identifier of the sound.
+     * @param readEncoded The function which reads the encoded bytes of the sound.  It is only called on a miss.
+     * @return The decoded audio, or @c nullptr on a miss.
+     */
+    std::shared_ptr<const DecodedAudio> get(const std::string& key, const EncodedReader& readEncoded);
+
+    /**
+     * Build the key for a sound which has no identifier of its own from its encoded bytes.
+     *
+     * @param encoded The encoded bytes.
+     * @return The key.
+     */
+    static std::string buildContentKey(const std::string& encoded);
+
+    /**
+     * Block until every decode scheduled so far has finished.
+     */
+    void waitForPendingDecodes();
+
+    /**
+     * Get the total size of the cached PCM.
+     *
+     * @return The total size in bytes.
+     */
+    size_t getCachedBytes() const;
+
+    /**
+     * Get the maximum total size of the cached PCM.
+     *
+     * @return The maximum size in bytes.
+     */
+    size_t getMaxBytes() const;
+
+private:
+    /// An entry in the cache.
+    struct Entry {
+        /// The key of this entry in @c m_entries.
+        std::string key;
+
+        /// The decoded audio.
+        std::shared_ptr<const DecodedAudio> audio;
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param maxBytes The maximum total size of the cached PCM.
+     * @param decoder The function used to decode sounds that are not cached yet.
+     */
+    DecodedAudioCache(size_t maxBytes, Decoder decoder);
+
+    /**
+     * Decode a sound on the worker thread and add it to the cache.
+     *
+     * @param key The key of the sound.
+     * @param encoded The encoded bytes.
+     */
+    void executeDecode(const std::string& key, const std::string& encoded);
+
+    /// The maximum total size of the cached PCM.
+    const size_t m_maxBytes;
+
+    /// The function used to decode sounds.
+    const Decoder m_decoder;
+
+    /// Serializes access to the members below.
+    mutable std::mutex m_mutex;
+
+    /// The cached entries, most recently used first.
+    std::list<Entry> m_lru;
+
+    /// Map from key to entry in @c m_lru.
+    std::unordered_map<std::string, std::list<Entry>::iterator> m_entries;
+
+    /// Keys of sounds being decoded.
+    std::unordered_set<std::string> m_pending;
+
+    /// Keys of sounds which could not be read, failed to decode or are too large to cache, so they are not retried.
+    std::unordered_set<std::string> m_uncacheable;
+
+    /// The total size of the PCM in @c m_lru.
+    size_t m_cachedBytes;
+
+    /// Worker thread on which sounds are decoded.  This is declared last so that it is shut down first.
+    avsCommon::utils::threading::Executor m_executor;
+};
+
+}  // namespace mediaPlayer
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_MEDIAPLAYER_INCLUDE_MEDIAPLAYER_DECODEDAUDIOCACHE_H_
@@ -0,0 +1,103 @@
+/*
+ * Copyright 2017-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_MEDIAPLAYER_INCLUDE_MEDIAPLAYER_DECODEDAUDIOSOURCE_H_
+#define ALEXA_CLIENT_SDK_MEDIAPLAYER_INCLUDE_MEDIAPLAYER_DECODEDAUDIOSOURCE_H_
+
+#include <memory>
+
+#include <gst/gst.h>
+#include <gst/app/gstappsrc.h>
+
+#include "MediaPlayer/BaseStreamSource.h"
+#include "MediaPlayer/DecodedAudioCache.h"
+
+namespace alexaClientSDK {
+namespace mediaPlayer {
+
+/**
+ * A source which plays already decoded PCM, typically from the @c DecodedAudioCache.  The PCM is pushed to the
+ * pipeline with raw caps, so no decoder is plugged in, and each buffer wraps the shared PCM rather than copying it.
+ */
+class DecodedAudioSource : public BaseStreamSource {
+public:
+    /**
+     * Create a DecodedAudioSource.
+     *
+     * @param pipeline The @c PipelineInterface through which the source of the @c AudioPipeline may be set.
+     * @param audio The decoded audio to play.
+     * @param repeat Whether the audio should be replayed until stopped.
+     * @return The new source, or @c nullptr if it could not be created.
+     */
+    static std::unique_ptr<DecodedAudioSource> create(
+        PipelineInterface* pipeline,
+        std::shared_ptr<const DecodedAudio> audio,
+        bool repeat);
+
+    /**
+     * Destructor.
+     */
+    ~DecodedAudioSource() override;
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param pipeline The @c PipelineInterface through which the source of the @c AudioPipeline may be set.
+     * @param audio The decoded audio to play.
+     * @param repeat Whether the audio should be replayed until stopped.
+     */
+    DecodedAudioSource(PipelineInterface* pipeline, std::shared_ptr<const DecodedAudio> audio, bool repeat);
+
+    /**
+     * Release the reference to the decoded audio held by a pushed buffer.
+     *
+     * @param pointer The @c std::shared_ptr<const DecodedAudio> allocated when the buffer was created.
+     */
+    static void releaseAudio(gpointer pointer);
+
+    /// @name Overridden SourceInterface methods.
+    /// @{
+    bool isPlaybackRemote() const override;
+    bool hasAdditionalData() override;
+    /// @}
+
+    /// @name RequiresShutdown Functions
+    /// @{
+    void doShutdown() override{};
+    /// @}
+
+    /// @name Overridden BaseStreamSource methods.
+    /// @{
+    bool isOpen() override;
+    void close() override;
+    gboolean handleReadData() override;
+    gboolean handleSeekData(guint64 offset) override;
+    /// @}
+
+    /// The decoded audio to play.
+    std::shared_ptr<const DecodedAudio> m_audio;
+
+    /// Play the audio over and over until told to stop.
+    bool m_repeat;
+
+    /// The offset in @c m_audio of the next byte to push.
+    size_t m_offset;
+};
+
+}  // namespace mediaPlayer
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_MEDIAPLAYER_INCLUDE_MEDIAPLAYER_DECODEDAUDIOSOURCE_H_
@@ -0,0 +1,39 @@
+/*
+ * Copyright 2017-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_MEDIAPLAYER_INCLUDE_MEDIAPLAYER_GSTREAMERAUDIODECODER_H_
+#define ALEXA_CLIENT_SDK_MEDIAPLAYER_INCLUDE_MEDIAPLAYER_GSTREAMERAUDIODECODER_H_
+
+#include <memory>
+#include <string>
+
+#include "MediaPlayer/DecodedAudioCache.h"
+
+namespace alexaClientSDK {
+namespace mediaPlayer {
+
+/**
+ * Decode a whole encoded sound to interleaved signed 16-bit little endian PCM using a private GStreamer pipeline.
+ * This blocks until the sound has been decoded, so it should not be called from a GStreamer main loop.
+ *
+ * @param encoded The encoded bytes, in any format GStreamer can decode.
+ * @return The decoded audio, or @c nullptr if it could not be decoded.
+ */
+std::shared_ptr<const DecodedAudio> decodeWithGStreamer(const std::string& encoded);
+
+}  // namespace mediaPlayer
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_MEDIAPLAYER_INCLUDE_MEDIAPLAYER_GSTREAMERAUDIODECODER_H_
@@ -22,11 +22,13 @@
 #include <functional>
 #include <future>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
 #include <queue>
 
 #include <gst/gst.h>
+#include <gst/app/gstappsink.h>
 #include <gst/app/gstappsrc.h>
 #include <gst/base/gstbasesink.h>
 
@@ -37,8 +39,11 @@
 #include <AVSCommon/Utils/PlaylistParser/PlaylistParserInterface.h>
 #include <PlaylistParser/UrlContentToAttachmentConverter.h>
 
+#include "MediaPlayer/DecodedAudioCache.h"
 #include "MediaPlayer/OffsetManager.h"
+#include "MediaPlayer/OutputTap.h"
 #include "MediaPlayer/PipelineInterface.h"
+#include "MediaPlayer/SharedMainLoop.h"
 #include "MediaPlayer/SourceInterface.h"
 
 namespace alexaClientSDK {
@@ -93,8 +98,10 @@ public:
      * will reset the pipeline and source, and will not resume playback.
      */
     bool resume(SourceId id) override;
+    bool preroll(SourceId id) override;
     uint64_t getNumBytesBuffered() override;
     std::chrono::milliseconds getOffset(SourceId id) override;
+    std::chrono::milliseconds getDuration(SourceId id) override;
     void setObserver(std::shared_ptr<avsCommon::utils::mediaPlayer::MediaPlayerObserverInterface> observer) override;
     /// @}
 
@@ -124,6 +131,14 @@ public:
 
     void doShutdown() override;
 
+    /**
+     * Get the tap on this player's output, which is enabled with @c outputTap in the @c gstreamerMediaPlayer
+     * configuration.
+     *
+     * @return The output tap, or @c nullptr if it is not enabled.
+     */
+    std::shared_ptr<OutputTap> getOutputTap() const;
+
 private:
     /**
      * The @c AudioPipeline consists of the following elements:
@@ -135,6 +150,12 @@ private:
      * @li @c resampler The optional resampler element is used to convert to a specified format
      * @li @c caps The optional caps element is used to specify the resampler format
      * @li @c audioSink Sink for the audio.
+     * @li @c tee The optional tee element copies the output to the output tap branch after the volume is applied.
+     * @li @c tapQueue A leaky queue that decouples the output tap branch from playback.
+     * @li @c tapConverter An audio-converter for the output tap branch.
+     * @li @c tapResample A resampler for the output tap branch.
+     * @li @c tapCaps The caps element specifying the output tap format.
+     * @li @c tapSink The appsink which writes the output tap branch to the @c OutputTap.
      * @li @c pipeline The pipeline is a bin consisting of the @c appsrc, the @c decoder, the @c converter, and the
      * @c audioSink.
      *
@@ -167,6 +188,24 @@ private:
         /// The sink element.
         GstElement* audioSink;
 
+        /// The tee element feeding the output tap.
+        GstElement* tee;
+
+        /// The queue of the output tap branch.
+        GstElement* tapQueue;
+
+        /// The converter element of the output tap branch.
+        GstElement* tapConverter;
+
+        /// The resampler element of the output tap branch.
+        GstElement* tapResample;
+
+        /// The capabilities element of the output tap branch.
+        GstElement* tapCaps;
+
+        /// The sink element of the output tap branch.
+        GstElement* tapSink;
+
         /// Pipeline element.
         GstElement* pipeline;
 
@@ -178,6 +217,12 @@ private:
                 converter{nullptr},
                 volume{nullptr},
                 audioSink{nullptr},
+                tee{nullptr},
+                tapQueue{nullptr},
+                tapConverter{nullptr},
+                tapResample{nullptr},
+                tapCaps{nullptr},
+                tapSink{nullptr},
                 pipeline{nullptr} {};
     };
 
@@ -193,7 +238,8 @@ private:
         std::string name);
 
     /**
-     * Initializes GStreamer and starts a main event loop on a new thread.
+     * Initializes GStreamer and starts a main event loop on a new thread, or joins the @c SharedMainLoop if
+     * @c sharedMainLoop is enabled in the configuration.
      *
      * @return @c SUCCESS if initialization was successful. Else @c FAILURE.
      */
@@ -228,6 +274,21 @@ private:
      */
     void tearDownTransientPipelineElements();
 
+    /**
+     * Get the state the pipeline is parked in between sources.  With @c persistentPipeline enabled in the
+     * configuration this is @c GST_STATE_READY, which keeps the permanent elements, and in particular the audio
+     * device opened by the sink, warm for the next source.  After a pipeline error, or with the option disabled, this
+     * is @c GST_STATE_NULL so the next source starts from a full reset.
+     *
+     * @return The state to park the pipeline in between sources.
+     */
+    GstState getIdleState() const;
+
+    /**
+     * Log how long the current source took from @c setSource() and from @c play() to reaching the PLAYING state.
+     */
+    void logPlaybackStartedLatency();
+
     /**
      * Resets the @c AudioPipeline.
      */
@@ -266,6 +327,41 @@ private:
      */
     static gboolean onBusMessage(GstBus* bus, GstMessage* msg, gpointer mediaPlayer);
 
+    /**
+     * Create the output tap branch, add it to the pipeline and link it to the tee.
+     *
+     * @return Whether the branch was set up.
+     */
+    bool setupOutputTapBranch();
+
+    /**
+     * Pad probe on the tee's sink pad which records when output is handed to the audio sink, so that the output tap
+     * can timestamp the converted audio.
+     *
+     * @param pad The tee's sink pad.
+     * @param info The probe info holding the buffer.
+     * @param mediaPlayer A pointer to the instance of the @c MediaPlayer.
+     * @return @c GST_PAD_PROBE_OK to let the buffer through.
+     */
+    static GstPadProbeReturn onOutputTapProbe(GstPad* pad, GstPadProbeInfo* info, gpointer mediaPlayer);
+
+    /**
+     * Callback for a new sample on the output tap branch's appsink, which writes it to @c m_outputTap.
+     *
+     * @param sink The appsink.
+     * @param mediaPlayer A pointer to the instance of the @c MediaPlayer.
+     * @return @c GST_FLOW_OK.
+     */
+    static GstFlowReturn onOutputTapSample(GstAppSink* sink, gpointer mediaPlayer);
+
+    /**
+     * Callback for end of stream on the output tap branch's appsink, which logs the latency the tap has added so far.
+     *
+     * @param sink The appsink.
+     * @param mediaPlayer A pointer to the instance of the @c MediaPlayer.
+     */
+    static void onOutputTapEos(GstAppSink* sink, gpointer mediaPlayer);
+
     /**
      * Performs actions based on the message.
      *
@@ -311,14 +407,30 @@ private:
      */
     void handleSetUrlSource(const std::string& url, std::chrono::milliseconds offset, std::promise<SourceId>* promise);
 
+    /**
+     * Look up the decoded PCM for a stream in @c m_decodedAudioCache, by the resource identifier of its
+     * @c avsCommon::utils::stream::Streambuf if it has one, or else by its content.  The stream is left at the position
+     * it started at.  On a miss the cache starts decoding the stream in the background, so the next play of it is a
+     * hit.
+     *
+     * @param stream The stream to look up.
+     * @return The decoded audio, or @c nullptr if the cache is disabled, the stream can't be cached or it missed.
+     */
+    std::shared_ptr<const DecodedAudio> lookUpDecodedAudio(std::shared_ptr<std::istream> stream);
+
     /**
      * Worker thread handler for setting the source of audio to play.
      *
      * @param stream The source from which to receive the audio to play.
+     * @param decodedAudio The decoded PCM of @c stream to play instead of decoding it, or @c nullptr.
      * @param repeat Whether the audio stream should be played in a loop until stopped.
      * @param promise A promise to fulfill with a @ SourceId value once the source has been set.
      */
-    void handleSetIStreamSource(std::shared_ptr<std::istream> stream, bool repeat, std::promise<SourceId>* promise);
+    void handleSetIStreamSource(
+        std::shared_ptr<std::istream> stream,
+        std::shared_ptr<const DecodedAudio> decodedAudio,
+        bool repeat,
+        std::promise<SourceId>* promise);
 
     /**
      * Internal method to update the volume according to a gstreamer bug fix
@@ -397,6 +509,15 @@ private:
      */
     void handleResume(SourceId id, std::promise<bool>* promise);
 
+    /**
+     * Worker thread handler for prerolling the current audio source to @c GST_STATE_PAUSED ahead of playback.
+     *
+     * @param id The @c SourceId that the caller is expecting to be handled.
+     * @param promise A promise to fulfill with a @c bool value once prerolling has started
+     * (or the operation has failed).
+     */
+    void handlePreroll(SourceId id, std::promise<bool>* promise);
+
     /**
      * Worker thread handler for getting the current playback position.
      *
@@ -405,6 +526,14 @@ private:
      */
     void handleGetOffset(SourceId id, std::promise<std::chrono::milliseconds>* promise);
 
+    /**
+     * Worker thread handler for getting the duration of the current audio source.
+     *
+     * @param id The @c SourceId that the caller is expecting to be handled.
+     * @param promise A promise to fulfill with the duration once the value has been determined.
+     */
+    void handleGetDuration(SourceId id, std::promise<std::chrono::milliseconds>* promise);
+
     /**
      * Worker thread handler for setting the observer.
      *
@@ -498,8 +627,10 @@ private:
 
     /**
      * Destructs the @c m_source with proper steps.
+     *
+     * @param idleState The state to leave the pipeline in.
      */
-    void cleanUpSource();
+    void cleanUpSource(GstState idleState = GST_STATE_NULL);
 
     /// The volume to restore to when exiting muted state. Used in GStreamer crash fix for zero volume on PCM data.
     gdouble m_lastVolume;
@@ -522,12 +653,15 @@ private:
     /// The Speaker type.
     avsCommon::sdkInterfaces::SpeakerInterface::Type m_speakerType;
 
-    /// Main event loop.
+    /// Main event loop.  This is @c nullptr when the player runs on @c m_sharedMainLoop.
     GMainLoop* m_mainLoop;
 
     // Main loop thread
     std::thread m_mainLoopThread;
 
+    /// The main loop shared with other players, if @c sharedMainLoop is enabled in the configuration.
+    std::shared_ptr<SharedMainLoop> m_sharedMainLoop;
+
     /// Bus Id to track the bus.
     guint m_busWatchId;
 
@@ -543,6 +677,9 @@ private:
     /// Flag to indicate whether a buffer underrun is occurring.
     bool m_isBufferUnderrun;
 
+    /// Flag to indicate whether the pipeline was prerolled to @c GST_STATE_PAUSED and is waiting for a @c play().
+    bool m_isPrerolled;
+
     /// @c MediaPlayerObserverInterface instance to notify when the playback state changes.
     std::shared_ptr<avsCommon::utils::mediaPlayer::MediaPlayerObserverInterface> m_playerObserver;
 
@@ -566,6 +703,36 @@ private:
 
     /// Stream offset before we teardown the pipeline
     std::chrono::milliseconds m_offsetBeforeTeardown;
+
+    /// Whether to park the pipeline in @c GST_STATE_READY rather than @c GST_STATE_NULL between sources.
+    bool m_persistentPipeline;
+
+    /// Whether the pipeline hit an error, so the next source must start from @c GST_STATE_NULL.
+    bool m_pipelineNeedsReset;
+
+    /// Whether the current source was set on a pipeline parked in @c GST_STATE_READY.
+    bool m_pipelineReused;
+
+    /// Cache of decoded PCM for short sounds played from a @c std::istream, or @c nullptr if it is disabled.
+    std::shared_ptr<DecodedAudioCache> m_decodedAudioCache;
+
+    /// The tap on the player's output, or @c nullptr if it is disabled.
+    std::shared_ptr<OutputTap> m_outputTap;
+
+    /// Serializes access to @c m_outputTapAnchorPts and @c m_outputTapAnchorTime.
+    std::mutex m_outputTapAnchorMutex;
+
+    /// The timestamp of the last buffer handed to the audio sink.
+    GstClockTime m_outputTapAnchorPts;
+
+    /// When the buffer at @c m_outputTapAnchorPts was handed to the audio sink.
+    std::chrono::steady_clock::time_point m_outputTapAnchorTime;
+
+    /// When the current source was set.
+    std::chrono::steady_clock::time_point m_setSourceTime;
+
+    /// When @c play() was last handled for the current source.
+    std::chrono::steady_clock::time_point m_playTime;
 };
 
 }  // namespace mediaPlayer
@@ -0,0 +1,166 @@
+/*
+ * Copyright 2017-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_MEDIAPLAYER_INCLUDE_MEDIAPLAYER_OUTPUTTAP_H_
+#define ALEXA_CLIENT_SDK_MEDIAPLAYER_INCLUDE_MEDIAPLAYER_OUTPUTTAP_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include <AVSCommon/AVS/AudioInputStream.h>
+#include <AVSCommon/Utils/AudioFormat.h>
+
+namespace alexaClientSDK {
+namespace mediaPlayer {
+
+/**
+ * A copy of the audio a @c MediaPlayer is playing, taken after the volume is applied, for consumers such as acoustic
+ * echo cancellation which need the exact output as a reference.  The audio is written to a shared data stream as
+ * interleaved signed 16-bit little endian PCM, and the time each part of it was handed to the audio sink is recorded
+ * so that readers can align it with their own input.
+ *
+ * The tap never holds up playback: its writer is non-blocking, so a reader that falls more than the buffer behind
+ * loses the oldest audio.  The latency the tap adds, from audio being handed to the sink to it being in the stream, is
+ * measured on every write and can be read with @c getLatencyStats().
+ */
+class OutputTap {
+public:
+    /// The type of a clock time recorded for the audio in the stream.
+    using TimePoint = std::chrono::steady_clock::time_point;
+
+    /// The latency added by the tap: the time from audio being handed to the audio sink to it being in the stream.
+    struct LatencyStats {
+        /// The number of writes measured.
+        uint64_t writes;
+
+        /// The largest latency of a write.
+        std::chrono::microseconds max;
+
+        /// The average latency of a write, or zero if there were none.
+        std::chrono::microseconds average;
+    };
+
+    /// The number of bits in each sample written to the stream.
+    static const unsigned int SAMPLE_SIZE_IN_BITS = 16;
+
+    /**
+     * Create an output tap.
+     *
+     * @param sampleRateHz The sample rate of the audio in the stream.
+     * @param numChannels The number of channels of the audio in the stream.
+     * @param bufferDuration How much audio the stream holds.
+     * @param maxReaders The maximum number of readers of the stream.
+     * @return The new tap, or @c nullptr if the parameters are invalid.
+     */
+    static std::shared_ptr<OutputTap> create(
+        unsigned int sampleRateHz,
+        unsigned int numChannels,
+        std::chrono::milliseconds bufferDuration,
+        size_t maxReaders);
+
+    /**
+     * Get the stream the output is written to.  Each word in the stream is one frame, i.e. one sample of every
+     * channel.
+     *
+     * @return The stream.
+     */
+    std::shared_ptr<avsCommon::avs::AudioInputStream> getStream() const;
+
+    /**
+     * Get the format of the audio in the stream.
+     *
+     * @return The format.
+     */
+    avsCommon::utils::AudioFormat getFormat() const;
+
+    /**
+     * Get the time at which a frame in the stream was handed to the audio sink.
+     *
+     * @param index The index of the frame in the stream.
+     * @param[out] timestamp The time the frame was handed to the audio sink.
+     * @return Whether the frame is still in the stream and its time is known.
+     */
+    bool getTimestamp(avsCommon::avs::AudioInputStream::Index index, TimePoint* timestamp) const;
+
+    /**
+     * Write output to the stream.  This is called by the @c MediaPlayer from its pipeline.
+     *
+     * @param data The PCM to write.
+     * @param size The size of @c data in bytes.  Any partial frame at the end is dropped.
+     * @param timestamp The time the first frame of @c data was handed to the audio sink.
+     * @return The number of frames written.
+     */
+    size_t write(const void* data, size_t size, TimePoint timestamp);
+
+    /**
+     * Get the latency added by the tap, measured on each write since the tap was created.
+     *
+     * @return The latency statistics.
+     */
+    LatencyStats getLatencyStats() const;
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param format The format of the audio in the stream.
+     * @param bufferFrames The number of frames the stream holds.
+     * @param stream The stream to write to.
+     */
+    OutputTap(
+        const avsCommon::utils::AudioFormat& format,
+        size_t bufferFrames,
+        std::shared_ptr<avsCommon::avs::AudioInputStream> stream);
+
+    /// The format of the audio in the stream.
+    const avsCommon::utils::AudioFormat m_format;
+
+    /// The size of a frame in bytes.
+    const size_t m_frameSize;
+
+    /// The number of frames the stream holds.
+    const size_t m_bufferFrames;
+
+    /// The stream the output is written to.
+    const std::shared_ptr<avsCommon::avs::AudioInputStream> m_stream;
+
+    /// Serializes access to the members below.
+    mutable std::mutex m_mutex;
+
+    /// The writer of @c m_stream.
+    std::unique_ptr<avsCommon::avs::AudioInputStream::Writer> m_writer;
+
+    /// The index in the stream and time of the first frame of each recent write, oldest first.
+    std::deque<std::pair<avsCommon::avs::AudioInputStream::Index, TimePoint>> m_marks;
+
+    /// The number of writes whose latency has been measured.
+    uint64_t m_latencyWrites;
+
+    /// The largest latency of a write.
+    std::chrono::microseconds m_maxLatency;
+
+    /// The total latency of all writes.
+    std::chrono::microseconds m_totalLatency;
+};
+
+}  // namespace mediaPlayer
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_MEDIAPLAYER_INCLUDE_MEDIAPLAYER_OUTPUTTAP_H_
@@ -0,0 +1,92 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_MEDIAPLAYER_INCLUDE_MEDIAPLAYER_SHAREDMAINLOOP_H_
+#define ALEXA_CLIENT_SDK_MEDIAPLAYER_INCLUDE_MEDIAPLAYER_SHAREDMAINLOOP_H_
+
+#include <memory>
+#include <thread>
+
+#include <glib.h>
+
+namespace alexaClientSDK {
+namespace mediaPlayer {
+
+/**
+ * A single GLib main loop thread shared by every @c MediaPlayer that opts in to it.  The bus watches and idle/timeout
+ * sources of the players all attach to the default main context, so running that context on one thread instead of one
+ * per player cuts the thread count and idle wakeups, while sources from any one player are still dispatched in the
+ * order they were queued.
+ *
+ * The loop is started when the first player acquires it and stopped when the last player releases it.
+ */
+class SharedMainLoop {
+public:
+    /**
+     * Get the shared main loop, starting it if no player currently holds it.
+     *
+     * @return The shared main loop, or @c nullptr if it could not be started.
+     */
+    static std::shared_ptr<SharedMainLoop> acquire();
+
+    /**
+     * Destructor.  Stops the loop and joins its thread.
+     */
+    ~SharedMainLoop();
+
+    /**
+     * Block until every source already dispatched or queued at idle priority on the loop has run.  A player calls this
+     * after removing its sources, so that none of its callbacks are still running when it is destroyed.  This returns
+     * immediately when called on the loop thread.
+     */
+    void waitForPendingCallbacks();
+
+    /**
+     * Delete copy constructor.
+     */
+    SharedMainLoop(const SharedMainLoop&) = delete;
+
+    /**
+     * Delete copy operator.
+     */
+    SharedMainLoop& operator=(const SharedMainLoop&) = delete;
+
+private:
+    /**
+     * Constructor.
+     *
+     * @param mainLoop The main loop to run, which this object takes ownership of.
+     */
+    SharedMainLoop(GMainLoop* mainLoop);
+
+    /**
+     * Idle callback used by @c waitForPendingCallbacks() to signal the waiting thread.
+     *
+     * @param pointer The @c std::promise<void> to fulfill.
+     * @return @c false so the callback is not repeated.
+     */
+    static gboolean onPendingCallbacksDone(gpointer pointer);
+
+    /// The main loop, which runs the default main context.
+    GMainLoop* m_mainLoop;
+
+    /// The thread running @c m_mainLoop.
+    std::thread m_mainLoopThread;
+};
+
+}  // namespace mediaPlayer
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_MEDIAPLAYER_INCLUDE_MEDIAPLAYER_SHAREDMAINLOOP_H_
@@ -13,6 +13,7 @@
  * permissions and limitations under the License.
  */
 
+#include <algorithm>
 #include <cstring>
 
 #include <AVSCommon/Utils/Logger/Logger.h>
@@ -37,8 +38,59 @@ static const std::string TAG("AttachmentReaderSource");
  */
 #define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
 
-/// The number of bytes read from the attachment with each read in the read loop.
-static const unsigned int CHUNK_SIZE(4096);
+/// The smallest number of bytes read from the attachment with each read in the read loop.
+static const size_t MIN_CHUNK_SIZE(4096);
+
+/// The largest number of bytes read from the attachment with each read in the read loop.
+static const size_t MAX_CHUNK_SIZE(32768);
+
+/**
+ * The number of buffer pools.  Their buffer sizes double from @c MIN_CHUNK_SIZE to @c MAX_CHUNK_SIZE, so a buffer
+ * never holds less than half of the memory it takes up, unless the read into it comes up short.
+ */
+static const size_t NUM_BUFFER_POOLS(4);
+
+static_assert(
+    MIN_CHUNK_SIZE << (NUM_BUFFER_POOLS - 1) == MAX_CHUNK_SIZE,
+    "The largest buffer pool must hold MAX_CHUNK_SIZE bytes");
+
+/**
+ * Get the size of the buffers of a pool.
+ *
+ * @param index The index of the pool.
+ * @return The size of its buffers.
+ */
+static size_t getBufferPoolSize(size_t index) {
+    return MIN_CHUNK_SIZE << index;
+}
+
+/**
+ * Create and activate a pool of buffers.
+ *
+ * @param size The size of the buffers.
+ * @return The new pool, or @c nullptr if it could not be started.
+ */
+static GstBufferPool* createBufferPool(size_t size) {
+    auto pool = gst_buffer_pool_new();
+    if (!pool) {
+        ACSDK_ERROR(LX("createBufferPoolFailed").d("reason", "gstBufferPoolNewFailed"));
+        return nullptr;
+    }
+    auto config = gst_buffer_pool_get_config(pool);
+    // No caps, no buffers allocated up front, and no limit on how many buffers may be outstanding.
+    gst_buffer_pool_config_set_params(config, nullptr, size, 0, 0);
+    if (!gst_buffer_pool_set_config(pool, config)) {
+        ACSDK_ERROR(LX("createBufferPoolFailed").d("reason", "gstBufferPoolSetConfigFailed"));
+        gst_object_unref(pool);
+        return nullptr;
+    }
+    if (!gst_buffer_pool_set_active(pool, TRUE)) {
+        ACSDK_ERROR(LX("createBufferPoolFailed").d("reason", "gstBufferPoolSetActiveFailed"));
+        gst_object_unref(pool);
+        return nullptr;
+    }
+    return pool;
+}
 
 std::unique_ptr<AttachmentReaderSource> AttachmentReaderSource::create(
     PipelineInterface* pipeline,
@@ -53,13 +105,24 @@ std::unique_ptr<AttachmentReaderSource> AttachmentReaderSource::create(
 
 AttachmentReaderSource::~AttachmentReaderSource() {
     close();
+    for (auto pool : m_bufferPools) {
+        if (pool) {
+            // Buffers still held by the pipeline keep the pool alive until they are released.
+            gst_buffer_pool_set_active(pool, FALSE);
+            gst_object_unref(pool);
+        }
+    }
 }
 
 AttachmentReaderSource::AttachmentReaderSource(
     PipelineInterface* pipeline,
     std::shared_ptr<avsCommon::avs::attachment::AttachmentReader> reader) :
         BaseStreamSource{pipeline, "AttachmentReaderSource"},
-        m_reader{reader} {};
+        m_reader{reader} {
+    for (size_t i = 0; i < NUM_BUFFER_POOLS; ++i) {
+        m_bufferPools.push_back(createBufferPool(getBufferPoolSize(i)));
+    }
+};
 
 bool AttachmentReaderSource::isPlaybackRemote() const {
     return false;
@@ -71,6 +134,8 @@ bool AttachmentReaderSource::isOpen() {
 
 void AttachmentReaderSource::close() {
     if (m_reader) {
+        // Others may still hold the reader, so make sure it stops calling back into this object.
+        m_reader->setDataAvailableCallback(nullptr);
         m_reader->close();
     }
     m_reader.reset();
@@ -82,10 +147,11 @@ gboolean AttachmentReaderSource::handleReadData() {
         return false;
     }
 
-    auto buffer = gst_buffer_new_allocate(nullptr, CHUNK_SIZE, nullptr);
+    auto chunkSize = getChunkSize();
+    auto buffer = acquireBuffer(chunkSize);
 
     if (!buffer) {
-        ACSDK_ERROR(LX("handleReadDataFailed").d("reason", "gstBufferNewAllocateFailed"));
+        ACSDK_ERROR(LX("handleReadDataFailed").d("reason", "acquireBufferFailed"));
         signalEndOfData();
         return false;
     }
@@ -99,13 +165,27 @@ gboolean AttachmentReaderSource::handleReadData() {
     }
 
     auto status = AttachmentReader::ReadStatus::OK;
-    auto size = m_reader->read(info.data, info.size, &status);
+    chunkSize = std::min(chunkSize, static_cast<size_t>(info.size));
+    auto size = m_reader->read(info.data, chunkSize, &status);
 
-    ACSDK_DEBUG9(LX("read").d("size", size).d("status", static_cast<int>(status)));
+    ACSDK_DEBUG9(LX("read").d("chunkSize", chunkSize).d("size", size).d("status", static_cast<int>(status)));
 
-    gst_buffer_unmap(buffer, &info);
+    if (size > 0 && size < info.size / 2) {
+        // A short read, typically near the live edge, is copied out so the pooled buffer can be reused right away.
+        auto exactBuffer = gst_buffer_new_allocate(nullptr, size, nullptr);
+        if (exactBuffer) {
+            gst_buffer_fill(exactBuffer, 0, info.data, size);
+        }
+        gst_buffer_unmap(buffer, &info);
+        if (exactBuffer) {
+            gst_buffer_unref(buffer);
+            buffer = exactBuffer;
+        }
+    } else {
+        gst_buffer_unmap(buffer, &info);
+    }
 
-    if (size > 0 && size < info.size) {
+    if (size > 0 && size < gst_buffer_get_size(buffer)) {
         gst_buffer_resize(buffer, 0, size);
     }
 
@@ -147,6 +227,32 @@ gboolean AttachmentReaderSource::handleReadData() {
     return false;
 }
 
+GstBuffer* AttachmentReaderSource::acquireBuffer(size_t size) {
+    // Use the pool of the smallest buffers which are big enough.
+    size_t index = 0;
+    while (index + 1 < m_bufferPools.size() && getBufferPoolSize(index) < size) {
+        ++index;
+    }
+    auto pool = m_bufferPools[index];
+    if (pool) {
+        GstBuffer* buffer = nullptr;
+        auto flowRet = gst_buffer_pool_acquire_buffer(pool, &buffer, nullptr);
+        if (GST_FLOW_OK == flowRet && buffer) {
+            return buffer;
+        }
+        ACSDK_WARN(LX("acquireBufferFromPoolFailed").d("result", gst_flow_get_name(flowRet)));
+    }
+    return gst_buffer_new_allocate(nullptr, getBufferPoolSize(index), nullptr);
+}
+
+size_t AttachmentReaderSource::getChunkSize() {
+    auto unreadBytes = m_reader->getNumUnreadBytes();
+    if (unreadBytes >= MAX_CHUNK_SIZE) {
+        return MAX_CHUNK_SIZE;
+    }
+    return std::max(static_cast<size_t>(unreadBytes), MIN_CHUNK_SIZE);
+}
+
 gboolean AttachmentReaderSource::handleSeekData(guint64 offset) {
     ACSDK_DEBUG9(LX("handleSeekData").d("offset", offset));
     if (m_reader) {
@@ -157,5 +263,9 @@ gboolean AttachmentReaderSource::handleSeekData(guint64 offset) {
     }
 }
 
+bool AttachmentReaderSource::setDataAvailableCallback(std::function<void()> callback) {
+    return m_reader && m_reader->setDataAvailableCallback(callback);
+}
+
 }  // namespace mediaPlayer
 }  // namespace alexaClientSDK
@@ -16,7 +16,6 @@
 #include <cstring>
 
 #include <AVSCommon/Utils/Logger/Logger.h>
-#include <AVSCommon/AVS/Attachment/AttachmentReader.h>
 
 #include "MediaPlayer/BaseStreamSource.h"
 
@@ -25,7 +24,6 @@ namespace mediaPlayer {
 
 using namespace avsCommon::utils;
 using namespace avsCommon::utils::mediaPlayer;
-using namespace avsCommon::avs::attachment;
 
 /// String to identify log entries originating from this file.
 static const std::string TAG("BaseStreamSource");
@@ -40,6 +38,24 @@ static const std::string TAG("BaseStreamSource");
 /// The interval to wait (in milliseconds) between successive attempts to read audio data when none is available.
 static const guint RETRY_INTERVALS_MILLISECONDS[] = {0, 10, 10, 10, 20, 20, 50, 100};
 
+/**
+ * Dispatch a data available source.  Such a source is only ever made ready explicitly, with
+ * @c g_source_set_ready_time(), which is safe to call from any thread and wakes the main loop.
+ *
+ * @param source The source.
+ * @param callback The callback of the source.
+ * @param userData The data to pass to @c callback.
+ * @return Whether the source should stay attached.
+ */
+static gboolean dispatchDataAvailableSource(GSource* source, GSourceFunc callback, gpointer userData) {
+    g_source_set_ready_time(source, -1);
+    return callback ? callback(userData) : G_SOURCE_REMOVE;
+}
+
+/// The functions of a data available source, which needs neither polling nor a timeout.
+static GSourceFuncs DATA_AVAILABLE_SOURCE_FUNCS =
+    {nullptr, nullptr, dispatchDataAvailableSource, nullptr, nullptr, nullptr};
+
 /**
  * Method that returns a string to be used in CAPS negotiation (generating right PADS between gstreamer elements based
  * on audio data.) For raw PCM data without header audioFormat information needs to be passed explicitly for a
@@ -90,25 +106,39 @@ BaseStreamSource::BaseStreamSource(PipelineInterface* pipeline, const std::strin
         m_sourceRetryCount{0},
         m_handleNeedDataFunction{[this]() { return handleNeedData(); }},
         m_handleEnoughDataFunction{[this]() { return handleEnoughData(); }},
+        m_needsData{false},
         m_needDataHandlerId{0},
         m_enoughDataHandlerId{0},
         m_seekDataHandlerId{0},
         m_needDataCallbackId{0},
-        m_enoughDataCallbackId{0} {
+        m_enoughDataCallbackId{0},
+        m_dataAvailableSource{nullptr},
+        m_isWaitingForData{false} {
 }
 
 BaseStreamSource::~BaseStreamSource() {
     ACSDK_DEBUG9(LX("~BaseStreamSource"));
+    // Subclasses have stopped calling onDataAvailable() by now, since they set the callback back to nullptr on close.
+    if (m_dataAvailableSource) {
+        g_source_destroy(m_dataAvailableSource);
+        g_source_unref(m_dataAvailableSource);
+    }
     g_signal_handler_disconnect(m_pipeline->getAppSrc(), m_needDataHandlerId);
     g_signal_handler_disconnect(m_pipeline->getAppSrc(), m_enoughDataHandlerId);
     g_signal_handler_disconnect(m_pipeline->getAppSrc(), m_seekDataHandlerId);
     if (m_pipeline->getPipeline()) {
+        /*
+         * The pipeline may be parked in READY rather than NULL so the permanent elements stay warm for the next
+         * source, so bring the transient elements down to NULL before they are removed and released.
+         */
         if (m_pipeline->getAppSrc()) {
+            gst_element_set_state(GST_ELEMENT(m_pipeline->getAppSrc()), GST_STATE_NULL);
             gst_bin_remove(GST_BIN(m_pipeline->getPipeline()), GST_ELEMENT(m_pipeline->getAppSrc()));
         }
         m_pipeline->setAppSrc(nullptr);
 
         if (m_pipeline->getDecoder()) {
+            gst_element_set_state(m_pipeline->getDecoder(), GST_STATE_NULL);
             gst_bin_remove(GST_BIN(m_pipeline->getPipeline()), GST_ELEMENT(m_pipeline->getDecoder()));
         }
         m_pipeline->setDecoder(nullptr);
@@ -213,9 +243,25 @@ bool BaseStreamSource::init(const AudioFormat* audioFormat) {
     m_pipeline->setAppSrc(appsrc);
     m_pipeline->setDecoder(decoder);
 
+    createDataAvailableSource();
+
     return true;
 }
 
+void BaseStreamSource::createDataAvailableSource() {
+    auto source = g_source_new(&DATA_AVAILABLE_SOURCE_FUNCS, sizeof(GSource));
+    g_source_set_callback(source, reinterpret_cast<GSourceFunc>(&onDataAvailableDispatch), this, nullptr);
+    // Attach to the default context, like the idle and timeout handlers, so it is dispatched on the worker thread.
+    g_source_attach(source, nullptr);
+    m_dataAvailableSource = source;
+    if (!setDataAvailableCallback([this]() { onDataAvailable(); })) {
+        ACSDK_DEBUG9(LX("createDataAvailableSource").d("action", "fallBackToPolling"));
+        m_dataAvailableSource = nullptr;
+        g_source_destroy(source);
+        g_source_unref(source);
+    }
+}
+
 GstAppSrc* BaseStreamSource::getAppSrc() const {
     if (!m_pipeline) {
         return nullptr;
@@ -257,6 +303,16 @@ void BaseStreamSource::installOnReadDataHandler() {
 }
 
 void BaseStreamSource::updateOnReadDataHandler() {
+    if (m_dataAvailableSource) {
+        if (!m_isWaitingForData.exchange(true)) {
+            // From now on arriving data wakes the handler.  Read once more in case some arrived before now.
+            return;
+        }
+        // Rather than polling, wait for handleDataAvailable() to reinstall the handler.
+        ACSDK_DEBUG9(LX("updateOnReadDataHandler").d("action", "waitForData").d("sourceId", m_sourceId));
+        uninstallOnReadDataHandler();
+        return;
+    }
     if (m_sourceRetryCount < sizeof(RETRY_INTERVALS_MILLISECONDS) / sizeof(RETRY_INTERVALS_MILLISECONDS[0])) {
         ACSDK_DEBUG9(LX("updateOnReadDataHandler").d("action", "removeSourceId").d("sourceId", m_sourceId));
         if (!g_source_remove(m_sourceId)) {
@@ -304,6 +360,7 @@ gboolean BaseStreamSource::handleNeedData() {
     ACSDK_DEBUG9(LX("handleNeedDataCalled"));
     std::lock_guard<std::mutex> lock(m_callbackIdMutex);
     m_needDataCallbackId = 0;
+    m_needsData = true;
     installOnReadDataHandler();
     return false;
 }
@@ -323,10 +380,34 @@ gboolean BaseStreamSource::handleEnoughData() {
     ACSDK_DEBUG9(LX("handleEnoughDataCalled"));
     std::lock_guard<std::mutex> lock(m_callbackIdMutex);
     m_enoughDataCallbackId = 0;
+    m_needsData = false;
     uninstallOnReadDataHandler();
     return false;
 }
 
+bool BaseStreamSource::setDataAvailableCallback(std::function<void()> callback) {
+    return false;
+}
+
+void BaseStreamSource::onDataAvailable() {
+    if (m_isWaitingForData.exchange(false)) {
+        g_source_set_ready_time(m_dataAvailableSource, 0);
+    }
+}
+
+gboolean BaseStreamSource::onDataAvailableDispatch(gpointer pointer) {
+    return static_cast<BaseStreamSource*>(pointer)->handleDataAvailable();
+}
+
+gboolean BaseStreamSource::handleDataAvailable() {
+    ACSDK_DEBUG9(LX("handleDataAvailableCalled"));
+    std::lock_guard<std::mutex> lock(m_callbackIdMutex);
+    if (m_needsData) {
+        installOnReadDataHandler();
+    }
+    return true;
+}
+
 gboolean BaseStreamSource::onSeekData(GstElement* pipeline, guint64 offset, gpointer pointer) {
     return static_cast<BaseStreamSource*>(pointer)->handleSeekData(offset);
 }
@@ -0,0 +1,146 @@
+/*
+ * Copyright 2017-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "MediaPlayer/DecodedAudioCache.h"
+#include "MediaPlayer/GStreamerAudioDecoder.h"
+
+namespace alexaClientSDK {
+namespace mediaPlayer {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("DecodedAudioCache");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// Serializes creating and looking up the shared cache.
+static std::mutex g_sharedCacheMutex;
+
+/// The shared cache, if any player currently holds it.  The access to this variable is guarded by
+/// @c g_sharedCacheMutex.
+static std::weak_ptr<DecodedAudioCache> g_sharedCache;
+
+std::shared_ptr<DecodedAudioCache> DecodedAudioCache::acquire(size_t maxBytes) {
+    std::lock_guard<std::mutex> lock(g_sharedCacheMutex);
+    auto cache = g_sharedCache.lock();
+    if (cache) {
+        return cache;
+    }
+    cache = create(maxBytes, decodeWithGStreamer);
+    g_sharedCache = cache;
+    return cache;
+}
+
+std::shared_ptr<DecodedAudioCache> DecodedAudioCache::create(size_t maxBytes, Decoder decoder) {
+    if (0 == maxBytes) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "zeroMaxBytes"));
+        return nullptr;
+    }
+    if (!decoder) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "nullDecoder"));
+        return nullptr;
+    }
+    return std::shared_ptr<DecodedAudioCache>(new DecodedAudioCache(maxBytes, std::move(decoder)));
+}
+
+DecodedAudioCache::DecodedAudioCache(size_t maxBytes, Decoder decoder) :
+        m_maxBytes{maxBytes},
+        m_decoder{std::move(decoder)},
+        m_cachedBytes{0} {
+}
+
+std::shared_ptr<const DecodedAudio> DecodedAudioCache::get(const std::string& key, const EncodedReader& readEncoded) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_entries.find(key);
+        if (it != m_entries.end()) {
+            m_lru.splice(m_lru.begin(), m_lru, it->second);
+            return it->second->audio;
+        }
+        if (m_pending.count(key) || m_uncacheable.count(key)) {
+            return nullptr;
+        }
+        m_pending.insert(key);
+    }
+
+    // The bytes are read without holding the lock, as the reader may be slow.  Marking the key as pending first
+    // ensures that only one lookup reads them.
+    auto encoded = readEncoded ? readEncoded() : std::string();
+    if (encoded.empty()) {
+        ACSDK_DEBUG5(LX("notCached").d("reason", "readFailed").d("key", key));
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending.erase(key);
+        m_uncacheable.insert(key);
+        return nullptr;
+    }
+    m_executor.submit([this, key, encoded]() { executeDecode(key, encoded); });
+    return nullptr;
+}
+
+void DecodedAudioCache::waitForPendingDecodes() {
+    m_executor.waitForSubmittedTasks();
+}
+
+size_t DecodedAudioCache::getCachedBytes() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_cachedBytes;
+}
+
+size_t DecodedAudioCache::getMaxBytes() const {
+    return m_maxBytes;
+}
+
+std::string DecodedAudioCache::buildContentKey(const std::string& encoded) {
+    // Hashing keeps the key small; including the size makes a collision between different sounds even less likely.
+    return std::to_string(std::hash<std::string>()(encoded)) + ":" + std::to_string(encoded.size());
+}
+
+void DecodedAudioCache::executeDecode(const std::string& key, const std::string& encoded) {
+    auto audio = m_decoder(encoded);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_pending.erase(key);
+    if (!audio || audio->pcm.empty()) {
+        ACSDK_WARN(LX("decodeFailed").d("encodedBytes", encoded.size()));
+        m_uncacheable.insert(key);
+        return;
+    }
+    auto size = audio->pcm.size();
+    if (size > m_maxBytes) {
+        ACSDK_WARN(LX("notCached").d("reason", "tooLarge").d("pcmBytes", size).d("maxBytes", m_maxBytes));
+        m_uncacheable.insert(key);
+        return;
+    }
+    while (m_cachedBytes + size > m_maxBytes && !m_lru.empty()) {
+        auto& oldest = m_lru.back();
+        ACSDK_DEBUG5(LX("evicting").d("pcmBytes", oldest.audio->pcm.size()));
+        m_cachedBytes -= oldest.audio->pcm.size();
+        m_entries.erase(oldest.key);
+        m_lru.pop_back();
+    }
+    m_lru.push_front({key, audio});
+    m_entries[key] = m_lru.begin();
+    m_cachedBytes += size;
+    ACSDK_DEBUG5(LX("cached").d("encodedBytes", encoded.size()).d("pcmBytes", size).d("cachedBytes", m_cachedBytes));
+}
+
+}  // namespace mediaPlayer
+}  // namespace alexaClientSDK
@@ -0,0 +1,152 @@
+/*
+ * Copyright 2017-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "MediaPlayer/DecodedAudioSource.h"
+
+namespace alexaClientSDK {
+namespace mediaPlayer {
+
+using namespace avsCommon::utils;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("DecodedAudioSource");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The number of bytes pushed to the pipeline with each buffer.
+static const size_t CHUNK_SIZE(4096);
+
+/// The number of nanoseconds in a second.
+static const guint64 NANOSECONDS_PER_SECOND(1000000000);
+
+std::unique_ptr<DecodedAudioSource> DecodedAudioSource::create(
+    PipelineInterface* pipeline,
+    std::shared_ptr<const DecodedAudio> audio,
+    bool repeat) {
+    if (!audio || audio->pcm.empty()) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "noDecodedAudio"));
+        return nullptr;
+    }
+    std::unique_ptr<DecodedAudioSource> result(new DecodedAudioSource(pipeline, audio, repeat));
+    if (result->init(&audio->format)) {
+        return result;
+    }
+    return nullptr;
+}
+
+DecodedAudioSource::DecodedAudioSource(
+    PipelineInterface* pipeline,
+    std::shared_ptr<const DecodedAudio> audio,
+    bool repeat) :
+        BaseStreamSource{pipeline, "DecodedAudioSource"},
+        m_audio{std::move(audio)},
+        m_repeat{repeat},
+        m_offset{0} {
+}
+
+DecodedAudioSource::~DecodedAudioSource() {
+    close();
+}
+
+void DecodedAudioSource::releaseAudio(gpointer pointer) {
+    delete static_cast<std::shared_ptr<const DecodedAudio>*>(pointer);
+}
+
+bool DecodedAudioSource::isPlaybackRemote() const {
+    return false;
+}
+
+bool DecodedAudioSource::hasAdditionalData() {
+    if (!m_repeat) {
+        return false;
+    }
+    m_offset = 0;
+    return true;
+}
+
+bool DecodedAudioSource::isOpen() {
+    return m_audio != nullptr;
+}
+
+void DecodedAudioSource::close() {
+    m_audio.reset();
+}
+
+gboolean DecodedAudioSource::handleReadData() {
+    if (!isOpen()) {
+        ACSDK_ERROR(LX("handleReadDataFailed").d("reason", "audioIsNullPtr"));
+        return false;
+    }
+
+    auto& pcm = m_audio->pcm;
+    if (m_offset >= pcm.size()) {
+        if (!m_repeat) {
+            signalEndOfData();
+            return false;
+        }
+        m_offset = 0;
+    }
+
+    auto size = std::min(CHUNK_SIZE, pcm.size() - m_offset);
+    // The buffer refers straight into the shared PCM and keeps it alive until GStreamer is done with the buffer.
+    auto buffer = gst_buffer_new_wrapped_full(
+        GST_MEMORY_FLAG_READONLY,
+        const_cast<unsigned char*>(pcm.data()),
+        pcm.size(),
+        m_offset,
+        size,
+        new std::shared_ptr<const DecodedAudio>(m_audio),
+        &DecodedAudioSource::releaseAudio);
+    if (!buffer) {
+        ACSDK_ERROR(LX("handleReadDataFailed").d("reason", "gstBufferNewWrappedFullFailed"));
+        signalEndOfData();
+        return false;
+    }
+    m_offset += size;
+
+    installOnReadDataHandler();
+    auto flowRet = gst_app_src_push_buffer(getAppSrc(), buffer);
+    if (flowRet != GST_FLOW_OK) {
+        ACSDK_ERROR(LX("handleReadDataFailed")
+                        .d("reason", "gstAppSrcPushBufferFailed")
+                        .d("error", gst_flow_get_name(flowRet)));
+        return false;
+    }
+    return true;
+}
+
+gboolean DecodedAudioSource::handleSeekData(guint64 offset) {
+    if (!isOpen()) {
+        return false;
+    }
+    // Raw audio is pushed in GST_FORMAT_TIME, so the offset is in nanoseconds.
+    auto& format = m_audio->format;
+    guint64 bytesPerFrame = format.numChannels * format.sampleSizeInBits / 8;
+    guint64 frame = offset * format.sampleRateHz / NANOSECONDS_PER_SECOND;
+    m_offset = static_cast<size_t>(std::min<guint64>(frame * bytesPerFrame, m_audio->pcm.size()));
+    return true;
+}
+
+}  // namespace mediaPlayer
+}  // namespace alexaClientSDK
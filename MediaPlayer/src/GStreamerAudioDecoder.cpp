@@ -0,0 +1,187 @@
+/*
+ * Copyright 2017-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <chrono>
+#include <cstring>
+
+#include <gst/gst.h>
+#include <gst/app/gstappsink.h>
+#include <gst/app/gstappsrc.h>
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "MediaPlayer/GStreamerAudioDecoder.h"
+
+namespace alexaClientSDK {
+namespace mediaPlayer {
+
+using namespace avsCommon::utils;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("GStreamerAudioDecoder");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// The decoding pipeline.  decodebin's source pad is linked to audioconvert once the stream type is known.
+static const char* DECODE_PIPELINE_DESCRIPTION =
+    "appsrc name=src ! decodebin ! audioconvert ! audio/x-raw,format=S16LE,layout=interleaved ! "
+    "appsink name=sink sync=false";
+
+/// How long to wait for each decoded sample before checking the bus for errors.
+static const GstClockTime PULL_TIMEOUT = 100 * GST_MSECOND;
+
+/// The longest a single sound may take to decode.
+static const std::chrono::seconds DECODE_TIMEOUT(10);
+
+/// The number of bits in each decoded sample.
+static const unsigned int DECODED_SAMPLE_SIZE_IN_BITS = 16;
+
+/**
+ * Pull every decoded sample from @c sink into @c audio.
+ *
+ * @param pipeline The decoding pipeline.
+ * @param sink The appsink at the end of the pipeline.
+ * @param[out] audio The audio to fill in.
+ * @return Whether the whole sound was decoded.
+ */
+static bool pullDecodedAudio(GstElement* pipeline, GstAppSink* sink, DecodedAudio* audio) {
+    auto bus = gst_element_get_bus(pipeline);
+    auto deadline = std::chrono::steady_clock::now() + DECODE_TIMEOUT;
+    bool formatKnown = false;
+    bool result = false;
+    while (std::chrono::steady_clock::now() < deadline) {
+        auto sample = gst_app_sink_try_pull_sample(sink, PULL_TIMEOUT);
+        if (!sample) {
+            if (gst_app_sink_is_eos(sink)) {
+                result = formatKnown;
+                break;
+            }
+            auto message = gst_bus_pop_filtered(bus, GST_MESSAGE_ERROR);
+            if (message) {
+                GError* error = nullptr;
+                gst_message_parse_error(message, &error, nullptr);
+                ACSDK_ERROR(LX("decodeFailed").d("reason", "pipelineError").d("error", error ? error->message : ""));
+                if (error) {
+                    g_error_free(error);
+                }
+                gst_message_unref(message);
+                break;
+            }
+            continue;
+        }
+
+        if (!formatKnown) {
+            auto caps = gst_sample_get_caps(sample);
+            auto structure = caps ? gst_caps_get_structure(caps, 0) : nullptr;
+            gint rate = 0;
+            gint channels = 0;
+            if (!structure || !gst_structure_get_int(structure, "rate", &rate) ||
+                !gst_structure_get_int(structure, "channels", &channels) || rate <= 0 || channels <= 0) {
+                ACSDK_ERROR(LX("decodeFailed").d("reason", "unknownDecodedFormat"));
+                gst_sample_unref(sample);
+                break;
+            }
+            audio->format.encoding = AudioFormat::Encoding::LPCM;
+            audio->format.endianness = AudioFormat::Endianness::LITTLE;
+            audio->format.sampleRateHz = static_cast<unsigned int>(rate);
+            audio->format.sampleSizeInBits = DECODED_SAMPLE_SIZE_IN_BITS;
+            audio->format.numChannels = static_cast<unsigned int>(channels);
+            audio->format.dataSigned = true;
+            audio->format.layout = AudioFormat::Layout::INTERLEAVED;
+            formatKnown = true;
+        }
+
+        auto buffer = gst_sample_get_buffer(sample);
+        GstMapInfo info;
+        if (buffer && gst_buffer_map(buffer, &info, GST_MAP_READ)) {
+            audio->pcm.insert(audio->pcm.end(), info.data, info.data + info.size);
+            gst_buffer_unmap(buffer, &info);
+        }
+        gst_sample_unref(sample);
+    }
+    gst_object_unref(bus);
+    return result;
+}
+
+std::shared_ptr<const DecodedAudio> decodeWithGStreamer(const std::string& encoded) {
+    if (encoded.empty()) {
+        ACSDK_ERROR(LX("decodeFailed").d("reason", "emptyInput"));
+        return nullptr;
+    }
+
+    GError* error = nullptr;
+    auto pipeline = gst_parse_launch(DECODE_PIPELINE_DESCRIPTION, &error);
+    if (error) {
+        ACSDK_ERROR(LX("decodeFailed").d("reason", "gstParseLaunchFailed").d("error", error->message));
+        g_error_free(error);
+        if (pipeline) {
+            gst_object_unref(pipeline);
+        }
+        return nullptr;
+    }
+    if (!pipeline) {
+        ACSDK_ERROR(LX("decodeFailed").d("reason", "gstParseLaunchFailed"));
+        return nullptr;
+    }
+
+    auto src = gst_bin_get_by_name(GST_BIN(pipeline), "src");
+    auto sink = gst_bin_get_by_name(GST_BIN(pipeline), "sink");
+    std::shared_ptr<DecodedAudio> audio;
+    if (!src || !sink) {
+        ACSDK_ERROR(LX("decodeFailed").d("reason", "pipelineElementsMissing"));
+    } else if (GST_STATE_CHANGE_FAILURE == gst_element_set_state(pipeline, GST_STATE_PLAYING)) {
+        ACSDK_ERROR(LX("decodeFailed").d("reason", "setStatePlayingFailed"));
+    } else {
+        // The whole sound is handed to appsrc in one buffer, followed by end of stream.
+        auto data = g_malloc(encoded.size());
+        memcpy(data, encoded.data(), encoded.size());
+        auto buffer = gst_buffer_new_wrapped(data, encoded.size());
+        if (GST_FLOW_OK == gst_app_src_push_buffer(GST_APP_SRC(src), buffer) &&
+            GST_FLOW_OK == gst_app_src_end_of_stream(GST_APP_SRC(src))) {
+            audio = std::make_shared<DecodedAudio>();
+            if (!pullDecodedAudio(pipeline, GST_APP_SINK(sink), audio.get())) {
+                audio.reset();
+            }
+        } else {
+            ACSDK_ERROR(LX("decodeFailed").d("reason", "gstAppSrcPushBufferFailed"));
+        }
+    }
+
+    gst_element_set_state(pipeline, GST_STATE_NULL);
+    if (src) {
+        gst_object_unref(src);
+    }
+    if (sink) {
+        gst_object_unref(sink);
+    }
+    gst_object_unref(pipeline);
+
+    if (audio) {
+        ACSDK_DEBUG5(LX("decoded")
+                         .d("encodedBytes", encoded.size())
+                         .d("pcmBytes", audio->pcm.size())
+                         .d("sampleRateHz", audio->format.sampleRateHz)
+                         .d("numChannels", audio->format.numChannels));
+    }
+    return audio;
+}
+
+}  // namespace mediaPlayer
+}  // namespace alexaClientSDK
@@ -103,20 +103,28 @@ gboolean IStreamSource::handleReadData() {
         return false;
     }
 
-    if (m_repeat && m_stream->eof()) {
-        m_stream->clear();
-        m_stream->seekg(0);
-    }
+    unsigned long size = 0;
+    /*
+     * The whole stream is available, so a read which returns nothing is at its end.  A repeating stream is rewound and
+     * read again once, which only returns nothing if the stream is empty.
+     */
+    for (int attempt = 0; 0 == size && attempt < 2; ++attempt) {
+        if (m_repeat && m_stream->eof()) {
+            m_stream->clear();
+            m_stream->seekg(0);
+        }
 
-    m_stream->read(reinterpret_cast<std::istream::char_type*>(info.data), info.size);
+        m_stream->read(reinterpret_cast<std::istream::char_type*>(info.data), info.size);
 
-    unsigned long size;
-    if (m_stream->bad()) {
-        size = 0;
-        ACSDK_WARN(LX("readFailed").d("bad", m_stream->bad()).d("eof", m_stream->eof()));
-    } else {
+        if (m_stream->bad()) {
+            ACSDK_WARN(LX("readFailed").d("bad", m_stream->bad()).d("eof", m_stream->eof()));
+            break;
+        }
         size = m_stream->gcount();
         ACSDK_DEBUG9(LX("read").d("size", size).d("pos", m_stream->tellg()).d("eof", m_stream->eof()));
+        if (!m_repeat || !m_stream->eof()) {
+            break;
+        }
     }
 
     gst_buffer_unmap(buffer, &info);
@@ -137,15 +145,9 @@ gboolean IStreamSource::handleReadData() {
         }
     }
 
-    if (m_stream->bad() || (!m_repeat && m_stream->eof())) {
-        gst_buffer_unref(buffer);
-        signalEndOfData();
-        return false;
-    }
-
     gst_buffer_unref(buffer);
-    updateOnReadDataHandler();
-    return true;
+    signalEndOfData();
+    return false;
 }
 
 gboolean IStreamSource::handleSeekData(guint64 offset) {
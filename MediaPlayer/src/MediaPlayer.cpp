@@ -13,6 +13,7 @@
  * permissions and limitations under the License.
  */
 
+#include <algorithm>
 #include <cmath>
 #include <cstring>
 #include <unordered_map>
@@ -21,11 +22,13 @@
 #include <AVSCommon/AVS/SpeakerConstants/SpeakerConstants.h>
 #include <AVSCommon/Utils/Logger/Logger.h>
 #include <AVSCommon/Utils/Memory/Memory.h>
+#include <AVSCommon/Utils/Stream/Streambuf.h>
 #include <PlaylistParser/PlaylistParser.h>
 #include <PlaylistParser/UrlContentToAttachmentConverter.h>
 
 #include "MediaPlayer/AttachmentReaderSource.h"
 #include "MediaPlayer/ErrorTypeConversion.h"
+#include "MediaPlayer/DecodedAudioSource.h"
 #include "MediaPlayer/IStreamSource.h"
 #include "MediaPlayer/Normalizer.h"
 
@@ -46,6 +49,32 @@ using namespace avsCommon::utils::configuration;
 static const std::string TAG("MediaPlayer");
 
 static const std::string MEDIAPLAYER_CONFIGURATION_ROOT_KEY = "gstreamerMediaPlayer";
+/// The key in our config file to run all players on one shared GLib main loop thread.
+static const std::string MEDIAPLAYER_SHARED_MAIN_LOOP_KEY = "sharedMainLoop";
+/// The key in our config file to keep the pipeline warm between sources.
+static const std::string MEDIAPLAYER_PERSISTENT_PIPELINE_KEY = "persistentPipeline";
+/// The key in our config file for the size of the decoded PCM cache for short sounds (0 disables it).
+static const std::string MEDIAPLAYER_DECODED_AUDIO_CACHE_BYTES_KEY = "decodedAudioCacheBytes";
+/// The key in our config file to enable the output tap.
+static const std::string MEDIAPLAYER_OUTPUT_TAP_ROOT_KEY = "outputTap";
+/// The key in the output tap config for the sample rate of the tapped audio.
+static const std::string OUTPUT_TAP_SAMPLE_RATE_KEY = "sampleRateHz";
+/// The key in the output tap config for the number of channels of the tapped audio.
+static const std::string OUTPUT_TAP_NUM_CHANNELS_KEY = "numChannels";
+/// The key in the output tap config for how much audio the tap's stream holds.
+static const std::string OUTPUT_TAP_BUFFER_MILLISECONDS_KEY = "bufferMilliseconds";
+/// The key in the output tap config for the maximum number of readers of the tap's stream.
+static const std::string OUTPUT_TAP_MAX_READERS_KEY = "maxReaders";
+/// The default sample rate of the tapped audio.
+static const int DEFAULT_OUTPUT_TAP_SAMPLE_RATE_HZ = 16000;
+/// The default number of channels of the tapped audio.
+static const int DEFAULT_OUTPUT_TAP_NUM_CHANNELS = 1;
+/// The default amount of audio the tap's stream holds.
+static const int DEFAULT_OUTPUT_TAP_BUFFER_MILLISECONDS = 2000;
+/// The default maximum number of readers of the tap's stream.
+static const int DEFAULT_OUTPUT_TAP_MAX_READERS = 2;
+/// The most audio the output tap branch queues before it drops the oldest, so it never holds up playback.
+static const guint64 OUTPUT_TAP_QUEUE_MAX_TIME = 200 * GST_MSECOND;
 /// The key in our config file to find the output conversion type.
 static const std::string MEDIAPLAYER_OUTPUT_CONVERSION_ROOT_KEY = "outputConversion";
 /// The acceptable conversion keys to find in the config file
@@ -158,15 +187,31 @@ std::shared_ptr<MediaPlayer> MediaPlayer::create(
 MediaPlayer::~MediaPlayer() {
     ACSDK_DEBUG9(LX("~MediaPlayerCalled"));
     cleanUpSource();
-    g_main_loop_quit(m_mainLoop);
-    if (m_mainLoopThread.joinable()) {
-        m_mainLoopThread.join();
+    if (m_sharedMainLoop) {
+        // The loop keeps running for other players, so detach from it before tearing down the pipeline.
+        if (m_busWatchId) {
+            g_source_remove(m_busWatchId);
+            m_busWatchId = 0;
+        }
+        m_sharedMainLoop->waitForPendingCallbacks();
+        m_sharedMainLoop.reset();
+    } else if (m_mainLoop) {
+        g_main_loop_quit(m_mainLoop);
+        if (m_mainLoopThread.joinable()) {
+            m_mainLoopThread.join();
+        }
+    }
+    if (m_pipeline.pipeline) {
+        gst_object_unref(m_pipeline.pipeline);
     }
-    gst_object_unref(m_pipeline.pipeline);
     resetPipeline();
 
-    g_source_remove(m_busWatchId);
-    g_main_loop_unref(m_mainLoop);
+    if (m_busWatchId) {
+        g_source_remove(m_busWatchId);
+    }
+    if (m_mainLoop) {
+        g_main_loop_unref(m_mainLoop);
+    }
 }
 
 MediaPlayer::SourceId MediaPlayer::setSource(
@@ -189,8 +234,9 @@ MediaPlayer::SourceId MediaPlayer::setSource(std::shared_ptr<std::istream> strea
     ACSDK_DEBUG9(LX("setSourceCalled").d("sourceType", "istream"));
     std::promise<MediaPlayer::SourceId> promise;
     auto future = promise.get_future();
-    std::function<gboolean()> callback = [this, &stream, repeat, &promise]() {
-        handleSetIStreamSource(stream, repeat, &promise);
+    auto decodedAudio = lookUpDecodedAudio(stream);
+    std::function<gboolean()> callback = [this, &stream, &decodedAudio, repeat, &promise]() {
+        handleSetIStreamSource(stream, decodedAudio, repeat, &promise);
         return false;
     };
     if (queueCallback(&callback) != UNQUEUED_CALLBACK) {
@@ -286,6 +332,20 @@ bool MediaPlayer::resume(MediaPlayer::SourceId id) {
     return false;
 }
 
+bool MediaPlayer::preroll(MediaPlayer::SourceId id) {
+    ACSDK_DEBUG9(LX("prerollCalled"));
+    std::promise<bool> promise;
+    auto future = promise.get_future();
+    std::function<gboolean()> callback = [this, id, &promise]() {
+        handlePreroll(id, &promise);
+        return false;
+    };
+    if (queueCallback(&callback) != UNQUEUED_CALLBACK) {
+        return future.get();
+    }
+    return false;
+}
+
 std::chrono::milliseconds MediaPlayer::getOffset(MediaPlayer::SourceId id) {
     ACSDK_DEBUG9(LX("getOffsetCalled"));
     std::promise<std::chrono::milliseconds> promise;
@@ -301,6 +361,21 @@ std::chrono::milliseconds MediaPlayer::getOffset(MediaPlayer::SourceId id) {
     return MEDIA_PLAYER_INVALID_OFFSET;
 }
 
+std::chrono::milliseconds MediaPlayer::getDuration(MediaPlayer::SourceId id) {
+    ACSDK_DEBUG9(LX("getDurationCalled"));
+    std::promise<std::chrono::milliseconds> promise;
+    auto future = promise.get_future();
+    std::function<gboolean()> callback = [this, id, &promise]() {
+        handleGetDuration(id, &promise);
+        return false;
+    };
+
+    if (queueCallback(&callback) != UNQUEUED_CALLBACK) {
+        return future.get();
+    }
+    return MEDIA_PLAYER_INVALID_OFFSET;
+}
+
 void MediaPlayer::setObserver(std::shared_ptr<MediaPlayerObserverInterface> observer) {
     ACSDK_DEBUG9(LX("setObserverCalled"));
     std::promise<void> promise;
@@ -538,16 +613,23 @@ MediaPlayer::MediaPlayer(
         m_isMuted{false},
         m_contentFetcherFactory{contentFetcherFactory},
         m_speakerType{type},
+        m_mainLoop{nullptr},
+        m_busWatchId{0},
         m_playbackStartedSent{false},
         m_playbackFinishedSent{false},
         m_isPaused{false},
         m_isBufferUnderrun{false},
+        m_isPrerolled{false},
         m_playerObserver{nullptr},
         m_currentId{ERROR},
         m_playPending{false},
         m_pausePending{false},
         m_resumePending{false},
-        m_pauseImmediately{false} {
+        m_pauseImmediately{false},
+        m_persistentPipeline{false},
+        m_pipelineNeedsReset{false},
+        m_pipelineReused{false},
+        m_outputTapAnchorPts{GST_CLOCK_TIME_NONE} {
 }
 
 bool MediaPlayer::init() {
@@ -556,12 +638,56 @@ bool MediaPlayer::init() {
         return false;
     }
 
-    if (!(m_mainLoop = g_main_loop_new(nullptr, false))) {
-        ACSDK_ERROR(LX("initPlayerFailed").d("reason", "gstMainLoopNewFailed"));
-        return false;
-    };
+    bool useSharedMainLoop = false;
+    auto configurationRoot = ConfigurationNode::getRoot()[MEDIAPLAYER_CONFIGURATION_ROOT_KEY];
+    configurationRoot.getBool(MEDIAPLAYER_SHARED_MAIN_LOOP_KEY, &useSharedMainLoop, false);
+    configurationRoot.getBool(MEDIAPLAYER_PERSISTENT_PIPELINE_KEY, &m_persistentPipeline, false);
+    int decodedAudioCacheBytes = 0;
+    configurationRoot.getInt(MEDIAPLAYER_DECODED_AUDIO_CACHE_BYTES_KEY, &decodedAudioCacheBytes, 0);
+    if (decodedAudioCacheBytes > 0) {
+        m_decodedAudioCache = DecodedAudioCache::acquire(static_cast<size_t>(decodedAudioCacheBytes));
+    }
+
+    auto outputTapConfiguration = configurationRoot[MEDIAPLAYER_OUTPUT_TAP_ROOT_KEY];
+    if (outputTapConfiguration) {
+        int sampleRateHz = 0;
+        int numChannels = 0;
+        int bufferMilliseconds = 0;
+        int maxReaders = 0;
+        outputTapConfiguration.getInt(OUTPUT_TAP_SAMPLE_RATE_KEY, &sampleRateHz, DEFAULT_OUTPUT_TAP_SAMPLE_RATE_HZ);
+        outputTapConfiguration.getInt(OUTPUT_TAP_NUM_CHANNELS_KEY, &numChannels, DEFAULT_OUTPUT_TAP_NUM_CHANNELS);
+        outputTapConfiguration.getInt(
+            OUTPUT_TAP_BUFFER_MILLISECONDS_KEY, &bufferMilliseconds, DEFAULT_OUTPUT_TAP_BUFFER_MILLISECONDS);
+        outputTapConfiguration.getInt(OUTPUT_TAP_MAX_READERS_KEY, &maxReaders, DEFAULT_OUTPUT_TAP_MAX_READERS);
+        if (sampleRateHz <= 0 || numChannels <= 0 || bufferMilliseconds <= 0 || maxReaders <= 0) {
+            ACSDK_ERROR(LX("initPlayerFailed").d("reason", "invalidOutputTapConfiguration"));
+            return false;
+        }
+        m_outputTap = OutputTap::create(
+            static_cast<unsigned int>(sampleRateHz),
+            static_cast<unsigned int>(numChannels),
+            std::chrono::milliseconds(bufferMilliseconds),
+            static_cast<size_t>(maxReaders));
+        if (!m_outputTap) {
+            ACSDK_ERROR(LX("initPlayerFailed").d("reason", "createOutputTapFailed"));
+            return false;
+        }
+    }
+
+    if (useSharedMainLoop) {
+        m_sharedMainLoop = SharedMainLoop::acquire();
+        if (!m_sharedMainLoop) {
+            ACSDK_ERROR(LX("initPlayerFailed").d("reason", "acquireSharedMainLoopFailed"));
+            return false;
+        }
+    } else {
+        if (!(m_mainLoop = g_main_loop_new(nullptr, false))) {
+            ACSDK_ERROR(LX("initPlayerFailed").d("reason", "gstMainLoopNewFailed"));
+            return false;
+        };
 
-    m_mainLoopThread = std::thread(g_main_loop_run, m_mainLoop);
+        m_mainLoopThread = std::thread(g_main_loop_run, m_mainLoop);
+    }
 
     if (!setupPipeline()) {
         ACSDK_ERROR(LX("initPlayerFailed").d("reason", "setupPipelineFailed"));
@@ -685,17 +811,26 @@ bool MediaPlayer::setupPipeline() {
         m_pipeline.audioSink,
         nullptr);
 
+    if (!gst_element_link_many(m_pipeline.decodedQueue, m_pipeline.converter, m_pipeline.volume, nullptr)) {
+        ACSDK_ERROR(LX("setupPipelineFailed").d("reason", "createQueueToVolumeLinkFailed"));
+        return false;
+    }
+
+    // The sink is fed from the volume element, or from the tee which also feeds the output tap.
+    GstElement* output = m_pipeline.volume;
+    if (m_outputTap) {
+        if (!setupOutputTapBranch()) {
+            ACSDK_ERROR(LX("setupPipelineFailed").d("reason", "setupOutputTapBranchFailed"));
+            return false;
+        }
+        output = m_pipeline.tee;
+    }
+
     if (m_pipeline.resample != nullptr && m_pipeline.caps != nullptr) {
         // Set up pipeline with the resampler
         gst_bin_add_many(GST_BIN(m_pipeline.pipeline), m_pipeline.resample, m_pipeline.caps, nullptr);
 
-        if (!gst_element_link_many(
-                m_pipeline.decodedQueue,
-                m_pipeline.converter,
-                m_pipeline.volume,
-                m_pipeline.resample,
-                m_pipeline.caps,
-                nullptr)) {
+        if (!gst_element_link_many(output, m_pipeline.resample, m_pipeline.caps, nullptr)) {
             ACSDK_ERROR(LX("setupPipelineFailed").d("reason", "createVolumeToConverterLinkFailed"));
             return false;
         }
@@ -706,8 +841,7 @@ bool MediaPlayer::setupPipeline() {
         }
     } else {
         // No output format specified, set up a normal pipeline
-        if (!gst_element_link_many(
-                m_pipeline.decodedQueue, m_pipeline.converter, m_pipeline.volume, m_pipeline.audioSink, nullptr)) {
+        if (!gst_element_link(output, m_pipeline.audioSink)) {
             ACSDK_ERROR(LX("setupPipelineFailed").d("reason", "createResampleToSinkLinkFailed"));
             return false;
         }
@@ -716,6 +850,167 @@ bool MediaPlayer::setupPipeline() {
     return true;
 }
 
+bool MediaPlayer::setupOutputTapBranch() {
+    m_pipeline.tee = gst_element_factory_make("tee", "outputTee");
+    m_pipeline.tapQueue = gst_element_factory_make("queue", "tapQueue");
+    m_pipeline.tapConverter = gst_element_factory_make("audioconvert", "tapConverter");
+    m_pipeline.tapResample = gst_element_factory_make("audioresample", "tapResample");
+    m_pipeline.tapCaps = gst_element_factory_make("capsfilter", "tapCaps");
+    m_pipeline.tapSink = gst_element_factory_make("appsink", "tapSink");
+    if (!m_pipeline.tee || !m_pipeline.tapQueue || !m_pipeline.tapConverter || !m_pipeline.tapResample ||
+        !m_pipeline.tapCaps || !m_pipeline.tapSink) {
+        ACSDK_ERROR(LX("setupOutputTapBranchFailed").d("reason", "createElementFailed"));
+        return false;
+    }
+
+    /*
+     * The queue gives the tap branch its own thread, and drops the oldest audio rather than blocking if the branch
+     * falls behind, so the tap never delays the audio sink.
+     */
+    g_object_set(
+        m_pipeline.tapQueue,
+        "leaky",
+        2,
+        "silent",
+        TRUE,
+        "max-size-buffers",
+        0,
+        "max-size-bytes",
+        0,
+        "max-size-time",
+        OUTPUT_TAP_QUEUE_MAX_TIME,
+        NULL);
+
+    auto format = m_outputTap->getFormat();
+    GstCaps* tapCaps = gst_caps_new_simple(
+        "audio/x-raw",
+        "format",
+        G_TYPE_STRING,
+        "S16LE",
+        "layout",
+        G_TYPE_STRING,
+        "interleaved",
+        "rate",
+        G_TYPE_INT,
+        static_cast<gint>(format.sampleRateHz),
+        "channels",
+        G_TYPE_INT,
+        static_cast<gint>(format.numChannels),
+        NULL);
+    if (!tapCaps) {
+        ACSDK_ERROR(LX("setupOutputTapBranchFailed").d("reason", "createCapabilityStructFailed"));
+        return false;
+    }
+    g_object_set(G_OBJECT(m_pipeline.tapCaps), "caps", tapCaps, NULL);
+    gst_caps_unref(tapCaps);
+
+    // The tap must neither wait for the clock nor hold up prerolling the pipeline.
+    g_object_set(m_pipeline.tapSink, "sync", FALSE, "async", FALSE, NULL);
+    GstAppSinkCallbacks callbacks = {};
+    callbacks.eos = &MediaPlayer::onOutputTapEos;
+    callbacks.new_sample = &MediaPlayer::onOutputTapSample;
+    gst_app_sink_set_callbacks(GST_APP_SINK(m_pipeline.tapSink), &callbacks, this, nullptr);
+
+    gst_bin_add_many(
+        GST_BIN(m_pipeline.pipeline),
+        m_pipeline.tee,
+        m_pipeline.tapQueue,
+        m_pipeline.tapConverter,
+        m_pipeline.tapResample,
+        m_pipeline.tapCaps,
+        m_pipeline.tapSink,
+        nullptr);
+
+    if (!gst_element_link(m_pipeline.volume, m_pipeline.tee)) {
+        ACSDK_ERROR(LX("setupOutputTapBranchFailed").d("reason", "createVolumeToTeeLinkFailed"));
+        return false;
+    }
+    if (!gst_element_link_many(
+            m_pipeline.tee,
+            m_pipeline.tapQueue,
+            m_pipeline.tapConverter,
+            m_pipeline.tapResample,
+            m_pipeline.tapCaps,
+            m_pipeline.tapSink,
+            nullptr)) {
+        ACSDK_ERROR(LX("setupOutputTapBranchFailed").d("reason", "createTeeToTapSinkLinkFailed"));
+        return false;
+    }
+
+    auto teeSinkPad = gst_element_get_static_pad(m_pipeline.tee, "sink");
+    if (!teeSinkPad) {
+        ACSDK_ERROR(LX("setupOutputTapBranchFailed").d("reason", "getTeeSinkPadFailed"));
+        return false;
+    }
+    gst_pad_add_probe(teeSinkPad, GST_PAD_PROBE_TYPE_BUFFER, &MediaPlayer::onOutputTapProbe, this, nullptr);
+    gst_object_unref(teeSinkPad);
+
+    return true;
+}
+
+GstPadProbeReturn MediaPlayer::onOutputTapProbe(GstPad* pad, GstPadProbeInfo* info, gpointer pointer) {
+    auto mediaPlayer = static_cast<MediaPlayer*>(pointer);
+    auto buffer = GST_PAD_PROBE_INFO_BUFFER(info);
+    if (buffer && GST_BUFFER_PTS_IS_VALID(buffer)) {
+        std::lock_guard<std::mutex> lock(mediaPlayer->m_outputTapAnchorMutex);
+        mediaPlayer->m_outputTapAnchorPts = GST_BUFFER_PTS(buffer);
+        mediaPlayer->m_outputTapAnchorTime = std::chrono::steady_clock::now();
+    }
+    return GST_PAD_PROBE_OK;
+}
+
+GstFlowReturn MediaPlayer::onOutputTapSample(GstAppSink* sink, gpointer pointer) {
+    auto mediaPlayer = static_cast<MediaPlayer*>(pointer);
+    auto sample = gst_app_sink_pull_sample(sink);
+    if (!sample) {
+        return GST_FLOW_OK;
+    }
+    auto buffer = gst_sample_get_buffer(sample);
+    if (!buffer) {
+        gst_sample_unref(sample);
+        return GST_FLOW_OK;
+    }
+
+    /*
+     * Work out when this audio went to the sink from the last buffer that passed the tee.  The tap branch keeps the
+     * timestamps of the audio it converts, so the difference in timestamps is the difference in time.
+     */
+    auto timestamp = std::chrono::steady_clock::now();
+    if (GST_BUFFER_PTS_IS_VALID(buffer)) {
+        std::lock_guard<std::mutex> lock(mediaPlayer->m_outputTapAnchorMutex);
+        if (GST_CLOCK_TIME_IS_VALID(mediaPlayer->m_outputTapAnchorPts)) {
+            auto offset = static_cast<int64_t>(GST_BUFFER_PTS(buffer)) -
+                          static_cast<int64_t>(mediaPlayer->m_outputTapAnchorPts);
+            timestamp = mediaPlayer->m_outputTapAnchorTime +
+                        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                            std::chrono::nanoseconds(offset));
+        }
+    }
+
+    GstMapInfo info;
+    if (gst_buffer_map(buffer, &info, GST_MAP_READ)) {
+        mediaPlayer->m_outputTap->write(info.data, info.size, timestamp);
+        gst_buffer_unmap(buffer, &info);
+    }
+    gst_sample_unref(sample);
+    return GST_FLOW_OK;
+}
+
+void MediaPlayer::onOutputTapEos(GstAppSink* sink, gpointer pointer) {
+    auto mediaPlayer = static_cast<MediaPlayer*>(pointer);
+    auto stats = mediaPlayer->m_outputTap->getLatencyStats();
+    if (stats.writes > 0) {
+        ACSDK_INFO(LX("outputTapLatency")
+                       .d("maxUs", stats.max.count())
+                       .d("averageUs", stats.average.count())
+                       .d("writes", stats.writes));
+    }
+}
+
+std::shared_ptr<OutputTap> MediaPlayer::getOutputTap() const {
+    return m_outputTap;
+}
+
 void MediaPlayer::tearDownTransientPipelineElements() {
     ACSDK_DEBUG9(LX("tearDownTransientPipelineElements"));
     saveOffsetBeforeTeardown();
@@ -723,7 +1018,14 @@ void MediaPlayer::tearDownTransientPipelineElements() {
         sendPlaybackStopped();
     }
     m_currentId = ERROR_SOURCE_ID;
-    cleanUpSource();
+    auto idleState = getIdleState();
+    cleanUpSource(idleState);
+    m_pipelineReused = GST_STATE_READY == idleState;
+    if (GST_STATE_NULL == idleState) {
+        m_pipelineNeedsReset = false;
+    }
+    m_setSourceTime = std::chrono::steady_clock::now();
+    m_playTime = std::chrono::steady_clock::time_point();
     m_offsetManager.clear();
     m_playPending = false;
     m_pausePending = false;
@@ -733,6 +1035,26 @@ void MediaPlayer::tearDownTransientPipelineElements() {
     m_playbackFinishedSent = false;
     m_isPaused = false;
     m_isBufferUnderrun = false;
+    m_isPrerolled = false;
+}
+
+GstState MediaPlayer::getIdleState() const {
+    return (m_persistentPipeline && !m_pipelineNeedsReset) ? GST_STATE_READY : GST_STATE_NULL;
+}
+
+void MediaPlayer::logPlaybackStartedLatency() {
+    auto now = std::chrono::steady_clock::now();
+    logger::LogEntry entry(TAG, "playbackStartedLatency");
+    entry.d("currentId", m_currentId).d("pipelineReused", m_pipelineReused);
+    if (m_setSourceTime != std::chrono::steady_clock::time_point()) {
+        entry.d("setSourceToPlaybackStartedMs",
+                std::chrono::duration_cast<std::chrono::milliseconds>(now - m_setSourceTime).count());
+    }
+    if (m_playTime != std::chrono::steady_clock::time_point()) {
+        entry.d("playToPlaybackStartedMs",
+                std::chrono::duration_cast<std::chrono::milliseconds>(now - m_playTime).count());
+    }
+    ACSDK_INFO(entry);
 }
 
 void MediaPlayer::resetPipeline() {
@@ -746,6 +1068,12 @@ void MediaPlayer::resetPipeline() {
     m_pipeline.resample = nullptr;
     m_pipeline.caps = nullptr;
     m_pipeline.audioSink = nullptr;
+    m_pipeline.tee = nullptr;
+    m_pipeline.tapQueue = nullptr;
+    m_pipeline.tapConverter = nullptr;
+    m_pipeline.tapResample = nullptr;
+    m_pipeline.tapCaps = nullptr;
+    m_pipeline.tapSink = nullptr;
 }
 
 bool MediaPlayer::queryIsSeekable(bool* isSeekable) {
@@ -809,9 +1137,11 @@ void MediaPlayer::onError() {
 
 void MediaPlayer::doShutdown() {
     gst_element_set_state(m_pipeline.pipeline, GST_STATE_NULL);
-    g_main_loop_quit(m_mainLoop);
-    if (m_mainLoopThread.joinable()) {
-        m_mainLoopThread.join();
+    if (m_mainLoop) {
+        g_main_loop_quit(m_mainLoop);
+        if (m_mainLoopThread.joinable()) {
+            m_mainLoopThread.join();
+        }
     }
     if (m_urlConverter) {
         m_urlConverter->shutdown();
@@ -888,8 +1218,8 @@ gboolean MediaPlayer::handleBusMessage(GstMessage* message) {
 
                 // Continue playback if there is additional data.
                 if (m_source->hasAdditionalData()) {
-                    if (GST_STATE_CHANGE_FAILURE == gst_element_set_state(m_pipeline.pipeline, GST_STATE_NULL)) {
-                        const std::string errorMessage{"reason=setPipelineToNullFailed"};
+                    if (GST_STATE_CHANGE_FAILURE == gst_element_set_state(m_pipeline.pipeline, getIdleState())) {
+                        const std::string errorMessage{"reason=setPipelineToIdleFailed"};
                         ACSDK_ERROR(LX("continuingPlaybackFailed").m(errorMessage));
                         sendPlaybackError(ErrorType::MEDIA_ERROR_INTERNAL_DEVICE_ERROR, errorMessage);
                         break;
@@ -918,6 +1248,8 @@ gboolean MediaPlayer::handleBusMessage(GstMessage* message) {
                             .d("error", error->message)
                             .d("debug", debug ? debug : "noInfo"));
             bool isPlaybackRemote = m_source ? m_source->isPlaybackRemote() : false;
+            // Do not trust the permanent elements after an error; the next source will start from a full reset.
+            m_pipelineNeedsReset = true;
             sendPlaybackError(gerrorToErrorType(error, isPlaybackRemote), error->message);
             g_error_free(error);
             g_free(debug);
@@ -1004,6 +1336,10 @@ gboolean MediaPlayer::handleBusMessage(GstMessage* message) {
                     // To avoid starting to play if a pause() was called immediately after calling a play()
                     break;
                 }
+                if (m_isPrerolled) {
+                    // A prerolled pipeline stays in PAUSED until play() is called.
+                    break;
+                }
                 bool isSeekable = false;
                 if (queryIsSeekable(&isSeekable)) {
                     m_offsetManager.setIsSeekable(isSeekable);
@@ -1087,15 +1423,78 @@ void MediaPlayer::handleSetAttachmentReaderSource(
     promise->set_value(m_currentId);
 }
 
+/**
+ * Read the rest of a stream which is small enough to be cached, and rewind it to where it was.
+ *
+ * @param stream The stream to read.
+ * @param maxBytes The largest number of bytes to read.
+ * @return The bytes read, or an empty string if the stream can't be rewound, is empty or is larger than @c maxBytes.
+ */
+static std::string readRewindableStream(std::istream& stream, size_t maxBytes) {
+    auto start = stream.tellg();
+    if (start < 0 || !stream.seekg(0, std::ios::end)) {
+        stream.clear();
+        return "";
+    }
+    auto end = stream.tellg();
+    stream.seekg(start);
+    if (end <= start || static_cast<size_t>(end - start) > maxBytes) {
+        return "";
+    }
+
+    std::string bytes(static_cast<size_t>(end - start), '\0');
+    stream.read(&bytes[0], bytes.size());
+    auto readSize = stream.gcount();
+    stream.clear();
+    stream.seekg(start);
+    if (readSize != static_cast<std::streamsize>(bytes.size())) {
+        return "";
+    }
+    return bytes;
+}
+
+std::shared_ptr<const DecodedAudio> MediaPlayer::lookUpDecodedAudio(std::shared_ptr<std::istream> stream) {
+    if (!m_decodedAudioCache || !stream) {
+        return nullptr;
+    }
+    auto maxBytes = m_decodedAudioCache->getMaxBytes();
+
+    // A stream over a resource with an identifier, such as a compiled-in or resource pack sound, is looked up by that
+    // identifier, so its bytes are only read the first time it is decoded.
+    auto buf = dynamic_cast<avsCommon::utils::stream::Streambuf*>(stream->rdbuf());
+    if (buf && !buf->getResourceId().empty()) {
+        auto decodedAudio = m_decodedAudioCache->get(
+            buf->getResourceId(), [&stream, maxBytes]() { return readRewindableStream(*stream, maxBytes); });
+        ACSDK_DEBUG5(LX("lookUpDecodedAudio").d("resourceId", buf->getResourceId()).d("hit", decodedAudio != nullptr));
+        return decodedAudio;
+    }
+
+    // Any other stream has to be read to be recognized.
+    auto encoded = readRewindableStream(*stream, maxBytes);
+    if (encoded.empty()) {
+        return nullptr;
+    }
+    auto decodedAudio =
+        m_decodedAudioCache->get(DecodedAudioCache::buildContentKey(encoded), [&encoded]() { return encoded; });
+    ACSDK_DEBUG5(LX("lookUpDecodedAudio").d("encodedBytes", encoded.size()).d("hit", decodedAudio != nullptr));
+    return decodedAudio;
+}
+
 void MediaPlayer::handleSetIStreamSource(
     std::shared_ptr<std::istream> stream,
+    std::shared_ptr<const DecodedAudio> decodedAudio,
     bool repeat,
     std::promise<MediaPlayer::SourceId>* promise) {
     ACSDK_DEBUG(LX("handleSetSourceCalled"));
 
     tearDownTransientPipelineElements();
 
-    std::shared_ptr<SourceInterface> source = IStreamSource::create(this, stream, repeat);
+    std::shared_ptr<SourceInterface> source;
+    if (decodedAudio) {
+        source = DecodedAudioSource::create(this, decodedAudio, repeat);
+    } else {
+        source = IStreamSource::create(this, stream, repeat);
+    }
 
     if (!source) {
         ACSDK_ERROR(LX("handleSetIStreamSourceFailed").d("reason", "sourceIsNullptr"));
@@ -1126,8 +1525,14 @@ void MediaPlayer::handleSetUrlSource(
 
     tearDownTransientPipelineElements();
 
+    // A URL which is a single file, rather than a playlist, may be a podcast or audiobook which is resumed later.
     m_urlConverter = alexaClientSDK::playlistParser::UrlContentToAttachmentConverter::create(
-        m_contentFetcherFactory, url, shared_from_this(), offset);
+        m_contentFetcherFactory,
+        url,
+        shared_from_this(),
+        offset,
+        alexaClientSDK::playlistParser::UrlContentToAttachmentConverter::DEFAULT_MAX_PREFETCH_SEGMENTS,
+        true);
     if (!m_urlConverter) {
         ACSDK_ERROR(LX("setSourceUrlFailed").d("reason", "badUrlConverter"));
         promise->set_value(ERROR_SOURCE_ID);
@@ -1179,6 +1584,8 @@ void MediaPlayer::handlePlay(SourceId id, std::promise<bool>* promise) {
     m_playbackStartedSent = false;
     m_playPending = true;
     m_pauseImmediately = false;
+    m_isPrerolled = false;
+    m_playTime = std::chrono::steady_clock::now();
     promise->set_value(true);
 
     GstState startingState = GST_STATE_PLAYING;
@@ -1225,8 +1632,12 @@ void MediaPlayer::handleStop(MediaPlayer::SourceId id, std::promise<bool>* promi
         return;
     }
 
-    // Only stop if currently not stopped.
-    if (curState == GST_STATE_NULL) {
+    /*
+     * Only stop if currently not stopped.  A pipeline parked in READY between sources has not started playing, but one
+     * that is in READY on its way to PLAYING (preroll after a play()) must still take the normal stop path.
+     */
+    if (curState == GST_STATE_NULL ||
+        (curState == GST_STATE_READY && m_persistentPipeline && GST_STATE_VOID_PENDING == pending && !m_playPending)) {
         ACSDK_ERROR(LX("handleStopFailed").d("reason", "alreadyStopped"));
         promise->set_value(false);
         return;
@@ -1257,6 +1668,46 @@ void MediaPlayer::handleStop(MediaPlayer::SourceId id, std::promise<bool>* promi
     }
 }
 
+void MediaPlayer::handlePreroll(MediaPlayer::SourceId id, std::promise<bool>* promise) {
+    ACSDK_DEBUG(LX("handlePrerollCalled").d("idPassed", id).d("currentId", (m_currentId)));
+    if (!validateSourceAndId(id)) {
+        ACSDK_ERROR(LX("handlePrerollFailed"));
+        promise->set_value(false);
+        return;
+    }
+
+    GstState curState;
+    auto stateChangeRet = gst_element_get_state(m_pipeline.pipeline, &curState, NULL, TIMEOUT_ZERO_NANOSECONDS);
+    if (GST_STATE_CHANGE_FAILURE == stateChangeRet) {
+        ACSDK_ERROR(LX("handlePrerollFailed").d("reason", "gstElementGetStateFailure"));
+        promise->set_value(false);
+        return;
+    }
+    if ((curState != GST_STATE_NULL && curState != GST_STATE_READY) || m_playPending) {
+        ACSDK_DEBUG(LX("handlePrerollFailed").d("reason", "alreadyStarted"));
+        promise->set_value(false);
+        return;
+    }
+
+    /*
+     * The initial seek is performed on the PAUSED -> PLAYING transition started by play(), which a prerolled pipeline
+     * has already passed.  Sources that start at an offset are left to play() instead.
+     */
+    if (m_urlConverter && m_urlConverter->getDesiredStreamingPoint() != std::chrono::milliseconds::zero()) {
+        ACSDK_DEBUG(LX("handlePrerollFailed").d("reason", "sourceStartsAtOffset"));
+        promise->set_value(false);
+        return;
+    }
+
+    if (GST_STATE_CHANGE_FAILURE == gst_element_set_state(m_pipeline.pipeline, GST_STATE_PAUSED)) {
+        ACSDK_ERROR(LX("handlePrerollFailed").d("reason", "gstElementSetStateFailure"));
+        promise->set_value(false);
+        return;
+    }
+    m_isPrerolled = true;
+    promise->set_value(true);
+}
+
 void MediaPlayer::handlePause(MediaPlayer::SourceId id, std::promise<bool>* promise) {
     ACSDK_DEBUG(LX("handlePauseCalled").d("idPassed", id).d("currentId", (m_currentId)));
     if (!validateSourceAndId(id)) {
@@ -1417,6 +1868,32 @@ void MediaPlayer::handleGetOffset(SourceId id, std::promise<std::chrono::millise
     promise->set_value(MEDIA_PLAYER_INVALID_OFFSET);
 }
 
+void MediaPlayer::handleGetDuration(SourceId id, std::promise<std::chrono::milliseconds>* promise) {
+    ACSDK_DEBUG(LX("handleGetDurationCalled").d("idPassed", id).d("currentId", (m_currentId)));
+    gint64 duration = -1;
+
+    if (!m_pipeline.pipeline || !validateSourceAndId(id)) {
+        promise->set_value(MEDIA_PLAYER_INVALID_OFFSET);
+        return;
+    }
+
+    // Live streams and sources which have not been prerolled yet do not report a duration.
+    if (!gst_element_query_duration(m_pipeline.pipeline, GST_FORMAT_TIME, &duration) || duration < 0) {
+        ACSDK_DEBUG(LX("handleGetDurationFailed").d("reason", "durationUnknown"));
+        promise->set_value(MEDIA_PLAYER_INVALID_OFFSET);
+        return;
+    }
+
+    // Offsets include the point at which streaming started, so the duration is reported on the same scale.
+    std::chrono::milliseconds startStreamingPoint = std::chrono::milliseconds::zero();
+    if (m_urlConverter) {
+        startStreamingPoint = m_urlConverter->getStartStreamingPoint();
+    }
+    promise->set_value(
+        startStreamingPoint +
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::nanoseconds(duration)));
+}
+
 void MediaPlayer::handleSetObserver(
     std::promise<void>* promise,
     std::shared_ptr<avsCommon::utils::mediaPlayer::MediaPlayerObserverInterface> observer) {
@@ -1428,6 +1905,7 @@ void MediaPlayer::handleSetObserver(
 void MediaPlayer::sendPlaybackStarted() {
     if (!m_playbackStartedSent) {
         ACSDK_DEBUG(LX("callingOnPlaybackStarted").d("currentId", m_currentId));
+        logPlaybackStartedLatency();
         m_playbackStartedSent = true;
         m_playPending = false;
         if (m_playerObserver) {
@@ -1545,9 +2023,9 @@ gboolean MediaPlayer::onErrorCallback(gpointer pointer) {
     return false;
 }
 
-void MediaPlayer::cleanUpSource() {
+void MediaPlayer::cleanUpSource(GstState idleState) {
     if (m_pipeline.pipeline) {
-        gst_element_set_state(m_pipeline.pipeline, GST_STATE_NULL);
+        gst_element_set_state(m_pipeline.pipeline, idleState);
     }
     if (m_source) {
         m_source->shutdown();
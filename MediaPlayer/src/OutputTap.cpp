@@ -0,0 +1,174 @@
+/*
+ * Copyright 2017-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "MediaPlayer/OutputTap.h"
+
+namespace alexaClientSDK {
+namespace mediaPlayer {
+
+using namespace avsCommon::avs;
+using namespace avsCommon::utils;
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("OutputTap");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+const unsigned int OutputTap::SAMPLE_SIZE_IN_BITS;
+
+std::shared_ptr<OutputTap> OutputTap::create(
+    unsigned int sampleRateHz,
+    unsigned int numChannels,
+    std::chrono::milliseconds bufferDuration,
+    size_t maxReaders) {
+    if (0 == sampleRateHz || 0 == numChannels) {
+        ACSDK_ERROR(LX("createFailed")
+                        .d("reason", "invalidFormat")
+                        .d("sampleRateHz", sampleRateHz)
+                        .d("numChannels", numChannels));
+        return nullptr;
+    }
+    size_t bufferFrames = static_cast<size_t>(bufferDuration.count()) * sampleRateHz / 1000;
+    if (0 == bufferFrames) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "zeroBufferDuration"));
+        return nullptr;
+    }
+
+    AudioFormat format;
+    format.encoding = AudioFormat::Encoding::LPCM;
+    format.endianness = AudioFormat::Endianness::LITTLE;
+    format.sampleRateHz = sampleRateHz;
+    format.sampleSizeInBits = SAMPLE_SIZE_IN_BITS;
+    format.numChannels = numChannels;
+    format.dataSigned = true;
+    format.layout = AudioFormat::Layout::INTERLEAVED;
+
+    size_t frameSize = numChannels * SAMPLE_SIZE_IN_BITS / 8;
+    auto bufferSize = AudioInputStream::calculateBufferSize(bufferFrames, frameSize, maxReaders);
+    auto buffer = std::make_shared<AudioInputStream::Buffer>(bufferSize);
+    std::shared_ptr<AudioInputStream> stream = AudioInputStream::create(buffer, frameSize, maxReaders);
+    if (!stream) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "createStreamFailed"));
+        return nullptr;
+    }
+
+    std::shared_ptr<OutputTap> tap(new OutputTap(format, bufferFrames, stream));
+    if (!tap->m_writer) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "createWriterFailed"));
+        return nullptr;
+    }
+    return tap;
+}
+
+OutputTap::OutputTap(const AudioFormat& format, size_t bufferFrames, std::shared_ptr<AudioInputStream> stream) :
+        m_format{format},
+        m_frameSize{format.numChannels * format.sampleSizeInBits / 8},
+        m_bufferFrames{bufferFrames},
+        m_stream{stream},
+        m_writer{stream->createWriter(AudioInputStream::Writer::Policy::NONBLOCKABLE)},
+        m_latencyWrites{0},
+        m_maxLatency{0},
+        m_totalLatency{0} {
+}
+
+std::shared_ptr<AudioInputStream> OutputTap::getStream() const {
+    return m_stream;
+}
+
+AudioFormat OutputTap::getFormat() const {
+    return m_format;
+}
+
+bool OutputTap::getTimestamp(AudioInputStream::Index index, TimePoint* timestamp) const {
+    if (!timestamp) {
+        ACSDK_ERROR(LX("getTimestampFailed").d("reason", "nullTimestamp"));
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_marks.empty() || index < m_marks.front().first || index >= m_writer->tell()) {
+        return false;
+    }
+    // Find the last write which started at or before the frame.
+    auto next = std::upper_bound(
+        m_marks.begin(),
+        m_marks.end(),
+        index,
+        [](AudioInputStream::Index value, const std::pair<AudioInputStream::Index, TimePoint>& mark) {
+            return value < mark.first;
+        });
+    auto& mark = *(next - 1);
+    auto offset = std::chrono::microseconds((index - mark.first) * 1000000 / m_format.sampleRateHz);
+    *timestamp = mark.second + offset;
+    return true;
+}
+
+size_t OutputTap::write(const void* data, size_t size, TimePoint timestamp) {
+    size_t frames = size / m_frameSize;
+    if (0 == frames) {
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto index = m_writer->tell();
+    auto written = m_writer->write(data, frames);
+    if (written <= 0) {
+        ACSDK_WARN(LX("writeFailed").d("frames", frames).d("result", written));
+        return 0;
+    }
+    m_marks.emplace_back(index, timestamp);
+
+    // The audio is now available to readers, so this is the latency the tap added to it.
+    auto latency = std::max(
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - timestamp),
+        std::chrono::microseconds::zero());
+    m_latencyWrites++;
+    m_maxLatency = std::max(m_maxLatency, latency);
+    m_totalLatency += latency;
+
+    // Forget the times of frames which have been overwritten.
+    auto end = m_writer->tell();
+    auto oldest = end > m_bufferFrames ? end - m_bufferFrames : 0;
+    while (m_marks.size() > 1 && m_marks[1].first <= oldest) {
+        m_marks.pop_front();
+    }
+    if (m_marks.front().first < oldest) {
+        m_marks.front().second += std::chrono::microseconds(
+            (oldest - m_marks.front().first) * 1000000 / m_format.sampleRateHz);
+        m_marks.front().first = oldest;
+    }
+    return static_cast<size_t>(written);
+}
+
+OutputTap::LatencyStats OutputTap::getLatencyStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    LatencyStats stats;
+    stats.writes = m_latencyWrites;
+    stats.max = m_maxLatency;
+    stats.average = m_latencyWrites > 0 ? m_totalLatency / static_cast<int64_t>(m_latencyWrites)
+                                        : std::chrono::microseconds::zero();
+    return stats;
+}
+
+}  // namespace mediaPlayer
+}  // namespace alexaClientSDK
@@ -0,0 +1,95 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <future>
+#include <mutex>
+
+#include <AVSCommon/Utils/Logger/Logger.h>
+
+#include "MediaPlayer/SharedMainLoop.h"
+
+namespace alexaClientSDK {
+namespace mediaPlayer {
+
+/// String to identify log entries originating from this file.
+static const std::string TAG("SharedMainLoop");
+
+/**
+ * Create a LogEntry using this file's TAG and the specified event string.
+ *
+ * @param The event string for this @c LogEntry.
+ */
+#define LX(event) alexaClientSDK::avsCommon::utils::logger::LogEntry(TAG, event)
+
+/// Serializes starting and stopping the shared main loop.
+static std::mutex g_sharedMainLoopMutex;
+
+/// The shared main loop, if any player currently holds it.  The access to this variable is guarded by
+/// @c g_sharedMainLoopMutex.
+static std::weak_ptr<SharedMainLoop> g_sharedMainLoop;
+
+std::shared_ptr<SharedMainLoop> SharedMainLoop::acquire() {
+    std::lock_guard<std::mutex> lock(g_sharedMainLoopMutex);
+    auto sharedMainLoop = g_sharedMainLoop.lock();
+    if (sharedMainLoop) {
+        return sharedMainLoop;
+    }
+
+    auto mainLoop = g_main_loop_new(nullptr, false);
+    if (!mainLoop) {
+        ACSDK_ERROR(LX("acquireFailed").d("reason", "gMainLoopNewFailed"));
+        return nullptr;
+    }
+    ACSDK_DEBUG5(LX("startingSharedMainLoop"));
+    sharedMainLoop = std::shared_ptr<SharedMainLoop>(new SharedMainLoop(mainLoop));
+    g_sharedMainLoop = sharedMainLoop;
+    return sharedMainLoop;
+}
+
+SharedMainLoop::~SharedMainLoop() {
+    ACSDK_DEBUG5(LX("stoppingSharedMainLoop"));
+    g_main_loop_quit(m_mainLoop);
+    if (m_mainLoopThread.joinable()) {
+        if (std::this_thread::get_id() == m_mainLoopThread.get_id()) {
+            // The last player was released from one of its own callbacks; the loop exits once that callback returns.
+            m_mainLoopThread.detach();
+        } else {
+            m_mainLoopThread.join();
+        }
+    }
+    g_main_loop_unref(m_mainLoop);
+}
+
+void SharedMainLoop::waitForPendingCallbacks() {
+    if (std::this_thread::get_id() == m_mainLoopThread.get_id()) {
+        return;
+    }
+    std::promise<void> promise;
+    auto future = promise.get_future();
+    g_idle_add(&SharedMainLoop::onPendingCallbacksDone, &promise);
+    future.wait();
+}
+
+SharedMainLoop::SharedMainLoop(GMainLoop* mainLoop) : m_mainLoop{mainLoop} {
+    m_mainLoopThread = std::thread(g_main_loop_run, m_mainLoop);
+}
+
+gboolean SharedMainLoop::onPendingCallbacksDone(gpointer pointer) {
+    static_cast<std::promise<void>*>(pointer)->set_value();
+    return false;
+}
+
+}  // namespace mediaPlayer
+}  // namespace alexaClientSDK
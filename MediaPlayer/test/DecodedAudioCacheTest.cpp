@@ -0,0 +1,170 @@
+/*
+ * Copyright 2017-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "MediaPlayer/DecodedAudioCache.h"
+
+namespace alexaClientSDK {
+namespace mediaPlayer {
+namespace test {
+
+using namespace testing;
+
+/// The capacity of the caches under test.
+static const size_t MAX_BYTES = 100;
+
+/// Test decoder which "decodes" each encoded byte to two bytes of PCM and counts how often it is called.
+class FakeDecoder {
+public:
+    FakeDecoder() : calls{0} {
+    }
+
+    DecodedAudioCache::Decoder function() {
+        return [this](const std::string& encoded) -> std::shared_ptr<const DecodedAudio> {
+            ++calls;
+            if (encoded == "bad") {
+                return nullptr;
+            }
+            auto audio = std::make_shared<DecodedAudio>();
+            audio->pcm.assign(encoded.size() * 2, 0);
+            return audio;
+        };
+    }
+
+    std::atomic<int> calls;
+};
+
+class DecodedAudioCacheTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        m_cache = DecodedAudioCache::create(MAX_BYTES, m_decoder.function());
+        ASSERT_NE(m_cache, nullptr);
+    }
+
+    /// Look up @c encoded by its content.
+    std::shared_ptr<const DecodedAudio> get(const std::string& encoded) {
+        return m_cache->get(DecodedAudioCache::buildContentKey(encoded), [encoded]() { return encoded; });
+    }
+
+    /// Look up @c encoded by its content and wait for any decode it starts to finish.
+    std::shared_ptr<const DecodedAudio> getAndWait(const std::string& encoded) {
+        auto audio = get(encoded);
+        m_cache->waitForPendingDecodes();
+        return audio;
+    }
+
+    FakeDecoder m_decoder;
+    std::shared_ptr<DecodedAudioCache> m_cache;
+};
+
+/**
+ * Test that invalid parameters are rejected.
+ */
+TEST_F(DecodedAudioCacheTest, testCreateWithInvalidParameters) {
+    EXPECT_EQ(DecodedAudioCache::create(0, m_decoder.function()), nullptr);
+    EXPECT_EQ(DecodedAudioCache::create(MAX_BYTES, nullptr), nullptr);
+}
+
+/**
+ * Test that the first lookup misses and decodes in the background, and later lookups hit without decoding again.
+ */
+TEST_F(DecodedAudioCacheTest, testMissDecodesOnceThenHits) {
+    EXPECT_EQ(getAndWait(std::string(10, 'a')), nullptr);
+    EXPECT_EQ(m_decoder.calls, 1);
+
+    auto first = get(std::string(10, 'a'));
+    auto second = get(std::string(10, 'a'));
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(first->pcm.size(), 20u);
+    EXPECT_EQ(m_cache->getCachedBytes(), 20u);
+    EXPECT_EQ(m_decoder.calls, 1);
+}
+
+/**
+ * Test that the least recently used sounds are evicted to keep the cache within its byte limit.
+ */
+TEST_F(DecodedAudioCacheTest, testEvictsLeastRecentlyUsed) {
+    getAndWait(std::string(20, 'a'));
+    getAndWait(std::string(20, 'b'));
+    ASSERT_EQ(m_cache->getCachedBytes(), 80u);
+
+    // Touch 'a' so that 'b' is the least recently used when 'c' needs room.
+    ASSERT_NE(get(std::string(20, 'a')), nullptr);
+    getAndWait(std::string(15, 'c'));
+
+    EXPECT_LE(m_cache->getCachedBytes(), MAX_BYTES);
+    EXPECT_NE(get(std::string(20, 'a')), nullptr);
+    EXPECT_NE(get(std::string(15, 'c')), nullptr);
+    EXPECT_EQ(get(std::string(20, 'b')), nullptr);
+}
+
+/**
+ * Test that sounds which are too large to cache, or fail to decode, are not decoded again on every lookup.
+ */
+TEST_F(DecodedAudioCacheTest, testUncacheableSoundsAreNotRetried) {
+    EXPECT_EQ(getAndWait(std::string(60, 'a')), nullptr);
+    EXPECT_EQ(getAndWait(std::string(60, 'a')), nullptr);
+    EXPECT_EQ(getAndWait("bad"), nullptr);
+    EXPECT_EQ(getAndWait("bad"), nullptr);
+    EXPECT_EQ(m_decoder.calls, 2);
+    EXPECT_EQ(m_cache->getCachedBytes(), 0u);
+}
+
+/**
+ * Test that a sound looked up by its identifier is only read to decode it, not on later lookups.
+ */
+TEST_F(DecodedAudioCacheTest, testSoundIsOnlyReadOnMiss) {
+    int reads = 0;
+    auto reader = [&reads]() {
+        ++reads;
+        return std::string(10, 'a');
+    };
+    EXPECT_EQ(m_cache->get("tone", reader), nullptr);
+    EXPECT_EQ(m_cache->get("tone", reader), nullptr);
+    m_cache->waitForPendingDecodes();
+
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_NE(m_cache->get("tone", reader), nullptr);
+    }
+    EXPECT_EQ(reads, 1);
+    EXPECT_EQ(m_decoder.calls, 1);
+}
+
+/**
+ * Test that a sound which can't be read is not read again on every lookup.
+ */
+TEST_F(DecodedAudioCacheTest, testUnreadableSoundsAreNotRetried) {
+    int reads = 0;
+    auto reader = [&reads]() {
+        ++reads;
+        return std::string();
+    };
+    EXPECT_EQ(m_cache->get("tone", reader), nullptr);
+    EXPECT_EQ(m_cache->get("tone", reader), nullptr);
+    m_cache->waitForPendingDecodes();
+    EXPECT_EQ(reads, 1);
+    EXPECT_EQ(m_decoder.calls, 0);
+}
+
+}  // namespace test
+}  // namespace mediaPlayer
+}  // namespace alexaClientSDK
@@ -17,15 +17,20 @@
 #include <chrono>
 #include <condition_variable>
 #include <fstream>
+#include <iterator>
 #include <memory>
 #include <mutex>
+#include <sstream>
 #include <thread>
 #include <unordered_map>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <AVSCommon/AVS/Attachment/InProcessAttachment.h>
 #include <AVSCommon/AVS/SpeakerConstants/SpeakerConstants.h>
+#include <AVSCommon/Utils/Configuration/ConfigurationNode.h>
 #include <AVSCommon/Utils/Logger/Logger.h>
 #include <AVSCommon/Utils/Memory/Memory.h>
 #include <PlaylistParser/PlaylistParser.h>
@@ -40,6 +45,7 @@ namespace test {
 using namespace avsCommon::avs::attachment;
 using namespace avsCommon::avs::speakerConstants;
 using namespace avsCommon::sdkInterfaces;
+using namespace avsCommon::utils::configuration;
 using namespace avsCommon::utils::mediaPlayer;
 using namespace avsCommon::utils::memory;
 using namespace ::testing;
@@ -87,6 +93,12 @@ static const std::chrono::milliseconds TOLERANCE(200);
 /// Padding to add to offsets when necessary.
 static const std::chrono::milliseconds PADDING(10);
 
+/// How long an attachment source is left without data, so that it has to wait for data to arrive.
+static const std::chrono::milliseconds DATA_DELAY(500);
+
+/// The longest acceptable time from attachment data being written to playback starting.
+static const std::chrono::milliseconds MAX_DATA_TO_PLAYBACK_LATENCY(500);
+
 static std::unordered_map<std::string, std::string> urlsToContentTypes;
 
 static std::unordered_map<std::string, std::string> urlsToContent;
@@ -656,6 +668,37 @@ TEST_F(MediaPlayerTest, testStartPlayWaitForEnd) {
     ASSERT_TRUE(m_playerObserver->waitForPlaybackFinished(sourceId));
 }
 
+/**
+ * Set the source of the @c MediaPlayer to an attachment which has no data yet and play it.  Once the source has had
+ * to wait for data, write the whole audio file to the attachment and check that playback starts promptly, rather than
+ * after the source's next poll or wait timeout.
+ */
+TEST_F(MediaPlayerTest, testAttachmentSourceWakesWhenDataArrives) {
+    std::ifstream file(inputsDirPath + MP3_FILE_PATH, std::ios::binary);
+    ASSERT_TRUE(file.good());
+    std::vector<char> data{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    ASSERT_FALSE(data.empty());
+
+    InProcessAttachment attachment("wakeTest");
+    std::shared_ptr<AttachmentWriter> writer = attachment.createWriter();
+    std::shared_ptr<AttachmentReader> reader =
+        attachment.createReader(InProcessAttachmentReader::SDSTypeReader::Policy::NONBLOCKING);
+    ASSERT_TRUE(writer);
+    ASSERT_TRUE(reader);
+    auto sourceId = m_mediaPlayer->setSource(reader);
+    ASSERT_NE(ERROR_SOURCE_ID, sourceId);
+    ASSERT_TRUE(m_mediaPlayer->play(sourceId));
+    std::this_thread::sleep_for(DATA_DELAY);
+
+    auto writeTime = std::chrono::steady_clock::now();
+    AttachmentWriter::WriteStatus writeStatus;
+    ASSERT_EQ(writer->write(data.data(), data.size(), &writeStatus), data.size());
+    writer->close();
+    ASSERT_TRUE(m_playerObserver->waitForPlaybackStarted(sourceId));
+    EXPECT_LT(std::chrono::steady_clock::now() - writeTime, MAX_DATA_TO_PLAYBACK_LATENCY);
+    ASSERT_TRUE(m_playerObserver->waitForPlaybackFinished(sourceId));
+}
+
 /**
  * Set the source of the @c MediaPlayer to a url representing a single audio file. Playback audio till the end.
  * Check whether the playback started and playback finished notifications are received.
@@ -717,6 +760,60 @@ TEST_F(MediaPlayerTest, testStopPlay) {
     ASSERT_TRUE(m_playerObserver->waitForPlaybackStopped(sourceId));
 }
 
+/**
+ * With the persistent pipeline enabled, call @c stop right after @c play, while the pipeline is still in READY on its
+ * way to PLAYING.  The stop must not be rejected as already stopped, and the playback stopped notification should be
+ * received.
+ */
+TEST_F(MediaPlayerTest, testStopImmediatelyAfterPlayWithPersistentPipeline) {
+    std::stringstream configuration(R"({"gstreamerMediaPlayer":{"persistentPipeline":true}})");
+    ASSERT_TRUE(ConfigurationNode::initialize({&configuration}));
+    m_mediaPlayer->shutdown();
+    m_mediaPlayer = MediaPlayer::create(std::make_shared<MockContentFetcherFactory>());
+    ConfigurationNode::uninitialize();
+    ASSERT_TRUE(m_mediaPlayer);
+    m_mediaPlayer->setObserver(m_playerObserver);
+
+    MediaPlayer::SourceId sourceId;
+    setIStreamSource(&sourceId, true);
+    ASSERT_TRUE(m_mediaPlayer->play(sourceId));
+    ASSERT_TRUE(m_mediaPlayer->stop(sourceId));
+    ASSERT_TRUE(m_playerObserver->waitForPlaybackStopped(sourceId));
+}
+
+/**
+ * With the output tap enabled, play an audio file to the end and check that its output reached the tap.  The latency
+ * the tap added, from the audio being handed to the sink to it being in the tap's stream, is reported as the
+ * @c outputTapMaxLatencyUs and @c outputTapAverageLatencyUs test properties.
+ */
+TEST_F(MediaPlayerTest, testOutputTapLatency) {
+    std::stringstream configuration(R"({"gstreamerMediaPlayer":{"outputTap":{"sampleRateHz":16000}}})");
+    ASSERT_TRUE(ConfigurationNode::initialize({&configuration}));
+    m_mediaPlayer->shutdown();
+    m_mediaPlayer = MediaPlayer::create(std::make_shared<MockContentFetcherFactory>());
+    ConfigurationNode::uninitialize();
+    ASSERT_TRUE(m_mediaPlayer);
+    m_mediaPlayer->setObserver(m_playerObserver);
+    auto outputTap = m_mediaPlayer->getOutputTap();
+    ASSERT_TRUE(outputTap);
+
+    MediaPlayer::SourceId sourceId;
+    setAttachmentReaderSource(&sourceId);
+    ASSERT_TRUE(m_mediaPlayer->play(sourceId));
+    ASSERT_TRUE(m_playerObserver->waitForPlaybackStarted(sourceId));
+    ASSERT_TRUE(m_playerObserver->waitForPlaybackFinished(sourceId));
+
+    auto stats = outputTap->getLatencyStats();
+    ASSERT_GT(stats.writes, 0u);
+    EXPECT_LE(stats.average, stats.max);
+    RecordProperty("outputTapMaxLatencyUs", std::to_string(stats.max.count()));
+    RecordProperty("outputTapAverageLatencyUs", std::to_string(stats.average.count()));
+    ACSDK_INFO(LX("outputTapLatency")
+                   .d("maxUs", stats.max.count())
+                   .d("averageUs", stats.average.count())
+                   .d("writes", stats.writes));
+}
+
 /**
  * Read an audio file into a buffer. Set the source of the @c MediaPlayer to the buffer. Playback audio for a few
  * seconds. Playback started notification should be received when the playback starts. Then call @c stop and expect
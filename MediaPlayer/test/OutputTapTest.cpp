@@ -0,0 +1,166 @@
+/*
+ * Copyright 2017-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <cstdint>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "MediaPlayer/OutputTap.h"
+
+namespace alexaClientSDK {
+namespace mediaPlayer {
+namespace test {
+
+using namespace testing;
+using namespace avsCommon::avs;
+
+/// The sample rate of the taps under test.
+static const unsigned int SAMPLE_RATE_HZ = 16000;
+
+/// The number of channels of the taps under test.
+static const unsigned int NUM_CHANNELS = 2;
+
+/// How much audio the taps under test hold, i.e. 1600 frames.
+static const std::chrono::milliseconds BUFFER_DURATION(100);
+
+/// The maximum number of readers of the taps under test.
+static const size_t MAX_READERS = 2;
+
+/// The number of frames in 10 milliseconds of audio.
+static const size_t FRAMES_PER_10_MS = SAMPLE_RATE_HZ / 100;
+
+class OutputTapTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        m_tap = OutputTap::create(SAMPLE_RATE_HZ, NUM_CHANNELS, BUFFER_DURATION, MAX_READERS);
+        ASSERT_NE(m_tap, nullptr);
+        m_start = std::chrono::steady_clock::now();
+    }
+
+    /// Write @c frames frames, each holding its own index in every sample, handed to the sink at @c timestamp.
+    size_t writeFrames(size_t frames, OutputTap::TimePoint timestamp) {
+        std::vector<int16_t> samples;
+        for (size_t i = 0; i < frames; ++i) {
+            samples.insert(samples.end(), NUM_CHANNELS, static_cast<int16_t>(m_framesWritten + i));
+        }
+        m_framesWritten += frames;
+        return m_tap->write(samples.data(), samples.size() * sizeof(int16_t), timestamp);
+    }
+
+    std::shared_ptr<OutputTap> m_tap;
+    OutputTap::TimePoint m_start;
+    size_t m_framesWritten = 0;
+};
+
+/**
+ * Test that invalid parameters are rejected.
+ */
+TEST_F(OutputTapTest, testCreateWithInvalidParameters) {
+    EXPECT_EQ(OutputTap::create(0, NUM_CHANNELS, BUFFER_DURATION, MAX_READERS), nullptr);
+    EXPECT_EQ(OutputTap::create(SAMPLE_RATE_HZ, 0, BUFFER_DURATION, MAX_READERS), nullptr);
+    EXPECT_EQ(OutputTap::create(SAMPLE_RATE_HZ, NUM_CHANNELS, std::chrono::milliseconds(0), MAX_READERS), nullptr);
+}
+
+/**
+ * Test that the format describes 16-bit interleaved PCM at the requested rate and channel count.
+ */
+TEST_F(OutputTapTest, testFormat) {
+    auto format = m_tap->getFormat();
+    EXPECT_EQ(format.sampleRateHz, SAMPLE_RATE_HZ);
+    EXPECT_EQ(format.numChannels, NUM_CHANNELS);
+    EXPECT_EQ(format.sampleSizeInBits, 16u);
+    EXPECT_TRUE(format.dataSigned);
+    EXPECT_EQ(m_tap->getStream()->getWordSize(), NUM_CHANNELS * sizeof(int16_t));
+}
+
+/**
+ * Test that readers get the frames which were written, and that partial frames are dropped.
+ */
+TEST_F(OutputTapTest, testReadersGetOutput) {
+    std::shared_ptr<AudioInputStream::Reader> reader =
+        m_tap->getStream()->createReader(AudioInputStream::Reader::Policy::NONBLOCKING);
+    ASSERT_NE(reader, nullptr);
+
+    EXPECT_EQ(writeFrames(FRAMES_PER_10_MS, m_start), FRAMES_PER_10_MS);
+    int16_t partial = 0;
+    EXPECT_EQ(m_tap->write(&partial, sizeof(partial), m_start), 0u);
+
+    std::vector<int16_t> samples(FRAMES_PER_10_MS * NUM_CHANNELS * 2);
+    ASSERT_EQ(reader->read(samples.data(), FRAMES_PER_10_MS * 2), static_cast<ssize_t>(FRAMES_PER_10_MS));
+    EXPECT_EQ(samples[0], 0);
+    EXPECT_EQ(samples[(FRAMES_PER_10_MS - 1) * NUM_CHANNELS + 1], static_cast<int16_t>(FRAMES_PER_10_MS - 1));
+}
+
+/**
+ * Test that the time of each frame is interpolated from the time of the write it came from.
+ */
+TEST_F(OutputTapTest, testTimestamps) {
+    auto second = m_start + std::chrono::milliseconds(50);
+    writeFrames(FRAMES_PER_10_MS, m_start);
+    writeFrames(FRAMES_PER_10_MS, second);
+
+    OutputTap::TimePoint timestamp;
+    ASSERT_TRUE(m_tap->getTimestamp(0, &timestamp));
+    EXPECT_EQ(timestamp, m_start);
+    ASSERT_TRUE(m_tap->getTimestamp(FRAMES_PER_10_MS / 2, &timestamp));
+    EXPECT_EQ(timestamp, m_start + std::chrono::milliseconds(5));
+    ASSERT_TRUE(m_tap->getTimestamp(FRAMES_PER_10_MS, &timestamp));
+    EXPECT_EQ(timestamp, second);
+    ASSERT_TRUE(m_tap->getTimestamp(FRAMES_PER_10_MS * 2 - 1, &timestamp));
+    EXPECT_EQ(timestamp, second + std::chrono::microseconds(9937));
+
+    // Frames which haven't been written yet have no time.
+    EXPECT_FALSE(m_tap->getTimestamp(FRAMES_PER_10_MS * 2, &timestamp));
+}
+
+/**
+ * Test that the times of frames which have been overwritten are forgotten.
+ */
+TEST_F(OutputTapTest, testOverwrittenTimestampsAreForgotten) {
+    for (int i = 0; i < 15; ++i) {
+        writeFrames(FRAMES_PER_10_MS, m_start + std::chrono::milliseconds(10 * i));
+    }
+
+    // 150ms were written to a 100ms buffer, so the first 50ms are gone.
+    OutputTap::TimePoint timestamp;
+    EXPECT_FALSE(m_tap->getTimestamp(FRAMES_PER_10_MS * 5 - 1, &timestamp));
+    ASSERT_TRUE(m_tap->getTimestamp(FRAMES_PER_10_MS * 5, &timestamp));
+    EXPECT_EQ(timestamp, m_start + std::chrono::milliseconds(50));
+}
+
+/**
+ * Test that the latency of each write, from the time its audio was handed to the sink, is measured.
+ */
+TEST_F(OutputTapTest, testLatencyIsMeasured) {
+    auto stats = m_tap->getLatencyStats();
+    EXPECT_EQ(stats.writes, 0u);
+    EXPECT_EQ(stats.average, std::chrono::microseconds::zero());
+
+    auto now = std::chrono::steady_clock::now();
+    writeFrames(FRAMES_PER_10_MS, now - std::chrono::milliseconds(20));
+    writeFrames(FRAMES_PER_10_MS, now);
+
+    stats = m_tap->getLatencyStats();
+    EXPECT_EQ(stats.writes, 2u);
+    EXPECT_GE(stats.max, std::chrono::milliseconds(20));
+    EXPECT_GE(stats.average, std::chrono::milliseconds(10));
+    EXPECT_LE(stats.average, stats.max);
+}
+
+}  // namespace test
+}  // namespace mediaPlayer
+}  // namespace alexaClientSDK
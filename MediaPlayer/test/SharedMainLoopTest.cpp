@@ -0,0 +1,128 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "MediaPlayer/SharedMainLoop.h"
+
+namespace alexaClientSDK {
+namespace mediaPlayer {
+namespace test {
+
+using namespace testing;
+
+/// Timeout when waiting for a callback to run on the loop.
+static const std::chrono::seconds WAIT_TIMEOUT(5);
+
+/// Records which thread ran each idle callback, and in what order.
+struct CallbackLog {
+    std::mutex mutex;
+    std::vector<int> order;
+    std::vector<std::thread::id> threads;
+};
+
+/// An idle callback with the index it should record.
+struct IndexedCallback {
+    CallbackLog* log;
+    int index;
+};
+
+/// Idle callback which records its index and the thread it ran on.
+static gboolean recordCallback(gpointer pointer) {
+    auto callback = static_cast<IndexedCallback*>(pointer);
+    std::lock_guard<std::mutex> lock(callback->log->mutex);
+    callback->log->order.push_back(callback->index);
+    callback->log->threads.push_back(std::this_thread::get_id());
+    return false;
+}
+
+/// Idle callback which reports the thread it ran on.
+static gboolean fulfillPromise(gpointer pointer) {
+    static_cast<std::promise<std::thread::id>*>(pointer)->set_value(std::this_thread::get_id());
+    return false;
+}
+
+class SharedMainLoopTest : public ::testing::Test {};
+
+/**
+ * Test that every holder gets the same loop while it is held, and a new one once all holders release it.
+ */
+TEST_F(SharedMainLoopTest, testAcquireReturnsSameLoopWhileHeld) {
+    auto first = SharedMainLoop::acquire();
+    auto second = SharedMainLoop::acquire();
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(first, second);
+
+    std::weak_ptr<SharedMainLoop> weak = first;
+    first.reset();
+    EXPECT_FALSE(weak.expired());
+    second.reset();
+    EXPECT_TRUE(weak.expired());
+
+    auto third = SharedMainLoop::acquire();
+    EXPECT_NE(third, nullptr);
+}
+
+/**
+ * Test that sources queued on the default context run on the shared loop thread, in the order they were queued.
+ */
+TEST_F(SharedMainLoopTest, testCallbacksRunInOrderOnOneThread) {
+    auto loop = SharedMainLoop::acquire();
+    ASSERT_NE(loop, nullptr);
+
+    CallbackLog log;
+    std::vector<IndexedCallback> callbacks;
+    for (int i = 0; i < 10; ++i) {
+        callbacks.push_back({&log, i});
+    }
+    for (auto& callback : callbacks) {
+        g_idle_add(&recordCallback, &callback);
+    }
+    loop->waitForPendingCallbacks();
+
+    std::lock_guard<std::mutex> lock(log.mutex);
+    ASSERT_EQ(log.order.size(), callbacks.size());
+    for (size_t i = 0; i < log.order.size(); ++i) {
+        EXPECT_EQ(log.order[i], static_cast<int>(i));
+        EXPECT_EQ(log.threads[i], log.threads[0]);
+    }
+    EXPECT_NE(log.threads[0], std::this_thread::get_id());
+}
+
+/**
+ * Test that the loop thread keeps running after a holder releases it.
+ */
+TEST_F(SharedMainLoopTest, testLoopRunsUntilLastHolderReleases) {
+    auto first = SharedMainLoop::acquire();
+    auto second = SharedMainLoop::acquire();
+    ASSERT_NE(first, nullptr);
+    first.reset();
+
+    std::promise<std::thread::id> promise;
+    auto future = promise.get_future();
+    g_idle_add(&fulfillPromise, &promise);
+    ASSERT_EQ(future.wait_for(WAIT_TIMEOUT), std::future_status::ready);
+    EXPECT_NE(future.get(), std::this_thread::get_id());
+}
+
+}  // namespace test
+}  // namespace mediaPlayer
+}  // namespace alexaClientSDK
@@ -0,0 +1,272 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file
+ * Parses large synthetic M3U8 and PLS playlists with the incremental parsers, fed in the same chunk size that
+ * @c PlaylistParser reads from the content fetcher, and with the previous approach of gathering the whole playlist into
+ * a @c std::string and splitting it with @c std::getline.  Reports the time per playlist and the throughput of each.
+ *
+ * USAGE: PlaylistContentParserBenchmark [number_of_entries] [iterations]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "PlaylistParser/M3UContentParser.h"
+#include "PlaylistParser/PLSContentParser.h"
+
+using namespace alexaClientSDK::playlistParser;
+
+/// The URL of the playlists parsed.
+static const std::string PLAYLIST_URL = "http://radio.example.com/live/stream/playlist.m3u8";
+
+/// The size of each chunk fed to the parsers, matching the size @c PlaylistParser reads.
+static const size_t CHUNK_SIZE = 1024;
+
+/// The default number of entries in each playlist.
+static const size_t DEFAULT_NUM_ENTRIES = 100000;
+
+/// The default number of times each playlist is parsed.
+static const size_t DEFAULT_ITERATIONS = 20;
+
+/**
+ * Build an M3U8 media playlist with alternating absolute and relative segment URLs.
+ *
+ * @param numEntries The number of entries.
+ * @return The playlist.
+ */
+static std::string buildM3U8Playlist(size_t numEntries) {
+    std::string playlist = "#EXTM3U\r\n#EXT-X-VERSION:3\r\n#EXT-X-TARGETDURATION:10\r\n#EXT-X-MEDIA-SEQUENCE:1\r\n";
+    for (size_t i = 0; i < numEntries; ++i) {
+        playlist += "#EXTINF:9.984,Station " + std::to_string(i) + "\r\n";
+        if (i % 2) {
+            playlist += "https://cdn.example.com/live/stream/segment_" + std::to_string(i) + ".aac\r\n";
+        } else {
+            playlist += "segment_" + std::to_string(i) + ".aac\r\n";
+        }
+    }
+    return playlist;
+}
+
+/**
+ * Build a PLS playlist.
+ *
+ * @param numEntries The number of entries.
+ * @return The playlist.
+ */
+static std::string buildPLSPlaylist(size_t numEntries) {
+    std::string playlist = "[playlist]\nNumberOfEntries=" + std::to_string(numEntries) + "\n";
+    for (size_t i = 1; i <= numEntries; ++i) {
+        auto n = std::to_string(i);
+        playlist += "File" + n + "=http://stream" + n + ".example.com:8000/live\nTitle" + n + "=Station " + n +
+                    "\nLength" + n + "=-1\n";
+    }
+    playlist += "Version=2\n";
+    return playlist;
+}
+
+/**
+ * Resolve a URL the way the previous parser did.
+ *
+ * @param url The URL.
+ * @param [out] resolved The resolved URL.
+ * @return Whether the URL could be resolved.
+ */
+static bool resolveURLByCopying(const std::string& url, std::string* resolved) {
+    if (url.find("://") != std::string::npos) {
+        *resolved = url;
+        return true;
+    }
+    std::string baseURL = PLAYLIST_URL;
+    auto positionOfLastSlash = baseURL.find_last_of('/');
+    if (positionOfLastSlash == std::string::npos) {
+        return false;
+    }
+    baseURL.resize(positionOfLastSlash + 1);
+    *resolved = baseURL + url;
+    return true;
+}
+
+/**
+ * Gather a playlist into a string and parse its M3U entries line by line, as the previous parser did.  Durations are
+ * not parsed, which favours this approach.
+ *
+ * @param playlist The playlist.
+ * @return The number of entries found.
+ */
+static size_t parseM3UWithGetline(const std::string& playlist) {
+    std::string content;
+    for (size_t offset = 0; offset < playlist.size(); offset += CHUNK_SIZE) {
+        content.append(playlist.data() + offset, std::min(CHUNK_SIZE, playlist.size() - offset));
+    }
+    std::vector<std::string> urls;
+    std::istringstream iss(content);
+    std::string line;
+    while (std::getline(iss, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        std::istringstream iss2(line);
+        char firstChar;
+        iss2 >> firstChar;
+        if (!iss2 || firstChar == '#') {
+            continue;
+        }
+        std::string url;
+        if (resolveURLByCopying(line, &url)) {
+            urls.push_back(url);
+        }
+    }
+    return urls.size();
+}
+
+/**
+ * Gather a playlist into a string and parse its PLS entries line by line, as the previous parser did.
+ *
+ * @param playlist The playlist.
+ * @return The number of entries found.
+ */
+static size_t parsePLSWithGetline(const std::string& playlist) {
+    std::string content;
+    for (size_t offset = 0; offset < playlist.size(); offset += CHUNK_SIZE) {
+        content.append(playlist.data() + offset, std::min(CHUNK_SIZE, playlist.size() - offset));
+    }
+    std::vector<std::string> urls;
+    std::istringstream iss(content);
+    std::string line;
+    while (std::getline(iss, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.compare(0, 4, "File") == 0) {
+            std::string url;
+            if (resolveURLByCopying(line.substr(line.find_first_of('=') + 1), &url)) {
+                urls.push_back(url);
+            }
+        }
+    }
+    return urls.size();
+}
+
+/**
+ * Feed a playlist to a parser in chunks.
+ *
+ * @param playlist The playlist.
+ * @param parser The parser.
+ */
+static void feedInChunks(const std::string& playlist, PlaylistLineParser* parser) {
+    for (size_t offset = 0; offset < playlist.size(); offset += CHUNK_SIZE) {
+        parser->feed(playlist.data() + offset, std::min(CHUNK_SIZE, playlist.size() - offset));
+    }
+    parser->finish();
+}
+
+/**
+ * Parse a playlist with the incremental M3U parser, collecting the URLs as @c PlaylistParser does.
+ *
+ * @param playlist The playlist.
+ * @return The number of entries found.
+ */
+static size_t parseM3UIncrementally(const std::string& playlist) {
+    std::vector<std::string> urls;
+    M3UContentParser parser(
+        PLAYLIST_URL,
+        [&urls](const std::string& url, std::chrono::milliseconds duration, uint64_t sequenceNumber) {
+            urls.push_back(url);
+        });
+    feedInChunks(playlist, &parser);
+    return urls.size();
+}
+
+/**
+ * Parse a playlist with the incremental PLS parser, collecting the URLs as @c PlaylistParser does.
+ *
+ * @param playlist The playlist.
+ * @return The number of entries found.
+ */
+static size_t parsePLSIncrementally(const std::string& playlist) {
+    std::vector<std::string> urls;
+    PLSContentParser parser(PLAYLIST_URL, [&urls](const std::string& url) { urls.push_back(url); });
+    feedInChunks(playlist, &parser);
+    return urls.size();
+}
+
+/**
+ * Time a parse function and print the result.
+ *
+ * @param name The name to print.
+ * @param playlist The playlist to parse.
+ * @param iterations The number of times to parse it.
+ * @param parse The function to time.
+ * @return The number of entries found, or 0 if the iterations disagreed.
+ */
+static size_t run(
+    const std::string& name,
+    const std::string& playlist,
+    size_t iterations,
+    std::function<size_t(const std::string&)> parse) {
+    size_t numEntries = parse(playlist);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        if (parse(playlist) != numEntries) {
+            return 0;
+        }
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    double msPerParse = elapsed.count() / iterations;
+    double megabytesPerSecond = playlist.size() / (msPerParse * 1000.0);
+    std::cout << std::left << std::setw(24) << name << std::right << std::setw(10) << numEntries << std::setw(12)
+              << msPerParse << std::setw(12) << megabytesPerSecond << std::endl;
+    return numEntries;
+}
+
+int main(int argc, char** argv) {
+    size_t numEntries = DEFAULT_NUM_ENTRIES;
+    size_t iterations = DEFAULT_ITERATIONS;
+    if (argc > 1) {
+        numEntries = std::strtoul(argv[1], nullptr, 10);
+    }
+    if (argc > 2) {
+        iterations = std::strtoul(argv[2], nullptr, 10);
+    }
+    if (argc > 3 || !numEntries || !iterations) {
+        std::cerr << "USAGE: " << std::string(argv[0]) << " [number_of_entries] [iterations]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    auto m3u8Playlist = buildM3U8Playlist(numEntries);
+    auto plsPlaylist = buildPLSPlaylist(numEntries);
+
+    std::cout << std::left << std::setw(24) << "parser" << std::right << std::setw(10) << "entries" << std::setw(12)
+              << "ms" << std::setw(12) << "MB/s" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    bool ok = run("m3u8 getline", m3u8Playlist, iterations, parseM3UWithGetline) == numEntries &&
+              run("m3u8 incremental", m3u8Playlist, iterations, parseM3UIncrementally) == numEntries &&
+              run("pls getline", plsPlaylist, iterations, parsePLSWithGetline) == numEntries &&
+              run("pls incremental", plsPlaylist, iterations, parsePLSIncrementally) == numEntries;
+    if (!ok) {
+        std::cerr << "A parser did not find every entry" << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright 2017-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_PLAYLISTPARSER_INCLUDE_PLAYLISTPARSER_FETCHTIMINGOBSERVERINTERFACE_H_
+#define ALEXA_CLIENT_SDK_PLAYLISTPARSER_INCLUDE_PLAYLISTPARSER_FETCHTIMINGOBSERVERINTERFACE_H_
+
+#include <chrono>
+#include <string>
+
+#include <AVSCommon/SDKInterfaces/HTTPContentFetcherInterface.h>
+
+namespace alexaClientSDK {
+namespace playlistParser {
+
+/// The timing of one request made by the @c PlaylistParser while resolving a playlist.
+struct FetchTiming {
+    /// The URL requested.
+    std::string url;
+
+    /// What was requested.
+    avsCommon::sdkInterfaces::HTTPContentFetcherInterface::FetchOptions fetchOption;
+
+    /**
+     * The time from starting the request until the parser saw its result.  Requests started ahead of the URL being
+     * reached may have finished some time before the parser looked at them.
+     */
+    std::chrono::milliseconds elapsed;
+
+    /// How long the parser was blocked waiting for the result.
+    std::chrono::milliseconds waited;
+};
+
+/**
+ * An interface to be notified of the timing of each request made while resolving a playlist.
+ */
+class FetchTimingObserverInterface {
+public:
+    /**
+     * Destructor.
+     */
+    virtual ~FetchTimingObserverInterface() = default;
+
+    /**
+     * Notification that a request has completed.  This is called on the parser's thread and should return quickly.
+     *
+     * @param requestId The id of the @c parsePlaylist call the request was made for.
+     * @param timing The timing of the request.
+     */
+    virtual void onFetchCompleted(int requestId, const FetchTiming& timing) = 0;
+};
+
+}  // namespace playlistParser
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_PLAYLISTPARSER_INCLUDE_PLAYLISTPARSER_FETCHTIMINGOBSERVERINTERFACE_H_
@@ -0,0 +1,88 @@
+/*
+ * Copyright 2017-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_PLAYLISTPARSER_INCLUDE_PLAYLISTPARSER_LIVEPLAYLISTREFRESHER_H_
+#define ALEXA_CLIENT_SDK_PLAYLISTPARSER_INCLUDE_PLAYLISTPARSER_LIVEPLAYLISTREFRESHER_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace alexaClientSDK {
+namespace playlistParser {
+
+/**
+ * Keeps track of a live HLS media playlist (one without an @c #EXT-X-ENDLIST tag) which is reloaded to find the
+ * segments added to it.  Segments are identified by their media sequence numbers, so only the segments after the last
+ * one already seen need to be processed, and reloads are scheduled as described in RFC 8216 section 6.3.4: one target
+ * duration after the previous load started if it had new segments, or half a target duration if it did not.
+ */
+class LivePlaylistRefresher {
+public:
+    /**
+     * Constructor.
+     */
+    LivePlaylistRefresher();
+
+    /**
+     * Check whether a segment of a reload of the playlist has not been seen in an earlier load.  All segments are new
+     * until a load with an @c #EXT-X-MEDIA-SEQUENCE tag has been recorded.
+     *
+     * @param sequenceNumber The media sequence number of the segment.
+     * @return Whether the segment is new.
+     */
+    bool isNewSegment(uint64_t sequenceNumber) const;
+
+    /**
+     * Record a load of the playlist and schedule the next one.
+     *
+     * @param loadStart When the load started.
+     * @param hasMediaSequence Whether the playlist had an @c #EXT-X-MEDIA-SEQUENCE tag.
+     * @param numSegments The number of segments in the playlist.
+     * @param lastSequenceNumber The media sequence number of the last segment, if there were any.
+     * @param hasNewSegments Whether the playlist had segments which were not seen before.
+     * @param targetDuration The target duration of the playlist, or
+     * @c PlaylistParserObserverInterface::INVALID_DURATION if it had none.
+     */
+    void onPlaylistLoaded(
+        std::chrono::steady_clock::time_point loadStart,
+        bool hasMediaSequence,
+        size_t numSegments,
+        uint64_t lastSequenceNumber,
+        bool hasNewSegments,
+        std::chrono::milliseconds targetDuration);
+
+    /**
+     * Get the time at which the playlist should next be loaded.
+     *
+     * @return The time of the next load.
+     */
+    std::chrono::steady_clock::time_point getNextRefreshTime() const;
+
+private:
+    /// Whether @c m_lastSequenceNumber is known.
+    bool m_hasLastSequenceNumber;
+
+    /// The media sequence number of the last segment seen.
+    uint64_t m_lastSequenceNumber;
+
+    /// When the playlist should next be loaded.
+    std::chrono::steady_clock::time_point m_nextRefreshTime;
+};
+
+}  // namespace playlistParser
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_PLAYLISTPARSER_INCLUDE_PLAYLISTPARSER_LIVEPLAYLISTREFRESHER_H_
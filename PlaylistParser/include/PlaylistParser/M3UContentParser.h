@@ -0,0 +1,142 @@
+/*
+ * Copyright 2017-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_PLAYLISTPARSER_INCLUDE_PLAYLISTPARSER_M3UCONTENTPARSER_H_
+#define ALEXA_CLIENT_SDK_PLAYLISTPARSER_INCLUDE_PLAYLISTPARSER_M3UCONTENTPARSER_H_
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "PlaylistParser/PlaylistLineParser.h"
+
+namespace alexaClientSDK {
+namespace playlistParser {
+
+/**
+ * An incremental parser of M3U and M3U8 playlists.  An M3U playlist is formatted such that all metadata information is
+ * prepended with a '#' and everything else is a URL to play.  Each URL is passed to the callback as soon as its line
+ * has been read.
+ */
+class M3UContentParser : public PlaylistLineParser {
+public:
+    /**
+     * A function called with each URL in the playlist, in the order they appear.
+     *
+     * @param url The absolute URL.  This is only valid for the duration of the call.
+     * @param duration The duration from the @c #EXTINF tag before the URL, or
+     * @c PlaylistParserObserverInterface::INVALID_DURATION if there was none.
+     * @param sequenceNumber The media sequence number of the URL, which is its index in the playlist plus the value of
+     * the @c #EXT-X-MEDIA-SEQUENCE tag, if there is one.
+     */
+    using EntryCallback =
+        std::function<void(const std::string& url, std::chrono::milliseconds duration, uint64_t sequenceNumber)>;
+
+    /**
+     * Constructor.
+     *
+     * @param playlistURL The URL of the playlist, against which relative URLs in it are resolved.
+     * @param callback The function to call with each URL.
+     */
+    M3UContentParser(const std::string& playlistURL, EntryCallback callback);
+
+    /**
+     * Whether the playlist is an extended M3U playlist, which is taken to mean M3U8.  This is known once the first
+     * line has been parsed.
+     *
+     * @return Whether the first line starts with "#EXTM3U".
+     */
+    bool isExtendedM3U() const;
+
+    /**
+     * Whether an @c #EXT-X-STREAM-INF tag has been seen, meaning this is an HLS master playlist.
+     *
+     * @return Whether the tag has been seen.
+     */
+    bool isStreamInfTagPresent() const;
+
+    /**
+     * Whether an @c #EXT-X-ENDLIST tag has been seen, meaning no more URLs will be added to this playlist.
+     *
+     * @return Whether the tag has been seen.
+     */
+    bool isEndlistTagPresent() const;
+
+    /**
+     * Whether an @c #EXT-X-MEDIA-SEQUENCE tag has been seen, meaning the sequence numbers of the URLs identify them
+     * across reloads of a live playlist.
+     *
+     * @return Whether the tag has been seen.
+     */
+    bool hasMediaSequence() const;
+
+    /**
+     * Get the value of the @c #EXT-X-TARGETDURATION tag, which is the longest duration of any URL in the playlist.
+     *
+     * @return The target duration, or @c PlaylistParserObserverInterface::INVALID_DURATION if the tag has not been
+     * seen.
+     */
+    std::chrono::milliseconds getTargetDuration() const;
+
+    /**
+     * Parse the duration out of a line that starts with @c #EXTINF, such as "#EXTINF:10.5,Title".
+     *
+     * @param line The start of the line.
+     * @param length The length of the line.
+     * @return The duration, or @c PlaylistParserObserverInterface::INVALID_DURATION if it could not be parsed.
+     */
+    static std::chrono::milliseconds parseRuntime(const char* line, size_t length);
+
+protected:
+    /// @name PlaylistLineParser method
+    void onLine(const char* line, size_t length) override;
+
+private:
+    /// The function to call with each URL.
+    EntryCallback m_callback;
+
+    /// Whether the next line is the first.
+    bool m_isFirstLine;
+
+    /// Whether the first line starts with "#EXTM3U".
+    bool m_isExtendedM3U;
+
+    /// Whether an @c #EXT-X-STREAM-INF tag has been seen.
+    bool m_streamInfTagPresent;
+
+    /// Whether an @c #EXT-X-ENDLIST tag has been seen.
+    bool m_endlistTagPresent;
+
+    /// Whether an @c #EXT-X-MEDIA-SEQUENCE tag has been seen.
+    bool m_hasMediaSequence;
+
+    /// The sequence number of the next URL.
+    uint64_t m_sequenceNumber;
+
+    /// The value of the @c #EXT-X-TARGETDURATION tag.
+    std::chrono::milliseconds m_targetDuration;
+
+    /// The duration for the next URL.
+    std::chrono::milliseconds m_duration;
+
+    /// The last URL resolved, kept so that its storage is reused.
+    std::string m_url;
+};
+
+}  // namespace playlistParser
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_PLAYLISTPARSER_INCLUDE_PLAYLISTPARSER_M3UCONTENTPARSER_H_
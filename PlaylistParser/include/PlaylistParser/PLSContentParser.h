@@ -0,0 +1,64 @@
+/*
+ * Copyright 2017-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_PLAYLISTPARSER_INCLUDE_PLAYLISTPARSER_PLSCONTENTPARSER_H_
+#define ALEXA_CLIENT_SDK_PLAYLISTPARSER_INCLUDE_PLAYLISTPARSER_PLSCONTENTPARSER_H_
+
+#include <functional>
+#include <string>
+
+#include "PlaylistParser/PlaylistLineParser.h"
+
+namespace alexaClientSDK {
+namespace playlistParser {
+
+/**
+ * An incremental parser of PLS playlists.  A PLS playlist is formatted such that all URLs to play are prepended with
+ * "File'N'=", where 'N' refers to the numbered URL. For example "File1=url.com ... File2=anotherurl.com".  Each URL is
+ * passed to the callback as soon as its line has been read.
+ */
+class PLSContentParser : public PlaylistLineParser {
+public:
+    /**
+     * A function called with each URL in the playlist, in the order they appear.
+     *
+     * @param url The absolute URL.  This is only valid for the duration of the call.
+     */
+    using EntryCallback = std::function<void(const std::string& url)>;
+
+    /**
+     * Constructor.
+     *
+     * @param playlistURL The URL of the playlist, against which relative URLs in it are resolved.
+     * @param callback The function to call with each URL.
+     */
+    PLSContentParser(const std::string& playlistURL, EntryCallback callback);
+
+protected:
+    /// @name PlaylistLineParser method
+    void onLine(const char* line, size_t length) override;
+
+private:
+    /// The function to call with each URL.
+    EntryCallback m_callback;
+
+    /// The last URL resolved, kept so that its storage is reused.
+    std::string m_url;
+};
+
+}  // namespace playlistParser
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_PLAYLISTPARSER_INCLUDE_PLAYLISTPARSER_PLSCONTENTPARSER_H_
@@ -0,0 +1,112 @@
+/*
+ * Copyright 2017-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef ALEXA_CLIENT_SDK_PLAYLISTPARSER_INCLUDE_PLAYLISTPARSER_PLAYLISTLINEPARSER_H_
+#define ALEXA_CLIENT_SDK_PLAYLISTPARSER_INCLUDE_PLAYLISTPARSER_PLAYLISTLINEPARSER_H_
+
+#include <cstddef>
+#include <string>
+
+namespace alexaClientSDK {
+namespace playlistParser {
+
+/**
+ * The base of the incremental playlist parsers.  Playlist content is passed to @c feed in chunks of any size as it
+ * arrives, and each complete line is handed to @c onLine as a pointer into the chunk, so lines are not copied.  Only a
+ * line which is split across two chunks is gathered into an internal buffer, which is reused for the next such line.
+ */
+class PlaylistLineParser {
+public:
+    /**
+     * Destructor.
+     */
+    virtual ~PlaylistLineParser() = default;
+
+    /**
+     * Parse the next chunk of the playlist.
+     *
+     * @param data The chunk.
+     * @param size The size of the chunk in bytes.
+     */
+    void feed(const char* data, size_t size);
+
+    /**
+     * Parse the last line of the playlist if it did not end with a line break.  This must be called once after the
+     * last call to @c feed.
+     */
+    void finish();
+
+protected:
+    /**
+     * Constructor.
+     *
+     * @param playlistURL The URL of the playlist, against which relative URLs in it are resolved.
+     */
+    PlaylistLineParser(const std::string& playlistURL);
+
+    /**
+     * Handle a line of the playlist.  Lines are passed in order, including empty ones, with the line break and any
+     * carriage return before it removed.  The line is only valid for the duration of the call.
+     *
+     * @param line The start of the line.
+     * @param length The length of the line.
+     */
+    virtual void onLine(const char* line, size_t length) = 0;
+
+    /**
+     * Resolve a URL read from the playlist.  A URL containing "://" is absolute and used as is, anything else is
+     * appended to the playlist URL up to and including its last '/'.
+     *
+     * @param url The start of the URL.
+     * @param length The length of the URL.
+     * @param [out] resolved The resolved URL.  Its storage is reused, so passing the same string each time avoids
+     * allocating for each URL.
+     * @return @c true if the URL was resolved, or @c false if it is relative and the playlist URL has no '/'.
+     */
+    bool resolveURL(const char* url, size_t length, std::string* resolved) const;
+
+    /**
+     * Check whether a line starts with a prefix.
+     *
+     * @param line The start of the line.
+     * @param length The length of the line.
+     * @param prefix The prefix.
+     * @return Whether the line starts with @c prefix.
+     */
+    static bool startsWith(const char* line, size_t length, const std::string& prefix);
+
+private:
+    /**
+     * Strip the carriage return from the end of a line and pass it to @c onLine.
+     *
+     * @param line The start of the line.
+     * @param length The length of the line, without its '\n'.
+     */
+    void dispatchLine(const char* line, size_t length);
+
+    /// The part of the playlist URL which relative URLs are appended to.
+    std::string m_baseURL;
+
+    /// Whether the playlist URL has a '/', without which relative URLs cannot be resolved.
+    bool m_hasBaseURL;
+
+    /// The start of a line which was split across calls to @c feed.
+    std::string m_partialLine;
+};
+
+}  // namespace playlistParser
+}  // namespace alexaClientSDK
+
+#endif  // ALEXA_CLIENT_SDK_PLAYLISTPARSER_INCLUDE_PLAYLISTPARSER_PLAYLISTLINEPARSER_H_
@@ -16,8 +16,12 @@
 #ifndef ALEXA_CLIENT_SDK_PLAYLISTPARSER_INCLUDE_PLAYLISTPARSER_PLAYLISTPARSER_H_
 #define ALEXA_CLIENT_SDK_PLAYLISTPARSER_INCLUDE_PLAYLISTPARSER_PLAYLISTPARSER_H_
 
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
 #include <deque>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 
 #include <AVSCommon/AVS/Attachment/AttachmentReader.h>
@@ -26,6 +30,9 @@
 #include <AVSCommon/Utils/RequiresShutdown.h>
 #include <AVSCommon/Utils/Threading/Executor.h>
 
+#include "PlaylistParser/FetchTimingObserverInterface.h"
+#include "PlaylistParser/PlaylistLineParser.h"
+
 namespace alexaClientSDK {
 namespace playlistParser {
 
@@ -40,10 +47,14 @@ public:
      * Creates a new @c PlaylistParser instance.
      *
      * @param contentFetcherFactory A factory that can create @c HTTPContentFetcherInterfaces.
+     * @param maxConcurrentFetches The maximum number of URLs of a playlist which are fetched at the same time.
+     * @param fetchTimingObserver An optional observer to be notified of the timing of each request.
      * @return An @c std::unique_ptr to a new @c PlaylistParser if successful or @c nullptr otherwise.
      */
     static std::unique_ptr<PlaylistParser> create(
-        std::shared_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface> contentFetcherFactory);
+        std::shared_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface> contentFetcherFactory,
+        size_t maxConcurrentFetches = DEFAULT_MAX_CONCURRENT_FETCHES,
+        std::shared_ptr<FetchTimingObserverInterface> fetchTimingObserver = nullptr);
 
     int parsePlaylist(
         std::string url,
@@ -53,21 +64,55 @@ public:
     /// A return value that indicates a failure to start the playlist parsing.
     static const int START_FAILURE = 0;
 
+    /// The default maximum number of URLs of a playlist which are fetched at the same time.
+    static const size_t DEFAULT_MAX_CONCURRENT_FETCHES = 4;
+
     void doShutdown() override;
 
 private:
+    /**
+     * The requests made for a URL.  These may be started before the search reaches the URL, so that the URLs of a
+     * playlist are fetched concurrently while their results are still handled in order.
+     */
+    struct PlaylistFetch {
+        /// The fetcher used to get the content type.
+        std::unique_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterface> contentTypeFetcher;
+
+        /// The pending content type response, or @c nullptr once it has been resolved.
+        std::unique_ptr<avsCommon::utils::HTTPContent> contentTypeResponse;
+
+        /// When the content type request was started.
+        std::chrono::steady_clock::time_point contentTypeStart;
+
+        /// Whether the content type request has been resolved.
+        bool contentTypeResolved;
+
+        /// Whether the content type request succeeded.
+        bool contentTypeSucceeded;
+
+        /// The lower case content type, once resolved.
+        std::string contentType;
+
+        /// The fetcher used to get the body, if it has been requested.
+        std::unique_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterface> bodyFetcher;
+
+        /// The pending body response, if it has been requested.
+        std::unique_ptr<avsCommon::utils::HTTPContent> bodyResponse;
+
+        /// When the body request was started.
+        std::chrono::steady_clock::time_point bodyStart;
+
+        PlaylistFetch() : contentTypeResolved{false}, contentTypeSucceeded{false} {};
+    };
+
     /// A struct to contain a URL encountered in a playlist and metadata surrounding it.
     struct UrlAndInfo {
         std::string url;
         std::chrono::milliseconds length;
-    };
-
-    /// A struct used to encapsulate information retrieved from an M3U playlist.
-    struct M3UContent {
-        std::vector<UrlAndInfo> childrenUrls;
-        bool endlistTagPresent;
-        bool streamInfTagPresent;
-        M3UContent() : endlistTagPresent{false}, streamInfTagPresent{false} {};
+        /// The requests made for this URL, or @c nullptr if none have been started.
+        std::shared_ptr<PlaylistFetch> fetch;
+        /// Whether this is a reload of a live playlist, which waits for the refresh time of the playlist.
+        bool isLiveRefresh;
     };
 
     /**
@@ -75,9 +120,13 @@ private:
      *
      * @param contentFetcherFactory The object that will be used to create objects with which to fetch content from
      * urls.
+     * @param maxConcurrentFetches The maximum number of URLs of a playlist which are fetched at the same time.
+     * @param fetchTimingObserver An optional observer to be notified of the timing of each request.
      */
     PlaylistParser(
-        std::shared_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface> contentFetcherFactory);
+        std::shared_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface> contentFetcherFactory,
+        size_t maxConcurrentFetches,
+        std::shared_ptr<FetchTimingObserverInterface> fetchTimingObserver);
 
     /**
      * Parses the playlist pointed to by the url specified in a depth first search manner.
@@ -93,87 +142,103 @@ private:
         std::vector<PlaylistType> playlistTypesToNotBeParsed);
 
     /**
-     * Parses an M3U playlist and returns the "children" URLs in the order they appeared in the playlist.
+     * Starts requests for the URLs at the front of the search, up to @c m_maxConcurrentFetches at a time.  Playlists
+     * whose content type is already known also have their bodies requested.
      *
-     * @param content The content to parse.
-     * @return A vector of URLs and their relevant metadata in the order they appeared in the playlist.
-     */
-    static M3UContent parseM3UContent(const std::string& playlistURL, const std::string& content);
-
-    /**
-     * Parses an PLS playlist and returns the "children" URLs in the order they appeared in the playlist.
-     *
-     * @param content The content to parse.
-     * @return A vector of URLs in the order they appeared in the playlist.
+     * @param id The id of the request.
+     * @param urlsToParse The URLs still to be searched.
+     * @param playlistTypesToNotBeParsed The playlist types which are not to be parsed.
+     * @param [in,out] numFetchesInFlight The number of URLs in @c urlsToParse with requests started.
      */
-    static std::vector<std::string> parsePLSContent(const std::string& playlistURL, const std::string& content);
+    void startFetches(
+        int id,
+        std::deque<UrlAndInfo>* urlsToParse,
+        const std::vector<PlaylistType>& playlistTypesToNotBeParsed,
+        size_t* numFetchesInFlight);
 
     /**
-     * Determines the playlist type of an M3U playlist.
+     * Starts the content type request for a URL.
      *
-     * @param playlistContent The M3U playlist in @c std::string format.
-     * @return @c true if the playlist is M3U8 or @c false otherwise
+     * @param url The URL to fetch.
+     * @return The requests for the URL.
      */
-    static bool isM3UPlaylistM3U8(const std::string& playlistContent);
+    std::shared_ptr<PlaylistFetch> startContentTypeFetch(const std::string& url);
 
     /**
-     * Removes a carriage return from the end of a line. This is required to handle Windows style line breaks ('\r\n').
-     * std::getline reads by default up to '\n' so at times, the '\r' may be included when readinglines.
+     * Starts the body request for a URL, if it has not been started yet.
      *
-     * @param line The line to parse
+     * @param url The URL to fetch.
+     * @param fetch The requests for the URL.
      */
-    static void removeCarriageReturnFromLine(std::string* line);
+    void startBodyFetch(const std::string& url, PlaylistFetch* fetch);
 
     /**
-     * Retrieves content from a URL and stores it into a string.
+     * Resolves the content type of a URL, waiting for it if @c wait is @c true.
      *
-     * @param url The URL to retrieve from.
-     * @param [out] content The playlist content.
-     * @return @c true if no error occured or @c false otherwise.
-     * @note This function should be used to retrieve content specifically from playlist URLs. Attempting to use this
-     * on a media URL could be blocking forever as the URL might point to a live stream.
+     * @param id The id of the request.
+     * @param url The URL fetched.
+     * @param fetch The requests for the URL.
+     * @param wait Whether to block until the content type is available.
+     * @return @c true if the content type has been resolved, @c false if @c wait is @c false and it is not ready yet.
      */
-    bool getContentFromPlaylistUrlIntoString(const std::string& url, std::string* content) const;
+    bool resolveContentType(int id, const std::string& url, PlaylistFetch* fetch, bool wait);
 
     /**
-     * Determines whether the provided url is an absolute url as opposed to a relative url. This is done by simply
-     * checking to see if the string contains the substring "://".
+     * Notify the fetch timing observer, if there is one, that a request has completed.
      *
-     * @param url The url to check.
-     * @return @c true if the url is an absolute url and @c false otherwise.
+     * @param id The id of the request.
+     * @param url The URL fetched.
+     * @param fetchOption What was fetched.
+     * @param start When the request was started.
+     * @param waitStart When the parser started waiting for the result.
      */
-    static bool isURLAbsolute(const std::string& url);
+    void notifyFetchCompleted(
+        int id,
+        const std::string& url,
+        avsCommon::sdkInterfaces::HTTPContentFetcherInterface::FetchOptions fetchOption,
+        std::chrono::steady_clock::time_point start,
+        std::chrono::steady_clock::time_point waitStart);
 
     /**
-     * Creates an absolute url, given a base url and a relative path from that url. For example, if
-     * "www.awesomewebsite.com/music/test.m3u" was the base url and the relative path was "music.mp3",
-     * "www.awesomewebsite.com/music/music.mp3" would be returned.
+     * Retrieves content from a URL and passes it to a parser as it arrives, using the body request already started for
+     * it if there is one.
      *
-     * @param baseURL The base url to add the relative path to.
-     * @param relativePath The relative path to add to the base url.
-     * @param [out] absoluteURL The absolute url generated
-     * @return @c true If everything was successful and @c false otherwise.
+     * @param id The id of the request.
+     * @param url The URL to retrieve from.
+     * @param fetch The requests for the URL.
+     * @param parser The parser to pass the content to.
+     * @return @c true if no error occured or @c false otherwise.
+     * @note This function should be used to retrieve content specifically from playlist URLs. Attempting to use this
+     * on a media URL could be blocking forever as the URL might point to a live stream.
      */
-    static bool getAbsoluteURLFromRelativePathToURL(
-        std::string baseURL,
-        std::string relativePath,
-        std::string* absoluteURL);
+    bool parsePlaylistContent(int id, const std::string& url, PlaylistFetch* fetch, PlaylistLineParser* parser);
 
     /**
-     * Used to parse the time length out of a playlist entry metadata line that starts with #EXTINF.
+     * Block until a time or until shutdown begins.
      *
-     * @param line The line to parse.
-     * @return The time length of the entry or @c PlaylistParserObserverInterface::INVALID_DURATION if the time length
-     * was unable to be parsed.
+     * @param time The time to wait until.
+     * @return @c true if the time was reached, or @c false if shutdown began first.
      */
-    static std::chrono::milliseconds parseRuntime(std::string line);
+    bool waitUntil(std::chrono::steady_clock::time_point time);
 
     /// Used to retrieve content from URLs
     std::shared_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface> m_contentFetcherFactory;
 
+    /// The maximum number of URLs of a playlist which are fetched at the same time.
+    const size_t m_maxConcurrentFetches;
+
+    /// The observer to notify of the timing of each request, or @c nullptr.
+    const std::shared_ptr<FetchTimingObserverInterface> m_fetchTimingObserver;
+
     /// Used to indicate that a shutdown is occurring.
     std::atomic<bool> m_shuttingDown;
 
+    /// Serializes setting @c m_shuttingDown with waiting on @c m_wakeTrigger.
+    std::mutex m_mutex;
+
+    /// Used to wake the wait for the refresh time of a live playlist when shutdown begins.
+    std::condition_variable m_wakeTrigger;
+
     /**
      * @c Executor which queues up operations from asynchronous API calls.
      *
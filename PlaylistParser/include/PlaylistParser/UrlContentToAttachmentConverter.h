@@ -16,13 +16,20 @@
 #ifndef ALEXA_CLIENT_SDK_PLAYLISTPARSER_INCLUDE_PLAYLISTPARSER_URLCONTENTTOATTACHMENTCONVERTER_H_
 #define ALEXA_CLIENT_SDK_PLAYLISTPARSER_INCLUDE_PLAYLISTPARSER_URLCONTENTTOATTACHMENTCONVERTER_H_
 
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
 #include <memory>
+#include <mutex>
 
 #include <AVSCommon/AVS/Attachment/InProcessAttachment.h>
 #include <AVSCommon/AVS/Attachment/InProcessAttachmentWriter.h>
 #include <AVSCommon/AVS/Attachment/InProcessAttachmentReader.h>
 
+#include <AVSCommon/SDKInterfaces/HTTPContentFetcherInterface.h>
 #include <AVSCommon/SDKInterfaces/HTTPContentFetcherInterfaceFactoryInterface.h>
+#include <AVSCommon/Utils/HTTPContent.h>
 #include <AVSCommon/Utils/PlaylistParser/PlaylistParserObserverInterface.h>
 #include <AVSCommon/Utils/RequiresShutdown.h>
 #include <AVSCommon/Utils/Threading/Executor.h>
@@ -32,11 +39,20 @@
 namespace alexaClientSDK {
 namespace playlistParser {
 
-/// Class that handles the streaming of urls containing media into @c Attachments.
+/**
+ * Class that handles the streaming of urls containing media into @c Attachments.
+ *
+ * The URLs found in a playlist are fetched ahead of the one being streamed, each into its own buffer, and the buffers
+ * are copied into the attachment in playlist order.  This hides the latency of each new request behind the playback of
+ * the URLs before it.
+ */
 class UrlContentToAttachmentConverter
         : public avsCommon::utils::playlistParser::PlaylistParserObserverInterface
         , public avsCommon::utils::RequiresShutdown {
 public:
+    /// The default maximum number of URLs fetched at once, including the one being streamed.
+    static const size_t DEFAULT_MAX_PREFETCH_SEGMENTS;
+
     /// Class to observe errors that arise from converting a URL to to an @c Attachment
     class ErrorObserverInterface {
     public:
@@ -59,6 +75,11 @@ public:
      * @param startTime The desired time to attempt to start streaming from. Note that this will only succeed
      * in cases where the URL points to a playlist with metadata about individual chunks within it. If none are found,
      * streaming will begin from the beginning.
+     * @param maxPrefetchSegments The maximum number of URLs fetched at once, including the one being streamed.  A value
+     * of 1 fetches each URL only once the previous one has been streamed.
+     * @param cacheSingleFile Whether @c url may be read from and stored in the cache of @c contentFetcherFactory if it
+     * is not a playlist, because it is a file such as a podcast episode which may be resumed or played again.  The
+     * entries of a playlist, which are usually segments of a live stream played once, are never cached.
      * @return A @c std::shared_ptr to the new @c UrlContentToAttachmentConverter object or @c nullptr on failure.
      *
      * @note This object is intended to be used once. Subsequent calls to @c convertPlaylistToAttachment() will fail.
@@ -67,7 +88,9 @@ public:
         std::shared_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface> contentFetcherFactory,
         const std::string& url,
         std::shared_ptr<ErrorObserverInterface> observer,
-        std::chrono::milliseconds startTime = std::chrono::milliseconds::zero());
+        std::chrono::milliseconds startTime = std::chrono::milliseconds::zero(),
+        size_t maxPrefetchSegments = DEFAULT_MAX_PREFETCH_SEGMENTS,
+        bool cacheSingleFile = false);
 
     /**
      * Returns the attachment into which the URL content was streamed into.
@@ -90,6 +113,21 @@ public:
      */
     std::chrono::milliseconds getDesiredStreamingPoint();
 
+    /**
+     * Gets the number of times streaming into the attachment stalled, after it had begun, because the content of the
+     * next URL had not yet arrived.  Waits too short to matter to playback are not counted.
+     *
+     * @return The number of underruns so far.
+     */
+    size_t getUnderrunCount() const;
+
+    /**
+     * Gets the total time streaming into the attachment has spent stalled waiting for content to arrive.
+     *
+     * @return The time spent in underruns so far.
+     */
+    std::chrono::milliseconds getUnderrunDuration() const;
+
     void doShutdown() override;
 
 private:
@@ -102,12 +140,44 @@ private:
      * @param desiredStartTime The desired time to attempt to start streaming from. Note that this will only succeed
      * in cases where the URL points to a playlist with metadata about individual chunks within it. If none are found,
      * streaming will begin from the beginning.
+     * @param maxPrefetchSegments The maximum number of URLs fetched at once, including the one being streamed.
+     * @param cacheSingleFile Whether @c url may be cached if it is not a playlist.
      */
     UrlContentToAttachmentConverter(
         std::shared_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface> contentFetcherFactory,
         const std::string& url,
         std::shared_ptr<ErrorObserverInterface> observer,
-        std::chrono::milliseconds startTime);
+        std::chrono::milliseconds startTime,
+        size_t maxPrefetchSegments,
+        bool cacheSingleFile);
+
+    /// A URL to stream, and its fetch once it has been started.
+    struct Segment {
+        /// The URL.
+        std::string url;
+
+        /// The fetcher downloading the URL, which is kept until its content has been streamed.
+        std::unique_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterface> fetcher;
+
+        /// The content being downloaded, or @c nullptr if the fetch has not started or could not be started.
+        std::unique_ptr<avsCommon::utils::HTTPContent> content;
+
+        /// Whether the fetch has been started.
+        bool fetchStarted = false;
+    };
+
+    /**
+     * Queue a URL to be streamed after the ones already queued, and start fetching it if there is room.
+     *
+     * @param url The URL.
+     */
+    void queueSegment(const std::string& url);
+
+    /**
+     * Start fetching queued URLs, in order, until @c m_maxPrefetchSegments fetches are active.  @c m_segmentsMutex
+     * must be held.
+     */
+    void startFetchesLocked();
 
     void onPlaylistEntryParsed(
         int requestId,
@@ -125,11 +195,28 @@ private:
     /// @{
 
     /**
-     * Downloads the content from the url and writes it into the internal stream.
+     * Writes the content of the next queued URL into the internal stream, waiting for it to arrive as needed.
+     *
+     * @return @c true if the content was successfully streamed and written or @c false otherwise.
+     */
+    bool writeNextSegmentIntoStream();
+
+    /**
+     * Writes the content of a URL into the internal stream, waiting for it to arrive as needed.
      *
+     * @param segment The URL and its fetch.
      * @return @c true if the content was successfully streamed and written or @c false otherwise.
      */
-    bool writeUrlContentIntoStream(std::string url);
+    bool writeSegmentIntoStream(Segment* segment);
+
+    /**
+     * Wait for content which has not arrived yet, recording the wait as an underrun if any content has already been
+     * written into the internal stream.
+     *
+     * @param isReady A function which waits up to a given time and returns whether the content has arrived.
+     * @return @c true once the content has arrived, or @c false if a shutdown began first.
+     */
+    bool waitForContent(std::function<bool(std::chrono::milliseconds)> isReady);
 
     /// @}
 
@@ -139,6 +226,9 @@ private:
     /// Used to retrieve content from URLs
     std::shared_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface> m_contentFetcherFactory;
 
+    /// The URL whose content may be cached if it is not a playlist, or an empty string if nothing may be cached.
+    const std::string m_cacheableUrl;
+
     /// Used to parse URLS that point to playlists.
     std::shared_ptr<PlaylistParser> m_playlistParser;
 
@@ -157,6 +247,24 @@ private:
     /// Flag to indicate if a shutdown is occurring.
     std::atomic<bool> m_shuttingDown;
 
+    /// The maximum number of URLs fetched at once, including the one being streamed.
+    const size_t m_maxPrefetchSegments;
+
+    /// Serializes access to @c m_segments and @c m_numActiveFetches.
+    std::mutex m_segmentsMutex;
+
+    /// The URLs waiting to be streamed, in order.  The fetches of those at the front have been started.
+    std::deque<std::shared_ptr<Segment>> m_segments;
+
+    /// The number of URLs which have been started and not yet fully streamed.
+    size_t m_numActiveFetches;
+
+    /// The number of times streaming stalled waiting for content.
+    std::atomic<size_t> m_underrunCount;
+
+    /// The total time, in milliseconds, streaming has stalled waiting for content.
+    std::atomic<int64_t> m_underrunMilliseconds;
+
     /**
      * @name @c onPlaylistEntryParsed Callback Variables
      *
@@ -187,6 +295,9 @@ private:
     /// @{
     /// Indicates whether the stream writer has closed.
     bool m_streamWriterClosed;
+
+    /// Indicates whether any content has been written into the internal stream.
+    bool m_streamedContent;
     /// @}
 
     /**
@@ -0,0 +1,58 @@
+/*
+ * Copyright 2017-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "PlaylistParser/LivePlaylistRefresher.h"
+
+namespace alexaClientSDK {
+namespace playlistParser {
+
+/// The target duration used for playlists which do not have an @c #EXT-X-TARGETDURATION tag.
+static const std::chrono::milliseconds DEFAULT_TARGET_DURATION = std::chrono::seconds(1);
+
+LivePlaylistRefresher::LivePlaylistRefresher() :
+        m_hasLastSequenceNumber{false},
+        m_lastSequenceNumber{0},
+        m_nextRefreshTime{std::chrono::steady_clock::now()} {
+}
+
+bool LivePlaylistRefresher::isNewSegment(uint64_t sequenceNumber) const {
+    return !m_hasLastSequenceNumber || sequenceNumber > m_lastSequenceNumber;
+}
+
+void LivePlaylistRefresher::onPlaylistLoaded(
+    std::chrono::steady_clock::time_point loadStart,
+    bool hasMediaSequence,
+    size_t numSegments,
+    uint64_t lastSequenceNumber,
+    bool hasNewSegments,
+    std::chrono::milliseconds targetDuration) {
+    if (!hasMediaSequence) {
+        m_hasLastSequenceNumber = false;
+    } else if (numSegments > 0) {
+        m_hasLastSequenceNumber = true;
+        m_lastSequenceNumber = lastSequenceNumber;
+    }
+    if (targetDuration < std::chrono::milliseconds::zero()) {
+        targetDuration = DEFAULT_TARGET_DURATION;
+    }
+    m_nextRefreshTime = loadStart + (hasNewSegments ? targetDuration : targetDuration / 2);
+}
+
+std::chrono::steady_clock::time_point LivePlaylistRefresher::getNextRefreshTime() const {
+    return m_nextRefreshTime;
+}
+
+}  // namespace playlistParser
+}  // namespace alexaClientSDK
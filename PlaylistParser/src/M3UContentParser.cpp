@@ -0,0 +1,258 @@
+/*
+ * Copyright 2017-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "PlaylistParser/M3UContentParser.h"
+
+#include <cctype>
+#include <limits>
+
+#include <AVSCommon/Utils/PlaylistParser/PlaylistParserObserverInterface.h>
+
+namespace alexaClientSDK {
+namespace playlistParser {
+
+/// The first line of an M3U8 playlist.
+static const std::string M3U8_PLAYLIST_HEADER = "#EXTM3U";
+
+/// A tag giving the duration of the next URL in the playlist.
+static const std::string EXTINF = "#EXTINF";
+
+/**
+ * A tag present in a live stream playlist that indicates that the next URL points to a playlist. Attributes of this tag
+ * include information such as bitrate, codecs, and others.
+ */
+static const std::string EXTSTREAMINF = "#EXT-X-STREAM-INF";
+
+/**
+ * A tag present in a live stream playlist indicating that no more URLs will be added to the playlist on subsequent
+ * requests.
+ */
+static const std::string ENDLIST = "#EXT-X-ENDLIST";
+
+/// A tag giving the sequence number of the first URL in the playlist.
+static const std::string MEDIASEQUENCE = "#EXT-X-MEDIA-SEQUENCE";
+
+/// A tag giving, in whole seconds, the longest duration of any URL in the playlist.
+static const std::string TARGETDURATION = "#EXT-X-TARGETDURATION";
+
+/// The duration of entries without a valid @c #EXTINF tag.
+static constexpr std::chrono::milliseconds INVALID_DURATION =
+    avsCommon::utils::playlistParser::PlaylistParserObserverInterface::INVALID_DURATION;
+
+M3UContentParser::M3UContentParser(const std::string& playlistURL, EntryCallback callback) :
+        PlaylistLineParser{playlistURL},
+        m_callback{callback},
+        m_isFirstLine{true},
+        m_isExtendedM3U{false},
+        m_streamInfTagPresent{false},
+        m_endlistTagPresent{false},
+        m_hasMediaSequence{false},
+        m_sequenceNumber{0},
+        m_targetDuration{INVALID_DURATION},
+        m_duration{INVALID_DURATION} {
+}
+
+/**
+ * Parse the value of a tag of the form "#EXT-TAG:1234".
+ *
+ * @param line The start of the line.
+ * @param length The length of the line.
+ * @param tagLength The length of the tag.
+ * @param [out] value The value.
+ * @return Whether the value is a valid decimal integer.
+ */
+static bool parseIntegerTag(const char* line, size_t length, size_t tagLength, uint64_t* value) {
+    size_t runner = tagLength;
+    if (runner == length || line[runner] != ':') {
+        return false;
+    }
+    ++runner;
+    while (runner < length && std::isspace(static_cast<unsigned char>(line[runner]))) {
+        ++runner;
+    }
+    if (runner == length || !std::isdigit(static_cast<unsigned char>(line[runner]))) {
+        return false;
+    }
+    uint64_t result = 0;
+    while (runner < length && std::isdigit(static_cast<unsigned char>(line[runner]))) {
+        auto digit = static_cast<uint64_t>(line[runner] - '0');
+        if (result > (std::numeric_limits<uint64_t>::max() - digit) / 10) {
+            return false;
+        }
+        result = result * 10 + digit;
+        ++runner;
+    }
+    *value = result;
+    return true;
+}
+
+bool M3UContentParser::isExtendedM3U() const {
+    return m_isExtendedM3U;
+}
+
+bool M3UContentParser::isStreamInfTagPresent() const {
+    return m_streamInfTagPresent;
+}
+
+bool M3UContentParser::isEndlistTagPresent() const {
+    return m_endlistTagPresent;
+}
+
+bool M3UContentParser::hasMediaSequence() const {
+    return m_hasMediaSequence;
+}
+
+std::chrono::milliseconds M3UContentParser::getTargetDuration() const {
+    return m_targetDuration;
+}
+
+void M3UContentParser::onLine(const char* line, size_t length) {
+    if (m_isFirstLine) {
+        /*
+         * This isn't the best way of determining whether a playlist is M3U8 or M3U. The playlist header searched for
+         * is "EXTM3U" which indicates that this playlist is an "Extended M3U" playlist as opposed to a plain M3U
+         * playlist. All M3U8 playlists seen so far are also extended M3U playlists, but this might not be guaranteed.
+         */
+        m_isExtendedM3U = startsWith(line, length, M3U8_PLAYLIST_HEADER);
+        m_isFirstLine = false;
+    }
+    size_t firstChar = 0;
+    while (firstChar < length && std::isspace(static_cast<unsigned char>(line[firstChar]))) {
+        ++firstChar;
+    }
+    if (firstChar == length) {
+        return;
+    }
+    if (line[firstChar] == '#') {
+        if (startsWith(line, length, EXTINF)) {
+            m_duration = parseRuntime(line, length);
+        } else if (startsWith(line, length, EXTSTREAMINF)) {
+            m_streamInfTagPresent = true;
+        } else if (startsWith(line, length, ENDLIST)) {
+            m_endlistTagPresent = true;
+        } else if (startsWith(line, length, MEDIASEQUENCE)) {
+            uint64_t mediaSequence;
+            if (parseIntegerTag(line, length, MEDIASEQUENCE.length(), &mediaSequence)) {
+                m_hasMediaSequence = true;
+                m_sequenceNumber = mediaSequence;
+            }
+        } else if (startsWith(line, length, TARGETDURATION)) {
+            uint64_t seconds;
+            if (parseIntegerTag(line, length, TARGETDURATION.length(), &seconds) &&
+                seconds <= static_cast<uint64_t>(std::numeric_limits<int>::max())) {
+                m_targetDuration = std::chrono::seconds(seconds);
+            }
+        }
+        return;
+    }
+    // At this point, the line is a URL.
+    if (resolveURL(line, length, &m_url)) {
+        if (m_callback) {
+            m_callback(m_url, m_duration, m_sequenceNumber);
+        }
+        m_duration = INVALID_DURATION;
+        ++m_sequenceNumber;
+    }
+}
+
+std::chrono::milliseconds M3UContentParser::parseRuntime(const char* line, size_t length) {
+    // #EXTINF:1234.00, blah blah blah have you ever heard the tragedy of darth plagueis the wise?
+    size_t runner = EXTINF.length();
+    auto skipWhitespace = [line, length, &runner]() {
+        while (runner < length && std::isspace(static_cast<unsigned char>(line[runner]))) {
+            ++runner;
+        }
+    };
+    // Read the next character which is not whitespace, leaving @c c unchanged if there is none.
+    auto readChar = [line, length, &runner, &skipWhitespace](char* c) {
+        skipWhitespace();
+        if (runner == length) {
+            return false;
+        }
+        *c = line[runner++];
+        return true;
+    };
+
+    char nextChar;
+    if (!readChar(&nextChar) || nextChar != ':') {
+        return INVALID_DURATION;
+    }
+    skipWhitespace();
+    if (runner == length) {
+        return INVALID_DURATION;
+    }
+
+    // Read the whole seconds.
+    bool negative = false;
+    if (line[runner] == '+' || line[runner] == '-') {
+        negative = line[runner] == '-';
+        ++runner;
+    }
+    if (runner == length || !std::isdigit(static_cast<unsigned char>(line[runner]))) {
+        return INVALID_DURATION;
+    }
+    long long seconds = 0;
+    while (runner < length && std::isdigit(static_cast<unsigned char>(line[runner]))) {
+        seconds = seconds * 10 + (line[runner] - '0');
+        if (seconds > std::numeric_limits<int>::max()) {
+            return INVALID_DURATION;
+        }
+        ++runner;
+    }
+    if (negative && seconds != 0) {
+        return INVALID_DURATION;
+    }
+    std::chrono::milliseconds duration = std::chrono::seconds(seconds);
+    if (!readChar(&nextChar)) {
+        return duration;
+    }
+    if (nextChar == '.') {
+        int digitsSoFar = 0;
+        unsigned int fractionalSeconds = 0;
+        // we only care about the first 3 (sig figs = millisecond limit)
+        while (digitsSoFar < 3) {
+            if (!readChar(&nextChar)) {
+                break;
+            }
+            if (!std::isdigit(static_cast<unsigned char>(nextChar))) {
+                break;
+            }
+            fractionalSeconds *= 10;
+            fractionalSeconds += (nextChar - '0');
+            ++digitsSoFar;
+        }
+        // if we read say "1", this is equivalent to 0.1 s or 100 ms
+        while (digitsSoFar < 3) {
+            fractionalSeconds *= 10;
+            ++digitsSoFar;
+        }
+        duration += std::chrono::milliseconds(fractionalSeconds);
+    }
+    do {
+        if (std::isdigit(static_cast<unsigned char>(nextChar))) {
+            continue;
+        } else {
+            if (nextChar == ',') {
+                break;
+            } else {
+                return INVALID_DURATION;
+            }
+        }
+    } while (readChar(&nextChar));
+    return duration;
+}
+
+}  // namespace playlistParser
+}  // namespace alexaClientSDK
@@ -0,0 +1,44 @@
+/*
+ * Copyright 2017-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "PlaylistParser/PLSContentParser.h"
+
+#include <cstring>
+
+namespace alexaClientSDK {
+namespace playlistParser {
+
+/// The beginning of a line in a PLS file indicating a URL.
+static const std::string PLS_FILE = "File";
+
+PLSContentParser::PLSContentParser(const std::string& playlistURL, EntryCallback callback) :
+        PlaylistLineParser{playlistURL},
+        m_callback{callback} {
+}
+
+void PLSContentParser::onLine(const char* line, size_t length) {
+    if (!startsWith(line, length, PLS_FILE)) {
+        return;
+    }
+    // The URL follows the first '='.  A line without one is taken as a URL in its entirety.
+    auto equals = static_cast<const char*>(std::memchr(line, '=', length));
+    const char* url = equals ? equals + 1 : line;
+    if (resolveURL(url, length - (url - line), &m_url) && m_callback) {
+        m_callback(m_url);
+    }
+}
+
+}  // namespace playlistParser
+}  // namespace alexaClientSDK
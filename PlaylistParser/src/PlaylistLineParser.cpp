@@ -0,0 +1,95 @@
+/*
+ * Copyright 2017-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "PlaylistParser/PlaylistLineParser.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace alexaClientSDK {
+namespace playlistParser {
+
+/// The separator which marks a URL as absolute.
+static const std::string SCHEME_SEPARATOR = "://";
+
+PlaylistLineParser::PlaylistLineParser(const std::string& playlistURL) : m_hasBaseURL{false} {
+    auto positionOfLastSlash = playlistURL.find_last_of('/');
+    if (positionOfLastSlash != std::string::npos) {
+        m_baseURL = playlistURL.substr(0, positionOfLastSlash + 1);
+        m_hasBaseURL = true;
+    }
+}
+
+void PlaylistLineParser::feed(const char* data, size_t size) {
+    const char* end = data + size;
+    const char* lineStart = data;
+    const char* lineEnd = static_cast<const char*>(std::memchr(lineStart, '\n', size));
+    if (!m_partialLine.empty()) {
+        if (!lineEnd) {
+            m_partialLine.append(data, size);
+            return;
+        }
+        m_partialLine.append(lineStart, lineEnd - lineStart);
+        dispatchLine(m_partialLine.data(), m_partialLine.size());
+        m_partialLine.clear();
+        lineStart = lineEnd + 1;
+        lineEnd = static_cast<const char*>(std::memchr(lineStart, '\n', end - lineStart));
+    }
+    while (lineEnd) {
+        dispatchLine(lineStart, lineEnd - lineStart);
+        lineStart = lineEnd + 1;
+        lineEnd = static_cast<const char*>(std::memchr(lineStart, '\n', end - lineStart));
+    }
+    m_partialLine.append(lineStart, end - lineStart);
+}
+
+void PlaylistLineParser::finish() {
+    if (!m_partialLine.empty()) {
+        dispatchLine(m_partialLine.data(), m_partialLine.size());
+        m_partialLine.clear();
+    }
+}
+
+bool PlaylistLineParser::resolveURL(const char* url, size_t length, std::string* resolved) const {
+    if (!resolved) {
+        return false;
+    }
+    const char* end = url + length;
+    if (std::search(url, end, SCHEME_SEPARATOR.begin(), SCHEME_SEPARATOR.end()) != end) {
+        resolved->assign(url, length);
+        return true;
+    }
+    if (!m_hasBaseURL) {
+        return false;
+    }
+    resolved->assign(m_baseURL);
+    resolved->append(url, length);
+    return true;
+}
+
+bool PlaylistLineParser::startsWith(const char* line, size_t length, const std::string& prefix) {
+    return length >= prefix.length() && prefix.compare(0, prefix.length(), line, prefix.length()) == 0;
+}
+
+void PlaylistLineParser::dispatchLine(const char* line, size_t length) {
+    // Handle Windows style line breaks ("\r\n").
+    if (length > 0 && line[length - 1] == '\r') {
+        --length;
+    }
+    onLine(line, length);
+}
+
+}  // namespace playlistParser
+}  // namespace alexaClientSDK
@@ -16,11 +16,14 @@
 #include "PlaylistParser/PlaylistParser.h"
 
 #include <algorithm>
-#include <sstream>
 
 #include <AVSCommon/Utils/Logger/Logger.h>
 #include <AVSCommon/Utils/PlaylistParser/PlaylistParserObserverInterface.h>
 
+#include "PlaylistParser/LivePlaylistRefresher.h"
+#include "PlaylistParser/M3UContentParser.h"
+#include "PlaylistParser/PLSContentParser.h"
+
 namespace alexaClientSDK {
 namespace playlistParser {
 
@@ -46,38 +49,27 @@ static const size_t CHUNK_SIZE(1024);
 /// The id of each request.
 static int g_id = 0;
 
-/// The first line of an M3U8 playlist.
-static const std::string M3U8_PLAYLIST_HEADER = "#EXTM3U";
-
-static const std::string EXTINF = "#EXTINF";
-
-/**
- * A tag present in a live stream playlist that indicates that the next URL points to a playlist. Attributes of this tag
- * include information such as bitrate, codecs, and others.
- */
-static const std::string EXTSTREAMINF = "#EXT-X-STREAM-INF";
-
-/**
- * A tag present in a live stream playlist indicating that no more URLs will be added to the playlist on subsequent
- * requests.
- */
-static const std::string ENDLIST = "#EXT-X-ENDLIST";
-
 /// The first line of a PLS playlist.
 static const std::string PLS_PLAYLIST_HEADER = "[playlist]";
 
-/// The beginning of a line in a PLS file indicating a URL.
-static const std::string PLS_FILE = "File";
-
 static const std::chrono::milliseconds INVALID_DURATION =
     avsCommon::utils::playlistParser::PlaylistParserObserverInterface::INVALID_DURATION;
 
+const size_t PlaylistParser::DEFAULT_MAX_CONCURRENT_FETCHES;
+
 std::unique_ptr<PlaylistParser> PlaylistParser::create(
-    std::shared_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface> contentFetcherFactory) {
+    std::shared_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface> contentFetcherFactory,
+    size_t maxConcurrentFetches,
+    std::shared_ptr<FetchTimingObserverInterface> fetchTimingObserver) {
     if (!contentFetcherFactory) {
         return nullptr;
     }
-    return std::unique_ptr<PlaylistParser>(new PlaylistParser(contentFetcherFactory));
+    if (0 == maxConcurrentFetches) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "zeroMaxConcurrentFetches"));
+        return nullptr;
+    }
+    return std::unique_ptr<PlaylistParser>(
+        new PlaylistParser(contentFetcherFactory, maxConcurrentFetches, fetchTimingObserver));
 }
 
 int PlaylistParser::parsePlaylist(
@@ -100,9 +92,13 @@ int PlaylistParser::parsePlaylist(
 }
 
 PlaylistParser::PlaylistParser(
-    std::shared_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface> contentFetcherFactory) :
+    std::shared_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface> contentFetcherFactory,
+    size_t maxConcurrentFetches,
+    std::shared_ptr<FetchTimingObserverInterface> fetchTimingObserver) :
         RequiresShutdown{"PlaylistParser"},
         m_contentFetcherFactory{contentFetcherFactory},
+        m_maxConcurrentFetches{maxConcurrentFetches},
+        m_fetchTimingObserver{fetchTimingObserver},
         m_shuttingDown{false} {
 }
 
@@ -115,13 +111,26 @@ void PlaylistParser::doDepthFirstSearch(
      * A depth first search, as follows:
      * 1. Push root to vector.
      * 2. While vector isn't empty, pop from front and push children, in the order they appeared, to front of vector.
+     *
+     * The URLs at the front of the vector are fetched concurrently ahead of being popped, so a playlist of several
+     * URLs costs about one round trip rather than one per URL, while the observer is still notified in order.
      */
     std::deque<UrlAndInfo> urlsToParse;
     urlsToParse.push_front({rootUrl, INVALID_DURATION});
     std::string lastUrlParsed;
+    LivePlaylistRefresher liveRefresher;
+    size_t numFetchesInFlight = 0;
     while (!urlsToParse.empty() && !m_shuttingDown) {
+        startFetches(id, &urlsToParse, playlistTypesToNotBeParsed, &numFetchesInFlight);
         auto urlAndInfo = urlsToParse.front();
         urlsToParse.pop_front();
+        if (urlAndInfo.isLiveRefresh) {
+            if (!waitUntil(liveRefresher.getNextRefreshTime())) {
+                return;
+            }
+        } else if (urlAndInfo.fetch) {
+            --numFetchesInFlight;
+        }
         if (urlAndInfo.length != INVALID_DURATION) {
             // This is a media URL and not a playlist
             ACSDK_DEBUG9(LX("foundNonPlaylistURL"));
@@ -133,25 +142,41 @@ void PlaylistParser::doDepthFirstSearch(
                 urlAndInfo.length);
             continue;
         }
-        auto contentFetcher = m_contentFetcherFactory->create(urlAndInfo.url);
-        auto httpContent = contentFetcher->getContent(
-            avsCommon::sdkInterfaces::HTTPContentFetcherInterface::FetchOptions::CONTENT_TYPE);
-        if (!httpContent || !(*httpContent)) {
+        auto fetch = urlAndInfo.fetch ? urlAndInfo.fetch : startContentTypeFetch(urlAndInfo.url);
+        urlAndInfo.fetch.reset();
+        resolveContentType(id, urlAndInfo.url, fetch.get(), true);
+        if (!fetch->contentTypeSucceeded) {
             ACSDK_ERROR(LX("getHTTPContent").d("reason", "badHTTPContentReceived"));
             observer->onPlaylistEntryParsed(
                 id, urlAndInfo.url, avsCommon::utils::playlistParser::PlaylistParseResult::ERROR, urlAndInfo.length);
             return;
         }
-        std::string contentType = httpContent->contentType.get();
+        const std::string& contentType = fetch->contentType;
         ACSDK_DEBUG9(LX("PlaylistParser")
                          .d("contentType", contentType)
                          .sensitive("url", urlAndInfo.url)
                          .d("length", urlAndInfo.length.count()));
-        std::transform(contentType.begin(), contentType.end(), contentType.begin(), ::tolower);
         // Checking the HTML content type to see if the URL is a playlist.
         if (contentType.find(M3U_CONTENT_TYPE) != std::string::npos) {
-            std::string playlistContent;
-            if (!getContentFromPlaylistUrlIntoString(urlAndInfo.url, &playlistContent)) {
+            /*
+             * When reloading a live playlist, the segments which were already seen are skipped as they are parsed, so
+             * only the new ones are kept.
+             */
+            std::vector<UrlAndInfo> childrenUrls;
+            size_t numChildren = 0;
+            uint64_t lastSequenceNumber = 0;
+            bool isLiveRefresh = urlAndInfo.isLiveRefresh;
+            M3UContentParser parser(
+                urlAndInfo.url,
+                [&childrenUrls, &numChildren, &lastSequenceNumber, &liveRefresher, isLiveRefresh](
+                    const std::string& url, std::chrono::milliseconds duration, uint64_t sequenceNumber) {
+                    ++numChildren;
+                    lastSequenceNumber = sequenceNumber;
+                    if (!isLiveRefresh || liveRefresher.isNewSegment(sequenceNumber)) {
+                        childrenUrls.push_back({url, duration, nullptr});
+                    }
+                });
+            if (!parsePlaylistContent(id, urlAndInfo.url, fetch.get(), &parser)) {
                 ACSDK_ERROR(LX("failedToRetrieveContent").sensitive("url", urlAndInfo.url));
                 observer->onPlaylistEntryParsed(
                     id,
@@ -161,7 +186,7 @@ void PlaylistParser::doDepthFirstSearch(
                 return;
             }
             // This playlist may either be M3U or M3U8 so some additional parsing is required.
-            bool isM3U8 = isM3UPlaylistM3U8(playlistContent);
+            bool isM3U8 = parser.isExtendedM3U();
             if (isM3U8) {
                 ACSDK_DEBUG9(LX("isM3U8Playlist").sensitive("url", urlAndInfo.url));
             } else {
@@ -180,9 +205,7 @@ void PlaylistParser::doDepthFirstSearch(
                     urlAndInfo.length);
                 continue;
             }
-            auto M3UContent = parseM3UContent(urlAndInfo.url, playlistContent);
-            const auto& childrenUrls = M3UContent.childrenUrls;
-            if (childrenUrls.empty()) {
+            if (0 == numChildren) {
                 ACSDK_ERROR(LX("noChildrenURLs"));
                 observer->onPlaylistEntryParsed(
                     id,
@@ -193,16 +216,24 @@ void PlaylistParser::doDepthFirstSearch(
             }
             ACSDK_DEBUG9((LX("foundChildrenURLsInPlaylist").d("num", childrenUrls.size())));
             if (isM3U8) {
-                if (M3UContent.streamInfTagPresent) {
+                if (parser.isStreamInfTagPresent()) {
                     // Indicates that this is the Master Playlist and that only one URL should be chosen from here
                     ACSDK_DEBUG9(LX("encounteredMasterPlaylist").sensitive("url", urlAndInfo.url));
                     // Because we don't do any selective choosing based on bitrates or codecs, only push the first URL
                     // as a default.
                     urlsToParse.push_front(childrenUrls.front());
                 } else {
-                    // lastUrlParsed is set when we actually parse some urls from the playlist - here, it is our first
-                    // pass at this playlist
-                    if (lastUrlParsed.empty()) {
+                    if (parser.hasMediaSequence()) {
+                        // The segments already seen have been skipped by their sequence numbers.
+                        for (auto reverseIt = childrenUrls.rbegin(); reverseIt != childrenUrls.rend(); ++reverseIt) {
+                            urlsToParse.push_front(*reverseIt);
+                        }
+                        if (!childrenUrls.empty()) {
+                            lastUrlParsed = childrenUrls.back().url;
+                        }
+                    } else if (lastUrlParsed.empty()) {
+                        // lastUrlParsed is set when we actually parse some urls from the playlist - here, it is our
+                        // first pass at this playlist
                         for (auto reverseIt = childrenUrls.rbegin(); reverseIt != childrenUrls.rend(); ++reverseIt) {
                             urlsToParse.push_front(*reverseIt);
                         }
@@ -225,16 +256,33 @@ void PlaylistParser::doDepthFirstSearch(
                             lastUrlParsed = urlsToParse.back().url;
                         }
                     }
-                    if (!M3UContent.endlistTagPresent) {
+                    if (!parser.isEndlistTagPresent()) {
+                        liveRefresher.onPlaylistLoaded(
+                            fetch->bodyStart,
+                            parser.hasMediaSequence(),
+                            numChildren,
+                            lastSequenceNumber,
+                            !childrenUrls.empty(),
+                            parser.getTargetDuration());
                         ACSDK_DEBUG9(LX("encounteredLiveHLSPlaylist")
                                          .sensitive("url", urlAndInfo.url)
-                                         .d("info", "willRetryURLInFuture"));
+                                         .d("info", "willRetryURLInFuture")
+                                         .d("newSegments", childrenUrls.size())
+                                         .d("refreshInMs",
+                                            std::chrono::duration_cast<std::chrono::milliseconds>(
+                                                liveRefresher.getNextRefreshTime() - std::chrono::steady_clock::now())
+                                                .count()));
                         /*
                          * Because this URL represents a live playlist which can have additional chunks added to it, we
                          * need to make a request to this URL again in the future to continue playback of additional
-                         * chunks that get added.
+                         * chunks that get added.  Its content type is already known, so the reload only fetches the
+                         * body, and it is not started until the refresh time.
                          */
-                        urlsToParse.push_back(urlAndInfo);
+                        auto refreshFetch = std::make_shared<PlaylistFetch>();
+                        refreshFetch->contentTypeResolved = true;
+                        refreshFetch->contentTypeSucceeded = true;
+                        refreshFetch->contentType = contentType;
+                        urlsToParse.push_back({urlAndInfo.url, urlAndInfo.length, refreshFetch, true});
                     }
                 }
             } else {
@@ -258,8 +306,10 @@ void PlaylistParser::doDepthFirstSearch(
                     urlAndInfo.length);
                 continue;
             }
-            std::string playlistContent;
-            if (!getContentFromPlaylistUrlIntoString(urlAndInfo.url, &playlistContent)) {
+            std::vector<std::string> childrenUrls;
+            PLSContentParser parser(
+                urlAndInfo.url, [&childrenUrls](const std::string& url) { childrenUrls.push_back(url); });
+            if (!parsePlaylistContent(id, urlAndInfo.url, fetch.get(), &parser)) {
                 observer->onPlaylistEntryParsed(
                     id,
                     urlAndInfo.url,
@@ -267,7 +317,6 @@ void PlaylistParser::doDepthFirstSearch(
                     urlAndInfo.length);
                 return;
             }
-            auto childrenUrls = parsePLSContent(urlAndInfo.url, playlistContent);
             if (childrenUrls.empty()) {
                 observer->onPlaylistEntryParsed(
                     id,
@@ -292,30 +341,146 @@ void PlaylistParser::doDepthFirstSearch(
     }
 }
 
-bool PlaylistParser::getContentFromPlaylistUrlIntoString(const std::string& url, std::string* content) const {
-    if (!content) {
-        ACSDK_ERROR(LX("getContentFromPlaylistUrlIntoStringFailed").d("reason", "nullString"));
+void PlaylistParser::startFetches(
+    int id,
+    std::deque<UrlAndInfo>* urlsToParse,
+    const std::vector<PlaylistType>& playlistTypesToNotBeParsed,
+    size_t* numFetchesInFlight) {
+    /*
+     * Only the URLs which need fetching count towards the limit, and the scan stops after the first
+     * m_maxConcurrentFetches of them, since URLs further back could not be started anyway.
+     */
+    size_t numScanned = 0;
+    for (auto it = urlsToParse->begin(); it != urlsToParse->end() && numScanned < m_maxConcurrentFetches; ++it) {
+        if (it->length != INVALID_DURATION || it->isLiveRefresh) {
+            // A media URL, which is passed on without being fetched, or a live playlist waiting for its refresh time.
+            continue;
+        }
+        ++numScanned;
+        if (!it->fetch) {
+            if (*numFetchesInFlight >= m_maxConcurrentFetches) {
+                continue;
+            }
+            it->fetch = startContentTypeFetch(it->url);
+            ++(*numFetchesInFlight);
+            continue;
+        }
+        if (it->fetch->bodyFetcher || !resolveContentType(id, it->url, it->fetch.get(), false) ||
+            !it->fetch->contentTypeSucceeded) {
+            continue;
+        }
+        // The content type is known, so playlists that will be parsed can have their bodies requested too.
+        const auto& contentType = it->fetch->contentType;
+        if (contentType.find(M3U_CONTENT_TYPE) != std::string::npos ||
+            (contentType.find(PLS_CONTENT_TYPE) != std::string::npos &&
+             std::find(playlistTypesToNotBeParsed.begin(), playlistTypesToNotBeParsed.end(), PlaylistType::PLS) ==
+                 playlistTypesToNotBeParsed.end())) {
+            startBodyFetch(it->url, it->fetch.get());
+        }
+    }
+}
+
+std::shared_ptr<PlaylistParser::PlaylistFetch> PlaylistParser::startContentTypeFetch(const std::string& url) {
+    auto fetch = std::make_shared<PlaylistFetch>();
+    fetch->contentTypeStart = std::chrono::steady_clock::now();
+    fetch->contentTypeFetcher = m_contentFetcherFactory->create(url);
+    if (fetch->contentTypeFetcher) {
+        fetch->contentTypeResponse = fetch->contentTypeFetcher->getContent(
+            avsCommon::sdkInterfaces::HTTPContentFetcherInterface::FetchOptions::CONTENT_TYPE);
+    }
+    return fetch;
+}
+
+void PlaylistParser::startBodyFetch(const std::string& url, PlaylistFetch* fetch) {
+    if (fetch->bodyFetcher) {
+        return;
+    }
+    fetch->bodyStart = std::chrono::steady_clock::now();
+    fetch->bodyFetcher = m_contentFetcherFactory->create(url);
+    if (fetch->bodyFetcher) {
+        fetch->bodyResponse = fetch->bodyFetcher->getContent(
+            avsCommon::sdkInterfaces::HTTPContentFetcherInterface::FetchOptions::ENTIRE_BODY);
+    }
+}
+
+bool PlaylistParser::resolveContentType(int id, const std::string& url, PlaylistFetch* fetch, bool wait) {
+    if (fetch->contentTypeResolved) {
+        return true;
+    }
+    auto& response = fetch->contentTypeResponse;
+    if (response && !wait &&
+        (response->statusCode.wait_for(std::chrono::milliseconds::zero()) != std::future_status::ready ||
+         response->contentType.wait_for(std::chrono::milliseconds::zero()) != std::future_status::ready)) {
+        return false;
+    }
+    auto waitStart = std::chrono::steady_clock::now();
+    fetch->contentTypeResolved = true;
+    if (response && *response) {
+        fetch->contentTypeSucceeded = true;
+        fetch->contentType = response->contentType.get();
+        std::transform(
+            fetch->contentType.begin(), fetch->contentType.end(), fetch->contentType.begin(), ::tolower);
+    }
+    response.reset();
+    notifyFetchCompleted(
+        id,
+        url,
+        avsCommon::sdkInterfaces::HTTPContentFetcherInterface::FetchOptions::CONTENT_TYPE,
+        fetch->contentTypeStart,
+        waitStart);
+    return true;
+}
+
+void PlaylistParser::notifyFetchCompleted(
+    int id,
+    const std::string& url,
+    avsCommon::sdkInterfaces::HTTPContentFetcherInterface::FetchOptions fetchOption,
+    std::chrono::steady_clock::time_point start,
+    std::chrono::steady_clock::time_point waitStart) {
+    auto now = std::chrono::steady_clock::now();
+    FetchTiming timing{url,
+                       fetchOption,
+                       std::chrono::duration_cast<std::chrono::milliseconds>(now - start),
+                       std::chrono::duration_cast<std::chrono::milliseconds>(now - waitStart)};
+    ACSDK_DEBUG9(LX("fetchCompleted")
+                     .d("id", id)
+                     .sensitive("url", url)
+                     .d("entireBody",
+                        avsCommon::sdkInterfaces::HTTPContentFetcherInterface::FetchOptions::ENTIRE_BODY == fetchOption)
+                     .d("elapsedMs", timing.elapsed.count())
+                     .d("waitedMs", timing.waited.count()));
+    if (m_fetchTimingObserver) {
+        m_fetchTimingObserver->onFetchCompleted(id, timing);
+    }
+}
+
+bool PlaylistParser::parsePlaylistContent(
+    int id,
+    const std::string& url,
+    PlaylistFetch* fetch,
+    PlaylistLineParser* parser) {
+    if (!parser) {
+        ACSDK_ERROR(LX("parsePlaylistContentFailed").d("reason", "nullParser"));
         return false;
     }
-    auto contentFetcher = m_contentFetcherFactory->create(url);
-    auto httpContent =
-        contentFetcher->getContent(avsCommon::sdkInterfaces::HTTPContentFetcherInterface::FetchOptions::ENTIRE_BODY);
+    startBodyFetch(url, fetch);
+    auto waitStart = std::chrono::steady_clock::now();
+    auto httpContent = std::move(fetch->bodyResponse);
     if (!httpContent) {
-        ACSDK_ERROR(LX("getContentFromPlaylistUrlIntoStringFailed").d("reason", "nullHTTPContentReceived"));
+        ACSDK_ERROR(LX("parsePlaylistContentFailed").d("reason", "nullHTTPContentReceived"));
         return false;
     }
     if (!(*httpContent)) {
-        ACSDK_ERROR(LX("getContentFromPlaylistUrlIntoStringFailed").d("reason", "badHTTPContentReceived"));
+        ACSDK_ERROR(LX("parsePlaylistContentFailed").d("reason", "badHTTPContentReceived"));
         return false;
     }
     auto reader = httpContent->dataStream->createReader(avsCommon::utils::sds::ReaderPolicy::BLOCKING);
     if (!reader) {
-        ACSDK_ERROR(LX("getContentFromPlaylistUrlIntoStringFailed").d("reason", "failedToCreateStreamReader"));
+        ACSDK_ERROR(LX("parsePlaylistContentFailed").d("reason", "failedToCreateStreamReader"));
         return false;
     }
     avsCommon::avs::attachment::AttachmentReader::ReadStatus readStatus =
         avsCommon::avs::attachment::AttachmentReader::ReadStatus::OK;
-    std::string playlistContent;
     std::vector<char> buffer(CHUNK_SIZE, 0);
     bool streamClosed = false;
     while (!streamClosed) {
@@ -330,222 +495,36 @@ bool PlaylistParser::getContentFromPlaylistUrlIntoString(const std::string& url,
             case avsCommon::avs::attachment::AttachmentReader::ReadStatus::OK:
             case avsCommon::avs::attachment::AttachmentReader::ReadStatus::OK_WOULDBLOCK:
             case avsCommon::avs::attachment::AttachmentReader::ReadStatus::OK_TIMEDOUT:
-                playlistContent.append(buffer.data(), bytesRead);
+                parser->feed(buffer.data(), bytesRead);
                 break;
             case avsCommon::avs::attachment::AttachmentReader::ReadStatus::ERROR_OVERRUN:
             case avsCommon::avs::attachment::AttachmentReader::ReadStatus::ERROR_BYTES_LESS_THAN_WORD_SIZE:
             case avsCommon::avs::attachment::AttachmentReader::ReadStatus::ERROR_INTERNAL:
-                ACSDK_ERROR(LX("getContentFromPlaylistUrlIntoStringFailed").d("reason", "readError"));
+                ACSDK_ERROR(LX("parsePlaylistContentFailed").d("reason", "readError"));
                 return false;
         }
     }
-    *content = playlistContent;
+    notifyFetchCompleted(
+        id,
+        url,
+        avsCommon::sdkInterfaces::HTTPContentFetcherInterface::FetchOptions::ENTIRE_BODY,
+        fetch->bodyStart,
+        waitStart);
+    parser->finish();
     return true;
 }
 
-PlaylistParser::M3UContent PlaylistParser::parseM3UContent(const std::string& playlistURL, const std::string& content) {
-    /*
-     * An M3U playlist is formatted such that all metadata information is prepended with a '#' and everything else is a
-     * URL to play.
-     */
-    M3UContent parsedContent;
-    std::istringstream iss(content);
-    std::string line;
-    UrlAndInfo entry;
-    entry.length = INVALID_DURATION;
-    while (std::getline(iss, line)) {
-        removeCarriageReturnFromLine(&line);
-        std::istringstream iss2(line);
-        char firstChar;
-        iss2 >> firstChar;
-        if (!iss2) {
-            continue;
-        }
-        if (firstChar == '#') {
-            if (line.compare(0, EXTINF.length(), EXTINF) == 0) {
-                entry.length = parseRuntime(line);
-            } else if (line.compare(0, EXTSTREAMINF.length(), EXTSTREAMINF) == 0) {
-                parsedContent.streamInfTagPresent = true;
-            } else if (line.compare(0, ENDLIST.length(), ENDLIST) == 0) {
-                parsedContent.endlistTagPresent = true;
-            }
-            continue;
-        }
-        // at this point, "line" is a url
-        if (isURLAbsolute(line)) {
-            entry.url = line;
-            parsedContent.childrenUrls.push_back(entry);
-            entry.url.clear();
-            entry.length = INVALID_DURATION;
-        } else {
-            std::string absoluteURL;
-            if (getAbsoluteURLFromRelativePathToURL(playlistURL, line, &absoluteURL)) {
-                entry.url = absoluteURL;
-                parsedContent.childrenUrls.push_back(entry);
-                entry.url.clear();
-                entry.length = INVALID_DURATION;
-            }
-        }
-    }
-    return parsedContent;
-}
-
-std::vector<std::string> PlaylistParser::parsePLSContent(const std::string& playlistURL, const std::string& content) {
-    /*
-     * A PLS playlist is formatted such that all URLs to play are prepended with "File'N'=", where 'N' refers to the
-     * numbered URL. For example "File1=url.com ... File2="anotherurl.com".
-     */
-    std::vector<std::string> urlsParsed;
-    std::istringstream iss(content);
-    std::string line;
-    while (std::getline(iss, line)) {
-        removeCarriageReturnFromLine(&line);
-        if (line.compare(0, PLS_FILE.length(), PLS_FILE) == 0) {
-            std::string url = line.substr(line.find_first_of('=') + 1);
-            if (isURLAbsolute(url)) {
-                urlsParsed.push_back(url);
-            } else {
-                std::string absoluteURL;
-                if (getAbsoluteURLFromRelativePathToURL(playlistURL, url, &absoluteURL)) {
-                    urlsParsed.push_back(absoluteURL);
-                }
-            }
-        }
-    }
-    return urlsParsed;
-}
-
-void PlaylistParser::removeCarriageReturnFromLine(std::string* line) {
-    if (!line) {
-        return;
-    }
-    if (!line->empty() && (line->back() == '\r' || line->back() == '\n')) {
-        line->pop_back();
-    }
-}
-
-bool PlaylistParser::isURLAbsolute(const std::string& url) {
-    return url.find("://") != std::string::npos;
-}
-
-bool PlaylistParser::getAbsoluteURLFromRelativePathToURL(
-    std::string baseURL,
-    std::string relativePath,
-    std::string* absoluteURL) {
-    auto positionOfLastSlash = baseURL.find_last_of('/');
-    if (positionOfLastSlash == std::string::npos) {
-        return false;
-    } else {
-        if (!absoluteURL) {
-            return false;
-        }
-        baseURL.resize(positionOfLastSlash + 1);
-        *absoluteURL = baseURL + relativePath;
-        return true;
-    }
-}
-
-std::chrono::milliseconds PlaylistParser::parseRuntime(std::string line) {
-    // #EXTINF:1234.00, blah blah blah have you ever heard the tragedy of darth plagueis the wise?
-    auto runner = EXTINF.length();
-
-    // skip whitespace
-    while (runner < line.length() && std::isspace(line.at(runner))) {
-        ++runner;
-    }
-    if (runner == line.length()) {
-        return INVALID_DURATION;
-    }
-
-    // find colon
-    if (line.at(runner) != ':') {
-        return INVALID_DURATION;
-    }
-    ++runner;
-
-    // skip whitespace
-    while (runner < line.length() && std::isspace(line.at(runner))) {
-        ++runner;
-    }
-    if (runner == line.length()) {
-        return INVALID_DURATION;
-    }
-    // from here, we should be reading numbers or a '.' only, so the fractional part of the seconds
-    auto stringFromHereOnwards = line.substr(runner);
-    std::istringstream iss(stringFromHereOnwards);
-    int seconds;
-    char nextChar;
-    iss >> seconds;
-    if (!iss) {
-        return INVALID_DURATION;
-    }
-    if (seconds < 0) {
-        return INVALID_DURATION;
-    }
-    std::chrono::milliseconds duration = std::chrono::seconds(seconds);
-    iss >> nextChar;
-    if (!iss) {
-        return duration;
-    }
-    if (nextChar == '.') {
-        int digitsSoFar = 0;
-        unsigned int fractionalSeconds = 0;
-        // we only care about the first 3 (sig figs = millisecond limit)
-        while (digitsSoFar < 3) {
-            iss >> nextChar;
-            if (!iss) {
-                break;
-            }
-            if (!isdigit(nextChar)) {
-                break;
-            }
-            fractionalSeconds *= 10;
-            fractionalSeconds += (nextChar - '0');
-            ++digitsSoFar;
-        }
-        // if we read say "1", this is equivalent to 0.1 s or 100 ms
-        while (digitsSoFar < 3) {
-            fractionalSeconds *= 10;
-            ++digitsSoFar;
-        }
-        duration += std::chrono::milliseconds(fractionalSeconds);
-    }
-    do {
-        if (isdigit(nextChar)) {
-            continue;
-        } else {
-            if (nextChar == ',') {
-                break;
-            } else {
-                return INVALID_DURATION;
-            }
-        }
-    } while (iss >> nextChar);
-    return duration;
-}
-
-bool PlaylistParser::isM3UPlaylistM3U8(const std::string& playlistContent) {
-    std::istringstream iss(playlistContent);
-    std::string line;
-    if (std::getline(iss, line)) {
-        /*
-         * This isn't the best way of determining whether a playlist is M3U8 or M3U. However, there isn't really a
-         * better way that I could come up with. The playlist header I'm searching for is "EXTM3U" which indicates that
-         * this playlist is an "Extended M3U" playlist as opposed to a plain M3U playlist. In my testing, I've found
-         * that all M3U8 playlists are also extended M3U playlists, but this might not be guaranteed.
-         */
-        if (line.compare(0, M3U8_PLAYLIST_HEADER.length(), M3U8_PLAYLIST_HEADER) == 0) {
-            return true;
-        } else {
-            return false;
-        }
-    } else {
-        return false;
-    }
+bool PlaylistParser::waitUntil(std::chrono::steady_clock::time_point time) {
+    std::unique_lock<std::mutex> lock{m_mutex};
+    return !m_wakeTrigger.wait_until(lock, time, [this]() { return m_shuttingDown.load(); });
 }
 
 void PlaylistParser::doShutdown() {
-    m_shuttingDown = true;
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_shuttingDown = true;
+    }
+    m_wakeTrigger.notify_all();
     m_executor.shutdown();
 }
 
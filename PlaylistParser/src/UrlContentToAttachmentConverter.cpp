@@ -33,16 +33,36 @@ static const std::string TAG("UrlContentToAttachmentConverter");
 static const std::chrono::milliseconds UNVALID_DURATION =
     avsCommon::utils::playlistParser::PlaylistParserObserverInterface::INVALID_DURATION;
 
+const size_t UrlContentToAttachmentConverter::DEFAULT_MAX_PREFETCH_SEGMENTS = 3;
+
+/// How long each wait for content lasts before checking whether a shutdown has begun.
+static const std::chrono::milliseconds WAIT_TIMEOUT = std::chrono::milliseconds(100);
+
+/**
+ * The shortest wait for content counted as an underrun.  Shorter waits happen between the chunks of a download in
+ * progress and are covered by the data already in the internal stream.
+ */
+static const std::chrono::milliseconds MIN_UNDERRUN_DURATION = std::chrono::milliseconds(10);
+
+/// The size of the chunks copied from the content of each URL into the internal stream.
+static const size_t CHUNK_SIZE = 4096;
+
 std::shared_ptr<UrlContentToAttachmentConverter> UrlContentToAttachmentConverter::create(
     std::shared_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface> contentFetcherFactory,
     const std::string& url,
     std::shared_ptr<ErrorObserverInterface> observer,
-    std::chrono::milliseconds startTime) {
+    std::chrono::milliseconds startTime,
+    size_t maxPrefetchSegments,
+    bool cacheSingleFile) {
     if (!contentFetcherFactory) {
         return nullptr;
     }
-    auto thisSharedPointer = std::shared_ptr<UrlContentToAttachmentConverter>(
-        new UrlContentToAttachmentConverter(contentFetcherFactory, url, observer, startTime));
+    if (0 == maxPrefetchSegments) {
+        ACSDK_ERROR(LX("createFailed").d("reason", "zeroMaxPrefetchSegments"));
+        return nullptr;
+    }
+    auto thisSharedPointer = std::shared_ptr<UrlContentToAttachmentConverter>(new UrlContentToAttachmentConverter(
+        contentFetcherFactory, url, observer, startTime, maxPrefetchSegments, cacheSingleFile));
     auto retVal = thisSharedPointer->m_playlistParser->parsePlaylist(url, thisSharedPointer);
     if (0 == retVal) {
         thisSharedPointer->shutdown();
@@ -59,15 +79,23 @@ UrlContentToAttachmentConverter::UrlContentToAttachmentConverter(
     std::shared_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface> contentFetcherFactory,
     const std::string& url,
     std::shared_ptr<ErrorObserverInterface> observer,
-    std::chrono::milliseconds startTime) :
+    std::chrono::milliseconds startTime,
+    size_t maxPrefetchSegments,
+    bool cacheSingleFile) :
         RequiresShutdown{"UrlContentToAttachmentConverter"},
         m_desiredStreamPoint{startTime},
         m_contentFetcherFactory{contentFetcherFactory},
+        m_cacheableUrl{cacheSingleFile ? url : ""},
         m_observer{observer},
         m_shuttingDown{false},
+        m_maxPrefetchSegments{maxPrefetchSegments},
+        m_numActiveFetches{0},
+        m_underrunCount{0},
+        m_underrunMilliseconds{0},
         m_runningTotal{0},
         m_startedStreaming{false},
-        m_streamWriterClosed{false} {
+        m_streamWriterClosed{false},
+        m_streamedContent{false} {
     m_playlistParser = PlaylistParser::create(m_contentFetcherFactory);
     m_startStreamingPointFuture = m_startStreamingPointPromise.get_future();
     m_stream = std::make_shared<avsCommon::avs::attachment::InProcessAttachment>(url);
@@ -82,6 +110,14 @@ std::chrono::milliseconds UrlContentToAttachmentConverter::getDesiredStreamingPo
     return m_desiredStreamPoint;
 }
 
+size_t UrlContentToAttachmentConverter::getUnderrunCount() const {
+    return m_underrunCount;
+}
+
+std::chrono::milliseconds UrlContentToAttachmentConverter::getUnderrunDuration() const {
+    return std::chrono::milliseconds(m_underrunMilliseconds);
+}
+
 void UrlContentToAttachmentConverter::onPlaylistEntryParsed(
     int requestId,
     std::string url,
@@ -121,8 +157,9 @@ void UrlContentToAttachmentConverter::onPlaylistEntryParsed(
             });
             break;
         case avsCommon::utils::playlistParser::PlaylistParseResult::SUCCESS:
-            m_executor.submit([this, url]() {
-                if (!m_streamWriterClosed && !writeUrlContentIntoStream(url)) {
+            queueSegment(url);
+            m_executor.submit([this]() {
+                if (!m_streamWriterClosed && !writeNextSegmentIntoStream()) {
                     ACSDK_ERROR(LX("writeUrlContentToStreamFailed"));
                     std::unique_lock<std::mutex> lock{m_mutex};
                     auto observer = m_observer;
@@ -137,8 +174,9 @@ void UrlContentToAttachmentConverter::onPlaylistEntryParsed(
             });
             break;
         case avsCommon::utils::playlistParser::PlaylistParseResult::STILL_ONGOING:
-            m_executor.submit([this, url]() {
-                if (!m_streamWriterClosed && !writeUrlContentIntoStream(url)) {
+            queueSegment(url);
+            m_executor.submit([this]() {
+                if (!m_streamWriterClosed && !writeNextSegmentIntoStream()) {
                     ACSDK_ERROR(LX("writeUrlContentToStreamFailed").d("info", "closingWriter"));
                     m_streamWriter->close();
                     m_streamWriterClosed = true;
@@ -156,25 +194,153 @@ void UrlContentToAttachmentConverter::onPlaylistEntryParsed(
     }
 }
 
-bool UrlContentToAttachmentConverter::writeUrlContentIntoStream(std::string url) {
-    ACSDK_DEBUG9(LX("writeUrlContentIntoStream").d("info", "beginning"));
+void UrlContentToAttachmentConverter::queueSegment(const std::string& url) {
+    auto segment = std::make_shared<Segment>();
+    segment->url = url;
+    std::lock_guard<std::mutex> lock{m_segmentsMutex};
+    m_segments.push_back(segment);
+    startFetchesLocked();
+}
+
+void UrlContentToAttachmentConverter::startFetchesLocked() {
+    for (auto& segment : m_segments) {
+        if (m_numActiveFetches >= m_maxPrefetchSegments || m_shuttingDown) {
+            return;
+        }
+        if (segment->fetchStarted) {
+            continue;
+        }
+        ACSDK_DEBUG9(LX("startFetch").d("numActiveFetches", m_numActiveFetches).sensitive("url", segment->url));
+        /*
+         * Each URL is downloaded into the attachment of its own fetcher, so downloads can run ahead of the internal
+         * stream without their data being interleaved in it.  Only the URL itself, when it turns out not to be a
+         * playlist, may be cached, as playlist entries are usually segments of a live stream which are played once.
+         */
+        segment->fetcher = segment->url == m_cacheableUrl
+                               ? m_contentFetcherFactory->createForReusableContent(segment->url)
+                               : m_contentFetcherFactory->create(segment->url);
+        if (segment->fetcher) {
+            segment->content = segment->fetcher->getContent(
+                avsCommon::sdkInterfaces::HTTPContentFetcherInterface::FetchOptions::ENTIRE_BODY, nullptr);
+        }
+        segment->fetchStarted = true;
+        ++m_numActiveFetches;
+    }
+}
+
+bool UrlContentToAttachmentConverter::writeNextSegmentIntoStream() {
+    std::shared_ptr<Segment> segment;
+    {
+        std::lock_guard<std::mutex> lock{m_segmentsMutex};
+        if (m_segments.empty() || !m_segments.front()->fetchStarted) {
+            ACSDK_ERROR(LX("writeNextSegmentIntoStreamFailed").d("reason", "noStartedSegment"));
+            return false;
+        }
+        segment = m_segments.front();
+        m_segments.pop_front();
+    }
+    auto result = writeSegmentIntoStream(segment.get());
+    // Stop the download if it was abandoned part way, before its place is given to the next URL.
+    segment->fetcher.reset();
+    std::lock_guard<std::mutex> lock{m_segmentsMutex};
+    --m_numActiveFetches;
+    startFetchesLocked();
+    return result;
+}
+
+bool UrlContentToAttachmentConverter::writeSegmentIntoStream(Segment* segment) {
+    ACSDK_DEBUG9(LX("writeSegmentIntoStream").d("info", "beginning"));
 
-    auto contentFetcher = m_contentFetcherFactory->create(url);
-    auto httpContent = contentFetcher->getContent(
-        avsCommon::sdkInterfaces::HTTPContentFetcherInterface::FetchOptions::ENTIRE_BODY, m_streamWriter);
+    auto& httpContent = segment->content;
     if (!httpContent) {
         ACSDK_ERROR(LX("getContentFailed").d("reason", "nullHTTPContentReceived"));
         return false;
     }
+    if (httpContent->statusCode.wait_for(std::chrono::milliseconds::zero()) != std::future_status::ready &&
+        !waitForContent([&httpContent](std::chrono::milliseconds timeout) {
+            return httpContent->statusCode.wait_for(timeout) == std::future_status::ready;
+        })) {
+        return false;
+    }
     if (!(*httpContent)) {
         ACSDK_ERROR(LX("getContentFailed").d("reason", "badHTTPContentReceived"));
         return false;
     }
-    if (m_shuttingDown) {
+    if (!httpContent->dataStream) {
+        ACSDK_ERROR(LX("getContentFailed").d("reason", "nullDataStream"));
+        return false;
+    }
+    auto reader = httpContent->dataStream->createReader(avsCommon::utils::sds::ReaderPolicy::NONBLOCKING);
+    if (!reader) {
+        ACSDK_ERROR(LX("writeSegmentIntoStreamFailed").d("reason", "failedToCreateReader"));
         return false;
     }
-    ACSDK_DEBUG9(LX("writeUrlContentIntoStreamSuccess"));
-    return true;
+
+    char buffer[CHUNK_SIZE];
+    while (true) {
+        auto readStatus = avsCommon::avs::attachment::AttachmentReader::ReadStatus::OK;
+        auto numRead = reader->read(buffer, sizeof(buffer), &readStatus);
+        switch (readStatus) {
+            case avsCommon::avs::attachment::AttachmentReader::ReadStatus::OK:
+                break;
+            case avsCommon::avs::attachment::AttachmentReader::ReadStatus::OK_WOULDBLOCK:
+            case avsCommon::avs::attachment::AttachmentReader::ReadStatus::OK_TIMEDOUT:
+                if (!waitForContent([&reader](std::chrono::milliseconds timeout) {
+                        return reader->waitForData(timeout) !=
+                               avsCommon::avs::attachment::AttachmentReader::WaitStatus::TIMEDOUT;
+                    })) {
+                    return false;
+                }
+                continue;
+            case avsCommon::avs::attachment::AttachmentReader::ReadStatus::CLOSED:
+                ACSDK_DEBUG9(LX("writeSegmentIntoStreamSuccess"));
+                return true;
+            case avsCommon::avs::attachment::AttachmentReader::ReadStatus::ERROR_OVERRUN:
+            case avsCommon::avs::attachment::AttachmentReader::ReadStatus::ERROR_BYTES_LESS_THAN_WORD_SIZE:
+            case avsCommon::avs::attachment::AttachmentReader::ReadStatus::ERROR_INTERNAL:
+                ACSDK_ERROR(LX("writeSegmentIntoStreamFailed").d("reason", "readFailed"));
+                return false;
+        }
+
+        m_streamedContent = true;
+        size_t totalWritten = 0;
+        while (totalWritten < numRead) {
+            auto writeStatus = avsCommon::avs::attachment::AttachmentWriter::WriteStatus::OK;
+            totalWritten +=
+                m_streamWriter->write(buffer + totalWritten, numRead - totalWritten, &writeStatus, WAIT_TIMEOUT);
+            switch (writeStatus) {
+                case avsCommon::avs::attachment::AttachmentWriter::WriteStatus::OK:
+                    continue;
+                case avsCommon::avs::attachment::AttachmentWriter::WriteStatus::OK_BUFFER_FULL:
+                case avsCommon::avs::attachment::AttachmentWriter::WriteStatus::TIMEDOUT:
+                    // The reader of the internal stream is behind, which is not an underrun.
+                    if (m_shuttingDown) {
+                        return false;
+                    }
+                    continue;
+                case avsCommon::avs::attachment::AttachmentWriter::WriteStatus::CLOSED:
+                case avsCommon::avs::attachment::AttachmentWriter::WriteStatus::ERROR_BYTES_LESS_THAN_WORD_SIZE:
+                case avsCommon::avs::attachment::AttachmentWriter::WriteStatus::ERROR_INTERNAL:
+                    ACSDK_ERROR(LX("writeSegmentIntoStreamFailed").d("reason", "writeFailed"));
+                    return false;
+            }
+        }
+    }
+}
+
+bool UrlContentToAttachmentConverter::waitForContent(std::function<bool(std::chrono::milliseconds)> isReady) {
+    auto start = std::chrono::steady_clock::now();
+    bool ready = false;
+    while (!m_shuttingDown && !(ready = isReady(WAIT_TIMEOUT))) {
+    }
+    // Waiting for the first content is buffering, not an underrun.
+    auto stalled = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    if (m_streamedContent && stalled >= MIN_UNDERRUN_DURATION) {
+        ++m_underrunCount;
+        m_underrunMilliseconds += stalled.count();
+        ACSDK_DEBUG5(LX("underrun").d("durationMs", stalled.count()).d("underrunCount", m_underrunCount));
+    }
+    return ready;
 }
 
 void UrlContentToAttachmentConverter::doShutdown() {
@@ -188,6 +354,10 @@ void UrlContentToAttachmentConverter::doShutdown() {
     m_executor.shutdown();
     m_playlistParser->shutdown();
     m_playlistParser.reset();
+    {
+        std::lock_guard<std::mutex> lock{m_segmentsMutex};
+        m_segments.clear();
+    }
     m_streamWriter.reset();
     if (!m_startedStreaming) {
         m_startStreamingPointPromise.set_value(std::chrono::seconds::zero());
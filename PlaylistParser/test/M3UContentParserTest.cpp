@@ -0,0 +1,174 @@
+/*
+ * Copyright 2017-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <AVSCommon/Utils/PlaylistParser/PlaylistParserObserverInterface.h>
+
+#include "PlaylistParser/M3UContentParser.h"
+#include "PlaylistParser/PLSContentParser.h"
+
+namespace alexaClientSDK {
+namespace playlistParser {
+namespace test {
+
+using namespace avsCommon::utils::playlistParser;
+
+/// The duration of entries without a valid @c #EXTINF tag.
+static constexpr std::chrono::milliseconds INVALID_DURATION = PlaylistParserObserverInterface::INVALID_DURATION;
+
+/// The URL of the playlists parsed.
+static const std::string PLAYLIST_URL = "http://test.com/live/playlist.m3u8";
+
+/// A live HLS media playlist with Windows style line breaks and a relative URL.
+static const std::string HLS_PLAYLIST =
+    "#EXTM3U\r\n"
+    "#EXT-X-TARGETDURATION:10\r\n"
+    "#EXT-X-MEDIA-SEQUENCE:2680\r\n"
+    "\r\n"
+    "#EXTINF:7.975,\r\n"
+    "https://priv.example.com/fileSequence2680.ts\r\n"
+    "#EXTINF:7.941,\r\n"
+    "fileSequence2681.ts\r\n"
+    "   # a comment\r\n"
+    "https://priv.example.com/fileSequence2682.ts";
+
+/// The entries in @c HLS_PLAYLIST.
+static const std::vector<std::pair<std::string, std::chrono::milliseconds>> HLS_PLAYLIST_ENTRIES = {
+    {"https://priv.example.com/fileSequence2680.ts", std::chrono::milliseconds(7975)},
+    {"http://test.com/live/fileSequence2681.ts", std::chrono::milliseconds(7941)},
+    {"https://priv.example.com/fileSequence2682.ts", INVALID_DURATION}};
+
+/// The media sequence numbers of the entries in @c HLS_PLAYLIST.
+static const std::vector<uint64_t> HLS_PLAYLIST_SEQUENCE_NUMBERS = {2680, 2681, 2682};
+
+/// A PLS playlist with a relative URL.
+static const std::string PLS_PLAYLIST =
+    "[playlist]\n"
+    "NumberOfEntries=2\n"
+    "File1=http://stream.radio.com:8000/live\n"
+    "Title1=Radio\n"
+    "File2=backup/live\n";
+
+/**
+ * Parse a playlist fed in chunks of a given size.
+ *
+ * @param content The playlist.
+ * @param chunkSize The size of each chunk.
+ * @param [out] parser The parser to feed.
+ */
+static void feedInChunks(const std::string& content, size_t chunkSize, PlaylistLineParser* parser) {
+    for (size_t offset = 0; offset < content.size(); offset += chunkSize) {
+        parser->feed(content.data() + offset, std::min(chunkSize, content.size() - offset));
+    }
+    parser->finish();
+}
+
+/**
+ * Verify that an HLS playlist yields the same entries and tags however its content is split up.
+ */
+TEST(M3UContentParserTest, testParsingInChunksOfEverySize) {
+    for (size_t chunkSize = 1; chunkSize <= HLS_PLAYLIST.size(); ++chunkSize) {
+        std::vector<std::pair<std::string, std::chrono::milliseconds>> entries;
+        std::vector<uint64_t> sequenceNumbers;
+        M3UContentParser parser(
+            PLAYLIST_URL,
+            [&entries, &sequenceNumbers](
+                const std::string& url, std::chrono::milliseconds duration, uint64_t sequenceNumber) {
+                entries.push_back({url, duration});
+                sequenceNumbers.push_back(sequenceNumber);
+            });
+        feedInChunks(HLS_PLAYLIST, chunkSize, &parser);
+        ASSERT_EQ(HLS_PLAYLIST_ENTRIES, entries) << "chunkSize=" << chunkSize;
+        ASSERT_EQ(HLS_PLAYLIST_SEQUENCE_NUMBERS, sequenceNumbers) << "chunkSize=" << chunkSize;
+        ASSERT_TRUE(parser.isExtendedM3U());
+        ASSERT_TRUE(parser.hasMediaSequence());
+        ASSERT_EQ(std::chrono::milliseconds(10000), parser.getTargetDuration());
+        ASSERT_FALSE(parser.isStreamInfTagPresent());
+        ASSERT_FALSE(parser.isEndlistTagPresent());
+    }
+}
+
+/**
+ * Verify that the tags of a master playlist and a finished playlist are detected, and that a plain M3U playlist is
+ * not taken for M3U8.
+ */
+TEST(M3UContentParserTest, testTags) {
+    M3UContentParser master(PLAYLIST_URL, nullptr);
+    feedInChunks("#EXTM3U\n#EXT-X-STREAM-INF:BANDWIDTH=1280000\nlow.m3u8\n", 7, &master);
+    EXPECT_TRUE(master.isExtendedM3U());
+    EXPECT_TRUE(master.isStreamInfTagPresent());
+    EXPECT_FALSE(master.isEndlistTagPresent());
+
+    M3UContentParser finished(PLAYLIST_URL, nullptr);
+    feedInChunks("#EXTM3U\n#EXTINF:10,\na.ts\n#EXT-X-ENDLIST\n", 5, &finished);
+    EXPECT_TRUE(finished.isEndlistTagPresent());
+
+    std::vector<uint64_t> sequenceNumbers;
+    M3UContentParser plain(
+        PLAYLIST_URL,
+        [&sequenceNumbers](const std::string& url, std::chrono::milliseconds duration, uint64_t sequenceNumber) {
+            sequenceNumbers.push_back(sequenceNumber);
+        });
+    feedInChunks("http://a.com/1.mp3\nhttp://a.com/2.mp3\n", 3, &plain);
+    EXPECT_FALSE(plain.isExtendedM3U());
+    EXPECT_FALSE(plain.hasMediaSequence());
+    EXPECT_EQ(INVALID_DURATION, plain.getTargetDuration());
+    EXPECT_EQ(std::vector<uint64_t>({0, 1}), sequenceNumbers);
+}
+
+/**
+ * Verify the durations parsed from @c #EXTINF lines.
+ */
+TEST(M3UContentParserTest, testParseRuntime) {
+    const std::vector<std::pair<std::string, std::chrono::milliseconds>> cases = {
+        {"#EXTINF:10,", std::chrono::milliseconds(10000)},
+        {"#EXTINF: 10.5, Title", std::chrono::milliseconds(10500)},
+        {"#EXTINF:1.23456,", std::chrono::milliseconds(1234)},
+        {"#EXTINF:-1,", INVALID_DURATION},
+        {"#EXTINF:abc,", INVALID_DURATION},
+        {"#EXTINF10,", INVALID_DURATION},
+        {"#EXTINF:99999999999,", INVALID_DURATION},
+        {"#EXTINF:", INVALID_DURATION}};
+    for (const auto& testCase : cases) {
+        EXPECT_EQ(
+            testCase.second, M3UContentParser::parseRuntime(testCase.first.data(), testCase.first.size()))
+            << testCase.first;
+    }
+}
+
+/**
+ * Verify that a PLS playlist yields its URLs however its content is split up.
+ */
+TEST(PLSContentParserTest, testParsingInChunksOfEverySize) {
+    const std::vector<std::string> expected = {"http://stream.radio.com:8000/live",
+                                               "http://test.com/live/backup/live"};
+    for (size_t chunkSize = 1; chunkSize <= PLS_PLAYLIST.size(); ++chunkSize) {
+        std::vector<std::string> urls;
+        PLSContentParser parser(PLAYLIST_URL, [&urls](const std::string& url) { urls.push_back(url); });
+        feedInChunks(PLS_PLAYLIST, chunkSize, &parser);
+        ASSERT_EQ(expected, urls) << "chunkSize=" << chunkSize;
+    }
+}
+
+}  // namespace test
+}  // namespace playlistParser
+}  // namespace alexaClientSDK
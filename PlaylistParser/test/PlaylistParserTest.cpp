@@ -13,6 +13,7 @@
  * permissions and limitations under the License.
  */
 
+#include <algorithm>
 #include <memory>
 #include <chrono>
 #include <mutex>
@@ -187,7 +188,7 @@ static const std::string TEST_HLS_LIVE_STREAM_PLAYLIST_URL{"http://sanjayistheco
 
 static const std::string TEST_HLS_LIVE_STREAM_PLAYLIST_CONTENT_1 =
     "#EXTM3U\n"
-    "#EXT-X-TARGETDURATION:10\n"
+    "#EXT-X-TARGETDURATION:1\n"
     "#EXT-X-MEDIA-SEQUENCE:9684358\n"
     "#EXTINF:10,RADIO\n"
     "http://76.74.255.139/bismarck/live/bismarck.mov_9684358.aac\n"
@@ -223,8 +224,82 @@ static const std::vector<std::chrono::milliseconds> TEST_HLS_LIVE_STREAM_DURATIO
                                                                                       std::chrono::milliseconds{10000},
                                                                                       std::chrono::milliseconds{10000}};
 
+/// A live HLS playlist which is reloaded twice, the first time without any new segments.
+static const std::string TEST_HLS_LIVE_REFRESH_PLAYLIST_URL{"http://sanjayisthecoolest.com/liveRefresh.m3u8"};
+
+static const std::vector<std::string> TEST_HLS_LIVE_REFRESH_PLAYLIST_CONTENTS = {
+    "#EXTM3U\n"
+    "#EXT-X-TARGETDURATION:1\n"
+    "#EXT-X-MEDIA-SEQUENCE:100\n"
+    "#EXTINF:1,\n"
+    "segment100.aac\n"
+    "#EXTINF:1,\n"
+    "segment101.aac\n",
+    "#EXTM3U\n"
+    "#EXT-X-TARGETDURATION:1\n"
+    "#EXT-X-MEDIA-SEQUENCE:100\n"
+    "#EXTINF:1,\n"
+    "segment100.aac\n"
+    "#EXTINF:1,\n"
+    "segment101.aac\n",
+    "#EXTM3U\n"
+    "#EXT-X-TARGETDURATION:1\n"
+    "#EXT-X-MEDIA-SEQUENCE:101\n"
+    "#EXTINF:1,\n"
+    "segment101.aac\n"
+    "#EXTINF:1,\n"
+    "segment102.aac\n"
+    "#EXTINF:1,\n"
+    "segment103.aac\n"
+    "#EXT-X-ENDLIST\n"};
+
+static const std::vector<std::string> TEST_HLS_LIVE_REFRESH_PLAYLIST_URLS = {
+    "http://sanjayisthecoolest.com/segment100.aac",
+    "http://sanjayisthecoolest.com/segment101.aac",
+    "http://sanjayisthecoolest.com/segment102.aac",
+    "http://sanjayisthecoolest.com/segment103.aac"};
+
+/**
+ * The least time @c TEST_HLS_LIVE_REFRESH_PLAYLIST_URL takes to parse: one target duration before the first reload,
+ * then half a target duration before the second because the first reload had no new segments.
+ */
+static const auto TEST_HLS_LIVE_REFRESH_PLAYLIST_MIN_DURATION = std::chrono::milliseconds(1500);
+
+/// A live HLS playlist which never ends.
+static const std::string TEST_HLS_ENDLESS_PLAYLIST_URL{"http://sanjayisthecoolest.com/endless.m3u8"};
+
+static const std::string TEST_HLS_ENDLESS_PLAYLIST_CONTENT =
+    "#EXTM3U\n"
+    "#EXT-X-TARGETDURATION:10\n"
+    "#EXT-X-MEDIA-SEQUENCE:1\n"
+    "#EXTINF:10,\n"
+    "http://sanjay.com/chunk.mp3\n";
+
 static const size_t NUM_PARSES_EXPECTED_WHEN_NO_PARSING = 1;
 
+/// A test M3U playlist whose entries are all fetched to find their content types.
+static const std::string TEST_CONCURRENT_PLAYLIST_URL{"http://sanjayisthecoolest.com/concurrent.m3u"};
+
+static const std::string TEST_CONCURRENT_PLAYLIST_CONTENT =
+    "http://stream.radiotime.com/sample.mp3\n"
+    "http://live-mp3-128.kexp.org\n"
+    "http://sanjay.com/chunk.mp3\n"
+    "http://sanjay.com/anotherChunk.mp3\n";
+
+static const std::vector<std::string> TEST_CONCURRENT_PLAYLIST_URLS = {"http://stream.radiotime.com/sample.mp3",
+                                                                       "http://live-mp3-128.kexp.org",
+                                                                       "http://sanjay.com/chunk.mp3",
+                                                                       "http://sanjay.com/anotherChunk.mp3"};
+
+/// The number of requests made for @c TEST_CONCURRENT_PLAYLIST_URL: content type and body, then one per entry.
+static const size_t TEST_CONCURRENT_PLAYLIST_EXPECTED_FETCHES = 2 + TEST_CONCURRENT_PLAYLIST_URLS.size();
+
+/// How long each request made through a @c DelayedContentFetcher takes.
+static const auto FETCH_DELAY = std::chrono::milliseconds(100);
+
+/// Long time out for when callbacks are expected to be delayed by @c FETCH_DELAY.
+static const auto LONG_TIMEOUT = std::chrono::seconds(5);
+
 static const std::unordered_map<std::string, std::string> urlsToContentTypes{
     // Valid playlist content types
     {TEST_M3U_PLAYLIST_URL, "audio/mpegurl"},
@@ -233,6 +308,9 @@ static const std::unordered_map<std::string, std::string> urlsToContentTypes{
     {TEST_PLS_PLAYLIST_URL, "audio/x-scpls"},
     {TEST_HLS_RECURSIVE_PLAYLIST_URL, "audio/mpegurl"},
     {TEST_HLS_LIVE_STREAM_PLAYLIST_URL, "audio/mpegurl"},
+    {TEST_HLS_LIVE_REFRESH_PLAYLIST_URL, "application/vnd.apple.mpegurl"},
+    {TEST_HLS_ENDLESS_PLAYLIST_URL, "application/vnd.apple.mpegurl"},
+    {TEST_CONCURRENT_PLAYLIST_URL, "audio/mpegurl"},
     // Not playlist content types
     {"http://stream.radiotime.com/sample.mp3", "audio/mpeg"},
     {"http://live-mp3-128.kexp.org", "audio/mpeg"},
@@ -252,7 +330,10 @@ static std::unordered_map<std::string, std::string> urlsToContent{
     {TEST_HLS_PLAYLIST_URL, TEST_HLS_PLAYLIST_CONTENT},
     {TEST_PLS_PLAYLIST_URL, TEST_PLS_CONTENT},
     {TEST_HLS_RECURSIVE_PLAYLIST_URL, TEST_HLS_RECURSIVE_PLAYLIST_CONTENT},
-    {TEST_HLS_LIVE_STREAM_PLAYLIST_URL, TEST_HLS_LIVE_STREAM_PLAYLIST_CONTENT_1}};
+    {TEST_HLS_LIVE_STREAM_PLAYLIST_URL, TEST_HLS_LIVE_STREAM_PLAYLIST_CONTENT_1},
+    {TEST_HLS_LIVE_REFRESH_PLAYLIST_URL, TEST_HLS_LIVE_REFRESH_PLAYLIST_CONTENTS.front()},
+    {TEST_HLS_ENDLESS_PLAYLIST_URL, TEST_HLS_ENDLESS_PLAYLIST_CONTENT},
+    {TEST_CONCURRENT_PLAYLIST_URL, TEST_CONCURRENT_PLAYLIST_CONTENT}};
 
 /// A mock content fetcher
 class MockContentFetcher : public avsCommon::sdkInterfaces::HTTPContentFetcherInterface {
@@ -291,6 +372,11 @@ public:
                         it2->second = TEST_HLS_LIVE_STREAM_PLAYLIST_CONTENT_2;
                     }
                 }
+                static size_t liveRefreshPlaylistRequests = 0;
+                if (m_url == TEST_HLS_LIVE_REFRESH_PLAYLIST_URL) {
+                    it2->second = TEST_HLS_LIVE_REFRESH_PLAYLIST_CONTENTS.at(
+                        std::min(liveRefreshPlaylistRequests++, TEST_HLS_LIVE_REFRESH_PLAYLIST_CONTENTS.size() - 1));
+                }
                 std::promise<long> statusPromise;
                 auto statusFuture = statusPromise.get_future();
                 statusPromise.set_value(200);
@@ -334,6 +420,130 @@ class MockContentFetcherFactory : public avsCommon::sdkInterfaces::HTTPContentFe
     }
 };
 
+/// Keeps track of how many requests are in progress at once.
+class FetchTracker {
+public:
+    FetchTracker() : m_numInFlight{0}, m_maxInFlight{0} {
+    }
+
+    /// Called when a request starts.
+    void onFetchStarted() {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_maxInFlight = std::max(m_maxInFlight, ++m_numInFlight);
+    }
+
+    /// Called when a request finishes.
+    void onFetchFinished() {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        --m_numInFlight;
+    }
+
+    /// @return The largest number of requests that were in progress at once.
+    size_t getMaxInFlight() {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        return m_maxInFlight;
+    }
+
+private:
+    /// A mutex to guard the counts.
+    std::mutex m_mutex;
+
+    /// The number of requests in progress.
+    size_t m_numInFlight;
+
+    /// The largest number of requests that were in progress at once.
+    size_t m_maxInFlight;
+};
+
+/// A content fetcher which answers like @c MockContentFetcher, but only after @c FETCH_DELAY.
+class DelayedContentFetcher : public avsCommon::sdkInterfaces::HTTPContentFetcherInterface {
+public:
+    DelayedContentFetcher(const std::string& url, std::shared_ptr<FetchTracker> tracker) :
+            m_fetcher{url},
+            m_tracker{tracker} {
+    }
+
+    ~DelayedContentFetcher() {
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+    }
+
+    std::unique_ptr<avsCommon::utils::HTTPContent> getContent(
+        FetchOptions fetchOption,
+        std::shared_ptr<avsCommon::avs::attachment::AttachmentWriter> writer) {
+        auto content = m_fetcher.getContent(fetchOption, writer);
+        if (!content) {
+            return nullptr;
+        }
+        m_tracker->onFetchStarted();
+        auto statusCode = content->statusCode.get();
+        auto contentType = content->contentType.get();
+        auto statusFuture = m_statusPromise.get_future();
+        auto contentTypeFuture = m_contentTypePromise.get_future();
+        m_thread = std::thread([this, statusCode, contentType]() {
+            std::this_thread::sleep_for(FETCH_DELAY);
+            m_tracker->onFetchFinished();
+            m_statusPromise.set_value(statusCode);
+            m_contentTypePromise.set_value(contentType);
+        });
+        return avsCommon::utils::memory::make_unique<avsCommon::utils::HTTPContent>(avsCommon::utils::HTTPContent{
+            std::move(statusFuture), std::move(contentTypeFuture), content->dataStream});
+    }
+
+private:
+    /// The fetcher which provides the responses.
+    MockContentFetcher m_fetcher;
+
+    /// The tracker to tell about requests.
+    std::shared_ptr<FetchTracker> m_tracker;
+
+    /// Promise for the delayed status code.
+    std::promise<long> m_statusPromise;
+
+    /// Promise for the delayed content type.
+    std::promise<std::string> m_contentTypePromise;
+
+    /// The thread which delays the response.
+    std::thread m_thread;
+};
+
+/// A mock factory that creates delayed content fetchers
+class DelayedContentFetcherFactory : public avsCommon::sdkInterfaces::HTTPContentFetcherInterfaceFactoryInterface {
+public:
+    DelayedContentFetcherFactory() : tracker{std::make_shared<FetchTracker>()} {
+    }
+
+    std::unique_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterface> create(const std::string& url) {
+        return avsCommon::utils::memory::make_unique<DelayedContentFetcher>(url, tracker);
+    }
+
+    /// The tracker shared by all the fetchers created.
+    std::shared_ptr<FetchTracker> tracker;
+};
+
+/// An observer which records the timing of each request.
+class TestFetchTimingObserver : public FetchTimingObserverInterface {
+public:
+    void onFetchCompleted(int requestId, const FetchTiming& timing) {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_timings.push_back(timing);
+    }
+
+    /// @return The timings recorded so far.
+    std::vector<FetchTiming> getTimings() {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        return m_timings;
+    }
+
+private:
+    /// A mutex to guard @c m_timings.
+    std::mutex m_mutex;
+
+    /// The timings recorded.
+    std::vector<FetchTiming> m_timings;
+};
+
 /**
  * Mock AttachmentReader.
  */
@@ -530,7 +740,7 @@ TEST_F(PlaylistParserTest, testNotParsingCertainPlaylistTypes) {
  */
 TEST_F(PlaylistParserTest, testParsingLiveStreamPlaylist) {
     ASSERT_TRUE(playlistParser->parsePlaylist(TEST_HLS_LIVE_STREAM_PLAYLIST_URL, testObserver));
-    auto results = testObserver->waitForNCallbacks(TEST_HLS_LIVE_STREAM_PLAYLIST_EXPECTED_PARSES);
+    auto results = testObserver->waitForNCallbacks(TEST_HLS_LIVE_STREAM_PLAYLIST_EXPECTED_PARSES, LONG_TIMEOUT);
     ASSERT_EQ(TEST_HLS_LIVE_STREAM_PLAYLIST_EXPECTED_PARSES, results.size());
     for (unsigned int i = 0; i < results.size(); ++i) {
         ASSERT_EQ(results.at(i).url, TEST_HLS_LIVE_STREAM_PLAYLIST_URLS.at(i));
@@ -543,6 +753,117 @@ TEST_F(PlaylistParserTest, testParsingLiveStreamPlaylist) {
     }
 }
 
+/**
+ * Tests that the entries of a playlist are fetched concurrently, that they are still reported in order, and that the
+ * timing of every request is reported.
+ */
+TEST_F(PlaylistParserTest, testFetchingEntriesConcurrently) {
+    auto delayedFactory = std::make_shared<DelayedContentFetcherFactory>();
+    auto timingObserver = std::make_shared<TestFetchTimingObserver>();
+    auto parser =
+        PlaylistParser::create(delayedFactory, PlaylistParser::DEFAULT_MAX_CONCURRENT_FETCHES, timingObserver);
+    ASSERT_TRUE(parser);
+    ASSERT_TRUE(parser->parsePlaylist(TEST_CONCURRENT_PLAYLIST_URL, testObserver));
+    auto results = testObserver->waitForNCallbacks(TEST_CONCURRENT_PLAYLIST_URLS.size(), LONG_TIMEOUT);
+    ASSERT_EQ(TEST_CONCURRENT_PLAYLIST_URLS.size(), results.size());
+    for (unsigned int i = 0; i < results.size(); ++i) {
+        ASSERT_EQ(results.at(i).url, TEST_CONCURRENT_PLAYLIST_URLS.at(i));
+        if (i == results.size() - 1) {
+            ASSERT_EQ(results.at(i).parseResult, avsCommon::utils::playlistParser::PlaylistParseResult::SUCCESS);
+        } else {
+            ASSERT_EQ(results.at(i).parseResult, avsCommon::utils::playlistParser::PlaylistParseResult::STILL_ONGOING);
+        }
+    }
+    parser->shutdown();
+
+    auto maxInFlight = delayedFactory->tracker->getMaxInFlight();
+    ASSERT_GT(maxInFlight, 1u);
+    ASSERT_LE(maxInFlight, PlaylistParser::DEFAULT_MAX_CONCURRENT_FETCHES);
+
+    auto timings = timingObserver->getTimings();
+    ASSERT_EQ(TEST_CONCURRENT_PLAYLIST_EXPECTED_FETCHES, timings.size());
+    ASSERT_EQ(TEST_CONCURRENT_PLAYLIST_URL, timings.at(0).url);
+    ASSERT_EQ(HTTPContentFetcherInterface::FetchOptions::CONTENT_TYPE, timings.at(0).fetchOption);
+    ASSERT_EQ(TEST_CONCURRENT_PLAYLIST_URL, timings.at(1).url);
+    ASSERT_EQ(HTTPContentFetcherInterface::FetchOptions::ENTIRE_BODY, timings.at(1).fetchOption);
+    for (const auto& timing : timings) {
+        ASSERT_GE(timing.elapsed, timing.waited);
+    }
+}
+
+/**
+ * Tests that no more than the configured number of requests are made at once.
+ */
+TEST_F(PlaylistParserTest, testMaxConcurrentFetchesIsRespected) {
+    auto delayedFactory = std::make_shared<DelayedContentFetcherFactory>();
+    auto parser = PlaylistParser::create(delayedFactory, 1);
+    ASSERT_TRUE(parser);
+    ASSERT_TRUE(parser->parsePlaylist(TEST_CONCURRENT_PLAYLIST_URL, testObserver));
+    auto results = testObserver->waitForNCallbacks(TEST_CONCURRENT_PLAYLIST_URLS.size(), LONG_TIMEOUT);
+    ASSERT_EQ(TEST_CONCURRENT_PLAYLIST_URLS.size(), results.size());
+    for (unsigned int i = 0; i < results.size(); ++i) {
+        ASSERT_EQ(results.at(i).url, TEST_CONCURRENT_PLAYLIST_URLS.at(i));
+    }
+    parser->shutdown();
+    ASSERT_EQ(1u, delayedFactory->tracker->getMaxInFlight());
+}
+
+/**
+ * Tests that reloads of a live playlist wait for its target duration, or half of it when nothing changed, that only
+ * the new segments are reported, and that the reloads do not request the content type again.
+ */
+TEST_F(PlaylistParserTest, testLivePlaylistRefreshReportsOnlyNewSegments) {
+    auto timingObserver = std::make_shared<TestFetchTimingObserver>();
+    auto parser =
+        PlaylistParser::create(mockFactory, PlaylistParser::DEFAULT_MAX_CONCURRENT_FETCHES, timingObserver);
+    ASSERT_TRUE(parser);
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(parser->parsePlaylist(TEST_HLS_LIVE_REFRESH_PLAYLIST_URL, testObserver));
+    auto results = testObserver->waitForNCallbacks(TEST_HLS_LIVE_REFRESH_PLAYLIST_URLS.size(), LONG_TIMEOUT);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    ASSERT_EQ(TEST_HLS_LIVE_REFRESH_PLAYLIST_URLS.size(), results.size());
+    for (unsigned int i = 0; i < results.size(); ++i) {
+        ASSERT_EQ(results.at(i).url, TEST_HLS_LIVE_REFRESH_PLAYLIST_URLS.at(i));
+        ASSERT_EQ(results.at(i).duration, std::chrono::milliseconds{1000});
+    }
+    ASSERT_EQ(results.back().parseResult, avsCommon::utils::playlistParser::PlaylistParseResult::SUCCESS);
+    ASSERT_GE(elapsed, TEST_HLS_LIVE_REFRESH_PLAYLIST_MIN_DURATION);
+    parser->shutdown();
+
+    size_t numContentTypeFetches = 0;
+    size_t numBodyFetches = 0;
+    for (const auto& timing : timingObserver->getTimings()) {
+        ASSERT_EQ(TEST_HLS_LIVE_REFRESH_PLAYLIST_URL, timing.url);
+        if (HTTPContentFetcherInterface::FetchOptions::CONTENT_TYPE == timing.fetchOption) {
+            ++numContentTypeFetches;
+        } else {
+            ++numBodyFetches;
+        }
+    }
+    ASSERT_EQ(1u, numContentTypeFetches);
+    ASSERT_EQ(TEST_HLS_LIVE_REFRESH_PLAYLIST_CONTENTS.size(), numBodyFetches);
+}
+
+/**
+ * Tests that shutting down does not wait for the next reload of a live playlist.
+ */
+TEST_F(PlaylistParserTest, testShutdownDuringLivePlaylistRefreshWait) {
+    auto parser = PlaylistParser::create(mockFactory);
+    ASSERT_TRUE(parser);
+    ASSERT_TRUE(parser->parsePlaylist(TEST_HLS_ENDLESS_PLAYLIST_URL, testObserver));
+    ASSERT_EQ(1u, testObserver->waitForNCallbacks(1, LONG_TIMEOUT).size());
+    auto start = std::chrono::steady_clock::now();
+    parser->shutdown();
+    ASSERT_LT(std::chrono::steady_clock::now() - start, LONG_TIMEOUT);
+}
+
+/**
+ * Tests that a parser cannot be created without allowing any requests.
+ */
+TEST_F(PlaylistParserTest, testCreateWithZeroMaxConcurrentFetches) {
+    ASSERT_FALSE(PlaylistParser::create(mockFactory, 0));
+}
+
 }  // namespace test
 }  // namespace playlistParser
 }  // namespace alexaClientSDK
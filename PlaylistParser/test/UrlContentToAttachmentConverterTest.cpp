@@ -0,0 +1,277 @@
+/*
+ * Copyright 2017-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <AVSCommon/Utils/LibcurlUtils/HTTPContentFetcherFactory.h>
+#include <AVSCommon/Utils/LibcurlUtils/LocalHttpServer.h>
+
+#include "PlaylistParser/UrlContentToAttachmentConverter.h"
+
+namespace alexaClientSDK {
+namespace playlistParser {
+namespace test {
+
+using namespace avsCommon::avs::attachment;
+using namespace avsCommon::utils::libcurlUtils;
+using namespace avsCommon::utils::libcurlUtils::test;
+
+/// Used to limit the amount of time tests will wait for content.  This is only hit if a test is failing.
+static const auto TIMEOUT = std::chrono::seconds(10);
+
+/// The round trip time simulated by the server.
+static const auto RESPONSE_DELAY = std::chrono::milliseconds(200);
+
+/// The number of segments in the test playlist.
+static const size_t NUM_SEGMENTS = 5;
+
+/// The size of each test segment.
+static const size_t SEGMENT_SIZE = 20000;
+
+/// The content type of the test playlist.
+static const std::string HLS_CONTENT_TYPE = "application/vnd.apple.mpegurl";
+
+/// The content type of the test segments.
+static const std::string SEGMENT_CONTENT_TYPE = "audio/aac";
+
+/// The result of streaming the test playlist.
+struct StreamResult {
+    /// The content of the attachment.
+    std::string content;
+
+    /// The time from the first byte of the attachment to its end.
+    std::chrono::milliseconds timeAfterFirstByte{0};
+
+    /// The number of underruns the converter recorded.
+    size_t underrunCount = 0;
+
+    /// The time the converter recorded in underruns.
+    std::chrono::milliseconds underrunDuration{0};
+};
+
+/// A fetcher factory which records the URLs fetched as reusable content.
+class RecordingContentFetcherFactory : public HTTPContentFetcherFactory {
+public:
+    std::unique_ptr<avsCommon::sdkInterfaces::HTTPContentFetcherInterface> createForReusableContent(
+        const std::string& url) override {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_reusableUrls.push_back(url);
+        }
+        return HTTPContentFetcherFactory::createForReusableContent(url);
+    }
+
+    /// @return The URLs passed to @c createForReusableContent() so far.
+    std::vector<std::string> getReusableUrls() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_reusableUrls;
+    }
+
+private:
+    /// Serializes access to @c m_reusableUrls.
+    std::mutex m_mutex;
+
+    /// The URLs passed to @c createForReusableContent().
+    std::vector<std::string> m_reusableUrls;
+};
+
+/**
+ * Read the attachment of a converter to its end.
+ *
+ * @param converter The converter.
+ * @return The content of the attachment.
+ */
+static std::string readToEnd(std::shared_ptr<UrlContentToAttachmentConverter> converter) {
+    std::string content;
+    auto reader = converter->getAttachment()->createReader(avsCommon::utils::sds::ReaderPolicy::BLOCKING);
+    if (!reader) {
+        return content;
+    }
+    std::vector<char> buffer(4096);
+    auto status = AttachmentReader::ReadStatus::OK;
+    while (status != AttachmentReader::ReadStatus::CLOSED && status != AttachmentReader::ReadStatus::OK_TIMEDOUT) {
+        auto bytesRead = reader->read(buffer.data(), buffer.size(), &status, TIMEOUT);
+        content.append(buffer.data(), bytesRead);
+    }
+    return content;
+}
+
+/// Test harness for the @c UrlContentToAttachmentConverter class, streaming from a local server.
+class UrlContentToAttachmentConverterTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_TRUE(m_server.start());
+        std::string playlist = "#EXTM3U\n#EXT-X-TARGETDURATION:10\n#EXT-X-MEDIA-SEQUENCE:0\n";
+        for (size_t i = 0; i < NUM_SEGMENTS; ++i) {
+            std::string segment;
+            for (size_t j = 0; j < SEGMENT_SIZE; ++j) {
+                segment.push_back(static_cast<char>('a' + (i + j) % 26));
+            }
+            m_expectedContent += segment;
+            auto url = m_server.addBody("/segment" + std::to_string(i) + ".aac", segment, SEGMENT_CONTENT_TYPE);
+            if (0 == i) {
+                m_firstSegmentUrl = url;
+                m_firstSegmentContent = segment;
+            }
+            playlist += "#EXTINF:10.0,\nsegment" + std::to_string(i) + ".aac\n";
+        }
+        playlist += "#EXT-X-ENDLIST\n";
+        m_playlistUrl = m_server.addBody("/playlist.m3u8", playlist, HLS_CONTENT_TYPE);
+        m_server.setResponseDelay(RESPONSE_DELAY);
+    }
+
+    /**
+     * Stream the test playlist through a converter and read its attachment to the end.
+     *
+     * @param maxPrefetchSegments The maximum number of segments the converter fetches at once.
+     * @param [out] result The result.
+     */
+    void stream(size_t maxPrefetchSegments, StreamResult* result) {
+        auto converter = UrlContentToAttachmentConverter::create(
+            std::make_shared<HTTPContentFetcherFactory>(),
+            m_playlistUrl,
+            nullptr,
+            std::chrono::milliseconds::zero(),
+            maxPrefetchSegments);
+        ASSERT_TRUE(converter);
+        auto reader = converter->getAttachment()->createReader(avsCommon::utils::sds::ReaderPolicy::BLOCKING);
+        ASSERT_TRUE(reader);
+
+        std::vector<char> buffer(4096);
+        auto status = AttachmentReader::ReadStatus::OK;
+        std::chrono::steady_clock::time_point firstByte;
+        while (status != AttachmentReader::ReadStatus::CLOSED) {
+            auto bytesRead = reader->read(buffer.data(), buffer.size(), &status, TIMEOUT);
+            ASSERT_NE(AttachmentReader::ReadStatus::OK_TIMEDOUT, status);
+            if (bytesRead > 0 && result->content.empty()) {
+                firstByte = std::chrono::steady_clock::now();
+            }
+            result->content.append(buffer.data(), bytesRead);
+        }
+        result->timeAfterFirstByte =
+            std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - firstByte);
+        result->underrunCount = converter->getUnderrunCount();
+        result->underrunDuration = converter->getUnderrunDuration();
+        converter->shutdown();
+    }
+
+    /// The server the converter fetches from.
+    LocalHttpServer m_server;
+
+    /// The URL of the test playlist.
+    std::string m_playlistUrl;
+
+    /// The concatenated content of the test segments.
+    std::string m_expectedContent;
+
+    /// The URL of the first test segment, which is an audio file on its own.
+    std::string m_firstSegmentUrl;
+
+    /// The content of the first test segment.
+    std::string m_firstSegmentContent;
+};
+
+/**
+ * Verify that segments fetched concurrently are written into the attachment whole and in playlist order.
+ */
+TEST_F(UrlContentToAttachmentConverterTest, testPrefetchedSegmentsAreStreamedInOrder) {
+    StreamResult result;
+    stream(UrlContentToAttachmentConverter::DEFAULT_MAX_PREFETCH_SEGMENTS, &result);
+    ASSERT_EQ(m_expectedContent.size(), result.content.size());
+    ASSERT_TRUE(m_expectedContent == result.content);
+}
+
+/**
+ * Verify that fetching segments one at a time exposes each request's latency as an underrun, and that fetching them
+ * ahead hides it.
+ */
+TEST_F(UrlContentToAttachmentConverterTest, testPrefetchHidesSegmentLatency) {
+    StreamResult sequential;
+    stream(1, &sequential);
+    ASSERT_TRUE(m_expectedContent == sequential.content);
+    EXPECT_GE(sequential.underrunCount, NUM_SEGMENTS - 1);
+    EXPECT_GE(sequential.timeAfterFirstByte, RESPONSE_DELAY * (NUM_SEGMENTS - 1));
+
+    StreamResult prefetched;
+    stream(NUM_SEGMENTS, &prefetched);
+    ASSERT_TRUE(m_expectedContent == prefetched.content);
+    EXPECT_LT(prefetched.underrunDuration, RESPONSE_DELAY);
+    EXPECT_LT(prefetched.timeAfterFirstByte, RESPONSE_DELAY * (NUM_SEGMENTS - 1));
+    EXPECT_LT(prefetched.underrunCount, sequential.underrunCount);
+}
+
+/**
+ * Verify that a shutdown while the converter is waiting for a segment does not wait for the segment to arrive.
+ */
+TEST_F(UrlContentToAttachmentConverterTest, testShutdownWhileWaitingForSegment) {
+    m_server.addBody("/segment0.aac", "", SEGMENT_CONTENT_TYPE, TIMEOUT);
+    auto converter =
+        UrlContentToAttachmentConverter::create(std::make_shared<HTTPContentFetcherFactory>(), m_playlistUrl, nullptr);
+    ASSERT_TRUE(converter);
+    // Wait for the playlist to be fetched and the first segment to be requested.
+    auto deadline = std::chrono::steady_clock::now() + TIMEOUT;
+    while (m_server.getRequestCount() < 3 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(RESPONSE_DELAY / 10);
+    }
+    ASSERT_GE(m_server.getRequestCount(), 3u);
+    auto start = std::chrono::steady_clock::now();
+    converter->shutdown();
+    ASSERT_LT(std::chrono::steady_clock::now() - start, TIMEOUT / 4);
+}
+
+/**
+ * Verify that only a URL which is not a playlist is fetched as reusable content, and only when the caller asks for it.
+ */
+TEST_F(UrlContentToAttachmentConverterTest, testOnlySingleFileIsFetchedAsReusable) {
+    auto factory = std::make_shared<RecordingContentFetcherFactory>();
+    auto create = [&](const std::string& url, bool cacheSingleFile) {
+        return UrlContentToAttachmentConverter::create(
+            factory,
+            url,
+            nullptr,
+            std::chrono::milliseconds::zero(),
+            UrlContentToAttachmentConverter::DEFAULT_MAX_PREFETCH_SEGMENTS,
+            cacheSingleFile);
+    };
+
+    auto playlist = create(m_playlistUrl, true);
+    ASSERT_TRUE(playlist);
+    ASSERT_TRUE(m_expectedContent == readToEnd(playlist));
+    playlist->shutdown();
+    EXPECT_TRUE(factory->getReusableUrls().empty());
+
+    auto notCached = create(m_firstSegmentUrl, false);
+    ASSERT_TRUE(notCached);
+    ASSERT_TRUE(m_firstSegmentContent == readToEnd(notCached));
+    notCached->shutdown();
+    EXPECT_TRUE(factory->getReusableUrls().empty());
+
+    auto cached = create(m_firstSegmentUrl, true);
+    ASSERT_TRUE(cached);
+    ASSERT_TRUE(m_firstSegmentContent == readToEnd(cached));
+    cached->shutdown();
+    EXPECT_EQ(std::vector<std::string>{m_firstSegmentUrl}, factory->getReusableUrls());
+}
+
+}  // namespace test
+}  // namespace playlistParser
+}  // namespace alexaClientSDK
@@ -142,9 +142,15 @@ private:
     /// The @c MediaPlayer used by @c SpeechSynthesizer.
     std::shared_ptr<mediaPlayer::MediaPlayer> m_speakMediaPlayer;
 
+    /// The @c MediaPlayer used by @c SpeechSynthesizer to prestage the next Speak, if speech prestaging is enabled.
+    std::shared_ptr<mediaPlayer::MediaPlayer> m_speakPrestageMediaPlayer;
+
     /// The @c MediaPlayer used by @c AudioPlayer.
     std::shared_ptr<mediaPlayer::MediaPlayer> m_audioMediaPlayer;
 
+    /// The @c MediaPlayer used by @c AudioPlayer to prefetch the next item, if gapless playback is enabled.
+    std::shared_ptr<mediaPlayer::MediaPlayer> m_audioPrefetchMediaPlayer;
+
     /// The @c MediaPlayer used by @c Alerts.
     std::shared_ptr<mediaPlayer::MediaPlayer> m_alertsMediaPlayer;
 
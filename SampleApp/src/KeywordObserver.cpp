@@ -42,7 +42,7 @@ void KeywordObserver::onKeyWordDetected(
         beginIndex != avsCommon::sdkInterfaces::KeyWordObserverInterface::UNSPECIFIED_INDEX) {
         if (m_client) {
             if (m_espProvider) {
-                auto espData = m_espProvider->getESPData();
+                auto espData = m_espProvider->getESPData(beginIndex, endIndex);
                 m_client->notifyOfWakeWord(m_audioProvider, beginIndex, endIndex, keyword, espData);
             } else {
                 m_client->notifyOfWakeWord(m_audioProvider, beginIndex, endIndex, keyword);
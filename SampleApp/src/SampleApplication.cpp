@@ -28,13 +28,16 @@
 
 #ifdef ENABLE_ESP
 #include <ESP/ESPDataProvider.h>
+#include <ESP/ESPVoiceActivityDetector.h>
 #else
 #include <ESP/DummyESPDataProvider.h>
 #endif
 
+#include <AVSCommon/AVS/EnergyVoiceActivityDetector.h>
 #include <AVSCommon/AVS/Initialization/AlexaClientSDKInit.h>
 #include <AVSCommon/Utils/Configuration/ConfigurationNode.h>
 #include <AVSCommon/Utils/LibcurlUtils/HTTPContentFetcherFactory.h>
+#include <AVSCommon/Utils/LibcurlUtils/HttpContentCache.h>
 #include <AVSCommon/Utils/Logger/LoggerSinkManager.h>
 #include <Alerts/Storage/SQLiteAlertStorage.h>
 #include <Audio/AudioFactory.h>
@@ -83,6 +86,30 @@ static const std::string DISPLAY_CARD_KEY("displayCardsSupported");
 
 static const std::string DISABLE_STDIN_KEY("disableStdin");
 
+/// Key for enabling on-device end of speech detection under the @c SAMPLE_APP_CONFIG_KEY configuration node.
+static const std::string LOCAL_ENDPOINTER_KEY("localEndpointer");
+
+/// Key for the end of speech hangover in milliseconds under the @c SAMPLE_APP_CONFIG_KEY configuration node.
+static const std::string ENDPOINTER_HANGOVER_KEY("endpointerHangoverMs");
+
+/// Key for enabling gapless AudioPlayer playback under the @c SAMPLE_APP_CONFIG_KEY configuration node.
+static const std::string GAPLESS_AUDIO_PLAYER_KEY("gaplessAudioPlayer");
+
+/// Key for enabling prestaging of the next Speak under the @c SAMPLE_APP_CONFIG_KEY configuration node.
+static const std::string PRESTAGE_SPEECH_KEY("prestageSpeech");
+
+/// Key for the path of an audio resource pack under the @c SAMPLE_APP_CONFIG_KEY configuration node.
+static const std::string AUDIO_RESOURCE_PACK_KEY("audioResourcePack");
+
+/// Key for the directory of the HTTP content cache under the @c SAMPLE_APP_CONFIG_KEY configuration node.
+static const std::string HTTP_CONTENT_CACHE_DIRECTORY_KEY("httpContentCacheDirectory");
+
+/// Key for the size in megabytes of the HTTP content cache under the @c SAMPLE_APP_CONFIG_KEY configuration node.
+static const std::string HTTP_CONTENT_CACHE_SIZE_KEY("httpContentCacheSizeMB");
+
+/// The size in megabytes of the HTTP content cache if none is configured.
+static const int DEFAULT_HTTP_CONTENT_CACHE_SIZE_MB = 64;
+
 using namespace capabilityAgents::externalMediaPlayer;
 
 /// The @c m_playerToMediaPlayerMap Map of the adapter to their speaker-type and MediaPlayer creation methods.
@@ -213,9 +240,15 @@ SampleApplication::~SampleApplication() {
     if (m_speakMediaPlayer) {
         m_speakMediaPlayer->shutdown();
     }
+    if (m_speakPrestageMediaPlayer) {
+        m_speakPrestageMediaPlayer->shutdown();
+    }
     if (m_audioMediaPlayer) {
         m_audioMediaPlayer->shutdown();
     }
+    if (m_audioPrefetchMediaPlayer) {
+        m_audioPrefetchMediaPlayer->shutdown();
+    }
     if (m_alertsMediaPlayer) {
         m_alertsMediaPlayer->shutdown();
     }
@@ -293,7 +326,28 @@ bool SampleApplication::initialize(
     auto config = alexaClientSDK::avsCommon::utils::configuration::ConfigurationNode::getRoot();
     auto sampleAppConfig = config[SAMPLE_APP_CONFIG_KEY];
 
-    auto httpContentFetcherFactory = std::make_shared<avsCommon::utils::libcurlUtils::HTTPContentFetcherFactory>();
+    /*
+     * If a cache directory is configured, media files fetched over HTTP, such as podcast episodes, are kept there, so
+     * that replaying or resuming them reads from disk and an interrupted download only fetches what it is missing.
+     * Playlists and the segments of live streams are not cached.
+     */
+    std::shared_ptr<avsCommon::utils::libcurlUtils::HttpContentCache> httpContentCache;
+    std::string httpContentCacheDirectory;
+    if (sampleAppConfig.getString(HTTP_CONTENT_CACHE_DIRECTORY_KEY, &httpContentCacheDirectory)) {
+        int httpContentCacheSizeMB = DEFAULT_HTTP_CONTENT_CACHE_SIZE_MB;
+        sampleAppConfig.getInt(
+            HTTP_CONTENT_CACHE_SIZE_KEY, &httpContentCacheSizeMB, DEFAULT_HTTP_CONTENT_CACHE_SIZE_MB);
+        httpContentCache = avsCommon::utils::libcurlUtils::HttpContentCache::create(
+            httpContentCacheDirectory, static_cast<uint64_t>(std::max(httpContentCacheSizeMB, 1)) * 1024 * 1024);
+        if (!httpContentCache) {
+            alexaClientSDK::sampleApp::ConsolePrinter::simplePrint(
+                "Failed to create HTTP content cache in " + httpContentCacheDirectory + "!");
+            return false;
+        }
+    }
+
+    auto httpContentFetcherFactory =
+        std::make_shared<avsCommon::utils::libcurlUtils::HTTPContentFetcherFactory>(httpContentCache);
 
     m_speakMediaPlayer = alexaClientSDK::mediaPlayer::MediaPlayer::create(
         httpContentFetcherFactory, avsCommon::sdkInterfaces::SpeakerInterface::Type::AVS_SYNCED, "SpeakMediaPlayer");
@@ -302,6 +356,24 @@ bool SampleApplication::initialize(
         return false;
     }
 
+    /*
+     * If speech prestaging is enabled, SpeechSynthesizer prerolls the next Speak in a second MediaPlayer while the
+     * current one plays, and the two swap roles between utterances.
+     */
+    bool prestageSpeech = false;
+    sampleAppConfig.getBool(PRESTAGE_SPEECH_KEY, &prestageSpeech, false);
+    if (prestageSpeech) {
+        m_speakPrestageMediaPlayer = alexaClientSDK::mediaPlayer::MediaPlayer::create(
+            httpContentFetcherFactory,
+            avsCommon::sdkInterfaces::SpeakerInterface::Type::AVS_SYNCED,
+            "SpeakPrestageMediaPlayer");
+        if (!m_speakPrestageMediaPlayer) {
+            alexaClientSDK::sampleApp::ConsolePrinter::simplePrint(
+                "Failed to create prestage media player for speech!");
+            return false;
+        }
+    }
+
     m_audioMediaPlayer = alexaClientSDK::mediaPlayer::MediaPlayer::create(
         httpContentFetcherFactory, avsCommon::sdkInterfaces::SpeakerInterface::Type::AVS_SYNCED, "AudioMediaPlayer");
     if (!m_audioMediaPlayer) {
@@ -309,6 +381,24 @@ bool SampleApplication::initialize(
         return false;
     }
 
+    /*
+     * If gapless playback is enabled, AudioPlayer requests and prerolls the next item in a second MediaPlayer shortly
+     * before the current one ends, and the two swap roles just before the track boundary.
+     */
+    bool gaplessAudioPlayer = false;
+    sampleAppConfig.getBool(GAPLESS_AUDIO_PLAYER_KEY, &gaplessAudioPlayer, false);
+    if (gaplessAudioPlayer) {
+        m_audioPrefetchMediaPlayer = alexaClientSDK::mediaPlayer::MediaPlayer::create(
+            httpContentFetcherFactory,
+            avsCommon::sdkInterfaces::SpeakerInterface::Type::AVS_SYNCED,
+            "AudioPrefetchMediaPlayer");
+        if (!m_audioPrefetchMediaPlayer) {
+            alexaClientSDK::sampleApp::ConsolePrinter::simplePrint(
+                "Failed to create prefetch media player for content!");
+            return false;
+        }
+    }
+
     m_notificationsMediaPlayer = alexaClientSDK::mediaPlayer::MediaPlayer::create(
         httpContentFetcherFactory,
         avsCommon::sdkInterfaces::SpeakerInterface::Type::AVS_SYNCED,
@@ -348,12 +438,38 @@ bool SampleApplication::initialize(
 
     std::vector<std::shared_ptr<avsCommon::sdkInterfaces::SpeakerInterface>> additionalSpeakers;
 
+    // The prefetch player takes over as the content speaker at each track boundary, so keep its volume in sync.
+    if (m_audioPrefetchMediaPlayer) {
+        additionalSpeakers.push_back(
+            std::static_pointer_cast<alexaClientSDK::avsCommon::sdkInterfaces::SpeakerInterface>(
+                m_audioPrefetchMediaPlayer));
+    }
+
+    // Likewise, the speech prestage player takes over as the speech speaker between utterances.
+    if (m_speakPrestageMediaPlayer) {
+        additionalSpeakers.push_back(
+            std::static_pointer_cast<alexaClientSDK::avsCommon::sdkInterfaces::SpeakerInterface>(
+                m_speakPrestageMediaPlayer));
+    }
+
     if (!createMediaPlayersForAdapters(httpContentFetcherFactory, additionalSpeakers)) {
         alexaClientSDK::sampleApp::ConsolePrinter::simplePrint("ERROR: Could not create mediaPlayers for adapters");
         return false;
     }
 
-    auto audioFactory = std::make_shared<alexaClientSDK::applicationUtilities::resources::audio::AudioFactory>();
+    // The alert and notification sounds are read from a resource pack if one is configured.
+    std::shared_ptr<alexaClientSDK::applicationUtilities::resources::audio::AudioResourcePack> audioResourcePack;
+    std::string audioResourcePackPath;
+    if (sampleAppConfig.getString(AUDIO_RESOURCE_PACK_KEY, &audioResourcePackPath)) {
+        audioResourcePack =
+            alexaClientSDK::applicationUtilities::resources::audio::AudioResourcePack::create(audioResourcePackPath);
+        if (!audioResourcePack) {
+            alexaClientSDK::sampleApp::ConsolePrinter::simplePrint("Failed to open audio resource pack!");
+            return false;
+        }
+    }
+    auto audioFactory =
+        std::make_shared<alexaClientSDK::applicationUtilities::resources::audio::AudioFactory>(audioResourcePack);
 
     // Creating the alert storage object to be used for rendering and storing alerts.
     auto alertStorage =
@@ -414,6 +530,29 @@ bool SampleApplication::initialize(
     bool displayCardsSupported;
     config[SAMPLE_APP_CONFIG_KEY].getBool(DISPLAY_CARD_KEY, &displayCardsSupported, true);
 
+    /*
+     * Creating the Endpointer, if enabled - this stops capturing audio as soon as the user stops talking instead of
+     * waiting for AVS to send a StopCapture directive.  The ESP library's VAD is used where it is available.
+     */
+    std::shared_ptr<capabilityAgents::aip::Endpointer> endpointer;
+    bool localEndpointer = false;
+    sampleAppConfig.getBool(LOCAL_ENDPOINTER_KEY, &localEndpointer, false);
+    if (localEndpointer) {
+        std::chrono::milliseconds hangover;
+        sampleAppConfig.getDuration<std::chrono::milliseconds>(
+            ENDPOINTER_HANGOVER_KEY, &hangover, capabilityAgents::aip::Endpointer::DEFAULT_HANGOVER);
+#ifdef ENABLE_ESP
+        auto voiceActivityDetector = std::make_shared<esp::ESPVoiceActivityDetector>();
+#else
+        auto voiceActivityDetector = std::make_shared<avsCommon::avs::EnergyVoiceActivityDetector>();
+#endif
+        endpointer = capabilityAgents::aip::Endpointer::create(voiceActivityDetector, hangover);
+        if (!endpointer) {
+            alexaClientSDK::sampleApp::ConsolePrinter::simplePrint("Failed to create Endpointer!");
+            return false;
+        }
+    }
+
     /*
      * Creating the DefaultClient - this component serves as an out-of-box default object that instantiates and "glues"
      * together all the modules.
@@ -442,7 +581,10 @@ bool SampleApplication::initialize(
             displayCardsSupported,
             firmwareVersion,
             true,
-            nullptr);
+            nullptr,
+            endpointer,
+            m_audioPrefetchMediaPlayer,
+            m_speakPrestageMediaPlayer);
 
     if (!client) {
         alexaClientSDK::sampleApp::ConsolePrinter::simplePrint("Failed to create default SDK client!");
@@ -559,8 +701,14 @@ bool SampleApplication::initialize(
         wakeCanBeOverridden);
 
 #ifdef ENABLE_ESP
+#if defined(KWD_KITTAI) || defined(KWD_SENSORY)
+    // Creating ESP connector, fed with the audio the keyword detector reads rather than reading the stream itself.
+    std::shared_ptr<esp::ESPDataProvider> espDataProvider = esp::ESPDataProvider::create(wakeWordAudioProvider, false);
+#else
     // Creating ESP connector
-    std::shared_ptr<esp::ESPDataProviderInterface> espProvider = esp::ESPDataProvider::create(wakeWordAudioProvider);
+    std::shared_ptr<esp::ESPDataProvider> espDataProvider = esp::ESPDataProvider::create(wakeWordAudioProvider);
+#endif
+    std::shared_ptr<esp::ESPDataProviderInterface> espProvider = espDataProvider;
     std::shared_ptr<esp::ESPDataModifierInterface> espModifier = nullptr;
 #else
     // Create dummy ESP connector
@@ -612,6 +760,12 @@ bool SampleApplication::initialize(
     }
 #endif
 
+#if defined(ENABLE_ESP) && (defined(KWD_KITTAI) || defined(KWD_SENSORY))
+    if (espDataProvider) {
+        m_keywordDetector->addAudioObserver(espDataProvider);
+    }
+#endif
+
     // If wake word is enabled, then creating the interaction manager with a wake word audio provider.
     auto interactionManager = std::make_shared<alexaClientSDK::sampleApp::InteractionManager>(
         client,
@@ -27,9 +27,15 @@ include(PlaylistParser)
 # Setup media player variables.
 include(MediaPlayer)
 
+# Setup Opus encoder variables.
+include(Opus)
+
 # Setup PortAudio variables.
 include(PortAudio)
 
+# Setup audio resource variables.
+include(AudioResources)
+
 # Setup Test Options variables.
 include(TestOptions)
 
@@ -0,0 +1,14 @@
+#
+# Setup the AudioResources build.
+#
+# By default the alert and notification sounds are compiled into the AudioResources library, and are used whenever
+# they are not found in an audio resource pack.  To leave them out, so the sounds are only read from a pack, run the
+# following command,
+#     cmake <path-to-source> -DCOMPILED_IN_AUDIO_RESOURCES=OFF.
+#
+
+option(COMPILED_IN_AUDIO_RESOURCES "Compile the default alert and notification sounds into AudioResources." ON)
+
+if(COMPILED_IN_AUDIO_RESOURCES)
+    add_definitions(-DCOMPILED_IN_AUDIO_RESOURCES)
+endif()
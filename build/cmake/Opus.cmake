@@ -0,0 +1,16 @@
+#
+# Setup the Opus encoder build.
+#
+# To build AudioInputProcessor with the libopus based encoder for Recognize uploads, run the following command,
+#     cmake <path-to-source> -DOPUS=ON.
+#
+#
+
+option(OPUS "Enable libopus based encoding of Recognize audio." OFF)
+
+set(PKG_CONFIG_USE_CMAKE_PREFIX_PATH ON)
+if(OPUS)
+    find_package(PkgConfig)
+    pkg_check_modules(OPUS REQUIRED opus>=1.1)
+    add_definitions(-DENABLE_OPUS)
+endif()